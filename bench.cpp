@@ -0,0 +1,550 @@
+/*
+ * Copyright 2015-2021 Arm Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * At your option, you may choose to accept this material under either:
+ *  1. The Apache License, Version 2.0, found at <http://www.apache.org/licenses/LICENSE-2.0>, or
+ *  2. The MIT License, found at <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: Apache-2.0 OR MIT.
+ */
+
+// Benchmark harness for SPIRV-Cross.
+// Runs a set of SPIR-V modules through every backend and reports per-phase timings,
+// heap allocation counts and peak heap usage for each shader as JSON.
+
+#include "spirv_cpp.hpp"
+#include "spirv_glsl.hpp"
+#include "spirv_hlsl.hpp"
+#include "spirv_msl.hpp"
+#include "spirv_parser.hpp"
+#include "spirv_reflect.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#endif
+
+using namespace spv;
+using namespace SPIRV_CROSS_NAMESPACE;
+using namespace std;
+
+// Every heap allocation made through operator new is counted.
+// Blocks are prefixed with their size so that live bytes can be tracked on free.
+static size_t g_allocations;
+static size_t g_live_bytes;
+static size_t g_peak_bytes;
+static const size_t AllocationHeaderSize = alignof(max_align_t);
+
+static void *tracked_alloc(size_t size)
+{
+	auto *block = static_cast<unsigned char *>(malloc(size + AllocationHeaderSize));
+	if (!block)
+		return nullptr;
+
+	memcpy(block, &size, sizeof(size));
+	g_allocations++;
+	g_live_bytes += size;
+	if (g_live_bytes > g_peak_bytes)
+		g_peak_bytes = g_live_bytes;
+	return block + AllocationHeaderSize;
+}
+
+static void tracked_free(void *ptr)
+{
+	if (!ptr)
+		return;
+
+	auto *block = static_cast<unsigned char *>(ptr) - AllocationHeaderSize;
+	size_t size;
+	memcpy(&size, block, sizeof(size));
+	g_live_bytes -= size;
+	free(block);
+}
+
+void *operator new(size_t size)
+{
+	void *ptr = tracked_alloc(size);
+	if (!ptr)
+		throw bad_alloc();
+	return ptr;
+}
+
+void *operator new(size_t size, const nothrow_t &) noexcept
+{
+	return tracked_alloc(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+	tracked_free(ptr);
+}
+
+void operator delete(void *ptr, const nothrow_t &) noexcept
+{
+	tracked_free(ptr);
+}
+
+static double get_time()
+{
+	auto now = chrono::steady_clock::now().time_since_epoch();
+	return chrono::duration<double>(now).count();
+}
+
+struct CLIArguments
+{
+	vector<string> inputs;
+	const char *output = nullptr;
+	const char *glslang = nullptr;
+	const char *spirv_as = nullptr;
+	string work_dir;
+	unsigned iterations = 3;
+};
+
+enum Backend
+{
+	BackendGLSL,
+	BackendHLSL,
+	BackendMSL,
+	BackendCPP,
+	BackendReflect,
+	BackendCount
+};
+
+static const char *backend_names[BackendCount] = { "glsl", "hlsl", "msl", "cpp", "json" };
+
+struct BackendResult
+{
+	bool success = false;
+	string error;
+	double total = 0.0;
+	Compiler::PhaseTimings timings;
+	size_t allocations = 0;
+	size_t peak_bytes = 0;
+	size_t output_bytes = 0;
+};
+
+struct ShaderResult
+{
+	string path;
+	string error;
+	size_t word_count = 0;
+	double parse = 0.0;
+	size_t parse_allocations = 0;
+	BackendResult backends[BackendCount];
+};
+
+static bool ends_with(const string &str, const char *suffix)
+{
+	size_t len = strlen(suffix);
+	return str.size() >= len && str.compare(str.size() - len, len, suffix) == 0;
+}
+
+static void gather_inputs(const string &path, vector<string> &inputs)
+{
+#ifdef _WIN32
+	DWORD attr = GetFileAttributesA(path.c_str());
+	if (attr == INVALID_FILE_ATTRIBUTES || (attr & FILE_ATTRIBUTE_DIRECTORY) == 0)
+	{
+		inputs.push_back(path);
+		return;
+	}
+
+	WIN32_FIND_DATAA data;
+	HANDLE handle = FindFirstFileA((path + "\\*").c_str(), &data);
+	if (handle == INVALID_HANDLE_VALUE)
+		return;
+
+	vector<string> entries;
+	do
+	{
+		if (data.cFileName[0] != '.')
+			entries.push_back(path + "/" + data.cFileName);
+	} while (FindNextFileA(handle, &data));
+	FindClose(handle);
+#else
+	struct stat st;
+	if (stat(path.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+	{
+		inputs.push_back(path);
+		return;
+	}
+
+	DIR *dir = opendir(path.c_str());
+	if (!dir)
+		return;
+
+	vector<string> entries;
+	while (auto *entry = readdir(dir))
+		if (entry->d_name[0] != '.')
+			entries.push_back(path + "/" + entry->d_name);
+	closedir(dir);
+#endif
+
+	// Keep the report stable between runs.
+	sort(begin(entries), end(entries));
+	for (auto &entry : entries)
+		gather_inputs(entry, inputs);
+}
+
+static vector<uint32_t> read_spirv_file(const string &path)
+{
+	FILE *file = fopen(path.c_str(), "rb");
+	if (!file)
+		return {};
+
+	fseek(file, 0, SEEK_END);
+	long len = ftell(file) / sizeof(uint32_t);
+	rewind(file);
+
+	vector<uint32_t> spirv(len);
+	if (fread(spirv.data(), sizeof(uint32_t), len, file) != size_t(len))
+		spirv.clear();
+
+	fclose(file);
+	return spirv;
+}
+
+// Text shaders in the test corpora are assembled the same way as test_shaders.py does it.
+static bool assemble_shader(const CLIArguments &args, const string &path, const string &spirv_path)
+{
+	string cmd;
+	if (path.find(".asm.") != string::npos)
+	{
+		if (!args.spirv_as)
+			return false;
+
+		const char *env = path.find(".spv14.") != string::npos ? "vulkan1.1spv1.4" : "vulkan1.1";
+		cmd = join("\"", args.spirv_as, "\" --target-env ", env);
+		if (path.find(".preserve.") != string::npos)
+			cmd += " --preserve-numeric-ids";
+	}
+	else
+	{
+		if (!args.glslang)
+			return false;
+		cmd = join("\"", args.glslang, "\" --amb --target-env vulkan1.1 -V");
+	}
+
+	cmd += join(" -o \"", spirv_path, "\" \"", path, "\"");
+#ifdef _WIN32
+	cmd += " > NUL 2>&1";
+#else
+	cmd += " > /dev/null 2>&1";
+#endif
+	return system(cmd.c_str()) == 0;
+}
+
+static unique_ptr<Compiler> create_compiler(Backend backend, const ParsedIR &ir)
+{
+	switch (backend)
+	{
+	case BackendGLSL:
+	{
+		unique_ptr<CompilerGLSL> compiler(new CompilerGLSL(ir));
+		auto opts = compiler->get_common_options();
+		// Vulkan GLSL accepts the widest range of the corpora.
+		opts.vulkan_semantics = true;
+		compiler->set_common_options(opts);
+		return unique_ptr<Compiler>(compiler.release());
+	}
+
+	case BackendHLSL:
+	{
+		unique_ptr<CompilerHLSL> compiler(new CompilerHLSL(ir));
+		auto opts = compiler->get_hlsl_options();
+		opts.shader_model = 60;
+		compiler->set_hlsl_options(opts);
+		return unique_ptr<Compiler>(compiler.release());
+	}
+
+	case BackendMSL:
+	{
+		unique_ptr<CompilerMSL> compiler(new CompilerMSL(ir));
+		auto opts = compiler->get_msl_options();
+		opts.set_msl_version(2, 3);
+		compiler->set_msl_options(opts);
+		return unique_ptr<Compiler>(compiler.release());
+	}
+
+	case BackendCPP:
+		return unique_ptr<Compiler>(new CompilerCPP(ir));
+
+	default:
+		return unique_ptr<Compiler>(new CompilerReflection(ir));
+	}
+}
+
+static void run_backend(Backend backend, const ParsedIR &ir, unsigned iteration, BackendResult &best)
+{
+	BackendResult result;
+	g_allocations = 0;
+	g_peak_bytes = g_live_bytes;
+	size_t base_bytes = g_live_bytes;
+
+	double start = get_time();
+	try
+	{
+		auto compiler = create_compiler(backend, ir);
+
+		// MSL has no geometry stage and does not reliably reject such modules.
+		if (backend == BackendMSL && compiler->get_execution_model() == ExecutionModelGeometry)
+			SPIRV_CROSS_THROW("Geometry shaders are not supported in MSL.");
+
+		auto source = compiler->compile();
+		result.total = get_time() - start;
+		result.timings = compiler->get_phase_timings();
+		result.output_bytes = source.size();
+		result.success = true;
+	}
+	catch (const exception &e)
+	{
+		result.error = e.what();
+	}
+
+	result.allocations = g_allocations;
+	result.peak_bytes = g_peak_bytes - base_bytes;
+
+	// Report the fastest iteration, as it is the least affected by noise.
+	if (iteration == 0 || (result.success && result.total < best.total))
+		best = move(result);
+}
+
+static void run_shader(const CLIArguments &args, const string &path, size_t index, ShaderResult &result)
+{
+	result.path = path;
+
+	vector<uint32_t> spirv;
+	if (ends_with(path, ".spv"))
+		spirv = read_spirv_file(path);
+	else
+	{
+		auto spirv_path = join(args.work_dir, "/spirv-cross-bench-", index, ".spv");
+		if (!assemble_shader(args, path, spirv_path))
+		{
+			result.error = "Failed to assemble shader.";
+			return;
+		}
+		spirv = read_spirv_file(spirv_path);
+		remove(spirv_path.c_str());
+	}
+
+	if (spirv.empty())
+	{
+		result.error = "Failed to read SPIR-V.";
+		return;
+	}
+	result.word_count = spirv.size();
+
+	ParsedIR ir;
+	for (unsigned i = 0; i < args.iterations; i++)
+	{
+		try
+		{
+			g_allocations = 0;
+			double start = get_time();
+			Parser parser(spirv.data(), spirv.size());
+			parser.parse();
+			double parse_time = get_time() - start;
+			if (i == 0 || parse_time < result.parse)
+				result.parse = parse_time;
+			result.parse_allocations = g_allocations;
+			ir = move(parser.get_parsed_ir());
+		}
+		catch (const exception &e)
+		{
+			result.error = e.what();
+			return;
+		}
+	}
+
+	for (int backend = 0; backend < BackendCount; backend++)
+		for (unsigned i = 0; i < args.iterations; i++)
+			run_backend(Backend(backend), ir, i, result.backends[backend]);
+}
+
+static string escape_json(const string &str)
+{
+	string ret;
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+		{
+			ret += '\\';
+			ret += c;
+		}
+		else if (c == '\n')
+			ret += "\\n";
+		else if (uint8_t(c) < 0x20)
+		{
+			char buf[8];
+			snprintf(buf, sizeof(buf), "\\u%04x", unsigned(uint8_t(c)));
+			ret += buf;
+		}
+		else
+			ret += c;
+	}
+	return ret;
+}
+
+static void write_report(FILE *file, const CLIArguments &args, const vector<ShaderResult> &results)
+{
+	double totals[BackendCount] = {};
+	double total_parse = 0.0;
+
+	fprintf(file, "{\n\t\"iterations\": %u,\n\t\"shaders\": [\n", args.iterations);
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		auto &shader = results[i];
+		fprintf(file, "\t\t{\n\t\t\t\"path\": \"%s\",\n", escape_json(shader.path).c_str());
+		if (!shader.error.empty())
+		{
+			fprintf(file, "\t\t\t\"error\": \"%s\"\n", escape_json(shader.error).c_str());
+			fprintf(file, "\t\t}%s\n", i + 1 < results.size() ? "," : "");
+			continue;
+		}
+
+		total_parse += shader.parse;
+		fprintf(file, "\t\t\t\"words\": %zu,\n", shader.word_count);
+		fprintf(file, "\t\t\t\"parse\": %.9f,\n", shader.parse);
+		fprintf(file, "\t\t\t\"parse_allocations\": %zu,\n", shader.parse_allocations);
+		fprintf(file, "\t\t\t\"backends\": {\n");
+		for (int backend = 0; backend < BackendCount; backend++)
+		{
+			auto &res = shader.backends[backend];
+			fprintf(file, "\t\t\t\t\"%s\": {\n", backend_names[backend]);
+			if (res.success)
+			{
+				totals[backend] += res.total;
+				fprintf(file, "\t\t\t\t\t\"total\": %.9f,\n", res.total);
+				fprintf(file, "\t\t\t\t\t\"cfg\": %.9f,\n", res.timings.cfg);
+				fprintf(file, "\t\t\t\t\t\"analysis\": %.9f,\n", res.timings.analysis);
+				fprintf(file, "\t\t\t\t\t\"emission\": %.9f,\n", res.timings.emission);
+				fprintf(file, "\t\t\t\t\t\"passes\": [");
+				for (size_t pass = 0; pass < res.timings.passes.size(); pass++)
+					fprintf(file, "%s%.9f", pass ? ", " : " ", res.timings.passes[pass]);
+				fprintf(file, " ],\n");
+				fprintf(file, "\t\t\t\t\t\"allocations\": %zu,\n", res.allocations);
+				fprintf(file, "\t\t\t\t\t\"peak_heap_bytes\": %zu,\n", res.peak_bytes);
+				fprintf(file, "\t\t\t\t\t\"output_bytes\": %zu\n", res.output_bytes);
+			}
+			else
+				fprintf(file, "\t\t\t\t\t\"error\": \"%s\"\n", escape_json(res.error).c_str());
+			fprintf(file, "\t\t\t\t}%s\n", backend + 1 < BackendCount ? "," : "");
+		}
+		fprintf(file, "\t\t\t}\n\t\t}%s\n", i + 1 < results.size() ? "," : "");
+	}
+	fprintf(file, "\t],\n");
+
+	fprintf(file, "\t\"totals\": {\n\t\t\"parse\": %.9f", total_parse);
+	for (int backend = 0; backend < BackendCount; backend++)
+		fprintf(file, ",\n\t\t\"%s\": %.9f", backend_names[backend], totals[backend]);
+	fprintf(file, "\n\t}");
+
+#ifndef _WIN32
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+		fprintf(file, ",\n\t\"max_rss_kb\": %ld", long(usage.ru_maxrss));
+#endif
+	fprintf(file, "\n}\n");
+}
+
+static void print_help()
+{
+	fprintf(stderr, "Usage: spirv-cross-bench\n"
+	                "\t[--output <report.json>]\n"
+	                "\t[--iterations <count>]\n"
+	                "\t[--glslang <path to glslangValidator>]\n"
+	                "\t[--spirv-as <path to spirv-as>]\n"
+	                "\t[--work-dir <directory for temporary SPIR-V files>]\n"
+	                "\t<files or directories>...\n"
+	                "\n"
+	                "Directories are searched recursively, e.g. shaders*/.\n"
+	                "Files ending in .spv are used directly. Other files are assembled with\n"
+	                "spirv-as (*.asm.*) or glslangValidator first, and skipped if no tool is given.\n"
+	                "Timings are in seconds, the fastest of all iterations is reported.\n");
+}
+
+int main(int argc, char **argv)
+{
+	CLIArguments args;
+	const char *tmp = getenv("TMPDIR");
+	args.work_dir = tmp ? tmp : ".";
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char *arg = argv[i];
+		bool has_value = i + 1 < argc;
+		if (!strcmp(arg, "--help"))
+		{
+			print_help();
+			return EXIT_SUCCESS;
+		}
+		else if (!strcmp(arg, "--output") && has_value)
+			args.output = argv[++i];
+		else if (!strcmp(arg, "--iterations") && has_value)
+			args.iterations = max(1u, unsigned(strtoul(argv[++i], nullptr, 0)));
+		else if (!strcmp(arg, "--glslang") && has_value)
+			args.glslang = argv[++i];
+		else if (!strcmp(arg, "--spirv-as") && has_value)
+			args.spirv_as = argv[++i];
+		else if (!strcmp(arg, "--work-dir") && has_value)
+			args.work_dir = argv[++i];
+		else if (arg[0] == '-' && arg[1] == '-')
+		{
+			fprintf(stderr, "Invalid argument: %s\n", arg);
+			print_help();
+			return EXIT_FAILURE;
+		}
+		else
+			gather_inputs(arg, args.inputs);
+	}
+
+	if (args.inputs.empty())
+	{
+		print_help();
+		return EXIT_FAILURE;
+	}
+
+	vector<ShaderResult> results(args.inputs.size());
+	for (size_t i = 0; i < args.inputs.size(); i++)
+		run_shader(args, args.inputs[i], i, results[i]);
+
+	FILE *file = args.output ? fopen(args.output, "w") : stdout;
+	if (!file)
+	{
+		fprintf(stderr, "Failed to write file: %s\n", args.output);
+		return EXIT_FAILURE;
+	}
+
+	write_report(file, args, results);
+	if (file != stdout)
+		fclose(file);
+	return EXIT_SUCCESS;
+}
@@ -30,6 +30,11 @@ struct spirv_cross_interface
 	spirv_cross_shader_t *(*construct)(void);
 	void (*destruct)(spirv_cross_shader_t *thiz);
 	void (*invoke)(spirv_cross_shader_t *thiz);
+
+	/* Runs a full grid of compute workgroups, spread over a pool of worker threads.
+	 * gl_WorkGroupID and gl_NumWorkGroups are provided by the dispatch, and do not need to be set.
+	 * NULL for other shader stages. */
+	void (*dispatch)(spirv_cross_shader_t *thiz, unsigned x, unsigned y, unsigned z);
 };
 
 void spirv_cross_set_stage_input(spirv_cross_shader_t *thiz, unsigned location, void *data, size_t size);
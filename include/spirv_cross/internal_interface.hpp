@@ -34,6 +34,7 @@
 #include "image.hpp"
 #include "sampler.hpp"
 #include "thread_group.hpp"
+#include "workgroup_pool.hpp"
 #include <assert.h>
 #include <stdint.h>
 
@@ -321,6 +322,32 @@ struct spirv_cross_shader
 		*push_constant.ptr = data;
 	}
 
+	// Binds everything which is bound to other to the same slots in this shader.
+	// Both shaders must be instances of the same generated shader.
+	void copy_bindings(const spirv_cross_shader &other)
+	{
+		for (unsigned set = 0; set < SPIRV_CROSS_NUM_DESCRIPTOR_SETS; set++)
+			for (unsigned binding = 0; binding < SPIRV_CROSS_NUM_DESCRIPTOR_BINDINGS; binding++)
+				if (resources[set][binding].ptr)
+					*resources[set][binding].ptr = *other.resources[set][binding].ptr;
+
+		for (unsigned i = 0; i < SPIRV_CROSS_NUM_STAGE_INPUTS; i++)
+			if (stage_inputs[i].ptr)
+				*stage_inputs[i].ptr = *other.stage_inputs[i].ptr;
+		for (unsigned i = 0; i < SPIRV_CROSS_NUM_STAGE_OUTPUTS; i++)
+			if (stage_outputs[i].ptr)
+				*stage_outputs[i].ptr = *other.stage_outputs[i].ptr;
+		for (unsigned i = 0; i < SPIRV_CROSS_NUM_UNIFORM_CONSTANTS; i++)
+			if (uniform_constants[i].ptr)
+				*uniform_constants[i].ptr = *other.uniform_constants[i].ptr;
+		for (unsigned i = 0; i < SPIRV_CROSS_NUM_BUILTINS; i++)
+			if (builtins[i].ptr)
+				*builtins[i].ptr = *other.builtins[i].ptr;
+
+		if (push_constant.ptr)
+			*push_constant.ptr = *other.push_constant.ptr;
+	}
+
 	void set_resource(unsigned set, unsigned binding, void **data, size_t size)
 	{
 		assert(set < SPIRV_CROSS_NUM_DESCRIPTOR_SETS);
@@ -522,6 +549,23 @@ struct ComputeShader : BaseShader<ComputeShader<T, Res, WorkGroupX, WorkGroupY,
 		group.wait();
 	}
 
+	// Every invocation already has a thread of its own, so workgroups run one after the other.
+	inline void dispatch(unsigned x, unsigned y, unsigned z)
+	{
+		glm::uvec3 num_workgroups(x, y, z);
+		glm::uvec3 workgroup_id;
+		resources.gl_NumWorkGroups__.ptr = &num_workgroups;
+		resources.gl_WorkGroupID__.ptr = &workgroup_id;
+
+		for (workgroup_id.z = 0; workgroup_id.z < z; workgroup_id.z++)
+			for (workgroup_id.y = 0; workgroup_id.y < y; workgroup_id.y++)
+				for (workgroup_id.x = 0; workgroup_id.x < x; workgroup_id.x++)
+					main();
+
+		resources.gl_NumWorkGroups__.ptr = nullptr;
+		resources.gl_WorkGroupID__.ptr = nullptr;
+	}
+
 	ComputeShader()
 	    : group(&impl[0][0][0])
 	{
@@ -548,6 +592,104 @@ struct ComputeShader : BaseShader<ComputeShader<T, Res, WorkGroupX, WorkGroupY,
 	Res resources;
 };
 
+// Runs all invocations of a workgroup one after the other on the calling thread.
+// Shaders compiled with CompilerCPP::set_batched_invocations() return from main() at every barrier()
+// with __resume set to where they have to continue, so running every invocation until it returns
+// or suspends before starting the next round implements the barrier.
+template <typename T, typename Res, unsigned WorkGroupX, unsigned WorkGroupY, unsigned WorkGroupZ>
+struct BatchedComputeShader : BaseShader<BatchedComputeShader<T, Res, WorkGroupX, WorkGroupY, WorkGroupZ>>
+{
+	enum
+	{
+		Invocations = WorkGroupX * WorkGroupY * WorkGroupZ
+	};
+
+	inline void main()
+	{
+		unsigned i = 0;
+		for (unsigned z = 0; z < WorkGroupZ; z++)
+			for (unsigned y = 0; y < WorkGroupY; y++)
+				for (unsigned x = 0; x < WorkGroupX; x++)
+					impl[i++].__priv_res.gl_GlobalInvocationID__ =
+					    glm::uvec3(WorkGroupX, WorkGroupY, WorkGroupZ) * resources.gl_WorkGroupID__.get() +
+					    glm::uvec3(x, y, z);
+
+		bool active[Invocations];
+		for (i = 0; i < Invocations; i++)
+			active[i] = true;
+
+		bool suspended;
+		do
+		{
+			suspended = false;
+			for (i = 0; i < Invocations; i++)
+			{
+				if (!active[i])
+					continue;
+
+				impl[i].main();
+				active[i] = impl[i].__resume != 0;
+				suspended = suspended || active[i];
+			}
+		} while (suspended);
+	}
+
+	// Workgroups are spread over WorkgroupPool, with one copy of the shader per worker,
+	// so that every workgroup running at the same time has its own shared memory.
+	inline void dispatch(unsigned x, unsigned y, unsigned z)
+	{
+		auto &pool = WorkgroupPool::get();
+		while (workers.size() < pool.size())
+			workers.emplace_back(new BatchedComputeShader);
+
+		glm::uvec3 num_workgroups(x, y, z);
+		for (auto *worker : workers)
+		{
+			worker->copy_bindings(*this);
+			worker->resources.gl_NumWorkGroups__.ptr = &num_workgroups;
+			worker->resources.gl_WorkGroupID__.ptr = &worker->workgroup_id;
+		}
+
+		pool.run(x * y * z, [&](unsigned worker, unsigned workgroup) {
+			auto &shader = *workers[worker];
+			shader.workgroup_id = glm::uvec3(workgroup % x, (workgroup / x) % y, workgroup / (x * y));
+			shader.main();
+		});
+	}
+
+	~BatchedComputeShader()
+	{
+		for (auto *worker : workers)
+			delete worker;
+	}
+
+	BatchedComputeShader()
+	{
+		resources.init(*this);
+
+		unsigned i = 0;
+		for (unsigned z = 0; z < WorkGroupZ; z++)
+		{
+			for (unsigned y = 0; y < WorkGroupY; y++)
+			{
+				for (unsigned x = 0; x < WorkGroupX; x++)
+				{
+					impl[i].__priv_res.gl_LocalInvocationID__ = glm::uvec3(x, y, z);
+					impl[i].__priv_res.gl_LocalInvocationIndex__ = i;
+					impl[i].__res = &resources;
+					i++;
+				}
+			}
+		}
+	}
+
+	T impl[Invocations];
+	Res resources;
+
+	std::vector<BatchedComputeShader *> workers;
+	glm::uvec3 workgroup_id;
+};
+
 inline void memoryBarrierShared()
 {
 	Barrier::memoryBarrier();
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2015-2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SPIRV_CROSS_WORKGROUP_POOL_HPP
+#define SPIRV_CROSS_WORKGROUP_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace spirv_cross
+{
+// A persistent pool with one worker per core which runs the workgroups of a dispatch.
+// The workgroups are split evenly between the workers up front,
+// and workers which run out of work steal workgroups from the others one at a time.
+// The thread calling run() is worker 0 and takes part in the dispatch.
+class WorkgroupPool
+{
+public:
+	static WorkgroupPool &get()
+	{
+		static WorkgroupPool pool;
+		return pool;
+	}
+
+	unsigned size() const
+	{
+		return num_workers;
+	}
+
+	// Calls func(worker, workgroup) for every workgroup in [0, count) and returns once all of them are done.
+	// Calls from several threads are serialized, calls from inside func are not allowed.
+	void run(unsigned count, const std::function<void(unsigned, unsigned)> &func)
+	{
+		std::lock_guard<std::mutex> dispatch_holder{ dispatch_lock };
+
+		for (unsigned i = 0; i < num_workers; i++)
+		{
+			queues[i].next.store(unsigned(uint64_t(count) * i / num_workers), std::memory_order_relaxed);
+			queues[i].end = unsigned(uint64_t(count) * (i + 1) / num_workers);
+		}
+
+		{
+			std::lock_guard<std::mutex> l{ lock };
+			job = &func;
+			running = num_workers - 1;
+			generation++;
+		}
+		cond.notify_all();
+
+		work(0);
+
+		std::unique_lock<std::mutex> l{ lock };
+		done.wait(l, [this] { return running == 0; });
+		job = nullptr;
+	}
+
+	~WorkgroupPool()
+	{
+		{
+			std::lock_guard<std::mutex> l{ lock };
+			dying = true;
+		}
+		cond.notify_all();
+
+		for (auto &thread : threads)
+			thread.join();
+	}
+
+private:
+	struct Queue
+	{
+		std::atomic<unsigned> next;
+		unsigned end = 0;
+	};
+
+	WorkgroupPool()
+	{
+		num_workers = std::thread::hardware_concurrency();
+		if (num_workers == 0)
+			num_workers = 1;
+
+		queues.reset(new Queue[num_workers]);
+		for (unsigned i = 1; i < num_workers; i++)
+			threads.emplace_back([this, i] { loop(i); });
+	}
+
+	void loop(unsigned worker)
+	{
+		unsigned seen_generation = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> l{ lock };
+				cond.wait(l, [&] { return dying || generation != seen_generation; });
+				if (dying)
+					break;
+				seen_generation = generation;
+			}
+
+			work(worker);
+
+			std::lock_guard<std::mutex> l{ lock };
+			if (--running == 0)
+				done.notify_one();
+		}
+	}
+
+	void work(unsigned worker)
+	{
+		// Own queue first, then steal from the others.
+		for (unsigned i = 0; i < num_workers; i++)
+		{
+			auto &queue = queues[(worker + i) % num_workers];
+			unsigned workgroup;
+			while ((workgroup = queue.next.fetch_add(1u, std::memory_order_relaxed)) < queue.end)
+				(*job)(worker, workgroup);
+		}
+	}
+
+	unsigned num_workers;
+	std::unique_ptr<Queue[]> queues;
+	std::vector<std::thread> threads;
+
+	std::mutex dispatch_lock;
+	std::mutex lock;
+	std::condition_variable cond;
+	std::condition_variable done;
+	const std::function<void(unsigned, unsigned)> *job = nullptr;
+	unsigned generation = 0;
+	unsigned running = 0;
+	bool dying = false;
+};
+}
+
+#endif
@@ -22,6 +22,7 @@
  */
 
 #include "spirv_cpp.hpp"
+#include "spirv_cross_batch.hpp"
 #include "spirv_cross_util.hpp"
 #include "spirv_glsl.hpp"
 #include "spirv_hlsl.hpp"
@@ -279,6 +280,35 @@ static bool write_string_to_file(const char *path, const char *string)
 	return true;
 }
 
+static bool write_binary_to_file(const char *path, const string &data)
+{
+	FILE *file = fopen(path, "wb");
+	if (!file)
+	{
+		fprintf(stderr, "Failed to write file: %s\n", path);
+		return false;
+	}
+
+	bool success = fwrite(data.data(), 1, data.size(), file) == data.size();
+	fclose(file);
+	return success;
+}
+
+struct FileReflectionSink : ReflectionSink
+{
+	explicit FileReflectionSink(FILE *file_)
+	    : file(file_)
+	{
+	}
+
+	void write(const char *data, size_t size) override
+	{
+		fwrite(data, 1, size, file);
+	}
+
+	FILE *file;
+};
+
 #if defined(__clang__) || defined(__GNUC__)
 #pragma GCC diagnostic pop
 #elif defined(_MSC_VER)
@@ -523,6 +553,15 @@ static void print_capabilities_and_extensions(const Compiler &compiler)
 	fprintf(stderr, "============\n\n");
 }
 
+static void print_inferred_relaxed_precision(const CompilerGLSL &compiler)
+{
+	fprintf(stderr, "Inferred RelaxedPrecision\n");
+	fprintf(stderr, "============\n");
+	for (auto &id : compiler.get_inferred_relaxed_precision_ids())
+		fprintf(stderr, "ID: %u (%s)\n", uint32_t(id), compiler.get_name(id).c_str());
+	fprintf(stderr, "============\n\n");
+}
+
 struct PLSArg
 {
 	PlsFormat format;
@@ -552,8 +591,13 @@ struct InterfaceVariableRename
 struct CLIArguments
 {
 	const char *input = nullptr;
+	SmallVector<const char *> inputs;
 	const char *output = nullptr;
+	const char *output_dir = nullptr;
+	uint32_t jobs = 0;
+	uint32_t analysis_threads = 0;
 	const char *cpp_interface_name = nullptr;
+	bool cpp_batched_invocations = false;
 	uint32_t version = 0;
 	uint32_t shader_model = 0;
 	uint32_t msl_version = 0;
@@ -565,6 +609,7 @@ struct CLIArguments
 	bool dump_resources = false;
 	bool force_temporary = false;
 	bool flatten_ubo = false;
+	bool repack_ubo = false;
 	bool fixup = false;
 	bool yflip = false;
 	bool sso = false;
@@ -601,6 +646,12 @@ struct CLIArguments
 	bool msl_emulate_subgroups = false;
 	uint32_t msl_fixed_subgroup_size = 0;
 	bool msl_force_sample_rate_shading = false;
+	const char *msl_helper_library_include = nullptr;
+	const char *msl_helper_library_output = nullptr;
+	bool msl_vertex_pulling = false;
+	bool msl_stage_tess_control_outputs = false;
+	uint32_t msl_vertex_buffer_index_base = 0;
+	uint32_t msl_vertex_attribute_buffer_index = 20;
 	bool glsl_emit_push_constant_as_ubo = false;
 	bool glsl_emit_ubo_as_plain_uniforms = false;
 	bool glsl_force_flattened_io_blocks = false;
@@ -609,6 +660,14 @@ struct CLIArguments
 	bool emit_line_directives = false;
 	bool enable_storage_image_qualifier_deduction = true;
 	bool force_zero_initialized_variables = false;
+	bool predict_temporaries = false;
+	bool compact_output = false;
+	bool eliminate_common_subexpressions = false;
+	bool glsl_infer_relaxed_precision = false;
+	bool pad_workgroup_arrays = false;
+	bool alias_workgroup_variables = false;
+	Compiler::CompileBudget compile_budget;
+	SmallVector<SpecializationConstantValue> fold_spec_constants;
 	SmallVector<uint32_t> msl_discrete_descriptor_sets;
 	SmallVector<uint32_t> msl_device_argument_buffers;
 	SmallVector<pair<uint32_t, uint32_t>> msl_dynamic_buffers;
@@ -644,6 +703,7 @@ struct CLIArguments
 	bool hlsl_enable_16bit_types = false;
 	bool hlsl_flatten_matrix_vertex_input_semantics = false;
 	HLSLBindingFlags hlsl_binding_flags = 0;
+	const char *hlsl_root_signature_output = nullptr;
 	bool vulkan_semantics = false;
 	bool flatten_multidimensional_arrays = false;
 	bool use_420pack_extension = true;
@@ -668,7 +728,7 @@ static void print_help_backend()
 	        "\t[--vulkan-semantics] or [-V]:\n\t\tEmit Vulkan GLSL instead of plain GLSL. Makes use of Vulkan-only features to match SPIR-V.\n"
 	        "\t[--msl]:\n\t\tEmit Metal Shading Language (MSL).\n"
 	        "\t[--hlsl]:\n\t\tEmit HLSL.\n"
-	        "\t[--reflect]:\n\t\tEmit JSON reflection.\n"
+	        "\t[--reflect [json|binary]]:\n\t\tEmit JSON reflection, or the same data in the compact binary format described in spirv_reflect.hpp.\n"
 	        "\t[--cpp]:\n\t\tDEPRECATED. Emits C++ code.\n"
 	);
 	// clang-format on
@@ -682,6 +742,8 @@ static void print_help_glsl()
 	                "\t[--no-es]:\n\t\tForce desktop GLSL.\n"
 	                "\t[--version <GLSL version>]:\n\t\tE.g. --version 450 will emit '#version 450' in shader.\n"
 	                "\t\tCode generation will depend on the version used.\n"
+	                "\t[--repack-ubo]:\n\t\tReorder and pack the members of every UBO into 16-byte registers to minimize its size.\n"
+	                "\t\tThe new member offsets are reported by --reflect.\n"
 	                "\t[--flatten-ubo]:\n\t\tEmit UBOs as plain uniform arrays which are suitable for use with glUniform4*v().\n"
 	                "\t\tThis can be an optimization on GL implementations where this is faster or works around buggy driver implementations.\n"
 	                "\t\tE.g.: uniform MyUBO { vec4 a; float b, c, d, e; }; will be emitted as uniform vec4 MyUBO[2];\n"
@@ -717,6 +779,8 @@ static void print_help_glsl()
 	                "\t[--remap-variable-type <variable_name> <new_variable_type>]:\n\t\tRemaps a variable type based on name.\n"
 	                "\t\tPrimary use case is supporting external samplers in ESSL for video rendering on Android where you could remap a texture to a YUV one.\n"
 	                "\t[--glsl-force-flattened-io-blocks]:\n\t\tAlways flatten I/O blocks and structs.\n"
+	                "\t[--glsl-infer-relaxed-precision]:\n\t\tIn ES and Vulkan GLSL, infer which float values can be declared mediump.\n"
+	                "\t\tThe chosen values are listed by --dump-resources.\n"
 	);
 	// clang-format on
 }
@@ -742,6 +806,8 @@ static void print_help_hlsl()
 	                "\t\tOtherwise, TEXCOORD# is used as semantics, where # is location.\n"
 	                "\t[--hlsl-enable-16bit-types]:\n\t\tEnables native use of half/int16_t/uint16_t and ByteAddressBuffer interaction with these types. Requires SM 6.2.\n"
 	                "\t[--hlsl-flatten-matrix-vertex-input-semantics]:\n\t\tEmits matrix vertex inputs with input semantics as if they were independent vectors, e.g. TEXCOORD{2,3,4} rather than matrix form TEXCOORD2_{0,1,2}.\n"
+	                "\t[--hlsl-emit-root-signature <path>]:\n\t\tWrite a root signature covering all registers declared by the shader to <path>.\n"
+	                "\t\tPush constants are placed in root constants. All resources must have a register.\n"
 	);
 	// clang-format on
 }
@@ -823,7 +889,15 @@ static void print_help_msl()
 	                "\t\tIntended for Vulkan Portability implementations where VK_EXT_subgroup_size_control is not supported or disabled.\n"
 	                "\t\tIf 0, assume variable subgroup size as actually exposed by Metal.\n"
 	                "\t[--msl-force-sample-rate-shading]:\n\t\tForce fragment shaders to run per sample.\n"
-	                "\t\tThis adds a [[sample_id]] parameter if none is already present.\n");
+	                "\t\tThis adds a [[sample_id]] parameter if none is already present.\n"
+	                "\t[--msl-helper-library <header>]:\n\t\tDo not emit spv* helper functions in the shader, include <header> instead.\n"
+	                "\t[--msl-emit-helper-library <path>]:\n\t\tWrite the helper functions required by the shader to <path>.\n"
+	                "\t\tIntended to be used together with --msl-helper-library.\n"
+	                "\t[--msl-vertex-pulling]:\n\t\tLoad vertex inputs from device buffers instead of using [[stage_in]].\n"
+	                "\t[--msl-vertex-buffer-index-base <index>]:\n\t\tThe input at location L is loaded from [[buffer(<index> + L)]].\n"
+	                "\t[--msl-vertex-attribute-buffer-index <index>]:\n\t\tBuffer index of the vertex attribute descriptions.\n"
+	                "\t[--msl-stage-tess-control-outputs]:\n\t\tKeep the control points of a tessellation control shader in threadgroup memory,\n"
+	                "\t\tand write each of them to the output buffer once.\n");
 	// clang-format on
 }
 
@@ -841,6 +915,19 @@ static void print_help_common()
 	                "\t[--force-zero-initialized-variables]:\n\t\tForces temporary variables to be initialized to zero.\n"
 	                "\t\tCan be useful in environments where compilers do not allow potentially uninitialized variables.\n"
 	                "\t\tThis usually comes up with Phi temporaries.\n"
+	                "\t[--predict-temporaries]:\n\t\tAnalyze which expressions must be flushed to temporaries before emitting code.\n"
+	                "\t\tAvoids most extra compilation passes, but the output can contain slightly different temporaries.\n"
+	                "\t[--compact-output]:\n\t\tEmit source without indentation, comments or redundant whitespace.\n"
+	                "\t[--eliminate-common-subexpressions]:\n\t\tCompute repeated expressions and loads from read-only memory once per block.\n"
+	                "\t[--max-compile-time-us <microseconds>]:\n\t\tFail if compilation takes longer than this.\n"
+	                "\t[--max-expression-size <bytes>]:\n\t\tFail if any forwarded expression grows longer than this.\n"
+	                "\t[--max-forwarding-depth <count>]:\n\t\tFail if any expression is built from more forwarded expressions than this.\n"
+	                "\t[--max-output-size <bytes>]:\n\t\tFail if any emission pass emits more source than this.\n"
+	                "\t[--pad-workgroup-arrays]:\n\t\tPad the rows of shared arrays which would cause memory bank conflicts when indexed by invocation.\n"
+	                "\t[--alias-workgroup-variables]:\n\t\tLet shared variables whose lifetimes are separated by barriers share storage.\n"
+	                "\t\tThe resulting shared memory size is reported by --reflect.\n"
+	                "\t[--fold-spec-constant <constant id> <value>]:\n\t\tBakes the value (raw bits) of a specialization constant into the shader.\n"
+	                "\t\tBranches which become constant are removed, only the path taken is emitted.\n"
 	                "\t[--fixup-clipspace]:\n\t\tFixup Z clip-space at the end of a vertex shader. The behavior is backend-dependent.\n"
 	                "\t\tGLSL: Rewrites [0, w] Z range (D3D/Metal/Vulkan) to GL-style [-w, w].\n"
 	                "\t\tHLSL/MSL: Rewrites [-w, w] Z range (GL) to D3D/Metal/Vulkan-style [0, w].\n"
@@ -862,6 +949,8 @@ static void print_help_obscure()
 	                "\t\tdo not attempt to analyze usage, and always emit read/write state.\n"
 	                "\t[--flatten-multidimensional-arrays]:\n\t\tDo not support multi-dimensional arrays and flatten them to one dimension.\n"
 	                "\t[--cpp-interface-name <name>]:\n\t\tEmit a specific class name in C++ codegen.\n"
+	                "\t[--cpp-batched-invocations]:\n\t\tRun the invocations of a compute workgroup one after the "
+	                "other on a single thread in C++ codegen.\n\t\tbarrier() may only be used in the entry point.\n"
 	);
 	// clang-format on
 }
@@ -874,7 +963,12 @@ static void print_help()
 	fprintf(stderr, "Usage: spirv-cross <...>\n"
 	                "\nBasic:\n"
 	                "\t[SPIR-V file] (- is stdin)\n"
+	                "\t\tMore than one SPIR-V file can be given, in which case all files are compiled in parallel with the same options.\n"
 	                "\t[--output <output path>]: If not provided, prints output to stdout.\n"
+	                "\t[--output-dir <directory>]:\n\t\tWith multiple SPIR-V files, writes each output to <directory>/<file name>.<backend extension>.\n"
+	                "\t\tIf not provided, all outputs are printed to stdout in order.\n"
+	                "\t[--jobs <count>]:\n\t\tNumber of threads to use for multiple SPIR-V files. Defaults to one per hardware thread.\n"
+	                "\t[--analysis-threads <count>]:\n\t\tAnalyze the functions of a SPIR-V file on <count> threads.\n"
 	                "\t[--dump-resources]:\n\t\tPrints a basic reflection of the SPIR-V module along with other output.\n"
 	                "\t[--help]:\n\t\tPrints this help message.\n"
 	);
@@ -1011,24 +1105,23 @@ static HLSLBindingFlags hlsl_resource_type_to_flag(const std::string &arg)
 	}
 }
 
-static string compile_iteration(const CLIArguments &args, std::vector<uint32_t> spirv_file)
+static unique_ptr<CompilerGLSL> create_compiler(const CLIArguments &args, ParsedIR &&ir, ShaderResources &res)
 {
-	Parser spirv_parser(move(spirv_file));
-	spirv_parser.parse();
-
 	unique_ptr<CompilerGLSL> compiler;
 	bool combined_image_samplers = false;
 	bool build_dummy_sampler = false;
 
 	if (args.cpp)
 	{
-		compiler.reset(new CompilerCPP(move(spirv_parser.get_parsed_ir())));
+		compiler.reset(new CompilerCPP(move(ir)));
 		if (args.cpp_interface_name)
 			static_cast<CompilerCPP *>(compiler.get())->set_interface_name(args.cpp_interface_name);
+		if (args.cpp_batched_invocations)
+			static_cast<CompilerCPP *>(compiler.get())->set_batched_invocations(true);
 	}
 	else if (args.msl)
 	{
-		compiler.reset(new CompilerMSL(move(spirv_parser.get_parsed_ir())));
+		compiler.reset(new CompilerMSL(move(ir)));
 
 		auto *msl_comp = static_cast<CompilerMSL *>(compiler.get());
 		auto msl_opts = msl_comp->get_msl_options();
@@ -1069,7 +1162,14 @@ static string compile_iteration(const CLIArguments &args, std::vector<uint32_t>
 		msl_opts.emulate_subgroups = args.msl_emulate_subgroups;
 		msl_opts.fixed_subgroup_size = args.msl_fixed_subgroup_size;
 		msl_opts.force_sample_rate_shading = args.msl_force_sample_rate_shading;
+		msl_opts.use_helper_library = args.msl_helper_library_include != nullptr;
+		msl_opts.vertex_pulling = args.msl_vertex_pulling;
+		msl_opts.vertex_buffer_index_base = args.msl_vertex_buffer_index_base;
+		msl_opts.vertex_attribute_buffer_index = args.msl_vertex_attribute_buffer_index;
+		msl_opts.stage_tess_control_outputs_in_threadgroup = args.msl_stage_tess_control_outputs;
 		msl_comp->set_msl_options(msl_opts);
+		if (args.msl_helper_library_include)
+			msl_comp->set_helper_library_include(args.msl_helper_library_include);
 		for (auto &v : args.msl_discrete_descriptor_sets)
 			msl_comp->add_discrete_descriptor_set(v);
 		for (auto &v : args.msl_device_argument_buffers)
@@ -1083,13 +1183,13 @@ static string compile_iteration(const CLIArguments &args, std::vector<uint32_t>
 			msl_comp->add_msl_shader_input(v);
 	}
 	else if (args.hlsl)
-		compiler.reset(new CompilerHLSL(move(spirv_parser.get_parsed_ir())));
+		compiler.reset(new CompilerHLSL(move(ir)));
 	else
 	{
 		combined_image_samplers = !args.vulkan_semantics;
 		if (!args.vulkan_semantics || args.vulkan_glsl_disable_ext_samplerless_texture_functions)
 			build_dummy_sampler = true;
-		compiler.reset(new CompilerGLSL(move(spirv_parser.get_parsed_ir())));
+		compiler.reset(new CompilerGLSL(move(ir)));
 	}
 
 	if (!args.variable_type_remaps.empty())
@@ -1181,6 +1281,13 @@ static string compile_iteration(const CLIArguments &args, std::vector<uint32_t>
 	if (!entry_point.empty())
 		compiler->set_entry_point(entry_point, model);
 
+	if (!args.fold_spec_constants.empty())
+		compiler->fold_specialization_constants(args.fold_spec_constants);
+	if (args.pad_workgroup_arrays)
+		compiler->pad_workgroup_arrays();
+	if (args.alias_workgroup_variables)
+		compiler->alias_workgroup_variables();
+
 	if (!args.set_version && !compiler->get_common_options().version)
 	{
 		fprintf(stderr, "Didn't specify GLSL version and SPIR-V did not specify language.\n");
@@ -1207,6 +1314,10 @@ static string compile_iteration(const CLIArguments &args, std::vector<uint32_t>
 	opts.emit_line_directives = args.emit_line_directives;
 	opts.enable_storage_image_qualifier_deduction = args.enable_storage_image_qualifier_deduction;
 	opts.force_zero_initialized_variables = args.force_zero_initialized_variables;
+	opts.predict_temporaries = args.predict_temporaries;
+	opts.compact_output = args.compact_output;
+	opts.eliminate_common_subexpressions = args.eliminate_common_subexpressions;
+	opts.infer_relaxed_precision = args.glsl_infer_relaxed_precision;
 	compiler->set_common_options(opts);
 
 	for (auto &fetch : args.glsl_ext_framebuffer_fetch)
@@ -1261,7 +1372,6 @@ static string compile_iteration(const CLIArguments &args, std::vector<uint32_t>
 		}
 	}
 
-	ShaderResources res;
 	if (args.remove_unused)
 	{
 		auto active = compiler->get_active_interface_variables();
@@ -1271,6 +1381,10 @@ static string compile_iteration(const CLIArguments &args, std::vector<uint32_t>
 	else
 		res = compiler->get_shader_resources();
 
+	if (args.repack_ubo)
+		for (auto &ubo : res.uniform_buffers)
+			compiler->repack_buffer_block(ubo.id);
+
 	if (args.flatten_ubo)
 	{
 		for (auto &ubo : res.uniform_buffers)
@@ -1342,6 +1456,25 @@ static string compile_iteration(const CLIArguments &args, std::vector<uint32_t>
 			static_cast<CompilerHLSL *>(compiler.get())->add_vertex_attribute_remap(remap);
 	}
 
+	return compiler;
+}
+
+static string compile_iteration(const CLIArguments &args, std::vector<uint32_t> spirv_file)
+{
+	Parser spirv_parser(move(spirv_file));
+	spirv_parser.parse();
+
+	ShaderResources res;
+	auto compiler = create_compiler(args, move(spirv_parser.get_parsed_ir()), res);
+
+	unique_ptr<ThreadPool> analysis_pool;
+	if (args.analysis_threads != 0)
+	{
+		analysis_pool.reset(new ThreadPool(args.analysis_threads));
+		compiler->set_analysis_thread_pool(analysis_pool.get());
+	}
+
+	compiler->set_compile_budget(args.compile_budget);
 	auto ret = compiler->compile();
 
 	if (args.dump_resources)
@@ -1350,6 +1483,123 @@ static string compile_iteration(const CLIArguments &args, std::vector<uint32_t>
 		print_push_constant_resources(*compiler, res.push_constant_buffers);
 		print_spec_constants(*compiler);
 		print_capabilities_and_extensions(*compiler);
+		if (args.glsl_infer_relaxed_precision)
+			print_inferred_relaxed_precision(*compiler);
+		fprintf(stderr, "Compile passes: %u\n\n", compiler->get_compile_pass_count());
+	}
+
+	if (args.msl && args.msl_helper_library_output)
+	{
+		auto library = static_cast<CompilerMSL *>(compiler.get())->compile_helper_library();
+		if (!write_string_to_file(args.msl_helper_library_output, library.c_str()))
+			THROW("Failed to write MSL helper library.");
+	}
+
+	if (args.hlsl && args.hlsl_root_signature_output)
+	{
+		auto &hlsl = *static_cast<CompilerHLSL *>(compiler.get());
+		auto root_signature = CompilerHLSL::root_signature_to_string(hlsl.get_root_signature());
+		if (!write_string_to_file(args.hlsl_root_signature_output, root_signature.c_str()))
+			THROW("Failed to write HLSL root signature.");
+	}
+
+	return ret;
+}
+
+static unique_ptr<Compiler> create_reflection_compiler(const CLIArguments &args, ParsedIR &&ir)
+{
+	auto *compiler = new CompilerReflection(move(ir));
+	compiler->set_format(args.reflect);
+	if (args.repack_ubo)
+		for (auto &ubo : compiler->get_shader_resources().uniform_buffers)
+			compiler->repack_buffer_block(ubo.id);
+	if (args.pad_workgroup_arrays)
+		compiler->pad_workgroup_arrays();
+	if (args.alias_workgroup_variables)
+		compiler->alias_workgroup_variables();
+	return unique_ptr<Compiler>(compiler);
+}
+
+static const char *get_output_extension(const CLIArguments &args)
+{
+	if (args.reflect == "binary")
+		return "spvr";
+	else if (!args.reflect.empty())
+		return "json";
+	else if (args.cpp)
+		return "cpp";
+	else if (args.msl)
+		return "msl";
+	else if (args.hlsl)
+		return "hlsl";
+	else
+		return "glsl";
+}
+
+static int compile_batch(const CLIArguments &args)
+{
+	if (args.output)
+	{
+		fprintf(stderr, "Cannot use --output with multiple input files, use --output-dir instead.\n");
+		return EXIT_FAILURE;
+	}
+
+	if (args.dump_resources || args.iterations != 1)
+	{
+		fprintf(stderr, "Cannot use --dump-resources or --iterations with multiple input files.\n");
+		return EXIT_FAILURE;
+	}
+
+	SmallVector<vector<uint32_t>> spirv_files;
+	spirv_files.reserve(args.inputs.size());
+	for (auto *input : args.inputs)
+	{
+		spirv_files.push_back(read_spirv_file(input));
+		if (spirv_files.back().empty())
+			return EXIT_FAILURE;
+	}
+
+	SmallVector<BatchCompiler::Job> jobs(spirv_files.size());
+	for (size_t i = 0; i < jobs.size(); i++)
+	{
+		jobs[i].spirv = spirv_files[i].data();
+		jobs[i].word_count = spirv_files[i].size();
+		jobs[i].create_compiler = [&args](ParsedIR &&ir) -> unique_ptr<Compiler> {
+			if (!args.reflect.empty())
+				return create_reflection_compiler(args, move(ir));
+
+			ShaderResources res;
+			return create_compiler(args, move(ir), res);
+		};
+	}
+
+	BatchCompiler batch(args.jobs);
+	auto results = batch.compile(jobs.data(), jobs.size());
+
+	int ret = EXIT_SUCCESS;
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		auto &result = results[i];
+		if (!result.success)
+		{
+			fprintf(stderr, "%s: %s\n", args.inputs[i], result.error.c_str());
+			ret = EXIT_FAILURE;
+		}
+		else if (args.output_dir)
+		{
+			string name = args.inputs[i];
+			auto slash = name.find_last_of("/\\");
+			if (slash != string::npos)
+				name = name.substr(slash + 1);
+
+			auto path = join(args.output_dir, "/", name, ".", get_output_extension(args));
+			bool written = args.reflect == "binary" ? write_binary_to_file(path.c_str(), result.source) :
+			                                          write_string_to_file(path.c_str(), result.source.c_str());
+			if (!written)
+				ret = EXIT_FAILURE;
+		}
+		else
+			printf("%s", result.source.c_str());
 	}
 
 	return ret;
@@ -1369,6 +1619,9 @@ static int main_inner(int argc, char *argv[])
 		parser.end();
 	});
 	cbs.add("--output", [&args](CLIParser &parser) { args.output = parser.next_string(); });
+	cbs.add("--output-dir", [&args](CLIParser &parser) { args.output_dir = parser.next_string(); });
+	cbs.add("--jobs", [&args](CLIParser &parser) { args.jobs = parser.next_uint(); });
+	cbs.add("--analysis-threads", [&args](CLIParser &parser) { args.analysis_threads = parser.next_uint(); });
 	cbs.add("--es", [&args](CLIParser &) {
 		args.es = true;
 		args.set_es = true;
@@ -1384,16 +1637,19 @@ static int main_inner(int argc, char *argv[])
 	cbs.add("--dump-resources", [&args](CLIParser &) { args.dump_resources = true; });
 	cbs.add("--force-temporary", [&args](CLIParser &) { args.force_temporary = true; });
 	cbs.add("--flatten-ubo", [&args](CLIParser &) { args.flatten_ubo = true; });
+	cbs.add("--repack-ubo", [&args](CLIParser &) { args.repack_ubo = true; });
 	cbs.add("--fixup-clipspace", [&args](CLIParser &) { args.fixup = true; });
 	cbs.add("--flip-vert-y", [&args](CLIParser &) { args.yflip = true; });
 	cbs.add("--iterations", [&args](CLIParser &parser) { args.iterations = parser.next_uint(); });
 	cbs.add("--cpp", [&args](CLIParser &) { args.cpp = true; });
 	cbs.add("--reflect", [&args](CLIParser &parser) { args.reflect = parser.next_value_string("json"); });
 	cbs.add("--cpp-interface-name", [&args](CLIParser &parser) { args.cpp_interface_name = parser.next_string(); });
+	cbs.add("--cpp-batched-invocations", [&args](CLIParser &) { args.cpp_batched_invocations = true; });
 	cbs.add("--metal", [&args](CLIParser &) { args.msl = true; }); // Legacy compatibility
 	cbs.add("--glsl-emit-push-constant-as-ubo", [&args](CLIParser &) { args.glsl_emit_push_constant_as_ubo = true; });
 	cbs.add("--glsl-emit-ubo-as-plain-uniforms", [&args](CLIParser &) { args.glsl_emit_ubo_as_plain_uniforms = true; });
 	cbs.add("--glsl-force-flattened-io-blocks", [&args](CLIParser &) { args.glsl_force_flattened_io_blocks = true; });
+	cbs.add("--glsl-infer-relaxed-precision", [&args](CLIParser &) { args.glsl_infer_relaxed_precision = true; });
 	cbs.add("--glsl-remap-ext-framebuffer-fetch", [&args](CLIParser &parser) {
 		uint32_t input_index = parser.next_uint();
 		uint32_t color_attachment = parser.next_uint();
@@ -1405,6 +1661,25 @@ static int main_inner(int argc, char *argv[])
 	        [&args](CLIParser &) { args.enable_storage_image_qualifier_deduction = false; });
 	cbs.add("--force-zero-initialized-variables",
 	        [&args](CLIParser &) { args.force_zero_initialized_variables = true; });
+	cbs.add("--predict-temporaries", [&args](CLIParser &) { args.predict_temporaries = true; });
+	cbs.add("--compact-output", [&args](CLIParser &) { args.compact_output = true; });
+	cbs.add("--eliminate-common-subexpressions",
+	        [&args](CLIParser &) { args.eliminate_common_subexpressions = true; });
+	cbs.add("--max-compile-time-us",
+	        [&args](CLIParser &parser) { args.compile_budget.max_time_us = parser.next_uint(); });
+	cbs.add("--max-expression-size",
+	        [&args](CLIParser &parser) { args.compile_budget.max_expression_size = parser.next_uint(); });
+	cbs.add("--max-forwarding-depth",
+	        [&args](CLIParser &parser) { args.compile_budget.max_forwarding_depth = parser.next_uint(); });
+	cbs.add("--max-output-size",
+	        [&args](CLIParser &parser) { args.compile_budget.max_output_size = parser.next_uint(); });
+	cbs.add("--pad-workgroup-arrays", [&args](CLIParser &) { args.pad_workgroup_arrays = true; });
+	cbs.add("--alias-workgroup-variables", [&args](CLIParser &) { args.alias_workgroup_variables = true; });
+	cbs.add("--fold-spec-constant", [&args](CLIParser &parser) {
+		uint32_t constant_id = parser.next_uint();
+		uint32_t value = parser.next_uint();
+		args.fold_spec_constants.push_back({ constant_id, value });
+	});
 	cbs.add("--msl", [&args](CLIParser &) { args.msl = true; });
 	cbs.add("--hlsl", [&args](CLIParser &) { args.hlsl = true; });
 	cbs.add("--hlsl-enable-compat", [&args](CLIParser &) { args.hlsl_compat = true; });
@@ -1420,6 +1695,8 @@ static int main_inner(int argc, char *argv[])
 	cbs.add("--hlsl-enable-16bit-types", [&args](CLIParser &) { args.hlsl_enable_16bit_types = true; });
 	cbs.add("--hlsl-flatten-matrix-vertex-input-semantics",
 	        [&args](CLIParser &) { args.hlsl_flatten_matrix_vertex_input_semantics = true; });
+	cbs.add("--hlsl-emit-root-signature",
+	        [&args](CLIParser &parser) { args.hlsl_root_signature_output = parser.next_string(); });
 	cbs.add("--vulkan-semantics", [&args](CLIParser &) { args.vulkan_semantics = true; });
 	cbs.add("-V", [&args](CLIParser &) { args.vulkan_semantics = true; });
 	cbs.add("--flatten-multidimensional-arrays", [&args](CLIParser &) { args.flatten_multidimensional_arrays = true; });
@@ -1502,6 +1779,16 @@ static int main_inner(int argc, char *argv[])
 	cbs.add("--msl-fixed-subgroup-size",
 	        [&args](CLIParser &parser) { args.msl_fixed_subgroup_size = parser.next_uint(); });
 	cbs.add("--msl-force-sample-rate-shading", [&args](CLIParser &) { args.msl_force_sample_rate_shading = true; });
+	cbs.add("--msl-helper-library",
+	        [&args](CLIParser &parser) { args.msl_helper_library_include = parser.next_string(); });
+	cbs.add("--msl-emit-helper-library",
+	        [&args](CLIParser &parser) { args.msl_helper_library_output = parser.next_string(); });
+	cbs.add("--msl-vertex-pulling", [&args](CLIParser &) { args.msl_vertex_pulling = true; });
+	cbs.add("--msl-vertex-buffer-index-base",
+	        [&args](CLIParser &parser) { args.msl_vertex_buffer_index_base = parser.next_uint(); });
+	cbs.add("--msl-vertex-attribute-buffer-index",
+	        [&args](CLIParser &parser) { args.msl_vertex_attribute_buffer_index = parser.next_uint(); });
+	cbs.add("--msl-stage-tess-control-outputs", [&args](CLIParser &) { args.msl_stage_tess_control_outputs = true; });
 	cbs.add("--extension", [&args](CLIParser &parser) { args.extensions.push_back(parser.next_string()); });
 	cbs.add("--rename-entry-point", [&args](CLIParser &parser) {
 		auto old_name = parser.next_string();
@@ -1571,8 +1858,14 @@ static int main_inner(int argc, char *argv[])
 	cbs.add("--no-support-nonzero-baseinstance", [&](CLIParser &) { args.support_nonzero_baseinstance = false; });
 	cbs.add("--emit-line-directives", [&args](CLIParser &) { args.emit_line_directives = true; });
 
-	cbs.default_handler = [&args](const char *value) { args.input = value; };
-	cbs.add("-", [&args](CLIParser &) { args.input = "-"; });
+	cbs.default_handler = [&args](const char *value) {
+		args.input = value;
+		args.inputs.push_back(value);
+	};
+	cbs.add("-", [&args](CLIParser &) {
+		args.input = "-";
+		args.inputs.push_back("-");
+	});
 	cbs.error_handler = [] { print_help(); };
 
 	CLIParser parser{ move(cbs), argc - 1, argv + 1 };
@@ -1588,6 +1881,9 @@ static int main_inner(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
+	if (args.inputs.size() > 1)
+		return compile_batch(args);
+
 	auto spirv_file = read_spirv_file(args.input);
 	if (spirv_file.empty())
 		return EXIT_FAILURE;
@@ -1598,13 +1894,24 @@ static int main_inner(int argc, char *argv[])
 		Parser spirv_parser(move(spirv_file));
 		spirv_parser.parse();
 
-		CompilerReflection compiler(move(spirv_parser.get_parsed_ir()));
-		compiler.set_format(args.reflect);
-		auto json = compiler.compile();
+		auto compiler = create_reflection_compiler(args, move(spirv_parser.get_parsed_ir()));
+
+		// Stream the output instead of building it in memory first.
+		FILE *file = stdout;
 		if (args.output)
-			write_string_to_file(args.output, json.c_str());
-		else
-			printf("%s", json.c_str());
+		{
+			file = fopen(args.output, args.reflect == "binary" ? "wb" : "w");
+			if (!file)
+			{
+				fprintf(stderr, "Failed to write file: %s\n", args.output);
+				return EXIT_FAILURE;
+			}
+		}
+
+		FileReflectionSink sink(file);
+		static_cast<CompilerReflection &>(*compiler).compile(sink);
+		if (file != stdout)
+			fclose(file);
 		return EXIT_SUCCESS;
 	}
 
@@ -23,9 +23,9 @@ void frag_main()
     FragColor = 0.0f.xxxx;
     FragColor += uTextures[2].Sample(uSamplers[1], vTex);
     FragColor += uSampler[vIndex].Sample(_uSampler_sampler[vIndex], vTex);
-    FragColor += uSampler[vIndex].Sample(_uSampler_sampler[vIndex], vTex + 0.100000001490116119384765625f.xx);
-    FragColor += uSampler[vIndex].Sample(_uSampler_sampler[vIndex], vTex + 0.20000000298023223876953125f.xx);
-    FragColor += uSampler[3].Sample(_uSampler_sampler[3], vTex + 0.300000011920928955078125f.xx);
+    FragColor += uSampler[vIndex].Sample(_uSampler_sampler[vIndex], vTex + 0.1f.xx);
+    FragColor += uSampler[vIndex].Sample(_uSampler_sampler[vIndex], vTex + 0.2f.xx);
+    FragColor += uSampler[3].Sample(_uSampler_sampler[3], vTex + 0.3f.xx);
 }
 
 SPIRV_Cross_Output main(SPIRV_Cross_Input stage_input)
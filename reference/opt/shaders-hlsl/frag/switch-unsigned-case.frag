@@ -18,12 +18,12 @@ void frag_main()
     {
         case 0u:
         {
-            fsout_Color = 0.100000001490116119384765625f.xxxx;
+            fsout_Color = 0.1f.xxxx;
             break;
         }
         case 1u:
         {
-            fsout_Color = 0.20000000298023223876953125f.xxxx;
+            fsout_Color = 0.2f.xxxx;
             break;
         }
     }
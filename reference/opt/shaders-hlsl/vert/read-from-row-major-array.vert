@@ -22,7 +22,7 @@ struct SPIRV_Cross_Output
 void vert_main()
 {
     gl_Position = a_position;
-    v_vtxResult = ((float(abs(_104_var[0][0][0].x - 2.0f) < 0.0500000007450580596923828125f) * float(abs(_104_var[0][0][0].y - 6.0f) < 0.0500000007450580596923828125f)) * float(abs(_104_var[0][0][0].z - (-6.0f)) < 0.0500000007450580596923828125f)) * ((float(abs(_104_var[0][0][1].x) < 0.0500000007450580596923828125f) * float(abs(_104_var[0][0][1].y - 5.0f) < 0.0500000007450580596923828125f)) * float(abs(_104_var[0][0][1].z - 5.0f) < 0.0500000007450580596923828125f));
+    v_vtxResult = ((float(abs(_104_var[0][0][0].x - 2.0f) < 0.05f) * float(abs(_104_var[0][0][0].y - 6.0f) < 0.05f)) * float(abs(_104_var[0][0][0].z - (-6.0f)) < 0.05f)) * ((float(abs(_104_var[0][0][1].x) < 0.05f) * float(abs(_104_var[0][0][1].y - 5.0f) < 0.05f)) * float(abs(_104_var[0][0][1].z - 5.0f) < 0.05f));
 }
 
 SPIRV_Cross_Output main(SPIRV_Cross_Input stage_input)
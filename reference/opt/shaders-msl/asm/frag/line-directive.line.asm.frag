@@ -36,9 +36,9 @@ fragment main0_out main0(main0_in in [[stage_in]])
     for (int _127 = 0; float(_127) < (40.0 + in.vColor); )
     {
 #line 21 "test.frag"
-        out.FragColor += 0.20000000298023223876953125;
+        out.FragColor += 0.2;
 #line 22 "test.frag"
-        out.FragColor += 0.300000011920928955078125;
+        out.FragColor += 0.3;
 #line 19 "test.frag"
         _127 += (int(in.vColor) + 5);
         continue;
@@ -49,21 +49,21 @@ fragment main0_out main0(main0_in in [[stage_in]])
         case 0:
         {
 #line 28 "test.frag"
-            out.FragColor += 0.20000000298023223876953125;
+            out.FragColor += 0.2;
 #line 29 "test.frag"
             break;
         }
         case 1:
         {
 #line 32 "test.frag"
-            out.FragColor += 0.4000000059604644775390625;
+            out.FragColor += 0.4;
 #line 33 "test.frag"
             break;
         }
         default:
         {
 #line 36 "test.frag"
-            out.FragColor += 0.800000011920928955078125;
+            out.FragColor += 0.8;
 #line 37 "test.frag"
             break;
         }
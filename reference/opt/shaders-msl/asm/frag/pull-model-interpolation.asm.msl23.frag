@@ -109,14 +109,14 @@ fragment main0_out main0(main0_in in [[stage_in]], uint gl_SampleID [[sample_id]
     out.FragColor = in.foo.interpolate_at_center();
     out.FragColor += in.foo.interpolate_at_centroid();
     out.FragColor += in.foo.interpolate_at_sample(in.sid);
-    out.FragColor += in.foo.interpolate_at_offset(float2(0.100000001490116119384765625) + 0.4375);
+    out.FragColor += in.foo.interpolate_at_offset(float2(0.1) + 0.4375);
     float3 _65 = out.FragColor.xyz + in.bar.interpolate_at_centroid();
     out.FragColor = float4(_65.x, _65.y, _65.z, out.FragColor.w);
     float3 _71 = out.FragColor.xyz + in.bar.interpolate_at_centroid();
     out.FragColor = float4(_71.x, _71.y, _71.z, out.FragColor.w);
     float3 _78 = out.FragColor.xyz + in.bar.interpolate_at_sample(in.sid);
     out.FragColor = float4(_78.x, _78.y, _78.z, out.FragColor.w);
-    float3 _84 = out.FragColor.xyz + in.bar.interpolate_at_offset(float2(-0.100000001490116119384765625) + 0.4375);
+    float3 _84 = out.FragColor.xyz + in.bar.interpolate_at_offset(float2(-0.1) + 0.4375);
     out.FragColor = float4(_84.x, _84.y, _84.z, out.FragColor.w);
     float2 _91 = out.FragColor.xy + b[0];
     out.FragColor = float4(_91.x, _91.y, out.FragColor.z, out.FragColor.w);
@@ -124,7 +124,7 @@ fragment main0_out main0(main0_in in [[stage_in]], uint gl_SampleID [[sample_id]
     out.FragColor = float4(_98.x, _98.y, out.FragColor.z, out.FragColor.w);
     float2 _105 = out.FragColor.xy + in.b_0.interpolate_at_sample(2);
     out.FragColor = float4(_105.x, _105.y, out.FragColor.z, out.FragColor.w);
-    float2 _112 = out.FragColor.xy + in.b_1.interpolate_at_offset(float2(-0.100000001490116119384765625, 0.100000001490116119384765625) + 0.4375);
+    float2 _112 = out.FragColor.xy + in.b_1.interpolate_at_offset(float2(-0.1, 0.1) + 0.4375);
     out.FragColor = float4(_112.x, _112.y, out.FragColor.z, out.FragColor.w);
     float2 _119 = out.FragColor.xy + c[0];
     out.FragColor = float4(_119.x, _119.y, out.FragColor.z, out.FragColor.w);
@@ -132,50 +132,50 @@ fragment main0_out main0(main0_in in [[stage_in]], uint gl_SampleID [[sample_id]
     out.FragColor = float4(_127.x, _127.y, out.FragColor.z, out.FragColor.w);
     float2 _135 = out.FragColor.xy + in.c_0.interpolate_at_sample(2).yx;
     out.FragColor = float4(_135.x, _135.y, out.FragColor.z, out.FragColor.w);
-    float2 _143 = out.FragColor.xy + in.c_1.interpolate_at_offset(float2(-0.100000001490116119384765625, 0.100000001490116119384765625) + 0.4375).xx;
+    float2 _143 = out.FragColor.xy + in.c_1.interpolate_at_offset(float2(-0.1, 0.1) + 0.4375).xx;
     out.FragColor = float4(_143.x, _143.y, out.FragColor.z, out.FragColor.w);
     out.FragColor += s.x;
     out.FragColor += in.m_13_x.interpolate_at_centroid();
     out.FragColor += in.m_13_x.interpolate_at_sample(in.sid);
-    out.FragColor += in.m_13_x.interpolate_at_offset(float2(0.100000001490116119384765625) + 0.4375);
+    out.FragColor += in.m_13_x.interpolate_at_offset(float2(0.1) + 0.4375);
     out.FragColor += s.y;
     out.FragColor += in.m_13_y.interpolate_at_centroid();
     out.FragColor += in.m_13_y.interpolate_at_sample(in.sid);
-    out.FragColor += in.m_13_y.interpolate_at_offset(float2(-0.100000001490116119384765625) + 0.4375);
+    out.FragColor += in.m_13_y.interpolate_at_offset(float2(-0.1) + 0.4375);
     float2 _184 = out.FragColor.xy + s.v[0];
     out.FragColor = float4(_184.x, _184.y, out.FragColor.z, out.FragColor.w);
     float2 _191 = out.FragColor.xy + in.m_13_v_1.interpolate_at_centroid();
     out.FragColor = float4(_191.x, _191.y, out.FragColor.z, out.FragColor.w);
     float2 _198 = out.FragColor.xy + in.m_13_v_0.interpolate_at_sample(2);
     out.FragColor = float4(_198.x, _198.y, out.FragColor.z, out.FragColor.w);
-    float2 _205 = out.FragColor.xy + in.m_13_v_1.interpolate_at_offset(float2(-0.100000001490116119384765625, 0.100000001490116119384765625) + 0.4375);
+    float2 _205 = out.FragColor.xy + in.m_13_v_1.interpolate_at_offset(float2(-0.1, 0.1) + 0.4375);
     out.FragColor = float4(_205.x, _205.y, out.FragColor.z, out.FragColor.w);
     out.FragColor.x += s.w[0];
     out.FragColor.x += in.m_13_w_1.interpolate_at_centroid();
     out.FragColor.x += in.m_13_w_0.interpolate_at_sample(2);
-    out.FragColor.x += in.m_13_w_1.interpolate_at_offset(float2(-0.100000001490116119384765625, 0.100000001490116119384765625) + 0.4375);
+    out.FragColor.x += in.m_13_w_1.interpolate_at_offset(float2(-0.1, 0.1) + 0.4375);
     float2 _328 = out.FragColor.xy + in.baz.interpolate_at_sample(gl_SampleID);
     out.FragColor = float4(_328.x, _328.y, out.FragColor.z, out.FragColor.w);
     out.FragColor.x += in.baz.interpolate_at_centroid().x;
     out.FragColor.y += in.baz.interpolate_at_sample(3).y;
-    out.FragColor.z += in.baz.interpolate_at_offset(float2(-0.100000001490116119384765625, 0.100000001490116119384765625) + 0.4375).y;
+    out.FragColor.z += in.baz.interpolate_at_offset(float2(-0.1, 0.1) + 0.4375).y;
     float2 _353 = out.FragColor.xy + in.a_1.interpolate_at_centroid();
     out.FragColor = float4(_353.x, _353.y, out.FragColor.z, out.FragColor.w);
     float2 _360 = out.FragColor.xy + in.a_0.interpolate_at_sample(2);
     out.FragColor = float4(_360.x, _360.y, out.FragColor.z, out.FragColor.w);
-    float2 _367 = out.FragColor.xy + in.a_1.interpolate_at_offset(float2(-0.100000001490116119384765625, 0.100000001490116119384765625) + 0.4375);
+    float2 _367 = out.FragColor.xy + in.a_1.interpolate_at_offset(float2(-0.1, 0.1) + 0.4375);
     out.FragColor = float4(_367.x, _367.y, out.FragColor.z, out.FragColor.w);
     out.FragColor += s.z;
     float2 _379 = out.FragColor.xy + in.m_13_z.interpolate_at_centroid().yy;
     out.FragColor = float4(_379.x, _379.y, out.FragColor.z, out.FragColor.w);
     float2 _387 = out.FragColor.yz + in.m_13_z.interpolate_at_sample(3).xy;
     out.FragColor = float4(out.FragColor.x, _387.x, _387.y, out.FragColor.w);
-    float2 _395 = out.FragColor.zw + in.m_13_z.interpolate_at_offset(float2(-0.100000001490116119384765625, 0.100000001490116119384765625) + 0.4375).wx;
+    float2 _395 = out.FragColor.zw + in.m_13_z.interpolate_at_offset(float2(-0.1, 0.1) + 0.4375).wx;
     out.FragColor = float4(out.FragColor.x, out.FragColor.y, _395.x, _395.y);
     out.FragColor += s.u[0];
     out.FragColor += in.m_13_u_1.interpolate_at_centroid();
     out.FragColor += in.m_13_u_0.interpolate_at_sample(2);
-    out.FragColor += in.m_13_u_1.interpolate_at_offset(float2(-0.100000001490116119384765625, 0.100000001490116119384765625) + 0.4375);
+    out.FragColor += in.m_13_u_1.interpolate_at_offset(float2(-0.1, 0.1) + 0.4375);
     return out;
 }
 
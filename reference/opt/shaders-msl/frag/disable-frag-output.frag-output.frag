@@ -28,7 +28,7 @@ fragment main0_out main0()
     buf5 = float4(0.25);
     out.buf6 = float4(0.75);
     out.buf7 = float4(1.0);
-    gl_FragDepth = 0.89999997615814208984375;
+    gl_FragDepth = 0.9;
     gl_FragStencilRefARB = uint(127);
     return out;
 }
@@ -20,9 +20,9 @@ fragment main0_out main0(main0_in in [[stage_in]], array<texture2d<float>, 4> uS
     out.FragColor = float4(0.0);
     out.FragColor += uTextures[2].sample(uSamplers[1], in.vTex);
     out.FragColor += uSampler[in.vIndex].sample(uSamplerSmplr[in.vIndex], in.vTex);
-    out.FragColor += uSampler[in.vIndex].sample(uSamplerSmplr[in.vIndex], (in.vTex + float2(0.100000001490116119384765625)));
-    out.FragColor += uSampler[in.vIndex].sample(uSamplerSmplr[in.vIndex], (in.vTex + float2(0.20000000298023223876953125)));
-    out.FragColor += uSampler[3].sample(uSamplerSmplr[3], (in.vTex + float2(0.300000011920928955078125)));
+    out.FragColor += uSampler[in.vIndex].sample(uSamplerSmplr[in.vIndex], (in.vTex + float2(0.1)));
+    out.FragColor += uSampler[in.vIndex].sample(uSamplerSmplr[in.vIndex], (in.vTex + float2(0.2)));
+    out.FragColor += uSampler[3].sample(uSamplerSmplr[3], (in.vTex + float2(0.3)));
     return out;
 }
 
@@ -21,12 +21,12 @@ fragment main0_out main0(constant Buff& _15 [[buffer(0)]])
     {
         case 0u:
         {
-            out.fsout_Color = float4(0.100000001490116119384765625);
+            out.fsout_Color = float4(0.1);
             break;
         }
         case 1u:
         {
-            out.fsout_Color = float4(0.20000000298023223876953125);
+            out.fsout_Color = float4(0.2);
             break;
         }
     }
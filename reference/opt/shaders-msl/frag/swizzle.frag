@@ -21,10 +21,10 @@ fragment main0_out main0(main0_in in [[stage_in]], texture2d<float> samp [[textu
     float _23 = _19.x;
     out.FragColor = float4(_23, _19.yz, 1.0);
     out.FragColor = float4(_23, _19.z, 1.0, 4.0);
-    out.FragColor = float4(_23, _23, samp.sample(sampSmplr, (in.vUV + float2(0.100000001490116119384765625))).yy);
+    out.FragColor = float4(_23, _23, samp.sample(sampSmplr, (in.vUV + float2(0.1))).yy);
     out.FragColor = float4(in.vNormal, 1.0);
-    out.FragColor = float4(in.vNormal + float3(1.7999999523162841796875), 1.0);
-    out.FragColor = float4(in.vUV, in.vUV + float2(1.7999999523162841796875));
+    out.FragColor = float4(in.vNormal + float3(1.8), 1.0);
+    out.FragColor = float4(in.vUV, in.vUV + float2(1.8));
     return out;
 }
 
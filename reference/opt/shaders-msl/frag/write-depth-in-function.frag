@@ -13,7 +13,7 @@ fragment main0_out main0()
 {
     main0_out out = {};
     out.FragColor = 1.0;
-    out.gl_FragDepth = 0.20000000298023223876953125;
+    out.gl_FragDepth = 0.2;
     return out;
 }
 
@@ -23,7 +23,7 @@ vertex main0_out main0(main0_in in [[stage_in]], constant Block& _104 [[buffer(0
 {
     main0_out out = {};
     out.gl_Position = in.a_position;
-    out.v_vtxResult = ((float(abs(_104.var[0][0][0][0] - 2.0) < 0.0500000007450580596923828125) * float(abs(_104.var[0][0][1][0] - 6.0) < 0.0500000007450580596923828125)) * float(abs(_104.var[0][0][2][0] - (-6.0)) < 0.0500000007450580596923828125)) * ((float(abs(_104.var[0][0][0][1]) < 0.0500000007450580596923828125) * float(abs(_104.var[0][0][1][1] - 5.0) < 0.0500000007450580596923828125)) * float(abs(_104.var[0][0][2][1] - 5.0) < 0.0500000007450580596923828125));
+    out.v_vtxResult = ((float(abs(_104.var[0][0][0][0] - 2.0) < 0.05) * float(abs(_104.var[0][0][1][0] - 6.0) < 0.05)) * float(abs(_104.var[0][0][2][0] - (-6.0)) < 0.05)) * ((float(abs(_104.var[0][0][0][1]) < 0.05) * float(abs(_104.var[0][0][1][1] - 5.0) < 0.05)) * float(abs(_104.var[0][0][2][1] - 5.0) < 0.05));
     return out;
 }
 
@@ -94,12 +94,12 @@ struct type_Globals
     float ExpandGamut;
 };
 
-constant spvUnsafeArray<float, 6> _499 = spvUnsafeArray<float, 6>({ -4.0, -4.0, -3.1573765277862548828125, -0.485249996185302734375, 1.84773242473602294921875, 1.84773242473602294921875 });
-constant spvUnsafeArray<float, 6> _500 = spvUnsafeArray<float, 6>({ -0.718548238277435302734375, 2.0810306072235107421875, 3.66812419891357421875, 4.0, 4.0, 4.0 });
-constant spvUnsafeArray<float, 10> _503 = spvUnsafeArray<float, 10>({ -4.97062206268310546875, -3.0293781757354736328125, -2.1261999607086181640625, -1.5104999542236328125, -1.0578000545501708984375, -0.4668000042438507080078125, 0.11937999725341796875, 0.7088134288787841796875, 1.2911865711212158203125, 1.2911865711212158203125 });
-constant spvUnsafeArray<float, 10> _504 = spvUnsafeArray<float, 10>({ 0.80891323089599609375, 1.19108676910400390625, 1.5683000087738037109375, 1.94830000400543212890625, 2.308300018310546875, 2.63840007781982421875, 2.85949993133544921875, 2.9872608184814453125, 3.0127391815185546875, 3.0127391815185546875 });
-constant spvUnsafeArray<float, 10> _506 = spvUnsafeArray<float, 10>({ -2.3010299205780029296875, -2.3010299205780029296875, -1.9312000274658203125, -1.5204999446868896484375, -1.0578000545501708984375, -0.4668000042438507080078125, 0.11937999725341796875, 0.7088134288787841796875, 1.2911865711212158203125, 1.2911865711212158203125 });
-constant spvUnsafeArray<float, 10> _507 = spvUnsafeArray<float, 10>({ 0.801995217800140380859375, 1.19800484180450439453125, 1.5943000316619873046875, 1.99730002880096435546875, 2.3782999515533447265625, 2.7683999538421630859375, 3.0515000820159912109375, 3.2746293544769287109375, 3.32743072509765625, 3.32743072509765625 });
+constant spvUnsafeArray<float, 6> _499 = spvUnsafeArray<float, 6>({ -4.0, -4.0, -3.1573765, -0.48525, 1.8477324, 1.8477324 });
+constant spvUnsafeArray<float, 6> _500 = spvUnsafeArray<float, 6>({ -0.71854824, 2.0810306, 3.6681242, 4.0, 4.0, 4.0 });
+constant spvUnsafeArray<float, 10> _503 = spvUnsafeArray<float, 10>({ -4.970622, -3.0293782, -2.1262, -1.5105, -1.0578, -0.4668, 0.11938, 0.7088134, 1.2911866, 1.2911866 });
+constant spvUnsafeArray<float, 10> _504 = spvUnsafeArray<float, 10>({ 0.80891323, 1.1910868, 1.5683, 1.9483, 2.3083, 2.6384, 2.8595, 2.9872608, 3.0127392, 3.0127392 });
+constant spvUnsafeArray<float, 10> _506 = spvUnsafeArray<float, 10>({ -2.30103, -2.30103, -1.9312, -1.5205, -1.0578, -0.4668, 0.11938, 0.7088134, 1.2911866, 1.2911866 });
+constant spvUnsafeArray<float, 10> _507 = spvUnsafeArray<float, 10>({ 0.8019952, 1.1980048, 1.5943, 1.9973, 2.3783, 2.7684, 3.0515, 3.2746294, 3.3274307, 3.3274307 });
 
 constant float3 _523 = {};
 constant float3 _3265 = {};
@@ -117,32 +117,32 @@ struct main0_in
 fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globals [[buffer(0)]], texture2d<float> Texture1 [[texture(0)]], sampler Texture1Sampler [[sampler(0)]], uint gl_Layer [[render_target_array_index]])
 {
     main0_out out = {};
-    float3x3 _572 = float3x3(float3(0.41245639324188232421875, 0.3575761020183563232421875, 0.180437505245208740234375), float3(0.21267290413379669189453125, 0.715152204036712646484375, 0.072175003588199615478515625), float3(0.01933390088379383087158203125, 0.119191996753215789794921875, 0.950304090976715087890625)) * float3x3(float3(1.01303005218505859375, 0.0061053098179399967193603515625, -0.014971000142395496368408203125), float3(0.0076982299797236919403076171875, 0.99816501140594482421875, -0.005032029934227466583251953125), float3(-0.0028413101099431514739990234375, 0.0046851597726345062255859375, 0.92450702190399169921875));
-    float3x3 _573 = _572 * float3x3(float3(1.6410233974456787109375, -0.324803292751312255859375, -0.23642469942569732666015625), float3(-0.663662850856781005859375, 1.6153316497802734375, 0.016756348311901092529296875), float3(0.01172189414501190185546875, -0.008284442126750946044921875, 0.98839485645294189453125));
-    float3x3 _574 = float3x3(float3(0.662454187870025634765625, 0.1340042054653167724609375, 0.1561876833438873291015625), float3(0.272228717803955078125, 0.674081742763519287109375, 0.053689517080783843994140625), float3(-0.0055746496655046939849853515625, 0.0040607335977256298065185546875, 1.01033914089202880859375)) * float3x3(float3(0.98722398281097412109375, -0.0061132698319852352142333984375, 0.01595330052077770233154296875), float3(-0.007598360069096088409423828125, 1.00186002254486083984375, 0.0053300200961530208587646484375), float3(0.003072570078074932098388671875, -0.0050959498621523380279541015625, 1.0816800594329833984375));
-    float3x3 _575 = _574 * float3x3(float3(3.2409698963165283203125, -1.53738319873809814453125, -0.4986107647418975830078125), float3(-0.96924364566802978515625, 1.875967502593994140625, 0.0415550582110881805419921875), float3(0.055630080401897430419921875, -0.2039769589900970458984375, 1.05697154998779296875));
-    float3x3 _576 = float3x3(float3(0.952552378177642822265625, 0.0, 9.25), float3(0.3439664542675018310546875, 0.728166103363037109375, -0.07213254272937774658203125), float3(0.0, 0.0, 1.00882518291473388671875)) * float3x3(float3(1.6410233974456787109375, -0.324803292751312255859375, -0.23642469942569732666015625), float3(-0.663662850856781005859375, 1.6153316497802734375, 0.016756348311901092529296875), float3(0.01172189414501190185546875, -0.008284442126750946044921875, 0.98839485645294189453125));
-    float3x3 _577 = float3x3(float3(0.662454187870025634765625, 0.1340042054653167724609375, 0.1561876833438873291015625), float3(0.272228717803955078125, 0.674081742763519287109375, 0.053689517080783843994140625), float3(-0.0055746496655046939849853515625, 0.0040607335977256298065185546875, 1.01033914089202880859375)) * float3x3(float3(1.04981100559234619140625, 0.0, -9.74845024757087230682373046875e-05), float3(-0.49590301513671875, 1.37331306934356689453125, 0.09824003279209136962890625), float3(0.0, 0.0, 0.991252005100250244140625));
+    float3x3 _572 = float3x3(float3(0.4124564, 0.3575761, 0.1804375), float3(0.2126729, 0.7151522, 0.072175), float3(0.0193339, 0.119192, 0.9503041)) * float3x3(float3(1.01303, 0.00610531, -0.014971), float3(0.00769823, 0.998165, -0.00503203), float3(-0.00284131, 0.00468516, 0.924507));
+    float3x3 _573 = _572 * float3x3(float3(1.6410234, -0.3248033, -0.2364247), float3(-0.66366285, 1.6153316, 0.016756348), float3(0.011721894, -0.008284442, 0.98839486));
+    float3x3 _574 = float3x3(float3(0.6624542, 0.1340042, 0.15618768), float3(0.27222872, 0.67408174, 0.053689517), float3(-0.0055746497, 0.0040607336, 1.0103391)) * float3x3(float3(0.987224, -0.00611327, 0.0159533), float3(-0.00759836, 1.00186, 0.00533002), float3(0.00307257, -0.00509595, 1.08168));
+    float3x3 _575 = _574 * float3x3(float3(3.24097, -1.5373832, -0.49861076), float3(-0.96924365, 1.8759675, 0.04155506), float3(0.05563008, -0.20397696, 1.0569715));
+    float3x3 _576 = float3x3(float3(0.9525524, 0.0, 9.25), float3(0.34396645, 0.7281661, -0.07213254), float3(0.0, 0.0, 1.0088252)) * float3x3(float3(1.6410234, -0.3248033, -0.2364247), float3(-0.66366285, 1.6153316, 0.016756348), float3(0.011721894, -0.008284442, 0.98839486));
+    float3x3 _577 = float3x3(float3(0.6624542, 0.1340042, 0.15618768), float3(0.27222872, 0.67408174, 0.053689517), float3(-0.0055746497, 0.0040607336, 1.0103391)) * float3x3(float3(1.049811, 0.0, -9.74845e-05), float3(-0.49590302, 1.3733131, 0.09824003), float3(0.0, 0.0, 0.991252));
     float3x3 _602;
     for (;;)
     {
         if (_Globals.OutputGamut == 1u)
         {
-            _602 = _574 * float3x3(float3(2.493396282196044921875, -0.931345880031585693359375, -0.4026944935321807861328125), float3(-0.829486787319183349609375, 1.76265966892242431640625, 0.02362460084259510040283203125), float3(0.0358506999909877777099609375, -0.076182700693607330322265625, 0.957014024257659912109375));
+            _602 = _574 * float3x3(float3(2.4933963, -0.9313459, -0.4026945), float3(-0.8294868, 1.7626597, 0.0236246), float3(0.0358507, -0.0761827, 0.957014));
             break;
         }
         else
         {
             if (_Globals.OutputGamut == 2u)
             {
-                _602 = _574 * float3x3(float3(1.71660840511322021484375, -0.3556621074676513671875, -0.253360092639923095703125), float3(-0.666682898998260498046875, 1.61647760868072509765625, 0.01576850004494190216064453125), float3(0.017642199993133544921875, -0.04277630150318145751953125, 0.94222867488861083984375));
+                _602 = _574 * float3x3(float3(1.7166084, -0.3556621, -0.2533601), float3(-0.6666829, 1.6164776, 0.0157685), float3(0.0176422, -0.0427763, 0.9422287));
                 break;
             }
             else
             {
                 if (_Globals.OutputGamut == 3u)
                 {
-                    _602 = float3x3(float3(0.695452213287353515625, 0.140678703784942626953125, 0.16386906802654266357421875), float3(0.0447945632040500640869140625, 0.859671115875244140625, 0.095534317195415496826171875), float3(-0.0055258828215301036834716796875, 0.0040252101607620716094970703125, 1.00150072574615478515625));
+                    _602 = float3x3(float3(0.6954522, 0.1406787, 0.16386907), float3(0.044794563, 0.8596711, 0.09553432), float3(-0.005525883, 0.00402521, 1.0015007));
                     break;
                 }
                 else
@@ -161,31 +161,31 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
             }
         }
     }
-    float3 _603 = float4((in.in_var_TEXCOORD0 - float2(0.015625)) * float2(1.03225803375244140625), float(gl_Layer) * 0.0322580635547637939453125, 0.0).xyz;
+    float3 _603 = float4((in.in_var_TEXCOORD0 - float2(0.015625)) * float2(1.032258), float(gl_Layer) * 0.032258064, 0.0).xyz;
     float3 _625;
     if (_Globals.OutputDevice >= 3u)
     {
-        float3 _617 = pow(_603, float3(0.0126833133399486541748046875));
-        _625 = pow(fast::max(float3(0.0), _617 - float3(0.8359375)) / (float3(18.8515625) - (float3(18.6875) * _617)), float3(6.277394771575927734375)) * float3(10000.0);
+        float3 _617 = pow(_603, float3(0.012683313));
+        _625 = pow(fast::max(float3(0.0), _617 - float3(0.8359375)) / (float3(18.851563) - (float3(18.6875) * _617)), float3(6.277395)) * float3(10000.0);
     }
     else
     {
-        _625 = (exp2((_603 - float3(0.434017598628997802734375)) * float3(14.0)) * float3(0.180000007152557373046875)) - float3(0.00266771926544606685638427734375);
+        _625 = (exp2((_603 - float3(0.4340176)) * float3(14.0)) * float3(0.18)) - float3(0.0026677193);
     }
-    float _628 = _Globals.WhiteTemp * 1.00055634975433349609375;
-    float _642 = (_628 <= 7000.0) ? (0.24406300485134124755859375 + ((99.1100006103515625 + ((2967800.0 - (4604438528.0 / _Globals.WhiteTemp)) / _628)) / _628)) : (0.23703999817371368408203125 + ((247.4799957275390625 + ((1901800.0 - (2005284352.0 / _Globals.WhiteTemp)) / _628)) / _628));
-    float _659 = ((0.860117733478546142578125 + (0.00015411825734190642833709716796875 * _Globals.WhiteTemp)) + ((1.2864121856637211749330163002014e-07 * _Globals.WhiteTemp) * _Globals.WhiteTemp)) / ((1.0 + (0.0008424202096648514270782470703125 * _Globals.WhiteTemp)) + ((7.0814513719597016461193561553955e-07 * _Globals.WhiteTemp) * _Globals.WhiteTemp));
-    float _670 = ((0.317398726940155029296875 + (4.25 * _Globals.WhiteTemp)) + ((4.2048167614439080352894961833954e-08 * _Globals.WhiteTemp) * _Globals.WhiteTemp)) / ((1.0 - (2.8974181986995972692966461181641e-05 * _Globals.WhiteTemp)) + ((1.6145605741257895715534687042236e-07 * _Globals.WhiteTemp) * _Globals.WhiteTemp));
+    float _628 = _Globals.WhiteTemp * 1.0005563;
+    float _642 = (_628 <= 7000.0) ? (0.244063 + ((99.11 + ((2967800.0 - (4604438500.0 / _Globals.WhiteTemp)) / _628)) / _628)) : (0.23704 + ((247.48 + ((1901800.0 - (2005284400.0 / _Globals.WhiteTemp)) / _628)) / _628));
+    float _659 = ((0.86011773 + (0.00015411826 * _Globals.WhiteTemp)) + ((1.2864122e-07 * _Globals.WhiteTemp) * _Globals.WhiteTemp)) / ((1.0 + (0.0008424202 * _Globals.WhiteTemp)) + ((7.0814514e-07 * _Globals.WhiteTemp) * _Globals.WhiteTemp));
+    float _670 = ((0.31739873 + (4.25 * _Globals.WhiteTemp)) + ((4.2048168e-08 * _Globals.WhiteTemp) * _Globals.WhiteTemp)) / ((1.0 - (2.8974182e-05 * _Globals.WhiteTemp)) + ((1.6145606e-07 * _Globals.WhiteTemp) * _Globals.WhiteTemp));
     float _675 = ((2.0 * _659) - (8.0 * _670)) + 4.0;
     float2 _679 = float2((3.0 * _659) / _675, (2.0 * _670) / _675);
     float2 _686 = normalize(float2(_659, _670));
-    float _691 = _659 + (((-_686.y) * _Globals.WhiteTint) * 0.0500000007450580596923828125);
-    float _695 = _670 + ((_686.x * _Globals.WhiteTint) * 0.0500000007450580596923828125);
+    float _691 = _659 + (((-_686.y) * _Globals.WhiteTint) * 0.05);
+    float _695 = _670 + ((_686.x * _Globals.WhiteTint) * 0.05);
     float _700 = ((2.0 * _691) - (8.0 * _695)) + 4.0;
-    float2 _706 = select(float2(_642, (_642 * (((-3.0) * _642) + 2.86999988555908203125)) - 0.2750000059604644775390625), _679, bool2(_Globals.WhiteTemp < 4000.0)) + (float2((3.0 * _691) / _700, (2.0 * _695) / _700) - _679);
+    float2 _706 = select(float2(_642, (_642 * (((-3.0) * _642) + 2.87)) - 0.275), _679, bool2(_Globals.WhiteTemp < 4000.0)) + (float2((3.0 * _691) / _700, (2.0 * _695) / _700) - _679);
     float _707 = _706.x;
     float _708 = _706.y;
-    float _709 = fast::max(_708, 1.0000000133514319600180897396058e-10);
+    float _709 = fast::max(_708, 1e-10);
     float3 _711 = _523;
     _711.x = _707 / _709;
     float3 _712 = _711;
@@ -193,26 +193,26 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
     float3 _716 = _712;
     _716.z = ((1.0 - _707) - _708) / _709;
     float3 _719 = _523;
-    _719.x = 0.950455963611602783203125;
+    _719.x = 0.95045596;
     float3 _720 = _719;
     _720.y = 1.0;
     float3 _722 = _720;
-    _722.z = 1.0890576839447021484375;
-    float3 _723 = _716 * float3x3(float3(0.89509999752044677734375, 0.2664000093936920166015625, -0.16140000522136688232421875), float3(-0.750199973583221435546875, 1.71350002288818359375, 0.0366999991238117218017578125), float3(0.0388999991118907928466796875, -0.06849999725818634033203125, 1.02960002422332763671875));
-    float3 _724 = _722 * float3x3(float3(0.89509999752044677734375, 0.2664000093936920166015625, -0.16140000522136688232421875), float3(-0.750199973583221435546875, 1.71350002288818359375, 0.0366999991238117218017578125), float3(0.0388999991118907928466796875, -0.06849999725818634033203125, 1.02960002422332763671875));
-    float3 _743 = (_625 * ((float3x3(float3(0.41245639324188232421875, 0.3575761020183563232421875, 0.180437505245208740234375), float3(0.21267290413379669189453125, 0.715152204036712646484375, 0.072175003588199615478515625), float3(0.01933390088379383087158203125, 0.119191996753215789794921875, 0.950304090976715087890625)) * ((float3x3(float3(0.89509999752044677734375, 0.2664000093936920166015625, -0.16140000522136688232421875), float3(-0.750199973583221435546875, 1.71350002288818359375, 0.0366999991238117218017578125), float3(0.0388999991118907928466796875, -0.06849999725818634033203125, 1.02960002422332763671875)) * float3x3(float3(_724.x / _723.x, 0.0, 0.0), float3(0.0, _724.y / _723.y, 0.0), float3(0.0, 0.0, _724.z / _723.z))) * float3x3(float3(0.986992895603179931640625, -0.14705429971218109130859375, 0.15996269881725311279296875), float3(0.4323053061962127685546875, 0.518360316753387451171875, 0.049291200935840606689453125), float3(-0.00852870009839534759521484375, 0.0400427989661693572998046875, 0.968486726284027099609375)))) * float3x3(float3(3.2409698963165283203125, -1.53738319873809814453125, -0.4986107647418975830078125), float3(-0.96924364566802978515625, 1.875967502593994140625, 0.0415550582110881805419921875), float3(0.055630080401897430419921875, -0.2039769589900970458984375, 1.05697154998779296875)))) * _573;
+    _722.z = 1.0890577;
+    float3 _723 = _716 * float3x3(float3(0.8951, 0.2664, -0.1614), float3(-0.7502, 1.7135, 0.0367), float3(0.0389, -0.0685, 1.0296));
+    float3 _724 = _722 * float3x3(float3(0.8951, 0.2664, -0.1614), float3(-0.7502, 1.7135, 0.0367), float3(0.0389, -0.0685, 1.0296));
+    float3 _743 = (_625 * ((float3x3(float3(0.4124564, 0.3575761, 0.1804375), float3(0.2126729, 0.7151522, 0.072175), float3(0.0193339, 0.119192, 0.9503041)) * ((float3x3(float3(0.8951, 0.2664, -0.1614), float3(-0.7502, 1.7135, 0.0367), float3(0.0389, -0.0685, 1.0296)) * float3x3(float3(_724.x / _723.x, 0.0, 0.0), float3(0.0, _724.y / _723.y, 0.0), float3(0.0, 0.0, _724.z / _723.z))) * float3x3(float3(0.9869929, -0.1470543, 0.1599627), float3(0.4323053, 0.5183603, 0.0492912), float3(-0.0085287, 0.0400428, 0.9684867)))) * float3x3(float3(3.24097, -1.5373832, -0.49861076), float3(-0.96924365, 1.8759675, 0.04155506), float3(0.05563008, -0.20397696, 1.0569715)))) * _573;
     float3 _771;
     if (_Globals.ColorShadow_Tint2.w != 0.0)
     {
-        float _750 = dot(_743, float3(0.272228717803955078125, 0.674081742763519287109375, 0.053689517080783843994140625));
+        float _750 = dot(_743, float3(0.27222872, 0.67408174, 0.053689517));
         float3 _753 = (_743 / float3(_750)) - float3(1.0);
-        _771 = mix(_743, _743 * (_575 * (float3x3(float3(0.544169127941131591796875, 0.23959259688854217529296875, 0.16669429838657379150390625), float3(0.23946559429168701171875, 0.702153027057647705078125, 0.058381401002407073974609375), float3(-0.0023439000360667705535888671875, 0.0361833982169628143310546875, 1.05521833896636962890625)) * float3x3(float3(1.6410233974456787109375, -0.324803292751312255859375, -0.23642469942569732666015625), float3(-0.663662850856781005859375, 1.6153316497802734375, 0.016756348311901092529296875), float3(0.01172189414501190185546875, -0.008284442126750946044921875, 0.98839485645294189453125)))), float3((1.0 - exp2((-4.0) * dot(_753, _753))) * (1.0 - exp2((((-4.0) * _Globals.ExpandGamut) * _750) * _750))));
+        _771 = mix(_743, _743 * (_575 * (float3x3(float3(0.5441691, 0.2395926, 0.1666943), float3(0.2394656, 0.702153, 0.0583814), float3(-0.0023439, 0.0361834, 1.0552183)) * float3x3(float3(1.6410234, -0.3248033, -0.2364247), float3(-0.66366285, 1.6153316, 0.016756348), float3(0.011721894, -0.008284442, 0.98839486)))), float3((1.0 - exp2((-4.0) * dot(_753, _753))) * (1.0 - exp2((((-4.0) * _Globals.ExpandGamut) * _750) * _750))));
     }
     else
     {
         _771 = _743;
     }
-    float _772 = dot(_771, float3(0.272228717803955078125, 0.674081742763519287109375, 0.053689517080783843994140625));
+    float _772 = dot(_771, float3(0.27222872, 0.67408174, 0.053689517));
     float4 _777 = _Globals.ColorSaturationShadows * _Globals.ColorSaturation;
     float4 _782 = _Globals.ColorContrastShadows * _Globals.ColorContrast;
     float4 _787 = _Globals.ColorGammaShadows * _Globals.ColorGamma;
@@ -231,35 +231,35 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
     float4 _887 = _Globals.ColorGammaMidtones * _Globals.ColorGamma;
     float4 _890 = _Globals.ColorGainMidtones * _Globals.ColorGain;
     float4 _893 = _Globals.ColorOffsetMidtones + _Globals.ColorOffset;
-    float3 _931 = ((((pow(pow(fast::max(float3(0.0), mix(_798, _771, _777.xyz * float3(_777.w))) * float3(5.5555553436279296875), _782.xyz * float3(_782.w)) * float3(0.180000007152557373046875), float3(1.0) / (_787.xyz * float3(_787.w))) * (_792.xyz * float3(_792.w))) + (_797.xyz + float3(_797.w))) * float3(1.0 - _830)) + (((pow(pow(fast::max(float3(0.0), mix(_798, _771, _881.xyz * float3(_881.w))) * float3(5.5555553436279296875), _884.xyz * float3(_884.w)) * float3(0.180000007152557373046875), float3(1.0) / (_887.xyz * float3(_887.w))) * (_890.xyz * float3(_890.w))) + (_893.xyz + float3(_893.w))) * float3(_830 - _878))) + (((pow(pow(fast::max(float3(0.0), mix(_798, _771, _834.xyz * float3(_834.w))) * float3(5.5555553436279296875), _837.xyz * float3(_837.w)) * float3(0.180000007152557373046875), float3(1.0) / (_840.xyz * float3(_840.w))) * (_843.xyz * float3(_843.w))) + (_846.xyz + float3(_846.w))) * float3(_878));
+    float3 _931 = ((((pow(pow(fast::max(float3(0.0), mix(_798, _771, _777.xyz * float3(_777.w))) * float3(5.5555553), _782.xyz * float3(_782.w)) * float3(0.18), float3(1.0) / (_787.xyz * float3(_787.w))) * (_792.xyz * float3(_792.w))) + (_797.xyz + float3(_797.w))) * float3(1.0 - _830)) + (((pow(pow(fast::max(float3(0.0), mix(_798, _771, _881.xyz * float3(_881.w))) * float3(5.5555553), _884.xyz * float3(_884.w)) * float3(0.18), float3(1.0) / (_887.xyz * float3(_887.w))) * (_890.xyz * float3(_890.w))) + (_893.xyz + float3(_893.w))) * float3(_830 - _878))) + (((pow(pow(fast::max(float3(0.0), mix(_798, _771, _834.xyz * float3(_834.w))) * float3(5.5555553), _837.xyz * float3(_837.w)) * float3(0.18), float3(1.0) / (_840.xyz * float3(_840.w))) * (_843.xyz * float3(_843.w))) + (_846.xyz + float3(_846.w))) * float3(_878));
     float3 _932 = _931 * _575;
     float3 _940 = float3(_Globals.BlueCorrection);
-    float3 _942 = mix(_931, _931 * ((_577 * float3x3(float3(0.940437257289886474609375, -0.01830687932670116424560546875, 0.07786960899829864501953125), float3(0.008378696627914905548095703125, 0.82866001129150390625, 0.162961304187774658203125), float3(0.0005471261101774871349334716796875, -0.00088337459601461887359619140625, 1.00033628940582275390625))) * _576), _940) * _577;
+    float3 _942 = mix(_931, _931 * ((_577 * float3x3(float3(0.94043726, -0.01830688, 0.07786961), float3(0.008378697, 0.82866, 0.1629613), float3(0.0005471261, -0.0008833746, 1.0003363))) * _576), _940) * _577;
     float _943 = _942.x;
     float _944 = _942.y;
     float _946 = _942.z;
     float _949 = fast::max(fast::max(_943, _944), _946);
-    float _954 = (fast::max(_949, 1.0000000133514319600180897396058e-10) - fast::max(fast::min(fast::min(_943, _944), _946), 1.0000000133514319600180897396058e-10)) / fast::max(_949, 0.00999999977648258209228515625);
+    float _954 = (fast::max(_949, 1e-10) - fast::max(fast::min(fast::min(_943, _944), _946), 1e-10)) / fast::max(_949, 0.01);
     float _967 = ((_946 + _944) + _943) + (1.75 * sqrt(((_946 * (_946 - _944)) + (_944 * (_944 - _943))) + (_943 * (_943 - _946))));
-    float _968 = _967 * 0.3333333432674407958984375;
-    float _969 = _954 - 0.4000000059604644775390625;
+    float _968 = _967 * 0.33333334;
+    float _969 = _954 - 0.4;
     float _974 = fast::max(1.0 - abs(_969 * 2.5), 0.0);
-    float _982 = (1.0 + (float(int(sign(_969 * 5.0))) * (1.0 - (_974 * _974)))) * 0.02500000037252902984619140625;
+    float _982 = (1.0 + (float(int(sign(_969 * 5.0))) * (1.0 - (_974 * _974)))) * 0.025;
     float _995;
-    if (_968 <= 0.053333334624767303466796875)
+    if (_968 <= 0.053333335)
     {
         _995 = _982;
     }
     else
     {
         float _994;
-        if (_968 >= 0.1599999964237213134765625)
+        if (_968 >= 0.16)
         {
             _994 = 0.0;
         }
         else
         {
-            _994 = _982 * ((0.23999999463558197021484375 / _967) - 0.5);
+            _994 = _982 * ((0.24 / _967) - 0.5);
         }
         _995 = _994;
     }
@@ -274,7 +274,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
     }
     else
     {
-        _1016 = 57.2957763671875 * atan2(1.73205077648162841796875 * (_1000 - _1002), ((2.0 * _999) - _1000) - _1002);
+        _1016 = 57.295776 * atan2(1.7320508 * (_1000 - _1002), ((2.0 * _999) - _1000) - _1002);
     }
     float _1021;
     if (_1016 < 0.0)
@@ -295,26 +295,26 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
     {
         _1027 = _1022;
     }
-    float _1031 = smoothstep(0.0, 1.0, 1.0 - abs(_1027 * 0.01481481455266475677490234375));
+    float _1031 = smoothstep(0.0, 1.0, 1.0 - abs(_1027 * 0.014814815));
     float3 _1038 = _998;
-    _1038.x = _999 + ((((_1031 * _1031) * _954) * (0.02999999932944774627685546875 - _999)) * 0.180000007152557373046875);
-    float3 _1040 = fast::max(float3(0.0), _1038 * float3x3(float3(1.45143926143646240234375, -0.236510753631591796875, -0.214928567409515380859375), float3(-0.07655377686023712158203125, 1.1762297153472900390625, -0.0996759235858917236328125), float3(0.0083161480724811553955078125, -0.0060324496589601039886474609375, 0.99771630764007568359375)));
+    _1038.x = _999 + ((((_1031 * _1031) * _954) * (0.03 - _999)) * 0.18);
+    float3 _1040 = fast::max(float3(0.0), _1038 * float3x3(float3(1.4514393, -0.23651075, -0.21492857), float3(-0.07655378, 1.1762297, -0.09967592), float3(0.008316148, -0.0060324497, 0.9977163)));
     float _1049 = (1.0 + _Globals.FilmBlackClip) - _Globals.FilmToe;
     float _1052 = 1.0 + _Globals.FilmWhiteClip;
     float _1055 = _1052 - _Globals.FilmShoulder;
     float _1082;
-    if (_Globals.FilmToe > 0.800000011920928955078125)
+    if (_Globals.FilmToe > 0.8)
     {
-        _1082 = ((0.819999992847442626953125 - _Globals.FilmToe) / _Globals.FilmSlope) + (-0.744727432727813720703125);
+        _1082 = ((0.82 - _Globals.FilmToe) / _Globals.FilmSlope) + (-0.74472743);
     }
     else
     {
-        float _1061 = (0.180000007152557373046875 + _Globals.FilmBlackClip) / _1049;
-        _1082 = (-0.744727432727813720703125) - ((0.5 * log(_1061 / (2.0 - _1061))) * (_1049 / _Globals.FilmSlope));
+        float _1061 = (0.18 + _Globals.FilmBlackClip) / _1049;
+        _1082 = (-0.74472743) - ((0.5 * log(_1061 / (2.0 - _1061))) * (_1049 / _Globals.FilmSlope));
     }
     float _1087 = ((1.0 - _Globals.FilmToe) / _Globals.FilmSlope) - _1082;
     float _1089 = (_Globals.FilmShoulder / _Globals.FilmSlope) - _1087;
-    float3 _1093 = log(mix(float3(dot(_1040, float3(0.272228717803955078125, 0.674081742763519287109375, 0.053689517080783843994140625))), _1040, float3(0.959999978542327880859375))) * float3(0.4342944622039794921875);
+    float3 _1093 = log(mix(float3(dot(_1040, float3(0.27222872, 0.67408174, 0.053689517))), _1040, float3(0.96))) * float3(0.43429446);
     float3 _1097 = float3(_Globals.FilmSlope) * (_1093 + float3(_1087));
     float3 _1105 = float3(_1082);
     float3 _1106 = _1093 - _1105;
@@ -322,7 +322,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
     float3 _1132 = fast::clamp(_1106 / float3(_1089 - _1082), float3(0.0), float3(1.0));
     float3 _1136 = select(_1132, float3(1.0) - _1132, bool3(_1089 < _1082));
     float3 _1141 = mix(select(_1097, float3(-_Globals.FilmBlackClip) + (float3(2.0 * _1049) / (float3(1.0) + exp(float3(((-2.0) * _Globals.FilmSlope) / _1049) * _1106))), _1093 < _1105), select(_1097, float3(_1052) - (float3(2.0 * _1055) / (float3(1.0) + exp(float3((2.0 * _Globals.FilmSlope) / _1055) * (_1093 - _1118)))), _1093 > _1118), ((float3(3.0) - (float3(2.0) * _1136)) * _1136) * _1136);
-    float3 _1145 = fast::max(float3(0.0), mix(float3(dot(_1141, float3(0.272228717803955078125, 0.674081742763519287109375, 0.053689517080783843994140625))), _1141, float3(0.930000007152557373046875)));
+    float3 _1145 = fast::max(float3(0.0), mix(float3(dot(_1141, float3(0.27222872, 0.67408174, 0.053689517))), _1141, float3(0.93)));
     float3 _1215;
     if (_Globals.ColorShadow_Tint2.w == 0.0)
     {
@@ -335,47 +335,47 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
         float3 _1183 = fast::max(float3(0.0), _1167 * (_Globals.ColorShadow_Tint1.xyz + (_Globals.ColorShadow_Tint2.xyz * float3(1.0 / (dot(_932, _Globals.ColorShadow_Luma.xyz) + 1.0)))));
         float3 _1188 = fast::max(float3(0.0), _Globals.ColorCurve_Cm0Cd0_Cd2_Ch0Cm1_Ch3.xxx - _1183);
         float3 _1190 = fast::max(_1183, _Globals.ColorCurve_Cm0Cd0_Cd2_Ch0Cm1_Ch3.zzz);
-        _1215 = ((((_1190 * _Globals.ColorCurve_Ch1_Ch2.xxx) + _Globals.ColorCurve_Ch1_Ch2.yyy) * (float3(1.0) / (_1190 + _Globals.ColorCurve_Cm0Cd0_Cd2_Ch0Cm1_Ch3.www))) + ((fast::clamp(_1183, _Globals.ColorCurve_Cm0Cd0_Cd2_Ch0Cm1_Ch3.xxx, _Globals.ColorCurve_Cm0Cd0_Cd2_Ch0Cm1_Ch3.zzz) * _Globals.ColorMatrixB_ColorCurveCm2.www) + (((_1188 * _Globals.ColorMatrixR_ColorCurveCd1.www) * (float3(1.0) / (_1188 + _Globals.ColorCurve_Cm0Cd0_Cd2_Ch0Cm1_Ch3.yyy))) + _Globals.ColorMatrixG_ColorCurveCd3Cm3.www))) - float3(0.00200000009499490261077880859375);
+        _1215 = ((((_1190 * _Globals.ColorCurve_Ch1_Ch2.xxx) + _Globals.ColorCurve_Ch1_Ch2.yyy) * (float3(1.0) / (_1190 + _Globals.ColorCurve_Cm0Cd0_Cd2_Ch0Cm1_Ch3.www))) + ((fast::clamp(_1183, _Globals.ColorCurve_Cm0Cd0_Cd2_Ch0Cm1_Ch3.xxx, _Globals.ColorCurve_Cm0Cd0_Cd2_Ch0Cm1_Ch3.zzz) * _Globals.ColorMatrixB_ColorCurveCm2.www) + (((_1188 * _Globals.ColorMatrixR_ColorCurveCd1.www) * (float3(1.0) / (_1188 + _Globals.ColorCurve_Cm0Cd0_Cd2_Ch0Cm1_Ch3.yyy))) + _Globals.ColorMatrixG_ColorCurveCd3Cm3.www))) - float3(0.002);
     }
     else
     {
-        _1215 = fast::max(float3(0.0), mix(_1145, _1145 * ((_577 * float3x3(float3(1.06317996978759765625, 0.02339559979736804962158203125, -0.08657260239124298095703125), float3(-0.010633699595928192138671875, 1.2063200473785400390625, -0.1956900060176849365234375), float3(-0.0005908869788981974124908447265625, 0.00105247995816171169281005859375, 0.999538004398345947265625))) * _576), _940) * _575);
+        _1215 = fast::max(float3(0.0), mix(_1145, _1145 * ((_577 * float3x3(float3(1.06318, 0.0233956, -0.0865726), float3(-0.0106337, 1.20632, -0.19569), float3(-0.000590887, 0.00105248, 0.999538))) * _576), _940) * _575);
     }
     float3 _1216 = fast::clamp(_1215, float3(0.0), float3(1.0));
     float _1217 = _1216.x;
     float _1229;
     for (;;)
     {
-        if (_1217 < 0.00313066993840038776397705078125)
+        if (_1217 < 0.00313067)
         {
-            _1229 = _1217 * 12.9200000762939453125;
+            _1229 = _1217 * 12.92;
             break;
         }
-        _1229 = (pow(_1217, 0.4166666567325592041015625) * 1.05499994754791259765625) - 0.054999999701976776123046875;
+        _1229 = (pow(_1217, 0.41666666) * 1.055) - 0.055;
         break;
     }
     float _1230 = _1216.y;
     float _1242;
     for (;;)
     {
-        if (_1230 < 0.00313066993840038776397705078125)
+        if (_1230 < 0.00313067)
         {
-            _1242 = _1230 * 12.9200000762939453125;
+            _1242 = _1230 * 12.92;
             break;
         }
-        _1242 = (pow(_1230, 0.4166666567325592041015625) * 1.05499994754791259765625) - 0.054999999701976776123046875;
+        _1242 = (pow(_1230, 0.41666666) * 1.055) - 0.055;
         break;
     }
     float _1243 = _1216.z;
     float _1255;
     for (;;)
     {
-        if (_1243 < 0.00313066993840038776397705078125)
+        if (_1243 < 0.00313067)
         {
-            _1255 = _1243 * 12.9200000762939453125;
+            _1255 = _1243 * 12.92;
             break;
         }
-        _1255 = (pow(_1243, 0.4166666567325592041015625) * 1.05499994754791259765625) - 0.054999999701976776123046875;
+        _1255 = (pow(_1243, 0.41666666) * 1.055) - 0.055;
         break;
     }
     float3 _1256 = float3(_1229, _1242, _1255);
@@ -386,8 +386,8 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
     float _1276 = _1258.y;
     float4 _1279 = Texture1.sample(Texture1Sampler, float2(_1275, _1276));
     float4 _1283 = Texture1.sample(Texture1Sampler, float2(_1275 + 0.0625, _1276));
-    float3 _1289 = fast::max(float3(6.1035199905745685100555419921875e-05), (float3(_Globals.LUTWeights[0].x) * _1256) + (float3(_Globals.LUTWeights[1].x) * mix(_1279, _1283, float4(_1270 - _1271)).xyz));
-    float3 _1295 = select(_1289 * float3(0.077399380505084991455078125), pow((_1289 * float3(0.94786727428436279296875)) + float3(0.0521326996386051177978515625), float3(2.400000095367431640625)), _1289 > float3(0.040449999272823333740234375));
+    float3 _1289 = fast::max(float3(6.10352e-05), (float3(_Globals.LUTWeights[0].x) * _1256) + (float3(_Globals.LUTWeights[1].x) * mix(_1279, _1283, float4(_1270 - _1271)).xyz));
+    float3 _1295 = select(_1289 * float3(0.07739938), pow((_1289 * float3(0.9478673)) + float3(0.0521327), float3(2.4)), _1289 > float3(0.04045));
     float3 _1324 = pow(fast::max(float3(0.0), mix((((float3(_Globals.MappingPolynomial.x) * (_1295 * _1295)) + (float3(_Globals.MappingPolynomial.y) * _1295)) + float3(_Globals.MappingPolynomial.z)) * _Globals.ColorScale, _Globals.OverlayColor.xyz, float3(_Globals.OverlayColor.w))), float3(_Globals.InverseGamma.y));
     float3 _3103;
     if (_Globals.OutputDevice == 0u)
@@ -396,36 +396,36 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
         float _3075;
         for (;;)
         {
-            if (_3063 < 0.00313066993840038776397705078125)
+            if (_3063 < 0.00313067)
             {
-                _3075 = _3063 * 12.9200000762939453125;
+                _3075 = _3063 * 12.92;
                 break;
             }
-            _3075 = (pow(_3063, 0.4166666567325592041015625) * 1.05499994754791259765625) - 0.054999999701976776123046875;
+            _3075 = (pow(_3063, 0.41666666) * 1.055) - 0.055;
             break;
         }
         float _3076 = _1324.y;
         float _3088;
         for (;;)
         {
-            if (_3076 < 0.00313066993840038776397705078125)
+            if (_3076 < 0.00313067)
             {
-                _3088 = _3076 * 12.9200000762939453125;
+                _3088 = _3076 * 12.92;
                 break;
             }
-            _3088 = (pow(_3076, 0.4166666567325592041015625) * 1.05499994754791259765625) - 0.054999999701976776123046875;
+            _3088 = (pow(_3076, 0.41666666) * 1.055) - 0.055;
             break;
         }
         float _3089 = _1324.z;
         float _3101;
         for (;;)
         {
-            if (_3089 < 0.00313066993840038776397705078125)
+            if (_3089 < 0.00313067)
             {
-                _3101 = _3089 * 12.9200000762939453125;
+                _3101 = _3089 * 12.92;
                 break;
             }
-            _3101 = (pow(_3089, 0.4166666567325592041015625) * 1.05499994754791259765625) - 0.054999999701976776123046875;
+            _3101 = (pow(_3089, 0.41666666) * 1.055) - 0.055;
             break;
         }
         _3103 = float3(_3075, _3088, _3101);
@@ -435,40 +435,40 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
         float3 _3062;
         if (_Globals.OutputDevice == 1u)
         {
-            float3 _3055 = fast::max(float3(6.1035199905745685100555419921875e-05), (_1324 * _573) * _602);
-            _3062 = fast::min(_3055 * float3(4.5), (pow(fast::max(_3055, float3(0.017999999225139617919921875)), float3(0.449999988079071044921875)) * float3(1.09899997711181640625)) - float3(0.098999999463558197021484375));
+            float3 _3055 = fast::max(float3(6.10352e-05), (_1324 * _573) * _602);
+            _3062 = fast::min(_3055 * float3(4.5), (pow(fast::max(_3055, float3(0.018)), float3(0.45)) * float3(1.099)) - float3(0.099));
         }
         else
         {
             float3 _3052;
             if ((_Globals.OutputDevice == 3u) || (_Globals.OutputDevice == 5u))
             {
-                float3 _2204 = (_932 * float3(1.5)) * (_572 * float3x3(float3(1.04981100559234619140625, 0.0, -9.74845024757087230682373046875e-05), float3(-0.49590301513671875, 1.37331306934356689453125, 0.09824003279209136962890625), float3(0.0, 0.0, 0.991252005100250244140625)));
+                float3 _2204 = (_932 * float3(1.5)) * (_572 * float3x3(float3(1.049811, 0.0, -9.74845e-05), float3(-0.49590302, 1.3733131, 0.09824003), float3(0.0, 0.0, 0.991252)));
                 float _2205 = _2204.x;
                 float _2206 = _2204.y;
                 float _2208 = _2204.z;
                 float _2211 = fast::max(fast::max(_2205, _2206), _2208);
-                float _2216 = (fast::max(_2211, 1.0000000133514319600180897396058e-10) - fast::max(fast::min(fast::min(_2205, _2206), _2208), 1.0000000133514319600180897396058e-10)) / fast::max(_2211, 0.00999999977648258209228515625);
+                float _2216 = (fast::max(_2211, 1e-10) - fast::max(fast::min(fast::min(_2205, _2206), _2208), 1e-10)) / fast::max(_2211, 0.01);
                 float _2229 = ((_2208 + _2206) + _2205) + (1.75 * sqrt(((_2208 * (_2208 - _2206)) + (_2206 * (_2206 - _2205))) + (_2205 * (_2205 - _2208))));
-                float _2230 = _2229 * 0.3333333432674407958984375;
-                float _2231 = _2216 - 0.4000000059604644775390625;
+                float _2230 = _2229 * 0.33333334;
+                float _2231 = _2216 - 0.4;
                 float _2236 = fast::max(1.0 - abs(_2231 * 2.5), 0.0);
-                float _2244 = (1.0 + (float(int(sign(_2231 * 5.0))) * (1.0 - (_2236 * _2236)))) * 0.02500000037252902984619140625;
+                float _2244 = (1.0 + (float(int(sign(_2231 * 5.0))) * (1.0 - (_2236 * _2236)))) * 0.025;
                 float _2257;
-                if (_2230 <= 0.053333334624767303466796875)
+                if (_2230 <= 0.053333335)
                 {
                     _2257 = _2244;
                 }
                 else
                 {
                     float _2256;
-                    if (_2230 >= 0.1599999964237213134765625)
+                    if (_2230 >= 0.16)
                     {
                         _2256 = 0.0;
                     }
                     else
                     {
-                        _2256 = _2244 * ((0.23999999463558197021484375 / _2229) - 0.5);
+                        _2256 = _2244 * ((0.24 / _2229) - 0.5);
                     }
                     _2257 = _2256;
                 }
@@ -483,7 +483,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                 }
                 else
                 {
-                    _2278 = 57.2957763671875 * atan2(1.73205077648162841796875 * (_2262 - _2264), ((2.0 * _2261) - _2262) - _2264);
+                    _2278 = 57.295776 * atan2(1.7320508 * (_2262 - _2264), ((2.0 * _2261) - _2262) - _2264);
                 }
                 float _2283;
                 if (_2278 < 0.0)
@@ -507,7 +507,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                 float _2339;
                 if ((_2289 > (-67.5)) && (_2289 < 67.5))
                 {
-                    float _2296 = (_2289 - (-67.5)) * 0.0296296291053295135498046875;
+                    float _2296 = (_2289 - (-67.5)) * 0.02962963;
                     int _2297 = int(_2296);
                     float _2299 = _2296 - float(_2297);
                     float _2300 = _2299 * _2299;
@@ -515,28 +515,28 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     float _2338;
                     if (_2297 == 3)
                     {
-                        _2338 = (((_2301 * (-0.16666667163372039794921875)) + (_2300 * 0.5)) + (_2299 * (-0.5))) + 0.16666667163372039794921875;
+                        _2338 = (((_2301 * (-0.16666667)) + (_2300 * 0.5)) + (_2299 * (-0.5))) + 0.16666667;
                     }
                     else
                     {
                         float _2331;
                         if (_2297 == 2)
                         {
-                            _2331 = ((_2301 * 0.5) + (_2300 * (-1.0))) + 0.666666686534881591796875;
+                            _2331 = ((_2301 * 0.5) + (_2300 * (-1.0))) + 0.6666667;
                         }
                         else
                         {
                             float _2326;
                             if (_2297 == 1)
                             {
-                                _2326 = (((_2301 * (-0.5)) + (_2300 * 0.5)) + (_2299 * 0.5)) + 0.16666667163372039794921875;
+                                _2326 = (((_2301 * (-0.5)) + (_2300 * 0.5)) + (_2299 * 0.5)) + 0.16666667;
                             }
                             else
                             {
                                 float _2319;
                                 if (_2297 == 0)
                                 {
-                                    _2319 = _2301 * 0.16666667163372039794921875;
+                                    _2319 = _2301 * 0.16666667;
                                 }
                                 else
                                 {
@@ -555,22 +555,22 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     _2339 = 0.0;
                 }
                 float3 _2346 = _2260;
-                _2346.x = _2261 + ((((_2339 * 1.5) * _2216) * (0.02999999932944774627685546875 - _2261)) * 0.180000007152557373046875);
-                float3 _2349 = fast::clamp(fast::clamp(_2346, float3(0.0), float3(65535.0)) * float3x3(float3(1.45143926143646240234375, -0.236510753631591796875, -0.214928567409515380859375), float3(-0.07655377686023712158203125, 1.1762297153472900390625, -0.0996759235858917236328125), float3(0.0083161480724811553955078125, -0.0060324496589601039886474609375, 0.99771630764007568359375)), float3(0.0), float3(65535.0));
-                float3 _2352 = mix(float3(dot(_2349, float3(0.272228717803955078125, 0.674081742763519287109375, 0.053689517080783843994140625))), _2349, float3(0.959999978542327880859375));
+                _2346.x = _2261 + ((((_2339 * 1.5) * _2216) * (0.03 - _2261)) * 0.18);
+                float3 _2349 = fast::clamp(fast::clamp(_2346, float3(0.0), float3(65535.0)) * float3x3(float3(1.4514393, -0.23651075, -0.21492857), float3(-0.07655378, 1.1762297, -0.09967592), float3(0.008316148, -0.0060324497, 0.9977163)), float3(0.0), float3(65535.0));
+                float3 _2352 = mix(float3(dot(_2349, float3(0.27222872, 0.67408174, 0.053689517))), _2349, float3(0.96));
                 float _2353 = _2352.x;
-                float _2362 = log((_2353 <= 0.0) ? 6.103515625e-05 : _2353) * 0.4342944622039794921875;
+                float _2362 = log((_2353 <= 0.0) ? 6.1035156e-05 : _2353) * 0.43429446;
                 float _2431;
-                if (_2362 <= (-5.2601776123046875))
+                if (_2362 <= (-5.2601776))
                 {
                     _2431 = -4.0;
                 }
                 else
                 {
                     float _2428;
-                    if ((_2362 > (-5.2601776123046875)) && (_2362 < (-0.744727432727813720703125)))
+                    if ((_2362 > (-5.2601776)) && (_2362 < (-0.74472743)))
                     {
-                        float _2411 = (_2362 - (-5.2601776123046875)) * 0.6643855571746826171875;
+                        float _2411 = (_2362 - (-5.2601776)) * 0.66438556;
                         int _2412 = int(_2411);
                         float _2414 = _2411 - float(_2412);
                         _2428 = dot(float3(_2414 * _2414, _2414, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(_499[_2412], _499[_2412 + 1], _499[_2412 + 2]));
@@ -578,9 +578,9 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     else
                     {
                         float _2407;
-                        if ((_2362 >= (-0.744727432727813720703125)) && (_2362 < 4.673812389373779296875))
+                        if ((_2362 >= (-0.74472743)) && (_2362 < 4.6738124))
                         {
-                            float _2390 = (_2362 - (-0.744727432727813720703125)) * 0.55365467071533203125;
+                            float _2390 = (_2362 - (-0.74472743)) * 0.5536547;
                             int _2391 = int(_2390);
                             float _2393 = _2390 - float(_2391);
                             _2407 = dot(float3(_2393 * _2393, _2393, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(_500[_2391], _500[_2391 + 1], _500[_2391 + 2]));
@@ -596,18 +596,18 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                 float3 _2433 = _523;
                 _2433.x = pow(10.0, _2431);
                 float _2434 = _2352.y;
-                float _2438 = log((_2434 <= 0.0) ? 6.103515625e-05 : _2434) * 0.4342944622039794921875;
+                float _2438 = log((_2434 <= 0.0) ? 6.1035156e-05 : _2434) * 0.43429446;
                 float _2505;
-                if (_2438 <= (-5.2601776123046875))
+                if (_2438 <= (-5.2601776))
                 {
                     _2505 = -4.0;
                 }
                 else
                 {
                     float _2502;
-                    if ((_2438 > (-5.2601776123046875)) && (_2438 < (-0.744727432727813720703125)))
+                    if ((_2438 > (-5.2601776)) && (_2438 < (-0.74472743)))
                     {
-                        float _2485 = (_2438 - (-5.2601776123046875)) * 0.6643855571746826171875;
+                        float _2485 = (_2438 - (-5.2601776)) * 0.66438556;
                         int _2486 = int(_2485);
                         float _2488 = _2485 - float(_2486);
                         _2502 = dot(float3(_2488 * _2488, _2488, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(_499[_2486], _499[_2486 + 1], _499[_2486 + 2]));
@@ -615,9 +615,9 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     else
                     {
                         float _2481;
-                        if ((_2438 >= (-0.744727432727813720703125)) && (_2438 < 4.673812389373779296875))
+                        if ((_2438 >= (-0.74472743)) && (_2438 < 4.6738124))
                         {
-                            float _2464 = (_2438 - (-0.744727432727813720703125)) * 0.55365467071533203125;
+                            float _2464 = (_2438 - (-0.74472743)) * 0.5536547;
                             int _2465 = int(_2464);
                             float _2467 = _2464 - float(_2465);
                             _2481 = dot(float3(_2467 * _2467, _2467, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(_500[_2465], _500[_2465 + 1], _500[_2465 + 2]));
@@ -633,18 +633,18 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                 float3 _2507 = _2433;
                 _2507.y = pow(10.0, _2505);
                 float _2508 = _2352.z;
-                float _2512 = log((_2508 <= 0.0) ? 6.103515625e-05 : _2508) * 0.4342944622039794921875;
+                float _2512 = log((_2508 <= 0.0) ? 6.1035156e-05 : _2508) * 0.43429446;
                 float _2579;
-                if (_2512 <= (-5.2601776123046875))
+                if (_2512 <= (-5.2601776))
                 {
                     _2579 = -4.0;
                 }
                 else
                 {
                     float _2576;
-                    if ((_2512 > (-5.2601776123046875)) && (_2512 < (-0.744727432727813720703125)))
+                    if ((_2512 > (-5.2601776)) && (_2512 < (-0.74472743)))
                     {
-                        float _2559 = (_2512 - (-5.2601776123046875)) * 0.6643855571746826171875;
+                        float _2559 = (_2512 - (-5.2601776)) * 0.66438556;
                         int _2560 = int(_2559);
                         float _2562 = _2559 - float(_2560);
                         _2576 = dot(float3(_2562 * _2562, _2562, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(_499[_2560], _499[_2560 + 1], _499[_2560 + 2]));
@@ -652,9 +652,9 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     else
                     {
                         float _2555;
-                        if ((_2512 >= (-0.744727432727813720703125)) && (_2512 < 4.673812389373779296875))
+                        if ((_2512 >= (-0.74472743)) && (_2512 < 4.6738124))
                         {
-                            float _2538 = (_2512 - (-0.744727432727813720703125)) * 0.55365467071533203125;
+                            float _2538 = (_2512 - (-0.74472743)) * 0.5536547;
                             int _2539 = int(_2538);
                             float _2541 = _2538 - float(_2539);
                             _2555 = dot(float3(_2541 * _2541, _2541, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(_500[_2539], _500[_2539 + 1], _500[_2539 + 2]));
@@ -669,22 +669,22 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                 }
                 float3 _2581 = _2507;
                 _2581.z = pow(10.0, _2579);
-                float3 _2583 = (_2581 * float3x3(float3(0.695452213287353515625, 0.140678703784942626953125, 0.16386906802654266357421875), float3(0.0447945632040500640869140625, 0.859671115875244140625, 0.095534317195415496826171875), float3(-0.0055258828215301036834716796875, 0.0040252101607620716094970703125, 1.00150072574615478515625))) * float3x3(float3(1.45143926143646240234375, -0.236510753631591796875, -0.214928567409515380859375), float3(-0.07655377686023712158203125, 1.1762297153472900390625, -0.0996759235858917236328125), float3(0.0083161480724811553955078125, -0.0060324496589601039886474609375, 0.99771630764007568359375));
-                float _2714 = pow(10.0, (float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(-0.718548238277435302734375, 2.0810306072235107421875, 3.66812419891357421875)).z);
-                float _2786 = pow(10.0, dot(float3(0.4444443881511688232421875, 0.66666662693023681640625, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(2.0810306072235107421875, 3.66812419891357421875, 4.0)));
+                float3 _2583 = (_2581 * float3x3(float3(0.6954522, 0.1406787, 0.16386907), float3(0.044794563, 0.8596711, 0.09553432), float3(-0.005525883, 0.00402521, 1.0015007))) * float3x3(float3(1.4514393, -0.23651075, -0.21492857), float3(-0.07655378, 1.1762297, -0.09967592), float3(0.008316148, -0.0060324497, 0.9977163));
+                float _2714 = pow(10.0, (float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(-0.71854824, 2.0810306, 3.6681242)).z);
+                float _2786 = pow(10.0, dot(float3(0.4444444, 0.6666666, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(2.0810306, 3.6681242, 4.0)));
                 float _2787 = _2583.x;
-                float _2790 = log((_2787 <= 0.0) ? 9.9999997473787516355514526367188e-05 : _2787);
-                float _2791 = _2790 * 0.4342944622039794921875;
-                float _2792 = log(pow(10.0, dot(float3(0.3600003719329833984375, 0.600000321865081787109375, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(-4.0, -4.0, -3.1573765277862548828125))));
-                float _2793 = _2792 * 0.4342944622039794921875;
+                float _2790 = log((_2787 <= 0.0) ? 0.0001 : _2787);
+                float _2791 = _2790 * 0.43429446;
+                float _2792 = log(pow(10.0, dot(float3(0.36000037, 0.6000003, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(-4.0, -4.0, -3.1573765))));
+                float _2793 = _2792 * 0.43429446;
                 float _2870;
                 if (_2791 <= _2793)
                 {
-                    _2870 = (_2790 * 1.3028833866119384765625) + ((-4.0) - (_2792 * 1.3028833866119384765625));
+                    _2870 = (_2790 * 1.3028834) + ((-4.0) - (_2792 * 1.3028834));
                 }
                 else
                 {
-                    float _2800 = log(_2714) * 0.4342944622039794921875;
+                    float _2800 = log(_2714) * 0.43429446;
                     float _2862;
                     if ((_2791 > _2793) && (_2791 < _2800))
                     {
@@ -696,7 +696,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     else
                     {
                         float _2807 = log(_2786);
-                        float _2808 = _2807 * 0.4342944622039794921875;
+                        float _2808 = _2807 * 0.43429446;
                         float _2841;
                         if ((_2791 >= _2800) && (_2791 < _2808))
                         {
@@ -707,7 +707,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                         }
                         else
                         {
-                            _2841 = (_2790 * 0.026057668030261993408203125) + (3.0 - (_2807 * 0.026057668030261993408203125));
+                            _2841 = (_2790 * 0.026057668) + (3.0 - (_2807 * 0.026057668));
                         }
                         _2862 = _2841;
                     }
@@ -716,16 +716,16 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                 float3 _2872 = _523;
                 _2872.x = pow(10.0, _2870);
                 float _2873 = _2583.y;
-                float _2876 = log((_2873 <= 0.0) ? 9.9999997473787516355514526367188e-05 : _2873);
-                float _2877 = _2876 * 0.4342944622039794921875;
+                float _2876 = log((_2873 <= 0.0) ? 0.0001 : _2873);
+                float _2877 = _2876 * 0.43429446;
                 float _2954;
                 if (_2877 <= _2793)
                 {
-                    _2954 = (_2876 * 1.3028833866119384765625) + ((-4.0) - (_2792 * 1.3028833866119384765625));
+                    _2954 = (_2876 * 1.3028834) + ((-4.0) - (_2792 * 1.3028834));
                 }
                 else
                 {
-                    float _2884 = log(_2714) * 0.4342944622039794921875;
+                    float _2884 = log(_2714) * 0.43429446;
                     float _2946;
                     if ((_2877 > _2793) && (_2877 < _2884))
                     {
@@ -737,7 +737,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     else
                     {
                         float _2891 = log(_2786);
-                        float _2892 = _2891 * 0.4342944622039794921875;
+                        float _2892 = _2891 * 0.43429446;
                         float _2925;
                         if ((_2877 >= _2884) && (_2877 < _2892))
                         {
@@ -748,7 +748,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                         }
                         else
                         {
-                            _2925 = (_2876 * 0.026057668030261993408203125) + (3.0 - (_2891 * 0.026057668030261993408203125));
+                            _2925 = (_2876 * 0.026057668) + (3.0 - (_2891 * 0.026057668));
                         }
                         _2946 = _2925;
                     }
@@ -757,16 +757,16 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                 float3 _2956 = _2872;
                 _2956.y = pow(10.0, _2954);
                 float _2957 = _2583.z;
-                float _2960 = log((_2957 <= 0.0) ? 9.9999997473787516355514526367188e-05 : _2957);
-                float _2961 = _2960 * 0.4342944622039794921875;
+                float _2960 = log((_2957 <= 0.0) ? 0.0001 : _2957);
+                float _2961 = _2960 * 0.43429446;
                 float _3038;
                 if (_2961 <= _2793)
                 {
-                    _3038 = (_2960 * 1.3028833866119384765625) + ((-4.0) - (_2792 * 1.3028833866119384765625));
+                    _3038 = (_2960 * 1.3028834) + ((-4.0) - (_2792 * 1.3028834));
                 }
                 else
                 {
-                    float _2968 = log(_2714) * 0.4342944622039794921875;
+                    float _2968 = log(_2714) * 0.43429446;
                     float _3030;
                     if ((_2961 > _2793) && (_2961 < _2968))
                     {
@@ -778,7 +778,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     else
                     {
                         float _2975 = log(_2786);
-                        float _2976 = _2975 * 0.4342944622039794921875;
+                        float _2976 = _2975 * 0.43429446;
                         float _3009;
                         if ((_2961 >= _2968) && (_2961 < _2976))
                         {
@@ -789,7 +789,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                         }
                         else
                         {
-                            _3009 = (_2960 * 0.026057668030261993408203125) + (3.0 - (_2975 * 0.026057668030261993408203125));
+                            _3009 = (_2960 * 0.026057668) + (3.0 - (_2975 * 0.026057668));
                         }
                         _3030 = _3009;
                     }
@@ -797,40 +797,40 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                 }
                 float3 _3040 = _2956;
                 _3040.z = pow(10.0, _3038);
-                float3 _3044 = pow(((_3040 - float3(3.5073844628641381859779357910156e-05)) * _602) * float3(9.9999997473787516355514526367188e-05), float3(0.1593017578125));
-                _3052 = pow((float3(0.8359375) + (float3(18.8515625) * _3044)) * (float3(1.0) / (float3(1.0) + (float3(18.6875) * _3044))), float3(78.84375));
+                float3 _3044 = pow(((_3040 - float3(3.5073845e-05)) * _602) * float3(0.0001), float3(0.15930176));
+                _3052 = pow((float3(0.8359375) + (float3(18.851563) * _3044)) * (float3(1.0) / (float3(1.0) + (float3(18.6875) * _3044))), float3(78.84375));
             }
             else
             {
                 float3 _2201;
                 if ((_Globals.OutputDevice == 4u) || (_Globals.OutputDevice == 6u))
                 {
-                    float3 _1369 = (_932 * float3(1.5)) * (_572 * float3x3(float3(1.04981100559234619140625, 0.0, -9.74845024757087230682373046875e-05), float3(-0.49590301513671875, 1.37331306934356689453125, 0.09824003279209136962890625), float3(0.0, 0.0, 0.991252005100250244140625)));
+                    float3 _1369 = (_932 * float3(1.5)) * (_572 * float3x3(float3(1.049811, 0.0, -9.74845e-05), float3(-0.49590302, 1.3733131, 0.09824003), float3(0.0, 0.0, 0.991252)));
                     float _1370 = _1369.x;
                     float _1371 = _1369.y;
                     float _1373 = _1369.z;
                     float _1376 = fast::max(fast::max(_1370, _1371), _1373);
-                    float _1381 = (fast::max(_1376, 1.0000000133514319600180897396058e-10) - fast::max(fast::min(fast::min(_1370, _1371), _1373), 1.0000000133514319600180897396058e-10)) / fast::max(_1376, 0.00999999977648258209228515625);
+                    float _1381 = (fast::max(_1376, 1e-10) - fast::max(fast::min(fast::min(_1370, _1371), _1373), 1e-10)) / fast::max(_1376, 0.01);
                     float _1394 = ((_1373 + _1371) + _1370) + (1.75 * sqrt(((_1373 * (_1373 - _1371)) + (_1371 * (_1371 - _1370))) + (_1370 * (_1370 - _1373))));
-                    float _1395 = _1394 * 0.3333333432674407958984375;
-                    float _1396 = _1381 - 0.4000000059604644775390625;
+                    float _1395 = _1394 * 0.33333334;
+                    float _1396 = _1381 - 0.4;
                     float _1401 = fast::max(1.0 - abs(_1396 * 2.5), 0.0);
-                    float _1409 = (1.0 + (float(int(sign(_1396 * 5.0))) * (1.0 - (_1401 * _1401)))) * 0.02500000037252902984619140625;
+                    float _1409 = (1.0 + (float(int(sign(_1396 * 5.0))) * (1.0 - (_1401 * _1401)))) * 0.025;
                     float _1422;
-                    if (_1395 <= 0.053333334624767303466796875)
+                    if (_1395 <= 0.053333335)
                     {
                         _1422 = _1409;
                     }
                     else
                     {
                         float _1421;
-                        if (_1395 >= 0.1599999964237213134765625)
+                        if (_1395 >= 0.16)
                         {
                             _1421 = 0.0;
                         }
                         else
                         {
-                            _1421 = _1409 * ((0.23999999463558197021484375 / _1394) - 0.5);
+                            _1421 = _1409 * ((0.24 / _1394) - 0.5);
                         }
                         _1422 = _1421;
                     }
@@ -845,7 +845,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     }
                     else
                     {
-                        _1443 = 57.2957763671875 * atan2(1.73205077648162841796875 * (_1427 - _1429), ((2.0 * _1426) - _1427) - _1429);
+                        _1443 = 57.295776 * atan2(1.7320508 * (_1427 - _1429), ((2.0 * _1426) - _1427) - _1429);
                     }
                     float _1448;
                     if (_1443 < 0.0)
@@ -869,7 +869,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     float _1504;
                     if ((_1454 > (-67.5)) && (_1454 < 67.5))
                     {
-                        float _1461 = (_1454 - (-67.5)) * 0.0296296291053295135498046875;
+                        float _1461 = (_1454 - (-67.5)) * 0.02962963;
                         int _1462 = int(_1461);
                         float _1464 = _1461 - float(_1462);
                         float _1465 = _1464 * _1464;
@@ -877,28 +877,28 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                         float _1503;
                         if (_1462 == 3)
                         {
-                            _1503 = (((_1466 * (-0.16666667163372039794921875)) + (_1465 * 0.5)) + (_1464 * (-0.5))) + 0.16666667163372039794921875;
+                            _1503 = (((_1466 * (-0.16666667)) + (_1465 * 0.5)) + (_1464 * (-0.5))) + 0.16666667;
                         }
                         else
                         {
                             float _1496;
                             if (_1462 == 2)
                             {
-                                _1496 = ((_1466 * 0.5) + (_1465 * (-1.0))) + 0.666666686534881591796875;
+                                _1496 = ((_1466 * 0.5) + (_1465 * (-1.0))) + 0.6666667;
                             }
                             else
                             {
                                 float _1491;
                                 if (_1462 == 1)
                                 {
-                                    _1491 = (((_1466 * (-0.5)) + (_1465 * 0.5)) + (_1464 * 0.5)) + 0.16666667163372039794921875;
+                                    _1491 = (((_1466 * (-0.5)) + (_1465 * 0.5)) + (_1464 * 0.5)) + 0.16666667;
                                 }
                                 else
                                 {
                                     float _1484;
                                     if (_1462 == 0)
                                     {
-                                        _1484 = _1466 * 0.16666667163372039794921875;
+                                        _1484 = _1466 * 0.16666667;
                                     }
                                     else
                                     {
@@ -917,22 +917,22 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                         _1504 = 0.0;
                     }
                     float3 _1511 = _1425;
-                    _1511.x = _1426 + ((((_1504 * 1.5) * _1381) * (0.02999999932944774627685546875 - _1426)) * 0.180000007152557373046875);
-                    float3 _1514 = fast::clamp(fast::clamp(_1511, float3(0.0), float3(65535.0)) * float3x3(float3(1.45143926143646240234375, -0.236510753631591796875, -0.214928567409515380859375), float3(-0.07655377686023712158203125, 1.1762297153472900390625, -0.0996759235858917236328125), float3(0.0083161480724811553955078125, -0.0060324496589601039886474609375, 0.99771630764007568359375)), float3(0.0), float3(65535.0));
-                    float3 _1517 = mix(float3(dot(_1514, float3(0.272228717803955078125, 0.674081742763519287109375, 0.053689517080783843994140625))), _1514, float3(0.959999978542327880859375));
+                    _1511.x = _1426 + ((((_1504 * 1.5) * _1381) * (0.03 - _1426)) * 0.18);
+                    float3 _1514 = fast::clamp(fast::clamp(_1511, float3(0.0), float3(65535.0)) * float3x3(float3(1.4514393, -0.23651075, -0.21492857), float3(-0.07655378, 1.1762297, -0.09967592), float3(0.008316148, -0.0060324497, 0.9977163)), float3(0.0), float3(65535.0));
+                    float3 _1517 = mix(float3(dot(_1514, float3(0.27222872, 0.67408174, 0.053689517))), _1514, float3(0.96));
                     float _1518 = _1517.x;
-                    float _1527 = log((_1518 <= 0.0) ? 6.103515625e-05 : _1518) * 0.4342944622039794921875;
+                    float _1527 = log((_1518 <= 0.0) ? 6.1035156e-05 : _1518) * 0.43429446;
                     float _1596;
-                    if (_1527 <= (-5.2601776123046875))
+                    if (_1527 <= (-5.2601776))
                     {
                         _1596 = -4.0;
                     }
                     else
                     {
                         float _1593;
-                        if ((_1527 > (-5.2601776123046875)) && (_1527 < (-0.744727432727813720703125)))
+                        if ((_1527 > (-5.2601776)) && (_1527 < (-0.74472743)))
                         {
-                            float _1576 = (_1527 - (-5.2601776123046875)) * 0.6643855571746826171875;
+                            float _1576 = (_1527 - (-5.2601776)) * 0.66438556;
                             int _1577 = int(_1576);
                             float _1579 = _1576 - float(_1577);
                             _1593 = dot(float3(_1579 * _1579, _1579, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(_499[_1577], _499[_1577 + 1], _499[_1577 + 2]));
@@ -940,9 +940,9 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                         else
                         {
                             float _1572;
-                            if ((_1527 >= (-0.744727432727813720703125)) && (_1527 < 4.673812389373779296875))
+                            if ((_1527 >= (-0.74472743)) && (_1527 < 4.6738124))
                             {
-                                float _1555 = (_1527 - (-0.744727432727813720703125)) * 0.55365467071533203125;
+                                float _1555 = (_1527 - (-0.74472743)) * 0.5536547;
                                 int _1556 = int(_1555);
                                 float _1558 = _1555 - float(_1556);
                                 _1572 = dot(float3(_1558 * _1558, _1558, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(_500[_1556], _500[_1556 + 1], _500[_1556 + 2]));
@@ -958,18 +958,18 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     float3 _1598 = _523;
                     _1598.x = pow(10.0, _1596);
                     float _1599 = _1517.y;
-                    float _1603 = log((_1599 <= 0.0) ? 6.103515625e-05 : _1599) * 0.4342944622039794921875;
+                    float _1603 = log((_1599 <= 0.0) ? 6.1035156e-05 : _1599) * 0.43429446;
                     float _1670;
-                    if (_1603 <= (-5.2601776123046875))
+                    if (_1603 <= (-5.2601776))
                     {
                         _1670 = -4.0;
                     }
                     else
                     {
                         float _1667;
-                        if ((_1603 > (-5.2601776123046875)) && (_1603 < (-0.744727432727813720703125)))
+                        if ((_1603 > (-5.2601776)) && (_1603 < (-0.74472743)))
                         {
-                            float _1650 = (_1603 - (-5.2601776123046875)) * 0.6643855571746826171875;
+                            float _1650 = (_1603 - (-5.2601776)) * 0.66438556;
                             int _1651 = int(_1650);
                             float _1653 = _1650 - float(_1651);
                             _1667 = dot(float3(_1653 * _1653, _1653, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(_499[_1651], _499[_1651 + 1], _499[_1651 + 2]));
@@ -977,9 +977,9 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                         else
                         {
                             float _1646;
-                            if ((_1603 >= (-0.744727432727813720703125)) && (_1603 < 4.673812389373779296875))
+                            if ((_1603 >= (-0.74472743)) && (_1603 < 4.6738124))
                             {
-                                float _1629 = (_1603 - (-0.744727432727813720703125)) * 0.55365467071533203125;
+                                float _1629 = (_1603 - (-0.74472743)) * 0.5536547;
                                 int _1630 = int(_1629);
                                 float _1632 = _1629 - float(_1630);
                                 _1646 = dot(float3(_1632 * _1632, _1632, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(_500[_1630], _500[_1630 + 1], _500[_1630 + 2]));
@@ -995,18 +995,18 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     float3 _1672 = _1598;
                     _1672.y = pow(10.0, _1670);
                     float _1673 = _1517.z;
-                    float _1677 = log((_1673 <= 0.0) ? 6.103515625e-05 : _1673) * 0.4342944622039794921875;
+                    float _1677 = log((_1673 <= 0.0) ? 6.1035156e-05 : _1673) * 0.43429446;
                     float _1744;
-                    if (_1677 <= (-5.2601776123046875))
+                    if (_1677 <= (-5.2601776))
                     {
                         _1744 = -4.0;
                     }
                     else
                     {
                         float _1741;
-                        if ((_1677 > (-5.2601776123046875)) && (_1677 < (-0.744727432727813720703125)))
+                        if ((_1677 > (-5.2601776)) && (_1677 < (-0.74472743)))
                         {
-                            float _1724 = (_1677 - (-5.2601776123046875)) * 0.6643855571746826171875;
+                            float _1724 = (_1677 - (-5.2601776)) * 0.66438556;
                             int _1725 = int(_1724);
                             float _1727 = _1724 - float(_1725);
                             _1741 = dot(float3(_1727 * _1727, _1727, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(_499[_1725], _499[_1725 + 1], _499[_1725 + 2]));
@@ -1014,9 +1014,9 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                         else
                         {
                             float _1720;
-                            if ((_1677 >= (-0.744727432727813720703125)) && (_1677 < 4.673812389373779296875))
+                            if ((_1677 >= (-0.74472743)) && (_1677 < 4.6738124))
                             {
-                                float _1703 = (_1677 - (-0.744727432727813720703125)) * 0.55365467071533203125;
+                                float _1703 = (_1677 - (-0.74472743)) * 0.5536547;
                                 int _1704 = int(_1703);
                                 float _1706 = _1703 - float(_1704);
                                 _1720 = dot(float3(_1706 * _1706, _1706, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(_500[_1704], _500[_1704 + 1], _500[_1704 + 2]));
@@ -1031,21 +1031,21 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     }
                     float3 _1746 = _1672;
                     _1746.z = pow(10.0, _1744);
-                    float3 _1748 = (_1746 * float3x3(float3(0.695452213287353515625, 0.140678703784942626953125, 0.16386906802654266357421875), float3(0.0447945632040500640869140625, 0.859671115875244140625, 0.095534317195415496826171875), float3(-0.0055258828215301036834716796875, 0.0040252101607620716094970703125, 1.00150072574615478515625))) * float3x3(float3(1.45143926143646240234375, -0.236510753631591796875, -0.214928567409515380859375), float3(-0.07655377686023712158203125, 1.1762297153472900390625, -0.0996759235858917236328125), float3(0.0083161480724811553955078125, -0.0060324496589601039886474609375, 0.99771630764007568359375));
-                    float _1879 = pow(10.0, (float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(-0.718548238277435302734375, 2.0810306072235107421875, 3.66812419891357421875)).z);
-                    float _1951 = pow(10.0, dot(float3(0.69444429874420166015625, 0.8333332538604736328125, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(2.0810306072235107421875, 3.66812419891357421875, 4.0)));
+                    float3 _1748 = (_1746 * float3x3(float3(0.6954522, 0.1406787, 0.16386907), float3(0.044794563, 0.8596711, 0.09553432), float3(-0.005525883, 0.00402521, 1.0015007))) * float3x3(float3(1.4514393, -0.23651075, -0.21492857), float3(-0.07655378, 1.1762297, -0.09967592), float3(0.008316148, -0.0060324497, 0.9977163));
+                    float _1879 = pow(10.0, (float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(-0.71854824, 2.0810306, 3.6681242)).z);
+                    float _1951 = pow(10.0, dot(float3(0.6944443, 0.83333325, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(2.0810306, 3.6681242, 4.0)));
                     float _1952 = _1748.x;
-                    float _1955 = log((_1952 <= 0.0) ? 9.9999997473787516355514526367188e-05 : _1952);
-                    float _1956 = _1955 * 0.4342944622039794921875;
-                    float _1958 = log(pow(10.0, dot(float3(0.3600003719329833984375, 0.600000321865081787109375, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(-4.0, -4.0, -3.1573765277862548828125)))) * 0.4342944622039794921875;
+                    float _1955 = log((_1952 <= 0.0) ? 0.0001 : _1952);
+                    float _1956 = _1955 * 0.43429446;
+                    float _1958 = log(pow(10.0, dot(float3(0.36000037, 0.6000003, 1.0), float3x3(float3(0.5, -1.0, 0.5), float3(-1.0, 1.0, 0.5), float3(0.5, 0.0, 0.0)) * float3(-4.0, -4.0, -3.1573765)))) * 0.43429446;
                     float _2030;
                     if (_1956 <= _1958)
                     {
-                        _2030 = -2.3010299205780029296875;
+                        _2030 = -2.30103;
                     }
                     else
                     {
-                        float _1965 = log(_1879) * 0.4342944622039794921875;
+                        float _1965 = log(_1879) * 0.43429446;
                         float _2027;
                         if ((_1956 > _1958) && (_1956 < _1965))
                         {
@@ -1057,7 +1057,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                         else
                         {
                             float _1972 = log(_1951);
-                            float _1973 = _1972 * 0.4342944622039794921875;
+                            float _1973 = _1972 * 0.43429446;
                             float _2006;
                             if ((_1956 >= _1965) && (_1956 < _1973))
                             {
@@ -1068,7 +1068,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                             }
                             else
                             {
-                                _2006 = (_1955 * 0.05211533606052398681640625) + (3.3010299205780029296875 - (_1972 * 0.05211533606052398681640625));
+                                _2006 = (_1955 * 0.052115336) + (3.30103 - (_1972 * 0.052115336));
                             }
                             _2027 = _2006;
                         }
@@ -1077,16 +1077,16 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     float3 _2032 = _523;
                     _2032.x = pow(10.0, _2030);
                     float _2033 = _1748.y;
-                    float _2036 = log((_2033 <= 0.0) ? 9.9999997473787516355514526367188e-05 : _2033);
-                    float _2037 = _2036 * 0.4342944622039794921875;
+                    float _2036 = log((_2033 <= 0.0) ? 0.0001 : _2033);
+                    float _2037 = _2036 * 0.43429446;
                     float _2109;
                     if (_2037 <= _1958)
                     {
-                        _2109 = -2.3010299205780029296875;
+                        _2109 = -2.30103;
                     }
                     else
                     {
-                        float _2044 = log(_1879) * 0.4342944622039794921875;
+                        float _2044 = log(_1879) * 0.43429446;
                         float _2106;
                         if ((_2037 > _1958) && (_2037 < _2044))
                         {
@@ -1098,7 +1098,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                         else
                         {
                             float _2051 = log(_1951);
-                            float _2052 = _2051 * 0.4342944622039794921875;
+                            float _2052 = _2051 * 0.43429446;
                             float _2085;
                             if ((_2037 >= _2044) && (_2037 < _2052))
                             {
@@ -1109,7 +1109,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                             }
                             else
                             {
-                                _2085 = (_2036 * 0.05211533606052398681640625) + (3.3010299205780029296875 - (_2051 * 0.05211533606052398681640625));
+                                _2085 = (_2036 * 0.052115336) + (3.30103 - (_2051 * 0.052115336));
                             }
                             _2106 = _2085;
                         }
@@ -1118,16 +1118,16 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     float3 _2111 = _2032;
                     _2111.y = pow(10.0, _2109);
                     float _2112 = _1748.z;
-                    float _2115 = log((_2112 <= 0.0) ? 9.9999997473787516355514526367188e-05 : _2112);
-                    float _2116 = _2115 * 0.4342944622039794921875;
+                    float _2115 = log((_2112 <= 0.0) ? 0.0001 : _2112);
+                    float _2116 = _2115 * 0.43429446;
                     float _2188;
                     if (_2116 <= _1958)
                     {
-                        _2188 = -2.3010299205780029296875;
+                        _2188 = -2.30103;
                     }
                     else
                     {
-                        float _2123 = log(_1879) * 0.4342944622039794921875;
+                        float _2123 = log(_1879) * 0.43429446;
                         float _2185;
                         if ((_2116 > _1958) && (_2116 < _2123))
                         {
@@ -1139,7 +1139,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                         else
                         {
                             float _2130 = log(_1951);
-                            float _2131 = _2130 * 0.4342944622039794921875;
+                            float _2131 = _2130 * 0.43429446;
                             float _2164;
                             if ((_2116 >= _2123) && (_2116 < _2131))
                             {
@@ -1150,7 +1150,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                             }
                             else
                             {
-                                _2164 = (_2115 * 0.05211533606052398681640625) + (3.3010299205780029296875 - (_2130 * 0.05211533606052398681640625));
+                                _2164 = (_2115 * 0.052115336) + (3.30103 - (_2130 * 0.052115336));
                             }
                             _2185 = _2164;
                         }
@@ -1158,16 +1158,16 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
                     }
                     float3 _2190 = _2111;
                     _2190.z = pow(10.0, _2188);
-                    float3 _2193 = pow((_2190 * _602) * float3(9.9999997473787516355514526367188e-05), float3(0.1593017578125));
-                    _2201 = pow((float3(0.8359375) + (float3(18.8515625) * _2193)) * (float3(1.0) / (float3(1.0) + (float3(18.6875) * _2193))), float3(78.84375));
+                    float3 _2193 = pow((_2190 * _602) * float3(0.0001), float3(0.15930176));
+                    _2201 = pow((float3(0.8359375) + (float3(18.851563) * _2193)) * (float3(1.0) / (float3(1.0) + (float3(18.6875) * _2193))), float3(78.84375));
                 }
                 else
                 {
                     float3 _1366;
                     if (_Globals.OutputDevice == 7u)
                     {
-                        float3 _1358 = pow(((_932 * _573) * _602) * float3(9.9999997473787516355514526367188e-05), float3(0.1593017578125));
-                        _1366 = pow((float3(0.8359375) + (float3(18.8515625) * _1358)) * (float3(1.0) / (float3(1.0) + (float3(18.6875) * _1358))), float3(78.84375));
+                        float3 _1358 = pow(((_932 * _573) * _602) * float3(0.0001), float3(0.15930176));
+                        _1366 = pow((float3(0.8359375) + (float3(18.851563) * _1358)) * (float3(1.0) / (float3(1.0) + (float3(18.6875) * _1358))), float3(78.84375));
                     }
                     else
                     {
@@ -1181,7 +1181,7 @@ fragment main0_out main0(main0_in in [[stage_in]], constant type_Globals& _Globa
         }
         _3103 = _3062;
     }
-    float3 _3104 = _3103 * float3(0.95238101482391357421875);
+    float3 _3104 = _3103 * float3(0.952381);
     float4 _3106 = float4(_3104.x, _3104.y, _3104.z, float4(0.0).w);
     _3106.w = 0.0;
     out.out_var_SV_Target0 = _3106;
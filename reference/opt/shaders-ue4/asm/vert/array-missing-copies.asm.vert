@@ -326,7 +326,7 @@ vertex main0_out main0(main0_in in [[stage_in]], constant type_View& View [[buff
     float4 _115 = in.in_var_ATTRIBUTE0 * float4(255.0);
     float2 _116 = _115.zw;
     float2 _119 = fract(_116 * float2(0.5)) * float2(2.0);
-    float2 _121 = (_116 - _119) * float2(0.0039215688593685626983642578125);
+    float2 _121 = (_116 - _119) * float2(0.003921569);
     float2 _122 = _115.xy;
     float2 _126 = _122 * float2(_Globals.LodValues.w);
     float _127 = _126.y;
@@ -431,7 +431,7 @@ vertex main0_out main0(main0_in in [[stage_in]], constant type_View& View [[buff
     }
     float _400 = fast::max(-127.0, MobileBasePass.MobileBasePass_Fog_ExponentialFogParameters.y * _396);
     float _417 = fast::max(-127.0, MobileBasePass.MobileBasePass_Fog_ExponentialFogParameters2.y * _396);
-    float _428 = (_395 * ((abs(_400) > 0.00999999977648258209228515625) ? ((1.0 - exp2(-_400)) / _400) : (0.693147182464599609375 - (0.2402265071868896484375 * _400)))) + (_394 * ((abs(_417) > 0.00999999977648258209228515625) ? ((1.0 - exp2(-_417)) / _417) : (0.693147182464599609375 - (0.2402265071868896484375 * _417))));
+    float _428 = (_395 * ((abs(_400) > 0.01) ? ((1.0 - exp2(-_400)) / _400) : (0.6931472 - (0.2402265 * _400)))) + (_394 * ((abs(_417) > 0.01) ? ((1.0 - exp2(-_417)) / _417) : (0.6931472 - (0.2402265 * _417))));
     float3 _459;
     if (MobileBasePass.MobileBasePass_Fog_InscatteringLightDirection.w >= 0.0)
     {
@@ -296,7 +296,7 @@ vertex main0_out main0(main0_in in [[stage_in]], constant type_View& View [[buff
     float4 _145 = AttributesTexture.sample(AttributesTextureSampler, _133, level(0.0));
     float _146 = _137.w;
     float3 _158 = float3x3(Primitive.Primitive_LocalToWorld[0].xyz, Primitive.Primitive_LocalToWorld[1].xyz, Primitive.Primitive_LocalToWorld[2].xyz) * VelocityTexture.sample(VelocityTextureSampler, _133, level(0.0)).xyz;
-    float3 _160 = normalize(_158 + float3(0.0, 0.0, 9.9999997473787516355514526367188e-05));
+    float3 _160 = normalize(_158 + float3(0.0, 0.0, 0.0001));
     float2 _204 = ((((_145.xy + float2((_145.x < 0.5) ? 0.0 : (-0.5), (_145.y < 0.5) ? 0.0 : (-0.5))) * float2(2.0)) * (((CurveTexture.sample(CurveTextureSampler, (EmitterUniforms.EmitterUniforms_MiscCurve.xy + (EmitterUniforms.EmitterUniforms_MiscCurve.zw * float2(_146))), level(0.0)) * EmitterUniforms.EmitterUniforms_MiscScale) + EmitterUniforms.EmitterUniforms_MiscBias).xy * EmitterDynamicUniforms.EmitterDynamicUniforms_LocalToWorldScale)) * fast::min(fast::max(EmitterUniforms.EmitterUniforms_SizeBySpeed.xy * float2(length(_158)), float2(1.0)), EmitterUniforms.EmitterUniforms_SizeBySpeed.zw)) * float2(step(_146, 1.0));
     float3 _239 = float4((((Primitive.Primitive_LocalToWorld[0u].xyz * _137.xxx) + (Primitive.Primitive_LocalToWorld[1u].xyz * _137.yyy)) + (Primitive.Primitive_LocalToWorld[2u].xyz * _137.zzz)) + (Primitive.Primitive_LocalToWorld[3u].xyz + float3(View.View_PreViewTranslation)), 1.0).xyz;
     float3 _242 = float3(EmitterUniforms.EmitterUniforms_RemoveHMDRoll);
@@ -304,13 +304,13 @@ vertex main0_out main0(main0_in in [[stage_in]], constant type_View& View [[buff
     float3 _259 = mix(-mix(float3(View.View_ViewUp), float3(View.View_HMDViewNoRollUp), _242), EmitterDynamicUniforms.EmitterDynamicUniforms_AxisLockUp.xyz, float3(EmitterDynamicUniforms.EmitterDynamicUniforms_AxisLockUp.w));
     float3 _260 = float3(View.View_TranslatedWorldCameraOrigin) - _239;
     float _261 = dot(_260, _260);
-    float3 _265 = _260 / float3(sqrt(fast::max(_261, 0.00999999977648258209228515625)));
+    float3 _265 = _260 / float3(sqrt(fast::max(_261, 0.01)));
     float3 _335;
     float3 _336;
     if (EmitterUniforms.EmitterUniforms_CameraFacingBlend[0] > 0.0)
     {
         float3 _279 = cross(_265, float3(0.0, 0.0, 1.0));
-        float3 _284 = _279 / float3(sqrt(fast::max(dot(_279, _279), 0.00999999977648258209228515625)));
+        float3 _284 = _279 / float3(sqrt(fast::max(dot(_279, _279), 0.01)));
         float3 _286 = float3(fast::clamp((_261 * EmitterUniforms.EmitterUniforms_CameraFacingBlend[1]) - EmitterUniforms.EmitterUniforms_CameraFacingBlend[2], 0.0, 1.0));
         _335 = normalize(mix(_251, _284, _286));
         _336 = normalize(mix(_259, cross(_265, _284), _286));
@@ -322,7 +322,7 @@ vertex main0_out main0(main0_in in [[stage_in]], constant type_View& View [[buff
         if (EmitterUniforms.EmitterUniforms_TangentSelector.y > 0.0)
         {
             float3 _297 = cross(_265, _160);
-            _333 = _297 / float3(sqrt(fast::max(dot(_297, _297), 0.00999999977648258209228515625)));
+            _333 = _297 / float3(sqrt(fast::max(dot(_297, _297), 0.01)));
             _334 = -_160;
         }
         else
@@ -333,7 +333,7 @@ vertex main0_out main0(main0_in in [[stage_in]], constant type_View& View [[buff
             {
                 float3 _310 = cross(EmitterDynamicUniforms.EmitterDynamicUniforms_AxisLockRight.xyz, _265);
                 _331 = EmitterDynamicUniforms.EmitterDynamicUniforms_AxisLockRight.xyz;
-                _332 = -(_310 / float3(sqrt(fast::max(dot(_310, _310), 0.00999999977648258209228515625))));
+                _332 = -(_310 / float3(sqrt(fast::max(dot(_310, _310), 0.01))));
             }
             else
             {
@@ -342,7 +342,7 @@ vertex main0_out main0(main0_in in [[stage_in]], constant type_View& View [[buff
                 if (EmitterUniforms.EmitterUniforms_TangentSelector.w > 0.0)
                 {
                     float3 _322 = cross(_265, float3(0.0, 0.0, 1.0));
-                    float3 _327 = _322 / float3(sqrt(fast::max(dot(_322, _322), 0.00999999977648258209228515625)));
+                    float3 _327 = _322 / float3(sqrt(fast::max(dot(_322, _322), 0.01)));
                     _329 = _327;
                     _330 = cross(_265, _327);
                 }
@@ -360,7 +360,7 @@ vertex main0_out main0(main0_in in [[stage_in]], constant type_View& View [[buff
         _335 = _333;
         _336 = _334;
     }
-    float _339 = ((_145.z + ((_145.w * EmitterUniforms.EmitterUniforms_RotationRateScale) * _146)) * 6.283185482025146484375) + EmitterUniforms.EmitterUniforms_RotationBias;
+    float _339 = ((_145.z + ((_145.w * EmitterUniforms.EmitterUniforms_RotationRateScale) * _146)) * 6.2831855) + EmitterUniforms.EmitterUniforms_RotationBias;
     float3 _342 = float3(sin(_339));
     float3 _344 = float3(cos(_339));
     float4 _371 = float4(_239 + ((float3(_204.x * (in.in_var_ATTRIBUTE0.x + EmitterUniforms.EmitterUniforms_PivotOffset.x)) * ((_342 * _336) + (_344 * _335))) + (float3(_204.y * (in.in_var_ATTRIBUTE0.y + EmitterUniforms.EmitterUniforms_PivotOffset.y)) * ((_344 * _336) - (_342 * _335)))), 1.0);
@@ -369,7 +369,7 @@ vertex main0_out main0(main0_in in [[stage_in]], constant type_View& View [[buff
     if ((MobileShadowDepthPass.MobileShadowDepthPass_bClampToNearPlane > 0.0) && (_375.z < 0.0))
     {
         float4 _384 = _375;
-        _384.z = 9.9999999747524270787835121154785e-07;
+        _384.z = 1e-06;
         float4 _385 = _384;
         _385.w = 1.0;
         _386 = _385;
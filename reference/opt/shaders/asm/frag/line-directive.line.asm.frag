@@ -26,9 +26,9 @@ void main()
     for (int _127 = 0; float(_127) < (40.0 + vColor); )
     {
 #line 21 "test.frag"
-        FragColor += 0.20000000298023223876953125;
+        FragColor += 0.2;
 #line 22 "test.frag"
-        FragColor += 0.300000011920928955078125;
+        FragColor += 0.3;
 #line 19 "test.frag"
         _127 += (int(vColor) + 5);
         continue;
@@ -39,21 +39,21 @@ void main()
         case 0:
         {
 #line 28 "test.frag"
-            FragColor += 0.20000000298023223876953125;
+            FragColor += 0.2;
 #line 29 "test.frag"
             break;
         }
         case 1:
         {
 #line 32 "test.frag"
-            FragColor += 0.4000000059604644775390625;
+            FragColor += 0.4;
 #line 33 "test.frag"
             break;
         }
         default:
         {
 #line 36 "test.frag"
-            FragColor += 0.800000011920928955078125;
+            FragColor += 0.8;
 #line 37 "test.frag"
             break;
         }
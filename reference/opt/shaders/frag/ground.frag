@@ -24,9 +24,9 @@ layout(location = 1) in vec3 EyeVec;
 void main()
 {
     vec3 _68 = normalize((texture(TexNormalmap, TexCoord).xyz * 2.0) - vec3(1.0));
-    float _113 = smoothstep(0.0, 0.1500000059604644775390625, (_101.g_CamPos.y + EyeVec.y) * 0.004999999888241291046142578125);
-    float _125 = smoothstep(0.699999988079071044921875, 0.75, _68.y);
-    vec3 _130 = mix(vec3(0.100000001490116119384765625), mix(vec3(0.100000001490116119384765625, 0.300000011920928955078125, 0.100000001490116119384765625), vec3(0.800000011920928955078125), vec3(_113)), vec3(_125));
+    float _113 = smoothstep(0.0, 0.15, (_101.g_CamPos.y + EyeVec.y) * 0.005);
+    float _125 = smoothstep(0.7, 0.75, _68.y);
+    vec3 _130 = mix(vec3(0.1), mix(vec3(0.1, 0.3, 0.1), vec3(0.8), vec3(_113)), vec3(_125));
     LightingOut = vec4(0.0);
     NormalOut = vec4((_68 * 0.5) + vec3(0.5), 0.0);
     SpecularOut = vec4(1.0 - (_125 * _113), 0.0, 0.0, 0.0);
@@ -16,12 +16,12 @@ void main()
     {
         case 0u:
         {
-            fsout_Color = vec4(0.100000001490116119384765625);
+            fsout_Color = vec4(0.1);
             break;
         }
         case 1u:
         {
-            fsout_Color = vec4(0.20000000298023223876953125);
+            fsout_Color = vec4(0.2);
             break;
         }
     }
@@ -14,9 +14,9 @@ void main()
     float _23 = _19.x;
     FragColor = vec4(_23, _19.yz, 1.0);
     FragColor = vec4(_23, _19.z, 1.0, 4.0);
-    FragColor = vec4(_23, _23, texture(samp, vUV + vec2(0.100000001490116119384765625)).yy);
+    FragColor = vec4(_23, _23, texture(samp, vUV + vec2(0.1)).yy);
     FragColor = vec4(vNormal, 1.0);
-    FragColor = vec4(vNormal + vec3(1.7999999523162841796875), 1.0);
-    FragColor = vec4(vUV, vUV + vec2(1.7999999523162841796875));
+    FragColor = vec4(vNormal + vec3(1.8), 1.0);
+    FragColor = vec4(vUV, vUV + vec2(1.8));
 }
 
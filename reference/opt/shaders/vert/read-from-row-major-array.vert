@@ -13,6 +13,6 @@ mat2x3 spvWorkaroundRowMajor(mat2x3 wrap) { return wrap; }
 void main()
 {
     gl_Position = a_position;
-    v_vtxResult = ((float(abs(spvWorkaroundRowMajor(_104.var[0][0])[0].x - 2.0) < 0.0500000007450580596923828125) * float(abs(spvWorkaroundRowMajor(_104.var[0][0])[0].y - 6.0) < 0.0500000007450580596923828125)) * float(abs(spvWorkaroundRowMajor(_104.var[0][0])[0].z - (-6.0)) < 0.0500000007450580596923828125)) * ((float(abs(spvWorkaroundRowMajor(_104.var[0][0])[1].x) < 0.0500000007450580596923828125) * float(abs(spvWorkaroundRowMajor(_104.var[0][0])[1].y - 5.0) < 0.0500000007450580596923828125)) * float(abs(spvWorkaroundRowMajor(_104.var[0][0])[1].z - 5.0) < 0.0500000007450580596923828125));
+    v_vtxResult = ((float(abs(spvWorkaroundRowMajor(_104.var[0][0])[0].x - 2.0) < 0.05) * float(abs(spvWorkaroundRowMajor(_104.var[0][0])[0].y - 6.0) < 0.05)) * float(abs(spvWorkaroundRowMajor(_104.var[0][0])[0].z - (-6.0)) < 0.05)) * ((float(abs(spvWorkaroundRowMajor(_104.var[0][0])[1].x) < 0.05) * float(abs(spvWorkaroundRowMajor(_104.var[0][0])[1].y - 5.0) < 0.05)) * float(abs(spvWorkaroundRowMajor(_104.var[0][0])[1].z - 5.0) < 0.05));
 }
 
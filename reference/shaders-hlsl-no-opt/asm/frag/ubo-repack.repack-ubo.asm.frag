@@ -0,0 +1,32 @@
+cbuffer UBO : register(b0)
+{
+    float _5_f[2] : packoffset(c0);
+    row_major float2x2 _5_g : packoffset(c2);
+    float4 _5_b : packoffset(c4);
+    float3 _5_d : packoffset(c5);
+    float _5_a : packoffset(c5.w);
+    float2 _5_e : packoffset(c6);
+    float2 _5_h : packoffset(c6.z);
+    float _5_c : packoffset(c7);
+};
+
+
+static float4 FragColor;
+
+struct SPIRV_Cross_Output
+{
+    float4 FragColor : SV_Target0;
+};
+
+void frag_main()
+{
+    FragColor = _5_b + ((((((_5_a + _5_c) + _5_d.x) + _5_e.x) + _5_f[1]) + _5_g[1].x) + _5_h.y).xxxx;
+}
+
+SPIRV_Cross_Output main()
+{
+    frag_main();
+    SPIRV_Cross_Output stage_output;
+    stage_output.FragColor = FragColor;
+    return stage_output;
+}
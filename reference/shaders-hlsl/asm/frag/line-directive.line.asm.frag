@@ -33,9 +33,9 @@ void func()
     for (int i = 0; float(i) < (40.0f + vColor); i += (int(vColor) + 5))
     {
 #line 21 "test.frag"
-        FragColor += 0.20000000298023223876953125f;
+        FragColor += 0.2f;
 #line 22 "test.frag"
-        FragColor += 0.300000011920928955078125f;
+        FragColor += 0.3f;
     }
 #line 25 "test.frag"
     switch (int(vColor))
@@ -43,21 +43,21 @@ void func()
         case 0:
         {
 #line 28 "test.frag"
-            FragColor += 0.20000000298023223876953125f;
+            FragColor += 0.2f;
 #line 29 "test.frag"
             break;
         }
         case 1:
         {
 #line 32 "test.frag"
-            FragColor += 0.4000000059604644775390625f;
+            FragColor += 0.4f;
 #line 33 "test.frag"
             break;
         }
         default:
         {
 #line 36 "test.frag"
-            FragColor += 0.800000011920928955078125f;
+            FragColor += 0.8f;
 #line 37 "test.frag"
             break;
         }
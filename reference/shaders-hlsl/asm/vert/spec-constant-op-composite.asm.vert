@@ -15,7 +15,7 @@ static const int4 _30 = SPIRV_CROSS_CONSTANT_ID_0;
 static const int2 _32 = int2(_30.y, _30.x);
 static const int _33 = _30.y;
 #ifndef SPIRV_CROSS_CONSTANT_ID_200
-#define SPIRV_CROSS_CONSTANT_ID_200 3.141590118408203125f
+#define SPIRV_CROSS_CONSTANT_ID_200 3.14159f
 #endif
 static const float _9 = SPIRV_CROSS_CONSTANT_ID_200;
 
@@ -20,17 +20,17 @@ struct SPIRV_Cross_Output
 
 float4 sample_from_global()
 {
-    return uSampler[vIndex].Sample(_uSampler_sampler[vIndex], vTex + 0.100000001490116119384765625f.xx);
+    return uSampler[vIndex].Sample(_uSampler_sampler[vIndex], vTex + 0.1f.xx);
 }
 
 float4 sample_from_argument(Texture2D<float4> samplers[4], SamplerState _samplers_sampler[4])
 {
-    return samplers[vIndex].Sample(_samplers_sampler[vIndex], vTex + 0.20000000298023223876953125f.xx);
+    return samplers[vIndex].Sample(_samplers_sampler[vIndex], vTex + 0.2f.xx);
 }
 
 float4 sample_single_from_argument(Texture2D<float4> samp, SamplerState _samp_sampler)
 {
-    return samp.Sample(_samp_sampler, vTex + 0.300000011920928955078125f.xx);
+    return samp.Sample(_samp_sampler, vTex + 0.3f.xx);
 }
 
 void frag_main()
@@ -21,7 +21,7 @@ struct SPIRV_Cross_Output
 
 float compare_float(float a, float b)
 {
-    return float(abs(a - b) < 0.0500000007450580596923828125f);
+    return float(abs(a - b) < 0.05f);
 }
 
 float compare_vec3(float3 a, float3 b)
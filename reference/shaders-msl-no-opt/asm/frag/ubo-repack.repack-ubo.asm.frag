@@ -0,0 +1,29 @@
+#include <metal_stdlib>
+#include <simd/simd.h>
+
+using namespace metal;
+
+struct UBO
+{
+    float4 f[2];
+    float2x4 g;
+    float4 b;
+    packed_float3 d;
+    float a;
+    float2 e;
+    float2 h;
+    float c;
+};
+
+struct main0_out
+{
+    float4 FragColor [[color(0)]];
+};
+
+fragment main0_out main0(constant UBO& _5 [[buffer(0)]])
+{
+    main0_out out = {};
+    out.FragColor = _5.b + float4((((((_5.a + _5.c) + _5.d[0u]) + _5.e.x) + _5.f[1].x) + _5.g[1].x) + _5.h.y);
+    return out;
+}
+
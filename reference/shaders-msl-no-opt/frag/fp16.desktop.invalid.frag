@@ -62,7 +62,7 @@ void test_constants()
     half e = half(1.0 / 0.0);
     half f = half(-1.0 / 0.0);
     half g = half(1014.0);
-    half h = half(9.5367431640625e-07);
+    half h = half(9.536743e-07);
 }
 
 static inline __attribute__((always_inline))
@@ -28,7 +28,7 @@ fragment main0_out main0()
     o5 = float4(0.25);
     out.o6 = float4(0.75);
     out.o7 = float4(1.0);
-    gl_FragDepth = 0.89999997615814208984375;
+    gl_FragDepth = 0.9;
     gl_FragStencilRefARB = uint(127);
     return out;
 }
@@ -38,9 +38,9 @@ void func(thread float& FragColor, thread float& vColor)
     for (int i = 0; float(i) < (40.0 + vColor); i += (int(vColor) + 5))
     {
 #line 21 "test.frag"
-        FragColor += 0.20000000298023223876953125;
+        FragColor += 0.2;
 #line 22 "test.frag"
-        FragColor += 0.300000011920928955078125;
+        FragColor += 0.3;
     }
 #line 25 "test.frag"
     switch (int(vColor))
@@ -48,21 +48,21 @@ void func(thread float& FragColor, thread float& vColor)
         case 0:
         {
 #line 28 "test.frag"
-            FragColor += 0.20000000298023223876953125;
+            FragColor += 0.2;
 #line 29 "test.frag"
             break;
         }
         case 1:
         {
 #line 32 "test.frag"
-            FragColor += 0.4000000059604644775390625;
+            FragColor += 0.4;
 #line 33 "test.frag"
             break;
         }
         default:
         {
 #line 36 "test.frag"
-            FragColor += 0.800000011920928955078125;
+            FragColor += 0.8;
 #line 37 "test.frag"
             break;
         }
@@ -0,0 +1,23 @@
+#include <metal_stdlib>
+#include <simd/simd.h>
+
+using namespace metal;
+
+struct UBO
+{
+    float4x4 m;
+    int4 idx[4];
+};
+
+struct main0_out
+{
+    float FragColor [[color(0)]];
+};
+
+fragment main0_out main0(constant UBO& ubo [[buffer(0)]])
+{
+    main0_out out = {};
+    out.FragColor = ubo.m[2][ubo.idx[1]];
+    return out;
+}
+
@@ -13,7 +13,7 @@ constant int4 _30 = int4(20, 30, _20, _20);
 constant int2 _32 = int2(_30.y, _30.x);
 constant int _33 = _30.y;
 constant float _9_tmp [[function_constant(200)]];
-constant float _9 = is_function_constant_defined(_9_tmp) ? _9_tmp : 3.141590118408203125;
+constant float _9 = is_function_constant_defined(_9_tmp) ? _9_tmp : 3.14159;
 
 struct main0_out
 {
@@ -0,0 +1,43 @@
+#include <metal_stdlib>
+#include <simd/simd.h>
+
+using namespace metal;
+
+struct UBO
+{
+    float4 scale;
+};
+
+struct SSBO
+{
+    float4 bias0;
+};
+
+struct main0_out
+{
+    float4 gl_Position [[position]];
+};
+
+struct spvVertexAttribute
+{
+    uint offset;
+    uint stride;
+    uint instance_divisor;
+};
+
+struct main0_in
+{
+    float4 aPosition;
+    float4 aOffset;
+};
+
+vertex main0_out main0(constant UBO& ubo [[buffer(1)]], const device SSBO& ssbo [[buffer(3)]], uint gl_VertexIndex [[vertex_id]], uint gl_InstanceIndex [[instance_id]], uint gl_BaseInstance [[base_instance]], const device uchar* spvVertexBuffer0 [[buffer(0)]], const device uchar* spvVertexBuffer2 [[buffer(2)]], constant spvVertexAttribute* spvVertexAttributes [[buffer(20)]])
+{
+    main0_out out = {};
+    main0_in in = {};
+    in.aPosition = float4(*reinterpret_cast<const device packed_float4*>(spvVertexBuffer0 + spvVertexAttributes[0].offset + (spvVertexAttributes[0].instance_divisor != 0 ? (gl_InstanceIndex - gl_BaseInstance) / spvVertexAttributes[0].instance_divisor + gl_BaseInstance : gl_VertexIndex) * spvVertexAttributes[0].stride));
+    in.aOffset = float4(*reinterpret_cast<const device packed_float4*>(spvVertexBuffer2 + spvVertexAttributes[2].offset + (spvVertexAttributes[2].instance_divisor != 0 ? (gl_InstanceIndex - gl_BaseInstance) / spvVertexAttributes[2].instance_divisor + gl_BaseInstance : gl_VertexIndex) * spvVertexAttributes[2].stride));
+    out.gl_Position = ((in.aPosition + in.aOffset) * ubo.scale) + ssbo.bias0;
+    return out;
+}
+
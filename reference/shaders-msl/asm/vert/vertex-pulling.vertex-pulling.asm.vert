@@ -0,0 +1,39 @@
+#include <metal_stdlib>
+#include <simd/simd.h>
+
+using namespace metal;
+
+struct main0_out
+{
+    float2 vUV [[user(locn0)]];
+    uint vIndex [[user(locn1)]];
+    float4 gl_Position [[position]];
+};
+
+struct spvVertexAttribute
+{
+    uint offset;
+    uint stride;
+    uint instance_divisor;
+};
+
+struct main0_in
+{
+    float3 aPosition;
+    float2 aUV;
+    uint aIndex;
+};
+
+vertex main0_out main0(uint gl_VertexIndex [[vertex_id]], uint gl_InstanceIndex [[instance_id]], uint gl_BaseInstance [[base_instance]], const device uchar* spvVertexBuffer0 [[buffer(8)]], const device uchar* spvVertexBuffer1 [[buffer(9)]], const device uchar* spvVertexBuffer3 [[buffer(11)]], constant spvVertexAttribute* spvVertexAttributes [[buffer(20)]])
+{
+    main0_out out = {};
+    main0_in in = {};
+    in.aPosition = float3(*reinterpret_cast<const device packed_float3*>(spvVertexBuffer0 + spvVertexAttributes[0].offset + (spvVertexAttributes[0].instance_divisor != 0 ? (gl_InstanceIndex - gl_BaseInstance) / spvVertexAttributes[0].instance_divisor + gl_BaseInstance : gl_VertexIndex) * spvVertexAttributes[0].stride));
+    in.aUV = float2(*reinterpret_cast<const device packed_float2*>(spvVertexBuffer1 + spvVertexAttributes[1].offset + (spvVertexAttributes[1].instance_divisor != 0 ? (gl_InstanceIndex - gl_BaseInstance) / spvVertexAttributes[1].instance_divisor + gl_BaseInstance : gl_VertexIndex) * spvVertexAttributes[1].stride));
+    in.aIndex = *reinterpret_cast<const device uint*>(spvVertexBuffer3 + spvVertexAttributes[3].offset + (spvVertexAttributes[3].instance_divisor != 0 ? (gl_InstanceIndex - gl_BaseInstance) / spvVertexAttributes[3].instance_divisor + gl_BaseInstance : gl_VertexIndex) * spvVertexAttributes[3].stride);
+    out.gl_Position = float4(in.aPosition, 1.0);
+    out.vUV = in.aUV;
+    out.vIndex = in.aIndex;
+    return out;
+}
+
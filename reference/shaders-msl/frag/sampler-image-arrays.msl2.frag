@@ -19,19 +19,19 @@ struct main0_in
 static inline __attribute__((always_inline))
 float4 sample_from_global(thread int& vIndex, thread float2& vTex, thread const array<texture2d<float>, 4> uSampler, thread const array<sampler, 4> uSamplerSmplr)
 {
-    return uSampler[vIndex].sample(uSamplerSmplr[vIndex], (vTex + float2(0.100000001490116119384765625)));
+    return uSampler[vIndex].sample(uSamplerSmplr[vIndex], (vTex + float2(0.1)));
 }
 
 static inline __attribute__((always_inline))
 float4 sample_from_argument(thread const array<texture2d<float>, 4> samplers, thread const array<sampler, 4> samplersSmplr, thread int& vIndex, thread float2& vTex)
 {
-    return samplers[vIndex].sample(samplersSmplr[vIndex], (vTex + float2(0.20000000298023223876953125)));
+    return samplers[vIndex].sample(samplersSmplr[vIndex], (vTex + float2(0.2)));
 }
 
 static inline __attribute__((always_inline))
 float4 sample_single_from_argument(thread const texture2d<float> samp, thread const sampler sampSmplr, thread float2& vTex)
 {
-    return samp.sample(sampSmplr, (vTex + float2(0.300000011920928955078125)));
+    return samp.sample(sampSmplr, (vTex + float2(0.3)));
 }
 
 fragment main0_out main0(main0_in in [[stage_in]], array<texture2d<float>, 4> uSampler [[texture(0)]], array<texture2d<float>, 4> uTextures [[texture(4)]], array<sampler, 4> uSamplerSmplr [[sampler(0)]], array<sampler, 4> uSamplers [[sampler(4)]])
@@ -14,7 +14,7 @@ struct main0_out
 static inline __attribute__((always_inline))
 void set_output_depth(thread float& gl_FragDepth)
 {
-    gl_FragDepth = 0.20000000298023223876953125;
+    gl_FragDepth = 0.2;
 }
 
 fragment main0_out main0()
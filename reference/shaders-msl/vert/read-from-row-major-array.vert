@@ -24,7 +24,7 @@ struct main0_in
 static inline __attribute__((always_inline))
 float compare_float(thread const float& a, thread const float& b)
 {
-    return float(abs(a - b) < 0.0500000007450580596923828125);
+    return float(abs(a - b) < 0.05);
 }
 
 static inline __attribute__((always_inline))
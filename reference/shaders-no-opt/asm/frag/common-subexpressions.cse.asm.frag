@@ -0,0 +1,18 @@
+#version 450
+
+layout(binding = 0, std140) uniform UBO
+{
+    vec4 scale;
+    vec4 offsets[4];
+} _7;
+
+layout(location = 0) flat in int vIndex;
+layout(location = 1) in vec2 vUV;
+layout(location = 0) out vec4 FragColor;
+
+void main()
+{
+    vec4 _39 = (_7.scale * vUV.xyxy) + _7.offsets[vIndex & 3];
+    FragColor = _39 * _39;
+}
+
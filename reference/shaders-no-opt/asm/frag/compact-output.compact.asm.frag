@@ -0,0 +1,2 @@
+#version 450
+void main(){int _13;for(int _12=0;!(_12==16);_12=_13){_13=_12+1;}}
@@ -125,7 +125,7 @@ void main()
     _151.UvStuds = IN_UvStuds_EdgeDistance2.xy;
     SurfaceInput _156 = _151;
     _156.UvStuds.y = (fract(_151.UvStuds.y) + IN_studIndex) * 0.25;
-    float _160 = clamp(1.0 - (_146.View_Depth.w * 0.00333332992158830165863037109375), 0.0, 1.0);
+    float _160 = clamp(1.0 - (_146.View_Depth.w * 0.00333333), 0.0, 1.0);
     float _163 = _146.View_Depth.w * _19.CB0.RefractionBias_FadeDistance_GlowFactor.y;
     float _165 = clamp(1.0 - _163, 0.0, 1.0);
     vec2 _166 = IN_Uv_EdgeDistance1.xy * 1.0;
@@ -175,7 +175,7 @@ void main()
     vec2 _255 = _253.xy * _165;
     vec3 _256 = vec3(_255.x, _255.y, _253.z);
     vec4 _268 = texture(SPIRV_Cross_CombinedStudsMapTextureStudsMapSampler, _156.UvStuds);
-    vec3 _271 = ((IN_Color.xyz * (_193 * 1.0).xyz) * (1.0 + (_256.x * 0.300000011920928955078125))) * (_268.x * 2.0);
+    vec3 _271 = ((IN_Color.xyz * (_193 * 1.0).xyz) * (1.0 + (_256.x * 0.3))) * (_268.x * 2.0);
     vec4 _298;
     for (;;)
     {
@@ -193,7 +193,7 @@ void main()
         _298 = _297;
         break;
     }
-    vec2 _303 = mix(vec2(0.800000011920928955078125, 120.0), (_298.xy * vec2(2.0, 256.0)) + vec2(0.0, 0.00999999977648258209228515625), vec2(_165));
+    vec2 _303 = mix(vec2(0.8, 120.0), (_298.xy * vec2(2.0, 256.0)) + vec2(0.0, 0.01), vec2(_165));
     Surface _304 = _125;
     _304.albedo = _271;
     Surface _305 = _304;
@@ -0,0 +1,20 @@
+#version 450
+
+layout(binding = 0, std430) buffer Counter
+{
+    int count;
+} counter;
+
+layout(location = 0) out vec4 FragColor;
+layout(location = 0) in float vValue;
+
+void main()
+{
+    float value = vValue;
+    float _23 = value;
+    value = 2.0;
+    int _26 = counter.count;
+    counter.count = _26 + 1;
+    FragColor = vec4((_23 + 1.0) * value, float(_26), 1.0, 1.0);
+}
+
@@ -0,0 +1,19 @@
+#version 310 es
+precision mediump float;
+precision highp int;
+
+layout(binding = 0) uniform mediump sampler2D uTex;
+
+layout(location = 0) in highp vec2 vUV;
+layout(location = 1) in vec4 vColor;
+layout(location = 0) out vec4 FragColor;
+layout(location = 1) out highp vec4 FragScaled;
+
+void main()
+{
+    vec4 tinted = texture(uTex, vUV) * vColor;
+    vec4 shaded = tinted * 0.5;
+    FragColor = normalize(shaded);
+    FragScaled = shaded * min(vUV.x * 100000.0, 1.0);
+}
+
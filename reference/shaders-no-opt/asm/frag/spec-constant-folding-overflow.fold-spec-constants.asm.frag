@@ -0,0 +1,13 @@
+#version 450
+
+const int Quotient = ((-2147483648) / (-1));
+const int Modulo = ((-2147483648) % (-1));
+const int Shifted = (1 << 32);
+
+layout(location = 0) out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(float(Quotient), float(Modulo), float(Shifted), float(1073741824));
+}
+
@@ -0,0 +1,32 @@
+#version 450
+
+#ifndef SPIRV_CROSS_CONSTANT_ID_2
+#define SPIRV_CROSS_CONSTANT_ID_2 4
+#endif
+const int Unfolded = SPIRV_CROSS_CONSTANT_ID_2;
+const int UnfoldedPlusOne = (Unfolded + 1);
+const bool UnfoldedLarge = (Unfolded > 3);
+
+layout(location = 0) out vec4 FragColor;
+layout(location = 0) flat in int vIndex;
+
+void main()
+{
+    FragColor = vec4(0.0);
+    FragColor = vec4(1.0);
+    do
+    {
+        if (vIndex == 1)
+        {
+            break;
+        }
+        FragColor *= float(5);
+        break;
+    } while(false);
+    if (UnfoldedLarge)
+    {
+        FragColor *= 2.0;
+    }
+    FragColor += vec4(float(UnfoldedPlusOne));
+}
+
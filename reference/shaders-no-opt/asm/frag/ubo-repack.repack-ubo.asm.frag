@@ -0,0 +1,21 @@
+#version 450
+
+layout(binding = 0, std140) uniform UBO
+{
+    float f[2];
+    mat2 g;
+    vec4 b;
+    vec3 d;
+    float a;
+    vec2 e;
+    vec2 h;
+    float c;
+} _5;
+
+layout(location = 0) out vec4 FragColor;
+
+void main()
+{
+    FragColor = _5.b + vec4((((((_5.a + _5.c) + _5.d.x) + _5.e.x) + _5.f[1]) + _5.g[1].x) + _5.h.y);
+}
+
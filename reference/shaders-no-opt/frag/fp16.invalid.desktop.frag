@@ -37,7 +37,7 @@ void test_constants()
     float16_t e = float16_t(1.0 / 0.0);
     float16_t f = float16_t(-1.0 / 0.0);
     float16_t g = float16_t(1014.0);
-    float16_t h = float16_t(9.5367431640625e-07);
+    float16_t h = float16_t(9.536743e-07);
 }
 
 float16_t test_result()
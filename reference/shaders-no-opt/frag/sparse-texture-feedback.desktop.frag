@@ -25,7 +25,7 @@ void main()
     bool ret = sparseTexelsResidentARB(_24._m0);
     int _146;
     vec4 _147;
-    _146 = sparseTextureARB(uSamp, vUV, _147, 1.10000002384185791015625);
+    _146 = sparseTextureARB(uSamp, vUV, _147, 1.1);
     ResType _31 = ResType(_146, _147);
     texel = _31._m1;
     ret = sparseTexelsResidentARB(_31._m0);
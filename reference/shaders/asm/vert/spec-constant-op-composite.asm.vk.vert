@@ -14,7 +14,7 @@ const ivec4 _30 = ivec4(20, 30, _20, _20);
 const ivec2 _32 = ivec2(_30.y, _30.x);
 const int _33 = _30.y;
 #ifndef SPIRV_CROSS_CONSTANT_ID_200
-#define SPIRV_CROSS_CONSTANT_ID_200 3.141590118408203125
+#define SPIRV_CROSS_CONSTANT_ID_200 3.14159
 #endif
 const float _9 = SPIRV_CROSS_CONSTANT_ID_200;
 
@@ -7,6 +7,6 @@ uniform mediump sampler2D tex;
 
 void main()
 {
-    gl_FragData[0] = texture2DLodEXT(tex, vec2(0.4000000059604644775390625, 0.60000002384185791015625), 0.0);
+    gl_FragData[0] = texture2DLodEXT(tex, vec2(0.4, 0.6), 0.0);
 }
 
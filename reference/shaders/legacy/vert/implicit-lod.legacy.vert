@@ -4,6 +4,6 @@ uniform mediump sampler2D tex;
 
 void main()
 {
-    gl_Position = texture2DLod(tex, vec2(0.4000000059604644775390625, 0.60000002384185791015625), 0.0);
+    gl_Position = texture2DLod(tex, vec2(0.4, 0.6), 0.0);
 }
 
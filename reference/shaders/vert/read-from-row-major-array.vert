@@ -12,7 +12,7 @@ mat2x3 spvWorkaroundRowMajor(mat2x3 wrap) { return wrap; }
 
 mediump float compare_float(float a, float b)
 {
-    return float(abs(a - b) < 0.0500000007450580596923828125);
+    return float(abs(a - b) < 0.05);
 }
 
 mediump float compare_vec3(vec3 a, vec3 b)
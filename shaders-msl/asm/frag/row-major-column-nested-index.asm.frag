@@ -0,0 +1,53 @@
+; SPIR-V
+; Version: 1.0
+; Generator: Khronos Glslang Reference Front End; 10
+; Bound: 40
+; Schema: 0
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %main "main" %FragColor
+               OpExecutionMode %main OriginUpperLeft
+               OpSource GLSL 450
+               OpName %main "main"
+               OpName %UBO "UBO"
+               OpMemberName %UBO 0 "m"
+               OpMemberName %UBO 1 "idx"
+               OpName %ubo "ubo"
+               OpName %FragColor "FragColor"
+               OpDecorate %_arr_int_uint_4 ArrayStride 16
+               OpMemberDecorate %UBO 0 RowMajor
+               OpMemberDecorate %UBO 0 Offset 0
+               OpMemberDecorate %UBO 0 MatrixStride 16
+               OpMemberDecorate %UBO 1 Offset 64
+               OpDecorate %UBO Block
+               OpDecorate %ubo DescriptorSet 0
+               OpDecorate %ubo Binding 0
+               OpDecorate %FragColor Location 0
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+    %v4float = OpTypeVector %float 4
+%mat4v4float = OpTypeMatrix %v4float 4
+        %int = OpTypeInt 32 1
+       %uint = OpTypeInt 32 0
+     %uint_4 = OpConstant %uint 4
+%_arr_int_uint_4 = OpTypeArray %int %uint_4
+        %UBO = OpTypeStruct %mat4v4float %_arr_int_uint_4
+%_ptr_Uniform_UBO = OpTypePointer Uniform %UBO
+        %ubo = OpVariable %_ptr_Uniform_UBO Uniform
+      %int_0 = OpConstant %int 0
+      %int_1 = OpConstant %int 1
+      %int_2 = OpConstant %int 2
+%_ptr_Uniform_int = OpTypePointer Uniform %int
+%_ptr_Uniform_float = OpTypePointer Uniform %float
+%_ptr_Output_float = OpTypePointer Output %float
+  %FragColor = OpVariable %_ptr_Output_float Output
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+         %ip = OpAccessChain %_ptr_Uniform_int %ubo %int_1 %int_1
+        %idx = OpLoad %int %ip
+         %fp = OpAccessChain %_ptr_Uniform_float %ubo %int_0 %idx %int_2
+          %f = OpLoad %float %fp
+               OpStore %FragColor %f
+               OpReturn
+               OpFunctionEnd
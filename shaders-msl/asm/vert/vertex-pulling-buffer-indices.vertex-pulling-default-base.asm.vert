@@ -0,0 +1,63 @@
+; SPIR-V
+; Version: 1.0
+; Generator: Khronos Glslang Reference Front End; 10
+; Bound: 40
+; Schema: 0
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Vertex %main "main" %gl_Position %aPosition %aOffset
+               OpSource GLSL 450
+               OpName %main "main"
+               OpName %gl_Position "gl_Position"
+               OpName %aPosition "aPosition"
+               OpName %aOffset "aOffset"
+               OpName %UBO "UBO"
+               OpMemberName %UBO 0 "scale"
+               OpName %ubo "ubo"
+               OpName %SSBO "SSBO"
+               OpMemberName %SSBO 0 "bias"
+               OpName %ssbo "ssbo"
+               OpDecorate %gl_Position BuiltIn Position
+               OpDecorate %aPosition Location 0
+               OpDecorate %aOffset Location 2
+               OpMemberDecorate %UBO 0 Offset 0
+               OpDecorate %UBO Block
+               OpDecorate %ubo DescriptorSet 0
+               OpDecorate %ubo Binding 0
+               OpMemberDecorate %SSBO 0 NonWritable
+               OpMemberDecorate %SSBO 0 Offset 0
+               OpDecorate %SSBO BufferBlock
+               OpDecorate %ssbo DescriptorSet 0
+               OpDecorate %ssbo Binding 1
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+    %v4float = OpTypeVector %float 4
+%_ptr_Output_v4float = OpTypePointer Output %v4float
+%gl_Position = OpVariable %_ptr_Output_v4float Output
+%_ptr_Input_v4float = OpTypePointer Input %v4float
+  %aPosition = OpVariable %_ptr_Input_v4float Input
+    %aOffset = OpVariable %_ptr_Input_v4float Input
+        %int = OpTypeInt 32 1
+      %int_0 = OpConstant %int 0
+        %UBO = OpTypeStruct %v4float
+%_ptr_Uniform_UBO = OpTypePointer Uniform %UBO
+        %ubo = OpVariable %_ptr_Uniform_UBO Uniform
+       %SSBO = OpTypeStruct %v4float
+%_ptr_Uniform_SSBO = OpTypePointer Uniform %SSBO
+       %ssbo = OpVariable %_ptr_Uniform_SSBO Uniform
+%_ptr_Uniform_v4float = OpTypePointer Uniform %v4float
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+         %13 = OpLoad %v4float %aPosition
+         %14 = OpLoad %v4float %aOffset
+         %15 = OpFAdd %v4float %13 %14
+         %20 = OpAccessChain %_ptr_Uniform_v4float %ubo %int_0
+         %21 = OpLoad %v4float %20
+         %22 = OpFMul %v4float %15 %21
+         %23 = OpAccessChain %_ptr_Uniform_v4float %ssbo %int_0
+         %24 = OpLoad %v4float %23
+         %25 = OpFAdd %v4float %22 %24
+               OpStore %gl_Position %25
+               OpReturn
+               OpFunctionEnd
@@ -0,0 +1,57 @@
+; SPIR-V
+; Version: 1.0
+; Generator: Khronos Glslang Reference Front End; 10
+; Bound: 31
+; Schema: 0
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Vertex %main "main" %gl_Position %aPosition %vUV %aUV %vIndex %aIndex
+               OpSource GLSL 450
+               OpName %main "main"
+               OpName %gl_Position "gl_Position"
+               OpName %aPosition "aPosition"
+               OpName %vUV "vUV"
+               OpName %aUV "aUV"
+               OpName %vIndex "vIndex"
+               OpName %aIndex "aIndex"
+               OpDecorate %gl_Position BuiltIn Position
+               OpDecorate %aPosition Location 0
+               OpDecorate %vUV Location 0
+               OpDecorate %aUV Location 1
+               OpDecorate %vIndex Flat
+               OpDecorate %vIndex Location 1
+               OpDecorate %aIndex Location 3
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+    %v4float = OpTypeVector %float 4
+%_ptr_Output_v4float = OpTypePointer Output %v4float
+%gl_Position = OpVariable %_ptr_Output_v4float Output
+    %v3float = OpTypeVector %float 3
+%_ptr_Input_v3float = OpTypePointer Input %v3float
+  %aPosition = OpVariable %_ptr_Input_v3float Input
+    %float_1 = OpConstant %float 1
+    %v2float = OpTypeVector %float 2
+%_ptr_Output_v2float = OpTypePointer Output %v2float
+        %vUV = OpVariable %_ptr_Output_v2float Output
+%_ptr_Input_v2float = OpTypePointer Input %v2float
+        %aUV = OpVariable %_ptr_Input_v2float Input
+       %uint = OpTypeInt 32 0
+%_ptr_Output_uint = OpTypePointer Output %uint
+     %vIndex = OpVariable %_ptr_Output_uint Output
+%_ptr_Input_uint = OpTypePointer Input %uint
+     %aIndex = OpVariable %_ptr_Input_uint Input
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+         %13 = OpLoad %v3float %aPosition
+         %15 = OpCompositeExtract %float %13 0
+         %16 = OpCompositeExtract %float %13 1
+         %17 = OpCompositeExtract %float %13 2
+         %18 = OpCompositeConstruct %v4float %15 %16 %17 %float_1
+               OpStore %gl_Position %18
+         %24 = OpLoad %v2float %aUV
+               OpStore %vUV %24
+         %30 = OpLoad %uint %aIndex
+               OpStore %vIndex %30
+               OpReturn
+               OpFunctionEnd
@@ -0,0 +1,77 @@
+; SPIR-V
+; Version: 1.0
+; Generator: Khronos Glslang Reference Front End; 10
+; Bound: 50
+; Schema: 0
+               OpCapability Shader
+          %1 = OpExtInstImport "GLSL.std.450"
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %main "main" %vIndex %vUV %FragColor
+               OpExecutionMode %main OriginUpperLeft
+               OpSource GLSL 450
+               OpName %main "main"
+               OpName %UBO "UBO"
+               OpMemberName %UBO 0 "scale"
+               OpMemberName %UBO 1 "offsets"
+               OpName %_ ""
+               OpName %vIndex "vIndex"
+               OpName %vUV "vUV"
+               OpName %FragColor "FragColor"
+               OpDecorate %_arr_v4float_uint_4 ArrayStride 16
+               OpMemberDecorate %UBO 0 Offset 0
+               OpMemberDecorate %UBO 1 Offset 16
+               OpDecorate %UBO Block
+               OpDecorate %_ DescriptorSet 0
+               OpDecorate %_ Binding 0
+               OpDecorate %vIndex Flat
+               OpDecorate %vIndex Location 0
+               OpDecorate %vUV Location 1
+               OpDecorate %FragColor Location 0
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+    %v2float = OpTypeVector %float 2
+    %v4float = OpTypeVector %float 4
+        %int = OpTypeInt 32 1
+       %uint = OpTypeInt 32 0
+     %uint_4 = OpConstant %uint 4
+%_arr_v4float_uint_4 = OpTypeArray %v4float %uint_4
+        %UBO = OpTypeStruct %v4float %_arr_v4float_uint_4
+%_ptr_Uniform_UBO = OpTypePointer Uniform %UBO
+          %_ = OpVariable %_ptr_Uniform_UBO Uniform
+      %int_0 = OpConstant %int 0
+      %int_1 = OpConstant %int 1
+      %int_3 = OpConstant %int 3
+%_ptr_Uniform_v4float = OpTypePointer Uniform %v4float
+%_ptr_Input_int = OpTypePointer Input %int
+     %vIndex = OpVariable %_ptr_Input_int Input
+%_ptr_Input_v2float = OpTypePointer Input %v2float
+        %vUV = OpVariable %_ptr_Input_v2float Input
+%_ptr_Output_v4float = OpTypePointer Output %v4float
+  %FragColor = OpVariable %_ptr_Output_v4float Output
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+         %10 = OpLoad %int %vIndex
+         %11 = OpBitwiseAnd %int %10 %int_3
+         %12 = OpAccessChain %_ptr_Uniform_v4float %_ %int_1 %11
+         %13 = OpLoad %v4float %12
+         %14 = OpLoad %int %vIndex
+         %15 = OpBitwiseAnd %int %14 %int_3
+         %16 = OpAccessChain %_ptr_Uniform_v4float %_ %int_1 %15
+         %17 = OpLoad %v4float %16
+         %18 = OpAccessChain %_ptr_Uniform_v4float %_ %int_0
+         %19 = OpLoad %v4float %18
+         %20 = OpLoad %v2float %vUV
+         %21 = OpVectorShuffle %v4float %20 %20 0 1 0 1
+         %22 = OpFMul %v4float %19 %21
+         %23 = OpFAdd %v4float %22 %13
+         %24 = OpAccessChain %_ptr_Uniform_v4float %_ %int_0
+         %25 = OpLoad %v4float %24
+         %26 = OpLoad %v2float %vUV
+         %27 = OpVectorShuffle %v4float %26 %26 0 1 0 1
+         %28 = OpFMul %v4float %27 %25
+         %29 = OpFAdd %v4float %17 %28
+         %30 = OpFMul %v4float %23 %29
+               OpStore %FragColor %30
+               OpReturn
+               OpFunctionEnd
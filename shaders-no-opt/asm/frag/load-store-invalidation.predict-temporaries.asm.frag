@@ -0,0 +1,60 @@
+; SPIR-V
+; Version: 1.0
+; Generator: Khronos Glslang Reference Front End; 10
+; Bound: 48
+; Schema: 0
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %main "main" %FragColor %vValue
+               OpExecutionMode %main OriginUpperLeft
+               OpSource GLSL 450
+               OpName %main "main"
+               OpName %Counter "Counter"
+               OpMemberName %Counter 0 "count"
+               OpName %counter "counter"
+               OpName %FragColor "FragColor"
+               OpName %vValue "vValue"
+               OpName %value "value"
+               OpMemberDecorate %Counter 0 Offset 0
+               OpDecorate %Counter BufferBlock
+               OpDecorate %counter DescriptorSet 0
+               OpDecorate %counter Binding 0
+               OpDecorate %FragColor Location 0
+               OpDecorate %vValue Location 0
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+    %v4float = OpTypeVector %float 4
+        %int = OpTypeInt 32 1
+      %int_0 = OpConstant %int 0
+      %int_1 = OpConstant %int 1
+    %float_1 = OpConstant %float 1
+    %float_2 = OpConstant %float 2
+    %Counter = OpTypeStruct %int
+%_ptr_Uniform_Counter = OpTypePointer Uniform %Counter
+    %counter = OpVariable %_ptr_Uniform_Counter Uniform
+%_ptr_Uniform_int = OpTypePointer Uniform %int
+%_ptr_Output_v4float = OpTypePointer Output %v4float
+  %FragColor = OpVariable %_ptr_Output_v4float Output
+%_ptr_Input_float = OpTypePointer Input %float
+     %vValue = OpVariable %_ptr_Input_float Input
+%_ptr_Function_float = OpTypePointer Function %float
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+      %value = OpVariable %_ptr_Function_float Function
+         %10 = OpLoad %float %vValue
+               OpStore %value %10
+         %11 = OpLoad %float %value
+               OpStore %value %float_2
+         %12 = OpFAdd %float %11 %float_1
+         %13 = OpAccessChain %_ptr_Uniform_int %counter %int_0
+         %14 = OpLoad %int %13
+         %15 = OpIAdd %int %14 %int_1
+               OpStore %13 %15
+         %16 = OpConvertSToF %float %14
+         %17 = OpLoad %float %value
+         %18 = OpFMul %float %12 %17
+         %19 = OpCompositeConstruct %v4float %18 %16 %float_1 %float_1
+               OpStore %FragColor %19
+               OpReturn
+               OpFunctionEnd
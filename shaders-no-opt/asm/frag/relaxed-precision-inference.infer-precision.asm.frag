@@ -0,0 +1,68 @@
+; SPIR-V
+; Version: 1.0
+; Generator: Khronos; 0
+; Bound: 48
+; Schema: 0
+               OpCapability Shader
+          %1 = OpExtInstImport "GLSL.std.450"
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %main "main" %vUV %vColor %FragColor %FragScaled
+               OpExecutionMode %main OriginUpperLeft
+               OpSource ESSL 310
+               OpName %main "main"
+               OpName %vUV "vUV"
+               OpName %vColor "vColor"
+               OpName %FragColor "FragColor"
+               OpName %FragScaled "FragScaled"
+               OpName %uTex "uTex"
+               OpName %tinted "tinted"
+               OpName %texel "texel"
+               OpName %shaded "shaded"
+               OpName %scale "scale"
+               OpName %lit "lit"
+               OpDecorate %vUV Location 0
+               OpDecorate %vColor Location 1
+               OpDecorate %FragColor Location 0
+               OpDecorate %FragScaled Location 1
+               OpDecorate %uTex DescriptorSet 0
+               OpDecorate %uTex Binding 0
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+    %v2float = OpTypeVector %float 2
+    %v4float = OpTypeVector %float 4
+%_ptr_Input_v2float = OpTypePointer Input %v2float
+%_ptr_Input_v4float = OpTypePointer Input %v4float
+%_ptr_Output_v4float = OpTypePointer Output %v4float
+%_ptr_Function_v4float = OpTypePointer Function %v4float
+         %10 = OpTypeImage %float 2D 0 0 0 1 Unknown
+         %11 = OpTypeSampledImage %10
+%_ptr_UniformConstant_11 = OpTypePointer UniformConstant %11
+        %vUV = OpVariable %_ptr_Input_v2float Input
+     %vColor = OpVariable %_ptr_Input_v4float Input
+  %FragColor = OpVariable %_ptr_Output_v4float Output
+ %FragScaled = OpVariable %_ptr_Output_v4float Output
+       %uTex = OpVariable %_ptr_UniformConstant_11 UniformConstant
+  %float_0_5 = OpConstant %float 0.5
+%float_100000 = OpConstant %float 100000
+    %float_1 = OpConstant %float 1
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+     %tinted = OpVariable %_ptr_Function_v4float Function
+         %20 = OpLoad %11 %uTex
+         %21 = OpLoad %v2float %vUV
+      %texel = OpImageSampleImplicitLod %v4float %20 %21
+         %23 = OpLoad %v4float %vColor
+         %24 = OpFMul %v4float %texel %23
+               OpStore %tinted %24
+         %25 = OpLoad %v4float %tinted
+     %shaded = OpVectorTimesScalar %v4float %25 %float_0_5
+         %27 = OpCompositeExtract %float %21 0
+      %scale = OpFMul %float %27 %float_100000
+         %29 = OpExtInst %float %1 FMin %scale %float_1
+        %lit = OpExtInst %v4float %1 Normalize %shaded
+               OpStore %FragColor %lit
+         %31 = OpVectorTimesScalar %v4float %shaded %29
+               OpStore %FragScaled %31
+               OpReturn
+               OpFunctionEnd
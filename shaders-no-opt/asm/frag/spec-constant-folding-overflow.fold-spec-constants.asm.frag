@@ -0,0 +1,52 @@
+; SPIR-V
+; Version: 1.0
+; Generator: Khronos Glslang Reference Front End; 10
+; Bound: 40
+; Schema: 0
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %main "main" %FragColor
+               OpExecutionMode %main OriginUpperLeft
+               OpSource GLSL 450
+               OpName %main "main"
+               OpName %FragColor "FragColor"
+               OpName %One "One"
+               OpName %Two "Two"
+               OpName %IntMin "IntMin"
+               OpName %MinusOne "MinusOne"
+               OpName %Quotient "Quotient"
+               OpName %Modulo "Modulo"
+               OpName %ShiftCount "ShiftCount"
+               OpName %Shifted "Shifted"
+               OpName %Folded "Folded"
+               OpDecorate %FragColor Location 0
+               OpDecorate %One SpecId 0
+               OpDecorate %Two SpecId 1
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+    %v4float = OpTypeVector %float 4
+%_ptr_Output_v4float = OpTypePointer Output %v4float
+  %FragColor = OpVariable %_ptr_Output_v4float Output
+        %int = OpTypeInt 32 1
+        %One = OpSpecConstant %int 1
+        %Two = OpSpecConstant %int 2
+     %int_30 = OpConstant %int 30
+     %int_31 = OpConstant %int 31
+     %IntMin = OpSpecConstantOp %int ShiftLeftLogical %One %int_31
+   %MinusOne = OpSpecConstantOp %int SNegate %One
+   %Quotient = OpSpecConstantOp %int SDiv %IntMin %MinusOne
+     %Modulo = OpSpecConstantOp %int SMod %IntMin %MinusOne
+ %ShiftCount = OpSpecConstantOp %int IAdd %Two %int_30
+    %Shifted = OpSpecConstantOp %int ShiftLeftLogical %One %ShiftCount
+     %Folded = OpSpecConstantOp %int ShiftLeftLogical %One %int_30
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+         %10 = OpConvertSToF %float %Quotient
+         %12 = OpConvertSToF %float %Modulo
+         %13 = OpConvertSToF %float %Shifted
+         %14 = OpConvertSToF %float %Folded
+         %15 = OpCompositeConstruct %v4float %10 %12 %13 %14
+               OpStore %FragColor %15
+               OpReturn
+               OpFunctionEnd
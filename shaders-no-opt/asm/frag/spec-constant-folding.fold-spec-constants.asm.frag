@@ -0,0 +1,111 @@
+; SPIR-V
+; Version: 1.0
+; Generator: Khronos Glslang Reference Front End; 10
+; Bound: 60
+; Schema: 0
+               OpCapability Shader
+          %1 = OpExtInstImport "GLSL.std.450"
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %main "main" %FragColor %vIndex
+               OpExecutionMode %main OriginUpperLeft
+               OpSource GLSL 450
+               OpName %main "main"
+               OpName %FragColor "FragColor"
+               OpName %vIndex "vIndex"
+               OpName %UseFog "UseFog"
+               OpName %Mode "Mode"
+               OpName %Unfolded "Unfolded"
+               OpName %ModePlusThree "ModePlusThree"
+               OpName %UnfoldedPlusOne "UnfoldedPlusOne"
+               OpName %NotFog "NotFog"
+               OpName %UnfoldedLarge "UnfoldedLarge"
+               OpDecorate %FragColor Location 0
+               OpDecorate %vIndex Flat
+               OpDecorate %vIndex Location 0
+               OpDecorate %UseFog SpecId 0
+               OpDecorate %Mode SpecId 1
+               OpDecorate %Unfolded SpecId 2
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+    %v4float = OpTypeVector %float 4
+%_ptr_Output_v4float = OpTypePointer Output %v4float
+  %FragColor = OpVariable %_ptr_Output_v4float Output
+        %int = OpTypeInt 32 1
+%_ptr_Input_int = OpTypePointer Input %int
+     %vIndex = OpVariable %_ptr_Input_int Input
+       %bool = OpTypeBool
+     %UseFog = OpSpecConstantFalse %bool
+       %Mode = OpSpecConstant %int 0
+   %Unfolded = OpSpecConstant %int 4
+      %int_1 = OpConstant %int 1
+      %int_3 = OpConstant %int 3
+%ModePlusThree = OpSpecConstantOp %int IAdd %Mode %int_3
+%UnfoldedPlusOne = OpSpecConstantOp %int IAdd %Unfolded %int_1
+     %NotFog = OpSpecConstantOp %bool LogicalNot %UseFog
+%UnfoldedLarge = OpSpecConstantOp %bool SGreaterThan %Unfolded %int_3
+    %float_0 = OpConstant %float 0
+    %float_1 = OpConstant %float 1
+  %float_0_5 = OpConstant %float 0.5
+    %float_2 = OpConstant %float 2
+         %v0 = OpConstantComposite %v4float %float_0 %float_0 %float_0 %float_0
+         %v1 = OpConstantComposite %v4float %float_1 %float_1 %float_1 %float_1
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+               OpStore %FragColor %v0
+               OpSelectionMerge %fog_merge None
+               OpBranchConditional %UseFog %fog_true %fog_false
+   %fog_true = OpLabel
+               OpStore %FragColor %v1
+               OpBranch %fog_merge
+  %fog_false = OpLabel
+         %20 = OpLoad %v4float %FragColor
+         %21 = OpVectorTimesScalar %v4float %20 %float_0_5
+               OpStore %FragColor %21
+               OpBranch %fog_merge
+  %fog_merge = OpLabel
+               OpSelectionMerge %switch_merge None
+               OpSwitch %Mode %default 1 %case1 2 %case2
+      %case1 = OpLabel
+         %30 = OpConvertSToF %float %ModePlusThree
+         %31 = OpCompositeConstruct %v4float %30 %30 %30 %30
+               OpStore %FragColor %31
+               OpBranch %switch_merge
+      %case2 = OpLabel
+         %32 = OpLoad %int %vIndex
+         %33 = OpIEqual %bool %32 %int_1
+               OpSelectionMerge %case2_merge None
+               OpBranchConditional %33 %case2_early %case2_merge
+%case2_early = OpLabel
+               OpBranch %switch_merge
+%case2_merge = OpLabel
+         %34 = OpConvertSToF %float %ModePlusThree
+         %35 = OpLoad %v4float %FragColor
+         %36 = OpVectorTimesScalar %v4float %35 %34
+               OpStore %FragColor %36
+               OpBranch %switch_merge
+    %default = OpLabel
+               OpStore %FragColor %v1
+               OpBranch %switch_merge
+%switch_merge = OpLabel
+               OpSelectionMerge %fog2_merge None
+               OpBranchConditional %NotFog %fog2_true %fog2_merge
+  %fog2_true = OpLabel
+               OpStore %FragColor %v0
+               OpBranch %fog2_merge
+ %fog2_merge = OpLabel
+               OpSelectionMerge %unfolded_merge None
+               OpBranchConditional %UnfoldedLarge %unfolded_true %unfolded_merge
+%unfolded_true = OpLabel
+         %39 = OpLoad %v4float %FragColor
+         %40 = OpVectorTimesScalar %v4float %39 %float_2
+               OpStore %FragColor %40
+               OpBranch %unfolded_merge
+%unfolded_merge = OpLabel
+         %41 = OpConvertSToF %float %UnfoldedPlusOne
+         %42 = OpLoad %v4float %FragColor
+         %43 = OpCompositeConstruct %v4float %41 %41 %41 %41
+         %44 = OpFAdd %v4float %42 %43
+               OpStore %FragColor %44
+               OpReturn
+               OpFunctionEnd
@@ -0,0 +1,95 @@
+; SPIR-V
+; Version: 1.0
+; Generator: Khronos Glslang Reference Front End; 10
+; Bound: 80
+; Schema: 0
+               OpCapability Shader
+          %1 = OpExtInstImport "GLSL.std.450"
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %main "main" %FragColor
+               OpExecutionMode %main OriginUpperLeft
+               OpSource GLSL 450
+               OpName %main "main"
+               OpName %FragColor "FragColor"
+               OpName %UBO "UBO"
+               OpMemberName %UBO 0 "a"
+               OpMemberName %UBO 1 "b"
+               OpMemberName %UBO 2 "c"
+               OpMemberName %UBO 3 "d"
+               OpMemberName %UBO 4 "e"
+               OpMemberName %UBO 5 "f"
+               OpMemberName %UBO 6 "g"
+               OpMemberName %UBO 7 "h"
+               OpName %_ ""
+               OpDecorate %FragColor Location 0
+               OpDecorate %_arr_float_uint_2 ArrayStride 16
+               OpMemberDecorate %UBO 0 Offset 0
+               OpMemberDecorate %UBO 1 Offset 16
+               OpMemberDecorate %UBO 2 Offset 32
+               OpMemberDecorate %UBO 3 Offset 48
+               OpMemberDecorate %UBO 4 Offset 64
+               OpMemberDecorate %UBO 5 Offset 80
+               OpMemberDecorate %UBO 6 ColMajor
+               OpMemberDecorate %UBO 6 Offset 112
+               OpMemberDecorate %UBO 6 MatrixStride 16
+               OpMemberDecorate %UBO 7 Offset 144
+               OpDecorate %UBO Block
+               OpDecorate %_ DescriptorSet 0
+               OpDecorate %_ Binding 0
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+    %v4float = OpTypeVector %float 4
+%_ptr_Output_v4float = OpTypePointer Output %v4float
+  %FragColor = OpVariable %_ptr_Output_v4float Output
+    %v3float = OpTypeVector %float 3
+    %v2float = OpTypeVector %float 2
+       %uint = OpTypeInt 32 0
+     %uint_2 = OpConstant %uint 2
+%_arr_float_uint_2 = OpTypeArray %float %uint_2
+%mat2v2float = OpTypeMatrix %v2float 2
+        %UBO = OpTypeStruct %float %v4float %float %v3float %v2float %_arr_float_uint_2 %mat2v2float %v2float
+%_ptr_Uniform_UBO = OpTypePointer Uniform %UBO
+          %_ = OpVariable %_ptr_Uniform_UBO Uniform
+        %int = OpTypeInt 32 1
+      %int_0 = OpConstant %int 0
+      %int_1 = OpConstant %int 1
+      %int_2 = OpConstant %int 2
+      %int_3 = OpConstant %int 3
+      %int_4 = OpConstant %int 4
+      %int_5 = OpConstant %int 5
+      %int_6 = OpConstant %int 6
+      %int_7 = OpConstant %int 7
+     %uint_0 = OpConstant %uint 0
+     %uint_1 = OpConstant %uint 1
+%_ptr_Uniform_float = OpTypePointer Uniform %float
+%_ptr_Uniform_v4float = OpTypePointer Uniform %v4float
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+         %20 = OpAccessChain %_ptr_Uniform_v4float %_ %int_1
+         %21 = OpLoad %v4float %20
+         %22 = OpAccessChain %_ptr_Uniform_float %_ %int_0
+         %23 = OpLoad %float %22
+         %24 = OpAccessChain %_ptr_Uniform_float %_ %int_2
+         %25 = OpLoad %float %24
+         %26 = OpAccessChain %_ptr_Uniform_float %_ %int_3 %uint_0
+         %27 = OpLoad %float %26
+         %28 = OpAccessChain %_ptr_Uniform_float %_ %int_4 %uint_0
+         %29 = OpLoad %float %28
+         %30 = OpAccessChain %_ptr_Uniform_float %_ %int_5 %int_1
+         %31 = OpLoad %float %30
+         %32 = OpAccessChain %_ptr_Uniform_float %_ %int_6 %int_1 %uint_0
+         %33 = OpLoad %float %32
+         %34 = OpAccessChain %_ptr_Uniform_float %_ %int_7 %uint_1
+         %35 = OpLoad %float %34
+         %40 = OpFAdd %float %23 %25
+         %41 = OpFAdd %float %40 %27
+         %42 = OpFAdd %float %41 %29
+         %43 = OpFAdd %float %42 %31
+         %44 = OpFAdd %float %43 %33
+         %45 = OpFAdd %float %44 %35
+         %46 = OpCompositeConstruct %v4float %45 %45 %45 %45
+         %47 = OpFAdd %v4float %21 %46
+               OpStore %FragColor %47
+               OpReturn
+               OpFunctionEnd
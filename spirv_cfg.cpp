@@ -34,10 +34,72 @@ CFG::CFG(Compiler &compiler_, const SPIRFunction &func_)
     : compiler(compiler_)
     , func(func_)
 {
+	SPIRV_CROSS_TRACE_SCOPE(compiler.trace_callback, TraceEventCFG, func.self);
+
+	// Remap the block IDs of the function to a dense range up front.
+	if (!func.blocks.empty())
+	{
+		uint32_t min_id = func.blocks.front();
+		uint32_t max_id = func.blocks.front();
+		for (auto block : func.blocks)
+		{
+			min_id = min<uint32_t>(min_id, block);
+			max_id = max<uint32_t>(max_id, block);
+		}
+
+		block_id_base = min_id;
+		block_to_index.resize(max_id - min_id + 1);
+		nodes.reserve(func.blocks.size());
+		for (auto block : func.blocks)
+			get_node(block);
+	}
+
 	build_post_order_visit_order();
 	build_immediate_dominators();
 }
 
+CFG::Node &CFG::get_node(uint32_t block)
+{
+	uint32_t index = get_block_index(block);
+	if (index != InvalidIndex)
+		return nodes[index];
+
+	// Only happens for blocks outside the function's own block list, which valid SPIR-V cannot branch to.
+	if (block_to_index.empty())
+	{
+		block_id_base = block;
+		block_to_index.resize(1);
+	}
+	else if (block < block_id_base)
+	{
+		uint32_t shift = block_id_base - block;
+		SmallVector<uint32_t> shifted;
+		shifted.resize(block_to_index.size() + shift);
+		for (size_t i = 0; i < block_to_index.size(); i++)
+			shifted[i + shift] = block_to_index[i];
+		block_to_index = move(shifted);
+		block_id_base = block;
+	}
+	else if (block - block_id_base >= block_to_index.size())
+		block_to_index.resize(block - block_id_base + 1);
+
+	block_to_index[block - block_id_base] = uint32_t(nodes.size()) + 1;
+	nodes.emplace_back();
+	nodes.back().self = block;
+	return nodes.back();
+}
+
+size_t CFG::get_memory_usage() const
+{
+	size_t size = get_heap_size(nodes) + get_heap_size(block_to_index) + get_heap_size(post_order) +
+	              get_heap_size(dominance_frontiers);
+	for (auto &node : nodes)
+		size += get_heap_size(node.preceding_edges) + get_heap_size(node.succeeding_edges);
+	for (auto &frontier : dominance_frontiers)
+		size += get_heap_size(frontier);
+	return size;
+}
+
 uint32_t CFG::find_common_dominator(uint32_t a, uint32_t b) const
 {
 	while (a != b)
@@ -50,28 +112,75 @@ uint32_t CFG::find_common_dominator(uint32_t a, uint32_t b) const
 	return a;
 }
 
+bool CFG::dominates(uint32_t a, uint32_t b) const
+{
+	if (!get_immediate_dominator(a) || !get_immediate_dominator(b))
+		return false;
+
+	// Dominators always have a higher post-order index, so we can stop as soon as we walk past a.
+	uint32_t order = get_visit_order(a);
+	while (b != a && get_visit_order(b) < order)
+		b = get_immediate_dominator(b);
+	return b == a;
+}
+
 void CFG::build_immediate_dominators()
 {
 	// Traverse the post-order in reverse and build up the immediate dominator tree.
-	immediate_dominators.clear();
-	immediate_dominators[func.entry_block] = func.entry_block;
+	// Back edges are not part of the CFG, so every predecessor comes before its successors in reverse post-order.
+	// This means a single pass of the Cooper-Harvey-Kennedy algorithm is enough, no fixpoint iteration is needed.
+	for (auto &node : nodes)
+		node.immediate_dominator = 0;
+	if (!func.entry_block)
+		return;
+	get_node(func.entry_block).immediate_dominator = func.entry_block;
 
 	for (auto i = post_order.size(); i; i--)
 	{
 		uint32_t block = post_order[i - 1];
-		auto &pred = preceding_edges[block];
+		auto &node = nodes[get_block_index(block)];
+		auto &pred = node.preceding_edges;
 		if (pred.empty()) // This is for the entry block, but we've already set up the dominators.
 			continue;
 
 		for (auto &edge : pred)
 		{
-			if (immediate_dominators[block])
+			if (node.immediate_dominator)
 			{
-				assert(immediate_dominators[edge]);
-				immediate_dominators[block] = find_common_dominator(immediate_dominators[block], edge);
+				assert(get_immediate_dominator(edge));
+				node.immediate_dominator = find_common_dominator(node.immediate_dominator, edge);
 			}
 			else
-				immediate_dominators[block] = edge;
+				node.immediate_dominator = edge;
+		}
+	}
+}
+
+void CFG::build_dominance_frontiers() const
+{
+	// Cooper-Harvey-Kennedy: walk up the dominator tree from every predecessor of a join point,
+	// until we reach the join point's immediate dominator.
+	dominance_frontiers.resize(nodes.size());
+	for (auto &node : nodes)
+	{
+		if (node.preceding_edges.size() < 2 || !node.immediate_dominator)
+			continue;
+
+		for (auto pred : node.preceding_edges)
+		{
+			uint32_t runner = pred;
+			while (runner && runner != node.immediate_dominator)
+			{
+				// All predecessors of this node are handled back to back, so checking the last entry avoids duplicates.
+				auto &frontier = dominance_frontiers[get_block_index(runner)];
+				if (frontier.empty() || frontier.back() != node.self)
+					frontier.push_back(node.self);
+
+				uint32_t next = get_immediate_dominator(runner);
+				if (next == runner)
+					break;
+				runner = next;
+			}
 		}
 	}
 }
@@ -80,15 +189,15 @@ bool CFG::is_back_edge(uint32_t to) const
 {
 	// We have a back edge if the visit order is set with the temporary magic value 0.
 	// Crossing edges will have already been recorded with a visit order.
-	auto itr = visit_order.find(to);
-	return itr != end(visit_order) && itr->second.get() == 0;
+	uint32_t index = get_block_index(to);
+	return index != InvalidIndex && nodes[index].visit_order == 0;
 }
 
 bool CFG::has_visited_forward_edge(uint32_t to) const
 {
 	// If > 0, we have visited the edge already, and this is not a back edge branch.
-	auto itr = visit_order.find(to);
-	return itr != end(visit_order) && itr->second.get() > 0;
+	uint32_t index = get_block_index(to);
+	return index != InvalidIndex && nodes[index].visit_order > 0;
 }
 
 bool CFG::post_order_visit(uint32_t block_id)
@@ -101,8 +210,10 @@ bool CFG::post_order_visit(uint32_t block_id)
 	else if (is_back_edge(block_id))
 		return false;
 
+	compiler.check_compile_budget();
+
 	// Block back-edges from recursively revisiting ourselves.
-	visit_order[block_id].get() = 0;
+	get_node(block_id).visit_order = 0;
 
 	auto &block = compiler.get<SPIRBlock>(block_id);
 
@@ -165,14 +276,10 @@ bool CFG::post_order_visit(uint32_t block_id)
 		// all coming from same scope, so be more conservative in this case.
 		// Adding fake branches unconditionally breaks parameter preservation analysis,
 		// which looks at how variables are accessed through the CFG.
-		auto pred_itr = preceding_edges.find(block.next_block);
-		if (pred_itr != end(preceding_edges))
+		auto &pred = get_node(block.next_block).preceding_edges;
+		if (!pred.empty())
 		{
-			auto &pred = pred_itr->second;
-			auto succ_itr = succeeding_edges.find(block_id);
-			size_t num_succeeding_edges = 0;
-			if (succ_itr != end(succeeding_edges))
-				num_succeeding_edges = succ_itr->second.size();
+			size_t num_succeeding_edges = nodes[get_block_index(block_id)].succeeding_edges.size();
 
 			if (block.terminator == SPIRBlock::MultiSelect && num_succeeding_edges == 1)
 			{
@@ -200,7 +307,7 @@ bool CFG::post_order_visit(uint32_t block_id)
 	}
 
 	// Then visit ourselves. Start counting at one, to let 0 be a magic value for testing back vs. crossing edges.
-	visit_order[block_id].get() = ++visit_count;
+	nodes[get_block_index(block_id)].visit_order = int(++visit_count);
 	post_order.push_back(block_id);
 	return true;
 }
@@ -209,7 +316,8 @@ void CFG::build_post_order_visit_order()
 {
 	uint32_t block = func.entry_block;
 	visit_count = 0;
-	visit_order.clear();
+	for (auto &node : nodes)
+		node.visit_order = -1;
 	post_order.clear();
 	post_order_visit(block);
 }
@@ -221,18 +329,17 @@ void CFG::add_branch(uint32_t from, uint32_t to)
 		if (itr == end(l))
 			l.push_back(value);
 	};
-	add_unique(preceding_edges[to], from);
-	add_unique(succeeding_edges[from], to);
+	get_node(from);
+	add_unique(get_node(to).preceding_edges, from);
+	add_unique(nodes[get_block_index(from)].succeeding_edges, to);
 }
 
 uint32_t CFG::find_loop_dominator(uint32_t block_id) const
 {
 	while (block_id != SPIRBlock::NoDominator)
 	{
-		auto itr = preceding_edges.find(block_id);
-		if (itr == end(preceding_edges))
-			return SPIRBlock::NoDominator;
-		if (itr->second.empty())
+		auto &preds = get_preceding_edges(block_id);
+		if (preds.empty())
 			return SPIRBlock::NoDominator;
 
 		uint32_t pred_block_id = SPIRBlock::NoDominator;
@@ -241,7 +348,7 @@ uint32_t CFG::find_loop_dominator(uint32_t block_id) const
 		// If we are a merge block, go directly to the header block.
 		// Only consider a loop dominator if we are branching from inside a block to a loop header.
 		// NOTE: In the CFG we forced an edge from header to merge block always to support variable scopes properly.
-		for (auto &pred : itr->second)
+		for (auto &pred : preds)
 		{
 			auto &pred_block = compiler.get<SPIRBlock>(pred);
 			if (pred_block.merge == SPIRBlock::MergeLoop && pred_block.merge_block == ID(block_id))
@@ -260,7 +367,7 @@ uint32_t CFG::find_loop_dominator(uint32_t block_id) const
 		// No merge block means we can just pick any edge. Loop headers dominate the inner loop, so any path we
 		// take will lead there.
 		if (pred_block_id == SPIRBlock::NoDominator)
-			pred_block_id = itr->second.front();
+			pred_block_id = preds.front();
 
 		block_id = pred_block_id;
 
@@ -281,6 +388,10 @@ bool CFG::node_terminates_control_flow_in_sub_graph(BlockID from, BlockID to) co
 	// Only follow pred edges if they have a 1:1 relationship, or a merge relationship.
 	// If we cannot find a path to "from", we must assume that to is inside control flow in some way.
 
+	// Every step below moves to the immediate dominator, so "from" can only be reached if it dominates "to".
+	if (to != from && !dominates(from, to))
+		return false;
+
 	auto &from_block = compiler.get<SPIRBlock>(from);
 	BlockID ignore_block_id = 0;
 	if (from_block.merge == SPIRBlock::MergeLoop)
@@ -288,12 +399,12 @@ bool CFG::node_terminates_control_flow_in_sub_graph(BlockID from, BlockID to) co
 
 	while (to != from)
 	{
-		auto pred_itr = preceding_edges.find(to);
-		if (pred_itr == end(preceding_edges))
+		auto &preds = get_preceding_edges(to);
+		if (preds.empty())
 			return false;
 
 		DominatorBuilder builder(*this);
-		for (auto &edge : pred_itr->second)
+		for (auto &edge : preds)
 			builder.add_block(edge);
 
 		uint32_t dominator = builder.get_dominator();
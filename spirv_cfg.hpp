@@ -52,42 +52,63 @@ public:
 
 	uint32_t get_immediate_dominator(uint32_t block) const
 	{
-		auto itr = immediate_dominators.find(block);
-		if (itr != std::end(immediate_dominators))
-			return itr->second;
+		uint32_t index = get_block_index(block);
+		if (index != InvalidIndex)
+			return nodes[index].immediate_dominator;
 		else
 			return 0;
 	}
 
 	uint32_t get_visit_order(uint32_t block) const
 	{
-		auto itr = visit_order.find(block);
-		assert(itr != std::end(visit_order));
-		int v = itr->second.get();
+		uint32_t index = get_block_index(block);
+		assert(index != InvalidIndex);
+		int v = nodes[index].visit_order;
 		assert(v > 0);
 		return uint32_t(v);
 	}
 
 	uint32_t find_common_dominator(uint32_t a, uint32_t b) const;
 
+	// Approximate heap memory held by the graph.
+	size_t get_memory_usage() const;
+
+	// Returns true if every path from the entry block to b goes through a.
+	bool dominates(uint32_t a, uint32_t b) const;
+
 	const SmallVector<uint32_t> &get_preceding_edges(uint32_t block) const
 	{
-		auto itr = preceding_edges.find(block);
-		if (itr != std::end(preceding_edges))
-			return itr->second;
+		uint32_t index = get_block_index(block);
+		if (index != InvalidIndex)
+			return nodes[index].preceding_edges;
 		else
 			return empty_vector;
 	}
 
 	const SmallVector<uint32_t> &get_succeeding_edges(uint32_t block) const
 	{
-		auto itr = succeeding_edges.find(block);
-		if (itr != std::end(succeeding_edges))
-			return itr->second;
+		uint32_t index = get_block_index(block);
+		if (index != InvalidIndex)
+			return nodes[index].succeeding_edges;
 		else
 			return empty_vector;
 	}
 
+	// The blocks where the dominance of block ends, i.e. blocks which have a predecessor dominated by block,
+	// but are not strictly dominated by block themselves.
+	// Since back edges are not part of the CFG, loop headers never appear in a dominance frontier.
+	// The frontiers of all blocks are built on the first call, so the first call must not race with other queries.
+	const SmallVector<uint32_t> &get_dominance_frontier(uint32_t block) const
+	{
+		uint32_t index = get_block_index(block);
+		if (index == InvalidIndex)
+			return empty_vector;
+
+		if (dominance_frontiers.empty())
+			build_dominance_frontiers();
+		return dominance_frontiers[index];
+	}
+
 	template <typename Op>
 	void walk_from(std::unordered_set<uint32_t> &seen_blocks, uint32_t block, const Op &op) const
 	{
@@ -102,38 +123,80 @@ public:
 		}
 	}
 
+	// Same as above, but tracks seen blocks densely and does not recurse, which scales to huge functions.
+	template <typename Op>
+	void walk_from(uint32_t block, const Op &op) const
+	{
+		SmallVector<uint8_t> seen(nodes.size());
+		SmallVector<uint32_t> stack;
+		stack.push_back(block);
+
+		while (!stack.empty())
+		{
+			block = stack.back();
+			stack.pop_back();
+
+			uint32_t index = get_block_index(block);
+			if (index == InvalidIndex || seen[index])
+				continue;
+			seen[index] = 1;
+
+			if (op(block))
+			{
+				// Push in reverse so successors are visited in the same order as the recursive walk.
+				auto &succ = nodes[index].succeeding_edges;
+				for (size_t i = succ.size(); i; i--)
+					stack.push_back(succ[i - 1]);
+			}
+		}
+	}
+
 	uint32_t find_loop_dominator(uint32_t block) const;
 
 	bool node_terminates_control_flow_in_sub_graph(BlockID from, BlockID to) const;
 
 private:
-	struct VisitOrder
+	enum : uint32_t
 	{
-		int &get()
-		{
-			return v;
-		}
-
-		const int &get() const
-		{
-			return v;
-		}
+		InvalidIndex = ~0u
+	};
 
-		int v = -1;
+	// All per-block state lives in a dense array, indexed through block_to_index, to avoid hashing in every query.
+	struct Node
+	{
+		SmallVector<uint32_t> preceding_edges;
+		SmallVector<uint32_t> succeeding_edges;
+		uint32_t self = 0;
+		uint32_t immediate_dominator = 0;
+		// -1 means not visited, 0 means currently being visited, otherwise post-order index + 1.
+		int visit_order = -1;
 	};
 
+	uint32_t get_block_index(uint32_t block) const
+	{
+		uint32_t offset = block - block_id_base;
+		if (block < block_id_base || offset >= block_to_index.size())
+			return InvalidIndex;
+		return block_to_index[offset] - 1;
+	}
+
+	Node &get_node(uint32_t block);
+
 	Compiler &compiler;
 	const SPIRFunction &func;
-	std::unordered_map<uint32_t, SmallVector<uint32_t>> preceding_edges;
-	std::unordered_map<uint32_t, SmallVector<uint32_t>> succeeding_edges;
-	std::unordered_map<uint32_t, uint32_t> immediate_dominators;
-	std::unordered_map<uint32_t, VisitOrder> visit_order;
+	SmallVector<Node> nodes;
+	// Maps a block ID minus block_id_base to its index in nodes plus one, or 0 if the block is not part of the CFG.
+	SmallVector<uint32_t> block_to_index;
+	uint32_t block_id_base = 0;
 	SmallVector<uint32_t> post_order;
 	SmallVector<uint32_t> empty_vector;
+	// Indexed like nodes, empty until get_dominance_frontier() is first called.
+	mutable SmallVector<SmallVector<uint32_t>> dominance_frontiers;
 
 	void add_branch(uint32_t from, uint32_t to);
 	void build_post_order_visit_order();
 	void build_immediate_dominators();
+	void build_dominance_frontiers() const;
 	bool post_order_visit(uint32_t block);
 	uint32_t visit_count = 0;
 
@@ -27,6 +27,7 @@
 #include "spirv.hpp"
 #include "spirv_cross_containers.hpp"
 #include "spirv_cross_error_handling.hpp"
+#include <cmath>
 #include <functional>
 
 // A bit crude, but allows projects which embed SPIRV-Cross statically to
@@ -76,8 +77,9 @@ public:
 	{
 		if (bit < 64)
 			return (lower & (1ull << bit)) != 0;
-		else
-			return higher.count(bit) != 0;
+
+		auto *word = find_word(bit >> 6);
+		return word && (word->bits & (1ull << (bit & 63))) != 0;
 	}
 
 	inline void set(uint32_t bit)
@@ -85,15 +87,28 @@ public:
 		if (bit < 64)
 			lower |= 1ull << bit;
 		else
-			higher.insert(bit);
+			ensure_word(bit >> 6).bits |= 1ull << (bit & 63);
 	}
 
 	inline void clear(uint32_t bit)
 	{
 		if (bit < 64)
+		{
 			lower &= ~(1ull << bit);
-		else
-			higher.erase(bit);
+			return;
+		}
+
+		for (size_t i = 0; i < higher.size(); i++)
+		{
+			if (higher[i].index == (bit >> 6))
+			{
+				higher[i].bits &= ~(1ull << (bit & 63));
+				// Never keep empty words around, so comparisons can be done word by word.
+				if (!higher[i].bits)
+					higher.erase(higher.begin() + i);
+				return;
+			}
+		}
 	}
 
 	inline uint64_t get_lower() const
@@ -110,30 +125,64 @@ public:
 	inline void merge_and(const Bitset &other)
 	{
 		lower &= other.lower;
-		std::unordered_set<uint32_t> tmp_set;
-		for (auto &v : higher)
-			if (other.higher.count(v) != 0)
-				tmp_set.insert(v);
-		higher = std::move(tmp_set);
+
+		size_t count = 0;
+		size_t j = 0;
+		for (size_t i = 0; i < higher.size(); i++)
+		{
+			while (j < other.higher.size() && other.higher[j].index < higher[i].index)
+				j++;
+			if (j == other.higher.size())
+				break;
+
+			if (other.higher[j].index == higher[i].index)
+			{
+				uint64_t bits = higher[i].bits & other.higher[j].bits;
+				if (bits)
+					higher[count++] = { higher[i].index, bits };
+			}
+		}
+		higher.resize(count);
 	}
 
 	inline void merge_or(const Bitset &other)
 	{
 		lower |= other.lower;
-		for (auto &v : other.higher)
-			higher.insert(v);
+		if (other.higher.empty())
+			return;
+
+		if (higher.empty())
+		{
+			higher = other.higher;
+			return;
+		}
+
+		SmallVector<Word, 1> merged;
+		merged.reserve(higher.size() + other.higher.size());
+		size_t i = 0, j = 0;
+		while (i < higher.size() || j < other.higher.size())
+		{
+			if (j == other.higher.size() || (i < higher.size() && higher[i].index < other.higher[j].index))
+				merged.push_back(higher[i++]);
+			else if (i == higher.size() || other.higher[j].index < higher[i].index)
+				merged.push_back(other.higher[j++]);
+			else
+			{
+				merged.push_back({ higher[i].index, higher[i].bits | other.higher[j].bits });
+				i++;
+				j++;
+			}
+		}
+		higher = std::move(merged);
 	}
 
 	inline bool operator==(const Bitset &other) const
 	{
-		if (lower != other.lower)
+		if (lower != other.lower || higher.size() != other.higher.size())
 			return false;
 
-		if (higher.size() != other.higher.size())
-			return false;
-
-		for (auto &v : higher)
-			if (other.higher.count(v) == 0)
+		for (size_t i = 0; i < higher.size(); i++)
+			if (higher[i].index != other.higher[i].index || higher[i].bits != other.higher[i].bits)
 				return false;
 
 		return true;
@@ -147,39 +196,77 @@ public:
 	template <typename Op>
 	void for_each_bit(const Op &op) const
 	{
-		// TODO: Add ctz-based iteration.
-		for (uint32_t i = 0; i < 64; i++)
+		// Words are sorted, so bits are visited in increasing order.
+		for_each_bit_in_word(lower, 0, op);
+		for (auto &word : higher)
+			for_each_bit_in_word(word.bits, word.index * 64, op);
+	}
+
+	inline bool empty() const
+	{
+		return lower == 0 && higher.empty();
+	}
+
+private:
+	struct Word
+	{
+		uint32_t index;
+		uint64_t bits;
+	};
+
+	template <typename Op>
+	static void for_each_bit_in_word(uint64_t bits, uint32_t base, const Op &op)
+	{
+		while (bits)
 		{
-			if (lower & (1ull << i))
-				op(i);
+			op(base + trailing_zeroes(bits));
+			bits &= bits - 1;
 		}
+	}
 
-		if (higher.empty())
-			return;
-
-		// Need to enforce an order here for reproducible results,
-		// but hitting this path should happen extremely rarely, so having this slow path is fine.
-		SmallVector<uint32_t> bits;
-		bits.reserve(higher.size());
-		for (auto &v : higher)
-			bits.push_back(v);
-		std::sort(std::begin(bits), std::end(bits));
+	static inline uint32_t trailing_zeroes(uint64_t bits)
+	{
+#if defined(__clang__) || defined(__GNUC__)
+		return uint32_t(__builtin_ctzll(bits));
+#else
+		uint32_t count = 0;
+		while ((bits & 1) == 0)
+		{
+			bits >>= 1;
+			count++;
+		}
+		return count;
+#endif
+	}
 
-		for (auto &v : bits)
-			op(v);
+	inline const Word *find_word(uint32_t index) const
+	{
+		for (auto &word : higher)
+		{
+			if (word.index == index)
+				return &word;
+			if (word.index > index)
+				break;
+		}
+		return nullptr;
 	}
 
-	inline bool empty() const
+	inline Word &ensure_word(uint32_t index)
 	{
-		return lower == 0 && higher.empty();
+		size_t i = 0;
+		while (i < higher.size() && higher[i].index < index)
+			i++;
+
+		if (i == higher.size() || higher[i].index != index)
+			higher.insert(higher.begin() + i, Word{ index, 0 });
+		return higher[i];
 	}
 
-private:
-	// The most common bits to set are all lower than 64,
-	// so optimize for this case. Bits spilling outside 64 go into a slower data structure.
-	// In almost all cases, higher data structure will not be used.
+	// The most common bits to set are all lower than 64, so optimize for this case.
+	// Higher bits, e.g. extension decorations and builtins in the 5000 range, are stored as a sorted list of
+	// non-empty 64-bit words. These tend to cluster, so there are rarely more than a couple of words.
 	uint64_t lower = 0;
-	std::unordered_set<uint32_t> higher;
+	SmallVector<Word, 1> higher;
 };
 
 // Helper template to avoid lots of nasty string temporary munging.
@@ -211,11 +298,6 @@ inline std::string convert_to_string(const T &t)
 	return std::to_string(t);
 }
 
-// Allow implementations to set a convenient standard precision
-#ifndef SPIRV_CROSS_FLT_FMT
-#define SPIRV_CROSS_FLT_FMT "%.32g"
-#endif
-
 // Disable sprintf and strcat warnings.
 // We cannot rely on snprintf and family existing because, ..., MSVC.
 #if defined(__clang__) || defined(__GNUC__)
@@ -226,6 +308,10 @@ inline std::string convert_to_string(const T &t)
 #pragma warning(disable : 4996)
 #endif
 
+// Allow implementations to set a convenient standard precision.
+// This uses printf formatting instead of the shortest representation.
+#ifdef SPIRV_CROSS_FLT_FMT
+
 static inline void fixup_radix_point(char *str, char radix_point)
 {
 	// Setting locales is a very risky business in multi-threaded program,
@@ -268,6 +354,489 @@ inline std::string convert_to_string(double t, char locale_radix_point)
 		strcat(buf, ".0");
 	return buf;
 }
+#else
+namespace inner
+{
+// Just enough of an arbitrary precision unsigned integer to print any double exactly.
+class FloatBignum
+{
+public:
+	explicit FloatBignum(uint64_t value = 0)
+	{
+		limbs[0] = uint32_t(value);
+		limbs[1] = uint32_t(value >> 32);
+		count = limbs[1] ? 2 : (limbs[0] ? 1 : 0);
+	}
+
+	void shift_left(uint32_t bits)
+	{
+		uint32_t words = bits / 32;
+		bits %= 32;
+		if (count == 0)
+			return;
+		if (count + words + 1 > MaxLimbs)
+			SPIRV_CROSS_THROW("Floating point value out of range.");
+
+		limbs[count] = 0;
+		for (uint32_t i = count + 1; i; i--)
+		{
+			uint32_t hi = limbs[i - 1] << bits;
+			uint32_t lo = (bits && i > 1) ? limbs[i - 2] >> (32 - bits) : 0;
+			limbs[i - 1 + words] = hi | lo;
+		}
+		for (uint32_t i = 0; i < words; i++)
+			limbs[i] = 0;
+
+		count += words + 1;
+		trim();
+	}
+
+	void multiply(uint32_t factor)
+	{
+		uint64_t carry = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			carry += uint64_t(limbs[i]) * factor;
+			limbs[i] = uint32_t(carry);
+			carry >>= 32;
+		}
+
+		if (carry)
+		{
+			if (count == MaxLimbs)
+				SPIRV_CROSS_THROW("Floating point value out of range.");
+			limbs[count++] = uint32_t(carry);
+		}
+	}
+
+	void multiply_pow10(uint32_t exponent)
+	{
+		static const uint32_t powers[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+		for (; exponent >= 9; exponent -= 9)
+			multiply(1000000000u);
+		multiply(powers[exponent]);
+	}
+
+	void add(const FloatBignum &other)
+	{
+		uint64_t carry = 0;
+		uint32_t n = count > other.count ? count : other.count;
+		for (uint32_t i = 0; i < n; i++)
+		{
+			carry += uint64_t(i < count ? limbs[i] : 0) + (i < other.count ? other.limbs[i] : 0);
+			limbs[i] = uint32_t(carry);
+			carry >>= 32;
+		}
+		count = n;
+
+		if (carry)
+		{
+			if (count == MaxLimbs)
+				SPIRV_CROSS_THROW("Floating point value out of range.");
+			limbs[count++] = uint32_t(carry);
+		}
+	}
+
+	// Must not underflow.
+	void subtract(const FloatBignum &other)
+	{
+		int64_t borrow = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			borrow += int64_t(limbs[i]) - (i < other.count ? other.limbs[i] : 0);
+			limbs[i] = uint32_t(borrow);
+			borrow = borrow < 0 ? -1 : 0;
+		}
+		trim();
+	}
+
+	friend int compare(const FloatBignum &a, const FloatBignum &b)
+	{
+		if (a.count != b.count)
+			return a.count < b.count ? -1 : 1;
+		for (uint32_t i = a.count; i; i--)
+			if (a.limbs[i - 1] != b.limbs[i - 1])
+				return a.limbs[i - 1] < b.limbs[i - 1] ? -1 : 1;
+		return 0;
+	}
+
+private:
+	// 2^1074 scaled by 10^324 and some digits of headroom.
+	enum
+	{
+		MaxLimbs = 72
+	};
+	uint32_t limbs[MaxLimbs];
+	uint32_t count;
+
+	void trim()
+	{
+		while (count && limbs[count - 1] == 0)
+			count--;
+	}
+};
+
+// Generates the fewest digits of value = mantissa * 2^exponent which still read back as the same value,
+// using the free-format algorithm by Burger and Dybvig. The value is then 0.digits * 10^k.
+// wide_upper_gap is set when mantissa is the smallest normalized mantissa,
+// as the next smaller value is then closer than the next larger one.
+inline uint32_t generate_shortest_digits_exact(char *digits, int &k, double value, uint64_t mantissa, int exponent,
+                                               bool wide_upper_gap)
+{
+	// Ties round to even when reading back, so the boundaries can be used if the mantissa is even.
+	bool even = (mantissa & 1) == 0;
+	uint32_t gap = wide_upper_gap ? 1 : 0;
+
+	// high - low is the rounding interval around value, r / s is value, scaled to be an integer.
+	FloatBignum r(mantissa), s, high, low;
+	if (exponent >= 0)
+	{
+		r.shift_left(uint32_t(exponent) + gap + 1);
+		s = FloatBignum(2u << gap);
+		high = FloatBignum(1);
+		high.shift_left(uint32_t(exponent) + gap);
+		low = FloatBignum(1);
+		low.shift_left(uint32_t(exponent));
+	}
+	else
+	{
+		r.shift_left(gap + 1);
+		s = FloatBignum(1);
+		s.shift_left(uint32_t(-exponent) + gap + 1);
+		high = FloatBignum(1u << gap);
+		low = FloatBignum(1);
+	}
+
+	k = int(std::ceil(std::log10(value) - 1e-10));
+	if (k >= 0)
+		s.multiply_pow10(uint32_t(k));
+	else
+	{
+		r.multiply_pow10(uint32_t(-k));
+		high.multiply_pow10(uint32_t(-k));
+		low.multiply_pow10(uint32_t(-k));
+	}
+
+	FloatBignum upper = r;
+	upper.add(high);
+	int c = compare(upper, s);
+	if (even ? c >= 0 : c > 0)
+	{
+		s.multiply(10);
+		k++;
+	}
+
+	uint32_t num_digits = 0;
+	for (;;)
+	{
+		r.multiply(10);
+		high.multiply(10);
+		low.multiply(10);
+
+		char digit = '0';
+		while (compare(r, s) >= 0)
+		{
+			r.subtract(s);
+			digit++;
+		}
+
+		c = compare(r, low);
+		bool round_down = even ? c <= 0 : c < 0;
+		upper = r;
+		upper.add(high);
+		c = compare(upper, s);
+		bool round_up = even ? c >= 0 : c > 0;
+
+		if (round_down && round_up)
+		{
+			FloatBignum twice = r;
+			twice.multiply(2);
+			if (compare(twice, s) >= 0)
+				digit++;
+		}
+		else if (round_up)
+			digit++;
+
+		digits[num_digits++] = digit;
+		if (round_down || round_up)
+			break;
+	}
+
+	return num_digits;
+}
+
+// Upper 64 bits of the 128-bit product, rounded to nearest.
+inline uint64_t multiply_high_rounded(uint64_t a, uint64_t b)
+{
+	uint64_t a_hi = a >> 32, a_lo = a & 0xffffffffu;
+	uint64_t b_hi = b >> 32, b_lo = b & 0xffffffffu;
+	uint64_t hi_lo = a_hi * b_lo;
+	uint64_t lo_hi = a_lo * b_hi;
+	uint64_t mid = ((a_lo * b_lo) >> 32) + (hi_lo & 0xffffffffu) + (lo_hi & 0xffffffffu) + (1u << 31);
+	return a_hi * b_hi + (hi_lo >> 32) + (lo_hi >> 32) + (mid >> 32);
+}
+
+// Moves the last digit towards the exact value while the candidate stays inside the rounding interval,
+// and returns false if the imprecision of the scaled values makes the result uncertain.
+inline bool round_weed_digits(char *digits, uint32_t num_digits, uint64_t distance_too_high_w, uint64_t unsafe_interval,
+                              uint64_t rest, uint64_t ten_kappa, uint64_t unit)
+{
+	uint64_t small_distance = distance_too_high_w - unit;
+	uint64_t big_distance = distance_too_high_w + unit;
+
+	while (rest < small_distance && unsafe_interval - rest >= ten_kappa &&
+	       (rest + ten_kappa < small_distance || small_distance - rest >= rest + ten_kappa - small_distance))
+	{
+		digits[num_digits - 1]--;
+		rest += ten_kappa;
+	}
+
+	if (rest < big_distance && unsafe_interval - rest >= ten_kappa &&
+	    (rest + ten_kappa < big_distance || big_distance - rest > rest + ten_kappa - big_distance))
+	{
+		return false;
+	}
+
+	return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+}
+
+// Same digits as generate_shortest_digits_exact(), computed with 64-bit arithmetic using the Grisu3 algorithm
+// by Florian Loitsch. Returns 0 for the few values where the result cannot be guaranteed to be the shortest
+// and closest one.
+inline uint32_t generate_shortest_digits_fast(char *digits, int &k, uint64_t mantissa, int exponent,
+                                              bool wide_upper_gap)
+{
+	// Normalized 10^decimal_exponent = significand * 2^binary_exponent, for every 8th decimal exponent.
+	struct CachedPower
+	{
+		uint64_t significand;
+		int16_t binary_exponent;
+		int16_t decimal_exponent;
+	};
+	static const CachedPower cached_powers[] = {
+		{ 0xfa8fd5a0081c0288ull, -1220, -348 }, { 0xbaaee17fa23ebf76ull, -1193, -340 },
+		{ 0x8b16fb203055ac76ull, -1166, -332 }, { 0xcf42894a5dce35eaull, -1140, -324 },
+		{ 0x9a6bb0aa55653b2dull, -1113, -316 }, { 0xe61acf033d1a45dfull, -1087, -308 },
+		{ 0xab70fe17c79ac6caull, -1060, -300 }, { 0xff77b1fcbebcdc4full, -1034, -292 },
+		{ 0xbe5691ef416bd60cull, -1007, -284 }, { 0x8dd01fad907ffc3cull, -980, -276 },
+		{ 0xd3515c2831559a83ull, -954, -268 }, { 0x9d71ac8fada6c9b5ull, -927, -260 },
+		{ 0xea9c227723ee8bcbull, -901, -252 }, { 0xaecc49914078536dull, -874, -244 },
+		{ 0x823c12795db6ce57ull, -847, -236 }, { 0xc21094364dfb5637ull, -821, -228 },
+		{ 0x9096ea6f3848984full, -794, -220 }, { 0xd77485cb25823ac7ull, -768, -212 },
+		{ 0xa086cfcd97bf97f4ull, -741, -204 }, { 0xef340a98172aace5ull, -715, -196 },
+		{ 0xb23867fb2a35b28eull, -688, -188 }, { 0x84c8d4dfd2c63f3bull, -661, -180 },
+		{ 0xc5dd44271ad3cdbaull, -635, -172 }, { 0x936b9fcebb25c996ull, -608, -164 },
+		{ 0xdbac6c247d62a584ull, -582, -156 }, { 0xa3ab66580d5fdaf6ull, -555, -148 },
+		{ 0xf3e2f893dec3f126ull, -529, -140 }, { 0xb5b5ada8aaff80b8ull, -502, -132 },
+		{ 0x87625f056c7c4a8bull, -475, -124 }, { 0xc9bcff6034c13053ull, -449, -116 },
+		{ 0x964e858c91ba2655ull, -422, -108 }, { 0xdff9772470297ebdull, -396, -100 },
+		{ 0xa6dfbd9fb8e5b88full, -369, -92 }, { 0xf8a95fcf88747d94ull, -343, -84 },
+		{ 0xb94470938fa89bcfull, -316, -76 }, { 0x8a08f0f8bf0f156bull, -289, -68 },
+		{ 0xcdb02555653131b6ull, -263, -60 }, { 0x993fe2c6d07b7facull, -236, -52 },
+		{ 0xe45c10c42a2b3b06ull, -210, -44 }, { 0xaa242499697392d3ull, -183, -36 },
+		{ 0xfd87b5f28300ca0eull, -157, -28 }, { 0xbce5086492111aebull, -130, -20 },
+		{ 0x8cbccc096f5088ccull, -103, -12 }, { 0xd1b71758e219652cull, -77, -4 },
+		{ 0x9c40000000000000ull, -50, 4 }, { 0xe8d4a51000000000ull, -24, 12 },
+		{ 0xad78ebc5ac620000ull, 3, 20 }, { 0x813f3978f8940984ull, 30, 28 },
+		{ 0xc097ce7bc90715b3ull, 56, 36 }, { 0x8f7e32ce7bea5c70ull, 83, 44 },
+		{ 0xd5d238a4abe98068ull, 109, 52 }, { 0x9f4f2726179a2245ull, 136, 60 },
+		{ 0xed63a231d4c4fb27ull, 162, 68 }, { 0xb0de65388cc8ada8ull, 189, 76 },
+		{ 0x83c7088e1aab65dbull, 216, 84 }, { 0xc45d1df942711d9aull, 242, 92 },
+		{ 0x924d692ca61be758ull, 269, 100 }, { 0xda01ee641a708deaull, 295, 108 },
+		{ 0xa26da3999aef774aull, 322, 116 }, { 0xf209787bb47d6b85ull, 348, 124 },
+		{ 0xb454e4a179dd1877ull, 375, 132 }, { 0x865b86925b9bc5c2ull, 402, 140 },
+		{ 0xc83553c5c8965d3dull, 428, 148 }, { 0x952ab45cfa97a0b3ull, 455, 156 },
+		{ 0xde469fbd99a05fe3ull, 481, 164 }, { 0xa59bc234db398c25ull, 508, 172 },
+		{ 0xf6c69a72a3989f5cull, 534, 180 }, { 0xb7dcbf5354e9beceull, 561, 188 },
+		{ 0x88fcf317f22241e2ull, 588, 196 }, { 0xcc20ce9bd35c78a5ull, 614, 204 },
+		{ 0x98165af37b2153dfull, 641, 212 }, { 0xe2a0b5dc971f303aull, 667, 220 },
+		{ 0xa8d9d1535ce3b396ull, 694, 228 }, { 0xfb9b7cd9a4a7443cull, 720, 236 },
+		{ 0xbb764c4ca7a44410ull, 747, 244 }, { 0x8bab8eefb6409c1aull, 774, 252 },
+		{ 0xd01fef10a657842cull, 800, 260 }, { 0x9b10a4e5e9913129ull, 827, 268 },
+		{ 0xe7109bfba19c0c9dull, 853, 276 }, { 0xac2820d9623bf429ull, 880, 284 },
+		{ 0x80444b5e7aa7cf85ull, 907, 292 }, { 0xbf21e44003acdd2dull, 933, 300 },
+		{ 0x8e679c2f5e44ff8full, 960, 308 }, { 0xd433179d9c8cb841ull, 986, 316 },
+		{ 0x9e19db92b4e31ba9ull, 1013, 324 }, { 0xeb96bf6ebadf77d9ull, 1039, 332 },
+		{ 0xaf87023b9bf0ee6bull, 1066, 340 }
+	};
+
+	// The upper boundary has the most significant bits, normalize the others to the same exponent.
+	uint64_t w = mantissa;
+	int w_exponent = exponent;
+	while (!(w >> 52))
+	{
+		w <<= 11;
+		w_exponent -= 11;
+	}
+	while (!(w >> 63))
+	{
+		w <<= 1;
+		w_exponent--;
+	}
+	uint32_t shift = uint32_t(exponent - w_exponent);
+	uint64_t boundary_plus = ((mantissa << 1) + 1) << (shift - 1);
+	uint64_t boundary_minus =
+	    wide_upper_gap ? ((mantissa << 2) - 1) << (shift - 2) : ((mantissa << 1) - 1) << (shift - 1);
+
+	// Scale by a cached power of ten so that the binary exponent ends up in [-60, -32].
+	int min_decimal_exponent = int(std::ceil((-60 - (w_exponent + 64) + 63) * 0.30102999566398114));
+	const CachedPower &power = cached_powers[(348 + min_decimal_exponent - 1) / 8 + 1];
+	int one_shift = -(w_exponent + power.binary_exponent + 64);
+	uint64_t one = uint64_t(1) << one_shift;
+
+	uint64_t scaled_w = multiply_high_rounded(w, power.significand);
+	uint64_t too_low = multiply_high_rounded(boundary_minus, power.significand) - 1;
+	uint64_t too_high = multiply_high_rounded(boundary_plus, power.significand) + 1;
+	uint64_t unsafe_interval = too_high - too_low;
+	uint64_t unit = 1;
+
+	uint32_t integrals = uint32_t(too_high >> one_shift);
+	uint64_t fractionals = too_high & (one - 1);
+	uint32_t divisor = 1;
+	int kappa = 1;
+	while (kappa < 10 && uint64_t(divisor) * 10 <= integrals)
+	{
+		divisor *= 10;
+		kappa++;
+	}
+
+	uint32_t num_digits = 0;
+	while (kappa > 0)
+	{
+		digits[num_digits++] = char('0' + integrals / divisor);
+		integrals %= divisor;
+		kappa--;
+		uint64_t rest = (uint64_t(integrals) << one_shift) + fractionals;
+		if (rest < unsafe_interval)
+		{
+			k = int(num_digits) + kappa - power.decimal_exponent;
+			if (!round_weed_digits(digits, num_digits, too_high - scaled_w, unsafe_interval, rest,
+			                       uint64_t(divisor) << one_shift, unit))
+				return 0;
+			return num_digits;
+		}
+		divisor /= 10;
+	}
+
+	for (;;)
+	{
+		fractionals *= 10;
+		unit *= 10;
+		unsafe_interval *= 10;
+		digits[num_digits++] = char('0' + (fractionals >> one_shift));
+		fractionals &= one - 1;
+		kappa--;
+		if (fractionals < unsafe_interval)
+		{
+			k = int(num_digits) + kappa - power.decimal_exponent;
+			if (!round_weed_digits(digits, num_digits, (too_high - scaled_w) * unit, unsafe_interval, fractionals,
+			                       one, unit))
+				return 0;
+			return num_digits;
+		}
+	}
+}
+
+// Prints value = mantissa * 2^exponent with the fewest digits which still read back as the same value.
+// The layout matches printf("%.32g"), and there is no dependency on the current locale.
+inline void format_shortest_float(char *buf, double value, uint64_t mantissa, int exponent, bool wide_upper_gap)
+{
+	char digits[32];
+	int k = 0;
+	uint32_t num_digits = generate_shortest_digits_fast(digits, k, mantissa, exponent, wide_upper_gap);
+	if (!num_digits)
+		num_digits = generate_shortest_digits_exact(digits, k, value, mantissa, exponent, wide_upper_gap);
+
+	int decimal_exponent = k - 1;
+	if (decimal_exponent < -4 || decimal_exponent >= 32)
+	{
+		*buf++ = digits[0];
+		if (num_digits > 1)
+		{
+			*buf++ = '.';
+			for (uint32_t i = 1; i < num_digits; i++)
+				*buf++ = digits[i];
+		}
+		sprintf(buf, "e%c%02d", decimal_exponent < 0 ? '-' : '+', decimal_exponent < 0 ? -decimal_exponent : decimal_exponent);
+	}
+	else if (decimal_exponent >= 0)
+	{
+		for (int i = 0; i < int(num_digits) || i <= decimal_exponent; i++)
+		{
+			if (i == decimal_exponent + 1)
+				*buf++ = '.';
+			*buf++ = i < int(num_digits) ? digits[i] : '0';
+		}
+		*buf = '\0';
+	}
+	else
+	{
+		*buf++ = '0';
+		*buf++ = '.';
+		for (int i = -1; i > decimal_exponent; i--)
+			*buf++ = '0';
+		for (uint32_t i = 0; i < num_digits; i++)
+			*buf++ = digits[i];
+		*buf = '\0';
+	}
+}
+
+template <typename T, typename Bits, int MantissaBits>
+inline std::string convert_to_shortest_string(T t)
+{
+	char buf[64];
+	if (!std::isfinite(t))
+	{
+		// Backends deal with these before getting here, so just print something readable.
+		strcpy(buf, std::isnan(t) ? "nan" : (t < T(0) ? "-inf" : "inf"));
+		return buf;
+	}
+
+	Bits bits;
+	memcpy(&bits, &t, sizeof(bits));
+
+	char *str = buf;
+	if (bits >> (8 * sizeof(Bits) - 1))
+		*str++ = '-';
+
+	const Bits mantissa_mask = (Bits(1) << MantissaBits) - 1;
+	const int exponent_bias = (1 << (8 * int(sizeof(Bits)) - MantissaBits - 2)) - 1;
+	Bits mantissa = bits & mantissa_mask;
+	int biased_exponent = int((bits >> MantissaBits) & ((Bits(1) << (8 * sizeof(Bits) - MantissaBits - 1)) - 1));
+
+	if (mantissa == 0 && biased_exponent == 0)
+		strcpy(str, "0");
+	else if (biased_exponent == 0)
+	{
+		// Denormal.
+		format_shortest_float(str, std::fabs(double(t)), mantissa, 1 - exponent_bias - MantissaBits, false);
+	}
+	else
+	{
+		format_shortest_float(str, std::fabs(double(t)), mantissa | (Bits(1) << MantissaBits),
+		                      biased_exponent - exponent_bias - MantissaBits, mantissa == 0 && biased_exponent > 1);
+	}
+
+	// Ensure that the literal is float.
+	if (!strchr(buf, '.') && !strchr(buf, 'e'))
+		strcat(buf, ".0");
+	return buf;
+}
+} // namespace inner
+
+// Prints the shortest representation which reads back as the same value.
+// The output never depends on the current locale, so the radix point is always '.',
+// the radix point argument is kept for compatibility.
+inline std::string convert_to_string(float t, char)
+{
+	return inner::convert_to_shortest_string<float, uint32_t, 23>(t);
+}
+
+inline std::string convert_to_string(double t, char)
+{
+	return inner::convert_to_shortest_string<double, uint64_t, 52>(t);
+}
+#endif
 
 template <typename T>
 struct ValueSaver
@@ -292,6 +861,63 @@ struct ValueSaver
 	T saved;
 };
 
+// Deduplicates strings and hands out small integer handles for them,
+// so sets of names can be stored, copied and compared as integers.
+// Handles are only meaningful for the interner which created them.
+class StringInterner
+{
+public:
+	enum : uint32_t
+	{
+		InvalidHandle = 0
+	};
+
+	// Returns the handle for str, adding it if it has not been seen before.
+	uint32_t intern(const std::string &str)
+	{
+		auto itr = handles.find(str);
+		if (itr != handles.end())
+			return itr->second;
+
+		uint32_t handle = uint32_t(strings.size()) + 1;
+		auto result = handles.emplace(str, handle);
+		strings.push_back(&result.first->first);
+		return handle;
+	}
+
+	// Returns InvalidHandle if str has never been interned.
+	uint32_t find(const std::string &str) const
+	{
+		auto itr = handles.find(str);
+		return itr != handles.end() ? itr->second : uint32_t(InvalidHandle);
+	}
+
+	const std::string &get(uint32_t handle) const
+	{
+		return *strings[handle - 1];
+	}
+
+	size_t size() const
+	{
+		return strings.size();
+	}
+
+	// Invalidates all handles.
+	void clear()
+	{
+		strings.clear();
+		handles.clear();
+	}
+
+private:
+	std::unordered_map<std::string, uint32_t> handles;
+	// Node based, so pointers to the keys in handles stay valid.
+	SmallVector<const std::string *> strings;
+};
+
+// A set of names interned with a StringInterner.
+using NameCache = std::unordered_set<uint32_t>;
+
 #if defined(__clang__) || defined(__GNUC__)
 #pragma GCC diagnostic pop
 #elif defined(_MSC_VER)
@@ -579,7 +1205,7 @@ struct SPIRType : IVariant
 	TypeID parent_type = 0;
 
 	// Used in backends to avoid emitting members with conflicting names.
-	std::unordered_set<std::string> member_name_cache;
+	NameCache member_name_cache;
 
 	SPIRV_CROSS_DECLARE_CLONE(SPIRType)
 };
@@ -681,7 +1307,12 @@ struct SPIRExpression : IVariant
 	// Whether or not this is an access chain expression.
 	bool access_chain = false;
 
-	// A list of expressions which this expression depends on.
+	// For access chains which select a column of a row-major matrix, the offset of the column subscript
+	// in expression. Lets backends split off the column without scanning the expression for brackets.
+	size_t access_chain_column_offset = std::string::npos;
+
+	// A list of expressions which this expression depends on, directly or indirectly.
+	// Kept sorted and free of duplicates, see Compiler::inherit_expression_dependencies().
 	SmallVector<ID> expression_dependencies;
 
 	// By reading this expression, we implicitly read these expressions as well.
@@ -793,7 +1424,8 @@ struct SPIRBlock : IVariant
 	BlockID false_block = 0;
 	BlockID default_block = 0;
 
-	SmallVector<Instruction> ops;
+	// Shared between copies of the IR, see SharedVector.
+	SharedVector<Instruction> ops;
 
 	struct Phi
 	{
@@ -911,7 +1543,8 @@ struct SPIRFunction : IVariant
 	SmallVector<Parameter> shadow_arguments;
 	SmallVector<VariableID> local_variables;
 	BlockID entry_block = 0;
-	SmallVector<BlockID> blocks;
+	// Shared between copies of the IR, see SharedVector.
+	SharedVector<BlockID> blocks;
 	SmallVector<CombinedImageSamplerParameter> combined_parameters;
 
 	struct EntryLine
@@ -1261,9 +1894,10 @@ struct SPIRConstant : IVariant
 	    : constant_type(constant_type_)
 	    , specialization(specialized)
 	{
-		subconstants.reserve(num_elements);
+		auto &elems = subconstants.get_mutable();
+		elems.reserve(num_elements);
 		for (uint32_t i = 0; i < num_elements; i++)
-			subconstants.push_back(elements[i]);
+			elems.push_back(elements[i]);
 		specialization = specialized;
 	}
 
@@ -1331,8 +1965,8 @@ struct SPIRConstant : IVariant
 	// If true, this is a LUT, and should always be declared in the outer scope.
 	bool is_used_as_lut = false;
 
-	// For composites which are constant arrays, etc.
-	SmallVector<ConstantID> subconstants;
+	// For composites which are constant arrays, etc. Shared between copies of the IR, see SharedVector.
+	SharedVector<ConstantID> subconstants;
 
 	// Non-Vulkan GLSL, HLSL and sometimes MSL emits defines for each specialization constant,
 	// and uses them to initialize the constant. This allows the user
@@ -1346,6 +1980,8 @@ struct SPIRConstant : IVariant
 // Variants have a very specific allocation scheme.
 struct ObjectPoolGroup
 {
+	// Backing storage for the pools. Must be destroyed after the pools.
+	MemoryArena arena;
 	std::unique_ptr<ObjectPoolBase> pools[TypeCount];
 };
 
@@ -1523,6 +2159,8 @@ struct AccessChainMeta
 	bool storage_is_packed = false;
 	bool storage_is_invariant = false;
 	bool flattened_struct = false;
+	// Offset of the subscript of the final step if it selected a matrix column, see SPIRExpression.
+	size_t column_offset = std::string::npos;
 };
 
 enum ExtendedDecorations
@@ -1590,6 +2228,11 @@ enum ExtendedDecorations
 	// results of interpolation can.
 	SPIRVCrossDecorationInterpolantComponentExpr,
 
+	// Apply to a struct type whose member Offsets are not increasing with the member index,
+	// because CompilerGLSL::repack_buffer_block() reordered its layout.
+	// Members of such types are declared in Offset order rather than member index order.
+	SPIRVCrossDecorationMemberDeclarationOrderByOffset,
+
 	SPIRVCrossDecorationCount
 };
 
@@ -1618,17 +2261,73 @@ struct Meta
 		spv::FPRoundingMode fp_rounding_mode = spv::FPRoundingModeMax;
 		bool builtin = false;
 
-		struct Extended
+		// Values for extended decorations are stored out of line,
+		// since the vast majority of IDs never have any extended decorations.
+		class ExtendedValues
 		{
-			Extended()
+		public:
+			ExtendedValues() = default;
+
+			ExtendedValues(const ExtendedValues &other)
+			{
+				*this = other;
+			}
+
+			ExtendedValues &operator=(const ExtendedValues &other)
+			{
+				if (this != &other)
+				{
+					if (other.values)
+					{
+						allocate();
+						memcpy(values.get(), other.values.get(), sizeof(uint32_t) * SPIRVCrossDecorationCount);
+					}
+					else
+						values.reset();
+				}
+				return *this;
+			}
+
+			// MSVC 2013 cannot default these.
+			ExtendedValues(ExtendedValues &&other) SPIRV_CROSS_NOEXCEPT : values(std::move(other.values))
 			{
-				// MSVC 2013 workaround to init like this.
-				for (auto &v : values)
-					v = 0;
 			}
 
+			ExtendedValues &operator=(ExtendedValues &&other) SPIRV_CROSS_NOEXCEPT
+			{
+				values = std::move(other.values);
+				return *this;
+			}
+
+			uint32_t operator[](uint32_t index) const
+			{
+				return values ? values[index] : 0;
+			}
+
+			uint32_t &operator[](uint32_t index)
+			{
+				allocate();
+				return values[index];
+			}
+
+		private:
+			void allocate()
+			{
+				if (!values)
+				{
+					values.reset(new uint32_t[SPIRVCrossDecorationCount]);
+					for (uint32_t i = 0; i < SPIRVCrossDecorationCount; i++)
+						values[i] = 0;
+				}
+			}
+
+			std::unique_ptr<uint32_t[]> values;
+		};
+
+		struct Extended
+		{
 			Bitset flags;
-			uint32_t values[SPIRVCrossDecorationCount];
+			ExtendedValues values;
 		} extended;
 	};
 
@@ -1651,6 +2350,93 @@ struct Meta
 using VariableTypeRemapCallback =
     std::function<void(const SPIRType &type, const std::string &var_name, std::string &name_of_type)>;
 
+// Phases reported to a TraceCallback.
+enum TraceEvent
+{
+	// Parser::parse().
+	TraceEventParse,
+	// Compiler::build_function_control_flow_graphs_and_analyze().
+	TraceEventAnalyze,
+	// Construction of a CFG, id is the function.
+	TraceEventCFG,
+	// Emission of all global declarations.
+	TraceEventEmitResources,
+	// Emission of a function, id is the function.
+	TraceEventEmitFunction,
+	// One emission pass, id is the index of the pass.
+	TraceEventCompilePass,
+	// Instant event, id is the RecompileReason. Only reported with begin set to true.
+	TraceEventForceRecompile
+};
+
+// Why an emission pass had to be redone, see Compiler::get_recompile_reason_count().
+enum RecompileReason
+{
+	RecompileReasonGeneric,
+	// An expression was read after it was invalidated, so it has to become a temporary.
+	RecompileReasonInvalidatedExpression,
+	// An expression was read multiple times, or needs to be invariant, so it has to become a temporary.
+	RecompileReasonForcedTemporary,
+	// A temporary needs to be declared in an outer scope, e.g. before a loop.
+	RecompileReasonHoistedTemporary,
+	// A helper function or type has to be emitted ahead of its first use.
+	RecompileReasonHelperFunction,
+	// An extension or pragma needs to be enabled ahead of its first use.
+	RecompileReasonExtension,
+	// A decoration had to be changed, e.g. access qualifiers of storage images.
+	RecompileReasonDecoration,
+	// A control flow construct could not be emitted as expected and needs a more general fallback.
+	RecompileReasonControlFlow,
+	// A builtin was used which was not found during analysis.
+	RecompileReasonBuiltin,
+	RecompileReasonCount
+};
+
+// Called when entering and leaving a traced phase.
+// Tracing is only compiled in with SPIRV_CROSS_ENABLE_TRACING, otherwise the callback is never called.
+using TraceCallback = std::function<void(TraceEvent event, bool begin, uint32_t id)>;
+
+class TraceScope
+{
+public:
+	TraceScope(const TraceCallback &callback_, TraceEvent event_, uint32_t id_)
+	    : callback(callback_)
+	    , event(event_)
+	    , id(id_)
+	{
+		if (callback)
+			callback(event, true, id);
+	}
+
+	~TraceScope()
+	{
+		if (callback)
+			callback(event, false, id);
+	}
+
+	TraceScope(const TraceScope &) = delete;
+	void operator=(const TraceScope &) = delete;
+
+private:
+	const TraceCallback &callback;
+	TraceEvent event;
+	uint32_t id;
+};
+
+#ifdef SPIRV_CROSS_ENABLE_TRACING
+#define SPIRV_CROSS_TRACE_SCOPE(callback, event, id) \
+	::SPIRV_CROSS_NAMESPACE::TraceScope spirv_cross_trace_scope(callback, event, id)
+#define SPIRV_CROSS_TRACE_INSTANT(callback, event, id) \
+	do                                                 \
+	{                                                  \
+		if (callback)                                  \
+			callback(event, true, id);                 \
+	} while (false)
+#else
+#define SPIRV_CROSS_TRACE_SCOPE(callback, event, id) ((void)0)
+#define SPIRV_CROSS_TRACE_INSTANT(callback, event, id) ((void)0)
+#endif
+
 class Hasher
 {
 public:
@@ -1659,6 +2445,25 @@ public:
 		h = (h * 0x100000001b3ull) ^ value;
 	}
 
+	inline void u64(uint64_t value)
+	{
+		u32(uint32_t(value));
+		u32(uint32_t(value >> 32));
+	}
+
+	inline void string(const std::string &str)
+	{
+		u32(uint32_t(str.size()));
+		for (auto c : str)
+			u32(uint8_t(c));
+	}
+
+	inline void bitset(const Bitset &bits)
+	{
+		bits.for_each_bit([this](uint32_t bit) { u32(bit); });
+		u32(~0u);
+	}
+
 	inline uint64_t get() const
 	{
 		return h;
@@ -150,6 +150,8 @@ void CompilerCPP::emit_block_struct(SPIRType &type)
 
 void CompilerCPP::emit_resources()
 {
+	SPIRV_CROSS_TRACE_SCOPE(trace_callback, TraceEventEmitResources, 0);
+
 	for (auto &id : ir.ids)
 	{
 		if (id.get_type() == TypeConstant)
@@ -290,6 +292,8 @@ void CompilerCPP::emit_resources()
 	statement("Resources* __res;");
 	if (get_entry_point().model == ExecutionModelGLCompute)
 		statement("ComputePrivateResources __priv_res;");
+	if (batched_execution)
+		statement("uint32_t __resume = 0;");
 	statement("");
 
 	// Emit regular globals which are allocated per invocation.
@@ -313,6 +317,8 @@ void CompilerCPP::emit_resources()
 
 string CompilerCPP::compile()
 {
+	CompileBudgetScope budget_scope(*this);
+	begin_phase_timings();
 	ir.fixup_reserved_names();
 
 	// Do not deal with ES-isms like precision, older extensions and such.
@@ -334,25 +340,48 @@ string CompilerCPP::compile()
 	reorder_type_alias();
 	build_function_control_flow_graphs_and_analyze();
 	update_active_builtins();
+	if (options.predict_temporaries)
+		analyze_multiply_read_expressions();
+	analyze_common_subexpressions();
+	analyze_batched_invocations();
 
-	uint32_t pass_count = 0;
+	begin_emission_timings();
+	compile_pass_count = 0;
 	do
 	{
-		if (pass_count >= 3)
+		if (compile_pass_count >= 3)
 			SPIRV_CROSS_THROW("Over 3 compilation loops detected. Must be a bug!");
 
+		SPIRV_CROSS_TRACE_SCOPE(trace_callback, TraceEventCompilePass, compile_pass_count);
+
 		resource_registrations.clear();
+		batched_members.clear();
+		batched_member_names.clear();
 		reset();
 
 		// Move constructor for this type is broken on GCC 4.9 ...
-		buffer.reset();
+		buffer.clear();
 
 		emit_header();
 		emit_resources();
 
 		emit_function(get<SPIRFunction>(ir.default_entry_point), Bitset());
+		hoisting_batched_members = false;
+
+		for (auto &member : batched_members)
+			statement(member, ";");
+		if (!batched_members.empty())
+			statement("");
+
+		// Blocks can be emitted more than once, make sure every resume point has a label to jump to.
+		if (emitted_resume_points != batched_resume_points)
+		{
+			batched_resume_points = emitted_resume_points;
+			force_recompile();
+		}
 
-		pass_count++;
+		compile_pass_count++;
+		end_pass_timing();
 	} while (is_forcing_recompilation());
 
 	// Match opening scope of emit_header().
@@ -366,7 +395,7 @@ string CompilerCPP::compile()
 	// Entry point in CPP is always main() for the time being.
 	get_entry_point().name = "main";
 
-	return buffer.str();
+	return finish_output();
 }
 
 void CompilerCPP::emit_c_linkage()
@@ -390,12 +419,23 @@ void CompilerCPP::emit_c_linkage()
 	statement("static_cast<", impl_type, "*>(shader)->invoke();");
 	end_scope();
 
+	bool compute = get_entry_point().model == ExecutionModelGLCompute;
+	if (compute)
+	{
+		statement("");
+		statement("void spirv_cross_dispatch(spirv_cross_shader_t *shader, unsigned x, unsigned y, unsigned z)");
+		begin_scope();
+		statement("static_cast<", impl_type, "*>(shader)->dispatch(x, y, z);");
+		end_scope();
+	}
+
 	statement("");
 	statement("static const struct spirv_cross_interface vtable =");
 	begin_scope();
 	statement("spirv_cross_construct,");
 	statement("spirv_cross_destruct,");
 	statement("spirv_cross_invoke,");
+	statement(compute ? "spirv_cross_dispatch," : "nullptr,");
 	end_scope_decl();
 
 	statement("");
@@ -406,6 +446,150 @@ void CompilerCPP::emit_c_linkage()
 	end_scope();
 }
 
+void CompilerCPP::analyze_batched_invocations()
+{
+	batched_execution = false;
+	batched_resume_points = 0;
+	emitted_resume_points = 0;
+	if (!batched_invocations || get_entry_point().model != ExecutionModelGLCompute)
+		return;
+
+	// Only main() itself can be suspended.
+	bool barrier_in_callee = false;
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, SPIRFunction &func) {
+		for (auto block_id : func.blocks)
+		{
+			for (auto &i : get<SPIRBlock>(block_id).ops)
+			{
+				if (static_cast<Op>(i.op) != OpControlBarrier || evaluate_constant_u32(stream(i)[0]) != ScopeWorkgroup)
+					continue;
+
+				if (func.self == ir.default_entry_point)
+					batched_resume_points++;
+				else
+					barrier_in_callee = true;
+			}
+		}
+	});
+
+	if (barrier_in_callee)
+		SPIRV_CROSS_THROW("Batched invocations only support barrier() in the entry point, not in other functions.");
+
+	batched_execution = true;
+
+	// Execution can resume inside a loop body, which must not skip the declaration in a for-loop header.
+	if (batched_resume_points)
+	{
+		for (auto block_id : get<SPIRFunction>(ir.default_entry_point).blocks)
+		{
+			auto &block = get<SPIRBlock>(block_id);
+			for (auto var : block.loop_variables)
+				get<SPIRVariable>(var).loop_variable = false;
+			block.loop_variables.clear();
+		}
+	}
+}
+
+void CompilerCPP::emit_entry_point_declarations()
+{
+	CompilerGLSL::emit_entry_point_declarations();
+
+	emitted_resume_points = 0;
+	if (!batched_resume_points)
+		return;
+
+	// Continue after the barrier() which suspended this invocation the last time.
+	statement("switch (__resume)");
+	begin_scope();
+	for (uint32_t i = 1; i <= batched_resume_points; i++)
+	{
+		statement("case ", i, "u:");
+		indent++;
+		statement("goto __barrier_", i, ";");
+		indent--;
+	}
+	statement("default:");
+	indent++;
+	statement("break;");
+	indent--;
+	end_scope();
+	statement("");
+
+	hoisting_batched_members = true;
+}
+
+void CompilerCPP::emit_batched_barrier()
+{
+	// Other invocations run until they reach the barrier as well, so nothing can be forwarded past it.
+	assert(current_emitting_block);
+	flush_control_dependent_expressions(current_emitting_block->self);
+	flush_all_active_variables();
+
+	uint32_t resume_point = ++emitted_resume_points;
+	statement("__resume = ", resume_point, "u;");
+	statement("return;");
+	statement_no_indent("__barrier_", resume_point, ":");
+	statement("__resume = 0u;");
+}
+
+void CompilerCPP::emit_instruction(const Instruction &instruction)
+{
+	if (batched_resume_points && instruction.op == OpControlBarrier &&
+	    current_function->self == ir.default_entry_point &&
+	    evaluate_constant_u32(stream(instruction)[0]) == ScopeWorkgroup)
+	{
+		emit_batched_barrier();
+	}
+	else
+		CompilerGLSL::emit_instruction(instruction);
+}
+
+void CompilerCPP::emit_hoisted_temporaries(SmallVector<pair<TypeID, ID>> &temporaries)
+{
+	if (!hoisting_batched_members)
+	{
+		CompilerGLSL::emit_hoisted_temporaries(temporaries);
+		return;
+	}
+
+	// Every block starts here, so this is where deferred local variables of main() would be declared next.
+	// They are members instead, so they never need a declaration in the body.
+	for (auto var_id : current_function->local_variables)
+	{
+		auto &var = get<SPIRVariable>(var_id);
+		if (var.deferred_declaration)
+		{
+			hoist_batched_member(get_variable_data_type(var), to_name(var_id), var_id);
+			var.deferred_declaration = false;
+		}
+	}
+
+	// The declarations of hoisted temporaries only name the members now, drop them unless they zero-initialize.
+	if (options.force_zero_initialized_variables)
+		CompilerGLSL::emit_hoisted_temporaries(temporaries);
+	else
+	{
+		SmallVector<string> declarations;
+		auto *old_redirect = redirect_statement;
+		redirect_statement = &declarations;
+		CompilerGLSL::emit_hoisted_temporaries(temporaries);
+		redirect_statement = old_redirect;
+	}
+}
+
+string CompilerCPP::hoist_batched_member(const SPIRType &type, const string &name, uint32_t id)
+{
+	// main() is resumed with goto, which must not jump over any declaration.
+	// Everything main() declares becomes a member of the shader instead, and is only assigned in main().
+	if (batched_member_names.insert(name).second)
+	{
+		hoisting_batched_members = false;
+		batched_members.push_back(variable_decl(type, name, id));
+		hoisting_batched_members = true;
+	}
+	return name;
+}
+
 void CompilerCPP::emit_function_prototype(SPIRFunction &func, const Bitset &)
 {
 	if (func.self != ir.default_entry_point)
@@ -463,8 +647,11 @@ string CompilerCPP::argument_decl(const SPIRFunction::Parameter &arg)
 	return join(constref ? "const " : "", base, " &", variable_name);
 }
 
-string CompilerCPP::variable_decl(const SPIRType &type, const string &name, uint32_t /* id */)
+string CompilerCPP::variable_decl(const SPIRType &type, const string &name, uint32_t id)
 {
+	if (hoisting_batched_members)
+		return hoist_batched_member(type, name, id);
+
 	string base = type_to_glsl(type);
 	remap_variable_type_name(type, name, base);
 	bool runtime = false;
@@ -537,7 +724,8 @@ void CompilerCPP::emit_header()
 		break;
 
 	case ExecutionModelGLCompute:
-		impl_type = join("ComputeShader<Impl::Shader, Impl::Shader::Resources, ", execution.workgroup_size.x, ", ",
+		impl_type = join(batched_execution ? "BatchedComputeShader" : "ComputeShader",
+		                 "<Impl::Shader, Impl::Shader::Resources, ", execution.workgroup_size.x, ", ",
 		                 execution.workgroup_size.y, ", ", execution.workgroup_size.z, ">");
 		resource_type = "ComputeResources";
 		break;
@@ -556,3 +744,27 @@ void CompilerCPP::emit_header()
 		SPIRV_CROSS_THROW("Unsupported execution model.");
 	}
 }
+
+void CompilerCPP::reset_module_state()
+{
+	// The interface name is a naming preference and is kept.
+	resource_registrations.clear();
+	impl_type.clear();
+	resource_type.clear();
+	shared_counter = 0;
+	batched_execution = false;
+	batched_resume_points = 0;
+	emitted_resume_points = 0;
+	hoisting_batched_members = false;
+	batched_members.clear();
+	batched_member_names.clear();
+	CompilerGLSL::reset_module_state();
+}
+
+void CompilerCPP::hash_compile_state(Hasher &hasher) const
+{
+	CompilerGLSL::hash_compile_state(hasher);
+	hasher.string("cpp");
+	hasher.string(interface_name);
+	hasher.u32(batched_invocations);
+}
@@ -25,6 +25,7 @@
 #define SPIRV_CROSS_CPP_HPP
 
 #include "spirv_glsl.hpp"
+#include <unordered_set>
 #include <utility>
 
 namespace SPIRV_CROSS_NAMESPACE
@@ -64,6 +65,18 @@ public:
 		interface_name = std::move(name);
 	}
 
+	// Runs all invocations of a compute workgroup one after the other on the calling thread,
+	// instead of giving every invocation its own std::thread.
+	// barrier() in the entry point suspends main() and resumes it once every other invocation in
+	// the workgroup has reached the barrier as well, so all its locals and temporaries live in the shader struct.
+	// Each invocation still runs its own scalar code: invocations are not packed into SIMD lane arrays,
+	// and divergent control flow is not executed with lane masks.
+	// compile() throws if barrier() is called from any function other than the entry point.
+	void set_batched_invocations(bool enable)
+	{
+		batched_invocations = enable;
+	}
+
 private:
 	void emit_header() override;
 	void emit_c_linkage();
@@ -81,12 +94,30 @@ private:
 
 	std::string argument_decl(const SPIRFunction::Parameter &arg);
 
+	void emit_instruction(const Instruction &instr) override;
+	void emit_entry_point_declarations() override;
+	void emit_hoisted_temporaries(SmallVector<std::pair<TypeID, ID>> &temporaries) override;
+	void analyze_batched_invocations();
+	void emit_batched_barrier();
+	std::string hoist_batched_member(const SPIRType &type, const std::string &name, uint32_t id);
+
 	SmallVector<std::string> resource_registrations;
 	std::string impl_type;
 	std::string resource_type;
 	uint32_t shared_counter = 0;
 
 	std::string interface_name;
+
+	bool batched_invocations = false;
+	bool batched_execution = false;
+	uint32_t batched_resume_points = 0;
+	uint32_t emitted_resume_points = 0;
+	bool hoisting_batched_members = false;
+	SmallVector<std::string> batched_members;
+	std::unordered_set<std::string> batched_member_names;
+
+	void hash_compile_state(Hasher &hasher) const override;
+	void reset_module_state() override;
 };
 } // namespace SPIRV_CROSS_NAMESPACE
 
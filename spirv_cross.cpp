@@ -25,9 +25,12 @@
 #include "GLSL.std.450.h"
 #include "spirv_cfg.hpp"
 #include "spirv_common.hpp"
+#include "spirv_cross_thread_pool.hpp"
 #include "spirv_parser.hpp"
 #include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <exception>
 #include <utility>
 
 using namespace std;
@@ -70,11 +73,97 @@ void Compiler::set_ir(const ParsedIR &ir_)
 	parse_fixup();
 }
 
+void Compiler::rebind_ir(ParsedIR &&ir_)
+{
+	reset_module_state();
+	set_ir(move(ir_));
+}
+
+void Compiler::rebind_ir(const ParsedIR &ir_)
+{
+	reset_module_state();
+	set_ir(ir_);
+}
+
+void Compiler::reset_module_state()
+{
+	// Containers are cleared rather than replaced so they keep their capacity.
+	global_variables.clear();
+	aliased_variables.clear();
+	current_function = nullptr;
+	current_block = nullptr;
+	current_loop_level = 0;
+	active_interface_variables.clear();
+	check_active_interface_variables = false;
+	removed_interface_variables.clear();
+	workgroup_variable_aliases.clear();
+	specialization_constants_folded = false;
+	invalid_expressions.clear();
+	name_interner.clear();
+
+	is_force_recompile = false;
+	compile_pass_count = 0;
+	phase_timings.cfg = 0.0;
+	phase_timings.analysis = 0.0;
+	phase_timings.emission = 0.0;
+	phase_timings.passes.clear();
+	phase_timestamp = 0;
+	for (auto &count : recompile_reason_counts)
+		count = 0;
+
+	scratch_arena.reset();
+	combined_image_samplers.clear();
+	function_summaries.clear();
+	reachable_functions_cache.clear();
+	global_struct_cache.clear();
+
+	forced_temporaries.clear();
+	forwarded_temporaries.clear();
+	suppressed_usage_tracking.clear();
+	hoisted_temporaries.clear();
+	forced_invariant_temporaries.clear();
+
+	active_input_builtins.reset();
+	active_output_builtins.reset();
+	clip_distance_count = 0;
+	cull_distance_count = 0;
+	position_invariant = false;
+
+	comparison_ids.clear();
+	need_subpass_input = false;
+	dummy_sampler_id = 0;
+
+	function_cfgs.clear();
+	function_analysis_hash = 0;
+	function_analysis_valid = false;
+	physical_storage_non_block_pointer_types.clear();
+	interlocked_resources.clear();
+	interlocked_is_complex = false;
+	declared_block_names.clear();
+}
+
 string Compiler::compile()
 {
 	return "";
 }
 
+void Compiler::compile_to_sink(OutputSink &sink)
+{
+	struct SinkScope
+	{
+		~SinkScope()
+		{
+			compiler.output_sink = nullptr;
+		}
+		Compiler &compiler;
+	} scope{ *this };
+
+	output_sink = &sink;
+	auto source = compile();
+	if (!source.empty())
+		sink.write(source.data(), source.size());
+}
+
 bool Compiler::variable_storage_is_aliased(const SPIRVariable &v)
 {
 	auto &type = get<SPIRType>(v.basetype);
@@ -185,6 +274,13 @@ bool Compiler::block_is_pure(const SPIRBlock &block)
 
 string Compiler::to_name(uint32_t id, bool allow_alias) const
 {
+	if (!workgroup_variable_aliases.empty())
+	{
+		auto itr = workgroup_variable_aliases.find(id);
+		if (itr != end(workgroup_variable_aliases))
+			return to_name(itr->second, allow_alias);
+	}
+
 	if (allow_alias && ir.ids[id].get_type() == TypeType)
 	{
 		// If this type is a simple alias, emit the
@@ -210,17 +306,27 @@ string Compiler::to_name(uint32_t id, bool allow_alias) const
 
 bool Compiler::function_is_pure(const SPIRFunction &func)
 {
+	// Called for every call site while emitting code, so remember the result.
+	// block_is_pure() recurses into callees, which makes this a bottom-up pass over the call graph.
+	auto &summary = function_summaries[func.self];
+	if (summary.purity_valid)
+		return summary.pure;
+
+	bool pure = true;
 	for (auto block : func.blocks)
 	{
 		if (!block_is_pure(get<SPIRBlock>(block)))
 		{
 			//fprintf(stderr, "Function %s is impure!\n", to_name(func.self).c_str());
-			return false;
+			pure = false;
+			break;
 		}
 	}
 
 	//fprintf(stderr, "Function %s is pure!\n", to_name(func.self).c_str());
-	return true;
+	summary.pure = pure;
+	summary.purity_valid = true;
+	return pure;
 }
 
 void Compiler::register_global_read_dependencies(const SPIRBlock &block, uint32_t id)
@@ -538,6 +644,9 @@ bool Compiler::is_hidden_variable(const SPIRVariable &var, bool include_builtins
 	if ((is_builtin_variable(var) && !include_builtins) || var.remapped_variable)
 		return true;
 
+	if (removed_interface_variables.count(var.self) || workgroup_variable_aliases.count(var.self))
+		return true;
+
 	// Combined image samplers are always considered active as they are "magic" variables.
 	if (find_if(begin(combined_image_samplers), end(combined_image_samplers), [&var](const CombinedImageSampler &samp) {
 		    return samp.combined_id == var.self;
@@ -810,10 +919,8 @@ bool Compiler::InterfaceVariableAccessHandler::handle(Op opcode, const uint32_t
 
 unordered_set<VariableID> Compiler::get_active_interface_variables() const
 {
-	// Traverse the call graph and find all interface variables which are in use.
-	unordered_set<VariableID> variables;
-	InterfaceVariableAccessHandler handler(*this, variables);
-	traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), handler);
+	// The summary of the entry point covers all interface variables which are in use.
+	unordered_set<VariableID> variables = get_function_summary(ir.default_entry_point).interface_variables;
 
 	ir.for_each_typed_id<SPIRVariable>([&](uint32_t, const SPIRVariable &var) {
 		if (var.storage != StorageClassOutput)
@@ -842,187 +949,1132 @@ void Compiler::set_enabled_interface_variables(std::unordered_set<VariableID> ac
 	check_active_interface_variables = true;
 }
 
-ShaderResources Compiler::get_shader_resources(const unordered_set<VariableID> *active_variables) const
+bool Compiler::opcode_has_side_effects(Op op, const uint32_t *ops, uint32_t length) const
 {
-	ShaderResources res;
+	switch (op)
+	{
+	case OpLoad:
+	case OpAccessChain:
+	case OpInBoundsAccessChain:
+	case OpPtrAccessChain:
+	case OpCopyObject:
+	case OpCopyLogical:
+	case OpCompositeConstruct:
+	case OpCompositeExtract:
+	case OpCompositeInsert:
+	case OpVectorShuffle:
+	case OpVectorExtractDynamic:
+	case OpVectorInsertDynamic:
+	case OpTranspose:
+	case OpSelect:
+	case OpSampledImage:
+	case OpImage:
+	case OpImageSampleImplicitLod:
+	case OpImageSampleExplicitLod:
+	case OpImageSampleDrefImplicitLod:
+	case OpImageSampleDrefExplicitLod:
+	case OpImageSampleProjImplicitLod:
+	case OpImageSampleProjExplicitLod:
+	case OpImageSampleProjDrefImplicitLod:
+	case OpImageSampleProjDrefExplicitLod:
+	case OpImageFetch:
+	case OpImageGather:
+	case OpImageDrefGather:
+	case OpImageQuerySizeLod:
+	case OpImageQuerySize:
+	case OpImageQueryLod:
+	case OpImageQueryLevels:
+	case OpImageQuerySamples:
+	case OpConvertFToU:
+	case OpConvertFToS:
+	case OpConvertSToF:
+	case OpConvertUToF:
+	case OpUConvert:
+	case OpSConvert:
+	case OpFConvert:
+	case OpQuantizeToF16:
+	case OpBitcast:
+	case OpSNegate:
+	case OpFNegate:
+	case OpIAdd:
+	case OpFAdd:
+	case OpISub:
+	case OpFSub:
+	case OpIMul:
+	case OpFMul:
+	case OpUDiv:
+	case OpSDiv:
+	case OpFDiv:
+	case OpUMod:
+	case OpSRem:
+	case OpSMod:
+	case OpFRem:
+	case OpFMod:
+	case OpVectorTimesScalar:
+	case OpMatrixTimesScalar:
+	case OpVectorTimesMatrix:
+	case OpMatrixTimesVector:
+	case OpMatrixTimesMatrix:
+	case OpOuterProduct:
+	case OpDot:
+	case OpAny:
+	case OpAll:
+	case OpIsNan:
+	case OpIsInf:
+	case OpLogicalEqual:
+	case OpLogicalNotEqual:
+	case OpLogicalOr:
+	case OpLogicalAnd:
+	case OpLogicalNot:
+	case OpIEqual:
+	case OpINotEqual:
+	case OpUGreaterThan:
+	case OpSGreaterThan:
+	case OpUGreaterThanEqual:
+	case OpSGreaterThanEqual:
+	case OpULessThan:
+	case OpSLessThan:
+	case OpULessThanEqual:
+	case OpSLessThanEqual:
+	case OpFOrdEqual:
+	case OpFUnordEqual:
+	case OpFOrdNotEqual:
+	case OpFUnordNotEqual:
+	case OpFOrdLessThan:
+	case OpFUnordLessThan:
+	case OpFOrdGreaterThan:
+	case OpFUnordGreaterThan:
+	case OpFOrdLessThanEqual:
+	case OpFUnordLessThanEqual:
+	case OpFOrdGreaterThanEqual:
+	case OpFUnordGreaterThanEqual:
+	case OpShiftRightLogical:
+	case OpShiftRightArithmetic:
+	case OpShiftLeftLogical:
+	case OpBitwiseOr:
+	case OpBitwiseXor:
+	case OpBitwiseAnd:
+	case OpNot:
+	case OpBitFieldInsert:
+	case OpBitFieldSExtract:
+	case OpBitFieldUExtract:
+	case OpBitReverse:
+	case OpBitCount:
+	case OpDPdx:
+	case OpDPdy:
+	case OpFwidth:
+	case OpDPdxFine:
+	case OpDPdyFine:
+	case OpFwidthFine:
+	case OpDPdxCoarse:
+	case OpDPdyCoarse:
+	case OpFwidthCoarse:
+		return false;
 
-	bool ssbo_instance_name = reflection_ssbo_instance_name_is_significant();
+	case OpExtInst:
+	{
+		if (length < 4)
+			return true;
+		auto *ext = maybe_get<SPIRExtension>(ops[2]);
+		if (!ext || ext->ext != SPIRExtension::GLSL)
+			return true;
+		// These write through a pointer.
+		auto glsl_op = static_cast<GLSLstd450>(ops[3]);
+		return glsl_op == GLSLstd450Modf || glsl_op == GLSLstd450Frexp;
+	}
 
-	ir.for_each_typed_id<SPIRVariable>([&](uint32_t, const SPIRVariable &var) {
-		auto &type = this->get<SPIRType>(var.basetype);
+	default:
+		return true;
+	}
+}
 
-		// It is possible for uniform storage classes to be passed as function parameters, so detect
-		// that. To detect function parameters, check of StorageClass of variable is function scope.
-		if (var.storage == StorageClassFunction || !type.pointer || is_builtin_variable(var))
-			return;
+SmallVector<VariableID> Compiler::remove_interface_variables(const unordered_set<VariableID> &variables)
+{
+	// Find out how the shader uses the variables. Storing to an output is fine, anything else keeps it.
+	unordered_map<uint32_t, uint32_t> base_variables;
+	unordered_set<uint32_t> used_variables;
 
-		if (active_variables && active_variables->find(var.self) == end(*active_variables))
-			return;
+	const auto base_variable = [&](uint32_t id) -> uint32_t {
+		auto itr = base_variables.find(id);
+		return itr != end(base_variables) ? itr->second : id;
+	};
 
-		// Input
-		if (var.storage == StorageClassInput && interface_variable_exists_in_entry_point(var.self))
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, const SPIRFunction &func) {
+		for (auto block_id : func.blocks)
 		{
-			if (has_decoration(type.self, DecorationBlock))
+			for (auto &i : get<SPIRBlock>(block_id).ops)
 			{
-				res.stage_inputs.push_back(
-				    { var.self, var.basetype, type.self, get_remapped_declared_block_name(var.self, false) });
+				auto op = static_cast<Op>(i.op);
+				auto *ops = stream(i);
+				if ((op == OpAccessChain || op == OpInBoundsAccessChain || op == OpPtrAccessChain) && i.length >= 3)
+					base_variables[ops[1]] = base_variable(ops[2]);
 			}
-			else
-				res.stage_inputs.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
-		}
-		// Subpass inputs
-		else if (var.storage == StorageClassUniformConstant && type.image.dim == DimSubpassData)
-		{
-			res.subpass_inputs.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
 		}
-		// Outputs
-		else if (var.storage == StorageClassOutput && interface_variable_exists_in_entry_point(var.self))
+	});
+
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, const SPIRFunction &func) {
+		for (auto block_id : func.blocks)
 		{
-			if (has_decoration(type.self, DecorationBlock))
+			auto &block = get<SPIRBlock>(block_id);
+			for (auto &i : block.ops)
 			{
-				res.stage_outputs.push_back(
-				    { var.self, var.basetype, type.self, get_remapped_declared_block_name(var.self, false) });
+				auto op = static_cast<Op>(i.op);
+				auto *ops = stream(i);
+				uint32_t first_arg = 0;
+
+				if (op == OpStore && i.length >= 2)
+				{
+					auto *var = maybe_get<SPIRVariable>(base_variable(ops[0]));
+					if (var && var->storage == StorageClassInput)
+						used_variables.insert(var->self);
+					first_arg = 1;
+				}
+				else if ((op == OpAccessChain || op == OpInBoundsAccessChain || op == OpPtrAccessChain) &&
+				         i.length >= 3)
+				{
+					// Only deriving a pointer does not access anything yet.
+					first_arg = 3;
+				}
+
+				for (uint32_t arg = first_arg; arg < i.length; arg++)
+					used_variables.insert(base_variable(ops[arg]));
 			}
-			else
-				res.stage_outputs.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
-		}
-		// UBOs
-		else if (type.storage == StorageClassUniform && has_decoration(type.self, DecorationBlock))
-		{
-			res.uniform_buffers.push_back(
-			    { var.self, var.basetype, type.self, get_remapped_declared_block_name(var.self, false) });
-		}
-		// Old way to declare SSBOs.
-		else if (type.storage == StorageClassUniform && has_decoration(type.self, DecorationBufferBlock))
-		{
-			res.storage_buffers.push_back(
-			    { var.self, var.basetype, type.self, get_remapped_declared_block_name(var.self, ssbo_instance_name) });
-		}
-		// Modern way to declare SSBOs.
-		else if (type.storage == StorageClassStorageBuffer)
-		{
-			res.storage_buffers.push_back(
-			    { var.self, var.basetype, type.self, get_remapped_declared_block_name(var.self, ssbo_instance_name) });
-		}
-		// Push constant blocks
-		else if (type.storage == StorageClassPushConstant)
-		{
-			// There can only be one push constant block, but keep the vector in case this restriction is lifted
-			// in the future.
-			res.push_constant_buffers.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
-		}
-		// Images
-		else if (type.storage == StorageClassUniformConstant && type.basetype == SPIRType::Image &&
-		         type.image.sampled == 2)
-		{
-			res.storage_images.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
-		}
-		// Separate images
-		else if (type.storage == StorageClassUniformConstant && type.basetype == SPIRType::Image &&
-		         type.image.sampled == 1)
-		{
-			res.separate_images.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
-		}
-		// Separate samplers
-		else if (type.storage == StorageClassUniformConstant && type.basetype == SPIRType::Sampler)
-		{
-			res.separate_samplers.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
-		}
-		// Textures
-		else if (type.storage == StorageClassUniformConstant && type.basetype == SPIRType::SampledImage)
-		{
-			res.sampled_images.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
-		}
-		// Atomic counters
-		else if (type.storage == StorageClassAtomicCounter)
-		{
-			res.atomic_counters.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
-		}
-		// Acceleration structures
-		else if (type.storage == StorageClassUniformConstant && type.basetype == SPIRType::AccelerationStructure)
-		{
-			res.acceleration_structures.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
+
+			for (auto &phi : block.phi_variables)
+				used_variables.insert(base_variable(phi.local_variable));
+			used_variables.insert(base_variable(block.return_value));
 		}
 	});
 
-	return res;
-}
+	SmallVector<VariableID> removed;
+	auto &execution = get_entry_point();
+	for (auto &id : execution.interface_variables)
+	{
+		if (!variables.count(id) || used_variables.count(id))
+			continue;
 
-bool Compiler::type_is_block_like(const SPIRType &type) const
-{
-	if (type.basetype != SPIRType::Struct)
-		return false;
+		auto &var = get<SPIRVariable>(id);
+		if (var.storage == StorageClassInput || var.storage == StorageClassOutput)
+			removed.push_back(id);
+	}
 
-	if (has_decoration(type.self, DecorationBlock) || has_decoration(type.self, DecorationBufferBlock))
+	if (removed.empty())
+		return removed;
+
+	for (auto &id : removed)
 	{
-		return true;
+		removed_interface_variables.insert(id);
+		auto itr = find(begin(execution.interface_variables), end(execution.interface_variables), id);
+		execution.interface_variables.erase(itr);
 	}
 
-	// Block-like types may have Offset decorations.
-	for (uint32_t i = 0; i < uint32_t(type.member_types.size()); i++)
-		if (has_member_decoration(type.self, i, DecorationOffset))
-			return true;
+	eliminate_dead_code();
+	return removed;
+}
 
-	return false;
+uint32_t Compiler::remap_resource_bindings(const ResourceBindingRemap *remaps, size_t count)
+{
+	unordered_map<uint64_t, const ResourceBindingRemap *> remap_table;
+	remap_table.reserve(count);
+	for (size_t i = 0; i < count; i++)
+		remap_table[(uint64_t(remaps[i].desc_set) << 32) | remaps[i].binding] = &remaps[i];
+
+	uint32_t remapped = 0;
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t id, const SPIRVariable &) {
+		auto *m = ir.find_meta(id);
+		if (!m || !m->decoration.decoration_flags.get(DecorationBinding))
+			return;
+
+		auto itr = remap_table.find((uint64_t(m->decoration.set) << 32) | m->decoration.binding);
+		if (itr == end(remap_table))
+			return;
+
+		ir.set_decoration(id, DecorationDescriptorSet, itr->second->new_desc_set);
+		ir.set_decoration(id, DecorationBinding, itr->second->new_binding);
+		remapped++;
+	});
+
+	return remapped;
 }
 
-void Compiler::parse_fixup()
+uint32_t Compiler::get_workgroup_type_size(const SPIRType &type, uint32_t &alignment) const
 {
-	// Figure out specialization constants for work group sizes.
-	for (auto id_ : ir.ids_for_constant_or_variable)
+	if (!type.array.empty())
 	{
-		auto &id = ir.ids[id_];
+		uint32_t count = type.array_size_literal.back() ? type.array.back() : evaluate_constant_u32(type.array.back());
+		uint32_t size = get_workgroup_type_size(get<SPIRType>(type.parent_type), alignment);
+		return count * ((size + alignment - 1) & ~(alignment - 1));
+	}
 
-		if (id.get_type() == TypeConstant)
-		{
-			auto &c = id.get<SPIRConstant>();
-			if (ir.meta[c.self].decoration.builtin && ir.meta[c.self].decoration.builtin_type == BuiltInWorkgroupSize)
-			{
-				// In current SPIR-V, there can be just one constant like this.
-				// All entry points will receive the constant value.
-				for (auto &entry : ir.entry_points)
-				{
-					entry.second.workgroup_size.constant = c.self;
-					entry.second.workgroup_size.x = c.scalar(0, 0);
-					entry.second.workgroup_size.y = c.scalar(0, 1);
-					entry.second.workgroup_size.z = c.scalar(0, 2);
-				}
-			}
-		}
-		else if (id.get_type() == TypeVariable)
+	if (type.pointer)
+	{
+		alignment = 8;
+		return 8;
+	}
+
+	if (type.basetype == SPIRType::Struct)
+	{
+		uint32_t offset = 0;
+		uint32_t struct_alignment = 1;
+		for (auto member_type : type.member_types)
 		{
-			auto &var = id.get<SPIRVariable>();
-			if (var.storage == StorageClassPrivate || var.storage == StorageClassWorkgroup ||
-			    var.storage == StorageClassOutput)
-				global_variables.push_back(var.self);
-			if (variable_storage_is_aliased(var))
-				aliased_variables.push_back(var.self);
+			uint32_t member_alignment = 1;
+			uint32_t size = get_workgroup_type_size(get<SPIRType>(member_type), member_alignment);
+			offset = ((offset + member_alignment - 1) & ~(member_alignment - 1)) + size;
+			struct_alignment = max(struct_alignment, member_alignment);
 		}
+		alignment = struct_alignment;
+		return (offset + struct_alignment - 1) & ~(struct_alignment - 1);
 	}
+
+	// Booleans have no defined size, assume they are stored as 32-bit values.
+	uint32_t component_size = type.basetype == SPIRType::Boolean ? 4 : type.width / 8;
+	alignment = component_size * (type.vecsize == 3 ? 4 : type.vecsize);
+	if (type.columns > 1)
+		return type.columns * alignment;
+	else
+		return component_size * type.vecsize;
 }
 
-void Compiler::update_name_cache(unordered_set<string> &cache_primary, const unordered_set<string> &cache_secondary,
-                                 string &name)
+uint32_t Compiler::get_workgroup_memory_size() const
 {
-	if (name.empty())
-		return;
+	uint32_t size = 0;
+	uint32_t explicit_layout_size = 0;
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t id, const SPIRVariable &var) {
+		if (var.storage != StorageClassWorkgroup || is_hidden_variable(var) || workgroup_variable_aliases.count(id))
+			return;
 
-	const auto find_name = [&](const string &n) -> bool {
-		if (cache_primary.find(n) != end(cache_primary))
-			return true;
+		// Blocks declared with an explicit layout all alias the same memory.
+		auto &type = get_variable_data_type(var);
+		if (has_decoration(type.self, DecorationBlock))
+		{
+			explicit_layout_size = max(explicit_layout_size, uint32_t(get_declared_struct_size(type)));
+			return;
+		}
 
-		if (&cache_primary != &cache_secondary)
-			if (cache_secondary.find(n) != end(cache_secondary))
-				return true;
+		uint32_t alignment = 1;
+		uint32_t var_size = get_workgroup_type_size(type, alignment);
+		size = ((size + alignment - 1) & ~(alignment - 1)) + var_size;
+	});
+
+	return size + explicit_layout_size;
+}
+
+static void append_block_successors(const SPIRBlock &block, SmallVector<uint32_t> &successors)
+{
+	switch (block.terminator)
+	{
+	case SPIRBlock::Direct:
+		successors.push_back(block.next_block);
+		break;
+
+	case SPIRBlock::Select:
+		successors.push_back(block.true_block);
+		successors.push_back(block.false_block);
+		break;
+
+	case SPIRBlock::MultiSelect:
+		for (auto &target : block.cases)
+			successors.push_back(target.block);
+		if (block.default_block)
+			successors.push_back(block.default_block);
+		break;
+
+	default:
+		break;
+	}
+}
+
+static bool opcode_forwards_invocation_dependence(Op op)
+{
+	switch (op)
+	{
+	case OpLoad:
+	case OpAccessChain:
+	case OpInBoundsAccessChain:
+	case OpCopyObject:
+	case OpCompositeExtract:
+	case OpCompositeConstruct:
+	case OpVectorShuffle:
+	case OpBitcast:
+	case OpUConvert:
+	case OpSConvert:
+	case OpConvertUToF:
+	case OpConvertSToF:
+	case OpConvertFToU:
+	case OpConvertFToS:
+	case OpIAdd:
+	case OpISub:
+	case OpIMul:
+	case OpUDiv:
+	case OpSDiv:
+	case OpUMod:
+	case OpSMod:
+	case OpSRem:
+	case OpShiftLeftLogical:
+	case OpShiftRightLogical:
+	case OpShiftRightArithmetic:
+	case OpBitwiseAnd:
+	case OpBitwiseOr:
+	case OpBitwiseXor:
+	case OpNot:
+	case OpSNegate:
+	case OpSelect:
+	case OpExtInst:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+uint32_t Compiler::pad_workgroup_arrays()
+{
+	// Find every value which can differ between the invocations of a workgroup,
+	// starting from the invocation ID built-ins. Values stored to memory taint the whole variable.
+	unordered_set<uint32_t> invocation_dependent;
+	unordered_map<uint32_t, uint32_t> base_variables;
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t id, const SPIRVariable &var) {
+		if (var.storage != StorageClassInput || !has_decoration(id, DecorationBuiltIn))
+			return;
+
+		switch (BuiltIn(get_decoration(id, DecorationBuiltIn)))
+		{
+		case BuiltInLocalInvocationId:
+		case BuiltInLocalInvocationIndex:
+		case BuiltInGlobalInvocationId:
+		case BuiltInSubgroupLocalInvocationId:
+			invocation_dependent.insert(id);
+			break;
+
+		default:
+			break;
+		}
+	});
+
+	const auto base_variable = [&](uint32_t id) -> uint32_t {
+		auto itr = base_variables.find(id);
+		return itr != end(base_variables) ? itr->second : id;
+	};
+
+	// Phis and stores can feed values backwards, iterate until nothing changes.
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		ir.for_each_typed_id<SPIRFunction>([&](uint32_t, const SPIRFunction &func) {
+			for (auto block_id : func.blocks)
+			{
+				auto &block = get<SPIRBlock>(block_id);
+				for (auto &phi : block.phi_variables)
+					if (invocation_dependent.count(phi.local_variable) &&
+					    invocation_dependent.insert(phi.function_variable).second)
+						changed = true;
+
+				for (auto &i : block.ops)
+				{
+					auto op = static_cast<Op>(i.op);
+					auto *ops = stream(i);
+					if ((op == OpAccessChain || op == OpInBoundsAccessChain) && i.length >= 3)
+						base_variables[ops[1]] = base_variable(ops[2]);
+
+					if (op == OpStore && i.length >= 2)
+					{
+						if (invocation_dependent.count(ops[1]) &&
+						    invocation_dependent.insert(base_variable(ops[0])).second)
+							changed = true;
+					}
+					else if (opcode_forwards_invocation_dependence(op) && i.length >= 3 &&
+					         !invocation_dependent.count(ops[1]))
+					{
+						for (uint32_t arg = 2; arg < i.length; arg++)
+						{
+							if (invocation_dependent.count(ops[arg]))
+							{
+								invocation_dependent.insert(ops[1]);
+								changed = true;
+								break;
+							}
+						}
+					}
+				}
+			}
+		});
+	}
+
+	// Arrays of 32-bit scalars whose rows are a multiple of 32 banks of 4 bytes wide, so that walking
+	// along an outer dimension hits the same bank over and over.
+	struct Candidate
+	{
+		bool invocation_dependent_outer_index = false;
+		bool rejected = false;
+	};
+	unordered_map<uint32_t, Candidate> candidates;
+
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t id, const SPIRVariable &var) {
+		if (var.storage != StorageClassWorkgroup || var.initializer || is_hidden_variable(var) ||
+		    workgroup_variable_aliases.count(id))
+			return;
+
+		auto &type = get_variable_data_type(var);
+		if (type.array.size() < 2 || !type.array_size_literal.front() || type.pointer || type.vecsize != 1 ||
+		    type.columns != 1 || type.width != 32)
+			return;
+		if (type.basetype != SPIRType::Float && type.basetype != SPIRType::Int && type.basetype != SPIRType::UInt)
+			return;
+
+		uint32_t row_size = type.array.front() * 4;
+		if (row_size == 0 || row_size % 128 != 0)
+			return;
+
+		for (uint32_t type_id = get_variable_data_type_id(var); get<SPIRType>(type_id).array.size() != 0;
+		     type_id = get<SPIRType>(type_id).parent_type)
+		{
+			if (has_decoration(type_id, DecorationArrayStride))
+				return;
+		}
+
+		candidates[id] = {};
+	});
+
+	if (candidates.empty())
+		return 0;
+
+	// Padding changes the type of the array, so it must only be accessed one element at a time.
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, const SPIRFunction &func) {
+		for (auto block_id : func.blocks)
+		{
+			auto &block = get<SPIRBlock>(block_id);
+			for (auto &phi : block.phi_variables)
+			{
+				auto itr = candidates.find(phi.local_variable);
+				if (itr != end(candidates))
+					itr->second.rejected = true;
+			}
+
+			for (auto &i : block.ops)
+			{
+				auto op = static_cast<Op>(i.op);
+				auto *ops = stream(i);
+				for (uint32_t arg = 0; arg < i.length; arg++)
+				{
+					auto itr = candidates.find(ops[arg]);
+					if (itr == end(candidates))
+						continue;
+
+					auto &candidate = itr->second;
+					uint32_t dimensions = uint32_t(get_variable_data_type(get<SPIRVariable>(itr->first)).array.size());
+					if (arg != 2 || (op != OpAccessChain && op != OpInBoundsAccessChain) || i.length != 3 + dimensions)
+					{
+						candidate.rejected = true;
+						continue;
+					}
+
+					// The last index selects the element within a row.
+					for (uint32_t index = 3; index + 1 < i.length; index++)
+						if (invocation_dependent.count(ops[index]))
+							candidate.invocation_dependent_outer_index = true;
+				}
+			}
+		}
+	});
+
+	uint32_t padded = 0;
+	for (auto &candidate : candidates)
+	{
+		if (candidate.second.rejected || !candidate.second.invocation_dependent_outer_index)
+			continue;
+
+		auto &var = get<SPIRVariable>(candidate.first);
+		uint32_t dimensions = uint32_t(get_variable_data_type(var).array.size());
+
+		SmallVector<uint32_t> array_types;
+		for (uint32_t type_id = get_variable_data_type_id(var); get<SPIRType>(type_id).array.size() != 0;
+		     type_id = get<SPIRType>(type_id).parent_type)
+			array_types.push_back(type_id);
+
+		// Rebuild the array types from the innermost one out, then the pointer type of the variable.
+		uint32_t ids = ir.increase_bound_by(dimensions + 1);
+		uint32_t parent_type = get<SPIRType>(array_types.back()).parent_type;
+		for (uint32_t i = 0; i < dimensions; i++)
+		{
+			SPIRType padded_type = get<SPIRType>(array_types[dimensions - 1 - i]);
+			padded_type.array.front()++;
+			padded_type.parent_type = parent_type;
+			set<SPIRType>(ids + i, padded_type);
+			parent_type = ids + i;
+		}
+
+		SPIRType pointer_type = get<SPIRType>(var.basetype);
+		pointer_type.array.front()++;
+		pointer_type.parent_type = parent_type;
+		set<SPIRType>(ids + dimensions, pointer_type);
+		var.basetype = ids + dimensions;
+		padded++;
+	}
+
+	if (padded)
+		invalidate_function_analysis();
+	return padded;
+}
+
+bool Compiler::workgroup_variable_lifetimes_are_disjoint(const WorkgroupVariableAccesses &accesses, uint32_t first,
+                                                          uint32_t second) const
+{
+	auto &func = get<SPIRFunction>(ir.default_entry_point);
+
+	// Whether the first variable can still be accessed once control reaches the start of a block.
+	unordered_set<uint32_t> first_reachable;
+	for (auto &block : accesses.blocks)
+		for (auto &access : block.second.accesses)
+			if (access.second == first)
+				first_reachable.insert(block.first);
+
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (auto block_id : func.blocks)
+		{
+			if (first_reachable.count(block_id))
+				continue;
+
+			SmallVector<uint32_t> successors;
+			append_block_successors(get<SPIRBlock>(block_id), successors);
+			for (auto succ : successors)
+			{
+				if (first_reachable.count(succ))
+				{
+					first_reachable.insert(block_id);
+					changed = true;
+					break;
+				}
+			}
+		}
+	}
+
+	// Every path from the entry to an access of the second variable has to pass a barrier
+	// after which the first variable is never accessed again.
+	unordered_set<uint32_t> visited;
+	SmallVector<uint32_t> worklist = { func.entry_block };
+	visited.insert(func.entry_block);
+	while (!worklist.empty())
+	{
+		uint32_t block_id = worklist.back();
+		worklist.pop_back();
+
+		SmallVector<uint32_t> successors;
+		append_block_successors(get<SPIRBlock>(block_id), successors);
+		bool first_reachable_after_block = false;
+		for (auto succ : successors)
+			if (first_reachable.count(succ))
+				first_reachable_after_block = true;
+
+		uint32_t last_first_access = 0;
+		uint32_t separating_barrier = ~0u;
+		auto block_itr = accesses.blocks.find(block_id);
+		if (block_itr != end(accesses.blocks))
+		{
+			auto &block = block_itr->second;
+			for (auto &access : block.accesses)
+				if (access.second == first)
+					last_first_access = max(last_first_access, access.first + 1);
+
+			if (!first_reachable_after_block)
+			{
+				for (auto barrier : block.barriers)
+				{
+					if (barrier >= last_first_access)
+					{
+						separating_barrier = barrier;
+						break;
+					}
+				}
+			}
+
+			for (auto &access : block.accesses)
+				if (access.second == second && access.first < separating_barrier)
+					return false;
+		}
+
+		if (separating_barrier != ~0u)
+			continue;
+
+		for (auto succ : successors)
+			if (visited.insert(succ).second)
+				worklist.push_back(succ);
+	}
+
+	return true;
+}
+
+uint32_t Compiler::alias_workgroup_variables()
+{
+	if (get_execution_model() != ExecutionModelGLCompute)
+		return 0;
+
+	unordered_set<uint32_t> candidates;
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t id, const SPIRVariable &var) {
+		if (var.storage != StorageClassWorkgroup || var.initializer || is_hidden_variable(var) ||
+		    workgroup_variable_aliases.count(id) || has_decoration(get_variable_data_type(var).self, DecorationBlock))
+			return;
+		candidates.insert(id);
+	});
+
+	if (candidates.size() < 2)
+		return 0;
+
+	unordered_map<uint32_t, uint32_t> base_variables;
+	const auto base_variable = [&](uint32_t id) -> uint32_t {
+		auto itr = base_variables.find(id);
+		return itr != end(base_variables) ? itr->second : id;
+	};
+
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, const SPIRFunction &func) {
+		for (auto block_id : func.blocks)
+		{
+			for (auto &i : get<SPIRBlock>(block_id).ops)
+			{
+				auto op = static_cast<Op>(i.op);
+				auto *ops = stream(i);
+				if ((op == OpAccessChain || op == OpInBoundsAccessChain || op == OpPtrAccessChain ||
+				     op == OpCopyObject) &&
+				    i.length >= 3)
+				{
+					base_variables[ops[1]] = base_variable(ops[2]);
+				}
+			}
+		}
+	});
+
+	// Record where in the entry point each variable is accessed, and give up on variables which are used
+	// from other functions or whose pointers escape into something we cannot follow.
+	// Any word of an instruction counts as an access, which can only make lifetimes longer than they are.
+	WorkgroupVariableAccesses accesses;
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t func_id, const SPIRFunction &func) {
+		bool is_entry_point = func_id == ir.default_entry_point;
+		for (auto block_id : func.blocks)
+		{
+			auto &block = get<SPIRBlock>(block_id);
+			for (auto &phi : block.phi_variables)
+				candidates.erase(base_variable(phi.local_variable));
+			candidates.erase(base_variable(block.return_value));
+
+			for (uint32_t index = 0; index < uint32_t(block.ops.size()); index++)
+			{
+				auto &i = block.ops[index];
+				auto op = static_cast<Op>(i.op);
+				auto *ops = stream(i);
+
+				if (is_entry_point && op == OpControlBarrier && i.length >= 3)
+				{
+					auto *execution_scope = maybe_get<SPIRConstant>(ops[0]);
+					auto *semantics = maybe_get<SPIRConstant>(ops[2]);
+					if (execution_scope && semantics && !execution_scope->specialization &&
+					    !semantics->specialization && execution_scope->scalar() == ScopeWorkgroup &&
+					    (semantics->scalar() & MemorySemanticsWorkgroupMemoryMask) != 0)
+					{
+						accesses.blocks[block_id].barriers.push_back(index);
+					}
+					continue;
+				}
+
+				bool escapes = !is_entry_point || op == OpFunctionCall || op == OpSelect || op == OpBitcast ||
+				               op == OpConvertPtrToU;
+				for (uint32_t arg = 0; arg < i.length; arg++)
+				{
+					uint32_t var_id = base_variable(ops[arg]);
+					if (!candidates.count(var_id))
+						continue;
+
+					if (escapes)
+						candidates.erase(var_id);
+					else
+						accesses.blocks[block_id].accesses.push_back({ index, var_id });
+				}
+			}
+		}
+	});
+
+	SmallVector<uint32_t> sorted_candidates;
+	sorted_candidates.reserve(candidates.size());
+	for (auto var_id : candidates)
+		sorted_candidates.push_back(var_id);
+	sort(begin(sorted_candidates), end(sorted_candidates));
+
+	// Greedily assign each variable to the first storage whose other users it never overlaps with.
+	SmallVector<SmallVector<uint32_t>> storage;
+	uint32_t aliased = 0;
+	for (auto var_id : sorted_candidates)
+	{
+		uint32_t type_id = get_variable_data_type_id(get<SPIRVariable>(var_id));
+		bool assigned = false;
+		for (auto &users : storage)
+		{
+			if (get_variable_data_type_id(get<SPIRVariable>(users.front())) != type_id)
+				continue;
+
+			bool disjoint = all_of(begin(users), end(users), [&](uint32_t user) {
+				return workgroup_variable_lifetimes_are_disjoint(accesses, user, var_id) ||
+				       workgroup_variable_lifetimes_are_disjoint(accesses, var_id, user);
+			});
+
+			if (disjoint)
+			{
+				workgroup_variable_aliases[var_id] = users.front();
+				users.push_back(var_id);
+				aliased++;
+				assigned = true;
+				break;
+			}
+		}
+
+		if (!assigned)
+			storage.push_back({ var_id });
+	}
+
+	if (aliased)
+		invalidate_function_analysis();
+	return aliased;
+}
+
+void Compiler::eliminate_dead_code()
+{
+	// Everything with side effects is live, and so is everything it consumes, transitively.
+	// Stores into function local and private variables only become live once the variable is read,
+	// stores into removed interface variables never are.
+	// Any word of a live instruction counts as a use, which can only keep more code than needed.
+	unordered_map<uint32_t, uint32_t> base_variables;
+	unordered_map<uint32_t, const Instruction *> definitions;
+	unordered_map<uint32_t, SmallVector<const Instruction *>> variable_stores;
+	unordered_map<uint32_t, SmallVector<uint32_t>> phi_inputs;
+	unordered_set<uint32_t> parameters;
+	unordered_set<uint32_t> live;
+	SmallVector<uint32_t> worklist;
+
+	const auto base_variable = [&](uint32_t id) -> uint32_t {
+		auto itr = base_variables.find(id);
+		return itr != end(base_variables) ? itr->second : id;
+	};
+
+	const auto mark = [&](uint32_t id) {
+		if (id && live.insert(id).second)
+			worklist.push_back(id);
+	};
+
+	const auto mark_instruction = [&](const Instruction &i) {
+		auto *ops = stream(i);
+		for (uint32_t arg = 0; arg < i.length; arg++)
+			mark(ops[arg]);
+	};
+
+	// Stores into these only matter if the variable is read.
+	const auto is_local_variable = [&](uint32_t id) {
+		auto *var = maybe_get<SPIRVariable>(id);
+		if (!var || parameters.count(id))
+			return false;
+		return var->storage == StorageClassFunction || var->storage == StorageClassPrivate ||
+		       removed_interface_variables.count(id) != 0;
+	};
+
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, const SPIRFunction &func) {
+		for (auto &arg : func.arguments)
+			parameters.insert(arg.id);
+
+		for (auto block_id : func.blocks)
+		{
+			for (auto &i : get<SPIRBlock>(block_id).ops)
+			{
+				auto op = static_cast<Op>(i.op);
+				auto *ops = stream(i);
+				if ((op == OpAccessChain || op == OpInBoundsAccessChain || op == OpPtrAccessChain) && i.length >= 3)
+					base_variables[ops[1]] = base_variable(ops[2]);
+			}
+		}
+	});
+
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, const SPIRFunction &func) {
+		for (auto block_id : func.blocks)
+		{
+			auto &block = get<SPIRBlock>(block_id);
+			mark(block.condition);
+			mark(block.return_value);
+			for (auto &phi : block.phi_variables)
+				phi_inputs[phi.function_variable].push_back(phi.local_variable);
+
+			for (auto &i : block.ops)
+			{
+				auto op = static_cast<Op>(i.op);
+				auto *ops = stream(i);
+
+				if ((op == OpStore || op == OpCopyMemory) && i.length >= 2 && is_local_variable(base_variable(ops[0])))
+					variable_stores[base_variable(ops[0])].push_back(&i);
+				else if (i.length >= 2 && !opcode_has_side_effects(op, ops, i.length))
+					definitions[ops[1]] = &i;
+				else
+					mark_instruction(i);
+			}
+		}
+	});
+
+	while (!worklist.empty())
+	{
+		uint32_t id = worklist.back();
+		worklist.pop_back();
+
+		auto def_itr = definitions.find(id);
+		if (def_itr != end(definitions))
+			mark_instruction(*def_itr->second);
+
+		// Stores into removed interface variables are never kept.
+		if (!removed_interface_variables.count(id))
+		{
+			auto store_itr = variable_stores.find(id);
+			if (store_itr != end(variable_stores))
+				for (auto *store : store_itr->second)
+					mark_instruction(*store);
+		}
+
+		auto phi_itr = phi_inputs.find(id);
+		if (phi_itr != end(phi_inputs))
+			for (auto input : phi_itr->second)
+				mark(input);
+
+		auto *var = maybe_get<SPIRVariable>(id);
+		if (var)
+			mark(var->initializer);
+	}
+
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, SPIRFunction &func) {
+		for (auto block_id : func.blocks)
+		{
+			auto &block = get<SPIRBlock>(block_id);
+			const auto is_dead = [&](const Instruction &i) {
+				auto *args = stream(i);
+				auto op = static_cast<Op>(i.op);
+				if ((op == OpStore || op == OpCopyMemory) && i.length >= 2 &&
+				    is_local_variable(base_variable(args[0])))
+				{
+					uint32_t var = base_variable(args[0]);
+					return !live.count(var) || removed_interface_variables.count(var) != 0;
+				}
+				return i.length >= 2 && definitions.count(args[1]) != 0 && !live.count(args[1]);
+			};
+
+			// Only unshare the instructions of blocks which actually lose some.
+			if (any_of(begin(block.ops), end(block.ops), is_dead))
+			{
+				auto &ops = block.ops.get_mutable();
+				ops.erase(remove_if(begin(ops), end(ops), is_dead), end(ops));
+			}
+
+			auto &phis = block.phi_variables;
+			phis.erase(remove_if(begin(phis), end(phis),
+			                     [&](const SPIRBlock::Phi &phi) { return !live.count(phi.function_variable); }),
+			           end(phis));
+		}
+
+		auto &locals = func.local_variables;
+		locals.erase(remove_if(begin(locals), end(locals), [&](VariableID id) { return !live.count(id); }),
+		             end(locals));
+	});
+
+	// What the shader accesses has changed.
+	invalidate_function_analysis();
+}
+
+ShaderResources Compiler::get_shader_resources(const unordered_set<VariableID> *active_variables) const
+{
+	ShaderResources res;
+
+	bool ssbo_instance_name = reflection_ssbo_instance_name_is_significant();
+
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t, const SPIRVariable &var) {
+		auto &type = this->get<SPIRType>(var.basetype);
+
+		// It is possible for uniform storage classes to be passed as function parameters, so detect
+		// that. To detect function parameters, check of StorageClass of variable is function scope.
+		if (var.storage == StorageClassFunction || !type.pointer || is_builtin_variable(var))
+			return;
+
+		if (active_variables && active_variables->find(var.self) == end(*active_variables))
+			return;
+
+		// Input
+		if (var.storage == StorageClassInput && interface_variable_exists_in_entry_point(var.self))
+		{
+			if (has_decoration(type.self, DecorationBlock))
+			{
+				res.stage_inputs.push_back(
+				    { var.self, var.basetype, type.self, get_remapped_declared_block_name(var.self, false) });
+			}
+			else
+				res.stage_inputs.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
+		}
+		// Subpass inputs
+		else if (var.storage == StorageClassUniformConstant && type.image.dim == DimSubpassData)
+		{
+			res.subpass_inputs.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
+		}
+		// Outputs
+		else if (var.storage == StorageClassOutput && interface_variable_exists_in_entry_point(var.self))
+		{
+			if (has_decoration(type.self, DecorationBlock))
+			{
+				res.stage_outputs.push_back(
+				    { var.self, var.basetype, type.self, get_remapped_declared_block_name(var.self, false) });
+			}
+			else
+				res.stage_outputs.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
+		}
+		// UBOs
+		else if (type.storage == StorageClassUniform && has_decoration(type.self, DecorationBlock))
+		{
+			res.uniform_buffers.push_back(
+			    { var.self, var.basetype, type.self, get_remapped_declared_block_name(var.self, false) });
+		}
+		// Old way to declare SSBOs.
+		else if (type.storage == StorageClassUniform && has_decoration(type.self, DecorationBufferBlock))
+		{
+			res.storage_buffers.push_back(
+			    { var.self, var.basetype, type.self, get_remapped_declared_block_name(var.self, ssbo_instance_name) });
+		}
+		// Modern way to declare SSBOs.
+		else if (type.storage == StorageClassStorageBuffer)
+		{
+			res.storage_buffers.push_back(
+			    { var.self, var.basetype, type.self, get_remapped_declared_block_name(var.self, ssbo_instance_name) });
+		}
+		// Push constant blocks
+		else if (type.storage == StorageClassPushConstant)
+		{
+			// There can only be one push constant block, but keep the vector in case this restriction is lifted
+			// in the future.
+			res.push_constant_buffers.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
+		}
+		// Images
+		else if (type.storage == StorageClassUniformConstant && type.basetype == SPIRType::Image &&
+		         type.image.sampled == 2)
+		{
+			res.storage_images.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
+		}
+		// Separate images
+		else if (type.storage == StorageClassUniformConstant && type.basetype == SPIRType::Image &&
+		         type.image.sampled == 1)
+		{
+			res.separate_images.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
+		}
+		// Separate samplers
+		else if (type.storage == StorageClassUniformConstant && type.basetype == SPIRType::Sampler)
+		{
+			res.separate_samplers.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
+		}
+		// Textures
+		else if (type.storage == StorageClassUniformConstant && type.basetype == SPIRType::SampledImage)
+		{
+			res.sampled_images.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
+		}
+		// Atomic counters
+		else if (type.storage == StorageClassAtomicCounter)
+		{
+			res.atomic_counters.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
+		}
+		// Acceleration structures
+		else if (type.storage == StorageClassUniformConstant && type.basetype == SPIRType::AccelerationStructure)
+		{
+			res.acceleration_structures.push_back({ var.self, var.basetype, type.self, get_name(var.self) });
+		}
+	});
+
+	return res;
+}
 
+bool Compiler::type_is_block_like(const SPIRType &type) const
+{
+	if (type.basetype != SPIRType::Struct)
 		return false;
-	};
 
-	const auto insert_name = [&](const string &n) { cache_primary.insert(n); };
+	if (has_decoration(type.self, DecorationBlock) || has_decoration(type.self, DecorationBufferBlock))
+	{
+		return true;
+	}
+
+	// Block-like types may have Offset decorations.
+	for (uint32_t i = 0; i < uint32_t(type.member_types.size()); i++)
+		if (has_member_decoration(type.self, i, DecorationOffset))
+			return true;
+
+	return false;
+}
+
+void Compiler::parse_fixup()
+{
+	// Figure out specialization constants for work group sizes.
+	for (auto id_ : ir.ids_for_constant_or_variable)
+	{
+		auto &id = ir.ids[id_];
+
+		if (id.get_type() == TypeConstant)
+		{
+			auto &c = id.get<SPIRConstant>();
+			auto *m = ir.find_meta(c.self);
+			if (m && m->decoration.builtin && m->decoration.builtin_type == BuiltInWorkgroupSize)
+			{
+				// In current SPIR-V, there can be just one constant like this.
+				// All entry points will receive the constant value.
+				for (auto &entry : ir.entry_points)
+				{
+					entry.second.workgroup_size.constant = c.self;
+					entry.second.workgroup_size.x = c.scalar(0, 0);
+					entry.second.workgroup_size.y = c.scalar(0, 1);
+					entry.second.workgroup_size.z = c.scalar(0, 2);
+				}
+			}
+		}
+		else if (id.get_type() == TypeVariable)
+		{
+			auto &var = id.get<SPIRVariable>();
+			if (var.storage == StorageClassPrivate || var.storage == StorageClassWorkgroup ||
+			    var.storage == StorageClassOutput)
+				global_variables.push_back(var.self);
+			if (variable_storage_is_aliased(var))
+				aliased_variables.push_back(var.self);
+		}
+	}
+}
+
+bool Compiler::name_cache_contains(const NameCache &cache, const string &name) const
+{
+	uint32_t handle = name_interner.find(name);
+	return handle != StringInterner::InvalidHandle && cache.count(handle) != 0;
+}
+
+void Compiler::insert_name(NameCache &cache, const string &name)
+{
+	cache.insert(name_interner.intern(name));
+}
+
+void Compiler::update_name_cache(NameCache &cache_primary, const NameCache &cache_secondary, string &name)
+{
+	if (name.empty())
+		return;
+
+	const auto find_handle = [&](uint32_t handle) -> bool {
+		if (cache_primary.count(handle))
+			return true;
+
+		if (&cache_primary != &cache_secondary)
+			if (cache_secondary.count(handle))
+				return true;
+
+		return false;
+	};
 
-	if (!find_name(name))
+	// The common case is no collision, where we need the handle anyway.
+	uint32_t handle = name_interner.intern(name);
+	if (!find_handle(handle))
 	{
-		insert_name(name);
+		cache_primary.insert(handle);
 		return;
 	}
 
@@ -1046,15 +2098,17 @@ void Compiler::update_name_cache(unordered_set<string> &cache_primary, const uno
 
 	// If there is a collision (very rare),
 	// keep tacking on extra identifier until it's unique.
+	// Names which were never interned cannot be in any cache.
 	do
 	{
 		counter++;
 		name = tmpname + (use_linked_underscore ? "_" : "") + convert_to_string(counter);
-	} while (find_name(name));
-	insert_name(name);
+		handle = name_interner.find(name);
+	} while (handle != StringInterner::InvalidHandle && find_handle(handle));
+	insert_name(cache_primary, name);
 }
 
-void Compiler::update_name_cache(unordered_set<string> &cache, string &name)
+void Compiler::update_name_cache(NameCache &cache, string &name)
 {
 	update_name_cache(cache, cache, name);
 }
@@ -1148,6 +2202,7 @@ void Compiler::set_member_decoration_string(TypeID id, uint32_t index, spv::Deco
 
 void Compiler::set_member_decoration(TypeID id, uint32_t index, Decoration decoration, uint32_t argument)
 {
+	invalidate_layout_cache(decoration, false);
 	ir.set_member_decoration(id, index, decoration, argument);
 }
 
@@ -1198,6 +2253,7 @@ bool Compiler::has_member_decoration(TypeID id, uint32_t index, Decoration decor
 
 void Compiler::unset_member_decoration(TypeID id, uint32_t index, Decoration decoration)
 {
+	invalidate_layout_cache(decoration, false);
 	ir.unset_member_decoration(id, index, decoration);
 }
 
@@ -1208,11 +2264,13 @@ void Compiler::set_decoration_string(ID id, spv::Decoration decoration, const st
 
 void Compiler::set_decoration(ID id, Decoration decoration, uint32_t argument)
 {
+	invalidate_layout_cache(decoration, false);
 	ir.set_decoration(id, decoration, argument);
 }
 
 void Compiler::set_extended_decoration(uint32_t id, ExtendedDecorations decoration, uint32_t value)
 {
+	invalidate_layout_cache(decoration, true);
 	auto &dec = ir.meta[id].decoration;
 	dec.extended.flags.set(decoration);
 	dec.extended.values[decoration] = value;
@@ -1221,6 +2279,7 @@ void Compiler::set_extended_decoration(uint32_t id, ExtendedDecorations decorati
 void Compiler::set_extended_member_decoration(uint32_t type, uint32_t index, ExtendedDecorations decoration,
                                               uint32_t value)
 {
+	invalidate_layout_cache(decoration, true);
 	ir.meta[type].members.resize(max(ir.meta[type].members.size(), size_t(index) + 1));
 	auto &dec = ir.meta[type].members[index];
 	dec.extended.flags.set(decoration);
@@ -1297,6 +2356,7 @@ bool Compiler::has_extended_member_decoration(uint32_t type, uint32_t index, Ext
 
 void Compiler::unset_extended_decoration(uint32_t id, ExtendedDecorations decoration)
 {
+	invalidate_layout_cache(decoration, true);
 	auto &dec = ir.meta[id].decoration;
 	dec.extended.flags.clear(decoration);
 	dec.extended.values[decoration] = 0;
@@ -1304,6 +2364,7 @@ void Compiler::unset_extended_decoration(uint32_t id, ExtendedDecorations decora
 
 void Compiler::unset_extended_member_decoration(uint32_t type, uint32_t index, ExtendedDecorations decoration)
 {
+	invalidate_layout_cache(decoration, true);
 	ir.meta[type].members.resize(max(ir.meta[type].members.size(), size_t(index) + 1));
 	auto &dec = ir.meta[type].members[index];
 	dec.extended.flags.clear(decoration);
@@ -1361,9 +2422,80 @@ uint32_t Compiler::get_decoration(ID id, Decoration decoration) const
 
 void Compiler::unset_decoration(ID id, Decoration decoration)
 {
+	invalidate_layout_cache(decoration, false);
 	ir.unset_decoration(id, decoration);
 }
 
+void Compiler::set_layout_cache_enabled(bool enable)
+{
+	layout_cache_enabled = enable;
+	layout_cache.clear();
+}
+
+void Compiler::invalidate_layout_cache(uint32_t decoration, bool extended)
+{
+	if (layout_cache.empty())
+		return;
+
+	bool affects_layout;
+	if (extended)
+	{
+		switch (decoration)
+		{
+		case SPIRVCrossDecorationBufferBlockRepacked:
+		case SPIRVCrossDecorationPhysicalTypeID:
+		case SPIRVCrossDecorationPhysicalTypePacked:
+		case SPIRVCrossDecorationPaddingTarget:
+			affects_layout = true;
+			break;
+
+		default:
+			affects_layout = false;
+			break;
+		}
+	}
+	else
+	{
+		switch (decoration)
+		{
+		case DecorationOffset:
+		case DecorationArrayStride:
+		case DecorationMatrixStride:
+		case DecorationRowMajor:
+		case DecorationColMajor:
+			affects_layout = true;
+			break;
+
+		default:
+			affects_layout = false;
+			break;
+		}
+	}
+
+	if (affects_layout)
+		layout_cache.clear();
+}
+
+bool Compiler::find_cached_layout(const SPIRType &type, LayoutQuery query, size_t &value) const
+{
+	if (!layout_cache_enabled || type.self == 0)
+		return false;
+
+	auto itr = layout_cache.find((uint64_t(query) << 32) | type.self);
+	// Temporary copies of a struct type share its ID, so make sure the shape still matches.
+	if (itr == end(layout_cache) || itr->second.member_count != type.member_types.size())
+		return false;
+
+	value = itr->second.value;
+	return true;
+}
+
+void Compiler::cache_layout(const SPIRType &type, LayoutQuery query, size_t value) const
+{
+	if (layout_cache_enabled && type.self != 0)
+		layout_cache[(uint64_t(query) << 32) | type.self] = { type.member_types.size(), value };
+}
+
 bool Compiler::get_binary_offset_for_decoration(VariableID id, spv::Decoration decoration, uint32_t &word_offset) const
 {
 	auto *m = ir.find_meta(id);
@@ -1585,49 +2717,275 @@ SPIRBlock::ContinueBlockType Compiler::continue_block_type(const SPIRBlock &bloc
 	}
 }
 
-bool Compiler::traverse_all_reachable_opcodes(const SPIRBlock &block, OpcodeHandler &handler) const
+bool Compiler::traverse_all_reachable_opcodes(const SPIRBlock &block, OpcodeHandler &handler) const
+{
+	check_compile_budget();
+	handler.set_current_block(block);
+	handler.rearm_current_block(block);
+
+	// Ideally, perhaps traverse the CFG instead of all blocks in order to eliminate dead blocks,
+	// but this shouldn't be a problem in practice unless the SPIR-V is doing insane things like recursing
+	// inside dead blocks ...
+	for (auto &i : block.ops)
+	{
+		auto ops = stream(i);
+		auto op = static_cast<Op>(i.op);
+
+		if (!handler.handle(op, ops, i.length))
+			return false;
+
+		if (op == OpFunctionCall)
+		{
+			auto &func = get<SPIRFunction>(ops[2]);
+			if (handler.follow_function_call(func))
+			{
+				if (!handler.begin_function_scope(ops, i.length))
+					return false;
+				if (!traverse_all_reachable_opcodes(get<SPIRFunction>(ops[2]), handler))
+					return false;
+				if (!handler.end_function_scope(ops, i.length))
+					return false;
+
+				handler.rearm_current_block(block);
+			}
+		}
+	}
+
+	return true;
+}
+
+bool Compiler::traverse_all_reachable_opcodes(const SPIRFunction &func, OpcodeHandler &handler) const
+{
+	for (auto block : func.blocks)
+		if (!traverse_all_reachable_opcodes(get<SPIRBlock>(block), handler))
+			return false;
+
+	return true;
+}
+
+const SmallVector<FunctionID> &Compiler::get_reachable_functions(FunctionID func_id) const
+{
+	auto itr = reachable_functions_cache.find(func_id);
+	if (itr != end(reachable_functions_cache))
+		return itr->second;
+
+	SmallVector<FunctionID> functions;
+	unordered_set<uint32_t> seen;
+	functions.push_back(func_id);
+	seen.insert(func_id);
+
+	// Recursion is not allowed in SPIR-V, but don't rely on it, the seen set also guards against cycles.
+	for (size_t i = 0; i < functions.size(); i++)
+	{
+		auto &func = get<SPIRFunction>(functions[i]);
+		for (auto block : func.blocks)
+		{
+			for (auto &op : get<SPIRBlock>(block).ops)
+			{
+				if (op.op != OpFunctionCall || op.length < 3)
+					continue;
+
+				uint32_t callee = stream(op)[2];
+				if (seen.insert(callee).second)
+					functions.push_back(callee);
+			}
+		}
+	}
+
+	return reachable_functions_cache[func_id] = move(functions);
+}
+
+void Compiler::FunctionSummary::merge_access(const FunctionSummary &other)
+{
+	interface_variables.insert(begin(other.interface_variables), end(other.interface_variables));
+	dref_combined_samplers.insert(begin(other.dref_combined_samplers), end(other.dref_combined_samplers));
+	merge_builtins(other);
+}
+
+void Compiler::FunctionSummary::merge_builtins(const FunctionSummary &other)
+{
+	input_builtins.merge_or(other.input_builtins);
+	output_builtins.merge_or(other.output_builtins);
+	clip_distance_count = max(clip_distance_count, other.clip_distance_count);
+	cull_distance_count = max(cull_distance_count, other.cull_distance_count);
+	position_invariant = position_invariant || other.position_invariant;
+}
+
+const Compiler::FunctionSummary &Compiler::get_function_summary(FunctionID func_id) const
+{
+	auto &summary = function_summaries[func_id];
+	if (summary.access_valid)
+		return summary;
+
+	// Mark as valid up front, so invalid SPIR-V with recursion cannot recurse forever.
+	summary.access_valid = true;
+
+	InterfaceVariableAccessHandler interface_handler(*this, summary.interface_variables);
+	ActiveBuiltinHandler builtin_handler(*this, summary);
+	CombinedImageSamplerDrefHandler dref_handler(*this);
+	bool interface_done = false;
+	bool builtin_done = false;
+
+	auto &func = get<SPIRFunction>(func_id);
+	for (auto block : func.blocks)
+	{
+		for (auto &i : get<SPIRBlock>(block).ops)
+		{
+			auto ops = stream(i);
+			auto op = static_cast<Op>(i.op);
+
+			// Like traverse_all_reachable_opcodes(), a handler which fails stops looking at the rest of the code.
+			if (!interface_done && !interface_handler.handle(op, ops, i.length))
+				interface_done = true;
+			if (!builtin_done && !builtin_handler.handle(op, ops, i.length))
+				builtin_done = true;
+			dref_handler.handle(op, ops, i.length);
+
+			// Callees are summarized first and composed into the caller.
+			if (op == OpFunctionCall && i.length >= 3)
+			{
+				// Our own entry in function_summaries stays valid, unordered_map never moves its elements.
+				summary.merge_access(get_function_summary(ops[2]));
+			}
+		}
+	}
+
+	summary.dref_combined_samplers.insert(begin(dref_handler.dref_combined_samplers),
+	                                      end(dref_handler.dref_combined_samplers));
+	return summary;
+}
+
+bool Compiler::traverse_reachable_functions_once(const SPIRFunction &entry, OpcodeHandler &handler) const
+{
+	for (auto func_id : get_reachable_functions(entry.self))
+	{
+		auto &func = get<SPIRFunction>(func_id);
+		for (auto block_id : func.blocks)
+		{
+			auto &block = get<SPIRBlock>(block_id);
+			handler.set_current_block(block);
+			handler.rearm_current_block(block);
+
+			for (auto &i : block.ops)
+				if (!handler.handle(static_cast<Op>(i.op), stream(i), i.length))
+					return false;
+		}
+	}
+
+	return true;
+}
+
+void Compiler::OpcodeHandlerGroup::add(OpcodeHandler &handler, bool follow_once)
+{
+	Entry entry;
+	entry.handler = &handler;
+	entry.depth = depth;
+	entry.follow_once = follow_once;
+	entry.following = false;
+	entry.returned = false;
+	entry.done = false;
+	handlers.push_back(move(entry));
+	active_count++;
+}
+
+bool Compiler::OpcodeHandlerGroup::handle(Op opcode, const uint32_t *args, uint32_t length)
+{
+	for (auto &entry : handlers)
+	{
+		if (is_active(entry) && !entry.handler->handle(opcode, args, length))
+		{
+			entry.done = true;
+			active_count--;
+		}
+	}
+
+	return active_count != 0;
+}
+
+bool Compiler::OpcodeHandlerGroup::follow_function_call(const SPIRFunction &func)
+{
+	bool any_following = false;
+	for (auto &entry : handlers)
+	{
+		entry.following = false;
+		if (!is_active(entry))
+			continue;
+		if (entry.follow_once && !entry.visited_functions.insert(func.self).second)
+			continue;
+
+		if (entry.handler->follow_function_call(func))
+		{
+			entry.following = true;
+			any_following = true;
+		}
+	}
+
+	return any_following;
+}
+
+void Compiler::OpcodeHandlerGroup::set_current_block(const SPIRBlock &block)
 {
-	handler.set_current_block(block);
-	handler.rearm_current_block(block);
+	for (auto &entry : handlers)
+		if (is_active(entry))
+			entry.handler->set_current_block(block);
+}
 
-	// Ideally, perhaps traverse the CFG instead of all blocks in order to eliminate dead blocks,
-	// but this shouldn't be a problem in practice unless the SPIR-V is doing insane things like recursing
-	// inside dead blocks ...
-	for (auto &i : block.ops)
+void Compiler::OpcodeHandlerGroup::rearm_current_block(const SPIRBlock &block)
+{
+	// After returning from a function, only handlers which followed the call are rearmed.
+	for (auto &entry : handlers)
+		if (is_active(entry) && (!returned_from_call || entry.returned))
+			entry.handler->rearm_current_block(block);
+
+	if (returned_from_call)
 	{
-		auto ops = stream(i);
-		auto op = static_cast<Op>(i.op);
+		for (auto &entry : handlers)
+			entry.returned = false;
+		returned_from_call = false;
+	}
+}
 
-		if (!handler.handle(op, ops, i.length))
-			return false;
+bool Compiler::OpcodeHandlerGroup::begin_function_scope(const uint32_t *args, uint32_t length)
+{
+	for (auto &entry : handlers)
+	{
+		if (!entry.following)
+			continue;
 
-		if (op == OpFunctionCall)
+		entry.following = false;
+		if (entry.handler->begin_function_scope(args, length))
+			entry.depth = depth + 1;
+		else
 		{
-			auto &func = get<SPIRFunction>(ops[2]);
-			if (handler.follow_function_call(func))
-			{
-				if (!handler.begin_function_scope(ops, i.length))
-					return false;
-				if (!traverse_all_reachable_opcodes(get<SPIRFunction>(ops[2]), handler))
-					return false;
-				if (!handler.end_function_scope(ops, i.length))
-					return false;
-
-				handler.rearm_current_block(block);
-			}
+			entry.done = true;
+			active_count--;
 		}
 	}
 
-	return true;
+	depth++;
+	return active_count != 0;
 }
 
-bool Compiler::traverse_all_reachable_opcodes(const SPIRFunction &func, OpcodeHandler &handler) const
+bool Compiler::OpcodeHandlerGroup::end_function_scope(const uint32_t *args, uint32_t length)
 {
-	for (auto block : func.blocks)
-		if (!traverse_all_reachable_opcodes(get<SPIRBlock>(block), handler))
-			return false;
+	for (auto &entry : handlers)
+	{
+		if (!is_active(entry))
+			continue;
 
-	return true;
+		entry.depth = depth - 1;
+		if (entry.handler->end_function_scope(args, length))
+			entry.returned = true;
+		else
+		{
+			entry.done = true;
+			active_count--;
+		}
+	}
+
+	depth--;
+	returned_from_call = true;
+	return active_count != 0;
 }
 
 uint32_t Compiler::type_struct_member_offset(const SPIRType &type, uint32_t index) const
@@ -1680,14 +3038,66 @@ uint32_t Compiler::type_struct_member_matrix_stride(const SPIRType &type, uint32
 		SPIRV_CROSS_THROW("Struct member does not have MatrixStride set.");
 }
 
+SmallVector<uint32_t> Compiler::get_struct_member_declaration_order(const SPIRType &type) const
+{
+	SmallVector<uint32_t> order(type.member_types.size());
+	for (uint32_t i = 0; i < uint32_t(order.size()); i++)
+		order[i] = i;
+
+	if (has_extended_decoration(type.self, SPIRVCrossDecorationMemberDeclarationOrderByOffset))
+	{
+		stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+			return type_struct_member_offset(type, a) < type_struct_member_offset(type, b);
+		});
+	}
+
+	return order;
+}
+
+uint32_t Compiler::get_next_declared_struct_member(const SPIRType &type, uint32_t index) const
+{
+	auto count = uint32_t(type.member_types.size());
+	if (!has_extended_decoration(type.self, SPIRVCrossDecorationMemberDeclarationOrderByOffset))
+		return index + 1;
+
+	// Offsets of repacked members are unique, so the next member is the one with the closest larger offset.
+	uint32_t offset = type_struct_member_offset(type, index);
+	uint32_t next = count;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		uint32_t member_offset = type_struct_member_offset(type, i);
+		if (member_offset > offset && (next == count || member_offset < type_struct_member_offset(type, next)))
+			next = i;
+	}
+	return next;
+}
+
+uint32_t Compiler::get_last_declared_struct_member(const SPIRType &type) const
+{
+	auto count = uint32_t(type.member_types.size());
+	if (!has_extended_decoration(type.self, SPIRVCrossDecorationMemberDeclarationOrderByOffset))
+		return count - 1;
+
+	uint32_t last = 0;
+	for (uint32_t i = 1; i < count; i++)
+		if (type_struct_member_offset(type, i) > type_struct_member_offset(type, last))
+			last = i;
+	return last;
+}
+
 size_t Compiler::get_declared_struct_size(const SPIRType &type) const
 {
 	if (type.member_types.empty())
 		SPIRV_CROSS_THROW("Declared struct in block cannot be empty.");
 
-	uint32_t last = uint32_t(type.member_types.size() - 1);
+	size_t cached_size;
+	if (find_cached_layout(type, LayoutQueryDeclaredSize, cached_size))
+		return cached_size;
+
+	uint32_t last = get_last_declared_struct_member(type);
 	size_t offset = type_struct_member_offset(type, last);
 	size_t size = get_declared_struct_member_size(type, last);
+	cache_layout(type, LayoutQueryDeclaredSize, offset + size);
 	return offset + size;
 }
 
@@ -1755,9 +3165,6 @@ uint32_t Compiler::evaluate_spec_constant_u32(const SPIRConstantOp &spec) const
 		binary_spec_op(BitwiseXor, ^);
 		binary_spec_op(LogicalAnd, &);
 		binary_spec_op(LogicalOr, |);
-		binary_spec_op(ShiftLeftLogical, <<);
-		binary_spec_op(ShiftRightLogical, >>);
-		binary_spec_op_cast(ShiftRightArithmetic, >>, int32_t);
 		binary_spec_op(LogicalEqual, ==);
 		binary_spec_op(LogicalNotEqual, !=);
 		binary_spec_op(IEqual, ==);
@@ -1773,6 +3180,23 @@ uint32_t Compiler::evaluate_spec_constant_u32(const SPIRConstantOp &spec) const
 #undef binary_spec_op
 #undef binary_spec_op_cast
 
+	case OpShiftLeftLogical:
+	case OpShiftRightLogical:
+	case OpShiftRightArithmetic:
+	{
+		uint32_t a = eval_u32(spec.arguments[0]);
+		uint32_t b = eval_u32(spec.arguments[1]);
+		if (b >= 32)
+			SPIRV_CROSS_THROW("Undefined behavior in shift, b >= 32.\n");
+		if (spec.opcode == OpShiftLeftLogical)
+			value = a << b;
+		else if (spec.opcode == OpShiftRightLogical)
+			value = a >> b;
+		else
+			value = uint32_t(int32_t(a) >> b);
+		break;
+	}
+
 	case OpLogicalNot:
 		value = uint32_t(!eval_u32(spec.arguments[0]));
 		break;
@@ -1782,7 +3206,7 @@ uint32_t Compiler::evaluate_spec_constant_u32(const SPIRConstantOp &spec) const
 		break;
 
 	case OpSNegate:
-		value = uint32_t(-int32_t(eval_u32(spec.arguments[0])));
+		value = 0u - eval_u32(spec.arguments[0]);
 		break;
 
 	case OpSelect:
@@ -1805,6 +3229,8 @@ uint32_t Compiler::evaluate_spec_constant_u32(const SPIRConstantOp &spec) const
 		auto b = int32_t(eval_u32(spec.arguments[1]));
 		if (b == 0)
 			SPIRV_CROSS_THROW("Undefined behavior in SRem, b == 0.\n");
+		if (uint32_t(a) == 0x80000000u && b == -1)
+			SPIRV_CROSS_THROW("Undefined behavior in SRem, INT_MIN / -1.\n");
 		value = a % b;
 		break;
 	}
@@ -1815,6 +3241,8 @@ uint32_t Compiler::evaluate_spec_constant_u32(const SPIRConstantOp &spec) const
 		auto b = int32_t(eval_u32(spec.arguments[1]));
 		if (b == 0)
 			SPIRV_CROSS_THROW("Undefined behavior in SMod, b == 0.\n");
+		if (uint32_t(a) == 0x80000000u && b == -1)
+			SPIRV_CROSS_THROW("Undefined behavior in SMod, INT_MIN / -1.\n");
 		auto v = a % b;
 
 		// Makes sure we match the sign of b, not a.
@@ -1840,6 +3268,8 @@ uint32_t Compiler::evaluate_spec_constant_u32(const SPIRConstantOp &spec) const
 		auto b = int32_t(eval_u32(spec.arguments[1]));
 		if (b == 0)
 			SPIRV_CROSS_THROW("Undefined behavior in SDiv, b == 0.\n");
+		if (uint32_t(a) == 0x80000000u && b == -1)
+			SPIRV_CROSS_THROW("Undefined behavior in SDiv, INT_MIN / -1.\n");
 		value = a / b;
 		break;
 	}
@@ -1958,9 +3388,10 @@ bool Compiler::BufferAccessHandler::handle(Op opcode, const uint32_t *args, uint
 	// monotonically increasing.
 	// Of course, this doesn't take into account if the SPIR-V for some reason decided to add
 	// very large amounts of padding, but that's not really a big deal.
-	if (index + 1 < type.member_types.size())
+	uint32_t next = compiler.get_next_declared_struct_member(type, index);
+	if (next < type.member_types.size())
 	{
-		range = compiler.type_struct_member_offset(type, index + 1) - offset;
+		range = compiler.type_struct_member_offset(type, next) - offset;
 	}
 	else
 	{
@@ -1980,8 +3411,24 @@ SmallVector<BufferRange> Compiler::get_active_buffer_ranges(VariableID id) const
 	return ranges;
 }
 
+uint32_t Compiler::set_interned_type(uint32_t id, SPIRType type, uint64_t tag)
+{
+	TypeID existing = ir.find_interned_type(type, id, tag);
+	if (existing)
+		return existing;
+
+	TypeID self = type.self;
+	auto &new_type = set<SPIRType>(id, std::move(type));
+	new_type.self = self;
+	ir.add_interned_type(id, tag);
+	return id;
+}
+
 bool Compiler::types_are_logically_equivalent(const SPIRType &a, const SPIRType &b) const
 {
+	if (&a == &b)
+		return true;
+
 	if (a.basetype != b.basetype)
 		return false;
 	if (a.width != b.width)
@@ -2009,6 +3456,9 @@ bool Compiler::types_are_logically_equivalent(const SPIRType &a, const SPIRType
 	size_t member_types = a.member_types.size();
 	for (size_t i = 0; i < member_types; i++)
 	{
+		// Only the ID needs to be compared for members which share a type, e.g. through interning.
+		if (a.member_types[i] == b.member_types[i])
+			continue;
 		if (!types_are_logically_equivalent(get<SPIRType>(a.member_types[i]), get<SPIRType>(b.member_types[i])))
 			return false;
 	}
@@ -2189,23 +3639,62 @@ void Compiler::inherit_expression_dependencies(uint32_t dst, uint32_t source_exp
 	{
 		// We have used a phi variable, which can change at the end of the block,
 		// so make sure we take a dependency on this phi variable.
-		phi->dependees.push_back(dst);
+		// The same expression commonly consumes a phi more than once, avoid growing the list for that.
+		if (phi->dependees.empty() || phi->dependees.back() != dst)
+			phi->dependees.push_back(dst);
 	}
 
 	auto *s = maybe_get<SPIRExpression>(source_expression);
 	if (!s)
 		return;
 
+	// Dependency lists are kept sorted and unique, so inheriting is a linear merge
+	// rather than appending everything and sorting again. On long forwarded chains the lists
+	// grow with the chain length, so this matters.
 	auto &e_deps = e.expression_dependencies;
 	auto &s_deps = s->expression_dependencies;
+	ID source_id = source_expression;
 
 	// If we depend on a expression, we also depend on all sub-dependencies from source.
-	e_deps.push_back(source_expression);
-	e_deps.insert(end(e_deps), begin(s_deps), end(s_deps));
+	// An expression which already depends on source has all of its sub-dependencies already.
+	auto source_itr = lower_bound(begin(e_deps), end(e_deps), source_id);
+	if (source_itr != end(e_deps) && *source_itr == source_id)
+		return;
+
+	if (s_deps.empty())
+	{
+		e_deps.insert(source_itr, source_id);
+		check_expression_budget(e);
+		return;
+	}
+
+	SmallVector<ID> merged;
+	merged.reserve(e_deps.size() + s_deps.size() + 1);
+
+	auto e_itr = begin(e_deps);
+	auto s_itr = begin(s_deps);
+	bool source_pending = true;
+
+	while (e_itr != end(e_deps) || s_itr != end(s_deps) || source_pending)
+	{
+		ID next = source_pending ? source_id : ID(UINT32_MAX);
+		if (e_itr != end(e_deps) && *e_itr < next)
+			next = *e_itr;
+		if (s_itr != end(s_deps) && *s_itr < next)
+			next = *s_itr;
+
+		if (e_itr != end(e_deps) && *e_itr == next)
+			++e_itr;
+		if (s_itr != end(s_deps) && *s_itr == next)
+			++s_itr;
+		if (source_pending && source_id == next)
+			source_pending = false;
+
+		merged.push_back(next);
+	}
 
-	// Eliminate duplicated dependencies.
-	sort(begin(e_deps), end(e_deps));
-	e_deps.erase(unique(begin(e_deps), end(e_deps)), end(e_deps));
+	e_deps = move(merged);
+	check_expression_budget(e);
 }
 
 SmallVector<EntryPoint> Compiler::get_entry_points_and_stages() const
@@ -2298,6 +3787,9 @@ bool Compiler::interface_variable_exists_in_entry_point(uint32_t id) const
 {
 	auto &var = get<SPIRVariable>(id);
 
+	if (removed_interface_variables.count(id))
+		return false;
+
 	if (ir.get_spirv_version() < 0x10400)
 	{
 		if (var.storage != StorageClassInput && var.storage != StorageClassOutput &&
@@ -2308,7 +3800,7 @@ bool Compiler::interface_variable_exists_in_entry_point(uint32_t id) const
 		// not emit input/output interfaces properly.
 		// We can assume they only had a single entry point, and single entry point
 		// shaders could easily be assumed to use every interface variable anyways.
-		if (ir.entry_points.size() <= 1)
+		if (ir.entry_points.size() <= 1 && !ir.entry_points_filtered)
 			return true;
 	}
 
@@ -2774,7 +4266,7 @@ bool Compiler::CombinedImageSamplerHandler::handle(Op opcode, const uint32_t *ar
 VariableID Compiler::build_dummy_sampler_for_combined_images()
 {
 	DummySamplerForCombinedImageHandler handler(*this);
-	traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), handler);
+	traverse_reachable_functions_once(get<SPIRFunction>(ir.default_entry_point), handler);
 	if (handler.need_dummy_sampler)
 	{
 		uint32_t offset = ir.increase_bound_by(3);
@@ -2802,40 +4294,396 @@ VariableID Compiler::build_dummy_sampler_for_combined_images()
 		return 0;
 }
 
-void Compiler::build_combined_image_samplers()
-{
-	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, SPIRFunction &func) {
-		func.combined_parameters.clear();
-		func.shadow_arguments.clear();
-		func.do_combined_parameters = true;
-	});
+void Compiler::build_combined_image_samplers()
+{
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, SPIRFunction &func) {
+		func.combined_parameters.clear();
+		func.shadow_arguments.clear();
+		func.do_combined_parameters = true;
+	});
+
+	combined_image_samplers.clear();
+	CombinedImageSamplerHandler handler(*this);
+	traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), handler);
+}
+
+SmallVector<SpecializationConstant> Compiler::get_specialization_constants() const
+{
+	SmallVector<SpecializationConstant> spec_consts;
+	ir.for_each_typed_id<SPIRConstant>([&](uint32_t, const SPIRConstant &c) {
+		if (c.specialization && has_decoration(c.self, DecorationSpecId))
+			spec_consts.push_back({ c.self, get_decoration(c.self, DecorationSpecId) });
+	});
+	return spec_consts;
+}
+
+SPIRConstant &Compiler::get_constant(ConstantID id)
+{
+	return get<SPIRConstant>(id);
+}
+
+const SPIRConstant &Compiler::get_constant(ConstantID id) const
+{
+	return get<SPIRConstant>(id);
+}
+
+bool Compiler::spec_constant_op_is_foldable(const SPIRConstantOp &spec) const
+{
+	// Must match what evaluate_spec_constant_u32() can deal with.
+	const auto is_u32_type = [&](const SPIRType &type) {
+		return is_scalar(type) && (type.basetype == SPIRType::UInt || type.basetype == SPIRType::Int ||
+		                           type.basetype == SPIRType::Boolean);
+	};
+
+	if (!is_u32_type(get<SPIRType>(spec.basetype)))
+		return false;
+
+	switch (spec.opcode)
+	{
+	case OpIAdd:
+	case OpISub:
+	case OpIMul:
+	case OpBitwiseAnd:
+	case OpBitwiseOr:
+	case OpBitwiseXor:
+	case OpLogicalAnd:
+	case OpLogicalOr:
+	case OpShiftLeftLogical:
+	case OpShiftRightLogical:
+	case OpShiftRightArithmetic:
+	case OpLogicalEqual:
+	case OpLogicalNotEqual:
+	case OpIEqual:
+	case OpINotEqual:
+	case OpULessThan:
+	case OpULessThanEqual:
+	case OpUGreaterThan:
+	case OpUGreaterThanEqual:
+	case OpSLessThan:
+	case OpSLessThanEqual:
+	case OpSGreaterThan:
+	case OpSGreaterThanEqual:
+	case OpLogicalNot:
+	case OpNot:
+	case OpSNegate:
+	case OpSelect:
+	case OpUMod:
+	case OpSRem:
+	case OpSMod:
+	case OpUDiv:
+	case OpSDiv:
+		break;
+
+	default:
+		return false;
+	}
+
+	for (auto &arg : spec.arguments)
+	{
+		auto *c = maybe_get<SPIRConstant>(arg);
+		if (!c || c->specialization || !is_u32_type(get<SPIRType>(c->constant_type)))
+			return false;
+	}
+
+	// Leave undefined behavior to the driver.
+	bool is_division = spec.opcode == OpUMod || spec.opcode == OpSRem || spec.opcode == OpSMod ||
+	                   spec.opcode == OpUDiv || spec.opcode == OpSDiv;
+	if (is_division && get<SPIRConstant>(spec.arguments[1]).scalar() == 0)
+		return false;
+
+	// INT_MIN / -1 overflows, and traps on some hosts.
+	bool is_signed_division = spec.opcode == OpSRem || spec.opcode == OpSMod || spec.opcode == OpSDiv;
+	if (is_signed_division && get<SPIRConstant>(spec.arguments[0]).scalar() == 0x80000000u &&
+	    get<SPIRConstant>(spec.arguments[1]).scalar() == 0xffffffffu)
+	{
+		return false;
+	}
+
+	bool is_shift =
+	    spec.opcode == OpShiftLeftLogical || spec.opcode == OpShiftRightLogical || spec.opcode == OpShiftRightArithmetic;
+	if (is_shift && get<SPIRConstant>(spec.arguments[1]).scalar() >= 32)
+		return false;
+
+	return true;
+}
+
+void Compiler::fold_specialization_constants(const SmallVector<SpecializationConstantValue> &values)
+{
+	unordered_map<uint32_t, uint64_t> value_for_constant_id;
+	for (auto &value : values)
+		value_for_constant_id[value.constant_id] = value.value;
+
+	// Constants are declared before use, so a single pass in declaration order sees operands folded first.
+	auto ids = ir.ids_for_constant_or_type;
+	unordered_set<uint32_t> folded_ops;
+	for (auto &id : ids)
+	{
+		if (auto *op = maybe_get<SPIRConstantOp>(id))
+		{
+			if (!spec_constant_op_is_foldable(*op))
+				continue;
+
+			uint32_t value = evaluate_spec_constant_u32(*op);
+			TypeID basetype = op->basetype;
+			ir.ids[id].set_allow_type_rewrite();
+			set<SPIRConstant>(id, basetype, value, false);
+
+			// The ID already has its place in declaration order, don't add it twice.
+			ir.ids_for_constant_or_type.pop_back();
+			folded_ops.insert(id);
+			continue;
+		}
+
+		auto *c = maybe_get<SPIRConstant>(id);
+		if (!c || !c->specialization)
+			continue;
+
+		if (has_decoration(id, DecorationSpecId))
+		{
+			auto itr = value_for_constant_id.find(get_decoration(id, DecorationSpecId));
+			if (itr == end(value_for_constant_id))
+				continue;
+
+			auto &type = get<SPIRType>(c->constant_type);
+			if (type.basetype == SPIRType::Boolean)
+				c->m.c[0].r[0].u32 = itr->second != 0 ? 1u : 0u;
+			else if (type.width == 64)
+				c->m.c[0].r[0].u64 = itr->second;
+			else
+				c->m.c[0].r[0].u32 = uint32_t(itr->second);
+			c->specialization = false;
+			continue;
+		}
+
+		// Composites which are specialization constants because of their elements,
+		// pull in any elements which have been folded.
+		bool folded = true;
+		for (uint32_t col = 0; col < c->m.columns; col++)
+		{
+			if (c->m.id[col])
+			{
+				auto &column = get<SPIRConstant>(c->m.id[col]);
+				if (column.specialization)
+				{
+					folded = false;
+					continue;
+				}
+				c->m.c[col] = column.m.c[0];
+				c->m.id[col] = 0;
+			}
+
+			for (uint32_t row = 0; row < c->m.c[col].vecsize; row++)
+			{
+				if (!c->m.c[col].id[row])
+					continue;
+
+				auto *elem = maybe_get<SPIRConstant>(c->m.c[col].id[row]);
+				if (!elem || elem->specialization)
+				{
+					folded = false;
+					continue;
+				}
+				c->m.c[col].r[row] = elem->m.c[0].r[0];
+				c->m.c[col].id[row] = 0;
+			}
+		}
+
+		for (auto &sub : c->subconstants)
+		{
+			auto *elem = maybe_get<SPIRConstant>(sub);
+			if (!elem || elem->specialization)
+				folded = false;
+		}
+
+		if (folded)
+			c->specialization = false;
+	}
+
+	// Constant operations were not part of the declaration order of constants and variables,
+	// so the folded ones were appended to it. Move each right after the constant declared before it.
+	if (!folded_ops.empty())
+	{
+		unordered_map<uint32_t, SmallVector<ID>> folded_after;
+		uint32_t previous_constant = 0;
+		for (auto &id : ir.ids_for_constant_or_type)
+		{
+			if (folded_ops.count(id))
+				folded_after[previous_constant].push_back(id);
+			else if (ir.ids[id].get_type() == TypeConstant)
+				previous_constant = id;
+		}
+
+		const auto append_folded_after = [&](SmallVector<ID> &order, uint32_t id) {
+			auto itr = folded_after.find(id);
+			if (itr != end(folded_after))
+				order.insert(end(order), begin(itr->second), end(itr->second));
+		};
+
+		SmallVector<ID> order;
+		order.reserve(ir.ids_for_constant_or_variable.size());
+		append_folded_after(order, 0);
+		for (auto &id : ir.ids_for_constant_or_variable)
+		{
+			if (folded_ops.count(id))
+				continue;
+			order.push_back(id);
+			append_folded_after(order, id);
+		}
+		ir.ids_for_constant_or_variable = move(order);
+	}
+
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, SPIRFunction &func) { fold_constant_branches(func); });
+	specialization_constants_folded = true;
+	invalidate_function_analysis();
+}
+
+void Compiler::fold_constant_branches(SPIRFunction &func)
+{
+	const auto for_each_successor = [&](const SPIRBlock &block, const std::function<void(BlockID)> &op) {
+		switch (block.terminator)
+		{
+		case SPIRBlock::Direct:
+			op(block.next_block);
+			break;
+
+		case SPIRBlock::Select:
+			op(block.true_block);
+			op(block.false_block);
+			break;
+
+		case SPIRBlock::MultiSelect:
+			op(block.default_block);
+			for (auto &case_label : block.cases)
+				op(case_label.block);
+			break;
+
+		default:
+			break;
+		}
+	};
+
+	// Counts the branches into the merge block when entering the construct through target.
+	const auto count_branches_to_merge = [&](BlockID target, BlockID merge) -> uint32_t {
+		if (target == merge)
+			return 1;
+
+		uint32_t count = 0;
+		unordered_set<uint32_t> visited = { target };
+		SmallVector<BlockID> work_list = { target };
+		while (!work_list.empty())
+		{
+			auto &block = get<SPIRBlock>(work_list.back());
+			work_list.pop_back();
+			for_each_successor(block, [&](BlockID next) {
+				if (next == merge)
+					count++;
+				else if (visited.insert(next).second)
+					work_list.push_back(next);
+			});
+		}
+		return count;
+	};
+
+	bool changed = false;
+
+	for (auto &block_id : func.blocks)
+	{
+		auto &block = get<SPIRBlock>(block_id);
+		if (block.merge != SPIRBlock::MergeSelection)
+			continue;
+
+		auto *c = maybe_get<SPIRConstant>(block.condition);
+		if (!c || c->specialization)
+			continue;
+
+		BlockID target = 0;
+		if (block.terminator == SPIRBlock::Select)
+			target = c->scalar() ? block.true_block : block.false_block;
+		else if (block.terminator == SPIRBlock::MultiSelect)
+		{
+			target = block.default_block;
+			for (auto &case_label : block.cases)
+				if (case_label.value == c->scalar())
+					target = case_label.block;
+		}
+		else
+			continue;
+
+		if (count_branches_to_merge(target, block.next_block) <= 1)
+		{
+			// If there is only one way to reach the merge block, the construct is not needed at all, and
+			// the merge block can be emitted right after the path taken as a straight chain of blocks.
+			ir.block_meta[block.next_block] &=
+			    ~(ParsedIR::BLOCK_META_SELECTION_MERGE_BIT | ParsedIR::BLOCK_META_MULTISELECT_MERGE_BIT);
+			block.terminator = SPIRBlock::Direct;
+			block.merge = SPIRBlock::MergeNone;
+			block.next_block = target;
+			block.true_block = 0;
+			block.false_block = 0;
+			block.default_block = 0;
+			block.cases.clear();
+		}
+		else if (block.terminator == SPIRBlock::MultiSelect)
+		{
+			// The case breaks out of the switch in more than one place, so keep the construct with only the case taken.
+			// This is emitted as a do { } while (false) block.
+			block.cases.clear();
+			block.default_block = target;
+		}
+		else
+		{
+			// Have to keep the selection construct, but only the path taken needs any code.
+			if (block.true_block == target)
+				block.false_block = block.next_block;
+			else
+				block.true_block = block.next_block;
+		}
+
+		changed = true;
+	}
+
+	if (!changed)
+		return;
+
+	// Drop the blocks which are no longer reachable, so they do not take part in any analysis.
+	unordered_set<uint32_t> reachable;
+	SmallVector<BlockID> work_list;
+	const auto add_block = [&](BlockID id) {
+		if (id && reachable.insert(id).second)
+			work_list.push_back(id);
+	};
 
-	combined_image_samplers.clear();
-	CombinedImageSamplerHandler handler(*this);
-	traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), handler);
-}
+	add_block(func.entry_block);
+	while (!work_list.empty())
+	{
+		auto &block = get<SPIRBlock>(work_list.back());
+		work_list.pop_back();
 
-SmallVector<SpecializationConstant> Compiler::get_specialization_constants() const
-{
-	SmallVector<SpecializationConstant> spec_consts;
-	ir.for_each_typed_id<SPIRConstant>([&](uint32_t, const SPIRConstant &c) {
-		if (c.specialization && has_decoration(c.self, DecorationSpecId))
-			spec_consts.push_back({ c.self, get_decoration(c.self, DecorationSpecId) });
-	});
-	return spec_consts;
-}
+		for_each_successor(block, add_block);
+		if (block.merge == SPIRBlock::MergeSelection)
+			add_block(block.next_block);
+		else if (block.merge == SPIRBlock::MergeLoop)
+		{
+			add_block(block.merge_block);
+			add_block(block.continue_block);
+		}
+	}
 
-SPIRConstant &Compiler::get_constant(ConstantID id)
-{
-	return get<SPIRConstant>(id);
-}
+	auto &blocks = func.blocks.get_mutable();
+	auto itr = remove_if(begin(blocks), end(blocks), [&](BlockID id) { return reachable.count(id) == 0; });
+	blocks.erase(itr, end(blocks));
 
-const SPIRConstant &Compiler::get_constant(ConstantID id) const
-{
-	return get<SPIRConstant>(id);
+	for (auto &block_id : func.blocks)
+	{
+		auto &phis = get<SPIRBlock>(block_id).phi_variables;
+		auto phi_itr = remove_if(begin(phis), end(phis),
+		                         [&](const SPIRBlock::Phi &phi) { return reachable.count(phi.parent) == 0; });
+		phis.erase(phi_itr, end(phis));
+	}
 }
 
-static bool exists_unaccessed_path_to_return(const CFG &cfg, uint32_t block, const unordered_set<uint32_t> &blocks,
+template <typename BlockSet>
+static bool exists_unaccessed_path_to_return(const CFG &cfg, uint32_t block, const BlockSet &blocks,
                                              unordered_set<uint32_t> &visit_cache)
 {
 	// This block accesses the variable.
@@ -2860,9 +4708,9 @@ static bool exists_unaccessed_path_to_return(const CFG &cfg, uint32_t block, con
 	return false;
 }
 
-void Compiler::analyze_parameter_preservation(
-    SPIRFunction &entry, const CFG &cfg, const unordered_map<uint32_t, unordered_set<uint32_t>> &variable_to_blocks,
-    const unordered_map<uint32_t, unordered_set<uint32_t>> &complete_write_blocks)
+void Compiler::analyze_parameter_preservation(SPIRFunction &entry, const CFG &cfg,
+                                              const ScratchIDSetMap &variable_to_blocks,
+                                              const ScratchIDSetMap &complete_write_blocks)
 {
 	for (auto &arg : entry.arguments)
 	{
@@ -2919,9 +4767,17 @@ void Compiler::analyze_parameter_preservation(
 }
 
 Compiler::AnalyzeVariableScopeAccessHandler::AnalyzeVariableScopeAccessHandler(Compiler &compiler_,
-                                                                               SPIRFunction &entry_)
+                                                                               SPIRFunction &entry_,
+                                                                               MemoryArena &arena)
     : compiler(compiler_)
     , entry(entry_)
+    , accessed_variables_to_block(ScratchIDSetMap::allocator_type(&arena))
+    , accessed_temporaries_to_block(ScratchIDSetMap::allocator_type(&arena))
+    , result_id_to_type(ScratchIDMap::allocator_type(&arena))
+    , complete_write_variables_to_block(ScratchIDSetMap::allocator_type(&arena))
+    , partial_write_variables_to_block(ScratchIDSetMap::allocator_type(&arena))
+    , access_chain_expressions(ScratchIDSet::allocator_type(&arena))
+    , access_chain_children(ScratchIDSetMap::allocator_type(&arena))
 {
 }
 
@@ -3077,13 +4933,8 @@ bool Compiler::AnalyzeVariableScopeAccessHandler::handle(spv::Op op, const uint3
 		// This means we need complex loop workarounds, and we must detect this via CFG analysis.
 		notify_variable_access(args[1], current_block->self);
 
-		// The result of an access chain is a fixed expression and is not really considered a temporary.
-		auto &e = compiler.set<SPIRExpression>(args[1], "", args[0], true);
-		auto *backing_variable = compiler.maybe_get_backing_variable(ptr);
-		e.loaded_from = backing_variable ? VariableID(backing_variable->self) : VariableID(0);
-
-		// Other backends might use SPIRAccessChain for this later.
-		compiler.ir.ids[args[1]].set_allow_type_rewrite();
+		if (!access_chains_registered)
+			compiler.register_access_chain_expression(args[0], args[1], ptr);
 		access_chain_expressions.insert(args[1]);
 		break;
 	}
@@ -3280,6 +5131,17 @@ bool Compiler::AnalyzeVariableScopeAccessHandler::handle(spv::Op op, const uint3
 	return true;
 }
 
+void Compiler::register_access_chain_expression(uint32_t result_type, uint32_t id, uint32_t ptr)
+{
+	// The result of an access chain is a fixed expression and is not really considered a temporary.
+	auto &e = set<SPIRExpression>(id, "", result_type, true);
+	auto *backing_variable = maybe_get_backing_variable(ptr);
+	e.loaded_from = backing_variable ? VariableID(backing_variable->self) : VariableID(0);
+
+	// Other backends might use SPIRAccessChain for this later.
+	ir.ids[id].set_allow_type_rewrite();
+}
+
 Compiler::StaticExpressionAccessHandler::StaticExpressionAccessHandler(Compiler &compiler_, uint32_t variable_id_)
     : compiler(compiler_)
     , variable_id(variable_id_)
@@ -3328,7 +5190,7 @@ bool Compiler::StaticExpressionAccessHandler::handle(spv::Op op, const uint32_t
 	return true;
 }
 
-void Compiler::find_function_local_luts(SPIRFunction &entry, const AnalyzeVariableScopeAccessHandler &handler,
+void Compiler::find_function_local_luts(SPIRFunction &entry, AnalyzeVariableScopeAccessHandler &handler,
                                         bool single_function)
 {
 	auto &cfg = *function_cfgs.find(entry.self)->second;
@@ -3413,7 +5275,7 @@ void Compiler::find_function_local_luts(SPIRFunction &entry, const AnalyzeVariab
 			static_constant_expression = static_expression_handler.static_expression;
 		}
 
-		get<SPIRConstant>(static_constant_expression).is_used_as_lut = true;
+		handler.lut_constants.push_back(static_constant_expression);
 		var.static_expression = static_constant_expression;
 		var.statically_assigned = true;
 		var.remapped_variable = true;
@@ -3481,7 +5343,7 @@ void Compiler::analyze_variable_scope(SPIRFunction &entry, AnalyzeVariableScopeA
 				// The continue block is dominated by the inner part of the loop, which does not make sense in high-level
 				// language output because it will be declared before the body,
 				// so we will have to lift the dominator up to the relevant loop header instead.
-				builder.add_block(ir.continue_block_to_loop_header[block]);
+				builder.add_block(get_continue_block_loop_header(block));
 
 				// Arrays or structs cannot be loop variables.
 				if (type.vecsize == 1 && type.columns == 1 && type.basetype != SPIRType::Struct && type.array.empty())
@@ -3573,7 +5435,7 @@ void Compiler::analyze_variable_scope(SPIRFunction &entry, AnalyzeVariableScopeA
 				// The risk here is that inner loop can dominate the continue block.
 				// Any temporary we access in the continue block must be declared before the loop.
 				// This is moot for complex loops however.
-				auto &loop_header_block = get<SPIRBlock>(ir.continue_block_to_loop_header[block]);
+				auto &loop_header_block = get<SPIRBlock>(get_continue_block_loop_header(block));
 				assert(loop_header_block.merge == SPIRBlock::MergeLoop);
 				builder.add_block(loop_header_block.self);
 				used_in_header_hoisted_continue_block = true;
@@ -3623,8 +5485,7 @@ void Compiler::analyze_variable_scope(SPIRFunction &entry, AnalyzeVariableScopeA
 					// This should be very rare, but if we try to declare a temporary inside a loop,
 					// and that temporary is used outside the loop as well (spirv-opt inliner likes this)
 					// we should actually emit the temporary outside the loop.
-					hoisted_temporaries.insert(var.first);
-					forced_temporaries.insert(var.first);
+					handler.hoisted_temporaries.push_back(var.first);
 
 					auto &block_temporaries = get<SPIRBlock>(dominating_block).declare_temporary;
 					block_temporaries.emplace_back(handler.result_id_to_type[var.first], var.first);
@@ -3643,8 +5504,6 @@ void Compiler::analyze_variable_scope(SPIRFunction &entry, AnalyzeVariableScopeA
 		}
 	}
 
-	unordered_set<uint32_t> seen_blocks;
-
 	// Now, try to analyze whether or not these variables are actually loop variables.
 	for (auto &loop_variable : potential_loop_variables)
 	{
@@ -3718,12 +5577,12 @@ void Compiler::analyze_variable_scope(SPIRFunction &entry, AnalyzeVariableScopeA
 		// The second condition we need to meet is that no access after the loop
 		// merge can occur. Walk the CFG to see if we find anything.
 
-		seen_blocks.clear();
-		cfg.walk_from(seen_blocks, header_block.merge_block, [&](uint32_t walk_block) -> bool {
+		cfg.walk_from(header_block.merge_block, [&](uint32_t walk_block) -> bool {
 			// We found a block which accesses the variable outside the loop.
 			if (blocks.find(walk_block) != end(blocks))
 				static_loop_init = false;
-			return true;
+			// No need to keep walking once we know.
+			return static_loop_init;
 		});
 
 		if (!static_loop_init)
@@ -3853,7 +5712,7 @@ void Compiler::ActiveBuiltinHandler::handle_builtin(const SPIRType &type, BuiltI
 		uint32_t array_size = type.array[0];
 		if (array_size == 0)
 			SPIRV_CROSS_THROW("Array size for ClipDistance must not be unsized.");
-		compiler.clip_distance_count = array_size;
+		summary.clip_distance_count = array_size;
 	}
 	else if (builtin == BuiltInCullDistance)
 	{
@@ -3862,12 +5721,12 @@ void Compiler::ActiveBuiltinHandler::handle_builtin(const SPIRType &type, BuiltI
 		uint32_t array_size = type.array[0];
 		if (array_size == 0)
 			SPIRV_CROSS_THROW("Array size for CullDistance must not be unsized.");
-		compiler.cull_distance_count = array_size;
+		summary.cull_distance_count = array_size;
 	}
 	else if (builtin == BuiltInPosition)
 	{
 		if (decoration_flags.get(DecorationInvariant))
-			compiler.position_invariant = true;
+			summary.position_invariant = true;
 	}
 }
 
@@ -3885,7 +5744,7 @@ void Compiler::ActiveBuiltinHandler::add_if_builtin(uint32_t id, bool allow_bloc
 		auto &type = compiler.get<SPIRType>(var->basetype);
 		auto &decorations = m->decoration;
 		auto &flags = type.storage == StorageClassInput ?
-		              compiler.active_input_builtins : compiler.active_output_builtins;
+		              summary.input_builtins : summary.output_builtins;
 		if (decorations.builtin)
 		{
 			flags.set(decorations.builtin_type);
@@ -3997,7 +5856,7 @@ bool Compiler::ActiveBuiltinHandler::handle(spv::Op opcode, const uint32_t *args
 		auto *type = &compiler.get_variable_data_type(*var);
 
 		auto &flags =
-		    var->storage == StorageClassInput ? compiler.active_input_builtins : compiler.active_output_builtins;
+		    var->storage == StorageClassInput ? summary.input_builtins : summary.output_builtins;
 
 		uint32_t count = length - 3;
 		args += 3;
@@ -4020,9 +5879,10 @@ bool Compiler::ActiveBuiltinHandler::handle(spv::Op opcode, const uint32_t *args
 			{
 				uint32_t index = compiler.get<SPIRConstant>(args[i]).scalar();
 
-				if (index < uint32_t(compiler.ir.meta[type->self].members.size()))
+				auto *type_meta = compiler.ir.find_meta(type->self);
+				if (type_meta && index < uint32_t(type_meta->members.size()))
 				{
-					auto &decorations = compiler.ir.meta[type->self].members[index];
+					auto &decorations = type_meta->members[index];
 					if (decorations.builtin)
 					{
 						flags.set(decorations.builtin_type);
@@ -4049,14 +5909,36 @@ bool Compiler::ActiveBuiltinHandler::handle(spv::Op opcode, const uint32_t *args
 	return true;
 }
 
-void Compiler::update_active_builtins()
+void Compiler::reset_active_builtins()
 {
 	active_input_builtins.reset();
 	active_output_builtins.reset();
 	cull_distance_count = 0;
 	clip_distance_count = 0;
-	ActiveBuiltinHandler handler(*this);
-	traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), handler);
+}
+
+void Compiler::merge_active_builtins(const FunctionSummary &summary)
+{
+	active_input_builtins.merge_or(summary.input_builtins);
+	active_output_builtins.merge_or(summary.output_builtins);
+	clip_distance_count = max(clip_distance_count, summary.clip_distance_count);
+	cull_distance_count = max(cull_distance_count, summary.cull_distance_count);
+	if (summary.position_invariant)
+		position_invariant = true;
+}
+
+void Compiler::update_active_builtins()
+{
+	function_summaries.clear();
+	reset_active_builtins();
+	merge_active_builtins(get_function_summary(ir.default_entry_point));
+	add_initialized_output_builtins();
+}
+
+void Compiler::add_initialized_output_builtins()
+{
+	FunctionSummary summary;
+	ActiveBuiltinHandler handler(*this, summary);
 
 	ir.for_each_typed_id<SPIRVariable>([&](uint32_t, const SPIRVariable &var) {
 		if (var.storage != StorageClassOutput)
@@ -4068,6 +5950,8 @@ void Compiler::update_active_builtins()
 		if (var.initializer != ID(0))
 			handler.add_if_builtin_or_block(var.self);
 	});
+
+	merge_active_builtins(summary);
 }
 
 // Returns whether this shader uses a builtin of the storage class
@@ -4089,22 +5973,69 @@ bool Compiler::has_active_builtin(BuiltIn builtin, StorageClass storage)
 	return flags->get(builtin);
 }
 
-void Compiler::analyze_image_and_sampler_usage()
+void Compiler::analyze_active_usage(OpcodeHandler *backend_handler)
 {
-	CombinedImageSamplerDrefHandler dref_handler(*this);
-	traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), dref_handler);
+	auto &entry = get<SPIRFunction>(ir.default_entry_point);
+	bool interlocked = get_execution_model() == ExecutionModelFragment &&
+	                   (get_entry_point().flags.get(ExecutionModePixelInterlockOrderedEXT) ||
+	                    get_entry_point().flags.get(ExecutionModePixelInterlockUnorderedEXT) ||
+	                    get_entry_point().flags.get(ExecutionModeSampleInterlockOrderedEXT) ||
+	                    get_entry_point().flags.get(ExecutionModeSampleInterlockUnorderedEXT));
 
-	CombinedImageSamplerUsageHandler handler(*this, dref_handler.dref_combined_samplers);
-	traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), handler);
+	// Builtins and Dref samplers come straight from the function summaries.
+	function_summaries.clear();
+	auto &summary = get_function_summary(ir.default_entry_point);
+	reset_active_builtins();
+	merge_active_builtins(summary);
+	add_initialized_output_builtins();
+
+	// First traversal covers everything else which does not depend on other analysis results.
+	InterlockedResourceAccessPrepassHandler prepass_handler(*this, ir.default_entry_point);
+	if (backend_handler || interlocked)
+	{
+		OpcodeHandlerGroup group;
+		if (backend_handler)
+			group.add(*backend_handler, true);
+		if (interlocked)
+			group.add(prepass_handler);
+		traverse_all_reachable_opcodes(entry, group);
+	}
+
+	// Second traversal consumes the results of the first one.
+	CombinedImageSamplerUsageHandler usage_handler(*this, summary.dref_combined_samplers);
+	InterlockedResourceAccessHandler interlock_handler(*this, ir.default_entry_point);
+	{
+		OpcodeHandlerGroup group;
+		group.add(usage_handler);
+
+		if (interlocked)
+		{
+			interlock_handler.interlock_function_id = prepass_handler.interlock_function_id;
+			interlock_handler.split_function_case = prepass_handler.split_function_case;
+			interlock_handler.control_flow_interlock = prepass_handler.control_flow_interlock;
+			interlock_handler.use_critical_section =
+			    !interlock_handler.split_function_case && !interlock_handler.control_flow_interlock;
+			group.add(interlock_handler);
+		}
+
+		traverse_all_reachable_opcodes(entry, group);
+	}
 
-	// Need to run this traversal twice. First time, we propagate any comparison sampler usage from leaf functions
-	// down to main().
+	// For GLSL. If we hit any of these cases, we have to fall back to conservative approach.
+	if (interlocked)
+	{
+		interlocked_is_complex = !interlock_handler.use_critical_section ||
+		                         interlock_handler.interlock_function_id != ir.default_entry_point;
+	}
+
+	// Need to run the image usage traversal twice. First time, we propagate any comparison sampler usage
+	// from leaf functions down to main().
 	// In the second pass, we can propagate up forced depth state coming from main() up into leaf functions.
-	handler.dependency_hierarchy.clear();
-	traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), handler);
+	usage_handler.dependency_hierarchy.clear();
+	traverse_all_reachable_opcodes(entry, usage_handler);
 
-	comparison_ids = move(handler.comparison_ids);
-	need_subpass_input = handler.need_subpass_input;
+	comparison_ids = move(usage_handler.comparison_ids);
+	need_subpass_input = usage_handler.need_subpass_input;
 
 	// Forward information from separate images and samplers into combined image samplers.
 	for (auto &combined : combined_image_samplers)
@@ -4151,20 +6082,291 @@ const CFG &Compiler::get_cfg_for_function(uint32_t id) const
 	return *cfg_itr->second;
 }
 
+uint64_t Compiler::get_timestamp_ns()
+{
+	auto now = chrono::steady_clock::now().time_since_epoch();
+	return uint64_t(chrono::duration_cast<chrono::nanoseconds>(now).count());
+}
+
+void Compiler::begin_phase_timings()
+{
+	phase_timings = {};
+	phase_timestamp = get_timestamp_ns();
+	for (auto &count : recompile_reason_counts)
+		count = 0;
+}
+
+Compiler::MemoryUsage Compiler::get_memory_usage() const
+{
+	MemoryUsage usage;
+	usage.ir = ir.get_memory_usage();
+
+	usage.cfgs = get_heap_size(function_cfgs);
+	for (auto &cfg : function_cfgs)
+		if (cfg.second)
+			usage.cfgs += sizeof(CFG) + cfg.second->get_memory_usage();
+
+	usage.analysis = scratch_arena.get_reserved_size() + get_heap_size(function_summaries) +
+	                 get_heap_size(reachable_functions_cache);
+	for (auto &summary : function_summaries)
+		usage.analysis += get_heap_size(summary.second.interface_variables) +
+		                  get_heap_size(summary.second.dref_combined_samplers);
+	return usage;
+}
+
+void Compiler::shrink_to_fit()
+{
+	// The analysis results are kept, only the CFGs and pure caches are released.
+	// The next compile() rebuilds the CFGs without running the analysis again.
+	function_cfgs.clear();
+	reachable_functions_cache.clear();
+	function_summaries.clear();
+	scratch_arena.release();
+	ir.shrink_to_fit();
+}
+
+void Compiler::set_compile_budget(const CompileBudget &budget)
+{
+	compile_budget = budget;
+}
+
+Compiler::CompileBudgetScope::CompileBudgetScope(Compiler &compiler_)
+    : compiler(compiler_)
+    , outermost(compiler_.compile_budget_start == 0)
+{
+	if (outermost)
+		compiler.compile_budget_start = get_timestamp_ns();
+}
+
+Compiler::CompileBudgetScope::~CompileBudgetScope()
+{
+	if (outermost)
+		compiler.compile_budget_start = 0;
+}
+
+void Compiler::check_compile_deadline() const
+{
+	if (compile_budget.cancel && compile_budget.cancel->load(memory_order_relaxed))
+		SPIRV_CROSS_THROW_BUDGET_EXCEEDED("Compilation was cancelled.");
+
+	if (compile_budget.max_time_us &&
+	    get_timestamp_ns() - compile_budget_start > compile_budget.max_time_us * 1000ull)
+	{
+		SPIRV_CROSS_THROW_BUDGET_EXCEEDED("Compilation exceeded its time budget.");
+	}
+}
+
+void Compiler::check_output_budget(size_t output_size) const
+{
+	if (compile_budget_start && compile_budget.max_output_size && output_size > compile_budget.max_output_size)
+		SPIRV_CROSS_THROW_BUDGET_EXCEEDED("Compilation exceeded its output size budget.");
+}
+
+void Compiler::check_expression_budget(const SPIRExpression &expr) const
+{
+	if (!compile_budget_start)
+		return;
+
+	if (compile_budget.max_expression_size && expr.expression.size() > compile_budget.max_expression_size)
+		SPIRV_CROSS_THROW_BUDGET_EXCEEDED("Compilation exceeded its expression size budget.");
+
+	if (compile_budget.max_forwarding_depth &&
+	    expr.expression_dependencies.size() > compile_budget.max_forwarding_depth)
+	{
+		SPIRV_CROSS_THROW_BUDGET_EXCEEDED("Compilation exceeded its forwarding depth budget.");
+	}
+}
+
+void Compiler::begin_emission_timings()
+{
+	uint64_t now = get_timestamp_ns();
+	phase_timings.analysis = double(now - phase_timestamp) * 1e-9 - phase_timings.cfg;
+	phase_timestamp = now;
+}
+
+void Compiler::end_pass_timing()
+{
+	uint64_t now = get_timestamp_ns();
+	double pass_time = double(now - phase_timestamp) * 1e-9;
+	phase_timings.passes.push_back(pass_time);
+	phase_timings.emission += pass_time;
+	phase_timestamp = now;
+}
+
+uint64_t Compiler::hash_function_analysis_inputs() const
+{
+	Hasher hasher;
+	hasher.u32(ir.default_entry_point);
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t id, const SPIRVariable &var) {
+		if (var.storage != StorageClassFunction)
+			return;
+		hasher.u32(id);
+		hasher.bitset(get_decoration_bitset(id));
+	});
+	return hasher.get();
+}
+
+void Compiler::invalidate_function_analysis()
+{
+	function_analysis_valid = false;
+	reachable_functions_cache.clear();
+	function_summaries.clear();
+}
+
+void Compiler::reset_function_analysis_results()
+{
+	ir.for_each_typed_id<SPIRBlock>([&](uint32_t, SPIRBlock &block) {
+		block.declare_temporary.clear();
+		block.potential_declare_temporary.clear();
+		block.dominated_variables.clear();
+		block.loop_variables.clear();
+		block.loop_dominator = 0;
+		block.complex_continue = false;
+		block.disable_block_optimization = false;
+		block.need_ladder_break = false;
+	});
+
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t, SPIRVariable &var) {
+		if (var.storage != StorageClassFunction)
+			return;
+		var.dominator = 0;
+		var.loop_variable = false;
+		var.loop_variable_enable = false;
+		var.statically_assigned = false;
+		var.static_expression = 0;
+		var.remapped_variable = false;
+	});
+
+	ir.for_each_typed_id<SPIRConstant>([&](uint32_t, SPIRConstant &c) { c.is_used_as_lut = false; });
+
+	for (auto id : hoisted_temporaries)
+		forced_temporaries.erase(id);
+	hoisted_temporaries.clear();
+}
+
+// Calls func(index) for every function index, on the pool if there is one.
+// Exceptions cannot escape the worker threads, so the first one is rethrown on the calling thread.
+template <typename Func>
+static void run_per_function(ThreadPool *pool, size_t count, const Func &func)
+{
+	if (!pool)
+	{
+		for (size_t i = 0; i < count; i++)
+			func(i);
+		return;
+	}
+
+#ifndef SPIRV_CROSS_EXCEPTIONS_TO_ASSERTIONS
+	SmallVector<exception_ptr> errors(count);
+	pool->parallel_for(count, [&](size_t i) {
+		try
+		{
+			func(i);
+		}
+		catch (...)
+		{
+			errors[i] = current_exception();
+		}
+	});
+
+	for (auto &error : errors)
+		if (error)
+			rethrow_exception(error);
+#else
+	pool->parallel_for(count, func);
+#endif
+}
+
+void Compiler::build_function_control_flow_graphs(const SmallVector<FunctionID> &functions, ThreadPool *pool)
+{
+	// Insert all entries up front, so that the map is not modified while the CFGs are built.
+	uint64_t cfg_start = get_timestamp_ns();
+	function_cfgs.clear();
+	SmallVector<unique_ptr<CFG> *> cfgs;
+	cfgs.reserve(functions.size());
+	for (auto func : functions)
+		cfgs.push_back(&function_cfgs[func]);
+	run_per_function(pool, functions.size(),
+	                 [&](size_t i) { cfgs[i]->reset(new CFG(*this, get<SPIRFunction>(functions[i]))); });
+	phase_timings.cfg = double(get_timestamp_ns() - cfg_start) * 1e-9;
+}
+
 void Compiler::build_function_control_flow_graphs_and_analyze()
 {
-	CFGBuilder handler(*this);
-	handler.function_cfgs[ir.default_entry_point].reset(new CFG(*this, get<SPIRFunction>(ir.default_entry_point)));
-	traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), handler);
-	function_cfgs = move(handler.function_cfgs);
-	bool single_function = function_cfgs.size() <= 1;
+	uint64_t analysis_hash = hash_function_analysis_inputs();
+	if (function_analysis_valid && analysis_hash == function_analysis_hash)
+	{
+		// shrink_to_fit() releases the CFGs, but keeps the analysis results.
+		if (function_cfgs.empty())
+		{
+			auto &functions = get_reachable_functions(ir.default_entry_point);
+			build_function_control_flow_graphs(functions, functions.size() > 1 ? analysis_thread_pool : nullptr);
+		}
+		return;
+	}
+
+	SPIRV_CROSS_TRACE_SCOPE(trace_callback, TraceEventAnalyze, 0);
+
+	reset_function_analysis_results();
+	auto &functions = get_reachable_functions(ir.default_entry_point);
+	ThreadPool *pool = functions.size() > 1 ? analysis_thread_pool : nullptr;
+	build_function_control_flow_graphs(functions, pool);
+	bool single_function = functions.size() <= 1;
 
-	for (auto &f : function_cfgs)
+	// Creating the access chain expressions allocates IDs from the shared object pools,
+	// so when analyzing in parallel, do all of them before any function is analyzed.
+	if (pool)
 	{
-		auto &func = get<SPIRFunction>(f.first);
-		AnalyzeVariableScopeAccessHandler scope_handler(*this, func);
+		for (auto func : functions)
+		{
+			for (auto block : get<SPIRFunction>(func).blocks)
+			{
+				for (auto &i : get<SPIRBlock>(block).ops)
+				{
+					auto op = static_cast<Op>(i.op);
+					if ((op == OpAccessChain || op == OpInBoundsAccessChain || op == OpPtrAccessChain) && i.length >= 3)
+					{
+						auto ops = stream(i);
+						register_access_chain_expression(ops[0], ops[1], ops[2]);
+					}
+				}
+			}
+		}
+	}
+
+	SmallVector<SmallVector<uint32_t>> hoisted(functions.size());
+	SmallVector<SmallVector<uint32_t>> luts(functions.size());
+	run_per_function(pool, functions.size(), [&](size_t i) {
+		auto &func = get<SPIRFunction>(functions[i]);
+
+		// On the calling thread, analysis state is only needed for one function at a time,
+		// so recycle the same memory. Workers need their own.
+		unique_ptr<MemoryArena> worker_arena;
+		if (pool)
+			worker_arena.reset(new MemoryArena);
+		else
+			scratch_arena.reset();
+
+		AnalyzeVariableScopeAccessHandler scope_handler(*this, func, pool ? *worker_arena : scratch_arena);
+		scope_handler.access_chains_registered = pool != nullptr;
 		analyze_variable_scope(func, scope_handler);
 		find_function_local_luts(func, scope_handler, single_function);
+		hoisted[i] = move(scope_handler.hoisted_temporaries);
+		luts[i] = move(scope_handler.lut_constants);
+	});
+
+	for (size_t i = 0; i < functions.size(); i++)
+	{
+		for (auto id : hoisted[i])
+		{
+			hoisted_temporaries.insert(id);
+			forced_temporaries.insert(id);
+		}
+
+		for (auto id : luts[i])
+			get<SPIRConstant>(id).is_used_as_lut = true;
+
+		auto &func = get<SPIRFunction>(functions[i]);
 
 		// Check if we can actually use the loop variables we found in analyze_variable_scope.
 		// To use multiple initializers, we need the same type and qualifiers.
@@ -4195,27 +6397,9 @@ void Compiler::build_function_control_flow_graphs_and_analyze()
 			}
 		}
 	}
-}
-
-Compiler::CFGBuilder::CFGBuilder(Compiler &compiler_)
-    : compiler(compiler_)
-{
-}
-
-bool Compiler::CFGBuilder::handle(spv::Op, const uint32_t *, uint32_t)
-{
-	return true;
-}
 
-bool Compiler::CFGBuilder::follow_function_call(const SPIRFunction &func)
-{
-	if (function_cfgs.find(func.self) == end(function_cfgs))
-	{
-		function_cfgs[func.self].reset(new CFG(compiler, func));
-		return true;
-	}
-	else
-		return false;
+	function_analysis_hash = analysis_hash;
+	function_analysis_valid = true;
 }
 
 void Compiler::CombinedImageSamplerUsageHandler::add_dependency(uint32_t dst, uint32_t src)
@@ -4565,9 +6749,28 @@ bool Compiler::type_is_opaque_value(const SPIRType &type) const
 }
 
 // Make these member functions so we can easily break on any force_recompile events.
-void Compiler::force_recompile()
+void Compiler::force_recompile(RecompileReason reason)
 {
 	is_force_recompile = true;
+	recompile_reason_counts[reason]++;
+	SPIRV_CROSS_TRACE_INSTANT(trace_callback, TraceEventForceRecompile, reason);
+}
+
+void Compiler::set_trace_callback(TraceCallback callback)
+{
+	trace_callback = move(callback);
+}
+
+void Compiler::set_analysis_thread_pool(ThreadPool *pool)
+{
+	analysis_thread_pool = pool;
+}
+
+uint32_t Compiler::get_recompile_reason_count(RecompileReason reason) const
+{
+	if (reason >= RecompileReasonCount)
+		SPIRV_CROSS_THROW("Invalid recompile reason.");
+	return recompile_reason_counts[reason];
 }
 
 bool Compiler::is_forcing_recompilation() const
@@ -4605,7 +6808,7 @@ bool Compiler::PhysicalStorageBufferPointerHandler::handle(Op op, const uint32_t
 void Compiler::analyze_non_block_pointer_types()
 {
 	PhysicalStorageBufferPointerHandler handler(*this);
-	traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), handler);
+	traverse_reachable_functions_once(get<SPIRFunction>(ir.default_entry_point), handler);
 	physical_storage_non_block_pointer_types.reserve(handler.types.size());
 	for (auto type : handler.types)
 		physical_storage_non_block_pointer_types.push_back(type);
@@ -4897,31 +7100,6 @@ bool Compiler::InterlockedResourceAccessHandler::handle(Op opcode, const uint32_
 	return true;
 }
 
-void Compiler::analyze_interlocked_resource_usage()
-{
-	if (get_execution_model() == ExecutionModelFragment &&
-	    (get_entry_point().flags.get(ExecutionModePixelInterlockOrderedEXT) ||
-	     get_entry_point().flags.get(ExecutionModePixelInterlockUnorderedEXT) ||
-	     get_entry_point().flags.get(ExecutionModeSampleInterlockOrderedEXT) ||
-	     get_entry_point().flags.get(ExecutionModeSampleInterlockUnorderedEXT)))
-	{
-		InterlockedResourceAccessPrepassHandler prepass_handler(*this, ir.default_entry_point);
-		traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), prepass_handler);
-
-		InterlockedResourceAccessHandler handler(*this, ir.default_entry_point);
-		handler.interlock_function_id = prepass_handler.interlock_function_id;
-		handler.split_function_case = prepass_handler.split_function_case;
-		handler.control_flow_interlock = prepass_handler.control_flow_interlock;
-		handler.use_critical_section = !handler.split_function_case && !handler.control_flow_interlock;
-
-		traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), handler);
-
-		// For GLSL. If we hit any of these cases, we have to fall back to conservative approach.
-		interlocked_is_complex =
-		    !handler.use_critical_section || handler.interlock_function_id != ir.default_entry_point;
-	}
-}
-
 bool Compiler::type_is_array_of_pointers(const SPIRType &type) const
 {
 	if (!type.pointer)
@@ -4950,3 +7128,168 @@ void Compiler::add_loop_level()
 {
 	current_loop_level++;
 }
+
+static void hash_decoration(Hasher &hasher, const Meta::Decoration &dec)
+{
+	hasher.string(dec.alias);
+	hasher.string(dec.qualified_alias);
+	hasher.string(dec.hlsl_semantic);
+	hasher.bitset(dec.decoration_flags);
+	hasher.u32(dec.builtin_type);
+	hasher.u32(dec.location);
+	hasher.u32(dec.component);
+	hasher.u32(dec.set);
+	hasher.u32(dec.binding);
+	hasher.u32(dec.offset);
+	hasher.u32(dec.xfb_buffer);
+	hasher.u32(dec.xfb_stride);
+	hasher.u32(dec.stream);
+	hasher.u32(dec.array_stride);
+	hasher.u32(dec.matrix_stride);
+	hasher.u32(dec.input_attachment);
+	hasher.u32(dec.spec_id);
+	hasher.u32(dec.index);
+	hasher.u32(dec.fp_rounding_mode);
+	hasher.u32(dec.builtin);
+	hasher.bitset(dec.extended.flags);
+	dec.extended.flags.for_each_bit([&](uint32_t bit) { hasher.u32(dec.extended.values[bit]); });
+}
+
+void Compiler::hash_compile_state(Hasher &hasher) const
+{
+	hasher.u32(uint32_t(ir.spirv.size()));
+	for (auto &w : ir.spirv)
+		hasher.u32(w);
+
+	// The ID bound can grow after parsing, e.g. through build_dummy_sampler_for_combined_images().
+	uint32_t bound = uint32_t(ir.ids.size());
+	hasher.u32(bound);
+	hasher.u32(ir.entry_points_filtered);
+
+	for (uint32_t i = 0; i < bound; i++)
+	{
+		auto &id = ir.ids[i];
+		hasher.u32(id.get_type());
+
+		if (id.get_type() == TypeConstant)
+		{
+			// Specialization constants can be modified in-place through get_constant().
+			auto &c = id.get<SPIRConstant>();
+			hasher.u32(c.specialization);
+			hasher.u32(c.m.columns);
+			for (uint32_t col = 0; col < c.m.columns; col++)
+			{
+				hasher.u32(c.m.id[col]);
+				hasher.u32(c.m.c[col].vecsize);
+				for (uint32_t row = 0; row < c.m.c[col].vecsize; row++)
+				{
+					hasher.u32(c.m.c[col].id[row]);
+					hasher.u64(c.m.c[col].r[row].u64);
+				}
+			}
+			hasher.u32(uint32_t(c.subconstants.size()));
+			for (auto &sub : c.subconstants)
+				hasher.u32(sub);
+		}
+		else if (id.get_type() == TypeVariable)
+		{
+			auto &var = id.get<SPIRVariable>();
+			hasher.u32(var.basetype);
+			hasher.u32(var.remapped_variable);
+			hasher.u32(var.remapped_components);
+		}
+
+		auto *m_ptr = ir.find_meta(i);
+		if (m_ptr)
+		{
+			auto &m = *m_ptr;
+			hasher.u32(1);
+			hash_decoration(hasher, m.decoration);
+			hasher.u32(uint32_t(m.members.size()));
+			for (auto &member : m.members)
+				hash_decoration(hasher, member);
+			hasher.u32(m.hlsl_is_magic_counter_buffer);
+			hasher.u32(m.hlsl_magic_counter_buffer);
+		}
+		else
+			hasher.u32(0);
+
+		auto ep_itr = ir.entry_points.find(i);
+		if (ep_itr != end(ir.entry_points))
+		{
+			auto &ep = ep_itr->second;
+			hasher.u32(1);
+			hasher.string(ep.name);
+			hasher.string(ep.orig_name);
+			hasher.u32(ep.model);
+			hasher.bitset(ep.flags);
+			hasher.u32(ep.workgroup_size.x);
+			hasher.u32(ep.workgroup_size.y);
+			hasher.u32(ep.workgroup_size.z);
+			hasher.u32(ep.workgroup_size.constant);
+			hasher.u32(ep.invocations);
+			hasher.u32(ep.output_vertices);
+			hasher.u32(ep.geometry_passthrough);
+		}
+		else
+			hasher.u32(0);
+	}
+
+	hasher.u32(ir.default_entry_point);
+
+	hasher.u32(uint32_t(combined_image_samplers.size()));
+	for (auto &combined : combined_image_samplers)
+	{
+		hasher.u32(combined.combined_id);
+		hasher.u32(combined.image_id);
+		hasher.u32(combined.sampler_id);
+	}
+
+	hasher.u32(specialization_constants_folded);
+
+	SmallVector<uint32_t> removed;
+	removed.reserve(removed_interface_variables.size());
+	for (auto &var : removed_interface_variables)
+		removed.push_back(var);
+	sort(begin(removed), end(removed));
+	hasher.u32(uint32_t(removed.size()));
+	for (auto &var : removed)
+		hasher.u32(var);
+
+	SmallVector<std::pair<uint32_t, uint32_t>> workgroup_aliases;
+	workgroup_aliases.reserve(workgroup_variable_aliases.size());
+	for (auto &alias : workgroup_variable_aliases)
+		workgroup_aliases.push_back(alias);
+	sort(begin(workgroup_aliases), end(workgroup_aliases));
+	hasher.u32(uint32_t(workgroup_aliases.size()));
+	for (auto &alias : workgroup_aliases)
+	{
+		hasher.u32(alias.first);
+		hasher.u32(alias.second);
+	}
+
+	hasher.u32(check_active_interface_variables);
+	if (check_active_interface_variables)
+	{
+		SmallVector<uint32_t> active;
+		active.reserve(active_interface_variables.size());
+		for (auto &var : active_interface_variables)
+			active.push_back(var);
+		sort(begin(active), end(active));
+		hasher.u32(uint32_t(active.size()));
+		for (auto &var : active)
+			hasher.u32(var);
+	}
+}
+
+bool Compiler::get_compile_state_hash(uint64_t &hash) const
+{
+	// We cannot know what an arbitrary callback will do.
+	if (variable_remap_callback)
+		return false;
+
+	Hasher hasher;
+	hash_compile_state(hasher);
+	hash = hasher.get();
+	return true;
+}
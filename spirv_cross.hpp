@@ -27,6 +27,8 @@
 #include "spirv.hpp"
 #include "spirv_cfg.hpp"
 #include "spirv_cross_parsed_ir.hpp"
+#include <atomic>
+#include <scoped_allocator>
 
 namespace SPIRV_CROSS_NAMESPACE
 {
@@ -99,6 +101,24 @@ struct SpecializationConstant
 	uint32_t constant_id;
 };
 
+struct SpecializationConstantValue
+{
+	// The constant ID of the constant, i.e. VkSpecializationMapEntry::constantID.
+	uint32_t constant_id;
+	// The raw bits of the value. Types smaller than 64 bits use the lower bits, booleans are true if non-zero.
+	uint64_t value;
+};
+
+struct ResourceBindingRemap
+{
+	// The descriptor set and binding of the resources to remap.
+	uint32_t desc_set;
+	uint32_t binding;
+	// The descriptor set and binding to decorate them with instead.
+	uint32_t new_desc_set;
+	uint32_t new_binding;
+};
+
 struct BufferRange
 {
 	unsigned index;
@@ -124,6 +144,16 @@ struct EntryPoint
 	spv::ExecutionModel execution_model;
 };
 
+// Receives generated source code in chunks, see Compiler::compile_to_sink().
+class ThreadPool;
+
+class OutputSink
+{
+public:
+	virtual ~OutputSink() = default;
+	virtual void write(const char *data, size_t size) = 0;
+};
+
 class Compiler
 {
 public:
@@ -138,16 +168,36 @@ public:
 
 	// This is more modular. We can also consume a ParsedIR structure directly, either as a move, or copy.
 	// With copy, we can reuse the same parsed IR for multiple Compiler instances.
+	// The raw SPIR-V words, the instruction lists of blocks, the block lists of functions and the elements
+	// of composite constants are shared between all copies rather than duplicated, see SharedVector.
+	// Other IR objects are still copied. Several Compiler instances may be created from the same const ParsedIR
+	// concurrently.
 	explicit Compiler(const ParsedIR &ir);
 	explicit Compiler(ParsedIR &&ir);
 
 	virtual ~Compiler() = default;
 
+	// Rebinds the compiler to a different module, so that one compiler can be reused for many modules.
+	// All state derived from the previous module is reset, including remapping, resource bindings and any other
+	// module specific configuration done through the compiler. Backend options, callbacks and
+	// naming preferences such as the combined sampler suffix are kept as-is, and unlike a newly constructed compiler,
+	// options are not derived from the new module.
+	// Internal containers keep their allocated capacity, which avoids most of the allocations of a new compiler.
+	void rebind_ir(const ParsedIR &ir);
+	void rebind_ir(ParsedIR &&ir);
+
 	// After parsing, API users can modify the SPIR-V via reflection and call this
 	// to disassemble the SPIR-V into the desired langauage.
 	// Sub-classes actually implement this.
 	virtual std::string compile();
 
+	// Like compile(), but the generated source is handed to sink piece by piece rather than returned
+	// as a single string. Backends can emit their code several times before it is final,
+	// so sink only receives data once the last pass has completed, but the output is never
+	// concatenated into one allocation. Backends which do not support streaming
+	// write the result of compile() in one go.
+	void compile_to_sink(OutputSink &sink);
+
 	// Gets the identifier (OpName) of an ID. If not defined, an empty string will be returned.
 	const std::string &get_name(ID id) const;
 
@@ -270,6 +320,39 @@ public:
 	// Once set, compile() will only consider the set in active_variables.
 	void set_enabled_interface_variables(std::unordered_set<VariableID> active_variables);
 
+	// Removes Input and Output variables from the interface of the current entry point,
+	// e.g. outputs which the next stage of a pipeline never reads. No backend declares removed variables.
+	// Stores to removed outputs are dropped, along with any code which only served to compute the stored values.
+	// Variables which the shader reads itself are kept, so the remaining outputs are computed as before.
+	// Returns the variables which were actually removed. This must be called before compile().
+	SmallVector<VariableID> remove_interface_variables(const std::unordered_set<VariableID> &variables);
+
+	// Remaps the DescriptorSet and Binding decorations of every resource variable which matches a
+	// (desc_set, binding) pair in remaps, in a single pass over the variables. All remaps are applied at once,
+	// so sets and bindings can be swapped. If a pair appears more than once, the last entry is used.
+	// Returns the number of variables which were remapped.
+	uint32_t remap_resource_bindings(const ResourceBindingRemap *remaps, size_t count);
+
+	// Returns the number of bytes of workgroup memory taken by the Workgroup variables of the current entry point,
+	// laid out one after another with their natural size and alignment, booleans counting as 32-bit.
+	// Variables padded or aliased by pad_workgroup_arrays() and alias_workgroup_variables() are accounted for.
+	// Backends are free to lay out workgroup memory differently, so this is an estimate rather than an exact figure.
+	uint32_t get_workgroup_memory_size() const;
+
+	// Pads the rows of Workgroup arrays of 32-bit scalars by one element to avoid memory bank conflicts.
+	// Only arrays of two or more dimensions whose rows span a multiple of 32 four-byte banks are considered,
+	// if they are indexed with an outer index which differs between invocations, like the tile of a transpose.
+	// Each element must be accessed through a fully indexed access chain, as the array type changes.
+	// Returns the number of variables which were padded. This must be called before compile().
+	uint32_t pad_workgroup_arrays();
+
+	// Lets Workgroup variables of the same type share storage when their lifetimes do not overlap, that is,
+	// every path to an access of one variable passes a workgroup barrier after which the other is never accessed.
+	// Only compute shaders are handled, and only variables which are accessed from the entry point function alone.
+	// The aliased variables are not declared, and any use of them is emitted as a use of the variable they alias.
+	// Returns the number of variables which now alias another one. This must be called before compile().
+	uint32_t alias_workgroup_variables();
+
 	// Query shader resources, use ids with reflection interface to modify or query binding points, etc.
 	ShaderResources get_shader_resources() const;
 
@@ -425,6 +508,17 @@ public:
 	SPIRConstant &get_constant(ConstantID id);
 	const SPIRConstant &get_constant(ConstantID id) const;
 
+	// Bakes known specialization constant values into the module.
+	// Specialization constants with a constant_id found in values become ordinary constants
+	// and are emitted as literals, and specialization constant operations which only depend on
+	// ordinary constants are evaluated where possible (32-bit integer and boolean scalars).
+	// Selection and switch constructs which branch on a constant are then reduced to the path taken,
+	// so the dead code is not emitted at all.
+	// Specialization constants which are not given a value are left alone.
+	// This modifies the module in-place. If it is called after compile(), the next compile() analyzes
+	// the modified module from scratch.
+	void fold_specialization_constants(const SmallVector<SpecializationConstantValue> &values);
+
 	uint32_t get_current_id_bound() const
 	{
 		return uint32_t(ir.ids.size());
@@ -440,6 +534,11 @@ public:
 	uint32_t type_struct_member_array_stride(const SPIRType &type, uint32_t index) const;
 	uint32_t type_struct_member_matrix_stride(const SPIRType &type, uint32_t index) const;
 
+	// Member indices of a struct type in the order its members are declared.
+	// This is member index order, unless the members were repacked with CompilerGLSL::repack_buffer_block(),
+	// in which case they are declared in Offset order.
+	SmallVector<uint32_t> get_struct_member_declaration_order(const SPIRType &type) const;
+
 	// Gets the offset in SPIR-V words (uint32_t) for a decoration which was originally declared in the SPIR-V binary.
 	// The offset will point to one or more uint32_t literals which can be modified in-place before using the SPIR-V binary.
 	// Note that adding or removing decorations using the reflection API will not change the behavior of this function.
@@ -504,6 +603,110 @@ public:
 		return position_invariant;
 	}
 
+	// Computes a 64-bit hash of all state which can affect the result of compile().
+	// This covers the SPIR-V module itself, names and decorations, specialization constant values,
+	// remapping state set through the reflection API as well as backend options and resource remaps.
+	// Two compilers of the same backend type with equal hashes are expected to produce identical code.
+	// Must be called before compile(), as compilation itself modifies compiler state.
+	// Returns false if the state cannot be hashed reliably, e.g. if a variable type remap callback is used.
+	bool get_compile_state_hash(uint64_t &hash) const;
+
+	// Returns the number of emission passes the last call to compile() needed.
+	// Backends speculate on certain things, e.g. whether an expression can be forwarded,
+	// and have to emit the code again when speculation fails.
+	// Returns 0 if compile() has not been called.
+	uint32_t get_compile_pass_count() const
+	{
+		return compile_pass_count;
+	}
+
+	// Wall-clock time in seconds spent in the major phases of the last call to compile().
+	// cfg covers building the control flow graphs of all reachable functions,
+	// analysis covers everything else compile() does before emitting code,
+	// and passes holds the time taken by every emission pass.
+	struct PhaseTimings
+	{
+		double cfg = 0.0;
+		double analysis = 0.0;
+		double emission = 0.0;
+		SmallVector<double> passes;
+	};
+
+	const PhaseTimings &get_phase_timings() const
+	{
+		return phase_timings;
+	}
+
+	// Approximate heap memory held by the compiler in bytes, by category.
+	struct MemoryUsage
+	{
+		// The IR owned by this compiler, see ParsedIR::get_memory_usage().
+		ParsedIR::MemoryUsage ir;
+
+		// Control flow graphs of all reachable functions, kept from the last compile().
+		size_t cfgs = 0;
+
+		// Scratch memory and caches used while analyzing the module.
+		size_t analysis = 0;
+
+		// Buffers holding generated source, which keep their capacity between calls to compile().
+		size_t output = 0;
+
+		size_t total() const
+		{
+			return ir.total() + cfgs + analysis + output;
+		}
+	};
+	virtual MemoryUsage get_memory_usage() const;
+
+	// Releases memory which is only needed while compiling, e.g. control flow graphs, analysis caches
+	// and output buffers, and trims the IR, see ParsedIR::shrink_to_fit().
+	// Reflection keeps working as before, and a later compile() rebuilds whatever it needs.
+	virtual void shrink_to_fit();
+
+	// Limits for a single call to compile(), to bound the cost of compiling untrusted modules.
+	// A limit of 0 means unlimited. When a limit is hit, compile() throws CompileBudgetExceeded,
+	// or aborts if exceptions are disabled. The budget is not part of get_compile_state_hash().
+	struct CompileBudget
+	{
+		// Wall-clock time, measured from the start of compile(). Checked regularly during analysis and emission.
+		uint64_t max_time_us = 0;
+
+		// Length in bytes of any single forwarded expression.
+		size_t max_expression_size = 0;
+
+		// Number of forwarded expressions any single expression may be built from,
+		// which bounds the depth of forwarding chains.
+		uint32_t max_forwarding_depth = 0;
+
+		// Bytes of source emitted by any single emission pass.
+		size_t max_output_size = 0;
+
+		// If set, compile() stops shortly after another thread sets the flag.
+		const std::atomic<bool> *cancel = nullptr;
+	};
+
+	void set_compile_budget(const CompileBudget &budget);
+	const CompileBudget &get_compile_budget() const
+	{
+		return compile_budget;
+	}
+
+	// Registers a callback which is called when entering and leaving the major phases of compile(), see TraceEvent.
+	// The callback is only called if SPIRV-Cross is built with SPIRV_CROSS_ENABLE_TRACING.
+	// If an analysis thread pool is set, TraceEventCFG is reported from the worker threads, possibly concurrently,
+	// so the callback must be thread-safe.
+	void set_trace_callback(TraceCallback callback);
+
+	// Builds the control flow graphs and runs the variable scope analysis of every function on a thread pool.
+	// The pool is not owned by the compiler and must stay alive while compile() runs. The output does not change.
+	// With tracing enabled, TraceEventCFG is reported from the worker threads.
+	// Pass nullptr (the default) to analyze all functions on the calling thread.
+	void set_analysis_thread_pool(ThreadPool *pool);
+
+	// Returns how many times the last call to compile() requested another emission pass for a given reason.
+	uint32_t get_recompile_reason_count(RecompileReason reason) const;
+
 protected:
 	const uint32_t *stream(const Instruction &instr) const
 	{
@@ -529,6 +732,26 @@ protected:
 	uint32_t current_loop_level = 0;
 	std::unordered_set<VariableID> active_interface_variables;
 	bool check_active_interface_variables = false;
+	std::unordered_set<VariableID> removed_interface_variables;
+
+	// Workgroup variables which are emitted as another variable, see alias_workgroup_variables().
+	std::unordered_map<uint32_t, uint32_t> workgroup_variable_aliases;
+	struct WorkgroupVariableAccesses
+	{
+		struct Block
+		{
+			// Instruction indices of the accesses to each variable, and of the workgroup barriers, in order.
+			SmallVector<std::pair<uint32_t, uint32_t>> accesses;
+			SmallVector<uint32_t> barriers;
+		};
+		std::unordered_map<uint32_t, Block> blocks;
+	};
+	bool workgroup_variable_lifetimes_are_disjoint(const WorkgroupVariableAccesses &accesses, uint32_t first,
+	                                               uint32_t second) const;
+	uint32_t get_workgroup_type_size(const SPIRType &type, uint32_t &alignment) const;
+	void eliminate_dead_code();
+	bool opcode_has_side_effects(spv::Op op, const uint32_t *ops, uint32_t length) const;
+	bool specialization_constants_folded = false;
 
 	void add_loop_level();
 
@@ -588,6 +811,11 @@ protected:
 			return nullptr;
 	}
 
+	// Creates type as id, unless a structurally identical type has been interned before,
+	// in which case the existing ID is returned and id is left unused. type.self is kept as set up by the caller.
+	// The returned type is shared and must not be modified.
+	uint32_t set_interned_type(uint32_t id, SPIRType type, uint64_t tag = 0);
+
 	// Gets the id of SPIR-V type underlying the given type_id, which might be a pointer.
 	uint32_t get_pointee_type_id(uint32_t type_id) const;
 
@@ -648,6 +876,15 @@ protected:
 		return (ir.block_meta[next] & ParsedIR::BLOCK_META_CONTINUE_BIT) != 0;
 	}
 
+	// The variable scope analysis can run on worker threads, so this must not insert into the map.
+	inline BlockID get_continue_block_loop_header(uint32_t block) const
+	{
+		auto itr = ir.continue_block_to_loop_header.find(block);
+		if (itr == ir.continue_block_to_loop_header.end())
+			SPIRV_CROSS_THROW("Continue block is not the continue target of any loop.");
+		return itr->second;
+	}
+
 	inline bool is_single_block_loop(uint32_t next) const
 	{
 		auto &block = get<SPIRBlock>(next);
@@ -681,13 +918,17 @@ protected:
 	void register_global_read_dependencies(const SPIRFunction &func, uint32_t id);
 	std::unordered_set<uint32_t> invalid_expressions;
 
-	void update_name_cache(std::unordered_set<std::string> &cache, std::string &name);
+	// Names in the name caches are interned, so copying and probing a cache does not touch any strings.
+	StringInterner name_interner;
+	bool name_cache_contains(const NameCache &cache, const std::string &name) const;
+	void insert_name(NameCache &cache, const std::string &name);
+
+	void update_name_cache(NameCache &cache, std::string &name);
 
 	// A variant which takes two sets of names. The secondary is only used to verify there are no collisions,
 	// but the set is not updated when we have found a new name.
 	// Used primarily when adding block interface names.
-	void update_name_cache(std::unordered_set<std::string> &cache_primary,
-	                       const std::unordered_set<std::string> &cache_secondary, std::string &name);
+	void update_name_cache(NameCache &cache_primary, const NameCache &cache_secondary, std::string &name);
 
 	bool function_is_pure(const SPIRFunction &func);
 	bool block_is_pure(const SPIRBlock &block);
@@ -697,10 +938,65 @@ protected:
 	bool execution_is_noop(const SPIRBlock &from, const SPIRBlock &to) const;
 	SPIRBlock::ContinueBlockType continue_block_type(const SPIRBlock &continue_block) const;
 
-	void force_recompile();
+	void force_recompile(RecompileReason reason = RecompileReasonGeneric);
 	void clear_force_recompile();
 	bool is_forcing_recompilation() const;
 	bool is_force_recompile = false;
+	uint32_t compile_pass_count = 0;
+
+	// Backends call these at the start of compile(), once all analysis is done, and after every emission pass.
+	// begin_phase_timings() also resets the force_recompile() statistics.
+	void begin_phase_timings();
+	void begin_emission_timings();
+	void end_pass_timing();
+	static uint64_t get_timestamp_ns();
+	PhaseTimings phase_timings;
+	uint64_t phase_timestamp = 0;
+	uint32_t recompile_reason_counts[RecompileReasonCount] = {};
+	TraceCallback trace_callback;
+
+	CompileBudget compile_budget;
+	uint64_t compile_budget_start = 0;
+
+	// Backends call this at the start of compile(). The budget is only enforced while the scope is alive,
+	// so reflection outside of compile() never fails because of it.
+	struct CompileBudgetScope
+	{
+		explicit CompileBudgetScope(Compiler &compiler);
+		~CompileBudgetScope();
+		CompileBudgetScope(const CompileBudgetScope &) = delete;
+		void operator=(const CompileBudgetScope &) = delete;
+		Compiler &compiler;
+		bool outermost;
+	};
+
+	// Throws if compilation was cancelled or ran out of time. Safe to call from analysis worker threads.
+	inline void check_compile_budget() const
+	{
+		if (compile_budget_start && (compile_budget.cancel || compile_budget.max_time_us))
+			check_compile_deadline();
+	}
+	void check_compile_deadline() const;
+	void check_output_budget(size_t output_size) const;
+	void check_expression_budget(const SPIRExpression &expr) const;
+
+	// Set for the duration of compile_to_sink(). Backends which stream their output
+	// write to it directly and return an empty string from compile().
+	OutputSink *output_sink = nullptr;
+
+	// Backing memory for transient data structures used while analyzing the module, e.g. per-function analysis.
+	// Memory is only reclaimed in bulk with scratch_arena.reset(), so users must not rely on
+	// allocations surviving beyond the analysis step which made them.
+	MemoryArena scratch_arena;
+
+	using ScratchIDSet =
+	    std::unordered_set<uint32_t, std::hash<uint32_t>, std::equal_to<uint32_t>, ArenaAllocator<uint32_t>>;
+	using ScratchIDMap = std::unordered_map<uint32_t, uint32_t, std::hash<uint32_t>, std::equal_to<uint32_t>,
+	                                        ArenaAllocator<std::pair<const uint32_t, uint32_t>>>;
+	// The scoped adaptor makes sure the inner sets allocate from the same arena.
+	using ScratchIDSetMap =
+	    std::unordered_map<uint32_t, ScratchIDSet, std::hash<uint32_t>, std::equal_to<uint32_t>,
+	                       std::scoped_allocator_adaptor<ArenaAllocator<std::pair<const uint32_t, ScratchIDSet>>>>;
 
 	bool block_is_loop_candidate(const SPIRBlock &block, SPIRBlock::Method method) const;
 
@@ -723,6 +1019,13 @@ protected:
 
 	void set_ir(const ParsedIR &parsed);
 	void set_ir(ParsedIR &&parsed);
+
+	// Called by rebind_ir() before the new module is installed.
+	// Backends which hold state derived from the module must clear it and call the parent implementation.
+	virtual void reset_module_state();
+
+	// Backends override this to hash their options and remapping state on top of the common state.
+	virtual void hash_compile_state(Hasher &hasher) const;
 	void parse_fixup();
 
 	// Used internally to implement various traversals for queries.
@@ -761,6 +1064,45 @@ protected:
 		}
 	};
 
+	// Drives several handlers in a single traversal.
+	// Every handler sees the same sequence of callbacks it would see if it was traversed on its own.
+	// A handler which returns false only stops itself, the traversal ends once all handlers are done.
+	// Handlers added with follow_once only enter a function the first time it is called.
+	// This is only correct for handlers which do not depend on the call context.
+	struct OpcodeHandlerGroup : OpcodeHandler
+	{
+		void add(OpcodeHandler &handler, bool follow_once = false);
+
+		bool handle(spv::Op opcode, const uint32_t *args, uint32_t length) override;
+		bool follow_function_call(const SPIRFunction &func) override;
+		void set_current_block(const SPIRBlock &block) override;
+		void rearm_current_block(const SPIRBlock &block) override;
+		bool begin_function_scope(const uint32_t *args, uint32_t length) override;
+		bool end_function_scope(const uint32_t *args, uint32_t length) override;
+
+		struct Entry
+		{
+			OpcodeHandler *handler;
+			std::unordered_set<uint32_t> visited_functions;
+			// Call depth of the function this handler is currently traversing.
+			uint32_t depth;
+			bool follow_once;
+			bool following;
+			bool returned;
+			bool done;
+		};
+
+		bool is_active(const Entry &entry) const
+		{
+			return !entry.done && entry.depth == depth;
+		}
+
+		SmallVector<Entry> handlers;
+		uint32_t depth = 0;
+		uint32_t active_count = 0;
+		bool returned_from_call = false;
+	};
+
 	struct BufferAccessHandler : OpcodeHandler
 	{
 		BufferAccessHandler(const Compiler &compiler_, SmallVector<BufferRange> &ranges_, uint32_t id_)
@@ -828,15 +1170,50 @@ protected:
 		bool need_dummy_sampler = false;
 	};
 
+	// What a function and everything it calls accesses.
+	// Summaries are computed bottom-up over the call graph, so every function is only analyzed once,
+	// no matter how many call sites it has.
+	struct FunctionSummary
+	{
+		// Interface variables which are accessed, see get_active_interface_variables().
+		std::unordered_set<VariableID> interface_variables;
+
+		// Builtins which are accessed, see update_active_builtins().
+		Bitset input_builtins;
+		Bitset output_builtins;
+		uint32_t clip_distance_count = 0;
+		uint32_t cull_distance_count = 0;
+		bool position_invariant = false;
+
+		// Sampled images which are used with depth comparison.
+		std::unordered_set<uint32_t> dref_combined_samplers;
+
+		// Purity depends on expression types which are only known while emitting code,
+		// so it is computed separately on demand by function_is_pure().
+		bool pure = false;
+		bool purity_valid = false;
+		bool access_valid = false;
+
+		void merge_access(const FunctionSummary &other);
+		void merge_builtins(const FunctionSummary &other);
+	};
+
+	// Summaries can depend on decorations which may change between compiles,
+	// so they are dropped whenever the active usage is analyzed again, or the function bodies are modified.
+	const FunctionSummary &get_function_summary(FunctionID func) const;
+	mutable std::unordered_map<uint32_t, FunctionSummary> function_summaries;
+
 	struct ActiveBuiltinHandler : OpcodeHandler
 	{
-		ActiveBuiltinHandler(Compiler &compiler_)
+		ActiveBuiltinHandler(const Compiler &compiler_, FunctionSummary &summary_)
 		    : compiler(compiler_)
+		    , summary(summary_)
 		{
 		}
 
 		bool handle(spv::Op opcode, const uint32_t *args, uint32_t length) override;
-		Compiler &compiler;
+		const Compiler &compiler;
+		FunctionSummary &summary;
 
 		void handle_builtin(const SPIRType &type, spv::BuiltIn builtin, const Bitset &decoration_flags);
 		void add_if_builtin(uint32_t id);
@@ -846,6 +1223,15 @@ protected:
 
 	bool traverse_all_reachable_opcodes(const SPIRBlock &block, OpcodeHandler &handler) const;
 	bool traverse_all_reachable_opcodes(const SPIRFunction &block, OpcodeHandler &handler) const;
+	// Visits every function reachable from func exactly once without following function calls.
+	// Cheaper than traverse_all_reachable_opcodes() for deep call graphs, but the handler
+	// must not depend on the call context or on the order functions are visited in.
+	bool traverse_reachable_functions_once(const SPIRFunction &func, OpcodeHandler &handler) const;
+
+	// Returns func and all functions it calls, directly or indirectly, in breadth-first call order.
+	// This is computed once per function, until invalidate_function_analysis() or shrink_to_fit() is called.
+	const SmallVector<FunctionID> &get_reachable_functions(FunctionID func) const;
+	mutable std::unordered_map<uint32_t, SmallVector<FunctionID>> reachable_functions_cache;
 	// This must be an ordered data structure so we always pick the same type aliases.
 	SmallVector<uint32_t> global_struct_cache;
 
@@ -867,10 +1253,8 @@ protected:
 	uint32_t cull_distance_count = 0;
 	bool position_invariant = false;
 
-	void analyze_parameter_preservation(
-	    SPIRFunction &entry, const CFG &cfg,
-	    const std::unordered_map<uint32_t, std::unordered_set<uint32_t>> &variable_to_blocks,
-	    const std::unordered_map<uint32_t, std::unordered_set<uint32_t>> &complete_write_blocks);
+	void analyze_parameter_preservation(SPIRFunction &entry, const CFG &cfg, const ScratchIDSetMap &variable_to_blocks,
+	                                    const ScratchIDSetMap &complete_write_blocks);
 
 	// If a variable ID or parameter ID is found in this set, a sampler is actually a shadow/comparison sampler.
 	// SPIR-V does not support this distinction, so we must keep track of this information outside the type system.
@@ -885,17 +1269,15 @@ protected:
 	// so we need to workaround by having the application inject a dummy sampler.
 	uint32_t dummy_sampler_id = 0;
 
-	void analyze_image_and_sampler_usage();
-
 	struct CombinedImageSamplerDrefHandler : OpcodeHandler
 	{
-		CombinedImageSamplerDrefHandler(Compiler &compiler_)
+		CombinedImageSamplerDrefHandler(const Compiler &compiler_)
 		    : compiler(compiler_)
 		{
 		}
 		bool handle(spv::Op opcode, const uint32_t *args, uint32_t length) override;
 
-		Compiler &compiler;
+		const Compiler &compiler;
 		std::unordered_set<uint32_t> dref_combined_samplers;
 	};
 
@@ -921,24 +1303,58 @@ protected:
 		void add_dependency(uint32_t dst, uint32_t src);
 	};
 
+	void build_function_control_flow_graphs(const SmallVector<FunctionID> &functions, ThreadPool *pool);
 	void build_function_control_flow_graphs_and_analyze();
 	std::unordered_map<uint32_t, std::unique_ptr<CFG>> function_cfgs;
-	const CFG &get_cfg_for_current_function() const;
-	const CFG &get_cfg_for_function(uint32_t id) const;
 
-	struct CFGBuilder : OpcodeHandler
+	// The CFGs and variable scope analysis only depend on the function bodies, the entry point,
+	// and decorations on function-local variables. When compile() is called again on the same
+	// Compiler with only e.g. resource bindings changed, the previous results are kept.
+	// Function bodies are not hashed, so anything which rewrites them, like fold_specialization_constants(),
+	// must call invalidate_function_analysis().
+	uint64_t hash_function_analysis_inputs() const;
+	void invalidate_function_analysis();
+	// The analysis stores its results in the blocks and variables, and emission adds to them.
+	// Before running it again, these are reset to how the parser left them.
+	void reset_function_analysis_results();
+	uint64_t function_analysis_hash = 0;
+	bool function_analysis_valid = false;
+	ThreadPool *analysis_thread_pool = nullptr;
+
+	// Memoizes struct size and alignment queries, keyed on the struct type and the layout rules of the query.
+	// Types are restructured, e.g. repacked or sorted, while declarations are emitted, so caching is only enabled
+	// while function bodies are emitted, and any change to a layout decoration drops all entries.
+	enum LayoutQuery
 	{
-		explicit CFGBuilder(Compiler &compiler_);
-
-		bool follow_function_call(const SPIRFunction &func) override;
-		bool handle(spv::Op op, const uint32_t *args, uint32_t length) override;
-		Compiler &compiler;
-		std::unordered_map<uint32_t, std::unique_ptr<CFG>> function_cfgs;
+		LayoutQueryDeclaredSize,
+		LayoutQueryMSLSize,
+		LayoutQueryMSLSizeIgnoreAlignment,
+		LayoutQueryMSLSizeIgnorePadding,
+		LayoutQueryMSLSizeIgnoreAlignmentAndPadding,
+		LayoutQueryMSLAlignment
+	};
+	struct LayoutCacheEntry
+	{
+		size_t member_count;
+		size_t value;
 	};
+	mutable std::unordered_map<uint64_t, LayoutCacheEntry> layout_cache;
+	bool layout_cache_enabled = false;
+	void set_layout_cache_enabled(bool enable);
+	void invalidate_layout_cache(uint32_t decoration, bool extended);
+	bool find_cached_layout(const SPIRType &type, LayoutQuery query, size_t &value) const;
+
+	// The member declared after index, or the member count if index is declared last.
+	uint32_t get_next_declared_struct_member(const SPIRType &type, uint32_t index) const;
+	uint32_t get_last_declared_struct_member(const SPIRType &type) const;
+	void cache_layout(const SPIRType &type, LayoutQuery query, size_t value) const;
+	void register_access_chain_expression(uint32_t result_type, uint32_t id, uint32_t ptr);
+	const CFG &get_cfg_for_current_function() const;
+	const CFG &get_cfg_for_function(uint32_t id) const;
 
 	struct AnalyzeVariableScopeAccessHandler : OpcodeHandler
 	{
-		AnalyzeVariableScopeAccessHandler(Compiler &compiler_, SPIRFunction &entry_);
+		AnalyzeVariableScopeAccessHandler(Compiler &compiler_, SPIRFunction &entry_, MemoryArena &arena);
 
 		bool follow_function_call(const SPIRFunction &) override;
 		void set_current_block(const SPIRBlock &block) override;
@@ -950,15 +1366,23 @@ protected:
 
 		Compiler &compiler;
 		SPIRFunction &entry;
-		std::unordered_map<uint32_t, std::unordered_set<uint32_t>> accessed_variables_to_block;
-		std::unordered_map<uint32_t, std::unordered_set<uint32_t>> accessed_temporaries_to_block;
-		std::unordered_map<uint32_t, uint32_t> result_id_to_type;
-		std::unordered_map<uint32_t, std::unordered_set<uint32_t>> complete_write_variables_to_block;
-		std::unordered_map<uint32_t, std::unordered_set<uint32_t>> partial_write_variables_to_block;
-		std::unordered_set<uint32_t> access_chain_expressions;
+		// All of these are allocated from the arena passed to the constructor.
+		ScratchIDSetMap accessed_variables_to_block;
+		ScratchIDSetMap accessed_temporaries_to_block;
+		ScratchIDMap result_id_to_type;
+		ScratchIDSetMap complete_write_variables_to_block;
+		ScratchIDSetMap partial_write_variables_to_block;
+		ScratchIDSet access_chain_expressions;
 		// Access chains used in multiple blocks mean hoisting all the variables used to construct the access chain as not all backends can use pointers.
-		std::unordered_map<uint32_t, std::unordered_set<uint32_t>> access_chain_children;
+		ScratchIDSetMap access_chain_children;
 		const SPIRBlock *current_block = nullptr;
+
+		// Set if the access chain expressions of the function have already been registered.
+		bool access_chains_registered = false;
+		// Results which touch state shared with other functions. They are applied once every function
+		// has been analyzed, so that functions can be analyzed concurrently.
+		SmallVector<uint32_t> hoisted_temporaries;
+		SmallVector<uint32_t> lut_constants;
 	};
 
 	struct StaticExpressionAccessHandler : OpcodeHandler
@@ -984,7 +1408,7 @@ protected:
 	SmallVector<uint32_t> physical_storage_non_block_pointer_types;
 
 	void analyze_variable_scope(SPIRFunction &function, AnalyzeVariableScopeAccessHandler &handler);
-	void find_function_local_luts(SPIRFunction &function, const AnalyzeVariableScopeAccessHandler &handler,
+	void find_function_local_luts(SPIRFunction &function, AnalyzeVariableScopeAccessHandler &handler,
 	                              bool single_function);
 	bool may_read_undefined_variable_in_block(const SPIRBlock &block, uint32_t var);
 
@@ -1038,7 +1462,14 @@ protected:
 		SmallVector<uint32_t> call_stack;
 	};
 
-	void analyze_interlocked_resource_usage();
+	// Computes active builtins, image and sampler usage and interlocked resource usage for the current entry point.
+	// Independent analyses share traversals, so this only walks the call graph three times.
+	// A backend can pass an extra handler which does not depend on the call context
+	// to run it as part of the first traversal.
+	void analyze_active_usage(OpcodeHandler *backend_handler = nullptr);
+	void reset_active_builtins();
+	void merge_active_builtins(const FunctionSummary &summary);
+	void add_initialized_output_builtins();
 	// The set of all resources written while inside the critical section, if present.
 	std::unordered_set<uint32_t> interlocked_resources;
 	bool interlocked_is_complex = false;
@@ -1078,6 +1509,8 @@ protected:
 
 	uint32_t evaluate_spec_constant_u32(const SPIRConstantOp &spec) const;
 	uint32_t evaluate_constant_u32(uint32_t id) const;
+	bool spec_constant_op_is_foldable(const SPIRConstantOp &spec) const;
+	void fold_constant_branches(SPIRFunction &func);
 
 	bool is_vertex_like_shader() const;
 
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2015-2021 Arm Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * At your option, you may choose to accept this material under either:
+ *  1. The Apache License, Version 2.0, found at <http://www.apache.org/licenses/LICENSE-2.0>, or
+ *  2. The MIT License, found at <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: Apache-2.0 OR MIT.
+ */
+
+#include "spirv_cross_batch.hpp"
+#include "spirv_cross_cache.hpp"
+#include "spirv_parser.hpp"
+
+using namespace std;
+
+namespace SPIRV_CROSS_NAMESPACE
+{
+BatchCompiler::BatchCompiler(unsigned num_threads)
+    : pool(num_threads)
+{
+}
+
+void BatchCompiler::set_compilation_cache(CompilationCache *cache_)
+{
+	cache = cache_;
+}
+
+static void compile_job(const BatchCompiler::Job &job, CompilationCache *cache, BatchCompiler::Result &result)
+{
+	if (!job.spirv || !job.create_compiler)
+	{
+		result.error = "Invalid job.";
+		return;
+	}
+
+	// The words outlive the compiler, so there is no need to copy them.
+	Parser parser(SPIRVWordBuffer::borrow(job.spirv, job.word_count));
+	parser.parse();
+
+	auto compiler = job.create_compiler(move(parser.get_parsed_ir()));
+	if (!compiler)
+	{
+		result.error = "Failed to create compiler.";
+		return;
+	}
+
+	result.source = cache ? cache->compile(*compiler) : compiler->compile();
+	if (result.source.empty())
+		result.error = "Unsupported SPIR-V.";
+	else
+		result.success = true;
+}
+
+SmallVector<BatchCompiler::Result> BatchCompiler::compile(const Job *jobs, size_t count)
+{
+	SmallVector<Result> results(count);
+
+	pool.parallel_for(count, [&](size_t index) {
+		auto &result = results[index];
+#ifndef SPIRV_CROSS_EXCEPTIONS_TO_ASSERTIONS
+		try
+		{
+			compile_job(jobs[index], cache, result);
+		}
+		catch (const std::exception &e)
+		{
+			result.success = false;
+			result.source.clear();
+			result.error = e.what();
+		}
+#else
+		compile_job(jobs[index], cache, result);
+#endif
+	});
+
+	return results;
+}
+} // namespace SPIRV_CROSS_NAMESPACE
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2015-2021 Arm Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * At your option, you may choose to accept this material under either:
+ *  1. The Apache License, Version 2.0, found at <http://www.apache.org/licenses/LICENSE-2.0>, or
+ *  2. The MIT License, found at <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: Apache-2.0 OR MIT.
+ */
+
+#ifndef SPIRV_CROSS_BATCH_HPP
+#define SPIRV_CROSS_BATCH_HPP
+
+#include "spirv_cross.hpp"
+#include "spirv_cross_thread_pool.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace SPIRV_CROSS_NAMESPACE
+{
+class CompilationCache;
+
+// Compiles many independent SPIR-V modules in parallel.
+// Parsing, compiler setup and compilation of every job all happen on the worker threads.
+class BatchCompiler
+{
+public:
+	struct Job
+	{
+		// Must remain valid until compile() returns.
+		const uint32_t *spirv = nullptr;
+		size_t word_count = 0;
+
+		// Creates the compiler for the parsed module and applies options, remaps, etc.
+		// Called on a worker thread, so it must not touch state shared with other jobs without synchronization.
+		std::function<std::unique_ptr<Compiler>(ParsedIR &&ir)> create_compiler;
+	};
+
+	struct Result
+	{
+		bool success = false;
+		std::string source;
+
+		// Set if success is false.
+		std::string error;
+	};
+
+	// If num_threads is 0, one thread per hardware thread is used.
+	explicit BatchCompiler(unsigned num_threads = 0);
+
+	// Optionally compile through a cache. The cache must outlive the BatchCompiler.
+	void set_compilation_cache(CompilationCache *cache);
+
+	// Compiles all jobs and returns results in the same order as the jobs.
+	// A failing job does not affect any other job.
+	// If exceptions are disabled with SPIRV_CROSS_EXCEPTIONS_TO_ASSERTIONS, errors cannot be recovered from.
+	SmallVector<Result> compile(const Job *jobs, size_t count);
+
+	ThreadPool &get_thread_pool()
+	{
+		return pool;
+	}
+
+private:
+	ThreadPool pool;
+	CompilationCache *cache = nullptr;
+};
+} // namespace SPIRV_CROSS_NAMESPACE
+
+#endif
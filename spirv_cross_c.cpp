@@ -45,6 +45,9 @@
 #include "gitversion.h"
 #endif
 
+#include "spirv_cross_cache.hpp"
+#include "spirv_cross_ir_serializer.hpp"
+#include "spirv_cross_thread_pool.hpp"
 #include "spirv_parser.hpp"
 #include <memory>
 #include <new>
@@ -74,6 +77,18 @@
 #define SPVC_END_SAFE_SCOPE(context, error)
 #endif
 
+#ifndef SPIRV_CROSS_EXCEPTIONS_TO_ASSERTIONS
+#define SPVC_END_COMPILE_SAFE_SCOPE(context, error) \
+	catch (const CompileBudgetExceeded &e)          \
+	{                                               \
+		(context)->report_error(e.what());          \
+		return SPVC_ERROR_BUDGET_EXCEEDED;          \
+	}                                               \
+	SPVC_END_SAFE_SCOPE(context, error)
+#else
+#define SPVC_END_COMPILE_SAFE_SCOPE(context, error)
+#endif
+
 using namespace std;
 using namespace SPIRV_CROSS_NAMESPACE;
 
@@ -82,21 +97,6 @@ struct ScratchMemoryAllocation
 	virtual ~ScratchMemoryAllocation() = default;
 };
 
-struct StringAllocation : ScratchMemoryAllocation
-{
-	explicit StringAllocation(const char *name)
-	    : str(name)
-	{
-	}
-
-	explicit StringAllocation(std::string name)
-	    : str(std::move(name))
-	{
-	}
-
-	std::string str;
-};
-
 template <typename T>
 struct TemporaryBuffer : ScratchMemoryAllocation
 {
@@ -113,11 +113,71 @@ struct spvc_context_s
 {
 	string last_error;
 	SmallVector<unique_ptr<ScratchMemoryAllocation>> allocations;
+
+	// Strings handed out to the user are carved out of an arena, and released along with all other allocations.
+	MemoryArena string_arena;
 	const char *allocate_name(const std::string &name);
 
+	// Removes a single allocation ahead of spvc_context_release_allocations().
+	void release_allocation(ScratchMemoryAllocation *allocation);
+
+	// String arenas of destroyed compilers are kept around for new compilers, so creating
+	// and destroying compilers in a loop does not go back to the heap every time.
+	SmallVector<unique_ptr<MemoryArena>> spare_arenas;
+	unique_ptr<MemoryArena> acquire_arena();
+	void recycle_arena(unique_ptr<MemoryArena> arena);
+
 	spvc_error_callback callback = nullptr;
 	void *callback_userdata = nullptr;
 	void report_error(std::string msg);
+
+	unique_ptr<CompilationCache> compilation_cache;
+
+	spvc_trace_callback trace_callback = nullptr;
+	void *trace_userdata = nullptr;
+	TraceCallback get_trace_callback() const;
+};
+
+struct CallbackCompilationCacheBackend : CompilationCache::Backend
+{
+	static void format_key(uint64_t key, char *name)
+	{
+		static const char digits[] = "0123456789abcdef";
+		for (int i = 15; i >= 0; i--)
+		{
+			name[i] = digits[key & 0xf];
+			key >>= 4;
+		}
+		name[16] = '\0';
+	}
+
+	bool load(uint64_t key, std::string &source) override
+	{
+		if (!load_cb)
+			return false;
+
+		char name[17];
+		format_key(key, name);
+		const char *str = load_cb(userdata, name);
+		if (!str)
+			return false;
+		source = str;
+		return true;
+	}
+
+	void store(uint64_t key, const std::string &source) override
+	{
+		if (!store_cb)
+			return;
+
+		char name[17];
+		format_key(key, name);
+		store_cb(userdata, name, source.c_str());
+	}
+
+	spvc_compilation_cache_load_callback load_cb = nullptr;
+	spvc_compilation_cache_store_callback store_cb = nullptr;
+	void *userdata = nullptr;
 };
 
 void spvc_context_s::report_error(std::string msg)
@@ -131,14 +191,40 @@ const char *spvc_context_s::allocate_name(const std::string &name)
 {
 	SPVC_BEGIN_SAFE_SCOPE
 	{
-		auto alloc = spvc_allocate<StringAllocation>(name);
-		auto *ret = alloc->str.c_str();
-		allocations.emplace_back(std::move(alloc));
-		return ret;
+		return string_arena.allocate_string(name.c_str(), name.size());
 	}
 	SPVC_END_SAFE_SCOPE(this, nullptr)
 }
 
+void spvc_context_s::release_allocation(ScratchMemoryAllocation *allocation)
+{
+	auto itr = find_if(begin(allocations), end(allocations),
+	                   [allocation](const unique_ptr<ScratchMemoryAllocation> &a) { return a.get() == allocation; });
+	if (itr != end(allocations))
+		allocations.erase(itr);
+}
+
+unique_ptr<MemoryArena> spvc_context_s::acquire_arena()
+{
+	if (spare_arenas.empty())
+		return unique_ptr<MemoryArena>(new MemoryArena);
+
+	auto arena = move(spare_arenas.back());
+	spare_arenas.pop_back();
+	return arena;
+}
+
+void spvc_context_s::recycle_arena(unique_ptr<MemoryArena> arena)
+{
+	// Only a handful of compilers tend to be alive at the same time, don't hold on to more than that.
+	static const size_t MaxSpareArenas = 4;
+	if (arena && spare_arenas.size() < MaxSpareArenas)
+	{
+		arena->reset();
+		spare_arenas.push_back(move(arena));
+	}
+}
+
 struct spvc_parsed_ir_s : ScratchMemoryAllocation
 {
 	spvc_context context = nullptr;
@@ -150,8 +236,26 @@ struct spvc_compiler_s : ScratchMemoryAllocation
 	spvc_context context = nullptr;
 	unique_ptr<Compiler> compiler;
 	spvc_backend backend = SPVC_BACKEND_NONE;
+
+	// Everything handed out through the compiler is owned by it rather than the context,
+	// so that spvc_compiler_destroy() can release it.
+	SmallVector<unique_ptr<ScratchMemoryAllocation>> allocations;
+	unique_ptr<MemoryArena> string_arena;
+	const char *allocate_name(const std::string &name);
+
+	// Installed as the cancellation flag of every budget, see spvc_compiler_cancel_compile().
+	std::atomic<bool> cancelled{ false };
 };
 
+const char *spvc_compiler_s::allocate_name(const std::string &name)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		return string_arena->allocate_string(name.c_str(), name.size());
+	}
+	SPVC_END_SAFE_SCOPE(context, nullptr)
+}
+
 struct spvc_compiler_options_s : ScratchMemoryAllocation
 {
 	spvc_context context = nullptr;
@@ -185,6 +289,7 @@ struct spvc_constant_s : SPIRConstant
 struct spvc_resources_s : ScratchMemoryAllocation
 {
 	spvc_context context = nullptr;
+	spvc_compiler compiler = nullptr;
 	SmallVector<spvc_reflected_resource> uniform_buffers;
 	SmallVector<spvc_reflected_resource> storage_buffers;
 	SmallVector<spvc_reflected_resource> stage_inputs;
@@ -220,6 +325,24 @@ void spvc_context_destroy(spvc_context context)
 void spvc_context_release_allocations(spvc_context context)
 {
 	context->allocations.clear();
+	context->string_arena.reset();
+}
+
+void spvc_compiler_destroy(spvc_compiler compiler)
+{
+	if (!compiler)
+		return;
+
+	auto *context = compiler->context;
+	compiler->allocations.clear();
+	context->recycle_arena(move(compiler->string_arena));
+	context->release_allocation(compiler);
+}
+
+void spvc_parsed_ir_destroy(spvc_parsed_ir parsed_ir)
+{
+	if (parsed_ir)
+		parsed_ir->context->release_allocation(parsed_ir);
 }
 
 const char *spvc_context_get_last_error_string(spvc_context context)
@@ -233,8 +356,92 @@ SPVC_PUBLIC_API void spvc_context_set_error_callback(spvc_context context, spvc_
 	context->callback_userdata = userdata;
 }
 
-spvc_result spvc_context_parse_spirv(spvc_context context, const SpvId *spirv, size_t word_count,
-                                     spvc_parsed_ir *parsed_ir)
+TraceCallback spvc_context_s::get_trace_callback() const
+{
+	if (!trace_callback)
+		return {};
+
+	auto cb = trace_callback;
+	auto userdata = trace_userdata;
+	return [cb, userdata](TraceEvent event, bool begin, uint32_t id) {
+		cb(userdata, static_cast<spvc_trace_event>(event), begin ? SPVC_TRUE : SPVC_FALSE, id);
+	};
+}
+
+spvc_result spvc_context_set_trace_callback(spvc_context context, spvc_trace_callback cb, void *userdata)
+{
+#ifdef SPIRV_CROSS_ENABLE_TRACING
+	context->trace_callback = cb;
+	context->trace_userdata = userdata;
+	return SPVC_SUCCESS;
+#else
+	(void)cb;
+	(void)userdata;
+	context->report_error("SPIRV-Cross was not built with SPIRV_CROSS_ENABLE_TRACING.");
+	return SPVC_ERROR_INVALID_ARGUMENT;
+#endif
+}
+
+spvc_result spvc_context_enable_compilation_cache(spvc_context context, size_t max_memory_bytes)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		if (context->compilation_cache)
+			context->compilation_cache->set_max_memory(max_memory_bytes);
+		else
+			context->compilation_cache.reset(new CompilationCache(max_memory_bytes));
+	}
+	SPVC_END_SAFE_SCOPE(context, SPVC_ERROR_OUT_OF_MEMORY)
+	return SPVC_SUCCESS;
+}
+
+void spvc_context_disable_compilation_cache(spvc_context context)
+{
+	context->compilation_cache.reset();
+}
+
+spvc_result spvc_context_set_compilation_cache_callbacks(spvc_context context,
+                                                         spvc_compilation_cache_load_callback load,
+                                                         spvc_compilation_cache_store_callback store,
+                                                         void *userdata)
+{
+	if (!context->compilation_cache)
+	{
+		context->report_error("Compilation cache is not enabled.");
+		return SPVC_ERROR_INVALID_ARGUMENT;
+	}
+
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		unique_ptr<CallbackCompilationCacheBackend> backend;
+		if (load || store)
+		{
+			backend.reset(new CallbackCompilationCacheBackend);
+			backend->load_cb = load;
+			backend->store_cb = store;
+			backend->userdata = userdata;
+		}
+		context->compilation_cache->set_backend(move(backend));
+	}
+	SPVC_END_SAFE_SCOPE(context, SPVC_ERROR_OUT_OF_MEMORY)
+	return SPVC_SUCCESS;
+}
+
+void spvc_context_get_compilation_cache_statistics(spvc_context context, size_t *hits, size_t *misses)
+{
+	CompilationCache::Statistics stats;
+	if (context->compilation_cache)
+		stats = context->compilation_cache->get_statistics();
+
+	if (hits)
+		*hits = stats.hits;
+	if (misses)
+		*misses = stats.misses;
+}
+
+static spvc_result spvc_context_parse_spirv_buffer(spvc_context context, SPIRVWordBuffer spirv,
+                                                   spvc_parsed_ir *parsed_ir, const char *entry_point = nullptr,
+                                                   SpvExecutionModel model = SpvExecutionModelMax)
 {
 	SPVC_BEGIN_SAFE_SCOPE
 	{
@@ -246,7 +453,10 @@ spvc_result spvc_context_parse_spirv(spvc_context context, const SpvId *spirv, s
 		}
 
 		pir->context = context;
-		Parser parser(spirv, word_count);
+		Parser parser(move(spirv));
+		parser.set_trace_callback(context->get_trace_callback());
+		if (entry_point)
+			parser.set_entry_point_filter(entry_point, static_cast<spv::ExecutionModel>(model));
 		parser.parse();
 		pir->parsed = move(parser.get_parsed_ir());
 		*parsed_ir = pir.get();
@@ -256,6 +466,92 @@ spvc_result spvc_context_parse_spirv(spvc_context context, const SpvId *spirv, s
 	return SPVC_SUCCESS;
 }
 
+spvc_result spvc_context_parse_spirv(spvc_context context, const SpvId *spirv, size_t word_count,
+                                     spvc_parsed_ir *parsed_ir)
+{
+	SPIRVWordBuffer words;
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		words = vector<uint32_t>(spirv, spirv + word_count);
+	}
+	SPVC_END_SAFE_SCOPE(context, SPVC_ERROR_OUT_OF_MEMORY)
+	return spvc_context_parse_spirv_buffer(context, move(words), parsed_ir);
+}
+
+spvc_result spvc_context_parse_spirv_entry_point(spvc_context context, const SpvId *spirv, size_t word_count,
+                                                 const char *entry_point, SpvExecutionModel model,
+                                                 spvc_parsed_ir *parsed_ir)
+{
+	if (!entry_point)
+	{
+		context->report_error("Entry point name must not be NULL.");
+		return SPVC_ERROR_INVALID_ARGUMENT;
+	}
+
+	SPIRVWordBuffer words;
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		words = vector<uint32_t>(spirv, spirv + word_count);
+	}
+	SPVC_END_SAFE_SCOPE(context, SPVC_ERROR_OUT_OF_MEMORY)
+	return spvc_context_parse_spirv_buffer(context, move(words), parsed_ir, entry_point, model);
+}
+
+spvc_result spvc_context_parse_spirv_borrowed(spvc_context context, const SpvId *spirv, size_t word_count,
+                                              spvc_parsed_ir *parsed_ir)
+{
+	return spvc_context_parse_spirv_buffer(context, SPIRVWordBuffer::borrow(spirv, word_count), parsed_ir);
+}
+
+spvc_result spvc_context_parse_spirv_file_region(spvc_context context, const char *path, size_t offset, size_t size,
+                                                 spvc_parsed_ir *parsed_ir)
+{
+	SPIRVWordBuffer spirv;
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		spirv = Parser::map_file(path, offset, size);
+	}
+	SPVC_END_SAFE_SCOPE(context, SPVC_ERROR_INVALID_ARGUMENT)
+	return spvc_context_parse_spirv_buffer(context, move(spirv), parsed_ir);
+}
+
+spvc_result spvc_context_serialize_parsed_ir(spvc_context context, spvc_parsed_ir parsed_ir, const SpvId **data,
+                                            size_t *word_count)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		auto buffer = spvc_allocate<TemporaryBuffer<SpvId>>();
+		auto words = serialize_parsed_ir(parsed_ir->parsed);
+		buffer->buffer.insert(buffer->buffer.end(), words.data(), words.data() + words.size());
+		*data = buffer->buffer.data();
+		*word_count = buffer->buffer.size();
+		context->allocations.push_back(std::move(buffer));
+	}
+	SPVC_END_SAFE_SCOPE(context, SPVC_ERROR_INVALID_ARGUMENT)
+	return SPVC_SUCCESS;
+}
+
+spvc_result spvc_context_deserialize_parsed_ir(spvc_context context, const SpvId *data, size_t word_count,
+                                              spvc_parsed_ir *parsed_ir)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		std::unique_ptr<spvc_parsed_ir_s> pir(new (std::nothrow) spvc_parsed_ir_s);
+		if (!pir)
+		{
+			context->report_error("Out of memory.");
+			return SPVC_ERROR_OUT_OF_MEMORY;
+		}
+
+		pir->context = context;
+		pir->parsed = deserialize_parsed_ir(SPIRVWordBuffer::borrow(data, word_count));
+		*parsed_ir = pir.get();
+		context->allocations.push_back(std::move(pir));
+	}
+	SPVC_END_SAFE_SCOPE(context, SPVC_ERROR_INVALID_ARGUMENT)
+	return SPVC_SUCCESS;
+}
+
 spvc_result spvc_context_create_compiler(spvc_context context, spvc_backend backend, spvc_parsed_ir parsed_ir,
                                          spvc_capture_mode mode, spvc_compiler *compiler)
 {
@@ -269,6 +565,7 @@ spvc_result spvc_context_create_compiler(spvc_context context, spvc_backend back
 		}
 		comp->backend = backend;
 		comp->context = context;
+		comp->string_arena = context->acquire_arena();
 
 		if (mode != SPVC_CAPTURE_MODE_COPY && mode != SPVC_CAPTURE_MODE_TAKE_OWNERSHIP)
 		{
@@ -335,6 +632,10 @@ spvc_result spvc_context_create_compiler(spvc_context context, spvc_backend back
 			return SPVC_ERROR_INVALID_ARGUMENT;
 		}
 
+		comp->compiler->set_trace_callback(context->get_trace_callback());
+		Compiler::CompileBudget budget;
+		budget.cancel = &comp->cancelled;
+		comp->compiler->set_compile_budget(budget);
 		*compiler = comp.get();
 		context->allocations.push_back(std::move(comp));
 	}
@@ -342,6 +643,25 @@ spvc_result spvc_context_create_compiler(spvc_context context, spvc_backend back
 	return SPVC_SUCCESS;
 }
 
+spvc_result spvc_compiler_rebind_parsed_ir(spvc_compiler compiler, spvc_parsed_ir parsed_ir, spvc_capture_mode mode)
+{
+	if (mode != SPVC_CAPTURE_MODE_COPY && mode != SPVC_CAPTURE_MODE_TAKE_OWNERSHIP)
+	{
+		compiler->context->report_error("Invalid argument for capture mode.");
+		return SPVC_ERROR_INVALID_ARGUMENT;
+	}
+
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		if (mode == SPVC_CAPTURE_MODE_TAKE_OWNERSHIP)
+			compiler->compiler->rebind_ir(move(parsed_ir->parsed));
+		else
+			compiler->compiler->rebind_ir(parsed_ir->parsed);
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
+	return SPVC_SUCCESS;
+}
+
 spvc_result spvc_compiler_create_compiler_options(spvc_compiler compiler, spvc_compiler_options *options)
 {
 	SPVC_BEGIN_SAFE_SCOPE
@@ -385,7 +705,7 @@ spvc_result spvc_compiler_create_compiler_options(spvc_compiler compiler, spvc_c
 		}
 
 		*options = opt.get();
-		compiler->context->allocations.push_back(std::move(opt));
+		compiler->allocations.push_back(std::move(opt));
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
 	return SPVC_SUCCESS;
@@ -433,6 +753,15 @@ spvc_result spvc_compiler_options_set_uint(spvc_compiler_options options, spvc_c
 	case SPVC_COMPILER_OPTION_FORCE_ZERO_INITIALIZED_VARIABLES:
 		options->glsl.force_zero_initialized_variables = value != 0;
 		break;
+	case SPVC_COMPILER_OPTION_PREDICT_TEMPORARIES:
+		options->glsl.predict_temporaries = value != 0;
+		break;
+	case SPVC_COMPILER_OPTION_COMPACT_OUTPUT:
+		options->glsl.compact_output = value != 0;
+		break;
+	case SPVC_COMPILER_OPTION_ELIMINATE_COMMON_SUBEXPRESSIONS:
+		options->glsl.eliminate_common_subexpressions = value != 0;
+		break;
 
 	case SPVC_COMPILER_OPTION_GLSL_SUPPORT_NONZERO_BASE_INSTANCE:
 		options->glsl.vertex.support_nonzero_base_instance = value != 0;
@@ -460,6 +789,9 @@ spvc_result spvc_compiler_options_set_uint(spvc_compiler_options options, spvc_c
 		options->glsl.fragment.default_int_precision =
 		    value != 0 ? CompilerGLSL::Options::Precision::Highp : CompilerGLSL::Options::Precision::Mediump;
 		break;
+	case SPVC_COMPILER_OPTION_GLSL_INFER_RELAXED_PRECISION:
+		options->glsl.infer_relaxed_precision = value != 0;
+		break;
 	case SPVC_COMPILER_OPTION_GLSL_EMIT_PUSH_CONSTANT_AS_UNIFORM_BUFFER:
 		options->glsl.emit_push_constant_as_uniform_buffer = value != 0;
 		break;
@@ -701,6 +1033,26 @@ spvc_result spvc_compiler_options_set_uint(spvc_compiler_options options, spvc_c
 	case SPVC_COMPILER_OPTION_MSL_FORCE_SAMPLE_RATE_SHADING:
 		options->msl.force_sample_rate_shading = value != 0;
 		break;
+
+	case SPVC_COMPILER_OPTION_MSL_USE_HELPER_LIBRARY:
+		options->msl.use_helper_library = value != 0;
+		break;
+
+	case SPVC_COMPILER_OPTION_MSL_VERTEX_PULLING:
+		options->msl.vertex_pulling = value != 0;
+		break;
+
+	case SPVC_COMPILER_OPTION_MSL_VERTEX_BUFFER_INDEX_BASE:
+		options->msl.vertex_buffer_index_base = value;
+		break;
+
+	case SPVC_COMPILER_OPTION_MSL_VERTEX_ATTRIBUTE_BUFFER_INDEX:
+		options->msl.vertex_attribute_buffer_index = value;
+		break;
+
+	case SPVC_COMPILER_OPTION_MSL_STAGE_TESS_CONTROL_OUTPUTS_IN_THREADGROUP:
+		options->msl.stage_tess_control_outputs_in_threadgroup = value != 0;
+		break;
 #endif
 
 	default:
@@ -797,6 +1149,31 @@ spvc_result spvc_compiler_flatten_buffer_block(spvc_compiler compiler, spvc_vari
 #endif
 }
 
+spvc_result spvc_compiler_repack_buffer_block(spvc_compiler compiler, spvc_variable_id id, spvc_bool *repacked)
+{
+#if SPIRV_CROSS_C_API_GLSL
+	if (compiler->backend == SPVC_BACKEND_NONE)
+	{
+		compiler->context->report_error("Cross-compilation related option used on NONE backend which only supports reflection.");
+		return SPVC_ERROR_INVALID_ARGUMENT;
+	}
+
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		bool result = static_cast<CompilerGLSL *>(compiler->compiler.get())->repack_buffer_block(id);
+		if (repacked)
+			*repacked = result ? SPVC_TRUE : SPVC_FALSE;
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_INVALID_ARGUMENT)
+	return SPVC_SUCCESS;
+#else
+	(void)id;
+	(void)repacked;
+	compiler->context->report_error("Cross-compilation related option used on NONE backend which only supports reflection.");
+	return SPVC_ERROR_INVALID_ARGUMENT;
+#endif
+}
+
 spvc_bool spvc_compiler_variable_is_depth_or_compare(spvc_compiler compiler, spvc_variable_id id)
 {
 #if SPIRV_CROSS_C_API_GLSL
@@ -914,6 +1291,25 @@ spvc_result spvc_compiler_hlsl_set_resource_binding_flags(spvc_compiler compiler
 #endif
 }
 
+#if SPIRV_CROSS_C_API_HLSL
+static HLSLResourceBinding to_hlsl_resource_binding(const spvc_hlsl_resource_binding &binding)
+{
+	HLSLResourceBinding bind;
+	bind.binding = binding.binding;
+	bind.desc_set = binding.desc_set;
+	bind.stage = static_cast<spv::ExecutionModel>(binding.stage);
+	bind.cbv.register_binding = binding.cbv.register_binding;
+	bind.cbv.register_space = binding.cbv.register_space;
+	bind.uav.register_binding = binding.uav.register_binding;
+	bind.uav.register_space = binding.uav.register_space;
+	bind.srv.register_binding = binding.srv.register_binding;
+	bind.srv.register_space = binding.srv.register_space;
+	bind.sampler.register_binding = binding.sampler.register_binding;
+	bind.sampler.register_space = binding.sampler.register_space;
+	return bind;
+}
+#endif
+
 spvc_result spvc_compiler_hlsl_add_resource_binding(spvc_compiler compiler,
                                                     const spvc_hlsl_resource_binding *binding)
 {
@@ -925,19 +1321,7 @@ spvc_result spvc_compiler_hlsl_add_resource_binding(spvc_compiler compiler,
 	}
 
 	auto &hlsl = *static_cast<CompilerHLSL *>(compiler->compiler.get());
-	HLSLResourceBinding bind;
-	bind.binding = binding->binding;
-	bind.desc_set = binding->desc_set;
-	bind.stage = static_cast<spv::ExecutionModel>(binding->stage);
-	bind.cbv.register_binding = binding->cbv.register_binding;
-	bind.cbv.register_space = binding->cbv.register_space;
-	bind.uav.register_binding = binding->uav.register_binding;
-	bind.uav.register_space = binding->uav.register_space;
-	bind.srv.register_binding = binding->srv.register_binding;
-	bind.srv.register_space = binding->srv.register_space;
-	bind.sampler.register_binding = binding->sampler.register_binding;
-	bind.sampler.register_space = binding->sampler.register_space;
-	hlsl.add_hlsl_resource_binding(bind);
+	hlsl.add_hlsl_resource_binding(to_hlsl_resource_binding(*binding));
 	return SPVC_SUCCESS;
 #else
 	(void)binding;
@@ -946,6 +1330,35 @@ spvc_result spvc_compiler_hlsl_add_resource_binding(spvc_compiler compiler,
 #endif
 }
 
+spvc_result spvc_compiler_hlsl_add_resource_bindings(spvc_compiler compiler,
+                                                     const spvc_hlsl_resource_binding *bindings, size_t count)
+{
+#if SPIRV_CROSS_C_API_HLSL
+	if (compiler->backend != SPVC_BACKEND_HLSL)
+	{
+		compiler->context->report_error("HLSL function used on a non-HLSL backend.");
+		return SPVC_ERROR_INVALID_ARGUMENT;
+	}
+
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		auto &hlsl = *static_cast<CompilerHLSL *>(compiler->compiler.get());
+		SmallVector<HLSLResourceBinding> binds;
+		binds.reserve(count);
+		for (size_t i = 0; i < count; i++)
+			binds.push_back(to_hlsl_resource_binding(bindings[i]));
+		hlsl.add_hlsl_resource_bindings(binds.data(), binds.size());
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
+	return SPVC_SUCCESS;
+#else
+	(void)bindings;
+	(void)count;
+	compiler->context->report_error("HLSL function used on a non-HLSL backend.");
+	return SPVC_ERROR_INVALID_ARGUMENT;
+#endif
+}
+
 spvc_bool spvc_compiler_hlsl_is_resource_used(spvc_compiler compiler, SpvExecutionModel model, unsigned set,
                                               unsigned binding)
 {
@@ -968,6 +1381,44 @@ spvc_bool spvc_compiler_hlsl_is_resource_used(spvc_compiler compiler, SpvExecuti
 #endif
 }
 
+spvc_result spvc_compiler_hlsl_build_root_signature(const spvc_compiler *compilers, size_t num_compilers,
+                                                    const char **root_signature)
+{
+	if (num_compilers == 0)
+		return SPVC_ERROR_INVALID_ARGUMENT;
+
+	spvc_compiler compiler = compilers[0];
+#if SPIRV_CROSS_C_API_HLSL
+	SmallVector<const CompilerHLSL *> hlsl_compilers;
+	for (size_t i = 0; i < num_compilers; i++)
+	{
+		if (compilers[i]->backend != SPVC_BACKEND_HLSL)
+		{
+			compiler->context->report_error("HLSL function used on a non-HLSL backend.");
+			return SPVC_ERROR_INVALID_ARGUMENT;
+		}
+		hlsl_compilers.push_back(static_cast<const CompilerHLSL *>(compilers[i]->compiler.get()));
+	}
+
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		auto signature = CompilerHLSL::build_root_signature(hlsl_compilers.data(), hlsl_compilers.size());
+		*root_signature = compiler->allocate_name(CompilerHLSL::root_signature_to_string(signature));
+		if (!*root_signature)
+		{
+			compiler->context->report_error("Out of memory.");
+			return SPVC_ERROR_OUT_OF_MEMORY;
+		}
+		return SPVC_SUCCESS;
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_INVALID_ARGUMENT)
+#else
+	(void)root_signature;
+	compiler->context->report_error("HLSL function used on a non-HLSL backend.");
+	return SPVC_ERROR_INVALID_ARGUMENT;
+#endif
+}
+
 spvc_bool spvc_compiler_msl_is_rasterization_disabled(spvc_compiler compiler)
 {
 #if SPIRV_CROSS_C_API_MSL
@@ -1122,6 +1573,20 @@ spvc_result spvc_compiler_msl_add_shader_input(spvc_compiler compiler, const spv
 #endif
 }
 
+#if SPIRV_CROSS_C_API_MSL
+static MSLResourceBinding to_msl_resource_binding(const spvc_msl_resource_binding &binding)
+{
+	MSLResourceBinding bind;
+	bind.binding = binding.binding;
+	bind.desc_set = binding.desc_set;
+	bind.stage = static_cast<spv::ExecutionModel>(binding.stage);
+	bind.msl_buffer = binding.msl_buffer;
+	bind.msl_texture = binding.msl_texture;
+	bind.msl_sampler = binding.msl_sampler;
+	return bind;
+}
+#endif
+
 spvc_result spvc_compiler_msl_add_resource_binding(spvc_compiler compiler,
                                                    const spvc_msl_resource_binding *binding)
 {
@@ -1133,14 +1598,7 @@ spvc_result spvc_compiler_msl_add_resource_binding(spvc_compiler compiler,
 	}
 
 	auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
-	MSLResourceBinding bind;
-	bind.binding = binding->binding;
-	bind.desc_set = binding->desc_set;
-	bind.stage = static_cast<spv::ExecutionModel>(binding->stage);
-	bind.msl_buffer = binding->msl_buffer;
-	bind.msl_texture = binding->msl_texture;
-	bind.msl_sampler = binding->msl_sampler;
-	msl.add_msl_resource_binding(bind);
+	msl.add_msl_resource_binding(to_msl_resource_binding(*binding));
 	return SPVC_SUCCESS;
 #else
 	(void)binding;
@@ -1149,6 +1607,35 @@ spvc_result spvc_compiler_msl_add_resource_binding(spvc_compiler compiler,
 #endif
 }
 
+spvc_result spvc_compiler_msl_add_resource_bindings(spvc_compiler compiler,
+                                                    const spvc_msl_resource_binding *bindings, size_t count)
+{
+#if SPIRV_CROSS_C_API_MSL
+	if (compiler->backend != SPVC_BACKEND_MSL)
+	{
+		compiler->context->report_error("MSL function used on a non-MSL backend.");
+		return SPVC_ERROR_INVALID_ARGUMENT;
+	}
+
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
+		SmallVector<MSLResourceBinding> binds;
+		binds.reserve(count);
+		for (size_t i = 0; i < count; i++)
+			binds.push_back(to_msl_resource_binding(bindings[i]));
+		msl.add_msl_resource_bindings(binds.data(), binds.size());
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
+	return SPVC_SUCCESS;
+#else
+	(void)bindings;
+	(void)count;
+	compiler->context->report_error("MSL function used on a non-MSL backend.");
+	return SPVC_ERROR_INVALID_ARGUMENT;
+#endif
+}
+
 spvc_result spvc_compiler_msl_add_dynamic_buffer(spvc_compiler compiler, unsigned desc_set, unsigned binding, unsigned index)
 {
 #if SPIRV_CROSS_C_API_MSL
@@ -1203,13 +1690,114 @@ spvc_result spvc_compiler_msl_add_discrete_descriptor_set(spvc_compiler compiler
 	msl.add_discrete_descriptor_set(desc_set);
 	return SPVC_SUCCESS;
 #else
-	(void)desc_set;
+	(void)desc_set;
+	compiler->context->report_error("MSL function used on a non-MSL backend.");
+	return SPVC_ERROR_INVALID_ARGUMENT;
+#endif
+}
+
+spvc_result spvc_compiler_msl_set_argument_buffer_device_address_space(spvc_compiler compiler, unsigned desc_set, spvc_bool device_address)
+{
+#if SPIRV_CROSS_C_API_MSL
+	if (compiler->backend != SPVC_BACKEND_MSL)
+	{
+		compiler->context->report_error("MSL function used on a non-MSL backend.");
+		return SPVC_ERROR_INVALID_ARGUMENT;
+	}
+
+	auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
+	msl.set_argument_buffer_device_address_space(desc_set, bool(device_address));
+	return SPVC_SUCCESS;
+#else
+	(void)desc_set;
+	(void)device_address;
+	compiler->context->report_error("MSL function used on a non-MSL backend.");
+	return SPVC_ERROR_INVALID_ARGUMENT;
+#endif
+}
+
+spvc_bool spvc_compiler_msl_is_shader_input_used(spvc_compiler compiler, unsigned location)
+{
+#if SPIRV_CROSS_C_API_MSL
+	if (compiler->backend != SPVC_BACKEND_MSL)
+	{
+		compiler->context->report_error("MSL function used on a non-MSL backend.");
+		return SPVC_FALSE;
+	}
+
+	auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
+	return msl.is_msl_shader_input_used(location) ? SPVC_TRUE : SPVC_FALSE;
+#else
+	(void)location;
+	compiler->context->report_error("MSL function used on a non-MSL backend.");
+	return SPVC_FALSE;
+#endif
+}
+
+spvc_bool spvc_compiler_msl_is_vertex_attribute_used(spvc_compiler compiler, unsigned location)
+{
+	return spvc_compiler_msl_is_shader_input_used(compiler, location);
+}
+
+spvc_bool spvc_compiler_msl_is_resource_used(spvc_compiler compiler, SpvExecutionModel model, unsigned set,
+                                             unsigned binding)
+{
+#if SPIRV_CROSS_C_API_MSL
+	if (compiler->backend != SPVC_BACKEND_MSL)
+	{
+		compiler->context->report_error("MSL function used on a non-MSL backend.");
+		return SPVC_FALSE;
+	}
+
+	auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
+	return msl.is_msl_resource_binding_used(static_cast<spv::ExecutionModel>(model), set, binding) ? SPVC_TRUE :
+	                                                                                                 SPVC_FALSE;
+#else
+	(void)model;
+	(void)set;
+	(void)binding;
+	compiler->context->report_error("MSL function used on a non-MSL backend.");
+	return SPVC_FALSE;
+#endif
+}
+
+spvc_result spvc_compiler_msl_set_combined_sampler_suffix(spvc_compiler compiler, const char *suffix)
+{
+#if SPIRV_CROSS_C_API_MSL
+	if (compiler->backend != SPVC_BACKEND_MSL)
+	{
+		compiler->context->report_error("MSL function used on a non-MSL backend.");
+		return SPVC_ERROR_INVALID_ARGUMENT;
+	}
+
+	auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
+	msl.set_combined_sampler_suffix(suffix);
+	return SPVC_SUCCESS;
+#else
+	(void)suffix;
+	compiler->context->report_error("MSL function used on a non-MSL backend.");
+	return SPVC_ERROR_INVALID_ARGUMENT;
+#endif
+}
+
+const char *spvc_compiler_msl_get_combined_sampler_suffix(spvc_compiler compiler)
+{
+#if SPIRV_CROSS_C_API_MSL
+	if (compiler->backend != SPVC_BACKEND_MSL)
+	{
+		compiler->context->report_error("MSL function used on a non-MSL backend.");
+		return "";
+	}
+
+	auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
+	return msl.get_combined_sampler_suffix();
+#else
 	compiler->context->report_error("MSL function used on a non-MSL backend.");
-	return SPVC_ERROR_INVALID_ARGUMENT;
+	return "";
 #endif
 }
 
-spvc_result spvc_compiler_msl_set_argument_buffer_device_address_space(spvc_compiler compiler, unsigned desc_set, spvc_bool device_address)
+spvc_result spvc_compiler_msl_set_helper_library_include(spvc_compiler compiler, const char *name)
 {
 #if SPIRV_CROSS_C_API_MSL
 	if (compiler->backend != SPVC_BACKEND_MSL)
@@ -1219,62 +1807,91 @@ spvc_result spvc_compiler_msl_set_argument_buffer_device_address_space(spvc_comp
 	}
 
 	auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
-	msl.set_argument_buffer_device_address_space(desc_set, bool(device_address));
+	msl.set_helper_library_include(name);
 	return SPVC_SUCCESS;
 #else
-	(void)desc_set;
-	(void)device_address;
+	(void)name;
 	compiler->context->report_error("MSL function used on a non-MSL backend.");
 	return SPVC_ERROR_INVALID_ARGUMENT;
 #endif
 }
 
-spvc_bool spvc_compiler_msl_is_shader_input_used(spvc_compiler compiler, unsigned location)
+spvc_result spvc_compiler_msl_add_helper_library_requirements(spvc_compiler compiler, spvc_compiler other)
 {
 #if SPIRV_CROSS_C_API_MSL
-	if (compiler->backend != SPVC_BACKEND_MSL)
+	if (compiler->backend != SPVC_BACKEND_MSL || other->backend != SPVC_BACKEND_MSL)
 	{
 		compiler->context->report_error("MSL function used on a non-MSL backend.");
-		return SPVC_FALSE;
+		return SPVC_ERROR_INVALID_ARGUMENT;
 	}
 
 	auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
-	return msl.is_msl_shader_input_used(location) ? SPVC_TRUE : SPVC_FALSE;
+	msl.add_helper_library_requirements(*static_cast<const CompilerMSL *>(other->compiler.get()));
+	return SPVC_SUCCESS;
 #else
-	(void)location;
+	(void)other;
 	compiler->context->report_error("MSL function used on a non-MSL backend.");
-	return SPVC_FALSE;
+	return SPVC_ERROR_INVALID_ARGUMENT;
 #endif
 }
 
-spvc_bool spvc_compiler_msl_is_vertex_attribute_used(spvc_compiler compiler, unsigned location)
-{
-	return spvc_compiler_msl_is_shader_input_used(compiler, location);
-}
-
-spvc_bool spvc_compiler_msl_is_resource_used(spvc_compiler compiler, SpvExecutionModel model, unsigned set,
-                                             unsigned binding)
+spvc_result spvc_compiler_msl_compile_helper_library(spvc_compiler compiler, const char **source)
 {
 #if SPIRV_CROSS_C_API_MSL
 	if (compiler->backend != SPVC_BACKEND_MSL)
 	{
 		compiler->context->report_error("MSL function used on a non-MSL backend.");
-		return SPVC_FALSE;
+		return SPVC_ERROR_INVALID_ARGUMENT;
 	}
 
-	auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
-	return msl.is_msl_resource_binding_used(static_cast<spv::ExecutionModel>(model), set, binding) ? SPVC_TRUE :
-	                                                                                                 SPVC_FALSE;
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
+		*source = compiler->allocate_name(msl.compile_helper_library());
+		if (!*source)
+		{
+			compiler->context->report_error("Out of memory.");
+			return SPVC_ERROR_OUT_OF_MEMORY;
+		}
+		return SPVC_SUCCESS;
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_UNSUPPORTED_SPIRV)
 #else
-	(void)model;
-	(void)set;
-	(void)binding;
+	(void)source;
 	compiler->context->report_error("MSL function used on a non-MSL backend.");
-	return SPVC_FALSE;
+	return SPVC_ERROR_INVALID_ARGUMENT;
 #endif
 }
 
-spvc_result spvc_compiler_msl_set_combined_sampler_suffix(spvc_compiler compiler, const char *suffix)
+#if SPIRV_CROSS_C_API_MSL
+static spvc_result spvc_return_msl_argument_buffer_layout(spvc_compiler compiler,
+                                                          const SmallVector<MSLArgumentBufferMember> &layout,
+                                                          const spvc_msl_argument_buffer_member **members,
+                                                          size_t *num_members)
+{
+	SmallVector<spvc_msl_argument_buffer_member> translated;
+	translated.reserve(layout.size());
+	for (auto &m : layout)
+	{
+		spvc_msl_argument_buffer_member trans = {
+			m.desc_set, m.binding, m.plane, static_cast<spvc_msl_argument_buffer_member_type>(m.type),
+			m.msl_id, m.count, m.offset, m.size, m.alignment, m.stage_mask
+		};
+		translated.push_back(trans);
+	}
+
+	auto ptr = spvc_allocate<TemporaryBuffer<spvc_msl_argument_buffer_member>>();
+	ptr->buffer = std::move(translated);
+	*members = ptr->buffer.data();
+	*num_members = ptr->buffer.size();
+	compiler->allocations.push_back(std::move(ptr));
+	return SPVC_SUCCESS;
+}
+#endif
+
+spvc_result spvc_compiler_msl_get_argument_buffer_layout(spvc_compiler compiler, unsigned desc_set,
+                                                         const spvc_msl_argument_buffer_member **members,
+                                                         size_t *num_members)
 {
 #if SPIRV_CROSS_C_API_MSL
 	if (compiler->backend != SPVC_BACKEND_MSL)
@@ -1283,30 +1900,55 @@ spvc_result spvc_compiler_msl_set_combined_sampler_suffix(spvc_compiler compiler
 		return SPVC_ERROR_INVALID_ARGUMENT;
 	}
 
-	auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
-	msl.set_combined_sampler_suffix(suffix);
-	return SPVC_SUCCESS;
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
+		return spvc_return_msl_argument_buffer_layout(compiler, msl.get_argument_buffer_layout(desc_set), members,
+		                                              num_members);
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
 #else
-	(void)suffix;
+	(void)desc_set;
+	(void)members;
+	(void)num_members;
 	compiler->context->report_error("MSL function used on a non-MSL backend.");
 	return SPVC_ERROR_INVALID_ARGUMENT;
 #endif
 }
 
-const char *spvc_compiler_msl_get_combined_sampler_suffix(spvc_compiler compiler)
+spvc_result spvc_compiler_msl_merge_argument_buffer_layouts(const spvc_compiler *compilers, size_t num_compilers,
+                                                            unsigned desc_set,
+                                                            const spvc_msl_argument_buffer_member **members,
+                                                            size_t *num_members)
 {
+	if (num_compilers == 0)
+		return SPVC_ERROR_INVALID_ARGUMENT;
+
+	spvc_compiler compiler = compilers[0];
 #if SPIRV_CROSS_C_API_MSL
-	if (compiler->backend != SPVC_BACKEND_MSL)
+	SmallVector<const CompilerMSL *> msl_compilers;
+	for (size_t i = 0; i < num_compilers; i++)
 	{
-		compiler->context->report_error("MSL function used on a non-MSL backend.");
-		return "";
+		if (compilers[i]->backend != SPVC_BACKEND_MSL)
+		{
+			compiler->context->report_error("MSL function used on a non-MSL backend.");
+			return SPVC_ERROR_INVALID_ARGUMENT;
+		}
+		msl_compilers.push_back(static_cast<const CompilerMSL *>(compilers[i]->compiler.get()));
 	}
 
-	auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
-	return msl.get_combined_sampler_suffix();
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		auto layout = CompilerMSL::merge_argument_buffer_layouts(msl_compilers.data(), msl_compilers.size(), desc_set);
+		return spvc_return_msl_argument_buffer_layout(compiler, layout, members, num_members);
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_INVALID_ARGUMENT)
 #else
+	(void)desc_set;
+	(void)members;
+	(void)num_members;
 	compiler->context->report_error("MSL function used on a non-MSL backend.");
-	return "";
+	return SPVC_ERROR_INVALID_ARGUMENT;
 #endif
 }
 
@@ -1506,18 +2148,36 @@ unsigned spvc_compiler_msl_get_automatic_resource_binding_secondary(spvc_compile
 #endif
 }
 
+unsigned spvc_compiler_msl_get_tess_control_output_staging_size(spvc_compiler compiler)
+{
+#if SPIRV_CROSS_C_API_MSL
+	if (compiler->backend != SPVC_BACKEND_MSL)
+	{
+		compiler->context->report_error("MSL function used on a non-MSL backend.");
+		return 0;
+	}
+
+	auto &msl = *static_cast<CompilerMSL *>(compiler->compiler.get());
+	return msl.get_tess_control_output_staging_size();
+#else
+	compiler->context->report_error("MSL function used on a non-MSL backend.");
+	return 0;
+#endif
+}
+
 spvc_result spvc_compiler_compile(spvc_compiler compiler, const char **source)
 {
 	SPVC_BEGIN_SAFE_SCOPE
 	{
-		auto result = compiler->compiler->compile();
+		auto &cache = compiler->context->compilation_cache;
+		auto result = cache ? cache->compile(*compiler->compiler) : compiler->compiler->compile();
 		if (result.empty())
 		{
 			compiler->context->report_error("Unsupported SPIR-V.");
 			return SPVC_ERROR_UNSUPPORTED_SPIRV;
 		}
 
-		*source = compiler->context->allocate_name(result);
+		*source = compiler->allocate_name(result);
 		if (!*source)
 		{
 			compiler->context->report_error("Out of memory.");
@@ -1525,7 +2185,89 @@ spvc_result spvc_compiler_compile(spvc_compiler compiler, const char **source)
 		}
 		return SPVC_SUCCESS;
 	}
-	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_UNSUPPORTED_SPIRV)
+	SPVC_END_COMPILE_SAFE_SCOPE(compiler->context, SPVC_ERROR_UNSUPPORTED_SPIRV)
+}
+
+void spvc_compile_budget_init(spvc_compile_budget *budget)
+{
+	Compiler::CompileBudget defaults;
+	budget->max_time_us = defaults.max_time_us;
+	budget->max_expression_size = defaults.max_expression_size;
+	budget->max_forwarding_depth = defaults.max_forwarding_depth;
+	budget->max_output_size = defaults.max_output_size;
+}
+
+spvc_result spvc_compiler_set_compile_budget(spvc_compiler compiler, const spvc_compile_budget *budget)
+{
+	if (!budget)
+	{
+		compiler->context->report_error("Budget must not be NULL.");
+		return SPVC_ERROR_INVALID_ARGUMENT;
+	}
+
+	Compiler::CompileBudget b;
+	b.max_time_us = budget->max_time_us;
+	b.max_expression_size = budget->max_expression_size;
+	b.max_forwarding_depth = budget->max_forwarding_depth;
+	b.max_output_size = budget->max_output_size;
+	b.cancel = &compiler->cancelled;
+	compiler->cancelled.store(false, std::memory_order_relaxed);
+	compiler->compiler->set_compile_budget(b);
+	return SPVC_SUCCESS;
+}
+
+void spvc_compiler_cancel_compile(spvc_compiler compiler)
+{
+	compiler->cancelled.store(true, std::memory_order_relaxed);
+}
+
+namespace
+{
+struct CallbackOutputSink : OutputSink
+{
+	CallbackOutputSink(spvc_output_callback callback_, void *userdata_)
+	    : callback(callback_)
+	    , userdata(userdata_)
+	{
+	}
+
+	void write(const char *data, size_t size) override
+	{
+		callback(userdata, data, size);
+		written += size;
+	}
+
+	spvc_output_callback callback;
+	void *userdata;
+	size_t written = 0;
+};
+} // namespace
+
+spvc_result spvc_compiler_compile_to_callback(spvc_compiler compiler, spvc_output_callback callback, void *userdata)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		CallbackOutputSink sink(callback, userdata);
+
+		// The cache needs the complete string anyways.
+		auto &cache = compiler->context->compilation_cache;
+		if (cache)
+		{
+			auto result = cache->compile(*compiler->compiler);
+			if (!result.empty())
+				sink.write(result.data(), result.size());
+		}
+		else
+			compiler->compiler->compile_to_sink(sink);
+
+		if (!sink.written)
+		{
+			compiler->context->report_error("Unsupported SPIR-V.");
+			return SPVC_ERROR_UNSUPPORTED_SPIRV;
+		}
+		return SPVC_SUCCESS;
+	}
+	SPVC_END_COMPILE_SAFE_SCOPE(compiler->context, SPVC_ERROR_UNSUPPORTED_SPIRV)
 }
 
 bool spvc_resources_s::copy_resources(SmallVector<spvc_reflected_resource> &outputs,
@@ -1537,7 +2279,7 @@ bool spvc_resources_s::copy_resources(SmallVector<spvc_reflected_resource> &outp
 		r.base_type_id = i.base_type_id;
 		r.type_id = i.type_id;
 		r.id = i.id;
-		r.name = context->allocate_name(i.name);
+		r.name = compiler->allocate_name(i.name);
 		if (!r.name)
 			return false;
 
@@ -1591,7 +2333,7 @@ spvc_result spvc_compiler_get_active_interface_variables(spvc_compiler compiler,
 		auto active = compiler->compiler->get_active_interface_variables();
 		ptr->set = std::move(active);
 		*set = ptr.get();
-		compiler->context->allocations.push_back(std::move(ptr));
+		compiler->allocations.push_back(std::move(ptr));
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_INVALID_ARGUMENT)
 	return SPVC_SUCCESS;
@@ -1620,6 +2362,7 @@ spvc_result spvc_compiler_create_shader_resources_for_active_variables(spvc_comp
 		}
 
 		res->context = compiler->context;
+		res->compiler = compiler;
 		auto accessed_resources = compiler->compiler->get_shader_resources(set->set);
 
 		if (!res->copy_resources(accessed_resources))
@@ -1628,7 +2371,7 @@ spvc_result spvc_compiler_create_shader_resources_for_active_variables(spvc_comp
 			return SPVC_ERROR_OUT_OF_MEMORY;
 		}
 		*resources = res.get();
-		compiler->context->allocations.push_back(std::move(res));
+		compiler->allocations.push_back(std::move(res));
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
 	return SPVC_SUCCESS;
@@ -1646,6 +2389,7 @@ spvc_result spvc_compiler_create_shader_resources(spvc_compiler compiler, spvc_r
 		}
 
 		res->context = compiler->context;
+		res->compiler = compiler;
 		auto accessed_resources = compiler->compiler->get_shader_resources();
 
 		if (!res->copy_resources(accessed_resources))
@@ -1655,7 +2399,7 @@ spvc_result spvc_compiler_create_shader_resources(spvc_compiler compiler, spvc_r
 		}
 
 		*resources = res.get();
-		compiler->context->allocations.push_back(std::move(res));
+		compiler->allocations.push_back(std::move(res));
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
 	return SPVC_SUCCESS;
@@ -1765,6 +2509,58 @@ void spvc_compiler_set_member_name(spvc_compiler compiler, spvc_type_id id, unsi
 	compiler->compiler->set_member_name(id, member_index, argument);
 }
 
+spvc_result spvc_compiler_remap_resource_bindings(spvc_compiler compiler, const spvc_resource_binding_remap *remaps,
+                                                  size_t count, unsigned *num_remapped)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		SmallVector<ResourceBindingRemap> table;
+		table.reserve(count);
+		for (size_t i = 0; i < count; i++)
+			table.push_back({ remaps[i].desc_set, remaps[i].binding, remaps[i].new_desc_set, remaps[i].new_binding });
+
+		uint32_t remapped = compiler->compiler->remap_resource_bindings(table.data(), table.size());
+		if (num_remapped)
+			*num_remapped = remapped;
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
+	return SPVC_SUCCESS;
+}
+
+spvc_result spvc_compiler_pad_workgroup_arrays(spvc_compiler compiler, unsigned *num_padded)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		uint32_t padded = compiler->compiler->pad_workgroup_arrays();
+		if (num_padded)
+			*num_padded = padded;
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
+	return SPVC_SUCCESS;
+}
+
+spvc_result spvc_compiler_alias_workgroup_variables(spvc_compiler compiler, unsigned *num_aliased)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		uint32_t aliased = compiler->compiler->alias_workgroup_variables();
+		if (num_aliased)
+			*num_aliased = aliased;
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
+	return SPVC_SUCCESS;
+}
+
+spvc_result spvc_compiler_get_workgroup_memory_size(spvc_compiler compiler, unsigned *size)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		*size = compiler->compiler->get_workgroup_memory_size();
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_INVALID_ARGUMENT)
+	return SPVC_SUCCESS;
+}
+
 void spvc_compiler_unset_decoration(spvc_compiler compiler, SpvId id, SpvDecoration decoration)
 {
 	compiler->compiler->unset_decoration(id, static_cast<spv::Decoration>(decoration));
@@ -1835,7 +2631,7 @@ spvc_result spvc_compiler_get_entry_points(spvc_compiler compiler, const spvc_en
 		{
 			spvc_entry_point new_entry;
 			new_entry.execution_model = static_cast<SpvExecutionModel>(entry.execution_model);
-			new_entry.name = compiler->context->allocate_name(entry.name);
+			new_entry.name = compiler->allocate_name(entry.name);
 			if (!new_entry.name)
 			{
 				compiler->context->report_error("Out of memory.");
@@ -1848,7 +2644,7 @@ spvc_result spvc_compiler_get_entry_points(spvc_compiler compiler, const spvc_en
 		ptr->buffer = std::move(translated);
 		*entry_points = ptr->buffer.data();
 		*num_entry_points = ptr->buffer.size();
-		compiler->context->allocations.push_back(std::move(ptr));
+		compiler->allocations.push_back(std::move(ptr));
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
 	return SPVC_SUCCESS;
@@ -1878,7 +2674,7 @@ const char *spvc_compiler_get_cleansed_entry_point_name(spvc_compiler compiler,
 	{
 		auto cleansed_name =
 		    compiler->compiler->get_cleansed_entry_point_name(name, static_cast<spv::ExecutionModel>(model));
-		return compiler->context->allocate_name(cleansed_name);
+		return compiler->allocate_name(cleansed_name);
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, nullptr)
 }
@@ -1911,7 +2707,7 @@ spvc_result spvc_compiler_get_execution_modes(spvc_compiler compiler, const SpvE
 
 		*modes = ptr->buffer.data();
 		*num_modes = ptr->buffer.size();
-		compiler->context->allocations.push_back(std::move(ptr));
+		compiler->allocations.push_back(std::move(ptr));
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
 	return SPVC_SUCCESS;
@@ -2146,7 +2942,7 @@ spvc_result spvc_compiler_get_combined_image_samplers(spvc_compiler compiler,
 		ptr->buffer = std::move(translated);
 		*samplers = ptr->buffer.data();
 		*num_samplers = ptr->buffer.size();
-		compiler->context->allocations.push_back(std::move(ptr));
+		compiler->allocations.push_back(std::move(ptr));
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
 	return SPVC_SUCCESS;
@@ -2171,12 +2967,28 @@ spvc_result spvc_compiler_get_specialization_constants(spvc_compiler compiler,
 		ptr->buffer = std::move(translated);
 		*constants = ptr->buffer.data();
 		*num_constants = ptr->buffer.size();
-		compiler->context->allocations.push_back(std::move(ptr));
+		compiler->allocations.push_back(std::move(ptr));
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
 	return SPVC_SUCCESS;
 }
 
+spvc_result spvc_compiler_fold_specialization_constants(spvc_compiler compiler,
+                                                        const spvc_specialization_constant_value *values,
+                                                        size_t num_values)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		SmallVector<SpecializationConstantValue> translated;
+		translated.reserve(num_values);
+		for (size_t i = 0; i < num_values; i++)
+			translated.push_back({ values[i].constant_id, values[i].value });
+		compiler->compiler->fold_specialization_constants(translated);
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_INVALID_ARGUMENT)
+	return SPVC_SUCCESS;
+}
+
 spvc_constant spvc_compiler_get_constant_handle(spvc_compiler compiler, spvc_variable_id id)
 {
 	SPVC_BEGIN_SAFE_SCOPE
@@ -2224,7 +3036,7 @@ spvc_result spvc_compiler_get_active_buffer_ranges(spvc_compiler compiler,
 		ptr->buffer = std::move(translated);
 		*ranges = ptr->buffer.data();
 		*num_ranges = ptr->buffer.size();
-		compiler->context->allocations.push_back(std::move(ptr));
+		compiler->allocations.push_back(std::move(ptr));
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
 	return SPVC_SUCCESS;
@@ -2278,7 +3090,7 @@ int spvc_constant_get_scalar_i8(spvc_constant constant, unsigned column, unsigne
 void spvc_constant_get_subconstants(spvc_constant constant, const spvc_constant_id **constituents, size_t *count)
 {
 	static_assert(sizeof(spvc_constant_id) == sizeof(constant->subconstants.front()), "ID size is not consistent.");
-	*constituents = reinterpret_cast<spvc_constant_id *>(constant->subconstants.data());
+	*constituents = reinterpret_cast<const spvc_constant_id *>(constant->subconstants.data());
 	*count = constant->subconstants.size();
 }
 
@@ -2340,13 +3152,13 @@ spvc_result spvc_compiler_get_declared_extensions(spvc_compiler compiler, const
 		SmallVector<const char *> duped;
 		duped.reserve(exts.size());
 		for (auto &ext : exts)
-			duped.push_back(compiler->context->allocate_name(ext));
+			duped.push_back(compiler->allocate_name(ext));
 
 		auto ptr = spvc_allocate<TemporaryBuffer<const char *>>();
 		ptr->buffer = std::move(duped);
 		*extensions = ptr->buffer.data();
 		*num_extensions = ptr->buffer.size();
-		compiler->context->allocations.push_back(std::move(ptr));
+		compiler->allocations.push_back(std::move(ptr));
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_OUT_OF_MEMORY)
 	return SPVC_SUCCESS;
@@ -2357,7 +3169,7 @@ const char *spvc_compiler_get_remapped_declared_block_name(spvc_compiler compile
 	SPVC_BEGIN_SAFE_SCOPE
 	{
 		auto name = compiler->compiler->get_remapped_declared_block_name(id);
-		return compiler->context->allocate_name(name);
+		return compiler->allocate_name(name);
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, nullptr)
 }
@@ -2374,7 +3186,7 @@ spvc_result spvc_compiler_get_buffer_block_decorations(spvc_compiler compiler, s
 
 		*decorations = bitset->buffer.data();
 		*num_decorations = bitset->buffer.size();
-		compiler->context->allocations.push_back(std::move(bitset));
+		compiler->allocations.push_back(std::move(bitset));
 	}
 	SPVC_END_SAFE_SCOPE(compiler->context, SPVC_ERROR_INVALID_ARGUMENT)
 	return SPVC_SUCCESS;
@@ -2493,6 +3305,202 @@ unsigned spvc_compiler_get_current_id_bound(spvc_compiler compiler)
 	return compiler->compiler->get_current_id_bound();
 }
 
+unsigned spvc_compiler_get_compile_pass_count(spvc_compiler compiler)
+{
+	return compiler->compiler->get_compile_pass_count();
+}
+
+unsigned spvc_compiler_get_recompile_reason_count(spvc_compiler compiler, spvc_recompile_reason reason)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		return compiler->compiler->get_recompile_reason_count(static_cast<RecompileReason>(reason));
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, 0)
+}
+
+static size_t get_ir_memory_usage(const ParsedIR::MemoryUsage &usage, spvc_memory_category category)
+{
+	switch (category)
+	{
+	case SPVC_MEMORY_CATEGORY_OBJECT_POOLS:
+		return usage.pool_arena;
+	case SPVC_MEMORY_CATEGORY_OBJECT_POOLS_LIVE:
+	{
+		size_t live = 0;
+		for (auto &pool : usage.pools)
+			live += pool.live;
+		return live;
+	}
+	case SPVC_MEMORY_CATEGORY_OBJECTS:
+		return usage.objects;
+	case SPVC_MEMORY_CATEGORY_META:
+		return usage.meta;
+	case SPVC_MEMORY_CATEGORY_DECORATION_STRINGS:
+		return usage.decoration_strings;
+	case SPVC_MEMORY_CATEGORY_SPIRV:
+		return usage.spirv;
+	case SPVC_MEMORY_CATEGORY_IR_OTHER:
+		return usage.other;
+	case SPVC_MEMORY_CATEGORY_TOTAL:
+		return usage.total();
+	default:
+		return 0;
+	}
+}
+
+size_t spvc_compiler_get_memory_usage(spvc_compiler compiler, spvc_memory_category category)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		auto usage = compiler->compiler->get_memory_usage();
+		size_t api = compiler->string_arena ? compiler->string_arena->get_reserved_size() : 0;
+
+		switch (category)
+		{
+		case SPVC_MEMORY_CATEGORY_CFGS:
+			return usage.cfgs;
+		case SPVC_MEMORY_CATEGORY_ANALYSIS:
+			return usage.analysis;
+		case SPVC_MEMORY_CATEGORY_OUTPUT:
+			return usage.output;
+		case SPVC_MEMORY_CATEGORY_API:
+			return api;
+		case SPVC_MEMORY_CATEGORY_TOTAL:
+			return usage.total() + api;
+		default:
+			return get_ir_memory_usage(usage.ir, category);
+		}
+	}
+	SPVC_END_SAFE_SCOPE(compiler->context, 0)
+}
+
+size_t spvc_parsed_ir_get_memory_usage(spvc_parsed_ir parsed_ir, spvc_memory_category category)
+{
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		return get_ir_memory_usage(parsed_ir->parsed.get_memory_usage(), category);
+	}
+	SPVC_END_SAFE_SCOPE(parsed_ir->context, 0)
+}
+
+void spvc_compiler_shrink_to_fit(spvc_compiler compiler)
+{
+	compiler->compiler->shrink_to_fit();
+}
+
+// Runs a batch job inside its own context, so errors are reported per job.
+static spvc_result spvc_compile_batch_job(spvc_context context, const spvc_batch_job &job, CompilationCache *cache,
+                                          string &source)
+{
+	spvc_parsed_ir parsed_ir = nullptr;
+	spvc_compiler compiler = nullptr;
+	spvc_compiler_options options = nullptr;
+
+	// The job words outlive the per-job context, so there is no need to copy them.
+	spvc_result ret = spvc_context_parse_spirv_borrowed(context, job.spirv, job.word_count, &parsed_ir);
+	if (ret != SPVC_SUCCESS)
+		return ret;
+
+	ret = spvc_context_create_compiler(context, job.backend, parsed_ir, SPVC_CAPTURE_MODE_TAKE_OWNERSHIP, &compiler);
+	if (ret != SPVC_SUCCESS)
+		return ret;
+
+	if (job.num_options != 0)
+	{
+		ret = spvc_compiler_create_compiler_options(compiler, &options);
+		if (ret != SPVC_SUCCESS)
+			return ret;
+
+		for (size_t i = 0; i < job.num_options; i++)
+		{
+			ret = spvc_compiler_options_set_uint(options, job.options[i].option, job.options[i].value);
+			if (ret != SPVC_SUCCESS)
+				return ret;
+		}
+
+		ret = spvc_compiler_install_compiler_options(compiler, options);
+		if (ret != SPVC_SUCCESS)
+			return ret;
+	}
+
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		source = cache ? cache->compile(*compiler->compiler) : compiler->compiler->compile();
+		if (source.empty())
+		{
+			context->report_error("Unsupported SPIR-V.");
+			return SPVC_ERROR_UNSUPPORTED_SPIRV;
+		}
+	}
+	SPVC_END_COMPILE_SAFE_SCOPE(context, SPVC_ERROR_UNSUPPORTED_SPIRV)
+	return SPVC_SUCCESS;
+}
+
+spvc_result spvc_context_compile_batch(spvc_context context, const spvc_batch_job *jobs, size_t num_jobs,
+                                       unsigned num_threads, spvc_batch_result *results)
+{
+	if (num_jobs != 0 && (!jobs || !results))
+	{
+		context->report_error("Jobs and results must not be NULL.");
+		return SPVC_ERROR_INVALID_ARGUMENT;
+	}
+
+	SPVC_BEGIN_SAFE_SCOPE
+	{
+		struct JobOutput
+		{
+			spvc_result result = SPVC_SUCCESS;
+			string source;
+			string error;
+		};
+
+		SmallVector<JobOutput> outputs(num_jobs);
+		auto *cache = context->compilation_cache.get();
+
+		ThreadPool pool(num_threads);
+		pool.parallel_for(num_jobs, [&](size_t index) {
+			auto &output = outputs[index];
+			spvc_context job_context = nullptr;
+			if (spvc_context_create(&job_context) != SPVC_SUCCESS)
+			{
+				output.result = SPVC_ERROR_OUT_OF_MEMORY;
+				return;
+			}
+
+			output.result = spvc_compile_batch_job(job_context, jobs[index], cache, output.source);
+			if (output.result != SPVC_SUCCESS)
+			{
+				output.source.clear();
+				output.error = job_context->last_error;
+			}
+			spvc_context_destroy(job_context);
+		});
+
+		for (size_t i = 0; i < num_jobs; i++)
+		{
+			auto &output = outputs[i];
+			auto &result = results[i];
+			result.result = output.result;
+			result.source = nullptr;
+			result.error = nullptr;
+
+			if (output.result == SPVC_SUCCESS)
+				result.source = context->allocate_name(output.source);
+			else
+				result.error = context->allocate_name(output.error.empty() ? "Out of memory." : output.error);
+
+			if (!result.source && !result.error)
+			{
+				context->report_error("Out of memory.");
+				return SPVC_ERROR_OUT_OF_MEMORY;
+			}
+		}
+	}
+	SPVC_END_SAFE_SCOPE(context, SPVC_ERROR_OUT_OF_MEMORY)
+	return SPVC_SUCCESS;
+}
+
 void spvc_get_version(unsigned *major, unsigned *minor, unsigned *patch)
 {
 	*major = SPVC_C_API_VERSION_MAJOR;
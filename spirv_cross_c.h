@@ -40,7 +40,7 @@ extern "C" {
 /* Bumped if ABI or API breaks backwards compatibility. */
 #define SPVC_C_API_VERSION_MAJOR 0
 /* Bumped if APIs or enumerations are added in a backwards compatible way. */
-#define SPVC_C_API_VERSION_MINOR 44
+#define SPVC_C_API_VERSION_MINOR 68
 /* Bumped if internal implementation details change. */
 #define SPVC_C_API_VERSION_PATCH 0
 
@@ -121,6 +121,13 @@ typedef struct spvc_specialization_constant
 	unsigned constant_id;
 } spvc_specialization_constant;
 
+/* See C++ API. */
+typedef struct spvc_specialization_constant_value
+{
+	unsigned constant_id;
+	unsigned long long value;
+} spvc_specialization_constant_value;
+
 /* See C++ API. */
 typedef struct spvc_buffer_range
 {
@@ -171,6 +178,9 @@ typedef enum spvc_result
 	/* Invalid API argument. */
 	SPVC_ERROR_INVALID_ARGUMENT = -4,
 
+	/* Compilation hit a limit set with spvc_compiler_set_compile_budget(), or was cancelled. */
+	SPVC_ERROR_BUDGET_EXCEEDED = -5,
+
 	SPVC_ERROR_INT_MAX = 0x7fffffff
 } spvc_result;
 
@@ -351,6 +361,31 @@ SPVC_PUBLIC_API void spvc_msl_resource_binding_init(spvc_msl_resource_binding *b
 #define SPVC_MSL_BUFFER_SIZE_BUFFER_BINDING (~(2u))
 #define SPVC_MSL_ARGUMENT_BUFFER_BINDING (~(3u))
 
+/* Maps to C++ API. */
+typedef enum spvc_msl_argument_buffer_member_type
+{
+	SPVC_MSL_ARGUMENT_BUFFER_MEMBER_BUFFER = 0,
+	SPVC_MSL_ARGUMENT_BUFFER_MEMBER_TEXTURE = 1,
+	SPVC_MSL_ARGUMENT_BUFFER_MEMBER_SAMPLER = 2,
+	SPVC_MSL_ARGUMENT_BUFFER_MEMBER_INLINE_UNIFORM_BLOCK = 3,
+	SPVC_MSL_ARGUMENT_BUFFER_MEMBER_INT_MAX = 0x7fffffff
+} spvc_msl_argument_buffer_member_type;
+
+/* Maps to C++ API. */
+typedef struct spvc_msl_argument_buffer_member
+{
+	unsigned desc_set;
+	unsigned binding;
+	unsigned plane;
+	spvc_msl_argument_buffer_member_type type;
+	unsigned msl_id;
+	unsigned count;
+	unsigned offset;
+	unsigned size;
+	unsigned alignment;
+	unsigned stage_mask;
+} spvc_msl_argument_buffer_member;
+
 /* Obsolete. Sticks around for backwards compatibility. */
 #define SPVC_MSL_AUX_BUFFER_STRUCT_VERSION 1
 
@@ -659,6 +694,20 @@ typedef enum spvc_compiler_option
 	SPVC_COMPILER_OPTION_MSL_FIXED_SUBGROUP_SIZE = 74 | SPVC_COMPILER_OPTION_MSL_BIT,
 	SPVC_COMPILER_OPTION_MSL_FORCE_SAMPLE_RATE_SHADING = 75 | SPVC_COMPILER_OPTION_MSL_BIT,
 
+	SPVC_COMPILER_OPTION_PREDICT_TEMPORARIES = 76 | SPVC_COMPILER_OPTION_COMMON_BIT,
+
+	SPVC_COMPILER_OPTION_MSL_USE_HELPER_LIBRARY = 77 | SPVC_COMPILER_OPTION_MSL_BIT,
+	SPVC_COMPILER_OPTION_MSL_VERTEX_PULLING = 78 | SPVC_COMPILER_OPTION_MSL_BIT,
+	SPVC_COMPILER_OPTION_MSL_VERTEX_BUFFER_INDEX_BASE = 79 | SPVC_COMPILER_OPTION_MSL_BIT,
+	SPVC_COMPILER_OPTION_MSL_VERTEX_ATTRIBUTE_BUFFER_INDEX = 80 | SPVC_COMPILER_OPTION_MSL_BIT,
+
+	SPVC_COMPILER_OPTION_COMPACT_OUTPUT = 81 | SPVC_COMPILER_OPTION_COMMON_BIT,
+	SPVC_COMPILER_OPTION_ELIMINATE_COMMON_SUBEXPRESSIONS = 82 | SPVC_COMPILER_OPTION_COMMON_BIT,
+
+	SPVC_COMPILER_OPTION_GLSL_INFER_RELAXED_PRECISION = 83 | SPVC_COMPILER_OPTION_GLSL_BIT,
+
+	SPVC_COMPILER_OPTION_MSL_STAGE_TESS_CONTROL_OUTPUTS_IN_THREADGROUP = 84 | SPVC_COMPILER_OPTION_MSL_BIT,
+
 	SPVC_COMPILER_OPTION_INT_MAX = 0x7fffffff
 } spvc_compiler_option;
 
@@ -668,6 +717,8 @@ typedef enum spvc_compiler_option
  * This means that the API user only has to care about one "destroy" call ever when using the C API.
  * All pointers handed out by the APIs are only valid as long as the context
  * is alive and spvc_context_release_allocations has not been called.
+ * Long-lived contexts can release individual compilers and parsed IR early with
+ * spvc_compiler_destroy and spvc_parsed_ir_destroy.
  */
 SPVC_PUBLIC_API spvc_result spvc_context_create(spvc_context *context);
 
@@ -684,10 +735,106 @@ SPVC_PUBLIC_API const char *spvc_context_get_last_error_string(spvc_context cont
 typedef void (*spvc_error_callback)(void *userdata, const char *error);
 SPVC_PUBLIC_API void spvc_context_set_error_callback(spvc_context context, spvc_error_callback cb, void *userdata);
 
+/*
+ * Tracing hooks around the major phases of parsing and compilation. Maps to C++ API.
+ * The callback is called with begin set to SPVC_TRUE when entering a phase, and SPVC_FALSE when leaving it.
+ * For CFG and EMIT_FUNCTION, id is the function, for COMPILE_PASS the index of the pass,
+ * and FORCE_RECOMPILE is an instant event with a spvc_recompile_reason as id.
+ * Applies to SPIR-V parsed and compilers created after this call.
+ * Returns an error if SPIRV-Cross is not built with SPIRV_CROSS_ENABLE_TRACING.
+ */
+typedef enum spvc_trace_event
+{
+	SPVC_TRACE_EVENT_PARSE = 0,
+	SPVC_TRACE_EVENT_ANALYZE = 1,
+	SPVC_TRACE_EVENT_CFG = 2,
+	SPVC_TRACE_EVENT_EMIT_RESOURCES = 3,
+	SPVC_TRACE_EVENT_EMIT_FUNCTION = 4,
+	SPVC_TRACE_EVENT_COMPILE_PASS = 5,
+	SPVC_TRACE_EVENT_FORCE_RECOMPILE = 6,
+	SPVC_TRACE_EVENT_INT_MAX = 0x7fffffff
+} spvc_trace_event;
+typedef void (*spvc_trace_callback)(void *userdata, spvc_trace_event event, spvc_bool begin, unsigned id);
+SPVC_PUBLIC_API spvc_result spvc_context_set_trace_callback(spvc_context context, spvc_trace_callback cb,
+                                                            void *userdata);
+
+/*
+ * Optional content-addressed compilation cache.
+ * When enabled, spvc_compiler_compile() first hashes the SPIR-V module along with all options, decorations
+ * and remappings set on the compiler, and returns a previously compiled source string on a hit.
+ * At most max_memory_bytes of source is kept in memory, least recently used entries are evicted first.
+ * Calling this again with a cache already enabled only changes the memory budget.
+ * On a cache hit, reflection state which is normally only available after compilation is not filled in,
+ * e.g. spvc_compiler_msl_is_resource_used().
+ */
+SPVC_PUBLIC_API spvc_result spvc_context_enable_compilation_cache(spvc_context context, size_t max_memory_bytes);
+SPVC_PUBLIC_API void spvc_context_disable_compilation_cache(spvc_context context);
+
+/*
+ * Persistent storage for the compilation cache, e.g. on disk.
+ * key is a NUL-terminated string of 16 hex characters.
+ * The load callback returns a NUL-terminated source string, or NULL on a miss.
+ * The returned string only needs to remain valid until the callback is called again or the context is destroyed.
+ * The store callback is called for every newly compiled source.
+ * Either callback may be NULL. The cache must be enabled first.
+ */
+typedef const char *(*spvc_compilation_cache_load_callback)(void *userdata, const char *key);
+typedef void (*spvc_compilation_cache_store_callback)(void *userdata, const char *key, const char *source);
+SPVC_PUBLIC_API spvc_result spvc_context_set_compilation_cache_callbacks(spvc_context context,
+                                                                         spvc_compilation_cache_load_callback load,
+                                                                         spvc_compilation_cache_store_callback store,
+                                                                         void *userdata);
+
+/* Number of cache hits and misses so far. Either pointer may be NULL. Reports 0 if the cache is not enabled. */
+SPVC_PUBLIC_API void spvc_context_get_compilation_cache_statistics(spvc_context context, size_t *hits,
+                                                                   size_t *misses);
+
 /* SPIR-V parsing interface. Maps to Parser which then creates a ParsedIR, and that IR is extracted into the handle. */
 SPVC_PUBLIC_API spvc_result spvc_context_parse_spirv(spvc_context context, const SpvId *spirv, size_t word_count,
                                                      spvc_parsed_ir *parsed_ir);
 
+/*
+ * Like spvc_context_parse_spirv, but only functions reachable from the given entry point are parsed.
+ * Other entry points are left out of the parsed IR.
+ */
+SPVC_PUBLIC_API spvc_result spvc_context_parse_spirv_entry_point(spvc_context context, const SpvId *spirv,
+                                                                 size_t word_count, const char *entry_point,
+                                                                 SpvExecutionModel model, spvc_parsed_ir *parsed_ir);
+
+/*
+ * Like spvc_context_parse_spirv, but the words are not copied.
+ * The parsed IR and any compiler created from it refer to the words directly,
+ * so they must remain valid and unmodified until the context is destroyed.
+ * If the module needs to be endian-swapped, a copy is made anyway.
+ */
+SPVC_PUBLIC_API spvc_result spvc_context_parse_spirv_borrowed(spvc_context context, const SpvId *spirv,
+                                                              size_t word_count, spvc_parsed_ir *parsed_ir);
+
+/*
+ * Memory-maps size bytes starting at byte offset in the file at path and parses them without copying.
+ * If size is 0, the rest of the file is used. Offset and size must be multiples of 4.
+ * The mapping is released when the context is destroyed.
+ */
+SPVC_PUBLIC_API spvc_result spvc_context_parse_spirv_file_region(spvc_context context, const char *path,
+                                                                 size_t offset, size_t size,
+                                                                 spvc_parsed_ir *parsed_ir);
+
+/*
+ * Serializes parsed IR into a compact binary form, which can be stored and loaded again with
+ * spvc_context_deserialize_parsed_ir to skip parsing. The words are owned by the context.
+ * Must be called before the IR is consumed by spvc_context_create_compiler with SPVC_CAPTURE_MODE_TAKE_OWNERSHIP.
+ */
+SPVC_PUBLIC_API spvc_result spvc_context_serialize_parsed_ir(spvc_context context, spvc_parsed_ir parsed_ir,
+                                                             const SpvId **data, size_t *word_count);
+
+/*
+ * Loads IR created by spvc_context_serialize_parsed_ir with the same version of SPIRV-Cross.
+ * The SPIR-V module embedded in the data is not copied, so like spvc_context_parse_spirv_borrowed,
+ * the data must remain valid and unmodified until the context is destroyed.
+ */
+SPVC_PUBLIC_API spvc_result spvc_context_deserialize_parsed_ir(spvc_context context, const SpvId *data,
+                                                               size_t word_count, spvc_parsed_ir *parsed_ir);
+
 /*
  * Create a compiler backend. Capture mode controls if we construct by copy or move semantics.
  * It is always recommended to use SPVC_CAPTURE_MODE_TAKE_OWNERSHIP if you only intend to cross-compile the IR once.
@@ -696,6 +843,28 @@ SPVC_PUBLIC_API spvc_result spvc_context_create_compiler(spvc_context context, s
                                                          spvc_parsed_ir parsed_ir, spvc_capture_mode mode,
                                                          spvc_compiler *compiler);
 
+/*
+ * Frees a compiler along with everything which was handed out through it, e.g. resource lists, compiler options
+ * and strings. All such pointers become invalid. Their memory is reused by compilers created later in the same context.
+ * Passing NULL is a no-op.
+ */
+SPVC_PUBLIC_API void spvc_compiler_destroy(spvc_compiler compiler);
+
+/*
+ * Frees parsed IR before the context is released. Compilers created from it are not affected.
+ * Passing NULL is a no-op.
+ */
+SPVC_PUBLIC_API void spvc_parsed_ir_destroy(spvc_parsed_ir parsed_ir);
+
+/*
+ * Rebinds an existing compiler to a different module, reusing its internal allocations.
+ * Capture mode works like for spvc_context_create_compiler.
+ * All state derived from the previous module is reset, but compiler options are kept.
+ * Maps to Compiler::rebind_ir().
+ */
+SPVC_PUBLIC_API spvc_result spvc_compiler_rebind_parsed_ir(spvc_compiler compiler, spvc_parsed_ir parsed_ir,
+                                                           spvc_capture_mode mode);
+
 /* Maps directly to C++ API. */
 SPVC_PUBLIC_API unsigned spvc_compiler_get_current_id_bound(spvc_compiler compiler);
 
@@ -714,10 +883,146 @@ SPVC_PUBLIC_API spvc_result spvc_compiler_install_compiler_options(spvc_compiler
 /* Compile IR into a string. *source is owned by the context, and caller must not free it themselves. */
 SPVC_PUBLIC_API spvc_result spvc_compiler_compile(spvc_compiler compiler, const char **source);
 
+/*
+ * Compile IR, but hand the source to callback in chunks instead of returning one string.
+ * Chunks are not NUL-terminated and are only valid for the duration of the callback.
+ * The callback is only invoked once the final source is known, and never for a failed compilation.
+ * This avoids holding a second copy of the full source in memory, which matters for very large shaders.
+ */
+typedef void (*spvc_output_callback)(void *userdata, const char *data, size_t size);
+SPVC_PUBLIC_API spvc_result spvc_compiler_compile_to_callback(spvc_compiler compiler, spvc_output_callback callback,
+                                                              void *userdata);
+
+/*
+ * Maps to C++ API, see Compiler::CompileBudget.
+ * Limits apply to every subsequent spvc_compiler_compile() and spvc_compiler_compile_to_callback().
+ * A limit of 0 means unlimited. Hitting a limit makes compilation fail with SPVC_ERROR_BUDGET_EXCEEDED.
+ */
+typedef struct spvc_compile_budget
+{
+	/* Wall-clock time in microseconds. */
+	unsigned long long max_time_us;
+	/* Length in bytes of any single forwarded expression. */
+	size_t max_expression_size;
+	/* Number of forwarded expressions any single expression may be built from. */
+	unsigned max_forwarding_depth;
+	/* Bytes of source emitted by any single emission pass. */
+	size_t max_output_size;
+} spvc_compile_budget;
+
+/* Initializes the budget to be unlimited. */
+SPVC_PUBLIC_API void spvc_compile_budget_init(spvc_compile_budget *budget);
+
+/* Also clears any pending spvc_compiler_cancel_compile(). */
+SPVC_PUBLIC_API spvc_result spvc_compiler_set_compile_budget(spvc_compiler compiler,
+                                                             const spvc_compile_budget *budget);
+
+/*
+ * Can be called from any thread while the compiler is compiling.
+ * Compilation fails with SPVC_ERROR_BUDGET_EXCEEDED shortly after. Later compilations fail as well
+ * until spvc_compiler_set_compile_budget() is called again.
+ */
+SPVC_PUBLIC_API void spvc_compiler_cancel_compile(spvc_compiler compiler);
+
+/* Number of emission passes the last spvc_compiler_compile() needed. 0 if nothing was compiled, e.g. on a cache hit. */
+SPVC_PUBLIC_API unsigned spvc_compiler_get_compile_pass_count(spvc_compiler compiler);
+
+/* Maps to C++ API. Why the last compilation needed another emission pass. */
+typedef enum spvc_recompile_reason
+{
+	SPVC_RECOMPILE_REASON_GENERIC = 0,
+	SPVC_RECOMPILE_REASON_INVALIDATED_EXPRESSION = 1,
+	SPVC_RECOMPILE_REASON_FORCED_TEMPORARY = 2,
+	SPVC_RECOMPILE_REASON_HOISTED_TEMPORARY = 3,
+	SPVC_RECOMPILE_REASON_HELPER_FUNCTION = 4,
+	SPVC_RECOMPILE_REASON_EXTENSION = 5,
+	SPVC_RECOMPILE_REASON_DECORATION = 6,
+	SPVC_RECOMPILE_REASON_CONTROL_FLOW = 7,
+	SPVC_RECOMPILE_REASON_BUILTIN = 8,
+	SPVC_RECOMPILE_REASON_INT_MAX = 0x7fffffff
+} spvc_recompile_reason;
+SPVC_PUBLIC_API unsigned spvc_compiler_get_recompile_reason_count(spvc_compiler compiler,
+                                                                  spvc_recompile_reason reason);
+
+/*
+ * Maps to C++ API. Approximate heap memory in bytes, see ParsedIR::MemoryUsage and Compiler::MemoryUsage.
+ * Categories which only exist for compilers are 0 for parsed IR.
+ */
+typedef enum spvc_memory_category
+{
+	/* Storage reserved for IR objects, e.g. types, variables and blocks. */
+	SPVC_MEMORY_CATEGORY_OBJECT_POOLS = 0,
+	/* The part of SPVC_MEMORY_CATEGORY_OBJECT_POOLS holding live objects. Not counted in the total. */
+	SPVC_MEMORY_CATEGORY_OBJECT_POOLS_LIVE = 1,
+	/* Heap memory owned by live IR objects, e.g. instruction lists. */
+	SPVC_MEMORY_CATEGORY_OBJECTS = 2,
+	SPVC_MEMORY_CATEGORY_META = 3,
+	SPVC_MEMORY_CATEGORY_DECORATION_STRINGS = 4,
+	SPVC_MEMORY_CATEGORY_SPIRV = 5,
+	SPVC_MEMORY_CATEGORY_IR_OTHER = 6,
+	SPVC_MEMORY_CATEGORY_CFGS = 7,
+	SPVC_MEMORY_CATEGORY_ANALYSIS = 8,
+	SPVC_MEMORY_CATEGORY_OUTPUT = 9,
+	/* Strings handed out by the C API for this compiler. */
+	SPVC_MEMORY_CATEGORY_API = 10,
+	SPVC_MEMORY_CATEGORY_TOTAL = 11,
+	SPVC_MEMORY_CATEGORY_INT_MAX = 0x7fffffff
+} spvc_memory_category;
+SPVC_PUBLIC_API size_t spvc_compiler_get_memory_usage(spvc_compiler compiler, spvc_memory_category category);
+SPVC_PUBLIC_API size_t spvc_parsed_ir_get_memory_usage(spvc_parsed_ir parsed_ir, spvc_memory_category category);
+
+/* Maps to C++ API. Releases memory which is only needed while compiling, e.g. for long-lived reflection. */
+SPVC_PUBLIC_API void spvc_compiler_shrink_to_fit(spvc_compiler compiler);
+
+/*
+ * Batch compilation.
+ * Every job is parsed, set up and compiled independently on a pool of num_threads threads.
+ * If num_threads is 0, one thread per hardware thread is used.
+ * Each job gets its own result. Errors in one job do not affect other jobs, and are reported in
+ * spvc_batch_result::error rather than through the context's error string and callback.
+ * Returned strings are owned by the context.
+ * The compilation cache is used if enabled on the context.
+ * Returns SPVC_SUCCESS if the batch itself could be run, even if individual jobs failed.
+ */
+typedef struct spvc_batch_option
+{
+	spvc_compiler_option option;
+	unsigned value;
+} spvc_batch_option;
+
+typedef struct spvc_batch_job
+{
+	const SpvId *spirv;
+	size_t word_count;
+	spvc_backend backend;
+
+	/* Applied in order as if by spvc_compiler_options_set_uint(). */
+	const spvc_batch_option *options;
+	size_t num_options;
+} spvc_batch_job;
+
+typedef struct spvc_batch_result
+{
+	spvc_result result;
+
+	/* Set if result is SPVC_SUCCESS, otherwise NULL. */
+	const char *source;
+
+	/* Set if result is not SPVC_SUCCESS, otherwise NULL. */
+	const char *error;
+} spvc_batch_result;
+
+SPVC_PUBLIC_API spvc_result spvc_context_compile_batch(spvc_context context, const spvc_batch_job *jobs,
+                                                       size_t num_jobs, unsigned num_threads,
+                                                       spvc_batch_result *results);
+
 /* Maps to C++ API. */
 SPVC_PUBLIC_API spvc_result spvc_compiler_add_header_line(spvc_compiler compiler, const char *line);
 SPVC_PUBLIC_API spvc_result spvc_compiler_require_extension(spvc_compiler compiler, const char *ext);
 SPVC_PUBLIC_API spvc_result spvc_compiler_flatten_buffer_block(spvc_compiler compiler, spvc_variable_id id);
+/* Maps to C++ API. repacked receives whether the layout changed and may be NULL. */
+SPVC_PUBLIC_API spvc_result spvc_compiler_repack_buffer_block(spvc_compiler compiler, spvc_variable_id id,
+                                                              spvc_bool *repacked);
 
 SPVC_PUBLIC_API spvc_bool spvc_compiler_variable_is_depth_or_compare(spvc_compiler compiler, spvc_variable_id id);
 
@@ -738,11 +1043,24 @@ SPVC_PUBLIC_API spvc_result spvc_compiler_hlsl_set_resource_binding_flags(spvc_c
 
 SPVC_PUBLIC_API spvc_result spvc_compiler_hlsl_add_resource_binding(spvc_compiler compiler,
                                                                     const spvc_hlsl_resource_binding *binding);
+/* Maps to C++ API. Adds a whole table of resource bindings in one call. */
+SPVC_PUBLIC_API spvc_result spvc_compiler_hlsl_add_resource_bindings(spvc_compiler compiler,
+                                                                     const spvc_hlsl_resource_binding *bindings,
+                                                                     size_t count);
 SPVC_PUBLIC_API spvc_bool spvc_compiler_hlsl_is_resource_used(spvc_compiler compiler,
                                                               SpvExecutionModel model,
                                                               unsigned set,
                                                               unsigned binding);
 
+/*
+ * Builds a root signature shared by all compilers, in the HLSL string form.
+ * All compilers must have been compiled. The string is owned by the first compiler.
+ * Maps to CompilerHLSL::build_root_signature() and CompilerHLSL::root_signature_to_string().
+ */
+SPVC_PUBLIC_API spvc_result spvc_compiler_hlsl_build_root_signature(const spvc_compiler *compilers,
+                                                                    size_t num_compilers,
+                                                                    const char **root_signature);
+
 /*
  * MSL specifics.
  * Maps to C++ API.
@@ -761,6 +1079,10 @@ SPVC_PUBLIC_API spvc_result spvc_compiler_msl_add_vertex_attribute(spvc_compiler
                                                                    const spvc_msl_vertex_attribute *attrs);
 SPVC_PUBLIC_API spvc_result spvc_compiler_msl_add_resource_binding(spvc_compiler compiler,
                                                                    const spvc_msl_resource_binding *binding);
+/* Maps to C++ API. Adds a whole table of resource bindings in one call. */
+SPVC_PUBLIC_API spvc_result spvc_compiler_msl_add_resource_bindings(spvc_compiler compiler,
+                                                                    const spvc_msl_resource_binding *bindings,
+                                                                    size_t count);
 SPVC_PUBLIC_API spvc_result spvc_compiler_msl_add_shader_input(spvc_compiler compiler,
                                                                const spvc_msl_shader_input *input);
 SPVC_PUBLIC_API spvc_result spvc_compiler_msl_add_discrete_descriptor_set(spvc_compiler compiler, unsigned desc_set);
@@ -782,6 +1104,8 @@ SPVC_PUBLIC_API spvc_result spvc_compiler_msl_set_fragment_output_components(spv
 
 SPVC_PUBLIC_API unsigned spvc_compiler_msl_get_automatic_resource_binding(spvc_compiler compiler, spvc_variable_id id);
 SPVC_PUBLIC_API unsigned spvc_compiler_msl_get_automatic_resource_binding_secondary(spvc_compiler compiler, spvc_variable_id id);
+/* Maps to C++ API. Returns 0 unless the tessellation control outputs are staged in threadgroup memory. */
+SPVC_PUBLIC_API unsigned spvc_compiler_msl_get_tess_control_output_staging_size(spvc_compiler compiler);
 
 SPVC_PUBLIC_API spvc_result spvc_compiler_msl_add_dynamic_buffer(spvc_compiler compiler, unsigned desc_set, unsigned binding, unsigned index);
 
@@ -790,6 +1114,25 @@ SPVC_PUBLIC_API spvc_result spvc_compiler_msl_add_inline_uniform_block(spvc_comp
 SPVC_PUBLIC_API spvc_result spvc_compiler_msl_set_combined_sampler_suffix(spvc_compiler compiler, const char *suffix);
 SPVC_PUBLIC_API const char *spvc_compiler_msl_get_combined_sampler_suffix(spvc_compiler compiler);
 
+/*
+ * Shared helper library, see SPVC_COMPILER_OPTION_MSL_USE_HELPER_LIBRARY.
+ * Maps 1:1 to C++ API. The returned source is owned by the compiler.
+ */
+SPVC_PUBLIC_API spvc_result spvc_compiler_msl_set_helper_library_include(spvc_compiler compiler, const char *name);
+SPVC_PUBLIC_API spvc_result spvc_compiler_msl_add_helper_library_requirements(spvc_compiler compiler,
+                                                                              spvc_compiler other);
+SPVC_PUBLIC_API spvc_result spvc_compiler_msl_compile_helper_library(spvc_compiler compiler, const char **source);
+
+/*
+ * Maps to C++ API. The returned members are owned by the compiler, or by compilers[0] for the merged layout.
+ */
+SPVC_PUBLIC_API spvc_result spvc_compiler_msl_get_argument_buffer_layout(spvc_compiler compiler, unsigned desc_set,
+                                                                         const spvc_msl_argument_buffer_member **members,
+                                                                         size_t *num_members);
+SPVC_PUBLIC_API spvc_result spvc_compiler_msl_merge_argument_buffer_layouts(
+    const spvc_compiler *compilers, size_t num_compilers, unsigned desc_set,
+    const spvc_msl_argument_buffer_member **members, size_t *num_members);
+
 /*
  * Reflect resources.
  * Maps almost 1:1 to C++ API.
@@ -821,6 +1164,29 @@ SPVC_PUBLIC_API void spvc_compiler_set_member_decoration_string(spvc_compiler co
 SPVC_PUBLIC_API void spvc_compiler_set_member_name(spvc_compiler compiler, spvc_type_id id, unsigned member_index,
                                                    const char *argument);
 SPVC_PUBLIC_API void spvc_compiler_unset_decoration(spvc_compiler compiler, SpvId id, SpvDecoration decoration);
+
+/*
+ * Maps to C++ API. Applies a table of descriptor set / binding remaps in one pass.
+ * num_remapped receives the number of variables which were remapped and may be NULL.
+ */
+typedef struct spvc_resource_binding_remap
+{
+	unsigned desc_set;
+	unsigned binding;
+	unsigned new_desc_set;
+	unsigned new_binding;
+} spvc_resource_binding_remap;
+SPVC_PUBLIC_API spvc_result spvc_compiler_remap_resource_bindings(spvc_compiler compiler,
+                                                                  const spvc_resource_binding_remap *remaps,
+                                                                  size_t count, unsigned *num_remapped);
+
+/*
+ * Maps to C++ API. Workgroup memory analysis, see Compiler::pad_workgroup_arrays() and
+ * Compiler::alias_workgroup_variables(). The counts may be NULL.
+ */
+SPVC_PUBLIC_API spvc_result spvc_compiler_pad_workgroup_arrays(spvc_compiler compiler, unsigned *num_padded);
+SPVC_PUBLIC_API spvc_result spvc_compiler_alias_workgroup_variables(spvc_compiler compiler, unsigned *num_aliased);
+SPVC_PUBLIC_API spvc_result spvc_compiler_get_workgroup_memory_size(spvc_compiler compiler, unsigned *size);
 SPVC_PUBLIC_API void spvc_compiler_unset_member_decoration(spvc_compiler compiler, spvc_type_id id,
                                                            unsigned member_index, SpvDecoration decoration);
 
@@ -930,6 +1296,11 @@ SPVC_PUBLIC_API spvc_result spvc_compiler_get_specialization_constants(spvc_comp
 SPVC_PUBLIC_API spvc_constant spvc_compiler_get_constant_handle(spvc_compiler compiler,
                                                                 spvc_constant_id id);
 
+/* Must be called before spvc_compiler_compile(). */
+SPVC_PUBLIC_API spvc_result spvc_compiler_fold_specialization_constants(spvc_compiler compiler,
+                                                                        const spvc_specialization_constant_value *values,
+                                                                        size_t num_values);
+
 SPVC_PUBLIC_API spvc_constant_id spvc_compiler_get_work_group_size_specialization_constants(spvc_compiler compiler,
                                                                                             spvc_specialization_constant *x,
                                                                                             spvc_specialization_constant *y,
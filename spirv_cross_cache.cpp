@@ -0,0 +1,156 @@
+/*
+ * Copyright 2015-2021 Arm Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * At your option, you may choose to accept this material under either:
+ *  1. The Apache License, Version 2.0, found at <http://www.apache.org/licenses/LICENSE-2.0>, or
+ *  2. The MIT License, found at <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: Apache-2.0 OR MIT.
+ */
+
+#include "spirv_cross_cache.hpp"
+
+using namespace std;
+
+namespace SPIRV_CROSS_NAMESPACE
+{
+CompilationCache::CompilationCache(size_t max_memory_)
+    : max_memory(max_memory_)
+{
+}
+
+string CompilationCache::compile(Compiler &compiler)
+{
+	uint64_t key;
+	if (!compiler.get_compile_state_hash(key))
+		return compiler.compile();
+
+	string source;
+	if (lookup(key, source))
+		return source;
+
+	source = compiler.compile();
+
+	// Don't cache failures.
+	if (!source.empty())
+		insert(key, source);
+	return source;
+}
+
+bool CompilationCache::lookup(uint64_t key, string &source)
+{
+	Backend *persistent = nullptr;
+	{
+		lock_guard<mutex> holder(lock);
+		auto itr = entries.find(key);
+		if (itr != end(entries))
+		{
+			lru.splice(begin(lru), lru, itr->second);
+			source = itr->second->source;
+			hits++;
+			return true;
+		}
+		persistent = backend.get();
+	}
+
+	if (persistent && persistent->load(key, source))
+	{
+		lock_guard<mutex> holder(lock);
+		insert_locked(key, source);
+		hits++;
+		return true;
+	}
+
+	lock_guard<mutex> holder(lock);
+	misses++;
+	return false;
+}
+
+void CompilationCache::insert(uint64_t key, const string &source)
+{
+	Backend *persistent;
+	{
+		lock_guard<mutex> holder(lock);
+		insert_locked(key, source);
+		persistent = backend.get();
+	}
+
+	if (persistent)
+		persistent->store(key, source);
+}
+
+void CompilationCache::insert_locked(uint64_t key, const string &source)
+{
+	auto itr = entries.find(key);
+	if (itr != end(entries))
+	{
+		memory -= itr->second->source.size();
+		itr->second->source = source;
+		lru.splice(begin(lru), lru, itr->second);
+	}
+	else
+	{
+		lru.push_front({ key, source });
+		entries[key] = begin(lru);
+	}
+
+	memory += source.size();
+	evict_locked();
+}
+
+void CompilationCache::evict_locked()
+{
+	while (memory > max_memory && !lru.empty())
+	{
+		auto &entry = lru.back();
+		memory -= entry.source.size();
+		entries.erase(entry.key);
+		lru.pop_back();
+	}
+}
+
+void CompilationCache::set_backend(unique_ptr<Backend> backend_)
+{
+	lock_guard<mutex> holder(lock);
+	backend = move(backend_);
+}
+
+void CompilationCache::set_max_memory(size_t max_memory_)
+{
+	lock_guard<mutex> holder(lock);
+	max_memory = max_memory_;
+	evict_locked();
+}
+
+void CompilationCache::clear()
+{
+	lock_guard<mutex> holder(lock);
+	lru.clear();
+	entries.clear();
+	memory = 0;
+}
+
+CompilationCache::Statistics CompilationCache::get_statistics() const
+{
+	lock_guard<mutex> holder(lock);
+	Statistics stats;
+	stats.hits = hits;
+	stats.misses = misses;
+	stats.entries = entries.size();
+	stats.memory = memory;
+	return stats;
+}
+} // namespace SPIRV_CROSS_NAMESPACE
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2015-2021 Arm Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * At your option, you may choose to accept this material under either:
+ *  1. The Apache License, Version 2.0, found at <http://www.apache.org/licenses/LICENSE-2.0>, or
+ *  2. The MIT License, found at <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: Apache-2.0 OR MIT.
+ */
+
+#ifndef SPIRV_CROSS_CACHE_HPP
+#define SPIRV_CROSS_CACHE_HPP
+
+#include "spirv_cross.hpp"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+
+namespace SPIRV_CROSS_NAMESPACE
+{
+// A content-addressed cache of compiled shader sources.
+// Entries are keyed on Compiler::get_compile_state_hash(), which covers the SPIR-V module,
+// decorations, specialization constants, backend options and resource remapping.
+// Recently used entries are kept in memory up to a configurable budget,
+// and an optional Backend can be used to persist entries, e.g. to disk.
+//
+// On a cache hit, compile() is not called on the compiler, so any state which is normally
+// only available after compilation, e.g. CompilerMSL::get_automatic_msl_resource_binding()
+// or is_msl_resource_binding_used(), is not filled in. If that information is needed, do not use the cache.
+//
+// The cache itself is thread-safe and can be shared between threads compiling different Compiler objects.
+class CompilationCache
+{
+public:
+	// Pluggable persistent storage. Called with the cache lock released.
+	class Backend
+	{
+	public:
+		virtual ~Backend() = default;
+
+		// Returns true and fills in source if an entry for key exists.
+		virtual bool load(uint64_t key, std::string &source) = 0;
+
+		// Called for every newly compiled entry.
+		virtual void store(uint64_t key, const std::string &source) = 0;
+	};
+
+	struct Statistics
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t entries = 0;
+		size_t memory = 0;
+	};
+
+	explicit CompilationCache(size_t max_memory = 64 * 1024 * 1024);
+
+	// Compiles through the cache. If the compiler state cannot be hashed, this is equivalent to compiler.compile().
+	std::string compile(Compiler &compiler);
+
+	// Raw lookup and insertion. Lookup falls back to the backend on a miss in memory.
+	bool lookup(uint64_t key, std::string &source);
+	void insert(uint64_t key, const std::string &source);
+
+	// Must not be called while other threads are using the cache.
+	void set_backend(std::unique_ptr<Backend> backend);
+	void set_max_memory(size_t max_memory);
+
+	// Drops all entries held in memory. The backend is not touched.
+	void clear();
+
+	Statistics get_statistics() const;
+
+private:
+	struct Entry
+	{
+		uint64_t key;
+		std::string source;
+	};
+
+	void insert_locked(uint64_t key, const std::string &source);
+	void evict_locked();
+
+	mutable std::mutex lock;
+	std::list<Entry> lru;
+	std::unordered_map<uint64_t, std::list<Entry>::iterator> entries;
+	std::unique_ptr<Backend> backend;
+	size_t max_memory;
+	size_t memory = 0;
+	size_t hits = 0;
+	size_t misses = 0;
+};
+} // namespace SPIRV_CROSS_NAMESPACE
+
+#endif
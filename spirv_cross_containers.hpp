@@ -517,6 +517,33 @@ public:
 		this->buffer_size = new_size;
 	}
 
+	size_t capacity() const SPIRV_CROSS_NOEXCEPT
+	{
+		return buffer_capacity;
+	}
+
+	// Gives back heap memory which is not needed to hold the current elements.
+	void shrink_to_fit() SPIRV_CROSS_NOEXCEPT
+	{
+		if (this->ptr == stack_storage.data() || this->buffer_size == buffer_capacity)
+			return;
+
+		T *new_buffer = this->buffer_size > N ? static_cast<T *>(malloc(this->buffer_size * sizeof(T))) :
+		                                        stack_storage.data();
+		if (!new_buffer)
+			std::terminate();
+
+		for (size_t i = 0; i < this->buffer_size; i++)
+		{
+			new (&new_buffer[i]) T(std::move(this->ptr[i]));
+			this->ptr[i].~T();
+		}
+
+		free(this->ptr);
+		this->ptr = new_buffer;
+		buffer_capacity = this->buffer_size > N ? this->buffer_size : N;
+	}
+
 private:
 	size_t buffer_capacity = 0;
 	AlignedBuffer<T, N> stack_storage;
@@ -539,6 +566,351 @@ using VectorView = std::vector<T>;
 
 #endif // SPIRV_CROSS_FORCE_STL_TYPES
 
+// An array which is shared through reference counting between copies, so copying it does not copy the elements.
+// Used for IR which is written once by the parser and only read afterwards, so copies of a ParsedIR are cheap.
+// Only read access is given out directly, writes go through get_mutable(),
+// which first makes a private copy if the elements are shared with other copies (copy-on-write).
+// Like a shared_ptr, copies may be made concurrently from the same const SharedVector.
+template <typename T>
+class SharedVector
+{
+public:
+	const T *data() const SPIRV_CROSS_NOEXCEPT
+	{
+		return storage ? storage->data() : nullptr;
+	}
+
+	size_t size() const SPIRV_CROSS_NOEXCEPT
+	{
+		return storage ? storage->size() : 0;
+	}
+
+	bool empty() const SPIRV_CROSS_NOEXCEPT
+	{
+		return size() == 0;
+	}
+
+	const T &operator[](size_t i) const SPIRV_CROSS_NOEXCEPT
+	{
+		return (*storage)[i];
+	}
+
+	const T *begin() const SPIRV_CROSS_NOEXCEPT
+	{
+		return data();
+	}
+
+	const T *end() const SPIRV_CROSS_NOEXCEPT
+	{
+		return data() + size();
+	}
+
+	const T &front() const SPIRV_CROSS_NOEXCEPT
+	{
+		return (*storage)[0];
+	}
+
+	const T &back() const SPIRV_CROSS_NOEXCEPT
+	{
+		return (*storage)[storage->size() - 1];
+	}
+
+	void push_back(const T &t)
+	{
+		get_mutable().push_back(t);
+	}
+
+	void reserve(size_t count)
+	{
+		get_mutable().reserve(count);
+	}
+
+	void clear() SPIRV_CROSS_NOEXCEPT
+	{
+		storage.reset();
+	}
+
+	// Shared storage is left alone, as other copies may be reading it.
+	void shrink_to_fit()
+	{
+		if (storage && !is_shared())
+			storage->shrink_to_fit();
+	}
+
+	bool is_shared() const SPIRV_CROSS_NOEXCEPT
+	{
+		return storage && storage.use_count() > 1;
+	}
+
+	// Pointers and references to elements obtained before this call may refer to the shared copy afterwards.
+	SmallVector<T> &get_mutable()
+	{
+		if (!storage)
+			storage = std::make_shared<SmallVector<T>>();
+		else if (is_shared())
+			storage = std::make_shared<SmallVector<T>>(*storage);
+		return *storage;
+	}
+
+	size_t get_heap_size() const;
+
+private:
+	std::shared_ptr<SmallVector<T>> storage;
+};
+
+// Approximate heap memory owned by a container, not counting the container object itself.
+// Used for memory usage reporting, so exactness is not a goal.
+#ifndef SPIRV_CROSS_FORCE_STL_TYPES
+template <typename T, size_t N>
+inline size_t get_heap_size(const SmallVector<T, N> &v)
+{
+	return v.capacity() > N ? v.capacity() * sizeof(T) : 0;
+}
+#endif
+
+template <typename T>
+inline size_t get_heap_size(const std::vector<T> &v)
+{
+	return v.capacity() * sizeof(T);
+}
+
+// Shared storage is split evenly between its owners.
+template <typename T>
+inline size_t get_heap_size(const SharedVector<T> &v)
+{
+	return v.get_heap_size();
+}
+
+template <typename T>
+inline size_t SharedVector<T>::get_heap_size() const
+{
+	if (!storage)
+		return 0;
+	return (sizeof(*storage) + SPIRV_CROSS_NAMESPACE::get_heap_size(*storage)) / size_t(storage.use_count());
+}
+
+inline size_t get_heap_size(const std::string &s)
+{
+	// Assume short strings are stored inline.
+	return s.capacity() >= sizeof(std::string) ? s.capacity() + 1 : 0;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+inline size_t get_heap_size(const std::unordered_map<K, V, H, E, A> &m)
+{
+	using Node = typename std::unordered_map<K, V, H, E, A>::value_type;
+	return m.bucket_count() * sizeof(void *) + m.size() * (sizeof(Node) + 2 * sizeof(void *));
+}
+
+template <typename K, typename H, typename E, typename A>
+inline size_t get_heap_size(const std::unordered_set<K, H, E, A> &m)
+{
+	return m.bucket_count() * sizeof(void *) + m.size() * (sizeof(K) + 2 * sizeof(void *));
+}
+
+// A monotonic allocator. Allocations are carved out of large blocks, and memory is only ever given back in bulk,
+// either with reset(), which keeps the blocks around for reuse, or when the arena is destroyed.
+// This avoids hitting the global heap for lots of small, short-lived allocations.
+// The arena is not thread-safe, every thread or Compiler instance should own its own.
+class MemoryArena
+{
+public:
+	explicit MemoryArena(size_t block_size_ = 64 * 1024) SPIRV_CROSS_NOEXCEPT : block_size(block_size_)
+	{
+	}
+
+	~MemoryArena()
+	{
+		free_large_blocks();
+		for (auto &block : blocks)
+			free(block.data);
+	}
+
+	MemoryArena(const MemoryArena &) = delete;
+	void operator=(const MemoryArena &) = delete;
+
+	void *allocate(size_t size, size_t alignment = 16)
+	{
+		if (size == 0)
+			size = 1;
+
+		// Large allocations get a dedicated block, so they don't waste the remainder of the current one.
+		// malloc() alignment is sufficient for any fundamental type.
+		if (size > block_size / 2)
+		{
+			Block block;
+			block.data = static_cast<char *>(malloc(size));
+			if (!block.data)
+				SPIRV_CROSS_THROW("Out of memory.");
+			block.size = size;
+			large_blocks.push_back(block);
+			allocated_size += size;
+			reserved_size += size;
+			return block.data;
+		}
+
+		while (current_block < blocks.size())
+		{
+			auto &block = blocks[current_block];
+			size_t offset = (current_offset + alignment - 1) & ~(alignment - 1);
+			if (offset + size <= block.size)
+			{
+				current_offset = offset + size;
+				allocated_size += size;
+				return block.data + offset;
+			}
+
+			// Move on to the next block, the remainder of this one is wasted until reset().
+			current_block++;
+			current_offset = 0;
+		}
+
+		Block block;
+		block.data = static_cast<char *>(malloc(block_size));
+		if (!block.data)
+			SPIRV_CROSS_THROW("Out of memory.");
+		block.size = block_size;
+		blocks.push_back(block);
+
+		current_block = blocks.size() - 1;
+		current_offset = size;
+		allocated_size += size;
+		reserved_size += block_size;
+		return block.data;
+	}
+
+	template <typename T>
+	T *allocate_array(size_t count)
+	{
+		return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+	}
+
+	const char *allocate_string(const char *str, size_t len)
+	{
+		auto *ret = static_cast<char *>(allocate(len + 1, 1));
+		memcpy(ret, str, len);
+		ret[len] = '\0';
+		return ret;
+	}
+
+	// Invalidates all allocations. Regular blocks are kept around for reuse.
+	void reset()
+	{
+		free_large_blocks();
+		current_block = 0;
+		current_offset = 0;
+		allocated_size = 0;
+	}
+
+	// Like reset(), but all memory is given back to the heap.
+	void release()
+	{
+		reset();
+		for (auto &block : blocks)
+		{
+			reserved_size -= block.size;
+			free(block.data);
+		}
+		blocks.clear();
+	}
+
+	// Bytes handed out since the last reset.
+	size_t get_allocated_size() const
+	{
+		return allocated_size;
+	}
+
+	// Bytes held by the arena in total.
+	size_t get_reserved_size() const
+	{
+		return reserved_size;
+	}
+
+private:
+	void free_large_blocks()
+	{
+		for (auto &block : large_blocks)
+		{
+			reserved_size -= block.size;
+			free(block.data);
+		}
+		large_blocks.clear();
+	}
+
+	struct Block
+	{
+		char *data;
+		size_t size;
+	};
+	SmallVector<Block> blocks;
+	SmallVector<Block> large_blocks;
+	size_t current_block = 0;
+	size_t current_offset = 0;
+	size_t allocated_size = 0;
+	size_t reserved_size = 0;
+	size_t block_size;
+};
+
+// STL-compatible allocator on top of MemoryArena, e.g. for transient hash maps.
+// Deallocation is a no-op, memory is reclaimed when the arena is reset.
+// A default-constructed allocator has no arena, and falls back to the global heap.
+// Use with std::scoped_allocator_adaptor for nested containers to share the arena.
+template <typename T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	template <typename U>
+	struct rebind
+	{
+		using other = ArenaAllocator<U>;
+	};
+
+	explicit ArenaAllocator(MemoryArena *arena_ = nullptr) SPIRV_CROSS_NOEXCEPT : arena(arena_)
+	{
+	}
+
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U> &other) SPIRV_CROSS_NOEXCEPT : arena(other.get_arena())
+	{
+	}
+
+	T *allocate(size_t count)
+	{
+		if (arena)
+			return arena->allocate_array<T>(count);
+		else
+			return static_cast<T *>(::operator new(count * sizeof(T)));
+	}
+
+	void deallocate(T *ptr, size_t)
+	{
+		if (!arena)
+			::operator delete(ptr);
+	}
+
+	MemoryArena *get_arena() const
+	{
+		return arena;
+	}
+
+	template <typename U>
+	bool operator==(const ArenaAllocator<U> &other) const
+	{
+		return arena == other.get_arena();
+	}
+
+	template <typename U>
+	bool operator!=(const ArenaAllocator<U> &other) const
+	{
+		return arena != other.get_arena();
+	}
+
+private:
+	MemoryArena *arena;
+};
+
 // An object pool which we use for allocating IVariant-derived objects.
 // We know we are going to allocate a bunch of objects of each type,
 // so amortize the mallocs.
@@ -547,14 +919,25 @@ class ObjectPoolBase
 public:
 	virtual ~ObjectPoolBase() = default;
 	virtual void free_opaque(void *ptr) = 0;
+
+	// Makes sure at least count objects can be allocated without growing the pool again.
+	virtual void reserve(size_t count) = 0;
+
+	// Number of objects the pool has storage for, and how many of those are currently in use.
+	virtual size_t get_capacity() const = 0;
+	virtual size_t get_live_count() const = 0;
+	virtual size_t get_object_size() const = 0;
 };
 
 template <typename T>
 class ObjectPool : public ObjectPoolBase
 {
 public:
-	explicit ObjectPool(unsigned start_object_count_ = 16)
+	// If an arena is provided, storage for objects is carved out of it instead of the global heap,
+	// and the arena must outlive the pool.
+	explicit ObjectPool(unsigned start_object_count_ = 16, MemoryArena *arena_ = nullptr)
 	    : start_object_count(start_object_count_)
+	    , arena(arena_)
 	{
 	}
 
@@ -563,15 +946,23 @@ public:
 	{
 		if (vacants.empty())
 		{
-			unsigned num_objects = start_object_count << memory.size();
-			T *ptr = static_cast<T *>(malloc(num_objects * sizeof(T)));
-			if (!ptr)
-				return nullptr;
+			unsigned num_objects = start_object_count << num_allocations;
+			T *ptr;
+			if (arena)
+				ptr = arena->allocate_array<T>(num_objects);
+			else
+			{
+				ptr = static_cast<T *>(malloc(num_objects * sizeof(T)));
+				if (!ptr)
+					return nullptr;
+				memory.emplace_back(ptr);
+			}
 
 			for (unsigned i = 0; i < num_objects; i++)
 				vacants.push_back(&ptr[i]);
 
-			memory.emplace_back(ptr);
+			num_allocations++;
+			capacity += num_objects;
 		}
 
 		T *ptr = vacants.back();
@@ -591,10 +982,51 @@ public:
 		free(static_cast<T *>(ptr));
 	}
 
+	void reserve(size_t count) override
+	{
+		if (vacants.size() >= count)
+			return;
+
+		size_t num_objects = count - vacants.size();
+		T *ptr;
+		if (arena)
+			ptr = arena->allocate_array<T>(num_objects);
+		else
+		{
+			ptr = static_cast<T *>(malloc(num_objects * sizeof(T)));
+			if (!ptr)
+				return;
+			memory.emplace_back(ptr);
+		}
+
+		vacants.reserve(count);
+		for (size_t i = 0; i < num_objects; i++)
+			vacants.push_back(&ptr[i]);
+		num_allocations++;
+		capacity += num_objects;
+	}
+
+	size_t get_capacity() const override
+	{
+		return capacity;
+	}
+
+	size_t get_live_count() const override
+	{
+		return capacity - vacants.size();
+	}
+
+	size_t get_object_size() const override
+	{
+		return sizeof(T);
+	}
+
 	void clear()
 	{
 		vacants.clear();
 		memory.clear();
+		num_allocations = 0;
+		capacity = 0;
 	}
 
 protected:
@@ -610,6 +1042,9 @@ protected:
 
 	SmallVector<std::unique_ptr<T, MallocDeleter>> memory;
 	unsigned start_object_count;
+	unsigned num_allocations = 0;
+	size_t capacity = 0;
+	MemoryArena *arena;
 };
 
 template <size_t StackSize = 4096, size_t BlockSize = 4096>
@@ -686,13 +1121,53 @@ public:
 		return ret;
 	}
 
+	// Heap memory held by the stream, including blocks kept around for reuse.
+	size_t get_reserved_size() const
+	{
+		size_t total = current_buffer.buffer != stack_buffer ? current_buffer.size : 0;
+		for (auto &saved : saved_buffers)
+			if (saved.buffer != stack_buffer)
+				total += saved.size;
+		for (auto &spare : spare_buffers)
+			total += spare.size;
+		return total;
+	}
+
+	size_t size() const
+	{
+		size_t total = current_buffer.offset;
+		for (auto &saved : saved_buffers)
+			total += saved.offset;
+		return total;
+	}
+
+	// Visits the contents of the stream in order without concatenating them into one string.
+	template <typename Op>
+	void for_each_chunk(const Op &op) const
+	{
+		for (auto &saved : saved_buffers)
+			if (saved.offset)
+				op(saved.buffer, saved.offset);
+		if (current_buffer.offset)
+			op(current_buffer.buffer, current_buffer.offset);
+	}
+
 	void reset()
+	{
+		clear();
+		for (auto &spare : spare_buffers)
+			free(spare.buffer);
+		spare_buffers.clear();
+	}
+
+	// Like reset(), but heap blocks are kept around for reuse rather than freed.
+	void clear()
 	{
 		for (auto &saved : saved_buffers)
 			if (saved.buffer != stack_buffer)
-				free(saved.buffer);
+				spare_buffers.push_back(saved);
 		if (current_buffer.buffer != stack_buffer)
-			free(current_buffer.buffer);
+			spare_buffers.push_back(current_buffer);
 
 		saved_buffers.clear();
 		current_buffer.buffer = stack_buffer;
@@ -710,6 +1185,7 @@ private:
 	Buffer current_buffer;
 	char stack_buffer[StackSize];
 	SmallVector<Buffer> saved_buffers;
+	SmallVector<Buffer> spare_buffers;
 
 	void append(const char *s, size_t len)
 	{
@@ -726,13 +1202,21 @@ private:
 
 			saved_buffers.push_back(current_buffer);
 			size_t target_size = len > BlockSize ? len : BlockSize;
-			current_buffer.buffer = static_cast<char *>(malloc(target_size));
-			if (!current_buffer.buffer)
-				SPIRV_CROSS_THROW("Out of memory.");
+			if (!spare_buffers.empty() && spare_buffers.back().size >= target_size)
+			{
+				current_buffer = spare_buffers.back();
+				spare_buffers.pop_back();
+			}
+			else
+			{
+				current_buffer.buffer = static_cast<char *>(malloc(target_size));
+				if (!current_buffer.buffer)
+					SPIRV_CROSS_THROW("Out of memory.");
+				current_buffer.size = target_size;
+			}
 
 			memcpy(current_buffer.buffer, s, len);
 			current_buffer.offset = len;
-			current_buffer.size = target_size;
 		}
 		else
 		{
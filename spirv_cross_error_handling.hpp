@@ -58,6 +58,7 @@ report_and_abort(const std::string &msg)
 }
 
 #define SPIRV_CROSS_THROW(x) report_and_abort(x)
+#define SPIRV_CROSS_THROW_BUDGET_EXCEEDED(x) report_and_abort(x)
 #else
 class CompilerError : public std::runtime_error
 {
@@ -68,7 +69,18 @@ public:
 	}
 };
 
+// Thrown when compilation hits a limit set through Compiler::set_compile_budget().
+class CompileBudgetExceeded : public CompilerError
+{
+public:
+	explicit CompileBudgetExceeded(const std::string &str)
+	    : CompilerError(str)
+	{
+	}
+};
+
 #define SPIRV_CROSS_THROW(x) throw CompilerError(x)
+#define SPIRV_CROSS_THROW_BUDGET_EXCEEDED(x) throw CompileBudgetExceeded(x)
 #endif
 
 // MSVC 2013 does not have noexcept. We need this for Variant to get move constructor to work correctly
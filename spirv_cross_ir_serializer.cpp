@@ -0,0 +1,989 @@
+/*
+ * Copyright 2015-2021 Arm Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * At your option, you may choose to accept this material under either:
+ *  1. The Apache License, Version 2.0, found at <http://www.apache.org/licenses/LICENSE-2.0>, or
+ *  2. The MIT License, found at <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: Apache-2.0 OR MIT.
+ */
+
+#include "spirv_cross_ir_serializer.hpp"
+#include <algorithm>
+#include <string.h>
+
+using namespace std;
+using namespace spv;
+
+namespace SPIRV_CROSS_NAMESPACE
+{
+// "SPXI" in little-endian byte order.
+static const uint32_t SerializedIRMagic = 0x49585053u;
+
+// Bump whenever the layout changes, or when any of the serialized structures change.
+static const uint32_t SerializedIRVersion = 2;
+
+// Magic, version, TypeCount, SPIRVCrossDecorationCount, ID bound and SPIR-V word count,
+// followed by the number of objects of each type and the SPIR-V words themselves.
+static const uint32_t SerializedIRHeaderWords = 6;
+
+namespace
+{
+class IRWriter
+{
+public:
+	explicit IRWriter(vector<uint32_t> &out_)
+	    : out(out_)
+	{
+	}
+
+	void u32(uint32_t value)
+	{
+		out.push_back(value);
+	}
+
+	void u64(uint64_t value)
+	{
+		u32(uint32_t(value));
+		u32(uint32_t(value >> 32));
+	}
+
+	void words(const void *data, size_t count)
+	{
+		size_t offset = out.size();
+		out.resize(offset + count);
+		if (count)
+			memcpy(&out[offset], data, count * sizeof(uint32_t));
+	}
+
+	// Padded to a whole number of words.
+	void bytes(const void *data, size_t count)
+	{
+		u32(uint32_t(count));
+		size_t offset = out.size();
+		out.resize(offset + (count + 3) / 4);
+		if (count)
+			memcpy(&out[offset], data, count);
+	}
+
+	void str(const string &s)
+	{
+		bytes(s.data(), s.size());
+	}
+
+	// Elements are copied in bulk, so they must be plain words, e.g. IDs.
+	template <typename T>
+	void array(const SmallVector<T> &v)
+	{
+		static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Element must be a whole number of words.");
+		u32(uint32_t(v.size()));
+		words(v.data(), v.size() * (sizeof(T) / sizeof(uint32_t)));
+	}
+
+	template <typename T>
+	void array(const SharedVector<T> &v)
+	{
+		static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Element must be a whole number of words.");
+		u32(uint32_t(v.size()));
+		words(v.data(), v.size() * (sizeof(T) / sizeof(uint32_t)));
+	}
+
+	void bools(const SmallVector<bool> &v)
+	{
+		u32(uint32_t(v.size()));
+		for (size_t i = 0; i < v.size(); i += 32)
+		{
+			uint32_t mask = 0;
+			for (size_t j = i; j < v.size() && j < i + 32; j++)
+				if (v[j])
+					mask |= 1u << (j - i);
+			u32(mask);
+		}
+	}
+
+	template <typename T, typename U>
+	void pairs(const SmallVector<pair<T, U>> &v)
+	{
+		u32(uint32_t(v.size()));
+		for (auto &p : v)
+		{
+			u32(uint32_t(p.first));
+			u32(uint32_t(p.second));
+		}
+	}
+
+	void bitset(const Bitset &bits)
+	{
+		u64(bits.get_lower());
+		SmallVector<uint32_t> higher;
+		bits.for_each_bit([&](uint32_t bit) {
+			if (bit >= 64)
+				higher.push_back(bit);
+		});
+		array(higher);
+	}
+
+private:
+	vector<uint32_t> &out;
+};
+
+class IRReader
+{
+public:
+	IRReader(const uint32_t *data_, size_t size_)
+	    : data(data_)
+	    , size(size_)
+	{
+	}
+
+	const uint32_t *consume(uint64_t count)
+	{
+		if (count > size - offset)
+			SPIRV_CROSS_THROW("Serialized IR is truncated.");
+		auto *ptr = data + offset;
+		offset += size_t(count);
+		return ptr;
+	}
+
+	uint32_t u32()
+	{
+		return *consume(1);
+	}
+
+	uint64_t u64()
+	{
+		auto *w = consume(2);
+		return uint64_t(w[0]) | (uint64_t(w[1]) << 32);
+	}
+
+	string str()
+	{
+		uint32_t len = u32();
+		auto *w = consume((uint64_t(len) + 3) / 4);
+		return string(reinterpret_cast<const char *>(w), len);
+	}
+
+	template <typename T>
+	void array(SmallVector<T> &v)
+	{
+		uint32_t count = u32();
+		auto *w = consume(uint64_t(count) * (sizeof(T) / sizeof(uint32_t)));
+		v.resize(count);
+		if (count)
+			memcpy(static_cast<void *>(v.data()), w, count * sizeof(T));
+	}
+
+	template <typename T>
+	void array(SharedVector<T> &v)
+	{
+		array(v.get_mutable());
+	}
+
+	void bools(SmallVector<bool> &v)
+	{
+		uint32_t count = u32();
+		auto *w = consume((uint64_t(count) + 31) / 32);
+		v.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			v[i] = (w[i / 32] & (1u << (i % 32))) != 0;
+	}
+
+	template <typename T, typename U>
+	void pairs(SmallVector<pair<T, U>> &v)
+	{
+		uint32_t count = u32();
+		auto *w = consume(uint64_t(count) * 2);
+		v.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			v[i] = make_pair(T(w[2 * i + 0]), U(w[2 * i + 1]));
+	}
+
+	Bitset bitset()
+	{
+		Bitset bits(u64());
+		SmallVector<uint32_t> higher;
+		array(higher);
+		for (auto &bit : higher)
+			bits.set(bit);
+		return bits;
+	}
+
+	size_t get_offset() const
+	{
+		return offset;
+	}
+
+	bool at_end() const
+	{
+		return offset == size;
+	}
+
+private:
+	const uint32_t *data;
+	size_t size;
+	size_t offset = 0;
+};
+} // namespace
+
+static void write_decoration(IRWriter &w, const Meta::Decoration &dec)
+{
+	w.str(dec.alias);
+	w.str(dec.qualified_alias);
+	w.str(dec.hlsl_semantic);
+	w.bitset(dec.decoration_flags);
+	w.u32(dec.builtin_type);
+	w.u32(dec.location);
+	w.u32(dec.component);
+	w.u32(dec.set);
+	w.u32(dec.binding);
+	w.u32(dec.offset);
+	w.u32(dec.xfb_buffer);
+	w.u32(dec.xfb_stride);
+	w.u32(dec.stream);
+	w.u32(dec.array_stride);
+	w.u32(dec.matrix_stride);
+	w.u32(dec.input_attachment);
+	w.u32(dec.spec_id);
+	w.u32(dec.index);
+	w.u32(dec.fp_rounding_mode);
+	w.u32(dec.builtin);
+
+	w.bitset(dec.extended.flags);
+	bool has_extended_values = false;
+	for (uint32_t i = 0; i < SPIRVCrossDecorationCount && !has_extended_values; i++)
+		has_extended_values = dec.extended.values[i] != 0;
+	w.u32(has_extended_values);
+	if (has_extended_values)
+		for (uint32_t i = 0; i < SPIRVCrossDecorationCount; i++)
+			w.u32(dec.extended.values[i]);
+}
+
+static void read_decoration(IRReader &r, Meta::Decoration &dec)
+{
+	dec.alias = r.str();
+	dec.qualified_alias = r.str();
+	dec.hlsl_semantic = r.str();
+	dec.decoration_flags = r.bitset();
+	dec.builtin_type = static_cast<BuiltIn>(r.u32());
+	dec.location = r.u32();
+	dec.component = r.u32();
+	dec.set = r.u32();
+	dec.binding = r.u32();
+	dec.offset = r.u32();
+	dec.xfb_buffer = r.u32();
+	dec.xfb_stride = r.u32();
+	dec.stream = r.u32();
+	dec.array_stride = r.u32();
+	dec.matrix_stride = r.u32();
+	dec.input_attachment = r.u32();
+	dec.spec_id = r.u32();
+	dec.index = r.u32();
+	dec.fp_rounding_mode = static_cast<FPRoundingMode>(r.u32());
+	dec.builtin = r.u32() != 0;
+
+	dec.extended.flags = r.bitset();
+	if (r.u32())
+	{
+		auto *values = r.consume(SPIRVCrossDecorationCount);
+		for (uint32_t i = 0; i < SPIRVCrossDecorationCount; i++)
+			dec.extended.values[i] = values[i];
+	}
+}
+
+static void write_meta(IRWriter &w, const Meta &meta)
+{
+	write_decoration(w, meta.decoration);
+	w.u32(uint32_t(meta.members.size()));
+	for (auto &member : meta.members)
+		write_decoration(w, member);
+
+	// Sort for reproducible output.
+	SmallVector<pair<uint32_t, uint32_t>> word_offsets;
+	for (auto &offset : meta.decoration_word_offset)
+		word_offsets.push_back(offset);
+	sort(word_offsets.begin(), word_offsets.end());
+	w.pairs(word_offsets);
+
+	w.u32(meta.hlsl_is_magic_counter_buffer);
+	w.u32(meta.hlsl_magic_counter_buffer);
+}
+
+static void read_meta(IRReader &r, Meta &meta)
+{
+	read_decoration(r, meta.decoration);
+	meta.members.resize(r.u32());
+	for (auto &member : meta.members)
+		read_decoration(r, member);
+
+	SmallVector<pair<uint32_t, uint32_t>> word_offsets;
+	r.pairs(word_offsets);
+	for (auto &offset : word_offsets)
+		meta.decoration_word_offset[offset.first] = offset.second;
+
+	meta.hlsl_is_magic_counter_buffer = r.u32() != 0;
+	meta.hlsl_magic_counter_buffer = r.u32();
+}
+
+static void write_type(IRWriter &w, const SPIRType &type)
+{
+	w.u32(type.basetype);
+	w.u32(type.width);
+	w.u32(type.vecsize);
+	w.u32(type.columns);
+	w.array(type.array);
+	w.bools(type.array_size_literal);
+	w.u32(type.pointer_depth);
+	w.u32(uint32_t(type.pointer) | (uint32_t(type.forward_pointer) << 1));
+	w.u32(type.storage);
+	w.array(type.member_types);
+	w.array(type.member_type_index_redirection);
+	w.u32(type.image.type);
+	w.u32(type.image.dim);
+	w.u32(uint32_t(type.image.depth) | (uint32_t(type.image.arrayed) << 1) | (uint32_t(type.image.ms) << 2));
+	w.u32(type.image.sampled);
+	w.u32(type.image.format);
+	w.u32(type.image.access);
+	w.u32(type.type_alias);
+	w.u32(type.parent_type);
+}
+
+static void read_type(IRReader &r, SPIRType &type)
+{
+	type.basetype = static_cast<SPIRType::BaseType>(r.u32());
+	type.width = r.u32();
+	type.vecsize = r.u32();
+	type.columns = r.u32();
+	r.array(type.array);
+	r.bools(type.array_size_literal);
+	type.pointer_depth = r.u32();
+	uint32_t flags = r.u32();
+	type.pointer = (flags & 1) != 0;
+	type.forward_pointer = (flags & 2) != 0;
+	type.storage = static_cast<StorageClass>(r.u32());
+	r.array(type.member_types);
+	r.array(type.member_type_index_redirection);
+	type.image.type = r.u32();
+	type.image.dim = static_cast<Dim>(r.u32());
+	flags = r.u32();
+	type.image.depth = (flags & 1) != 0;
+	type.image.arrayed = (flags & 2) != 0;
+	type.image.ms = (flags & 4) != 0;
+	type.image.sampled = r.u32();
+	type.image.format = static_cast<ImageFormat>(r.u32());
+	type.image.access = static_cast<AccessQualifier>(r.u32());
+	type.type_alias = r.u32();
+	type.parent_type = r.u32();
+}
+
+static void write_variable(IRWriter &w, const SPIRVariable &var)
+{
+	w.u32(var.basetype);
+	w.u32(var.storage);
+	w.u32(var.decoration);
+	w.u32(var.initializer);
+	w.u32(var.basevariable);
+	w.array(var.dereference_chain);
+	w.u32(var.static_expression);
+	w.array(var.dependees);
+	w.u32(var.remapped_components);
+	w.u32(var.dominator);
+	w.u32(uint32_t(var.compat_builtin) | (uint32_t(var.statically_assigned) << 1) |
+	      (uint32_t(var.forwardable) << 2) | (uint32_t(var.deferred_declaration) << 3) |
+	      (uint32_t(var.phi_variable) << 4) | (uint32_t(var.allocate_temporary_copy) << 5) |
+	      (uint32_t(var.remapped_variable) << 6) | (uint32_t(var.loop_variable) << 7) |
+	      (uint32_t(var.loop_variable_enable) << 8));
+}
+
+static void read_variable(IRReader &r, SPIRVariable &var)
+{
+	var.basetype = r.u32();
+	var.storage = static_cast<StorageClass>(r.u32());
+	var.decoration = r.u32();
+	var.initializer = r.u32();
+	var.basevariable = r.u32();
+	r.array(var.dereference_chain);
+	var.static_expression = r.u32();
+	r.array(var.dependees);
+	var.remapped_components = r.u32();
+	var.dominator = r.u32();
+	uint32_t flags = r.u32();
+	var.compat_builtin = (flags & (1u << 0)) != 0;
+	var.statically_assigned = (flags & (1u << 1)) != 0;
+	var.forwardable = (flags & (1u << 2)) != 0;
+	var.deferred_declaration = (flags & (1u << 3)) != 0;
+	var.phi_variable = (flags & (1u << 4)) != 0;
+	var.allocate_temporary_copy = (flags & (1u << 5)) != 0;
+	var.remapped_variable = (flags & (1u << 6)) != 0;
+	var.loop_variable = (flags & (1u << 7)) != 0;
+	var.loop_variable_enable = (flags & (1u << 8)) != 0;
+}
+
+static void write_constant(IRWriter &w, const SPIRConstant &c)
+{
+	w.u32(c.constant_type);
+	for (auto &col : c.m.c)
+	{
+		for (auto &elem : col.r)
+			w.u64(elem.u64);
+		for (auto &id : col.id)
+			w.u32(id);
+		w.u32(col.vecsize);
+	}
+	for (auto &id : c.m.id)
+		w.u32(id);
+	w.u32(c.m.columns);
+	w.u32(uint32_t(c.specialization) | (uint32_t(c.is_used_as_array_length) << 1) |
+	      (uint32_t(c.is_used_as_lut) << 2));
+	w.array(c.subconstants);
+	w.str(c.specialization_constant_macro_name);
+}
+
+static void read_constant(IRReader &r, SPIRConstant &c)
+{
+	c.constant_type = r.u32();
+	for (auto &col : c.m.c)
+	{
+		for (auto &elem : col.r)
+			elem.u64 = r.u64();
+		for (auto &id : col.id)
+			id = r.u32();
+		col.vecsize = r.u32();
+	}
+	for (auto &id : c.m.id)
+		id = r.u32();
+	c.m.columns = r.u32();
+	uint32_t flags = r.u32();
+	c.specialization = (flags & 1) != 0;
+	c.is_used_as_array_length = (flags & 2) != 0;
+	c.is_used_as_lut = (flags & 4) != 0;
+	r.array(c.subconstants);
+	c.specialization_constant_macro_name = r.str();
+}
+
+static void write_parameters(IRWriter &w, const SmallVector<SPIRFunction::Parameter> &params)
+{
+	w.u32(uint32_t(params.size()));
+	for (auto &param : params)
+	{
+		w.u32(param.type);
+		w.u32(param.id);
+		w.u32(param.read_count);
+		w.u32(param.write_count);
+		w.u32(param.alias_global_variable);
+	}
+}
+
+static void read_parameters(IRReader &r, SmallVector<SPIRFunction::Parameter> &params)
+{
+	params.resize(r.u32());
+	for (auto &param : params)
+	{
+		param.type = r.u32();
+		param.id = r.u32();
+		param.read_count = r.u32();
+		param.write_count = r.u32();
+		param.alias_global_variable = r.u32() != 0;
+	}
+}
+
+static void write_function(IRWriter &w, const SPIRFunction &func)
+{
+	// Hooks are installed by backends during compilation, and cannot be stored.
+	if (!func.fixup_hooks_in.empty() || !func.fixup_hooks_out.empty())
+		SPIRV_CROSS_THROW("Cannot serialize IR with function fixup hooks.");
+
+	w.u32(func.return_type);
+	w.u32(func.function_type);
+	write_parameters(w, func.arguments);
+	write_parameters(w, func.shadow_arguments);
+	w.array(func.local_variables);
+	w.u32(func.entry_block);
+	w.array(func.blocks);
+
+	w.u32(uint32_t(func.combined_parameters.size()));
+	for (auto &param : func.combined_parameters)
+	{
+		w.u32(param.id);
+		w.u32(param.image_id);
+		w.u32(param.sampler_id);
+		w.u32(uint32_t(param.global_image) | (uint32_t(param.global_sampler) << 1) | (uint32_t(param.depth) << 2));
+	}
+
+	w.u32(func.entry_line.file_id);
+	w.u32(func.entry_line.line_literal);
+	w.array(func.constant_arrays_needed_on_stack);
+	w.u32(uint32_t(func.active) | (uint32_t(func.flush_undeclared) << 1) |
+	      (uint32_t(func.do_combined_parameters) << 2));
+}
+
+static void read_function(IRReader &r, SPIRFunction &func)
+{
+	read_parameters(r, func.arguments);
+	read_parameters(r, func.shadow_arguments);
+	r.array(func.local_variables);
+	func.entry_block = r.u32();
+	r.array(func.blocks);
+
+	func.combined_parameters.resize(r.u32());
+	for (auto &param : func.combined_parameters)
+	{
+		param.id = r.u32();
+		param.image_id = r.u32();
+		param.sampler_id = r.u32();
+		uint32_t flags = r.u32();
+		param.global_image = (flags & 1) != 0;
+		param.global_sampler = (flags & 2) != 0;
+		param.depth = (flags & 4) != 0;
+	}
+
+	func.entry_line.file_id = r.u32();
+	func.entry_line.line_literal = r.u32();
+	r.array(func.constant_arrays_needed_on_stack);
+	uint32_t flags = r.u32();
+	func.active = (flags & 1) != 0;
+	func.flush_undeclared = (flags & 2) != 0;
+	func.do_combined_parameters = (flags & 4) != 0;
+}
+
+static void write_block(IRWriter &w, const SPIRBlock &block)
+{
+	w.u32(block.terminator);
+	w.u32(block.merge);
+	w.u32(block.hint);
+	w.u32(block.next_block);
+	w.u32(block.merge_block);
+	w.u32(block.continue_block);
+	w.u32(block.return_value);
+	w.u32(block.condition);
+	w.u32(block.true_block);
+	w.u32(block.false_block);
+	w.u32(block.default_block);
+	w.array(block.ops);
+	w.array(block.phi_variables);
+	w.pairs(block.declare_temporary);
+	w.pairs(block.potential_declare_temporary);
+	w.array(block.cases);
+	w.u32(uint32_t(block.disable_block_optimization) | (uint32_t(block.complex_continue) << 1) |
+	      (uint32_t(block.need_ladder_break) << 2));
+	w.u32(block.ignore_phi_from_block);
+	w.u32(block.loop_dominator);
+	w.array(block.dominated_variables);
+	w.array(block.loop_variables);
+	w.array(block.invalidate_expressions);
+}
+
+static void read_block(IRReader &r, SPIRBlock &block)
+{
+	block.terminator = static_cast<SPIRBlock::Terminator>(r.u32());
+	block.merge = static_cast<SPIRBlock::Merge>(r.u32());
+	block.hint = static_cast<SPIRBlock::Hints>(r.u32());
+	block.next_block = r.u32();
+	block.merge_block = r.u32();
+	block.continue_block = r.u32();
+	block.return_value = r.u32();
+	block.condition = r.u32();
+	block.true_block = r.u32();
+	block.false_block = r.u32();
+	block.default_block = r.u32();
+	r.array(block.ops);
+	r.array(block.phi_variables);
+	r.pairs(block.declare_temporary);
+	r.pairs(block.potential_declare_temporary);
+	r.array(block.cases);
+	uint32_t flags = r.u32();
+	block.disable_block_optimization = (flags & 1) != 0;
+	block.complex_continue = (flags & 2) != 0;
+	block.need_ladder_break = (flags & 4) != 0;
+	block.ignore_phi_from_block = r.u32();
+	block.loop_dominator = r.u32();
+	r.array(block.dominated_variables);
+	r.array(block.loop_variables);
+	r.array(block.invalidate_expressions);
+}
+
+static void write_object(IRWriter &w, const Variant &var)
+{
+	switch (var.get_type())
+	{
+	case TypeNone:
+		break;
+
+	case TypeType:
+		write_type(w, variant_get<SPIRType>(var));
+		break;
+
+	case TypeVariable:
+		write_variable(w, variant_get<SPIRVariable>(var));
+		break;
+
+	case TypeConstant:
+		write_constant(w, variant_get<SPIRConstant>(var));
+		break;
+
+	case TypeFunction:
+		write_function(w, variant_get<SPIRFunction>(var));
+		break;
+
+	case TypeFunctionPrototype:
+	{
+		auto &proto = variant_get<SPIRFunctionPrototype>(var);
+		w.u32(proto.return_type);
+		w.array(proto.parameter_types);
+		break;
+	}
+
+	case TypeBlock:
+		write_block(w, variant_get<SPIRBlock>(var));
+		break;
+
+	case TypeExtension:
+		w.u32(variant_get<SPIRExtension>(var).ext);
+		break;
+
+	case TypeConstantOp:
+	{
+		auto &op = variant_get<SPIRConstantOp>(var);
+		w.u32(op.opcode);
+		w.u32(op.basetype);
+		w.array(op.arguments);
+		break;
+	}
+
+	case TypeUndef:
+		w.u32(variant_get<SPIRUndef>(var).basetype);
+		break;
+
+	case TypeString:
+		w.str(variant_get<SPIRString>(var).str);
+		break;
+
+	default:
+		SPIRV_CROSS_THROW("Cannot serialize IR which contains objects created during compilation.");
+	}
+}
+
+static void read_object(IRReader &r, Variant &var, Types type)
+{
+	if (type == TypeNone)
+		return;
+
+	ID self = r.u32();
+	IVariant *object = nullptr;
+
+	switch (type)
+	{
+	case TypeType:
+	{
+		auto &t = variant_set<SPIRType>(var);
+		read_type(r, t);
+		object = &t;
+		break;
+	}
+
+	case TypeVariable:
+	{
+		auto &v = variant_set<SPIRVariable>(var);
+		read_variable(r, v);
+		object = &v;
+		break;
+	}
+
+	case TypeConstant:
+	{
+		auto &c = variant_set<SPIRConstant>(var);
+		read_constant(r, c);
+		object = &c;
+		break;
+	}
+
+	case TypeFunction:
+	{
+		TypeID return_type = r.u32();
+		TypeID function_type = r.u32();
+		auto &func = variant_set<SPIRFunction>(var, return_type, function_type);
+		read_function(r, func);
+		object = &func;
+		break;
+	}
+
+	case TypeFunctionPrototype:
+	{
+		auto &proto = variant_set<SPIRFunctionPrototype>(var, TypeID(r.u32()));
+		r.array(proto.parameter_types);
+		object = &proto;
+		break;
+	}
+
+	case TypeBlock:
+	{
+		auto &block = variant_set<SPIRBlock>(var);
+		read_block(r, block);
+		object = &block;
+		break;
+	}
+
+	case TypeExtension:
+		object = &variant_set<SPIRExtension>(var, static_cast<SPIRExtension::Extension>(r.u32()));
+		break;
+
+	case TypeConstantOp:
+	{
+		auto opcode = static_cast<Op>(r.u32());
+		TypeID basetype = r.u32();
+		auto &op = variant_set<SPIRConstantOp>(var, basetype, opcode, nullptr, 0u);
+		r.array(op.arguments);
+		object = &op;
+		break;
+	}
+
+	case TypeUndef:
+		object = &variant_set<SPIRUndef>(var, TypeID(r.u32()));
+		break;
+
+	case TypeString:
+		object = &variant_set<SPIRString>(var, r.str());
+		break;
+
+	default:
+		SPIRV_CROSS_THROW("Invalid object type in serialized IR.");
+	}
+
+	object->self = self;
+}
+
+template <typename T>
+static void read_id_list(IRReader &r, SmallVector<T> &ids, uint32_t bound)
+{
+	r.array(ids);
+	for (auto &id : ids)
+		if (uint32_t(id) >= bound)
+			SPIRV_CROSS_THROW("ID in serialized IR is out of range.");
+}
+
+vector<uint32_t> serialize_parsed_ir(const ParsedIR &ir)
+{
+	vector<uint32_t> out;
+	out.reserve(SerializedIRHeaderWords + TypeCount + ir.spirv.size() * 2);
+	IRWriter w(out);
+
+	uint32_t bound = uint32_t(ir.ids.size());
+	w.u32(SerializedIRMagic);
+	w.u32(SerializedIRVersion);
+	w.u32(TypeCount);
+	w.u32(SPIRVCrossDecorationCount);
+	w.u32(bound);
+	w.u32(uint32_t(ir.spirv.size()));
+
+	// Lets the loader size each object pool up front.
+	uint32_t type_counts[TypeCount] = {};
+	for (auto &var : ir.ids)
+		type_counts[var.get_type()]++;
+	for (auto &count : type_counts)
+		w.u32(count);
+
+	// The module goes first, so it is word aligned when the serialized buffer is, and can be used in place.
+	w.words(ir.spirv.data(), ir.spirv.size());
+
+	// The self ID is stored too, since it is not always the ID of the object itself,
+	// e.g. pointer types refer to their pointee type.
+	for (auto &var : ir.ids)
+	{
+		w.u32(var.get_type());
+		if (var.get_type() != TypeNone)
+			w.u32(var.get_id());
+		write_object(w, var);
+	}
+
+	w.u32(uint32_t(ir.meta.size()));
+	ir.meta.for_each([&](ID id, const Meta &meta) {
+		w.u32(id);
+		write_meta(w, meta);
+	});
+
+	w.bytes(ir.block_meta.data(), ir.block_meta.size());
+
+	SmallVector<pair<uint32_t, uint32_t>> loop_headers;
+	for (auto &header : ir.continue_block_to_loop_header)
+		loop_headers.emplace_back(header.first, header.second);
+	sort(loop_headers.begin(), loop_headers.end());
+	w.pairs(loop_headers);
+
+	SmallVector<const SPIREntryPoint *> entry_points;
+	for (auto &entry : ir.entry_points)
+		entry_points.push_back(&entry.second);
+	sort(entry_points.begin(), entry_points.end(),
+	     [](const SPIREntryPoint *a, const SPIREntryPoint *b) { return a->self < b->self; });
+
+	w.u32(uint32_t(entry_points.size()));
+	for (auto *entry : entry_points)
+	{
+		w.u32(entry->self);
+		w.str(entry->name);
+		w.str(entry->orig_name);
+		w.array(entry->interface_variables);
+		w.bitset(entry->flags);
+		w.u32(entry->workgroup_size.x);
+		w.u32(entry->workgroup_size.y);
+		w.u32(entry->workgroup_size.z);
+		w.u32(entry->workgroup_size.constant);
+		w.u32(entry->invocations);
+		w.u32(entry->output_vertices);
+		w.u32(entry->model);
+		w.u32(entry->geometry_passthrough);
+	}
+	w.u32(ir.default_entry_point);
+	w.u32(ir.entry_points_filtered);
+
+	w.u32(ir.source.version);
+	w.u32(uint32_t(ir.source.es) | (uint32_t(ir.source.known) << 1) | (uint32_t(ir.source.hlsl) << 2));
+	w.u32(ir.addressing_model);
+	w.u32(ir.memory_model);
+
+	w.array(ir.declared_capabilities);
+	w.u32(uint32_t(ir.declared_extensions.size()));
+	for (auto &ext : ir.declared_extensions)
+		w.str(ext);
+
+	for (auto &ids : ir.ids_for_type)
+		w.array(ids);
+	w.array(ir.ids_for_constant_or_type);
+	w.array(ir.ids_for_constant_or_variable);
+
+	SmallVector<uint32_t> name_fixups;
+	for (auto &id : ir.meta_needing_name_fixup)
+		name_fixups.push_back(id);
+	sort(name_fixups.begin(), name_fixups.end());
+	w.array(name_fixups);
+
+	return out;
+}
+
+ParsedIR deserialize_parsed_ir(const SPIRVWordBuffer &data)
+{
+	IRReader r(data.data(), data.size());
+
+	if (data.size() < SerializedIRHeaderWords + TypeCount)
+		SPIRV_CROSS_THROW("Serialized IR is truncated.");
+
+	uint32_t magic = r.u32();
+	if (magic != SerializedIRMagic)
+	{
+		if (magic == ((SerializedIRMagic >> 24) | ((SerializedIRMagic >> 8) & 0xff00u) |
+		              ((SerializedIRMagic << 8) & 0xff0000u) | (SerializedIRMagic << 24)))
+			SPIRV_CROSS_THROW("Serialized IR was written on a host with different byte order.");
+		SPIRV_CROSS_THROW("Data is not serialized IR.");
+	}
+
+	if (r.u32() != SerializedIRVersion || r.u32() != TypeCount || r.u32() != SPIRVCrossDecorationCount)
+		SPIRV_CROSS_THROW("Serialized IR was written by an incompatible version of SPIRV-Cross.");
+
+	uint32_t bound = r.u32();
+	uint32_t spirv_word_count = r.u32();
+
+	const uint32_t MaximumNumberOfIDs = 0x3fffff;
+	if (bound > MaximumNumberOfIDs)
+		SPIRV_CROSS_THROW("ID bound exceeds limit of 0x3fffff.\n");
+
+	ParsedIR ir;
+	for (uint32_t type = 0; type < TypeCount; type++)
+	{
+		uint32_t count = r.u32();
+		if (count > bound)
+			SPIRV_CROSS_THROW("Object count in serialized IR is out of range.");
+		if (type != TypeNone)
+			ir.reserve_objects(static_cast<Types>(type), count);
+	}
+
+	size_t spirv_offset = r.get_offset();
+	r.consume(spirv_word_count);
+	ir.spirv = data.subrange(spirv_offset, spirv_word_count);
+
+	ir.set_id_bounds(bound);
+	for (uint32_t id = 0; id < bound; id++)
+		read_object(r, ir.ids[id], static_cast<Types>(r.u32()));
+
+	uint32_t meta_count = r.u32();
+	for (uint32_t i = 0; i < meta_count; i++)
+	{
+		uint32_t id = r.u32();
+		if (id >= bound)
+			SPIRV_CROSS_THROW("ID in serialized IR is out of range.");
+		read_meta(r, ir.meta[id]);
+	}
+
+	// Stored as bytes.
+	uint32_t block_meta_count = r.u32();
+	if (block_meta_count != bound)
+		SPIRV_CROSS_THROW("Block meta in serialized IR does not match ID bound.");
+	auto *block_meta = r.consume((uint64_t(block_meta_count) + 3) / 4);
+	if (block_meta_count)
+		memcpy(ir.block_meta.data(), block_meta, block_meta_count);
+
+	SmallVector<pair<uint32_t, uint32_t>> loop_headers;
+	r.pairs(loop_headers);
+	for (auto &header : loop_headers)
+		ir.continue_block_to_loop_header[header.first] = header.second;
+
+	uint32_t entry_point_count = r.u32();
+	for (uint32_t i = 0; i < entry_point_count; i++)
+	{
+		FunctionID self = r.u32();
+		auto &entry = ir.entry_points[self];
+		entry.self = self;
+		entry.name = r.str();
+		entry.orig_name = r.str();
+		read_id_list(r, entry.interface_variables, bound);
+		entry.flags = r.bitset();
+		entry.workgroup_size.x = r.u32();
+		entry.workgroup_size.y = r.u32();
+		entry.workgroup_size.z = r.u32();
+		entry.workgroup_size.constant = r.u32();
+		entry.invocations = r.u32();
+		entry.output_vertices = r.u32();
+		entry.model = static_cast<ExecutionModel>(r.u32());
+		entry.geometry_passthrough = r.u32() != 0;
+	}
+	ir.default_entry_point = r.u32();
+	ir.entry_points_filtered = r.u32() != 0;
+
+	ir.source.version = r.u32();
+	uint32_t source_flags = r.u32();
+	ir.source.es = (source_flags & 1) != 0;
+	ir.source.known = (source_flags & 2) != 0;
+	ir.source.hlsl = (source_flags & 4) != 0;
+	ir.addressing_model = static_cast<AddressingModel>(r.u32());
+	ir.memory_model = static_cast<MemoryModel>(r.u32());
+
+	r.array(ir.declared_capabilities);
+	ir.declared_extensions.resize(r.u32());
+	for (auto &ext : ir.declared_extensions)
+		ext = r.str();
+
+	for (auto &ids : ir.ids_for_type)
+		read_id_list(r, ids, bound);
+	read_id_list(r, ir.ids_for_constant_or_type, bound);
+	read_id_list(r, ir.ids_for_constant_or_variable, bound);
+
+	SmallVector<uint32_t> name_fixups;
+	read_id_list(r, name_fixups, bound);
+	ir.meta_needing_name_fixup.insert(name_fixups.begin(), name_fixups.end());
+
+	if (!r.at_end())
+		SPIRV_CROSS_THROW("Serialized IR has trailing data.");
+
+	return ir;
+}
+} // namespace SPIRV_CROSS_NAMESPACE
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2015-2021 Arm Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * At your option, you may choose to accept this material under either:
+ *  1. The Apache License, Version 2.0, found at <http://www.apache.org/licenses/LICENSE-2.0>, or
+ *  2. The MIT License, found at <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: Apache-2.0 OR MIT.
+ */
+
+#ifndef SPIRV_CROSS_IR_SERIALIZER_HPP
+#define SPIRV_CROSS_IR_SERIALIZER_HPP
+
+#include "spirv_cross_parsed_ir.hpp"
+#include <stdint.h>
+#include <vector>
+
+namespace SPIRV_CROSS_NAMESPACE
+{
+// Compact binary serialization of a ParsedIR as produced by the Parser,
+// so that parsing can be skipped for modules which do not change, e.g. in an on-disk cache.
+//
+// The format is a stream of 32-bit words in host byte order. It is versioned, and only meant to be loaded
+// by the same version of SPIRV-Cross which wrote it. The raw SPIR-V words are stored unmodified
+// right after the header, so when loading, ParsedIR::spirv refers to the serialized buffer directly
+// instead of copying the module. Everything else is decoded with bulk copies into pre-sized pools.
+//
+// Only objects which the Parser creates are supported. IR which has been modified by a compiler
+// cannot be serialized.
+
+// Throws if the IR contains objects which cannot be serialized.
+std::vector<uint32_t> serialize_parsed_ir(const ParsedIR &ir);
+
+// Throws if the data is truncated, corrupt, or from an incompatible version.
+// The returned IR keeps the buffer alive, so it can come straight from Parser::map_file().
+// If the buffer borrows words without an owner, they must outlive the IR and any Compiler created from it.
+ParsedIR deserialize_parsed_ir(const SPIRVWordBuffer &data);
+} // namespace SPIRV_CROSS_NAMESPACE
+
+#endif
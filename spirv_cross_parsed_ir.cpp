@@ -36,19 +36,21 @@ ParsedIR::ParsedIR()
 	// so need an extra pointer here.
 	pool_group.reset(new ObjectPoolGroup);
 
-	pool_group->pools[TypeType].reset(new ObjectPool<SPIRType>);
-	pool_group->pools[TypeVariable].reset(new ObjectPool<SPIRVariable>);
-	pool_group->pools[TypeConstant].reset(new ObjectPool<SPIRConstant>);
-	pool_group->pools[TypeFunction].reset(new ObjectPool<SPIRFunction>);
-	pool_group->pools[TypeFunctionPrototype].reset(new ObjectPool<SPIRFunctionPrototype>);
-	pool_group->pools[TypeBlock].reset(new ObjectPool<SPIRBlock>);
-	pool_group->pools[TypeExtension].reset(new ObjectPool<SPIRExtension>);
-	pool_group->pools[TypeExpression].reset(new ObjectPool<SPIRExpression>);
-	pool_group->pools[TypeConstantOp].reset(new ObjectPool<SPIRConstantOp>);
-	pool_group->pools[TypeCombinedImageSampler].reset(new ObjectPool<SPIRCombinedImageSampler>);
-	pool_group->pools[TypeAccessChain].reset(new ObjectPool<SPIRAccessChain>);
-	pool_group->pools[TypeUndef].reset(new ObjectPool<SPIRUndef>);
-	pool_group->pools[TypeString].reset(new ObjectPool<SPIRString>);
+	// All pools carve their objects out of the same arena, which is released in bulk along with the IR.
+	auto *arena = &pool_group->arena;
+	pool_group->pools[TypeType].reset(new ObjectPool<SPIRType>(16, arena));
+	pool_group->pools[TypeVariable].reset(new ObjectPool<SPIRVariable>(16, arena));
+	pool_group->pools[TypeConstant].reset(new ObjectPool<SPIRConstant>(16, arena));
+	pool_group->pools[TypeFunction].reset(new ObjectPool<SPIRFunction>(16, arena));
+	pool_group->pools[TypeFunctionPrototype].reset(new ObjectPool<SPIRFunctionPrototype>(16, arena));
+	pool_group->pools[TypeBlock].reset(new ObjectPool<SPIRBlock>(16, arena));
+	pool_group->pools[TypeExtension].reset(new ObjectPool<SPIRExtension>(16, arena));
+	pool_group->pools[TypeExpression].reset(new ObjectPool<SPIRExpression>(16, arena));
+	pool_group->pools[TypeConstantOp].reset(new ObjectPool<SPIRConstantOp>(16, arena));
+	pool_group->pools[TypeCombinedImageSampler].reset(new ObjectPool<SPIRCombinedImageSampler>(16, arena));
+	pool_group->pools[TypeAccessChain].reset(new ObjectPool<SPIRAccessChain>(16, arena));
+	pool_group->pools[TypeUndef].reset(new ObjectPool<SPIRUndef>(16, arena));
+	pool_group->pools[TypeString].reset(new ObjectPool<SPIRString>(16, arena));
 }
 
 // Should have been default-implemented, but need this on MSVC 2013.
@@ -61,6 +63,8 @@ ParsedIR &ParsedIR::operator=(ParsedIR &&other) SPIRV_CROSS_NOEXCEPT
 {
 	if (this != &other)
 	{
+		// Our variants hold objects allocated from our pool group, so they must be released first.
+		ids.clear();
 		pool_group = move(other.pool_group);
 		spirv = move(other.spirv);
 		meta = move(other.meta);
@@ -78,11 +82,13 @@ ParsedIR &ParsedIR::operator=(ParsedIR &&other) SPIRV_CROSS_NOEXCEPT
 		memory_model = other.memory_model;
 
 		default_entry_point = other.default_entry_point;
+		entry_points_filtered = other.entry_points_filtered;
 		source = other.source;
 		loop_iteration_depth_hard = other.loop_iteration_depth_hard;
 		loop_iteration_depth_soft = other.loop_iteration_depth_soft;
 
 		meta_needing_name_fixup = std::move(other.meta_needing_name_fixup);
+		interned_types = std::move(other.interned_types);
 	}
 	return *this;
 }
@@ -109,6 +115,7 @@ ParsedIR &ParsedIR::operator=(const ParsedIR &other)
 		continue_block_to_loop_header = other.continue_block_to_loop_header;
 		entry_points = other.entry_points;
 		default_entry_point = other.default_entry_point;
+		entry_points_filtered = other.entry_points_filtered;
 		source = other.source;
 		loop_iteration_depth_hard = other.loop_iteration_depth_hard;
 		loop_iteration_depth_soft = other.loop_iteration_depth_soft;
@@ -116,6 +123,7 @@ ParsedIR &ParsedIR::operator=(const ParsedIR &other)
 		memory_model = other.memory_model;
 
 		meta_needing_name_fixup = other.meta_needing_name_fixup;
+		interned_types = other.interned_types;
 
 		// Very deliberate copying of IDs. There is no default copy constructor, nor a simple default constructor.
 		// Construct object first so we have the correct allocator set-up, then we can copy object into our new pool group.
@@ -130,6 +138,252 @@ ParsedIR &ParsedIR::operator=(const ParsedIR &other)
 	return *this;
 }
 
+void ParsedIR::reserve_objects(Types type, size_t count)
+{
+	pool_group->pools[type]->reserve(count);
+}
+
+uint64_t ParsedIR::hash_type_structure(const SPIRType &type, TypeID id, uint64_t tag)
+{
+	Hasher h;
+	h.u64(tag);
+	h.u32(type.basetype);
+	h.u32(type.width);
+	h.u32(type.vecsize);
+	h.u32(type.columns);
+	h.u32(uint32_t(type.array.size()));
+	for (auto &dim : type.array)
+		h.u32(dim);
+	for (auto literal : type.array_size_literal)
+		h.u32(literal);
+	h.u32(type.pointer_depth);
+	h.u32(type.pointer);
+	h.u32(type.forward_pointer);
+	h.u32(type.storage);
+	h.u32(uint32_t(type.member_types.size()));
+	for (auto &member : type.member_types)
+		h.u32(member);
+	h.u32(type.image.type);
+	h.u32(type.image.dim);
+	h.u32(type.image.format);
+	h.u32(type.parent_type);
+	h.u32(type.self == id ? 0u : uint32_t(type.self));
+	return h.get();
+}
+
+template <typename T>
+static bool vectors_are_equal(const SmallVector<T> &a, const SmallVector<T> &b)
+{
+	return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+bool ParsedIR::types_are_structurally_equal(const SPIRType &a, TypeID a_id, const SPIRType &b, TypeID b_id)
+{
+	// A type which refers to itself through self is equal to another type doing the same.
+	bool a_self = a.self == a_id;
+	bool b_self = b.self == b_id;
+	if (a_self != b_self || (!a_self && a.self != b.self))
+		return false;
+
+	auto &ai = a.image;
+	auto &bi = b.image;
+	if (ai.type != bi.type || ai.dim != bi.dim || ai.depth != bi.depth || ai.arrayed != bi.arrayed ||
+	    ai.ms != bi.ms || ai.sampled != bi.sampled || ai.format != bi.format || ai.access != bi.access)
+		return false;
+
+	return a.basetype == b.basetype && a.width == b.width && a.vecsize == b.vecsize && a.columns == b.columns &&
+	       vectors_are_equal(a.array, b.array) && vectors_are_equal(a.array_size_literal, b.array_size_literal) &&
+	       a.pointer_depth == b.pointer_depth && a.pointer == b.pointer && a.forward_pointer == b.forward_pointer &&
+	       a.storage == b.storage && vectors_are_equal(a.member_types, b.member_types) &&
+	       vectors_are_equal(a.member_type_index_redirection, b.member_type_index_redirection) &&
+	       a.type_alias == b.type_alias && a.parent_type == b.parent_type;
+}
+
+TypeID ParsedIR::find_interned_type(const SPIRType &type, TypeID id, uint64_t tag) const
+{
+	auto itr = interned_types.find(hash_type_structure(type, id, tag));
+	if (itr == end(interned_types))
+		return 0;
+
+	for (auto &candidate : itr->second)
+	{
+		// The ID might have been reused for something else since it was interned.
+		if (candidate.tag != tag || ids[candidate.id].get_type() != TypeType)
+			continue;
+		if (types_are_structurally_equal(type, id, get<SPIRType>(candidate.id), candidate.id))
+			return candidate.id;
+	}
+
+	return 0;
+}
+
+void ParsedIR::add_interned_type(TypeID id, uint64_t tag)
+{
+	auto &type = get<SPIRType>(id);
+	interned_types[hash_type_structure(type, id, tag)].push_back({ id, tag });
+}
+
+static size_t get_object_heap_size(const Variant &var)
+{
+	switch (var.get_type())
+	{
+	case TypeType:
+	{
+		auto &type = variant_get<SPIRType>(var);
+		return get_heap_size(type.array) + get_heap_size(type.array_size_literal) + get_heap_size(type.member_types) +
+		       get_heap_size(type.member_type_index_redirection);
+	}
+
+	case TypeVariable:
+	{
+		auto &v = variant_get<SPIRVariable>(var);
+		return get_heap_size(v.dereference_chain) + get_heap_size(v.dependees);
+	}
+
+	case TypeConstant:
+	{
+		auto &c = variant_get<SPIRConstant>(var);
+		return get_heap_size(c.subconstants) + get_heap_size(c.specialization_constant_macro_name);
+	}
+
+	case TypeFunction:
+	{
+		auto &func = variant_get<SPIRFunction>(var);
+		return get_heap_size(func.arguments) + get_heap_size(func.shadow_arguments) +
+		       get_heap_size(func.local_variables) + get_heap_size(func.blocks) +
+		       get_heap_size(func.combined_parameters) + get_heap_size(func.constant_arrays_needed_on_stack);
+	}
+
+	case TypeBlock:
+	{
+		auto &block = variant_get<SPIRBlock>(var);
+		return get_heap_size(block.ops) + get_heap_size(block.phi_variables) + get_heap_size(block.declare_temporary) +
+		       get_heap_size(block.potential_declare_temporary) + get_heap_size(block.cases) +
+		       get_heap_size(block.dominated_variables) + get_heap_size(block.loop_variables) +
+		       get_heap_size(block.invalidate_expressions);
+	}
+
+	case TypeExpression:
+	{
+		auto &expr = variant_get<SPIRExpression>(var);
+		return get_heap_size(expr.expression) + get_heap_size(expr.expression_dependencies) +
+		       get_heap_size(expr.implied_read_expressions);
+	}
+
+	case TypeConstantOp:
+		return get_heap_size(variant_get<SPIRConstantOp>(var).arguments);
+
+	case TypeAccessChain:
+	{
+		auto &chain = variant_get<SPIRAccessChain>(var);
+		return get_heap_size(chain.base) + get_heap_size(chain.dynamic_index) +
+		       get_heap_size(chain.implied_read_expressions);
+	}
+
+	case TypeString:
+		return get_heap_size(variant_get<SPIRString>(var).str);
+
+	default:
+		return 0;
+	}
+}
+
+static size_t get_decoration_string_size(const Meta::Decoration &dec)
+{
+	return get_heap_size(dec.alias) + get_heap_size(dec.qualified_alias) + get_heap_size(dec.hlsl_semantic);
+}
+
+ParsedIR::MemoryUsage ParsedIR::get_memory_usage() const
+{
+	MemoryUsage usage;
+
+	for (uint32_t type = 0; type < TypeCount; type++)
+	{
+		auto &pool = pool_group->pools[type];
+		if (!pool)
+			continue;
+		usage.pools[type].capacity = pool->get_capacity() * pool->get_object_size();
+		usage.pools[type].live = pool->get_live_count() * pool->get_object_size();
+		// The free lists.
+		usage.other += pool->get_capacity() * sizeof(void *);
+	}
+	usage.pool_arena = pool_group->arena.get_reserved_size();
+
+	for (auto &var : ids)
+		usage.objects += get_object_heap_size(var);
+
+	usage.meta = meta.get_heap_size();
+	meta.for_each([&](ID, const Meta &m) {
+		usage.decoration_strings += get_decoration_string_size(m.decoration);
+		usage.meta += get_heap_size(m.members) + get_heap_size(m.decoration_word_offset);
+		for (auto &member : m.members)
+			usage.decoration_strings += get_decoration_string_size(member);
+	});
+
+	if (!spirv.is_borrowed())
+		usage.spirv = spirv.size() * sizeof(uint32_t);
+
+	usage.other += get_heap_size(ids) + get_heap_size(ids_for_constant_or_type) +
+	               get_heap_size(ids_for_constant_or_variable) + get_heap_size(declared_capabilities) +
+	               get_heap_size(declared_extensions) + get_heap_size(block_meta) +
+	               get_heap_size(continue_block_to_loop_header) + get_heap_size(entry_points) +
+	               get_heap_size(meta_needing_name_fixup) + get_heap_size(interned_types);
+	for (auto &list : ids_for_type)
+		usage.other += get_heap_size(list);
+	for (auto &ext : declared_extensions)
+		usage.other += get_heap_size(ext);
+	for (auto &entry : entry_points)
+		usage.other += get_heap_size(entry.second.interface_variables) + get_heap_size(entry.second.name) +
+		               get_heap_size(entry.second.orig_name);
+
+	return usage;
+}
+
+void ParsedIR::shrink_to_fit()
+{
+	ids.shrink_to_fit();
+	for (auto &list : ids_for_type)
+		list.shrink_to_fit();
+	ids_for_constant_or_type.shrink_to_fit();
+	ids_for_constant_or_variable.shrink_to_fit();
+	block_meta.shrink_to_fit();
+	meta.shrink_to_fit();
+
+	for (auto &var : ids)
+	{
+		switch (var.get_type())
+		{
+		case TypeBlock:
+		{
+			auto &block = variant_get<SPIRBlock>(var);
+			block.ops.shrink_to_fit();
+			block.phi_variables.shrink_to_fit();
+			block.cases.shrink_to_fit();
+			break;
+		}
+
+		case TypeFunction:
+		{
+			auto &func = variant_get<SPIRFunction>(var);
+			func.blocks.shrink_to_fit();
+			func.local_variables.shrink_to_fit();
+			break;
+		}
+
+		case TypeType:
+			variant_get<SPIRType>(var).member_types.shrink_to_fit();
+			break;
+
+		case TypeConstant:
+			variant_get<SPIRConstant>(var).subconstants.shrink_to_fit();
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
 void ParsedIR::set_id_bounds(uint32_t bounds)
 {
 	ids.reserve(bounds);
@@ -137,6 +391,7 @@ void ParsedIR::set_id_bounds(uint32_t bounds)
 		ids.emplace_back(pool_group.get());
 
 	block_meta.resize(bounds);
+	meta.reserve(bounds);
 }
 
 // Roll our own versions of these functions to avoid potential locale shenanigans.
@@ -889,6 +1144,7 @@ uint32_t ParsedIR::increase_bound_by(uint32_t incr_amount)
 		ids.emplace_back(pool_group.get());
 
 	block_meta.resize(new_bound);
+	meta.reserve(uint32_t(new_bound));
 	return uint32_t(curr_bound);
 }
 
@@ -955,20 +1211,12 @@ void ParsedIR::add_typed_id(Types type, ID id)
 
 const Meta *ParsedIR::find_meta(ID id) const
 {
-	auto itr = meta.find(id);
-	if (itr != end(meta))
-		return &itr->second;
-	else
-		return nullptr;
+	return meta.find(id);
 }
 
 Meta *ParsedIR::find_meta(ID id)
 {
-	auto itr = meta.find(id);
-	if (itr != end(meta))
-		return &itr->second;
-	else
-		return nullptr;
+	return meta.find(id);
 }
 
 ParsedIR::LoopLock ParsedIR::create_loop_hard_lock() const
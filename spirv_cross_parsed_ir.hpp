@@ -25,12 +25,203 @@
 #define SPIRV_CROSS_PARSED_IR_HPP
 
 #include "spirv_common.hpp"
+#include <deque>
 #include <stdint.h>
 #include <unordered_map>
 
 namespace SPIRV_CROSS_NAMESPACE
 {
 
+// Storage for the raw SPIR-V words of a module.
+// The words are never modified once parsing is done, so copies share the same reference-counted buffer.
+// This makes it cheap to create several compilers from one ParsedIR, even on different threads,
+// since the (potentially very large) SPIR-V module is only held in memory once.
+//
+// The buffer can also borrow words owned by someone else, e.g. a memory-mapped shader archive.
+// In that case no copy is made, and the words must remain valid and unmodified for as long as
+// any ParsedIR or Compiler refers to them. Alternatively, an owner object can be attached, which
+// is kept alive by every copy of the buffer and released together with the last one.
+class SPIRVWordBuffer
+{
+public:
+	SPIRVWordBuffer() = default;
+
+	SPIRVWordBuffer(std::vector<uint32_t> words_)
+	    : words(std::make_shared<std::vector<uint32_t>>(std::move(words_)))
+	{
+	}
+
+	// Refers to word_count words at data_ without copying them.
+	static SPIRVWordBuffer borrow(const uint32_t *data_, size_t word_count,
+	                              std::shared_ptr<const void> owner_ = nullptr)
+	{
+		SPIRVWordBuffer buffer;
+		buffer.borrowed_data = data_;
+		buffer.borrowed_size = word_count;
+		buffer.owner = std::move(owner_);
+		return buffer;
+	}
+
+	const uint32_t *data() const
+	{
+		return words ? words->data() : borrowed_data;
+	}
+
+	size_t size() const
+	{
+		return words ? words->size() : borrowed_size;
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	const uint32_t &operator[](size_t index) const
+	{
+		return data()[index];
+	}
+
+	const uint32_t *begin() const
+	{
+		return data();
+	}
+
+	const uint32_t *end() const
+	{
+		return data() + size();
+	}
+
+	// Returns true if other copies of the ParsedIR refer to the same words.
+	bool is_shared() const
+	{
+		return words && words.use_count() > 1;
+	}
+
+	// Borrows a part of the buffer, which keeps the words alive as long as this buffer would.
+	SPIRVWordBuffer subrange(size_t offset, size_t word_count) const
+	{
+		if (words)
+			return borrow(words->data() + offset, word_count, words);
+		else
+			return borrow(borrowed_data + offset, word_count, owner);
+	}
+
+	// Returns true if the words are not owned by this buffer.
+	bool is_borrowed() const
+	{
+		return !words && borrowed_data;
+	}
+
+	// Only intended to be used by the parser.
+	// If the words are shared or borrowed, a private copy is made first so other owners are unaffected.
+	std::vector<uint32_t> &get_mutable()
+	{
+		if (!words)
+		{
+			words = std::make_shared<std::vector<uint32_t>>(borrowed_data, borrowed_data + borrowed_size);
+			borrowed_data = nullptr;
+			borrowed_size = 0;
+			owner.reset();
+		}
+		else if (words.use_count() > 1)
+			words = std::make_shared<std::vector<uint32_t>>(*words);
+		return *words;
+	}
+
+private:
+	std::shared_ptr<std::vector<uint32_t>> words;
+	const uint32_t *borrowed_data = nullptr;
+	size_t borrowed_size = 0;
+	std::shared_ptr<const void> owner;
+};
+
+// Index-addressed storage of Meta for IDs, which are dense in [0, bound).
+// Looking up an ID is an array load rather than a hash lookup. Entries are only materialized for IDs
+// which are actually given meta data, so an ID without any decorations or names only costs one index.
+// Like a node-based map, references to entries remain valid when other entries are added.
+class MetaStore
+{
+public:
+	// Materializes a default-constructed entry if the ID has none yet.
+	Meta &operator[](ID id)
+	{
+		uint32_t index = uint32_t(id);
+		if (index >= slots.size())
+			slots.resize(index + 1);
+
+		auto &slot = slots[index];
+		if (slot == 0)
+		{
+			storage.emplace_back();
+			slot = uint32_t(storage.size());
+		}
+		return storage[slot - 1];
+	}
+
+	// Returns nullptr if the ID has no entry.
+	Meta *find(ID id)
+	{
+		uint32_t index = uint32_t(id);
+		if (index >= slots.size() || slots[index] == 0)
+			return nullptr;
+		return &storage[slots[index] - 1];
+	}
+
+	const Meta *find(ID id) const
+	{
+		uint32_t index = uint32_t(id);
+		if (index >= slots.size() || slots[index] == 0)
+			return nullptr;
+		return &storage[slots[index] - 1];
+	}
+
+	// Pre-sizes the index for IDs up to bound.
+	void reserve(uint32_t bound)
+	{
+		if (bound > slots.size())
+			slots.resize(bound);
+	}
+
+	// Iterates over all IDs with an entry, in ID order.
+	template <typename Op>
+	void for_each(const Op &op) const
+	{
+		for (uint32_t index = 0; index < uint32_t(slots.size()); index++)
+			if (slots[index] != 0)
+				op(ID(index), storage[slots[index] - 1]);
+	}
+
+	// Number of IDs with an entry.
+	size_t size() const
+	{
+		return storage.size();
+	}
+
+	// Approximate heap memory held by the store itself, not counting strings owned by entries.
+	size_t get_heap_size() const
+	{
+		return SPIRV_CROSS_NAMESPACE::get_heap_size(slots) + storage.size() * sizeof(Meta);
+	}
+
+	void shrink_to_fit()
+	{
+		slots.shrink_to_fit();
+		storage.shrink_to_fit();
+	}
+
+	void clear()
+	{
+		slots.clear();
+		storage.clear();
+	}
+
+private:
+	// 0 means no entry, otherwise one past the index into storage.
+	SmallVector<uint32_t> slots;
+	std::deque<Meta> storage;
+};
+
 // This data structure holds all information needed to perform cross-compilation and reflection.
 // It is the output of the Parser, but any implementation could create this structure.
 // It is intentionally very "open" and struct-like with some helper functions to deal with decorations.
@@ -58,13 +249,14 @@ public:
 	void set_id_bounds(uint32_t bounds);
 
 	// The raw SPIR-V, instructions and opcodes refer to this by offset + count.
-	std::vector<uint32_t> spirv;
+	// Copying a ParsedIR does not copy the words, they are shared between all copies.
+	SPIRVWordBuffer spirv;
 
 	// Holds various data structures which inherit from IVariant.
 	SmallVector<Variant> ids;
 
 	// Various meta data for IDs, decorations, names, etc.
-	std::unordered_map<ID, Meta> meta;
+	MetaStore meta;
 
 	// Holds all IDs which have a certain type.
 	// This is needed so we can iterate through a specific kind of resource quickly,
@@ -102,6 +294,9 @@ public:
 	std::unordered_map<FunctionID, SPIREntryPoint> entry_points;
 	FunctionID default_entry_point = 0;
 
+	// Set if the module declares entry points which were left out, see Parser::set_entry_point_filter().
+	bool entry_points_filtered = false;
+
 	struct Source
 	{
 		uint32_t version = 0;
@@ -149,8 +344,21 @@ public:
 	Bitset get_buffer_block_type_flags(const SPIRType &type) const;
 
 	void add_typed_id(Types type, ID id);
+
+	// Pre-allocates pool storage for count objects of a type, e.g. when the number of objects is known up front.
+	void reserve_objects(Types type, size_t count);
 	void remove_typed_id(Types type, ID id);
 
+	// Hash-consing of types which are synthesized by the backends.
+	// Returns the ID of a previously interned type which is structurally identical to type, or 0 if there is none.
+	// id is the ID type would get, so that a type which refers to itself through self compares equal.
+	// tag distinguishes types which only differ in decorations the caller attaches to them.
+	TypeID find_interned_type(const SPIRType &type, TypeID id, uint64_t tag = 0) const;
+
+	// Makes an existing type available to find_interned_type().
+	// Interned types may be shared by several users, so they must not be modified afterwards.
+	void add_interned_type(TypeID id, uint64_t tag = 0);
+
 	class LoopLock
 	{
 	public:
@@ -224,6 +432,46 @@ public:
 
 	uint32_t get_spirv_version() const;
 
+	// Approximate heap memory held by the IR in bytes, by category.
+	struct MemoryUsage
+	{
+		struct Pool
+		{
+			// Bytes of storage the object pool of a type has set aside, and how much of it holds live objects.
+			size_t capacity = 0;
+			size_t live = 0;
+		};
+		Pool pools[TypeCount];
+
+		// Bytes reserved by the arena backing all object pools, which includes the pools above.
+		size_t pool_arena = 0;
+
+		// Heap memory owned by live objects, e.g. instruction lists of blocks and member lists of types.
+		size_t objects = 0;
+
+		// The per-ID meta data store, not counting strings.
+		size_t meta = 0;
+
+		// Names, aliases and semantics held in meta data.
+		size_t decoration_strings = 0;
+
+		// The SPIR-V words, unless they are borrowed. Shared buffers are counted in full by every copy of the IR.
+		size_t spirv = 0;
+
+		// ID lists, block meta data, entry points and other bookkeeping.
+		size_t other = 0;
+
+		size_t total() const
+		{
+			return pool_arena + objects + meta + decoration_strings + spirv + other;
+		}
+	};
+	MemoryUsage get_memory_usage() const;
+
+	// Gives back spare capacity in containers which have stopped growing once parsing is done.
+	// Useful for IR which is kept around for a long time, e.g. for reflection.
+	void shrink_to_fit();
+
 private:
 	template <typename T>
 	T &get(uint32_t id)
@@ -243,6 +491,19 @@ private:
 	Bitset cleared_bitset;
 
 	std::unordered_set<uint32_t> meta_needing_name_fixup;
+
+	struct InternedType
+	{
+		TypeID id;
+		uint64_t tag;
+	};
+	std::unordered_map<uint64_t, SmallVector<InternedType>> interned_types;
+
+	static uint64_t hash_type_structure(const SPIRType &type, TypeID id, uint64_t tag);
+	static bool types_are_structurally_equal(const SPIRType &a, TypeID a_id, const SPIRType &b, TypeID b_id);
+
+	friend std::vector<uint32_t> serialize_parsed_ir(const ParsedIR &ir);
+	friend ParsedIR deserialize_parsed_ir(const SPIRVWordBuffer &data);
 };
 } // namespace SPIRV_CROSS_NAMESPACE
 
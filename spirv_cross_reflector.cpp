@@ -0,0 +1,93 @@
+/*
+ * Copyright 2015-2021 Arm Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * At your option, you may choose to accept this material under either:
+ *  1. The Apache License, Version 2.0, found at <http://www.apache.org/licenses/LICENSE-2.0>, or
+ *  2. The MIT License, found at <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: Apache-2.0 OR MIT.
+ */
+
+#include "spirv_cross_reflector.hpp"
+
+using namespace std;
+
+namespace SPIRV_CROSS_NAMESPACE
+{
+Reflector::Reflector(ParsedIR &&ir_)
+    : Compiler(move(ir_))
+{
+}
+
+Reflector::Reflector(const ParsedIR &ir_)
+    : Compiler(ir_)
+{
+}
+
+Reflector::Reflector(const uint32_t *ir_, size_t word_count)
+    : Compiler(ir_, word_count)
+{
+}
+
+void Reflector::invalidate_if_entry_point_changed()
+{
+	if (cached_entry_point != ir.default_entry_point)
+	{
+		cached_entry_point = ir.default_entry_point;
+		active_variables_valid = false;
+		active_resources_valid = false;
+		active_push_constant_ranges_valid = false;
+	}
+}
+
+const unordered_set<VariableID> &Reflector::get_active_variables()
+{
+	invalidate_if_entry_point_changed();
+	if (!active_variables_valid)
+	{
+		active_variables = get_active_interface_variables();
+		active_variables_valid = true;
+	}
+	return active_variables;
+}
+
+const ShaderResources &Reflector::get_active_shader_resources()
+{
+	invalidate_if_entry_point_changed();
+	if (!active_resources_valid)
+	{
+		active_resources = get_shader_resources(get_active_variables());
+		active_resources_valid = true;
+	}
+	return active_resources;
+}
+
+const SmallVector<BufferRange> &Reflector::get_active_push_constant_ranges()
+{
+	invalidate_if_entry_point_changed();
+	if (!active_push_constant_ranges_valid)
+	{
+		active_push_constant_ranges.clear();
+		for (auto &block : get_active_shader_resources().push_constant_buffers)
+		{
+			auto ranges = get_active_buffer_ranges(block.id);
+			active_push_constant_ranges.insert(active_push_constant_ranges.end(), ranges.begin(), ranges.end());
+		}
+		active_push_constant_ranges_valid = true;
+	}
+	return active_push_constant_ranges;
+}
+} // namespace SPIRV_CROSS_NAMESPACE
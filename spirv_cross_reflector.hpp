@@ -0,0 +1,69 @@
+/*
+ * Copyright 2015-2021 Arm Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * At your option, you may choose to accept this material under either:
+ *  1. The Apache License, Version 2.0, found at <http://www.apache.org/licenses/LICENSE-2.0>, or
+ *  2. The MIT License, found at <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: Apache-2.0 OR MIT.
+ */
+
+#ifndef SPIRV_CROSS_REFLECTOR_HPP
+#define SPIRV_CROSS_REFLECTOR_HPP
+
+#include "spirv_cross.hpp"
+
+namespace SPIRV_CROSS_NAMESPACE
+{
+// A lightweight object for querying resources of a module, e.g. to create pipeline layouts.
+// Unlike the backends (including CompilerReflection), it sets up no emission state,
+// and it is cheapest to construct by moving a ParsedIR into it.
+//
+// Function bodies are not looked at until a query needs to know which variables are statically used
+// by the current entry point. The results of such queries are computed once and cached until
+// the entry point changes. Everything else in the Compiler reflection interface can be used as well.
+class Reflector : public Compiler
+{
+public:
+	explicit Reflector(ParsedIR &&ir);
+	explicit Reflector(const ParsedIR &ir);
+	Reflector(const uint32_t *ir, size_t word_count);
+
+	// Same as get_active_interface_variables(), but cached.
+	const std::unordered_set<VariableID> &get_active_variables();
+
+	// Same as get_shader_resources(get_active_interface_variables()), but cached.
+	const ShaderResources &get_active_shader_resources();
+
+	// The ranges of push constant blocks accessed by the current entry point, see get_active_buffer_ranges().
+	const SmallVector<BufferRange> &get_active_push_constant_ranges();
+
+private:
+	std::unordered_set<VariableID> active_variables;
+	ShaderResources active_resources;
+	SmallVector<BufferRange> active_push_constant_ranges;
+
+	// Entry point which the cached results belong to, if the respective flag is set.
+	FunctionID cached_entry_point = 0;
+	bool active_variables_valid = false;
+	bool active_resources_valid = false;
+	bool active_push_constant_ranges_valid = false;
+
+	void invalidate_if_entry_point_changed();
+};
+} // namespace SPIRV_CROSS_NAMESPACE
+
+#endif
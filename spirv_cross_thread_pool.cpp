@@ -0,0 +1,174 @@
+/*
+ * Copyright 2015-2021 Arm Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * At your option, you may choose to accept this material under either:
+ *  1. The Apache License, Version 2.0, found at <http://www.apache.org/licenses/LICENSE-2.0>, or
+ *  2. The MIT License, found at <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: Apache-2.0 OR MIT.
+ */
+
+#include "spirv_cross_thread_pool.hpp"
+
+using namespace std;
+
+namespace SPIRV_CROSS_NAMESPACE
+{
+ThreadPool::ThreadPool(unsigned num_threads)
+    : remaining(0)
+{
+	if (num_threads == 0)
+		num_threads = thread::hardware_concurrency();
+	if (num_threads == 0)
+		num_threads = 1;
+
+	queues.reserve(num_threads);
+	for (unsigned i = 0; i < num_threads; i++)
+		queues.emplace_back(new Queue);
+
+	// The last queue belongs to the thread calling parallel_for().
+	workers.reserve(num_threads - 1);
+	for (unsigned i = 0; i + 1 < num_threads; i++)
+		workers.emplace_back(&ThreadPool::worker_loop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> holder(lock);
+		shutdown = true;
+	}
+	work_cond.notify_all();
+
+	for (auto &worker : workers)
+		worker.join();
+}
+
+void ThreadPool::worker_loop(unsigned thread_index)
+{
+	uint64_t seen_generation = 0;
+	unique_lock<mutex> holder(lock);
+
+	for (;;)
+	{
+		work_cond.wait(holder, [&] { return shutdown || generation != seen_generation; });
+		if (shutdown)
+			break;
+
+		// If we woke up too late, the work might already have been completed by other threads.
+		seen_generation = generation;
+		auto *func = current_func;
+		if (!func)
+			continue;
+
+		active_workers++;
+		holder.unlock();
+
+		run_tasks(thread_index, *func);
+
+		holder.lock();
+		if (--active_workers == 0)
+			done_cond.notify_all();
+	}
+}
+
+bool ThreadPool::pop_task(unsigned thread_index, size_t &index)
+{
+	{
+		auto &queue = *queues[thread_index];
+		lock_guard<mutex> holder(queue.lock);
+		if (!queue.indices.empty())
+		{
+			index = queue.indices.front();
+			queue.indices.pop_front();
+			return true;
+		}
+	}
+
+	// Our own queue is empty, steal from the far end of someone else's queue.
+	size_t num_queues = queues.size();
+	for (size_t i = 1; i < num_queues; i++)
+	{
+		auto &victim = *queues[(thread_index + i) % num_queues];
+		lock_guard<mutex> holder(victim.lock);
+		if (!victim.indices.empty())
+		{
+			index = victim.indices.back();
+			victim.indices.pop_back();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ThreadPool::run_tasks(unsigned thread_index, const function<void(size_t)> &func)
+{
+	size_t index;
+	while (pop_task(thread_index, index))
+	{
+		func(index);
+		if (remaining.fetch_sub(1) == 1)
+		{
+			lock_guard<mutex> holder(lock);
+			done_cond.notify_all();
+		}
+	}
+}
+
+void ThreadPool::parallel_for(size_t count, const function<void(size_t)> &func)
+{
+	if (count == 0)
+		return;
+
+	lock_guard<mutex> call_holder(call_lock);
+
+	// Nothing to distribute, avoid waking up the workers.
+	if (count == 1 || workers.empty())
+	{
+		for (size_t i = 0; i < count; i++)
+			func(i);
+		return;
+	}
+
+	// Contiguous ranges per thread keeps related work together, stealing takes care of imbalance.
+	size_t num_queues = queues.size();
+	for (size_t i = 0; i < num_queues; i++)
+	{
+		size_t begin_index = count * i / num_queues;
+		size_t end_index = count * (i + 1) / num_queues;
+		auto &queue = *queues[i];
+		lock_guard<mutex> holder(queue.lock);
+		for (size_t index = begin_index; index < end_index; index++)
+			queue.indices.push_back(index);
+	}
+
+	{
+		lock_guard<mutex> holder(lock);
+		remaining = count;
+		current_func = &func;
+		generation++;
+	}
+	work_cond.notify_all();
+
+	run_tasks(unsigned(num_queues - 1), func);
+
+	// Wait for both the tasks to complete, and for every worker to stop looking at func.
+	unique_lock<mutex> holder(lock);
+	done_cond.wait(holder, [&] { return remaining == 0 && active_workers == 0; });
+	current_func = nullptr;
+}
+} // namespace SPIRV_CROSS_NAMESPACE
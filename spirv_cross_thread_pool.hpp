@@ -0,0 +1,86 @@
+/*
+ * Copyright 2015-2021 Arm Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * At your option, you may choose to accept this material under either:
+ *  1. The Apache License, Version 2.0, found at <http://www.apache.org/licenses/LICENSE-2.0>, or
+ *  2. The MIT License, found at <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: Apache-2.0 OR MIT.
+ */
+
+#ifndef SPIRV_CROSS_THREAD_POOL_HPP
+#define SPIRV_CROSS_THREAD_POOL_HPP
+
+#include "spirv_cross_containers.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace SPIRV_CROSS_NAMESPACE
+{
+// A small work-stealing thread pool.
+// Indices are distributed evenly over per-thread queues up front. A thread which runs out of work
+// steals from the back of another thread's queue, so uneven work items still balance out.
+class ThreadPool
+{
+public:
+	// If num_threads is 0, one thread per hardware thread is used.
+	// The thread calling parallel_for() takes part in the work, so num_threads - 1 worker threads are created.
+	explicit ThreadPool(unsigned num_threads = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool &) = delete;
+	void operator=(const ThreadPool &) = delete;
+
+	unsigned get_num_threads() const
+	{
+		return unsigned(queues.size());
+	}
+
+	// Calls func(index) once for every index in [0, count) and returns when all calls have completed.
+	// func must not throw. Concurrent calls to parallel_for() are serialized.
+	void parallel_for(size_t count, const std::function<void(size_t)> &func);
+
+private:
+	struct Queue
+	{
+		std::mutex lock;
+		std::deque<size_t> indices;
+	};
+
+	SmallVector<std::unique_ptr<Queue>> queues;
+	SmallVector<std::thread> workers;
+
+	std::mutex call_lock;
+	std::mutex lock;
+	std::condition_variable work_cond;
+	std::condition_variable done_cond;
+	const std::function<void(size_t)> *current_func = nullptr;
+	std::atomic<size_t> remaining;
+	uint64_t generation = 0;
+	unsigned active_workers = 0;
+	bool shutdown = false;
+
+	void worker_loop(unsigned thread_index);
+	void run_tasks(unsigned thread_index, const std::function<void(size_t)> &func);
+	bool pop_task(unsigned thread_index, size_t &index);
+};
+} // namespace SPIRV_CROSS_NAMESPACE
+
+#endif
@@ -23,6 +23,7 @@
 
 #include "spirv_cross_util.hpp"
 #include "spirv_common.hpp"
+#include <algorithm>
 
 using namespace spv;
 using namespace SPIRV_CROSS_NAMESPACE;
@@ -74,4 +75,148 @@ void inherit_combined_sampler_bindings(Compiler &compiler)
 		}
 	}
 }
+
+struct LinkedVarying
+{
+	VariableID id;
+	uint32_t location;
+	uint32_t slots;
+};
+
+static bool is_per_vertex_interface(const Compiler &compiler, VariableID id, StorageClass storage)
+{
+	if (compiler.has_decoration(id, DecorationPatch))
+		return false;
+
+	switch (compiler.get_execution_model())
+	{
+	case ExecutionModelTessellationControl:
+		return true;
+	case ExecutionModelTessellationEvaluation:
+	case ExecutionModelGeometry:
+		return storage == StorageClassInput;
+	default:
+		return false;
+	}
+}
+
+// Returns false if the interface cannot be linked by location alone.
+static bool get_linked_varyings(const Compiler &compiler, const SmallVector<Resource> &resources, StorageClass storage,
+                                SmallVector<LinkedVarying> &varyings)
+{
+	for (auto &res : resources)
+	{
+		if (!compiler.has_decoration(res.id, DecorationLocation))
+			return false;
+
+		auto &type = compiler.get_type(res.type_id);
+		if (type.basetype == SPIRType::Struct)
+			return false;
+
+		uint32_t slots = type.columns;
+		if (type.width == 64 && type.vecsize > 2)
+			slots *= 2;
+
+		size_t array_dimensions = type.array.size();
+		if (array_dimensions && is_per_vertex_interface(compiler, res.id, storage))
+			array_dimensions--;
+
+		for (size_t i = 0; i < array_dimensions; i++)
+		{
+			if (!type.array_size_literal[i] || type.array[i] == 0)
+				return false;
+			slots *= type.array[i];
+		}
+
+		varyings.push_back({ res.id, compiler.get_decoration(res.id, DecorationLocation), slots });
+	}
+
+	return true;
+}
+
+static bool varyings_overlap(const LinkedVarying &a, const LinkedVarying &b)
+{
+	return a.location < b.location + b.slots && b.location < a.location + a.slots;
+}
+
+static void link_stages(Compiler &producer, Compiler &consumer, bool compact_locations)
+{
+	// Inputs which are never read can go, which in turn allows the producer to drop the matching outputs.
+	auto active = consumer.get_active_interface_variables();
+	auto consumer_resources = consumer.get_shader_resources();
+
+	std::unordered_set<VariableID> unused_inputs;
+	for (auto &res : consumer_resources.stage_inputs)
+		if (!active.count(res.id))
+			unused_inputs.insert(res.id);
+
+	SmallVector<LinkedVarying> inputs;
+	SmallVector<LinkedVarying> outputs;
+	if (!get_linked_varyings(consumer, consumer_resources.stage_inputs, StorageClassInput, inputs) ||
+	    !get_linked_varyings(producer, producer.get_shader_resources().stage_outputs, StorageClassOutput, outputs))
+	{
+		return;
+	}
+
+	if (!unused_inputs.empty())
+	{
+		consumer.remove_interface_variables(unused_inputs);
+		inputs.erase(std::remove_if(inputs.begin(), inputs.end(),
+		                            [&](const LinkedVarying &v) { return unused_inputs.count(v.id) != 0; }),
+		             inputs.end());
+	}
+
+	std::unordered_set<VariableID> unused_outputs;
+	for (auto &output : outputs)
+	{
+		bool used = std::any_of(inputs.begin(), inputs.end(),
+		                        [&](const LinkedVarying &input) { return varyings_overlap(input, output); });
+		if (!used)
+			unused_outputs.insert(output.id);
+	}
+
+	if (!unused_outputs.empty())
+	{
+		// Outputs which the producer reads back itself are kept.
+		auto removed = producer.remove_interface_variables(unused_outputs);
+		outputs.erase(std::remove_if(outputs.begin(), outputs.end(),
+		                             [&](const LinkedVarying &v) {
+			                             return std::find(removed.begin(), removed.end(), v.id) != removed.end();
+		                             }),
+		              outputs.end());
+	}
+
+	if (!compact_locations)
+		return;
+
+	// Every slot still in use keeps its relative order, so varyings sharing a location through
+	// Component decorations stay together.
+	SmallVector<uint32_t> used_slots;
+	for (auto *varyings : { &inputs, &outputs })
+		for (auto &v : *varyings)
+			for (uint32_t slot = 0; slot < v.slots; slot++)
+				used_slots.push_back(v.location + slot);
+
+	std::sort(used_slots.begin(), used_slots.end());
+	used_slots.erase(std::unique(used_slots.begin(), used_slots.end()), used_slots.end());
+
+	const auto remap = [&](Compiler &compiler, const SmallVector<LinkedVarying> &varyings) {
+		for (auto &v : varyings)
+		{
+			auto itr = std::lower_bound(used_slots.begin(), used_slots.end(), v.location);
+			compiler.set_decoration(v.id, DecorationLocation, uint32_t(itr - used_slots.begin()));
+		}
+	};
+
+	remap(consumer, inputs);
+	remap(producer, outputs);
+}
+
+void link_pipeline_stages(const SmallVector<Compiler *> &stages, bool compact_locations)
+{
+	// Go from the back, so that inputs which only fed removed outputs are known to be unused
+	// by the time the previous stage is linked.
+	for (size_t i = stages.size(); i > 1; i--)
+		link_stages(*stages[i - 2], *stages[i - 1], compact_locations);
+}
 } // namespace spirv_cross_util
@@ -32,6 +32,15 @@ void rename_interface_variable(SPIRV_CROSS_NAMESPACE::Compiler &compiler,
                                const SPIRV_CROSS_NAMESPACE::SmallVector<SPIRV_CROSS_NAMESPACE::Resource> &resources,
                                uint32_t location, const std::string &name);
 void inherit_combined_sampler_bindings(SPIRV_CROSS_NAMESPACE::Compiler &compiler);
+
+// Links the user varyings of the stages of a pipeline, given in pipeline order, e.g. vertex and fragment.
+// Outputs which the next stage never reads are removed from the producing stage along with the code computing them,
+// see Compiler::remove_interface_variables(). Inputs which a stage never reads are removed as well.
+// If compact_locations is set, the remaining varyings are renumbered to consecutive locations on both sides.
+// Interfaces which are not matched by location only, e.g. ones using I/O blocks, are left alone.
+// Built-ins and the inputs of the first and outputs of the last stage are never changed.
+void link_pipeline_stages(const SPIRV_CROSS_NAMESPACE::SmallVector<SPIRV_CROSS_NAMESPACE::Compiler *> &stages,
+                          bool compact_locations = true);
 } // namespace spirv_cross_util
 
 #endif
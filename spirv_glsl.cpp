@@ -29,6 +29,7 @@
 #include <cmath>
 #include <limits>
 #include <locale.h>
+#include <map>
 #include <utility>
 
 #ifndef _WIN32
@@ -299,6 +300,7 @@ void CompilerGLSL::reset()
 	// Clear invalid expression tracking.
 	invalid_expressions.clear();
 	current_function = nullptr;
+	set_layout_cache_enabled(false);
 
 	// Clear temporary usage tracking.
 	expression_usage_counts.clear();
@@ -550,6 +552,8 @@ void CompilerGLSL::ray_tracing_khr_fixup_locations()
 
 string CompilerGLSL::compile()
 {
+	CompileBudgetScope budget_scope(*this);
+	begin_phase_timings();
 	ir.fixup_reserved_names();
 
 	if (options.vulkan_semantics)
@@ -573,9 +577,14 @@ string CompilerGLSL::compile()
 	build_function_control_flow_graphs_and_analyze();
 	find_static_extensions();
 	fixup_image_load_store_access();
-	update_active_builtins();
-	analyze_image_and_sampler_usage();
-	analyze_interlocked_resource_usage();
+	analyze_active_usage();
+	if (options.predict_temporaries)
+	{
+		analyze_multiply_read_expressions();
+		analyze_invalidated_loads();
+	}
+	analyze_common_subexpressions();
+	analyze_relaxed_precision();
 	if (!inout_color_attachments.empty())
 		emit_inout_fragment_outputs_copy_to_subpass_inputs();
 
@@ -584,15 +593,18 @@ string CompilerGLSL::compile()
 	if (ir.addressing_model == AddressingModelPhysicalStorageBuffer64EXT)
 		analyze_non_block_pointer_types();
 
-	uint32_t pass_count = 0;
+	begin_emission_timings();
+	compile_pass_count = 0;
 	do
 	{
-		if (pass_count >= 3)
+		if (compile_pass_count >= 3)
 			SPIRV_CROSS_THROW("Over 3 compilation loops detected. Must be a bug!");
 
+		SPIRV_CROSS_TRACE_SCOPE(trace_callback, TraceEventCompilePass, compile_pass_count);
+
 		reset();
 
-		buffer.reset();
+		buffer.clear();
 
 		emit_header();
 		emit_resources();
@@ -600,7 +612,8 @@ string CompilerGLSL::compile()
 
 		emit_function(get<SPIRFunction>(ir.default_entry_point), Bitset());
 
-		pass_count++;
+		compile_pass_count++;
+		end_pass_timing();
 	} while (is_forcing_recompilation());
 
 	// Implement the interlocked wrapper function at the end.
@@ -625,7 +638,162 @@ string CompilerGLSL::compile()
 	// Entry point in GLSL is always main().
 	get_entry_point().name = "main";
 
-	return buffer.str();
+	return finish_output();
+}
+
+static bool is_compact_identifier_char(char c)
+{
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '.';
+}
+
+// Whitespace between two characters can only be dropped if the characters do not merge into a different token.
+static bool compact_needs_space(char prev, char next)
+{
+	if (is_compact_identifier_char(prev) && is_compact_identifier_char(next))
+		return true;
+
+	static const char *const merging_pairs[] = { "++", "--", "&&", "||", "<<", ">>", "->", "<=", ">=", "==",
+		                                         "!=", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "//",
+		                                         "/*", "*/", "::" };
+	for (auto *pair : merging_pairs)
+		if (pair[0] == prev && pair[1] == next)
+			return true;
+	return false;
+}
+
+// Strips indentation, blank lines, comments and redundant spaces from emitted source.
+// String and character literals are copied verbatim, and preprocessor directives keep their own lines.
+static string compact_source(const string &source)
+{
+	string compact;
+	compact.reserve(source.size());
+
+	char last = '\n';
+	bool pending_space = false;
+	bool in_block_comment = false;
+	bool in_directive = false;
+	size_t i = 0;
+
+	while (i < source.size())
+	{
+		// At the start of a line.
+		size_t line_end = source.find('\n', i);
+		if (line_end == string::npos)
+			line_end = source.size();
+
+		size_t first = source.find_first_not_of(" \t\r", i);
+		if (!in_block_comment && (in_directive || (first < line_end && source[first] == '#')))
+		{
+			// Preprocessor directives, including continuation lines, are kept as-is.
+			if (!in_directive && last != '\n')
+				compact += '\n';
+			size_t end = line_end;
+			while (end > first && (source[end - 1] == ' ' || source[end - 1] == '\t' || source[end - 1] == '\r'))
+				end--;
+			compact.append(source, first, end - first);
+			compact += '\n';
+			last = '\n';
+			pending_space = false;
+			in_directive = end > first && source[end - 1] == '\\';
+			i = line_end + 1;
+			continue;
+		}
+
+		for (i = first; i < line_end; i++)
+		{
+			char c = source[i];
+			if (in_block_comment)
+			{
+				if (c == '*' && i + 1 < line_end && source[i + 1] == '/')
+				{
+					in_block_comment = false;
+					pending_space = true;
+					i++;
+				}
+				continue;
+			}
+
+			if (c == '/' && i + 1 < line_end && source[i + 1] == '/')
+				break;
+			if (c == '/' && i + 1 < line_end && source[i + 1] == '*')
+			{
+				in_block_comment = true;
+				i++;
+				continue;
+			}
+
+			if (c == ' ' || c == '\t' || c == '\r')
+			{
+				pending_space = true;
+				continue;
+			}
+
+			if (pending_space && last != '\n' && compact_needs_space(last, c))
+				compact += ' ';
+			pending_space = false;
+
+			if (c == '"' || c == '\'')
+			{
+				// Copy the literal up to and including the closing quote.
+				size_t end = i + 1;
+				while (end < line_end && source[end] != c)
+					end += source[end] == '\\' ? 2 : 1;
+				end = min(end + 1, line_end);
+				compact.append(source, i, end - i);
+				last = c;
+				i = end - 1;
+				continue;
+			}
+
+			compact += c;
+			last = c;
+		}
+
+		// A line break is whitespace like any other.
+		pending_space = true;
+		i = line_end + 1;
+	}
+
+	if (last != '\n')
+		compact += '\n';
+	return compact;
+}
+
+Compiler::MemoryUsage CompilerGLSL::get_memory_usage() const
+{
+	auto usage = Compiler::get_memory_usage();
+	usage.output += buffer.get_reserved_size();
+	return usage;
+}
+
+void CompilerGLSL::shrink_to_fit()
+{
+	Compiler::shrink_to_fit();
+	buffer.reset();
+}
+
+std::string CompilerGLSL::finish_output()
+{
+	// Anything emitted after the last block was started has not been checked yet.
+	check_output_budget(buffer.size());
+
+	if (options.compact_output)
+	{
+		auto source = compact_source(buffer.str());
+		if (!output_sink)
+			return source;
+
+		output_sink->write(source.data(), source.size());
+		buffer.clear();
+		return "";
+	}
+
+	if (!output_sink)
+		return buffer.str();
+
+	buffer.for_each_chunk([this](const char *data, size_t size) { output_sink->write(data, size); });
+	buffer.clear();
+	return "";
 }
 
 std::string CompilerGLSL::get_partial_source()
@@ -679,7 +847,7 @@ void CompilerGLSL::request_subgroup_feature(ShaderSubgroupSupportHelper::Feature
 	else
 	{
 		if (!shader_subgroup_supporter.is_feature_requested(feature))
-			force_recompile();
+			force_recompile(RecompileReasonExtension);
 		shader_subgroup_supporter.request_feature(feature);
 	}
 }
@@ -1010,13 +1178,11 @@ void CompilerGLSL::emit_struct(SPIRType &type)
 
 	type.member_name_cache.clear();
 
-	uint32_t i = 0;
 	bool emitted = false;
-	for (auto &member : type.member_types)
+	for (auto i : get_struct_member_declaration_order(type))
 	{
 		add_member_name(type, i);
-		emit_struct_member(type, member, i);
-		i++;
+		emit_struct_member(type, type.member_types[i], i);
 		emitted = true;
 	}
 
@@ -1495,8 +1661,10 @@ bool CompilerGLSL::buffer_is_packing_standard(const SPIRType &type, BufferPackin
 	bool is_top_level_block =
 	    has_decoration(type.self, DecorationBlock) || has_decoration(type.self, DecorationBufferBlock);
 
-	for (uint32_t i = 0; i < type.member_types.size(); i++)
+	auto member_order = get_struct_member_declaration_order(type);
+	for (uint32_t pos = 0; pos < uint32_t(member_order.size()); pos++)
 	{
+		uint32_t i = member_order[pos];
 		auto &memb_type = get<SPIRType>(type.member_types[i]);
 		auto member_flags = ir.meta[type.self].members[i].decoration_flags;
 
@@ -1515,7 +1683,7 @@ bool CompilerGLSL::buffer_is_packing_standard(const SPIRType &type, BufferPackin
 		//
 		// This is likely "best effort" we can support without going into unacceptably complicated workarounds.
 		bool member_can_be_unsized =
-		    is_top_level_block && size_t(i + 1) == type.member_types.size() && !memb_type.array.empty();
+		    is_top_level_block && size_t(pos + 1) == member_order.size() && !memb_type.array.empty();
 
 		uint32_t packed_size = 0;
 		if (!member_can_be_unsized || packing_is_hlsl(packing))
@@ -2040,9 +2208,8 @@ void CompilerGLSL::emit_buffer_reference_block(SPIRType &type, bool forward_decl
 		// Shaders never use the block by interface name, so we don't
 		// have to track this other than updating name caches.
 		// If we have a collision for any reason, just fallback immediately.
-		if (ir.meta[type.self].decoration.alias.empty() ||
-		    block_ssbo_names.find(buffer_name) != end(block_ssbo_names) ||
-		    resource_names.find(buffer_name) != end(resource_names))
+		if (ir.meta[type.self].decoration.alias.empty() || name_cache_contains(block_ssbo_names, buffer_name) ||
+		    name_cache_contains(resource_names, buffer_name))
 		{
 			buffer_name = join("_", type.self);
 		}
@@ -2057,8 +2224,8 @@ void CompilerGLSL::emit_buffer_reference_block(SPIRType &type, bool forward_decl
 		if (buffer_name.empty())
 			buffer_name = join("_", type.self);
 
-		block_names.insert(buffer_name);
-		block_ssbo_names.insert(buffer_name);
+		insert_name(block_names, buffer_name);
+		insert_name(block_ssbo_names, buffer_name);
 
 		// Ensure we emit the correct name when emitting non-forward pointer type.
 		ir.meta[type.self].decoration.alias = buffer_name;
@@ -2137,8 +2304,8 @@ void CompilerGLSL::emit_buffer_block_native(const SPIRVariable &var)
 	// Shaders never use the block by interface name, so we don't
 	// have to track this other than updating name caches.
 	// If we have a collision for any reason, just fallback immediately.
-	if (ir.meta[type.self].decoration.alias.empty() || block_namespace.find(buffer_name) != end(block_namespace) ||
-	    resource_names.find(buffer_name) != end(resource_names))
+	if (ir.meta[type.self].decoration.alias.empty() || name_cache_contains(block_namespace, buffer_name) ||
+	    name_cache_contains(resource_names, buffer_name))
 	{
 		buffer_name = get_block_fallback_name(var.self);
 	}
@@ -2153,8 +2320,8 @@ void CompilerGLSL::emit_buffer_block_native(const SPIRVariable &var)
 	if (buffer_name.empty())
 		buffer_name = join("_", get<SPIRType>(var.basetype).self, "_", var.self);
 
-	block_names.insert(buffer_name);
-	block_namespace.insert(buffer_name);
+	insert_name(block_names, buffer_name);
+	insert_name(block_namespace, buffer_name);
 
 	// Save for post-reflection later.
 	declared_block_names[var.self] = buffer_name;
@@ -2167,12 +2334,10 @@ void CompilerGLSL::emit_buffer_block_native(const SPIRVariable &var)
 
 	type.member_name_cache.clear();
 
-	uint32_t i = 0;
-	for (auto &member : type.member_types)
+	for (auto i : get_struct_member_declaration_order(type))
 	{
 		add_member_name(type, i);
-		emit_struct_member(type, member, i);
-		i++;
+		emit_struct_member(type, type.member_types[i], i);
 	}
 
 	// var.self can be used as a backup name for the block name,
@@ -2410,10 +2575,10 @@ void CompilerGLSL::emit_interface_block(const SPIRVariable &var)
 
 			// Shaders never use the block by interface name, so we don't
 			// have to track this other than updating name caches.
-			if (block_name.empty() || block_namespace.find(block_name) != end(block_namespace))
+			if (block_name.empty() || name_cache_contains(block_namespace, block_name))
 				block_name = get_fallback_name(type.self);
 			else
-				block_namespace.insert(block_name);
+				insert_name(block_namespace, block_name);
 
 			// If for some reason buffer_name is an illegal name, make a final fallback to a workaround name.
 			// This cannot conflict with anything else, so we're safe now.
@@ -2421,7 +2586,7 @@ void CompilerGLSL::emit_interface_block(const SPIRVariable &var)
 				block_name = join("_", get<SPIRType>(var.basetype).self, "_", var.self);
 
 			// Instance names cannot alias block names.
-			resource_names.insert(block_name);
+			insert_name(resource_names, block_name);
 
 			bool is_patch = has_decoration(var.self, DecorationPatch);
 			statement(layout_for_variable(var), (is_patch ? "patch " : ""), qual, block_name);
@@ -2698,100 +2863,1124 @@ void CompilerGLSL::replace_fragment_output(SPIRVariable &var)
 			SPIRV_CROSS_THROW("Arrayed output variable used, but location is not 0. "
 			                  "This is unimplemented in SPIRV-Cross.");
 
-		if (is_legacy_es())
-			require_extension_internal("GL_EXT_draw_buffers");
-	}
-	else
-		SPIRV_CROSS_THROW("Array-of-array output variable used. This cannot be implemented in legacy GLSL.");
+		if (is_legacy_es())
+			require_extension_internal("GL_EXT_draw_buffers");
+	}
+	else
+		SPIRV_CROSS_THROW("Array-of-array output variable used. This cannot be implemented in legacy GLSL.");
+
+	var.compat_builtin = true; // We don't want to declare this variable, but use the name as-is.
+}
+
+void CompilerGLSL::replace_fragment_outputs()
+{
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t, SPIRVariable &var) {
+		auto &type = this->get<SPIRType>(var.basetype);
+
+		if (!is_builtin_variable(var) && !var.remapped_variable && type.pointer && var.storage == StorageClassOutput)
+			replace_fragment_output(var);
+	});
+}
+
+string CompilerGLSL::remap_swizzle(const SPIRType &out_type, uint32_t input_components, const string &expr)
+{
+	if (out_type.vecsize == input_components)
+		return expr;
+	else if (input_components == 1 && !backend.can_swizzle_scalar)
+		return join(type_to_glsl(out_type), "(", expr, ")");
+	else
+	{
+		// FIXME: This will not work with packed expressions.
+		auto e = enclose_expression(expr) + ".";
+		// Just clamp the swizzle index if we have more outputs than inputs.
+		for (uint32_t c = 0; c < out_type.vecsize; c++)
+			e += index_to_swizzle(min(c, input_components - 1));
+		if (backend.swizzle_is_function && out_type.vecsize > 1)
+			e += "()";
+
+		remove_duplicate_swizzle(e);
+		return e;
+	}
+}
+
+void CompilerGLSL::emit_pls()
+{
+	auto &execution = get_entry_point();
+	if (execution.model != ExecutionModelFragment)
+		SPIRV_CROSS_THROW("Pixel local storage only supported in fragment shaders.");
+
+	if (!options.es)
+		SPIRV_CROSS_THROW("Pixel local storage only supported in OpenGL ES.");
+
+	if (options.version < 300)
+		SPIRV_CROSS_THROW("Pixel local storage only supported in ESSL 3.0 and above.");
+
+	if (!pls_inputs.empty())
+	{
+		statement("__pixel_local_inEXT _PLSIn");
+		begin_scope();
+		for (auto &input : pls_inputs)
+			statement(pls_decl(input), ";");
+		end_scope_decl();
+		statement("");
+	}
+
+	if (!pls_outputs.empty())
+	{
+		statement("__pixel_local_outEXT _PLSOut");
+		begin_scope();
+		for (auto &output : pls_outputs)
+			statement(pls_decl(output), ";");
+		end_scope_decl();
+		statement("");
+	}
+}
+
+void CompilerGLSL::fixup_image_load_store_access()
+{
+	if (!options.enable_storage_image_qualifier_deduction)
+		return;
+
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t var, const SPIRVariable &) {
+		auto &vartype = expression_type(var);
+		if (vartype.basetype == SPIRType::Image && vartype.image.sampled == 2)
+		{
+			// Very old glslangValidator and HLSL compilers do not emit required qualifiers here.
+			// Solve this by making the image access as restricted as possible and loosen up if we need to.
+			// If any no-read/no-write flags are actually set, assume that the compiler knows what it's doing.
+
+			auto &flags = ir.meta[var].decoration.decoration_flags;
+			if (!flags.get(DecorationNonWritable) && !flags.get(DecorationNonReadable))
+			{
+				flags.set(DecorationNonWritable);
+				flags.set(DecorationNonReadable);
+			}
+		}
+	});
+}
+
+static bool opcode_is_simple_arithmetic(Op op)
+{
+	// Opcodes which are emitted as a plain expression of all their operands,
+	// and will only ever be forwarded based on whether or not the operands can be forwarded.
+	switch (op)
+	{
+	case OpSNegate:
+	case OpFNegate:
+	case OpIAdd:
+	case OpFAdd:
+	case OpISub:
+	case OpFSub:
+	case OpIMul:
+	case OpFMul:
+	case OpUDiv:
+	case OpSDiv:
+	case OpFDiv:
+	case OpUMod:
+	case OpSMod:
+	case OpSRem:
+	case OpFRem:
+	case OpFMod:
+	case OpVectorTimesScalar:
+	case OpMatrixTimesScalar:
+	case OpDot:
+	case OpShiftRightLogical:
+	case OpShiftRightArithmetic:
+	case OpShiftLeftLogical:
+	case OpBitwiseOr:
+	case OpBitwiseXor:
+	case OpBitwiseAnd:
+	case OpNot:
+	case OpLogicalOr:
+	case OpLogicalAnd:
+	case OpLogicalNot:
+	case OpLogicalEqual:
+	case OpLogicalNotEqual:
+	case OpIEqual:
+	case OpINotEqual:
+	case OpUGreaterThan:
+	case OpSGreaterThan:
+	case OpUGreaterThanEqual:
+	case OpSGreaterThanEqual:
+	case OpULessThan:
+	case OpSLessThan:
+	case OpULessThanEqual:
+	case OpSLessThanEqual:
+	case OpFOrdEqual:
+	case OpFOrdNotEqual:
+	case OpFOrdLessThan:
+	case OpFOrdGreaterThan:
+	case OpFOrdLessThanEqual:
+	case OpFOrdGreaterThanEqual:
+	case OpConvertFToU:
+	case OpConvertFToS:
+	case OpConvertSToF:
+	case OpConvertUToF:
+	case OpFConvert:
+	case OpSelect:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+void CompilerGLSL::analyze_multiply_read_expressions()
+{
+	// Forwarded expressions which are read more than once are flushed to a temporary,
+	// but we normally only learn this while emitting code, which costs a full recompile.
+	// Simple arithmetic reads all its operands unconditionally, so if an arithmetic result is consumed
+	// at least twice by other arithmetic in the same function, we know up front that the expression
+	// will be flushed to a temporary. Expressions which would not be forwarded to begin with are not affected.
+	std::unordered_map<uint32_t, uint32_t> read_counts;
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, const SPIRFunction &func) {
+		read_counts.clear();
+
+		for (auto block_id : func.blocks)
+		{
+			for (auto &i : get<SPIRBlock>(block_id).ops)
+			{
+				auto op = static_cast<Op>(i.op);
+				if (opcode_is_simple_arithmetic(op) && i.length >= 3)
+					read_counts[stream(i)[1]] = 0;
+			}
+		}
+
+		for (auto block_id : func.blocks)
+		{
+			for (auto &i : get<SPIRBlock>(block_id).ops)
+			{
+				auto op = static_cast<Op>(i.op);
+				if (!opcode_is_simple_arithmetic(op) || i.length < 3)
+					continue;
+
+				auto *ops = stream(i);
+				for (uint32_t arg = 2; arg < i.length; arg++)
+				{
+					auto itr = read_counts.find(ops[arg]);
+					if (itr != end(read_counts) && ++itr->second == 2)
+						forced_temporaries.insert(ops[arg]);
+				}
+			}
+		}
+	});
+}
+
+static bool opcode_may_write_memory(Op op)
+{
+	switch (op)
+	{
+	case OpNop:
+	case OpLine:
+	case OpNoLine:
+	case OpPhi:
+	case OpSelectionMerge:
+	case OpLoopMerge:
+	case OpImageRead:
+	case OpImageSparseRead:
+	case OpImageSparseFetch:
+	case OpArrayLength:
+		return false;
+
+	default:
+		return true;
+	}
+}
+
+void CompilerGLSL::analyze_invalidated_loads()
+{
+	// Loads are forwarded, so a store to the memory they read from invalidates them.
+	// If the loaded value, or anything computed from it, is read after such a store,
+	// emission forces the load to a temporary and recompiles.
+	// Values which are read in other blocks are temporaries already, so walking each block in order
+	// finds these loads up front. Plain stores only invalidate loads from the same variable,
+	// or from any aliased variable, and image writes only loads from aliased variables.
+	// Everything else which may write memory invalidates all loads.
+	std::unordered_map<uint32_t, uint32_t> base_variables;
+	std::unordered_map<uint32_t, SmallVector<uint32_t>> load_dependencies;
+	std::unordered_map<uint32_t, uint32_t> pending_loads;
+	std::unordered_set<uint32_t> invalidated_loads;
+	std::unordered_map<uint32_t, uint32_t> read_counts;
+
+	const auto base_variable = [&](uint32_t id) -> uint32_t {
+		auto itr = base_variables.find(id);
+		if (itr != end(base_variables))
+			id = itr->second;
+		return maybe_get<SPIRVariable>(id) ? id : 0;
+	};
+
+	const auto is_aliased = [&](uint32_t var) { return var && variable_storage_is_aliased(get<SPIRVariable>(var)); };
+
+	const auto read = [&](uint32_t id) {
+		auto itr = load_dependencies.find(id);
+		if (itr == end(load_dependencies))
+			return;
+		for (auto load : itr->second)
+			if (invalidated_loads.count(load))
+				forced_temporaries.insert(load);
+	};
+
+	const auto inherit = [&](SmallVector<uint32_t> &deps, uint32_t id) {
+		auto itr = load_dependencies.find(id);
+		if (itr == end(load_dependencies))
+			return;
+		for (auto load : itr->second)
+			if (find(begin(deps), end(deps), load) == end(deps))
+				deps.push_back(load);
+	};
+
+	// A variable of 0 means the written memory is not known.
+	const auto invalidate = [&](uint32_t var, bool aliased) {
+		for (auto itr = begin(pending_loads); itr != end(pending_loads);)
+		{
+			if (!itr->second || itr->second == var || (aliased && is_aliased(itr->second)) || (!var && !aliased))
+			{
+				invalidated_loads.insert(itr->first);
+				itr = pending_loads.erase(itr);
+			}
+			else
+				++itr;
+		}
+	};
+
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, const SPIRFunction &func) {
+		base_variables.clear();
+
+		for (auto block_id : func.blocks)
+		{
+			auto &block = get<SPIRBlock>(block_id);
+			load_dependencies.clear();
+			pending_loads.clear();
+			invalidated_loads.clear();
+
+			// Results which are read more than once become temporaries, which ends the dependency on the loads.
+			read_counts.clear();
+			for (auto &i : block.ops)
+			{
+				auto *ops = stream(i);
+				for (uint32_t arg = 0; arg < i.length; arg++)
+					read_counts[ops[arg]]++;
+			}
+
+			for (auto &i : block.ops)
+			{
+				auto op = static_cast<Op>(i.op);
+				auto *ops = stream(i);
+
+				if (op == OpStore || op == OpCopyMemory)
+				{
+					if (i.length < 2)
+						continue;
+					read(ops[0]);
+					read(ops[1]);
+					uint32_t var = base_variable(ops[0]);
+					invalidate(var, is_aliased(var));
+					continue;
+				}
+
+				// These all have a result type and ID. For anything else, any word may be an ID which is read.
+				if (!opcode_has_side_effects(op, ops, i.length))
+				{
+					if (i.length < 3)
+						continue;
+
+					SmallVector<uint32_t> deps;
+					for (uint32_t arg = 2; arg < i.length; arg++)
+					{
+						read(ops[arg]);
+						inherit(deps, ops[arg]);
+					}
+
+					bool access_chain = op == OpAccessChain || op == OpInBoundsAccessChain || op == OpPtrAccessChain;
+					if (access_chain)
+						base_variables[ops[1]] = base_variable(ops[2]);
+
+					if (op == OpLoad)
+					{
+						// Opaque handles and pointers are never flushed to temporaries.
+						auto &type = get<SPIRType>(ops[0]);
+						if (!type.pointer && type.basetype != SPIRType::Image &&
+						    type.basetype != SPIRType::SampledImage && type.basetype != SPIRType::Sampler &&
+						    type.basetype != SPIRType::AccelerationStructure)
+						{
+							deps.push_back(ops[1]);
+							pending_loads[ops[1]] = base_variable(ops[2]);
+						}
+					}
+
+					// Each word of the instruction counts as a read, so the result itself is counted once.
+					// Access chains are never turned into temporaries.
+					if (!deps.empty() && (op == OpLoad || access_chain || read_counts[ops[1]] <= 2))
+						load_dependencies[ops[1]] = move(deps);
+					continue;
+				}
+
+				for (uint32_t arg = 0; arg < i.length; arg++)
+					read(ops[arg]);
+				if (op == OpImageWrite)
+					invalidate(0, true);
+				else if (opcode_may_write_memory(op))
+					invalidate(0, false);
+			}
+
+			read(block.condition);
+			read(block.return_value);
+		}
+	});
+}
+
+static bool opcode_is_commutative(Op op)
+{
+	switch (op)
+	{
+	case OpIAdd:
+	case OpFAdd:
+	case OpIMul:
+	case OpFMul:
+	case OpDot:
+	case OpBitwiseOr:
+	case OpBitwiseXor:
+	case OpBitwiseAnd:
+	case OpLogicalOr:
+	case OpLogicalAnd:
+	case OpLogicalEqual:
+	case OpLogicalNotEqual:
+	case OpIEqual:
+	case OpINotEqual:
+	case OpFOrdEqual:
+	case OpFOrdNotEqual:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+// The instructions analyze_common_subexpressions() can alias or drop, all of them have a result type and ID.
+static bool opcode_is_common_subexpression_candidate(Op op)
+{
+	return op == OpAccessChain || op == OpInBoundsAccessChain || op == OpLoad || op == OpCompositeExtract ||
+	       op == OpVectorShuffle || opcode_is_simple_arithmetic(op);
+}
+
+bool CompilerGLSL::is_read_only_load_source(uint32_t ptr) const
+{
+	auto *var = maybe_get<SPIRVariable>(ptr);
+	if (!var)
+		return false;
+
+	// HelperInvocation can change after demote.
+	if (has_decoration(ptr, DecorationVolatile) || (has_decoration(ptr, DecorationBuiltIn) &&
+	                                               get_decoration(ptr, DecorationBuiltIn) == BuiltInHelperInvocation))
+	{
+		return false;
+	}
+
+	switch (var->storage)
+	{
+	case StorageClassUniform:
+		return !has_decoration(get<SPIRType>(var->basetype).self, DecorationBufferBlock);
+	case StorageClassPushConstant:
+	case StorageClassInput:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void CompilerGLSL::analyze_common_subexpressions()
+{
+	// Within a block, identical pure expressions and loads from memory which cannot change
+	// during the invocation are computed once into a temporary, and later occurrences reuse it.
+	// An instruction is identified by its opcode, result type and the value numbers of its operands,
+	// so chains of equivalent expressions collapse even when they are spelled with different IDs.
+	// Expressions which are cheap to recompute are left alone, since a temporary costs as much as it saves.
+	// Loop headers and continue blocks are skipped, as they must not emit statements to form for loops.
+	// This is called on every compile(), to drop the aliases and temporaries from an earlier compile
+	// which had the option enabled.
+	common_subexpression_aliases.clear();
+	for (auto id : common_subexpression_temporaries)
+		if (!hoisted_temporaries.count(id))
+			forced_temporaries.erase(id);
+	common_subexpression_temporaries.clear();
+	if (!options.eliminate_common_subexpressions)
+		return;
+
+	// A load through an access chain is as expensive as the load and the address computation.
+	const uint32_t load_cost = 1;
+	const uint32_t min_alias_cost = 2;
+
+	std::unordered_map<uint32_t, uint32_t> base_variables;
+	std::unordered_map<uint32_t, uint32_t> value_numbers;
+	std::unordered_map<uint32_t, uint32_t> costs;
+	std::map<std::vector<uint32_t>, uint32_t> expressions;
+	std::vector<uint32_t> key;
+	std::unordered_set<uint32_t> alias_ids;
+	std::unordered_set<uint32_t> redundant_ids;
+	std::unordered_map<uint32_t, uint32_t> live_reads;
+
+	const auto value_number = [&](uint32_t id) -> uint32_t {
+		auto itr = value_numbers.find(id);
+		return itr != end(value_numbers) ? itr->second : id;
+	};
+
+	const auto cost_of = [&](uint32_t id) -> uint32_t {
+		auto itr = costs.find(id);
+		return itr != end(costs) ? itr->second : 0;
+	};
+
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, const SPIRFunction &func) {
+		// Access chains may be declared in a dominating block, so find the base variables up front.
+		base_variables.clear();
+		alias_ids.clear();
+		redundant_ids.clear();
+		for (auto block_id : func.blocks)
+		{
+			for (auto &i : get<SPIRBlock>(block_id).ops)
+			{
+				auto op = static_cast<Op>(i.op);
+				if ((op == OpAccessChain || op == OpInBoundsAccessChain) && i.length >= 3)
+				{
+					auto *ops = stream(i);
+					auto itr = base_variables.find(ops[2]);
+					base_variables[ops[1]] = itr != end(base_variables) ? itr->second : ops[2];
+				}
+			}
+		}
+
+		for (auto block_id : func.blocks)
+		{
+			if ((ir.block_meta[block_id] & (ParsedIR::BLOCK_META_LOOP_HEADER_BIT | ParsedIR::BLOCK_META_CONTINUE_BIT)) != 0)
+				continue;
+
+			value_numbers.clear();
+			costs.clear();
+			expressions.clear();
+
+			for (auto &i : get<SPIRBlock>(block_id).ops)
+			{
+				auto op = static_cast<Op>(i.op);
+				if (i.length < 3 || !opcode_is_common_subexpression_candidate(op))
+					continue;
+
+				auto *ops = stream(i);
+				uint32_t result_type = ops[0];
+				uint32_t id = ops[1];
+				uint32_t cost = 0;
+				bool alias_candidate = true;
+
+				if (op == OpAccessChain || op == OpInBoundsAccessChain)
+				{
+					// Only used to identify loads, the pointer itself is never reused.
+					auto itr = base_variables.find(id);
+					if (itr == end(base_variables) || !is_read_only_load_source(itr->second))
+						continue;
+					alias_candidate = false;
+					cost = 1;
+				}
+				else if (op == OpLoad)
+				{
+					auto itr = base_variables.find(ops[2]);
+					if (!is_read_only_load_source(itr != end(base_variables) ? itr->second : ops[2]))
+						continue;
+					cost = load_cost;
+				}
+				else if (opcode_is_simple_arithmetic(op) || op == OpCompositeExtract || op == OpVectorShuffle)
+					cost = 1;
+				else
+					continue;
+
+				auto &type = get<SPIRType>(result_type);
+				if (alias_candidate && (type.pointer || !type.array.empty() || type.basetype == SPIRType::Struct))
+					continue;
+
+				key.clear();
+				key.push_back(i.op);
+				key.push_back(result_type);
+				for (uint32_t arg = 2; arg < i.length; arg++)
+				{
+					// Literals in composite extracts and shuffles are not IDs.
+					bool literal = (op == OpCompositeExtract && arg >= 3) || (op == OpVectorShuffle && arg >= 4);
+					key.push_back(literal ? ops[arg] : value_number(ops[arg]));
+					if (!literal)
+						cost += cost_of(ops[arg]);
+				}
+
+				if (opcode_is_commutative(op) && key.size() == 4 && key[2] > key[3])
+					std::swap(key[2], key[3]);
+
+				auto itr = expressions.find(key);
+				if (itr == end(expressions))
+				{
+					expressions[key] = id;
+					costs[id] = cost;
+					continue;
+				}
+
+				uint32_t canonical = itr->second;
+				value_numbers[id] = canonical;
+
+				if (alias_candidate && cost >= min_alias_cost)
+				{
+					common_subexpression_aliases[id] = canonical;
+					alias_ids.insert(id);
+					// The alias is a plain reference to a temporary, and costs nothing to recompute.
+					costs[canonical] = 0;
+				}
+				else
+				{
+					redundant_ids.insert(id);
+					costs[id] = cost;
+				}
+			}
+		}
+
+		if (alias_ids.empty())
+			return;
+
+		// Redundant expressions which are only consumed by aliases are never read, and are not emitted at all.
+		// A canonical expression only needs a temporary if some emitted instruction reads one of its aliases.
+		// Blocks are ordered by dominance, so walking backwards sees all reads before the definition.
+		// Any word of an instruction counts as a read, which can only keep more code than needed.
+		live_reads.clear();
+		for (auto block_id : func.blocks)
+		{
+			auto &block = get<SPIRBlock>(block_id);
+			live_reads[block.condition]++;
+			live_reads[block.return_value]++;
+			for (auto &phi : block.phi_variables)
+				live_reads[phi.local_variable]++;
+		}
+
+		for (size_t block_index = func.blocks.size(); block_index; block_index--)
+		{
+			auto &ops = get<SPIRBlock>(func.blocks[block_index - 1]).ops;
+			for (size_t op_index = ops.size(); op_index; op_index--)
+			{
+				auto &i = ops[op_index - 1];
+				auto *args = stream(i);
+				bool candidate = i.length >= 3 && opcode_is_common_subexpression_candidate(static_cast<Op>(i.op));
+				if (candidate && alias_ids.count(args[1]))
+					continue;
+				if (candidate && redundant_ids.count(args[1]) && live_reads[args[1]] == 0)
+					continue;
+
+				for (uint32_t arg = 0; arg < i.length; arg++)
+					live_reads[args[arg]]++;
+			}
+		}
+
+		for (auto redundant : redundant_ids)
+			if (live_reads[redundant] == 0)
+				common_subexpression_aliases[redundant] = 0;
+
+		for (auto alias : alias_ids)
+		{
+			auto &canonical = common_subexpression_aliases[alias];
+			if (live_reads[alias] != 0)
+			{
+				if (forced_temporaries.insert(canonical).second)
+					common_subexpression_temporaries.insert(canonical);
+			}
+			else
+				canonical = 0;
+		}
+	});
+}
+
+void CompilerGLSL::analyze_relaxed_precision()
+{
+	// Infers which float values can be declared mediump, for modules which carry few or no
+	// RelaxedPrecision decorations, e.g. modules compiled from HLSL.
+	// Sampled texels and fragment shader inputs are mediump sources, and arithmetic which only consumes mediump values
+	// and constants within mediump range is mediump as well. Fragment shader outputs take whatever is stored to them.
+	// Texture coordinates, integer conversions, stores to memory, function calls, return values and outputs
+	// of other stages demand highp, and this demand is propagated back through everything feeding into them first.
+	// Chosen values are decorated with RelaxedPrecision, which their declarations then pick up.
+	// Combined image samplers whose texels are all relaxed are decorated as well.
+	// This is called on every compile(), and first removes the decorations an earlier compile() added,
+	// so the result does not depend on earlier options.
+	for (auto id : inferred_relaxed_precision_ids)
+		unset_decoration(id, DecorationRelaxedPrecision);
+	inferred_relaxed_precision_ids.clear();
+
+	if (!options.infer_relaxed_precision || !(options.es || backend.allow_precision_qualifiers))
+		return;
+
+	struct Node
+	{
+		SmallVector<uint32_t> inputs;
+		bool relaxable = false;
+		bool source = false;
+		// Access chains only forward the precision of their base variable and are never declared.
+		bool transparent = false;
+		// Variables are declared with their own precision, so stores into them do not evaluate anything.
+		bool variable = false;
+	};
+
+	std::unordered_map<uint32_t, Node> nodes;
+	SmallVector<uint32_t> node_order;
+	SmallVector<uint32_t> demands;
+	std::unordered_map<uint32_t, uint32_t> base_variables;
+	std::unordered_set<uint32_t> needs_highp;
+	std::unordered_set<uint32_t> relaxed;
+	std::unordered_set<uint32_t> parameters;
+	// Maps loads of combined image samplers to their variable, and sampled texels to the load.
+	std::unordered_map<uint32_t, uint32_t> sampler_loads;
+	std::unordered_map<uint32_t, uint32_t> sampled_texels;
+
+	bool is_fragment = get_execution_model() == ExecutionModelFragment;
+
+	const auto is_relaxable_type = [&](uint32_t type_id) {
+		auto &type = get<SPIRType>(type_id);
+		return type.basetype == SPIRType::Float && type.width == 32;
+	};
+
+	const auto add_node = [&](uint32_t id) -> Node & {
+		auto &node = nodes[id];
+		node_order.push_back(id);
+		return node;
+	};
+
+	const auto base_variable = [&](uint32_t ptr) -> uint32_t {
+		auto itr = base_variables.find(ptr);
+		return itr != end(base_variables) ? itr->second : ptr;
+	};
+
+	const auto is_small_constant = [&](uint32_t id) -> bool {
+		if (maybe_get<SPIRUndef>(id))
+			return true;
+
+		auto *c = maybe_get<SPIRConstant>(id);
+		if (!c || c->specialization || !is_relaxable_type(c->constant_type))
+			return false;
+
+		// Subconstants are not looked into, they are rare in arithmetic.
+		if (!c->subconstants.empty())
+			return false;
+
+		// Mediump only guarantees a range of (-2^14, 2^14).
+		for (uint32_t col = 0; col < c->columns(); col++)
+			for (uint32_t row = 0; row < c->vector_size(); row++)
+				if (!(std::abs(c->scalar_f32(col, row)) <= 16384.0f))
+					return false;
+		return true;
+	};
+
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, const SPIRFunction &func) {
+		for (auto &arg : func.arguments)
+			parameters.insert(arg.id);
+	});
+
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t id, const SPIRVariable &var) {
+		if (var.phi_variable || parameters.count(id) || !is_relaxable_type(var.basetype))
+			return;
+
+		bool builtin = is_builtin_variable(var);
+		switch (var.storage)
+		{
+		case StorageClassFunction:
+		case StorageClassPrivate:
+		{
+			auto &node = add_node(id);
+			node.relaxable = true;
+			node.variable = true;
+			if (var.initializer)
+				node.inputs.push_back(var.initializer);
+			break;
+		}
+
+		case StorageClassInput:
+			if (is_fragment && !builtin)
+			{
+				auto &node = add_node(id);
+				node.relaxable = true;
+				node.variable = true;
+				node.source = true;
+			}
+			break;
+
+		case StorageClassOutput:
+			if (is_fragment && !builtin)
+			{
+				auto &node = add_node(id);
+				node.relaxable = true;
+				node.variable = true;
+				if (var.initializer)
+					node.inputs.push_back(var.initializer);
+			}
+			break;
+
+		default:
+			break;
+		}
+	});
+
+	ir.for_each_typed_id<SPIRFunction>([&](uint32_t, const SPIRFunction &func) {
+		// Access chains may be declared in a dominating block, so find the base variables up front.
+		for (auto block_id : func.blocks)
+		{
+			for (auto &i : get<SPIRBlock>(block_id).ops)
+			{
+				auto op = static_cast<Op>(i.op);
+				if ((op == OpAccessChain || op == OpInBoundsAccessChain) && i.length >= 3)
+				{
+					auto *ops = stream(i);
+					base_variables[ops[1]] = base_variable(ops[2]);
+				}
+			}
+		}
+
+		for (auto block_id : func.blocks)
+		{
+			auto &block = get<SPIRBlock>(block_id);
+
+			for (auto &phi : block.phi_variables)
+			{
+				auto itr = nodes.find(phi.function_variable);
+				if (itr == end(nodes))
+				{
+					auto &node = add_node(phi.function_variable);
+					node.relaxable = is_relaxable_type(get<SPIRVariable>(phi.function_variable).basetype);
+					node.variable = true;
+					node.inputs.push_back(phi.local_variable);
+				}
+				else
+					itr->second.inputs.push_back(phi.local_variable);
+			}
+
+			if (block.return_value)
+				demands.push_back(block.return_value);
+
+			for (auto &i : block.ops)
+			{
+				auto op = static_cast<Op>(i.op);
+				auto *ops = stream(i);
+				uint32_t first_input = 2;
+				uint32_t last_input = i.length;
+				bool source = false;
+
+				switch (op)
+				{
+				case OpFAdd:
+				case OpFSub:
+				case OpFMul:
+				case OpFDiv:
+				case OpFMod:
+				case OpFRem:
+				case OpFNegate:
+				case OpVectorTimesScalar:
+				case OpDot:
+				case OpCopyObject:
+				case OpCompositeConstruct:
+				case OpLoad:
+					break;
+
+				case OpVectorShuffle:
+				case OpCompositeInsert:
+					last_input = 4;
+					break;
+
+				case OpCompositeExtract:
+					last_input = 3;
+					break;
+
+				case OpSelect:
+					// The condition is a boolean.
+					first_input = 3;
+					break;
+
+				case OpAccessChain:
+				case OpInBoundsAccessChain:
+					// The indices are integers, which are never relaxed.
+					last_input = 3;
+					break;
+
+				case OpImageSampleImplicitLod:
+				case OpImageSampleExplicitLod:
+				case OpImageSampleDrefImplicitLod:
+				case OpImageSampleDrefExplicitLod:
+				case OpImageSampleProjImplicitLod:
+				case OpImageSampleProjExplicitLod:
+				case OpImageSampleProjDrefImplicitLod:
+				case OpImageSampleProjDrefExplicitLod:
+				case OpImageFetch:
+				case OpImageGather:
+				case OpImageDrefGather:
+					// Coordinates and image operands need highp.
+					source = true;
+					sampled_texels[ops[1]] = ops[2];
+					for (uint32_t arg = 3; arg < i.length; arg++)
+						demands.push_back(ops[arg]);
+					first_input = last_input = 0;
+					break;
+
+				case OpExtInst:
+				{
+					if (i.length < 4 || get<SPIRExtension>(ops[2]).ext != SPIRExtension::GLSL)
+					{
+						op = OpNop;
+						break;
+					}
+
+					switch (static_cast<GLSLstd450>(ops[3]))
+					{
+					case GLSLstd450FAbs:
+					case GLSLstd450FSign:
+					case GLSLstd450Floor:
+					case GLSLstd450Ceil:
+					case GLSLstd450Trunc:
+					case GLSLstd450Round:
+					case GLSLstd450RoundEven:
+					case GLSLstd450Fract:
+					case GLSLstd450FMin:
+					case GLSLstd450FMax:
+					case GLSLstd450FClamp:
+					case GLSLstd450NMin:
+					case GLSLstd450NMax:
+					case GLSLstd450NClamp:
+					case GLSLstd450FMix:
+					case GLSLstd450Fma:
+					case GLSLstd450Step:
+					case GLSLstd450SmoothStep:
+					case GLSLstd450Sqrt:
+					case GLSLstd450InverseSqrt:
+					case GLSLstd450Pow:
+					case GLSLstd450Exp:
+					case GLSLstd450Exp2:
+					case GLSLstd450Log:
+					case GLSLstd450Log2:
+					case GLSLstd450Sin:
+					case GLSLstd450Cos:
+					case GLSLstd450Length:
+					case GLSLstd450Distance:
+					case GLSLstd450Normalize:
+					case GLSLstd450Cross:
+					case GLSLstd450Reflect:
+						first_input = 4;
+						break;
+
+					default:
+						op = OpNop;
+						break;
+					}
+					break;
+				}
+
+				case OpStore:
+				{
+					if (i.length < 2)
+						break;
+
+					// Stores feed the variable, unless it is memory which must stay highp.
+					auto itr = nodes.find(base_variable(ops[0]));
+					if (itr != end(nodes))
+						itr->second.inputs.push_back(ops[1]);
+					else
+						demands.push_back(ops[1]);
+					continue;
+				}
+
+				case OpFOrdEqual:
+				case OpFUnordEqual:
+				case OpFOrdNotEqual:
+				case OpFUnordNotEqual:
+				case OpFOrdLessThan:
+				case OpFUnordLessThan:
+				case OpFOrdGreaterThan:
+				case OpFUnordGreaterThan:
+				case OpFOrdLessThanEqual:
+				case OpFUnordLessThanEqual:
+				case OpFOrdGreaterThanEqual:
+				case OpFUnordGreaterThanEqual:
+				case OpIsNan:
+				case OpIsInf:
+					// Comparisons are fine in mediump, and their results are booleans.
+					continue;
 
-	var.compat_builtin = true; // We don't want to declare this variable, but use the name as-is.
-}
+				default:
+					op = OpNop;
+					break;
+				}
 
-void CompilerGLSL::replace_fragment_outputs()
-{
-	ir.for_each_typed_id<SPIRVariable>([&](uint32_t, SPIRVariable &var) {
-		auto &type = this->get<SPIRType>(var.basetype);
+				if (op == OpNop)
+				{
+					// Anything else is assumed to need highp operands.
+					// Words which are not IDs can only make this more conservative.
+					for (uint32_t arg = 0; arg < i.length; arg++)
+						demands.push_back(ops[arg]);
+					continue;
+				}
 
-		if (!is_builtin_variable(var) && !var.remapped_variable && type.pointer && var.storage == StorageClassOutput)
-			replace_fragment_output(var);
+				if (i.length < 3)
+					continue;
+
+				if (op == OpLoad)
+				{
+					auto *var = maybe_get<SPIRVariable>(base_variable(ops[2]));
+					if (var && var->storage == StorageClassUniformConstant &&
+					    get<SPIRType>(ops[0]).basetype == SPIRType::SampledImage)
+						sampler_loads[ops[1]] = var->self;
+				}
+
+				auto &node = add_node(ops[1]);
+				node.source = source;
+				if (op == OpAccessChain || op == OpInBoundsAccessChain)
+					node.transparent = true;
+				else
+					node.relaxable = is_relaxable_type(ops[0]);
+				for (uint32_t arg = first_input; arg < last_input && arg < i.length; arg++)
+					node.inputs.push_back(ops[arg]);
+			}
+		}
 	});
-}
 
-string CompilerGLSL::remap_swizzle(const SPIRType &out_type, uint32_t input_components, const string &expr)
-{
-	if (out_type.vecsize == input_components)
-		return expr;
-	else if (input_components == 1 && !backend.can_swizzle_scalar)
-		return join(type_to_glsl(out_type), "(", expr, ")");
-	else
+	const auto propagate_demands = [&]() {
+		bool grew = false;
+		while (!demands.empty())
+		{
+			uint32_t id = demands.back();
+			demands.pop_back();
+			auto itr = nodes.find(id);
+			if (itr == end(nodes) || !needs_highp.insert(id).second)
+				continue;
+			grew = true;
+			for (auto input : itr->second.inputs)
+				demands.push_back(input);
+		}
+		return grew;
+	};
+
+	const auto is_relaxed = [&](uint32_t id) {
+		return relaxed.count(id) != 0 || has_decoration(id, DecorationRelaxedPrecision);
+	};
+
+	std::unordered_set<uint32_t> highp_operands;
+	propagate_demands();
+
+	for (;;)
 	{
-		// FIXME: This will not work with packed expressions.
-		auto e = enclose_expression(expr) + ".";
-		// Just clamp the swizzle index if we have more outputs than inputs.
-		for (uint32_t c = 0; c < out_type.vecsize; c++)
-			e += index_to_swizzle(min(c, input_components - 1));
-		if (backend.swizzle_is_function && out_type.vecsize > 1)
-			e += "()";
+		// Grow the set of relaxed values until it is stable, so values computed in loops are found as well.
+		relaxed.clear();
+		bool changed = true;
+		while (changed)
+		{
+			changed = false;
+			for (auto id : node_order)
+			{
+				auto &node = nodes[id];
+				if ((!node.relaxable && !node.transparent) || needs_highp.count(id) || relaxed.count(id))
+					continue;
 
-		remove_duplicate_swizzle(e);
-		return e;
-	}
-}
+				bool any_relaxed = node.source;
+				bool all_relaxed = node.source || !node.inputs.empty();
+				if (!node.source)
+				{
+					for (auto input : node.inputs)
+					{
+						if (is_relaxed(input))
+							any_relaxed = true;
+						else if (!is_small_constant(input))
+						{
+							all_relaxed = false;
+							break;
+						}
+					}
+				}
 
-void CompilerGLSL::emit_pls()
-{
-	auto &execution = get_entry_point();
-	if (execution.model != ExecutionModelFragment)
-		SPIRV_CROSS_THROW("Pixel local storage only supported in fragment shaders.");
+				if (any_relaxed && all_relaxed)
+				{
+					relaxed.insert(id);
+					changed = true;
+				}
+			}
+		}
 
-	if (!options.es)
-		SPIRV_CROSS_THROW("Pixel local storage only supported in OpenGL ES.");
+		// An operation is evaluated in the highest precision of its operands, and constants do not count.
+		// Find which values are certainly highp, i.e. declared highp, or computed from something highp.
+		// Conservatively, anything which is not known about counts as highp as well,
+		// e.g. uniforms, function parameters and integer conversions.
+		highp_operands.clear();
+		changed = true;
+		while (changed)
+		{
+			changed = false;
+			for (auto id : node_order)
+			{
+				auto &node = nodes[id];
+				if (is_relaxed(id) || highp_operands.count(id))
+					continue;
 
-	if (options.version < 300)
-		SPIRV_CROSS_THROW("Pixel local storage only supported in ESSL 3.0 and above.");
+				bool highp = node.variable;
+				for (auto input : node.inputs)
+				{
+					if (highp)
+						break;
+					highp = highp_operands.count(input) ||
+					        (!nodes.count(input) && !is_relaxed(input) && !maybe_get<SPIRConstant>(input) &&
+					         !maybe_get<SPIRUndef>(input));
+				}
 
-	if (!pls_inputs.empty())
+				if (highp)
+				{
+					highp_operands.insert(id);
+					changed = true;
+				}
+			}
+		}
+
+		// A value which is not relaxed, but only consumes relaxed values and constants, would be evaluated
+		// in mediump anyways, so its inputs must stay highp.
+		for (auto id : node_order)
+		{
+			auto &node = nodes[id];
+			if (is_relaxed(id) || highp_operands.count(id))
+				continue;
+			for (auto input : node.inputs)
+				if (is_relaxed(input))
+					demands.push_back(input);
+		}
+
+		if (!propagate_demands())
+			break;
+	}
+
+	for (auto id : node_order)
 	{
-		statement("__pixel_local_inEXT _PLSIn");
-		begin_scope();
-		for (auto &input : pls_inputs)
-			statement(pls_decl(input), ";");
-		end_scope_decl();
-		statement("");
+		if (relaxed.count(id) && !nodes[id].transparent && !has_decoration(id, DecorationRelaxedPrecision))
+		{
+			set_decoration(id, DecorationRelaxedPrecision);
+			inferred_relaxed_precision_ids.push_back(id);
+		}
 	}
 
-	if (!pls_outputs.empty())
+	// Samplers can be declared mediump if they are only used for sampling, and all their texels are relaxed.
+	// Any other use of a sampler, e.g. passing it to a function, demands highp on the load.
+	std::unordered_map<uint32_t, bool> relaxed_samplers;
+	for (auto &load : sampler_loads)
 	{
-		statement("__pixel_local_outEXT _PLSOut");
-		begin_scope();
-		for (auto &output : pls_outputs)
-			statement(pls_decl(output), ";");
-		end_scope_decl();
-		statement("");
+		auto itr = relaxed_samplers.insert({ load.second, true }).first;
+		if (needs_highp.count(load.first))
+			itr->second = false;
 	}
-}
 
-void CompilerGLSL::fixup_image_load_store_access()
-{
-	if (!options.enable_storage_image_qualifier_deduction)
-		return;
+	for (auto &texel : sampled_texels)
+	{
+		auto itr = sampler_loads.find(texel.second);
+		if (itr != end(sampler_loads) && !relaxed.count(texel.first))
+			relaxed_samplers[itr->second] = false;
+	}
 
-	ir.for_each_typed_id<SPIRVariable>([&](uint32_t var, const SPIRVariable &) {
-		auto &vartype = expression_type(var);
-		if (vartype.basetype == SPIRType::Image && vartype.image.sampled == 2)
+	for (auto &sampler : relaxed_samplers)
+	{
+		if (sampler.second && !has_decoration(sampler.first, DecorationRelaxedPrecision))
 		{
-			// Very old glslangValidator and HLSL compilers do not emit required qualifiers here.
-			// Solve this by making the image access as restricted as possible and loosen up if we need to.
-			// If any no-read/no-write flags are actually set, assume that the compiler knows what it's doing.
-
-			auto &flags = ir.meta[var].decoration.decoration_flags;
-			if (!flags.get(DecorationNonWritable) && !flags.get(DecorationNonReadable))
-			{
-				flags.set(DecorationNonWritable);
-				flags.set(DecorationNonReadable);
-			}
+			set_decoration(sampler.first, DecorationRelaxedPrecision);
+			inferred_relaxed_precision_ids.push_back(sampler.first);
 		}
-	});
+	}
+
+	sort(begin(inferred_relaxed_precision_ids), end(inferred_relaxed_precision_ids));
 }
 
 static bool is_block_builtin(BuiltIn builtin)
@@ -3135,6 +4324,8 @@ bool CompilerGLSL::variable_is_lut(const SPIRVariable &var) const
 
 void CompilerGLSL::emit_resources()
 {
+	SPIRV_CROSS_TRACE_SCOPE(trace_callback, TraceEventEmitResources, 0);
+
 	auto &execution = get_entry_point();
 
 	replace_illegal_names();
@@ -4082,7 +5273,7 @@ void CompilerGLSL::handle_invalid_expression(uint32_t id)
 	// We tried to read an invalidated expression.
 	// This means we need another pass at compilation, but next time, force temporary variables so that they cannot be invalidated.
 	forced_temporaries.insert(id);
-	force_recompile();
+	force_recompile(RecompileReasonInvalidatedExpression);
 }
 
 // Converts the format of the current expression from packed to unpacked,
@@ -4392,10 +5583,23 @@ string CompilerGLSL::to_expression(uint32_t id, bool register_expression_read)
 		//
 		// However, we can propagate up a list of depended expressions when we used %2, so we can check if %2 is invalid when reading %3 after the store,
 		// and see that we should not forward reads of the original variable.
+		//
+		// Dependency lists are sorted and can grow large on long expression chains, while there are usually
+		// very few invalid expressions, so probe from whichever side is smaller.
 		auto &expr = get<SPIRExpression>(id);
-		for (uint32_t dep : expr.expression_dependencies)
-			if (invalid_expressions.find(dep) != end(invalid_expressions))
-				handle_invalid_expression(dep);
+		auto &deps = expr.expression_dependencies;
+		if (invalid_expressions.size() < deps.size())
+		{
+			for (uint32_t dep : invalid_expressions)
+				if (binary_search(begin(deps), end(deps), ID(dep)))
+					handle_invalid_expression(dep);
+		}
+		else
+		{
+			for (uint32_t dep : deps)
+				if (invalid_expressions.find(dep) != end(invalid_expressions))
+					handle_invalid_expression(dep);
+		}
 	}
 
 	if (register_expression_read)
@@ -5406,7 +6610,7 @@ void CompilerGLSL::emit_uninitialized_temporary(uint32_t result_type, uint32_t r
 		{
 			header.declare_temporary.emplace_back(result_type, result_id);
 			hoisted_temporaries.insert(result_id);
-			force_recompile();
+			force_recompile(RecompileReasonHoistedTemporary);
 		}
 	}
 	else if (hoisted_temporaries.count(result_id) == 0)
@@ -5442,7 +6646,7 @@ string CompilerGLSL::declare_temporary(uint32_t result_type, uint32_t result_id)
 		{
 			header.declare_temporary.emplace_back(result_type, result_id);
 			hoisted_temporaries.insert(result_id);
-			force_recompile();
+			force_recompile(RecompileReasonHoistedTemporary);
 		}
 
 		return join(to_name(result_id), " = ");
@@ -5492,7 +6696,9 @@ SPIRExpression &CompilerGLSL::emit_op(uint32_t result_type, uint32_t result_id,
 		if (suppress_usage_tracking)
 			suppressed_usage_tracking.insert(result_id);
 
-		return set<SPIRExpression>(result_id, rhs, result_type, true);
+		auto &expr = set<SPIRExpression>(result_id, rhs, result_type, true);
+		check_expression_budget(expr);
+		return expr;
 	}
 	else
 	{
@@ -8378,6 +9584,15 @@ string CompilerGLSL::access_chain_internal(uint32_t base, const uint32_t *indice
 
 	const auto *type = &get_pointee_type(type_id);
 
+	// If we continue a chain which ended in a matrix column, we know where the column subscript is.
+	size_t column_offset = string::npos;
+	if (!chain_only)
+	{
+		auto *e = maybe_get<SPIRExpression>(base);
+		if (e && e->access_chain_column_offset != string::npos && e->expression == expr)
+			column_offset = e->access_chain_column_offset;
+	}
+
 	bool access_chain_is_arrayed = expr.find_first_of('[') != string::npos;
 	bool row_major_matrix_needs_conversion = is_non_native_row_major_matrix(base);
 	bool is_packed = has_extended_decoration(base, SPIRVCrossDecorationPhysicalTypePacked);
@@ -8396,6 +9611,7 @@ string CompilerGLSL::access_chain_internal(uint32_t base, const uint32_t *indice
 	for (uint32_t i = 0; i < count; i++)
 	{
 		uint32_t index = indices[i];
+		size_t step_column_offset = string::npos;
 
 		bool is_literal = index_is_literal;
 		if (is_literal && msb_is_id && (index >> 31u) != 0u)
@@ -8584,6 +9800,7 @@ string CompilerGLSL::access_chain_internal(uint32_t base, const uint32_t *indice
 			// is used to store a column. We can resolve it right here and now if we access a scalar directly,
 			// by flipping indexing order of the matrix.
 
+			step_column_offset = expr.size();
 			expr += "[";
 			if (is_literal)
 				expr += convert_to_string(index);
@@ -8601,7 +9818,7 @@ string CompilerGLSL::access_chain_internal(uint32_t base, const uint32_t *indice
 			if (row_major_matrix_needs_conversion)
 			{
 				// Flip indexing order.
-				auto column_index = expr.find_last_of('[');
+				auto column_index = column_offset != string::npos ? column_offset : expr.find_last_of('[');
 				if (column_index != string::npos)
 				{
 					deferred_index = expr.substr(column_index);
@@ -8673,6 +9890,8 @@ string CompilerGLSL::access_chain_internal(uint32_t base, const uint32_t *indice
 		}
 		else if (!backend.allow_truncated_access_chain)
 			SPIRV_CROSS_THROW("Cannot subdivide a scalar value!");
+
+		column_offset = step_column_offset;
 	}
 
 	if (pending_array_enclose)
@@ -8688,6 +9907,7 @@ string CompilerGLSL::access_chain_internal(uint32_t base, const uint32_t *indice
 		meta->storage_is_packed = is_packed;
 		meta->storage_is_invariant = is_invariant;
 		meta->storage_physical_type = physical_type;
+		meta->column_offset = row_major_matrix_needs_conversion ? column_offset : string::npos;
 	}
 
 	return expr;
@@ -8697,6 +9917,15 @@ void CompilerGLSL::prepare_access_chain_for_scalar_access(std::string &, const S
 {
 }
 
+size_t CompilerGLSL::get_column_subscript_offset(uint32_t id, const std::string &expr) const
+{
+	auto *e = maybe_get<SPIRExpression>(id);
+	if (e && e->access_chain_column_offset < expr.size() && e->expression == expr)
+		return e->access_chain_column_offset;
+	else
+		return expr.find_last_of('[');
+}
+
 string CompilerGLSL::to_flattened_struct_member(const string &basename, const SPIRType &type, uint32_t index)
 {
 	auto ret = join(basename, "_", to_member_name(type, index));
@@ -9247,7 +10476,7 @@ void CompilerGLSL::track_expression_read(uint32_t id)
 
 			forced_temporaries.insert(id);
 			// Force a recompile after this pass to avoid forwarding this variable.
-			force_recompile();
+			force_recompile(RecompileReasonForcedTemporary);
 		}
 	}
 }
@@ -9588,11 +10817,38 @@ void CompilerGLSL::register_control_dependent_expression(uint32_t expr)
 void CompilerGLSL::emit_block_instructions(SPIRBlock &block)
 {
 	current_emitting_block = &block;
+
+	check_output_budget(buffer.size());
+
 	for (auto &op : block.ops)
-		emit_instruction(op);
+	{
+		check_compile_budget();
+		auto itr = end(common_subexpression_aliases);
+		if (!common_subexpression_aliases.empty() && op.length >= 3 &&
+		    opcode_is_common_subexpression_candidate(static_cast<Op>(op.op)))
+			itr = common_subexpression_aliases.find(stream(op)[1]);
+
+		if (itr == end(common_subexpression_aliases))
+			emit_instruction(op);
+		else if (itr->second)
+			emit_common_subexpression_alias(op, itr->second);
+	}
 	current_emitting_block = nullptr;
 }
 
+void CompilerGLSL::emit_common_subexpression_alias(const Instruction &instr, uint32_t canonical)
+{
+	auto *ops = stream(instr);
+	uint32_t result_type = ops[0];
+	uint32_t id = ops[1];
+
+	// The canonical expression is normally a forced temporary, so this just forwards its name,
+	// and reading it any number of times must not flush it to yet another temporary.
+	bool suppress_usage_tracking = !expression_is_forwarded(canonical) || should_suppress_usage_tracking(canonical);
+	emit_op(result_type, id, to_expression(canonical), should_forward(canonical), suppress_usage_tracking);
+	inherit_expression_dependencies(id, canonical);
+}
+
 void CompilerGLSL::disallow_forwarding_in_expression_chain(const SPIRExpression &expr)
 {
 	// Allow trivially forwarded expressions like OpLoad or trivial shuffles,
@@ -9603,7 +10859,7 @@ void CompilerGLSL::disallow_forwarding_in_expression_chain(const SPIRExpression
 	{
 		forced_temporaries.insert(expr.self);
 		forced_invariant_temporaries.insert(expr.self);
-		force_recompile();
+		force_recompile(RecompileReasonForcedTemporary);
 
 		for (auto &dependent : expr.expression_dependencies)
 			disallow_forwarding_in_expression_chain(get<SPIRExpression>(dependent));
@@ -9892,6 +11148,7 @@ void CompilerGLSL::emit_instruction(const Instruction &instruction)
 		expr.loaded_from = backing_variable ? backing_variable->self : ID(ops[2]);
 		expr.need_transpose = meta.need_transpose;
 		expr.access_chain = true;
+		expr.access_chain_column_offset = meta.column_offset;
 
 		// Mark the result as being packed. Some platforms handled packed vectors differently than non-packed.
 		if (meta.storage_is_packed)
@@ -11500,7 +12757,7 @@ void CompilerGLSL::emit_instruction(const Instruction &instruction)
 			if (flags.get(DecorationNonReadable))
 			{
 				flags.clear(DecorationNonReadable);
-				force_recompile();
+				force_recompile(RecompileReasonDecoration);
 			}
 		}
 
@@ -11695,7 +12952,7 @@ void CompilerGLSL::emit_instruction(const Instruction &instruction)
 			if (flags.get(DecorationNonWritable))
 			{
 				flags.clear(DecorationNonWritable);
-				force_recompile();
+				force_recompile(RecompileReasonDecoration);
 			}
 		}
 
@@ -12545,7 +13802,7 @@ string CompilerGLSL::convert_row_major_matrix(string exp_str, const SPIRType &ex
 			if (!requires_transpose_2x2)
 			{
 				requires_transpose_2x2 = true;
-				force_recompile();
+				force_recompile(RecompileReasonHelperFunction);
 			}
 		}
 		else if (exp_type.vecsize == 3 && exp_type.columns == 3)
@@ -12553,7 +13810,7 @@ string CompilerGLSL::convert_row_major_matrix(string exp_str, const SPIRType &ex
 			if (!requires_transpose_3x3)
 			{
 				requires_transpose_3x3 = true;
-				force_recompile();
+				force_recompile(RecompileReasonHelperFunction);
 			}
 		}
 		else if (exp_type.vecsize == 4 && exp_type.columns == 4)
@@ -12561,7 +13818,7 @@ string CompilerGLSL::convert_row_major_matrix(string exp_str, const SPIRType &ex
 			if (!requires_transpose_4x4)
 			{
 				requires_transpose_4x4 = true;
-				force_recompile();
+				force_recompile(RecompileReasonHelperFunction);
 			}
 		}
 		else
@@ -13216,8 +14473,7 @@ string CompilerGLSL::type_to_glsl(const SPIRType &type, uint32_t id)
 	}
 }
 
-void CompilerGLSL::add_variable(unordered_set<string> &variables_primary,
-                                const unordered_set<string> &variables_secondary, string &name)
+void CompilerGLSL::add_variable(NameCache &variables_primary, const NameCache &variables_secondary, string &name)
 {
 	if (name.empty())
 		return;
@@ -13264,7 +14520,7 @@ void CompilerGLSL::require_extension_internal(const string &ext)
 	if (backend.supports_extensions && !has_extension(ext))
 	{
 		forced_extensions.push_back(ext);
-		force_recompile();
+		force_recompile(RecompileReasonExtension);
 	}
 }
 
@@ -13287,6 +14543,146 @@ void CompilerGLSL::flatten_buffer_block(VariableID id)
 	flattened_buffer_blocks.insert(id);
 }
 
+bool CompilerGLSL::repack_buffer_block(VariableID id)
+{
+	auto &var = get<SPIRVariable>(id);
+	auto &type = get<SPIRType>(get<SPIRType>(var.basetype).self);
+	auto name = to_name(type.self, false);
+
+	if (var.storage != StorageClassUniform || type.basetype != SPIRType::Struct ||
+	    !has_decoration(type.self, DecorationBlock))
+		SPIRV_CROSS_THROW(name + " is not a uniform buffer block.");
+	if (type.member_types.empty())
+		SPIRV_CROSS_THROW(name + " is an empty struct.");
+
+	// The layout belongs to the type, so it must not be shared with anything but other uniform buffers.
+	if (type.type_alias)
+		return false;
+
+	bool shared = false;
+	ir.for_each_typed_id<SPIRType>([&](uint32_t, const SPIRType &other) {
+		if (other.type_alias == type.self)
+			shared = true;
+		for (auto member : other.member_types)
+			if (get<SPIRType>(member).self == type.self && other.self != type.self)
+				shared = true;
+	});
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t, const SPIRVariable &other) {
+		if (other.storage != StorageClassUniform && get<SPIRType>(other.basetype).self == type.self)
+			shared = true;
+	});
+	if (shared)
+		return false;
+
+	struct PackedMember
+	{
+		uint32_t index;
+		uint32_t alignment;
+		uint32_t size;
+		uint32_t offset;
+	};
+	SmallVector<PackedMember> members;
+	uint32_t total_size = 0;
+
+	for (uint32_t i = 0; i < uint32_t(type.member_types.size()); i++)
+	{
+		auto &memb_type = get<SPIRType>(type.member_types[i]);
+		auto &member_flags = ir.meta[type.self].members[i].decoration_flags;
+
+		if (member_flags.get(DecorationBuiltIn) || !member_flags.get(DecorationOffset) || memb_type.pointer)
+			return false;
+
+		// Only the placement of members changes, their own layout must already match std140.
+		for (auto literal : memb_type.array_size_literal)
+			if (!literal)
+				return false;
+		if (!memb_type.array.empty() && type_to_packed_array_stride(memb_type, member_flags, BufferPackingStd140) !=
+		                                    type_struct_member_array_stride(type, i))
+			return false;
+		if (memb_type.basetype == SPIRType::Struct && !buffer_is_packing_standard(memb_type, BufferPackingStd140))
+			return false;
+		if (is_matrix(memb_type))
+		{
+			SPIRType column_type = memb_type;
+			column_type.array.clear();
+			column_type.array_size_literal.clear();
+			if (member_flags.get(DecorationRowMajor))
+				column_type.vecsize = memb_type.columns;
+			column_type.columns = 1;
+			uint32_t matrix_stride = max(type_to_packed_alignment(column_type, {}, BufferPackingStd140), 16u);
+			if (matrix_stride != type_struct_member_matrix_stride(type, i))
+				return false;
+		}
+
+		PackedMember member = {};
+		member.index = i;
+		member.alignment = type_to_packed_alignment(memb_type, member_flags, BufferPackingStd140);
+		member.size = type_to_packed_size(memb_type, member_flags, BufferPackingStd140);
+
+		// The member following a struct is aligned to the base alignment of the struct.
+		if (memb_type.basetype == SPIRType::Struct)
+			member.size = (member.size + member.alignment - 1) & ~(member.alignment - 1);
+
+		total_size += member.size + member.alignment;
+		members.push_back(member);
+	}
+
+	// Place the largest alignments first, so smaller members can fill the holes they leave behind,
+	// e.g. a float goes in the last component of a vec3. Each member goes into the first slot it fits in.
+	// Since members are only ever placed in free space, declaring them in offset order matches std140.
+	auto placement_order = members;
+	stable_sort(placement_order.begin(), placement_order.end(), [](const PackedMember &a, const PackedMember &b) {
+		if (a.alignment != b.alignment)
+			return a.alignment > b.alignment;
+		return a.size > b.size;
+	});
+
+	SmallVector<uint8_t> occupied(total_size);
+	uint32_t new_size = 0;
+	uint32_t search_start = 0;
+	for (size_t i = 0; i < placement_order.size(); i++)
+	{
+		auto &member = placement_order[i];
+
+		// A member of the same shape as the previous one cannot fit anywhere before it.
+		if (i == 0 || placement_order[i - 1].alignment != member.alignment ||
+		    placement_order[i - 1].size != member.size)
+			search_start = 0;
+
+		uint32_t offset = search_start;
+		for (;; offset += member.alignment)
+		{
+			auto begin_itr = occupied.begin() + offset;
+			if (find(begin_itr, begin_itr + member.size, uint8_t(1)) == begin_itr + member.size)
+				break;
+		}
+
+		fill(occupied.begin() + offset, occupied.begin() + offset + member.size, uint8_t(1));
+		member.offset = offset;
+		search_start = (offset + member.size + member.alignment - 1) & ~(member.alignment - 1);
+		new_size = max(new_size, offset + member.size);
+		members[member.index].offset = offset;
+	}
+
+	if (new_size >= get_declared_struct_size(type))
+		return false;
+
+	bool declared_in_index_order = true;
+	for (auto &member : members)
+	{
+		set_member_decoration(type.self, member.index, DecorationOffset, member.offset);
+		if (member.index > 0 && member.offset < members[member.index - 1].offset)
+			declared_in_index_order = false;
+	}
+
+	if (declared_in_index_order)
+		unset_extended_decoration(type.self, SPIRVCrossDecorationMemberDeclarationOrderByOffset);
+	else
+		set_extended_decoration(type.self, SPIRVCrossDecorationMemberDeclarationOrderByOffset);
+
+	return true;
+}
+
 bool CompilerGLSL::builtin_translates_to_nonarray(spv::BuiltIn /*builtin*/) const
 {
 	return false; // GLSL itself does not need to translate array builtin types to non-array builtin types
@@ -13308,7 +14704,7 @@ bool CompilerGLSL::check_atomic_image(uint32_t id)
 			{
 				flags.clear(DecorationNonWritable);
 				flags.clear(DecorationNonReadable);
-				force_recompile();
+				force_recompile(RecompileReasonDecoration);
 			}
 		}
 		return true;
@@ -13446,12 +14842,23 @@ void CompilerGLSL::emit_function_prototype(SPIRFunction &func, const Bitset &ret
 }
 
 void CompilerGLSL::emit_function(SPIRFunction &func, const Bitset &return_flags)
+{
+	// Types are not restructured while function bodies are emitted, so struct layout queries can be memoized.
+	set_layout_cache_enabled(true);
+	emit_function_with_callees(func, return_flags);
+	set_layout_cache_enabled(false);
+	check_output_budget(buffer.size());
+}
+
+void CompilerGLSL::emit_function_with_callees(SPIRFunction &func, const Bitset &return_flags)
 {
 	// Avoid potential cycles.
 	if (func.active)
 		return;
 	func.active = true;
 
+	SPIRV_CROSS_TRACE_SCOPE(trace_callback, TraceEventEmitFunction, func.self);
+
 	// If we depend on a function, emit that function before we emit our own function.
 	for (auto block : func.blocks)
 	{
@@ -13465,7 +14872,7 @@ void CompilerGLSL::emit_function(SPIRFunction &func, const Bitset &return_flags)
 			{
 				// Recursively emit functions which are called.
 				uint32_t id = ops[2];
-				emit_function(get<SPIRFunction>(id), ir.meta[ops[1]].decoration.decoration_flags);
+				emit_function_with_callees(get<SPIRFunction>(id), ir.meta[ops[1]].decoration.decoration_flags);
 			}
 		}
 	}
@@ -13499,8 +14906,12 @@ void CompilerGLSL::emit_function(SPIRFunction &func, const Bitset &return_flags)
 			// Special variable type which cannot have initializer,
 			// need to be declared as standalone variables.
 			// Comes from MSL which can push global variables as local variables in main function.
-			add_local_variable_name(var.self);
-			statement(variable_decl(var), ";");
+			// Aliased variables share the declaration of the variable they alias.
+			if (!workgroup_variable_aliases.count(var.self))
+			{
+				add_local_variable_name(var.self);
+				statement(variable_decl(var), ";");
+			}
 			var.deferred_declaration = false;
 		}
 		else if (var.storage == StorageClassPrivate)
@@ -13642,7 +15053,7 @@ void CompilerGLSL::flush_phi(BlockID from, BlockID to)
 					if (!var.allocate_temporary_copy)
 					{
 						var.allocate_temporary_copy = true;
-						force_recompile();
+						force_recompile(RecompileReasonForcedTemporary);
 					}
 					statement("_", phi.function_variable, "_copy", " = ", to_name(phi.function_variable), ";");
 					temporary_phi_variables.insert(phi.function_variable);
@@ -13755,7 +15166,7 @@ void CompilerGLSL::branch(BlockID from, BlockID to)
 		{
 			if (!current_emitting_switch->need_ladder_break)
 			{
-				force_recompile();
+				force_recompile(RecompileReasonControlFlow);
 				current_emitting_switch->need_ladder_break = true;
 			}
 
@@ -14063,7 +15474,7 @@ bool CompilerGLSL::attempt_emit_loop_header(SPIRBlock &block, SPIRBlock::Method
 
 			default:
 				block.disable_block_optimization = true;
-				force_recompile();
+				force_recompile(RecompileReasonControlFlow);
 				begin_scope(); // We'll see an end_scope() later.
 				return false;
 			}
@@ -14074,7 +15485,7 @@ bool CompilerGLSL::attempt_emit_loop_header(SPIRBlock &block, SPIRBlock::Method
 		else
 		{
 			block.disable_block_optimization = true;
-			force_recompile();
+			force_recompile(RecompileReasonControlFlow);
 			begin_scope(); // We'll see an end_scope() later.
 			return false;
 		}
@@ -14140,7 +15551,7 @@ bool CompilerGLSL::attempt_emit_loop_header(SPIRBlock &block, SPIRBlock::Method
 
 			default:
 				block.disable_block_optimization = true;
-				force_recompile();
+				force_recompile(RecompileReasonControlFlow);
 				begin_scope(); // We'll see an end_scope() later.
 				return false;
 			}
@@ -14152,7 +15563,7 @@ bool CompilerGLSL::attempt_emit_loop_header(SPIRBlock &block, SPIRBlock::Method
 		else
 		{
 			block.disable_block_optimization = true;
-			force_recompile();
+			force_recompile(RecompileReasonControlFlow);
 			begin_scope(); // We'll see an end_scope() later.
 			return false;
 		}
@@ -14324,7 +15735,7 @@ void CompilerGLSL::emit_block_chain(SPIRBlock &block)
 	// as writes to said loop variables might have been masked out, we need a recompile.
 	if (!emitted_loop_header_variables && !block.loop_variables.empty())
 	{
-		force_recompile();
+		force_recompile(RecompileReasonControlFlow);
 		for (auto var : block.loop_variables)
 			get<SPIRVariable>(var).loop_variable = false;
 		block.loop_variables.clear();
@@ -14795,7 +16206,7 @@ void CompilerGLSL::emit_block_chain(SPIRBlock &block)
 			{
 				// The DoWhile block has side effects, force ComplexLoop pattern next pass.
 				get<SPIRBlock>(block.continue_block).complex_continue = true;
-				force_recompile();
+				force_recompile(RecompileReasonControlFlow);
 			}
 
 			// Might have to invert the do-while test here.
@@ -15229,7 +16640,7 @@ void CompilerGLSL::propagate_nonuniform_qualifier(uint32_t id)
 	if (!has_decoration(id, DecorationNonUniformEXT))
 	{
 		set_decoration(id, DecorationNonUniformEXT);
-		force_recompile();
+		force_recompile(RecompileReasonDecoration);
 	}
 
 	auto *e = maybe_get<SPIRExpression>(id);
@@ -15614,7 +17025,7 @@ void CompilerGLSL::request_workaround_wrapper_overload(TypeID id)
 	if (find(begin(workaround_ubo_load_overload_types), end(workaround_ubo_load_overload_types), id) ==
 	    end(workaround_ubo_load_overload_types))
 	{
-		force_recompile();
+		force_recompile(RecompileReasonHelperFunction);
 		workaround_ubo_load_overload_types.push_back(id);
 	}
 }
@@ -15666,3 +17077,117 @@ void CompilerGLSL::rewrite_load_for_wrapped_row_major(std::string &expr, TypeID
 		expr = join("spvWorkaroundRowMajor(", expr, ")");
 	}
 }
+
+void CompilerGLSL::reset_module_state()
+{
+	current_emitting_block = nullptr;
+	current_emitting_switch = nullptr;
+	current_emitting_switch_fallthrough = false;
+	buffer.clear();
+	redirect_statement = nullptr;
+	current_continue_block = nullptr;
+
+	local_variable_names.clear();
+	resource_names.clear();
+	block_input_names.clear();
+	block_output_names.clear();
+	block_ubo_names.clear();
+	block_ssbo_names.clear();
+	block_names.clear();
+	function_overloads.clear();
+	preserved_aliases.clear();
+	processing_entry_point = false;
+
+	indent = 0;
+	emitted_functions.clear();
+	flushed_phi_variables.clear();
+	flattened_buffer_blocks.clear();
+	flattened_structs.clear();
+	shader_subgroup_supporter = ShaderSubgroupSupportHelper();
+	expression_usage_counts.clear();
+	forced_extensions.clear();
+	header_lines.clear();
+	extra_sub_expressions.clear();
+	workaround_ubo_load_overload_types.clear();
+	statement_count = 0;
+	requires_transpose_2x2 = false;
+	requires_transpose_3x3 = false;
+	requires_transpose_4x4 = false;
+	ray_tracing_is_khr = false;
+
+	pls_inputs.clear();
+	pls_outputs.clear();
+	subpass_to_framebuffer_fetch_attachment.clear();
+	inout_color_attachments.clear();
+	common_subexpression_aliases.clear();
+	common_subexpression_temporaries.clear();
+	inferred_relaxed_precision_ids.clear();
+
+	Compiler::reset_module_state();
+}
+
+void CompilerGLSL::hash_compile_state(Hasher &hasher) const
+{
+	Compiler::hash_compile_state(hasher);
+	hasher.string("glsl");
+
+	hasher.u32(options.version);
+	hasher.u32(options.es);
+	hasher.u32(options.force_temporary);
+	hasher.u32(options.vulkan_semantics);
+	hasher.u32(options.separate_shader_objects);
+	hasher.u32(options.flatten_multidimensional_arrays);
+	hasher.u32(options.enable_420pack_extension);
+	hasher.u32(options.emit_push_constant_as_uniform_buffer);
+	hasher.u32(options.emit_uniform_buffer_as_plain_uniforms);
+	hasher.u32(options.emit_line_directives);
+	hasher.u32(options.enable_storage_image_qualifier_deduction);
+	hasher.u32(options.force_zero_initialized_variables);
+	hasher.u32(options.force_flattened_io_blocks);
+	hasher.u32(options.predict_temporaries);
+	hasher.u32(options.compact_output);
+	hasher.u32(options.eliminate_common_subexpressions);
+	hasher.u32(options.infer_relaxed_precision);
+	hasher.u32(options.vertex.fixup_clipspace);
+	hasher.u32(options.vertex.flip_vert_y);
+	hasher.u32(options.vertex.support_nonzero_base_instance);
+	hasher.u32(options.fragment.default_float_precision);
+	hasher.u32(options.fragment.default_int_precision);
+
+	hasher.u32(uint32_t(header_lines.size()));
+	for (auto &line : header_lines)
+		hasher.string(line);
+	hasher.u32(uint32_t(forced_extensions.size()));
+	for (auto &ext : forced_extensions)
+		hasher.string(ext);
+
+	hasher.u32(uint32_t(pls_inputs.size()));
+	for (auto &pls : pls_inputs)
+	{
+		hasher.u32(pls.id);
+		hasher.u32(pls.format);
+	}
+	hasher.u32(uint32_t(pls_outputs.size()));
+	for (auto &pls : pls_outputs)
+	{
+		hasher.u32(pls.id);
+		hasher.u32(pls.format);
+	}
+
+	// inout_color_attachments is derived from this list.
+	hasher.u32(uint32_t(subpass_to_framebuffer_fetch_attachment.size()));
+	for (auto &remap : subpass_to_framebuffer_fetch_attachment)
+	{
+		hasher.u32(remap.first);
+		hasher.u32(remap.second);
+	}
+
+	SmallVector<uint32_t> flattened;
+	flattened.reserve(flattened_buffer_blocks.size());
+	for (auto &id : flattened_buffer_blocks)
+		flattened.push_back(id);
+	sort(begin(flattened), end(flattened));
+	hasher.u32(uint32_t(flattened.size()));
+	for (auto &id : flattened)
+		hasher.u32(id);
+}
@@ -132,6 +132,29 @@ public:
 		// what happens on legacy GLSL targets for blocks and structs.
 		bool force_flattened_io_blocks = false;
 
+		// Analyze the module before emitting code to find expressions which must be flushed to temporaries.
+		// Normally this is discovered during emission, which costs an extra compilation pass.
+		// The output is functionally equivalent, but the set of emitted temporaries can differ slightly,
+		// since speculation can flush more expressions to temporaries than strictly required.
+		bool predict_temporaries = false;
+
+		// Emit the output with as little whitespace as possible, and without comments,
+		// to reduce the cost of handing the source to a driver. Identifiers are not changed.
+		// Preprocessor directives are kept on separate lines.
+		bool compact_output = false;
+
+		// Compute identical pure expressions and loads from read-only memory
+		// in a block only once, and reuse the result through a temporary.
+		// Cheap expressions are still recomputed, as a temporary would not save anything.
+		bool eliminate_common_subexpressions = false;
+
+		// In ES and Vulkan GLSL, infer which float values can be declared mediump for modules which carry few
+		// or no RelaxedPrecision decorations, e.g. modules compiled from HLSL. Mediump is what allows mobile GPUs
+		// to use half precision registers and ALUs. Sampled texels and fragment inputs are treated as mediump,
+		// but values feeding into texture coordinates, memory or integer conversions are kept highp.
+		// The chosen values can be queried with get_inferred_relaxed_precision_ids() after compilation.
+		bool infer_relaxed_precision = false;
+
 		enum Precision
 		{
 			DontCare,
@@ -179,6 +202,13 @@ public:
 	// the color attachment at location = color_location. Requires ESSL.
 	void remap_ext_framebuffer_fetch(uint32_t input_attachment_index, uint32_t color_location);
 
+	// If Options::infer_relaxed_precision is used, returns the IDs which were decorated with RelaxedPrecision
+	// by the last compile(), in ascending order.
+	const SmallVector<ID> &get_inferred_relaxed_precision_ids() const
+	{
+		return inferred_relaxed_precision_ids;
+	}
+
 	explicit CompilerGLSL(std::vector<uint32_t> spirv_)
 	    : Compiler(std::move(spirv_))
 	{
@@ -215,6 +245,9 @@ public:
 
 	std::string compile() override;
 
+	MemoryUsage get_memory_usage() const override;
+	void shrink_to_fit() override;
+
 	// Returns the current string held in the conversion buffer. Useful for
 	// capturing what has been converted so far when compile() throws an error.
 	std::string get_partial_source();
@@ -242,6 +275,17 @@ public:
 	// The name of the uniform array will be the same as the interface block name.
 	void flatten_buffer_block(VariableID id);
 
+	// Reorders and packs the members of a uniform buffer block into 16-byte registers to minimize its size,
+	// by reassigning the Offset decorations of the block type.
+	// Only use this for blocks whose layout is owned by the application, which must then fill the buffer to match.
+	// Member indices do not change, so the new layout can be read back with
+	// get_member_decoration(type, index, DecorationOffset) and get_declared_struct_size(), or from reflection.
+	// The packed layout follows std140 rules, so every backend can declare it.
+	// Returns false and leaves the block alone if its type is shared with other kinds of resources,
+	// its members do not follow std140 themselves, or packing would not make it smaller.
+	// This must be called before compile().
+	bool repack_buffer_block(VariableID id);
+
 	// After compilation, query if a variable ID was used as a depth resource.
 	// This is meaningful for MSL since descriptor types depend on this knowledge.
 	// Cases which return true:
@@ -330,6 +374,8 @@ protected:
 	void reset();
 	void emit_function(SPIRFunction &func, const Bitset &return_flags);
 
+	void emit_function_with_callees(SPIRFunction &func, const Bitset &return_flags);
+
 	bool has_extension(const std::string &ext) const;
 	void require_extension_internal(const std::string &ext);
 
@@ -342,6 +388,7 @@ protected:
 
 	virtual void emit_instruction(const Instruction &instr);
 	void emit_block_instructions(SPIRBlock &block);
+	void emit_common_subexpression_alias(const Instruction &instr, uint32_t canonical);
 	virtual void emit_glsl_op(uint32_t result_type, uint32_t result_id, uint32_t op, const uint32_t *args,
 	                          uint32_t count);
 	virtual void emit_spv_amd_shader_ballot_op(uint32_t result_type, uint32_t result_id, uint32_t op,
@@ -425,6 +472,9 @@ protected:
 
 	StringStream<> buffer;
 
+	// Hands the final contents of buffer to output_sink if set, otherwise returns them as a string.
+	std::string finish_output();
+
 	template <typename T>
 	inline void statement_inner(T &&t)
 	{
@@ -458,8 +508,9 @@ protected:
 		}
 		else
 		{
-			for (uint32_t i = 0; i < indent; i++)
-				buffer << "    ";
+			if (!options.compact_output)
+				for (uint32_t i = 0; i < indent; i++)
+					buffer << "    ";
 			statement_inner(std::forward<Ts>(ts)...);
 			buffer << '\n';
 		}
@@ -508,13 +559,13 @@ protected:
 	virtual std::string convert_row_major_matrix(std::string exp_str, const SPIRType &exp_type,
 	                                             uint32_t physical_type_id, bool is_packed);
 
-	std::unordered_set<std::string> local_variable_names;
-	std::unordered_set<std::string> resource_names;
-	std::unordered_set<std::string> block_input_names;
-	std::unordered_set<std::string> block_output_names;
-	std::unordered_set<std::string> block_ubo_names;
-	std::unordered_set<std::string> block_ssbo_names;
-	std::unordered_set<std::string> block_names; // A union of all block_*_names.
+	NameCache local_variable_names;
+	NameCache resource_names;
+	NameCache block_input_names;
+	NameCache block_output_names;
+	NameCache block_ubo_names;
+	NameCache block_ssbo_names;
+	NameCache block_names; // A union of all block_*_names.
 	std::unordered_map<std::string, std::unordered_set<uint64_t>> function_overloads;
 	std::unordered_map<uint32_t, std::string> preserved_aliases;
 	void preserve_alias_on_reset(uint32_t id);
@@ -589,7 +640,7 @@ protected:
 	void emit_flattened_io_block_member(const std::string &basename, const SPIRType &type, const char *qual,
 	                                    const SmallVector<uint32_t> &indices);
 	void emit_block_chain(SPIRBlock &block);
-	void emit_hoisted_temporaries(SmallVector<std::pair<TypeID, ID>> &temporaries);
+	virtual void emit_hoisted_temporaries(SmallVector<std::pair<TypeID, ID>> &temporaries);
 	std::string constant_value_macro_name(uint32_t id);
 	void emit_constant(const SPIRConstant &constant);
 	void emit_specialization_constant_op(const SPIRConstantOp &constant);
@@ -660,6 +711,8 @@ protected:
 	std::string access_chain_internal(uint32_t base, const uint32_t *indices, uint32_t count, AccessChainFlags flags,
 	                                  AccessChainMeta *meta);
 
+	// Finds the subscript selecting the column in expr, the rendered form of the row-major matrix column access chain id.
+	size_t get_column_subscript_offset(uint32_t id, const std::string &expr) const;
 	virtual void prepare_access_chain_for_scalar_access(std::string &expr, const SPIRType &type,
 	                                                    spv::StorageClass storage, bool &is_packed);
 
@@ -843,11 +896,13 @@ protected:
 	const SPIRVariable *find_subpass_input_by_attachment_index(uint32_t index) const;
 	const SPIRVariable *find_color_output_by_location(uint32_t location) const;
 
+	void hash_compile_state(Hasher &hasher) const override;
+	void reset_module_state() override;
+
 	// A variant which takes two sets of name. The secondary is only used to verify there are no collisions,
 	// but the set is not updated when we have found a new name.
 	// Used primarily when adding block interface names.
-	void add_variable(std::unordered_set<std::string> &variables_primary,
-	                  const std::unordered_set<std::string> &variables_secondary, std::string &name);
+	void add_variable(NameCache &variables_primary, const NameCache &variables_secondary, std::string &name);
 
 	void check_function_call_constraints(const uint32_t *args, uint32_t length);
 	void handle_invalid_expression(uint32_t id);
@@ -858,6 +913,17 @@ protected:
 	bool for_loop_initializers_are_same_type(const SPIRBlock &block);
 	bool optimize_read_modify_write(const SPIRType &type, const std::string &lhs, const std::string &rhs);
 	void fixup_image_load_store_access();
+	void analyze_multiply_read_expressions();
+	void analyze_invalidated_loads();
+	void analyze_common_subexpressions();
+	void analyze_relaxed_precision();
+	SmallVector<ID> inferred_relaxed_precision_ids;
+	bool is_read_only_load_source(uint32_t ptr) const;
+	// Maps the result ID of a redundant expression to the ID computing the same value,
+	// or 0 if the result is never read and the instruction does not need to be emitted.
+	std::unordered_map<uint32_t, uint32_t> common_subexpression_aliases;
+	// Canonical expressions which only became forced temporaries because of an alias.
+	std::unordered_set<uint32_t> common_subexpression_temporaries;
 
 	bool type_is_empty(const SPIRType &type);
 
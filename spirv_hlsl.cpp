@@ -1302,6 +1302,8 @@ void CompilerHLSL::declare_undefined_values()
 
 void CompilerHLSL::emit_resources()
 {
+	SPIRV_CROSS_TRACE_SCOPE(trace_callback, TraceEventEmitResources, 0);
+
 	auto &execution = get_entry_point();
 
 	replace_illegal_names();
@@ -2105,9 +2107,8 @@ void CompilerHLSL::emit_buffer_block(const SPIRVariable &var)
 
 			// Prefer the block name if possible.
 			auto buffer_name = to_name(type.self, false);
-			if (ir.meta[type.self].decoration.alias.empty() ||
-			    resource_names.find(buffer_name) != end(resource_names) ||
-			    block_names.find(buffer_name) != end(block_names))
+			if (ir.meta[type.self].decoration.alias.empty() || name_cache_contains(resource_names, buffer_name) ||
+			    name_cache_contains(block_names, buffer_name))
 			{
 				buffer_name = get_block_fallback_name(var.self);
 			}
@@ -2129,7 +2130,7 @@ void CompilerHLSL::emit_buffer_block(const SPIRVariable &var)
 				                       ") cannot be expressed with either HLSL packing layout or packoffset."));
 			}
 
-			block_names.insert(buffer_name);
+			insert_name(block_names, buffer_name);
 
 			// Save for post-reflection later.
 			declared_block_names[var.self] = buffer_name;
@@ -2143,8 +2144,7 @@ void CompilerHLSL::emit_buffer_block(const SPIRVariable &var)
 			statement("cbuffer ", buffer_name, to_resource_binding(var));
 			begin_scope();
 
-			uint32_t i = 0;
-			for (auto &member : type.member_types)
+			for (auto i : get_struct_member_declaration_order(type))
 			{
 				add_member_name(type, i);
 				auto backup_name = get_member_name(type.self, i);
@@ -2152,9 +2152,8 @@ void CompilerHLSL::emit_buffer_block(const SPIRVariable &var)
 				member_name = join(to_name(var.self), "_", member_name);
 				ParsedIR::sanitize_underscores(member_name);
 				set_member_name(type.self, i, member_name);
-				emit_struct_member(type, member, i, "");
+				emit_struct_member(type, type.member_types[i], i, "");
 				set_member_name(type.self, i, backup_name);
-				i++;
 			}
 
 			end_scope_decl();
@@ -2214,7 +2213,8 @@ void CompilerHLSL::emit_push_constant_block(const SPIRVariable &var)
 			auto &memb = ir.meta[type.self].members;
 
 			statement("cbuffer SPIRV_CROSS_RootConstant_", to_name(var.self),
-			          to_resource_register(HLSL_BINDING_AUTO_PUSH_CONSTANT_BIT, 'b', layout.binding, layout.space));
+			          to_resource_register(HLSL_BINDING_AUTO_PUSH_CONSTANT_BIT, 'b', layout.binding, layout.space, 1,
+			                               layout.end - layout.start));
 			begin_scope();
 
 			// Index of the next field in the generated root constant constant buffer
@@ -3206,11 +3206,6 @@ void CompilerHLSL::emit_texture_op(const Instruction &i, bool sparse)
 string CompilerHLSL::to_resource_binding(const SPIRVariable &var)
 {
 	const auto &type = get<SPIRType>(var.basetype);
-
-	// We can remap push constant blocks, even if they don't have any binding decoration.
-	if (type.storage != StorageClassPushConstant && !has_decoration(var.self, DecorationBinding))
-		return "";
-
 	char space = '\0';
 
 	HLSLBindingFlagBits resource_flags = HLSL_BINDING_AUTO_NONE_BIT;
@@ -3289,6 +3284,13 @@ string CompilerHLSL::to_resource_binding(const SPIRVariable &var)
 	if (!space)
 		return "";
 
+	// We can remap push constant blocks, even if they don't have any binding decoration.
+	if (type.storage != StorageClassPushConstant && !has_decoration(var.self, DecorationBinding))
+	{
+		declared_unbound_registers = true;
+		return "";
+	}
+
 	uint32_t desc_set =
 	    resource_flags == HLSL_BINDING_AUTO_PUSH_CONSTANT_BIT ? ResourceBindingPushConstantDescriptorSet : 0u;
 	uint32_t binding = resource_flags == HLSL_BINDING_AUTO_PUSH_CONSTANT_BIT ? ResourceBindingPushConstantBinding : 0u;
@@ -3298,7 +3300,12 @@ string CompilerHLSL::to_resource_binding(const SPIRVariable &var)
 	if (has_decoration(var.self, DecorationDescriptorSet))
 		desc_set = get_decoration(var.self, DecorationDescriptorSet);
 
-	return to_resource_register(resource_flags, space, binding, desc_set);
+	uint32_t root_constant_size = 0;
+	if (resource_flags == HLSL_BINDING_AUTO_PUSH_CONSTANT_BIT)
+		root_constant_size = uint32_t(get_declared_struct_size(type));
+
+	return to_resource_register(resource_flags, space, binding, desc_set, to_resource_register_count(type),
+	                            root_constant_size);
 }
 
 string CompilerHLSL::to_resource_binding_sampler(const SPIRVariable &var)
@@ -3308,7 +3315,21 @@ string CompilerHLSL::to_resource_binding_sampler(const SPIRVariable &var)
 		return "";
 
 	return to_resource_register(HLSL_BINDING_AUTO_SAMPLER_BIT, 's', get_decoration(var.self, DecorationBinding),
-	                            get_decoration(var.self, DecorationDescriptorSet));
+	                            get_decoration(var.self, DecorationDescriptorSet),
+	                            to_resource_register_count(get<SPIRType>(var.basetype)));
+}
+
+uint32_t CompilerHLSL::to_resource_register_count(const SPIRType &type) const
+{
+	uint32_t count = 1;
+	for (uint32_t i = 0; i < uint32_t(type.array.size()); i++)
+	{
+		uint32_t size = to_array_size_literal(type, i);
+		if (size == 0)
+			return HLSLDescriptorRangeUnbounded;
+		count *= size;
+	}
+	return count;
 }
 
 void CompilerHLSL::remap_hlsl_resource_binding(HLSLBindingFlagBits type, uint32_t &desc_set, uint32_t &binding)
@@ -3348,7 +3369,8 @@ void CompilerHLSL::remap_hlsl_resource_binding(HLSLBindingFlagBits type, uint32_
 	}
 }
 
-string CompilerHLSL::to_resource_register(HLSLBindingFlagBits flag, char space, uint32_t binding, uint32_t space_set)
+string CompilerHLSL::to_resource_register(HLSLBindingFlagBits flag, char space, uint32_t binding, uint32_t space_set,
+                                          uint32_t count, uint32_t root_constant_size)
 {
 	if ((flag & resource_binding_flags) == 0)
 	{
@@ -3357,7 +3379,13 @@ string CompilerHLSL::to_resource_register(HLSLBindingFlagBits flag, char space,
 		// The push constant block did not have a binding, and there were no remap for it,
 		// so, declare without register binding.
 		if (flag == HLSL_BINDING_AUTO_PUSH_CONSTANT_BIT && space_set == ResourceBindingPushConstantDescriptorSet)
+		{
+			declared_unbound_registers = true;
 			return "";
+		}
+
+		uint32_t register_space = hlsl_options.shader_model >= 51 ? space_set : 0;
+		declared_registers.push_back({ space, binding, register_space, count, root_constant_size });
 
 		if (hlsl_options.shader_model >= 51)
 			return join(" : register(", space, binding, ", space", space_set, ")");
@@ -3365,7 +3393,10 @@ string CompilerHLSL::to_resource_register(HLSLBindingFlagBits flag, char space,
 			return join(" : register(", space, binding, ")");
 	}
 	else
+	{
+		declared_unbound_registers = true;
 		return "";
+	}
 }
 
 void CompilerHLSL::emit_modern_uniform(const SPIRVariable &var)
@@ -3470,7 +3501,7 @@ string CompilerHLSL::bitcast_glsl_op(const SPIRType &out_type, const SPIRType &i
 		if (!requires_explicit_fp16_packing)
 		{
 			requires_explicit_fp16_packing = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		return "spvUnpackFloat2x16";
 	}
@@ -3479,7 +3510,7 @@ string CompilerHLSL::bitcast_glsl_op(const SPIRType &out_type, const SPIRType &i
 		if (!requires_explicit_fp16_packing)
 		{
 			requires_explicit_fp16_packing = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		return "spvPackFloat2x16";
 	}
@@ -3544,7 +3575,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 		if (!requires_fp16_packing)
 		{
 			requires_fp16_packing = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		emit_unary_func_op(result_type, id, args[0], "spvPackHalf2x16");
 		break;
@@ -3553,7 +3584,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 		if (!requires_fp16_packing)
 		{
 			requires_fp16_packing = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		emit_unary_func_op(result_type, id, args[0], "spvUnpackHalf2x16");
 		break;
@@ -3562,7 +3593,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 		if (!requires_snorm8_packing)
 		{
 			requires_snorm8_packing = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		emit_unary_func_op(result_type, id, args[0], "spvPackSnorm4x8");
 		break;
@@ -3571,7 +3602,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 		if (!requires_snorm8_packing)
 		{
 			requires_snorm8_packing = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		emit_unary_func_op(result_type, id, args[0], "spvUnpackSnorm4x8");
 		break;
@@ -3580,7 +3611,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 		if (!requires_unorm8_packing)
 		{
 			requires_unorm8_packing = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		emit_unary_func_op(result_type, id, args[0], "spvPackUnorm4x8");
 		break;
@@ -3589,7 +3620,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 		if (!requires_unorm8_packing)
 		{
 			requires_unorm8_packing = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		emit_unary_func_op(result_type, id, args[0], "spvUnpackUnorm4x8");
 		break;
@@ -3598,7 +3629,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 		if (!requires_snorm16_packing)
 		{
 			requires_snorm16_packing = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		emit_unary_func_op(result_type, id, args[0], "spvPackSnorm2x16");
 		break;
@@ -3607,7 +3638,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 		if (!requires_snorm16_packing)
 		{
 			requires_snorm16_packing = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		emit_unary_func_op(result_type, id, args[0], "spvUnpackSnorm2x16");
 		break;
@@ -3616,7 +3647,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 		if (!requires_unorm16_packing)
 		{
 			requires_unorm16_packing = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		emit_unary_func_op(result_type, id, args[0], "spvPackUnorm2x16");
 		break;
@@ -3625,7 +3656,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 		if (!requires_unorm16_packing)
 		{
 			requires_unorm16_packing = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		emit_unary_func_op(result_type, id, args[0], "spvUnpackUnorm2x16");
 		break;
@@ -3657,7 +3688,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 			if (!requires_inverse_2x2)
 			{
 				requires_inverse_2x2 = true;
-				force_recompile();
+				force_recompile(RecompileReasonHelperFunction);
 			}
 		}
 		else if (type.vecsize == 3 && type.columns == 3)
@@ -3665,7 +3696,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 			if (!requires_inverse_3x3)
 			{
 				requires_inverse_3x3 = true;
-				force_recompile();
+				force_recompile(RecompileReasonHelperFunction);
 			}
 		}
 		else if (type.vecsize == 4 && type.columns == 4)
@@ -3673,7 +3704,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 			if (!requires_inverse_4x4)
 			{
 				requires_inverse_4x4 = true;
-				force_recompile();
+				force_recompile(RecompileReasonHelperFunction);
 			}
 		}
 		emit_unary_func_op(result_type, id, args[0], "spvInverse");
@@ -3697,7 +3728,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 			if (!requires_scalar_reflect)
 			{
 				requires_scalar_reflect = true;
-				force_recompile();
+				force_recompile(RecompileReasonHelperFunction);
 			}
 			emit_binary_func_op(result_type, id, args[0], args[1], "spvReflect");
 		}
@@ -3711,7 +3742,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 			if (!requires_scalar_refract)
 			{
 				requires_scalar_refract = true;
-				force_recompile();
+				force_recompile(RecompileReasonHelperFunction);
 			}
 			emit_trinary_func_op(result_type, id, args[0], args[1], args[2], "spvRefract");
 		}
@@ -3725,7 +3756,7 @@ void CompilerHLSL::emit_glsl_op(uint32_t result_type, uint32_t id, uint32_t eop,
 			if (!requires_scalar_faceforward)
 			{
 				requires_scalar_faceforward = true;
-				force_recompile();
+				force_recompile(RecompileReasonHelperFunction);
 			}
 			emit_trinary_func_op(result_type, id, args[0], args[1], args[2], "spvFaceForward");
 		}
@@ -4760,7 +4791,7 @@ void CompilerHLSL::emit_instruction(const Instruction &instruction)
 			if (!requires_uint2_packing)
 			{
 				requires_uint2_packing = true;
-				force_recompile();
+				force_recompile(RecompileReasonHelperFunction);
 			}
 
 			if (bitcast_type == CompilerHLSL::TypePackUint2x32)
@@ -4835,7 +4866,7 @@ void CompilerHLSL::emit_instruction(const Instruction &instruction)
 		if (!requires_op_fmod)
 		{
 			requires_op_fmod = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 		CompilerGLSL::emit_instruction(instruction);
 		break;
@@ -5449,7 +5480,7 @@ void CompilerHLSL::emit_instruction(const Instruction &instruction)
 		if (!requires_bitfield_insert)
 		{
 			requires_bitfield_insert = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 
 		auto expr = join("spvBitfieldInsert(", to_expression(ops[2]), ", ", to_expression(ops[3]), ", ",
@@ -5470,7 +5501,7 @@ void CompilerHLSL::emit_instruction(const Instruction &instruction)
 		if (!requires_bitfield_extract)
 		{
 			requires_bitfield_extract = true;
-			force_recompile();
+			force_recompile(RecompileReasonHelperFunction);
 		}
 
 		if (opcode == OpBitFieldSExtract)
@@ -5591,7 +5622,7 @@ void CompilerHLSL::require_texture_query_variant(uint32_t var_id)
 	uint64_t mask = 1ull << bit;
 	if ((variant & mask) == 0)
 	{
-		force_recompile();
+		force_recompile(RecompileReasonHelperFunction);
 		variant |= mask;
 	}
 }
@@ -5690,6 +5721,8 @@ void CompilerHLSL::validate_shader_model()
 
 string CompilerHLSL::compile()
 {
+	CompileBudgetScope budget_scope(*this);
+	begin_phase_timings();
 	ir.fixup_reserved_names();
 
 	// Do not deal with ES-isms like precision, older extensions and such.
@@ -5723,24 +5756,30 @@ string CompilerHLSL::compile()
 	reorder_type_alias();
 	build_function_control_flow_graphs_and_analyze();
 	validate_shader_model();
-	update_active_builtins();
-	analyze_image_and_sampler_usage();
-	analyze_interlocked_resource_usage();
+	analyze_active_usage();
+	if (options.predict_temporaries)
+		analyze_multiply_read_expressions();
+	analyze_common_subexpressions();
 
 	// Subpass input needs SV_Position.
 	if (need_subpass_input)
 		active_input_builtins.set(BuiltInFragCoord);
 
-	uint32_t pass_count = 0;
+	begin_emission_timings();
+	compile_pass_count = 0;
 	do
 	{
-		if (pass_count >= 3)
+		if (compile_pass_count >= 3)
 			SPIRV_CROSS_THROW("Over 3 compilation loops detected. Must be a bug!");
 
+		SPIRV_CROSS_TRACE_SCOPE(trace_callback, TraceEventCompilePass, compile_pass_count);
+
 		reset();
 
 		// Move constructor for this type is broken on GCC 4.9 ...
-		buffer.reset();
+		buffer.clear();
+		declared_registers.clear();
+		declared_unbound_registers = false;
 
 		emit_header();
 		emit_resources();
@@ -5748,13 +5787,14 @@ string CompilerHLSL::compile()
 		emit_function(get<SPIRFunction>(ir.default_entry_point), Bitset());
 		emit_hlsl_entry_point();
 
-		pass_count++;
+		compile_pass_count++;
+		end_pass_timing();
 	} while (is_forcing_recompilation());
 
 	// Entry point in HLSL is always main() for the time being.
 	get_entry_point().name = "main";
 
-	return buffer.str();
+	return finish_output();
 }
 
 void CompilerHLSL::emit_block_hints(const SPIRBlock &block)
@@ -5789,6 +5829,13 @@ void CompilerHLSL::add_hlsl_resource_binding(const HLSLResourceBinding &binding)
 	resource_bindings[tuple] = { binding, false };
 }
 
+void CompilerHLSL::add_hlsl_resource_bindings(const HLSLResourceBinding *bindings, size_t count)
+{
+	resource_bindings.reserve(resource_bindings.size() + count);
+	for (size_t i = 0; i < count; i++)
+		add_hlsl_resource_binding(bindings[i]);
+}
+
 bool CompilerHLSL::is_hlsl_resource_binding_used(ExecutionModel model, uint32_t desc_set, uint32_t binding) const
 {
 	StageSetBinding tuple = { model, desc_set, binding };
@@ -5830,7 +5877,391 @@ void CompilerHLSL::set_hlsl_force_storage_buffer_as_uav(uint32_t desc_set, uint3
 	force_uav_buffer_bindings.insert(pair);
 }
 
+static HLSLShaderVisibility execution_model_to_shader_visibility(ExecutionModel model)
+{
+	switch (model)
+	{
+	case ExecutionModelVertex:
+		return HLSL_SHADER_VISIBILITY_VERTEX;
+	case ExecutionModelTessellationControl:
+		return HLSL_SHADER_VISIBILITY_HULL;
+	case ExecutionModelTessellationEvaluation:
+		return HLSL_SHADER_VISIBILITY_DOMAIN;
+	case ExecutionModelGeometry:
+		return HLSL_SHADER_VISIBILITY_GEOMETRY;
+	case ExecutionModelFragment:
+		return HLSL_SHADER_VISIBILITY_PIXEL;
+	default:
+		return HLSL_SHADER_VISIBILITY_ALL;
+	}
+}
+
+static HLSLDescriptorRangeType register_space_to_descriptor_range_type(char space)
+{
+	switch (space)
+	{
+	case 'b':
+		return HLSL_DESCRIPTOR_RANGE_CBV;
+	case 'u':
+		return HLSL_DESCRIPTOR_RANGE_UAV;
+	case 's':
+		return HLSL_DESCRIPTOR_RANGE_SAMPLER;
+	default:
+		return HLSL_DESCRIPTOR_RANGE_SRV;
+	}
+}
+
+HLSLRootSignature CompilerHLSL::get_root_signature() const
+{
+	const CompilerHLSL *compiler = this;
+	return build_root_signature(&compiler, 1);
+}
+
+HLSLRootSignature CompilerHLSL::build_root_signature(const CompilerHLSL *const *compilers, size_t count)
+{
+	struct Register
+	{
+		HLSLDescriptorRangeType type;
+		uint32_t space;
+		uint32_t binding;
+		uint32_t count;
+		uint32_t root_constant_size;
+		uint32_t visibility_mask;
+	};
+
+	SmallVector<Register> registers;
+	uint32_t visibility_mask = 0;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		auto &compiler = *compilers[i];
+		if (compiler.declared_unbound_registers)
+			SPIRV_CROSS_THROW("All resources must be declared with an explicit register to build a root signature.");
+
+		uint32_t stage_bit = 1u << execution_model_to_shader_visibility(compiler.get_execution_model());
+		visibility_mask |= stage_bit;
+
+		for (auto &reg : compiler.declared_registers)
+		{
+			auto type = register_space_to_descriptor_range_type(reg.space);
+			auto itr = find_if(begin(registers), end(registers), [&](const Register &r) {
+				return r.type == type && r.space == reg.register_space && r.binding == reg.binding;
+			});
+
+			if (itr != end(registers))
+			{
+				// Different stages may declare different array sizes for the same register.
+				itr->count = max(itr->count, reg.count);
+				itr->root_constant_size = max(itr->root_constant_size, reg.root_constant_size);
+				itr->visibility_mask |= stage_bit;
+			}
+			else
+			{
+				registers.push_back(
+				    { type, reg.register_space, reg.binding, reg.count, reg.root_constant_size, stage_bit });
+			}
+		}
+	}
+
+	sort(begin(registers), end(registers), [](const Register &a, const Register &b) {
+		if (a.type != b.type)
+			return a.type < b.type;
+		if (a.space != b.space)
+			return a.space < b.space;
+		return a.binding < b.binding;
+	});
+
+	const auto mask_to_visibility = [](uint32_t mask) -> HLSLShaderVisibility {
+		// Compute shaders can only use SHADER_VISIBILITY_ALL.
+		for (uint32_t i = HLSL_SHADER_VISIBILITY_VERTEX; i <= HLSL_SHADER_VISIBILITY_PIXEL; i++)
+			if (mask == (1u << i))
+				return HLSLShaderVisibility(i);
+		return HLSL_SHADER_VISIBILITY_ALL;
+	};
+
+	HLSLRootSignature root_signature;
+
+	// D3D12 root signatures are limited to 64 DWORDs. Descriptor tables cost one DWORD each,
+	// so reserve space for the tables we might need before handing out root constants.
+	const uint32_t max_root_signature_dwords = 64;
+	uint32_t reserved_dwords = 1;
+	for (auto &reg : registers)
+		if (reg.type == HLSL_DESCRIPTOR_RANGE_SAMPLER || reg.count == HLSLDescriptorRangeUnbounded)
+			reserved_dwords++;
+
+	uint32_t used_dwords = 0;
+	for (auto &reg : registers)
+	{
+		if (reg.root_constant_size == 0)
+			continue;
+
+		uint32_t num_32bit_values = (reg.root_constant_size + 3) / 4;
+		if (used_dwords + num_32bit_values + reserved_dwords > max_root_signature_dwords)
+			continue;
+
+		HLSLRootParameter param;
+		param.type = HLSL_ROOT_PARAMETER_32BIT_CONSTANTS;
+		param.visibility = mask_to_visibility(reg.visibility_mask);
+		param.shader_register = reg.binding;
+		param.register_space = reg.space;
+		param.num_32bit_values = num_32bit_values;
+		root_signature.parameters.push_back(move(param));
+
+		used_dwords += num_32bit_values;
+		reg.count = 0;
+	}
+
+	// Samplers cannot share a descriptor table with other descriptors.
+	// Unbounded ranges must come last in a table, so only one of them can join the shared table.
+	HLSLRootParameter view_table, sampler_table;
+	SmallVector<HLSLRootParameter> unbounded_tables;
+	view_table.visibility = mask_to_visibility(visibility_mask);
+	sampler_table.visibility = mask_to_visibility(visibility_mask);
+
+	for (auto &reg : registers)
+	{
+		if (reg.count == 0)
+			continue;
+
+		auto &table = reg.type == HLSL_DESCRIPTOR_RANGE_SAMPLER ? sampler_table : view_table;
+		auto &ranges = table.ranges;
+
+		if (!ranges.empty() && ranges.back().type == reg.type && ranges.back().register_space == reg.space)
+		{
+			auto &range = ranges.back();
+			if (range.count == HLSLDescriptorRangeUnbounded)
+				continue;
+
+			// Merge contiguous and overlapping registers into one range.
+			if (reg.binding <= range.base_register + range.count)
+			{
+				if (reg.count == HLSLDescriptorRangeUnbounded)
+					range.count = HLSLDescriptorRangeUnbounded;
+				else
+					range.count = max(range.count, reg.binding + reg.count - range.base_register);
+				continue;
+			}
+		}
+
+		HLSLDescriptorRange range;
+		range.type = reg.type;
+		range.base_register = reg.binding;
+		range.register_space = reg.space;
+		range.count = reg.count;
+		ranges.push_back(range);
+	}
+
+	for (auto *table : { &view_table, &sampler_table })
+	{
+		auto &ranges = table->ranges;
+		auto unbounded_itr = stable_partition(begin(ranges), end(ranges), [](const HLSLDescriptorRange &range) {
+			return range.count != HLSLDescriptorRangeUnbounded;
+		});
+
+		// Keep one unbounded range at the end of the table, and move the rest to tables of their own.
+		if (unbounded_itr != end(ranges))
+			++unbounded_itr;
+
+		for (auto itr = unbounded_itr; itr != end(ranges); ++itr)
+		{
+			HLSLRootParameter unbounded_table;
+			unbounded_table.visibility = table->visibility;
+			unbounded_table.ranges.push_back(*itr);
+			unbounded_tables.push_back(move(unbounded_table));
+		}
+		ranges.erase(unbounded_itr, end(ranges));
+
+		if (!ranges.empty())
+			root_signature.parameters.push_back(move(*table));
+	}
+
+	for (auto &table : unbounded_tables)
+		root_signature.parameters.push_back(move(table));
+
+	if ((visibility_mask & (1u << HLSL_SHADER_VISIBILITY_VERTEX)) != 0)
+	{
+		// Graphics pipeline, don't let the driver set up root access for stages which are not present.
+		root_signature.flags |= HLSL_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+		if ((visibility_mask & (1u << HLSL_SHADER_VISIBILITY_HULL)) == 0)
+			root_signature.flags |= HLSL_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS;
+		if ((visibility_mask & (1u << HLSL_SHADER_VISIBILITY_DOMAIN)) == 0)
+			root_signature.flags |= HLSL_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS;
+		if ((visibility_mask & (1u << HLSL_SHADER_VISIBILITY_GEOMETRY)) == 0)
+			root_signature.flags |= HLSL_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS;
+		if ((visibility_mask & (1u << HLSL_SHADER_VISIBILITY_PIXEL)) == 0)
+			root_signature.flags |= HLSL_ROOT_SIGNATURE_FLAG_DENY_PIXEL_SHADER_ROOT_ACCESS;
+	}
+
+	return root_signature;
+}
+
+string CompilerHLSL::root_signature_to_string(const HLSLRootSignature &root_signature)
+{
+	static const char *const flag_names[] = {
+		"ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT", "DENY_VERTEX_SHADER_ROOT_ACCESS", "DENY_HULL_SHADER_ROOT_ACCESS",
+		"DENY_DOMAIN_SHADER_ROOT_ACCESS", "DENY_GEOMETRY_SHADER_ROOT_ACCESS", "DENY_PIXEL_SHADER_ROOT_ACCESS",
+	};
+	static const char *const visibility_names[] = {
+		"SHADER_VISIBILITY_ALL",      "SHADER_VISIBILITY_VERTEX",   "SHADER_VISIBILITY_HULL",
+		"SHADER_VISIBILITY_DOMAIN",   "SHADER_VISIBILITY_GEOMETRY", "SHADER_VISIBILITY_PIXEL",
+	};
+	static const char *const range_names[] = { "SRV", "UAV", "CBV", "Sampler" };
+	static const char range_spaces[] = { 't', 'u', 'b', 's' };
+
+	string flags;
+	for (uint32_t i = 0; i < uint32_t(sizeof(flag_names) / sizeof(flag_names[0])); i++)
+	{
+		if ((root_signature.flags & (1u << i)) != 0)
+		{
+			if (!flags.empty())
+				flags += " | ";
+			flags += flag_names[i];
+		}
+	}
+
+	string result = join("RootFlags(", flags.empty() ? "0" : flags, ")");
+
+	const auto space_and_visibility = [&](uint32_t space, HLSLShaderVisibility visibility) -> string {
+		string str;
+		if (space != 0)
+			str += join(", space=", space);
+		if (visibility != HLSL_SHADER_VISIBILITY_ALL)
+			str += join(", visibility=", visibility_names[visibility]);
+		return str;
+	};
+
+	for (auto &param : root_signature.parameters)
+	{
+		result += ", ";
+		if (param.type == HLSL_ROOT_PARAMETER_32BIT_CONSTANTS)
+		{
+			result += join("RootConstants(num32BitConstants=", param.num_32bit_values, ", b", param.shader_register,
+			               space_and_visibility(param.register_space, param.visibility), ")");
+		}
+		else
+		{
+			result += "DescriptorTable(";
+			for (auto &range : param.ranges)
+			{
+				if (&range != &param.ranges.front())
+					result += ", ";
+				result += join(range_names[range.type], "(", range_spaces[range.type], range.base_register);
+				if (range.count == HLSLDescriptorRangeUnbounded)
+					result += ", numDescriptors=unbounded";
+				else if (range.count != 1)
+					result += join(", numDescriptors=", range.count);
+				result += space_and_visibility(range.register_space, HLSL_SHADER_VISIBILITY_ALL) + ")";
+			}
+			if (param.visibility != HLSL_SHADER_VISIBILITY_ALL)
+				result += join(", visibility=", visibility_names[param.visibility]);
+			result += ")";
+		}
+	}
+
+	return result;
+}
+
 bool CompilerHLSL::builtin_translates_to_nonarray(spv::BuiltIn builtin) const
 {
 	return (builtin == BuiltInSampleMask);
 }
+
+void CompilerHLSL::reset_module_state()
+{
+	declared_registers.clear();
+	declared_unbound_registers = false;
+	requires_op_fmod = false;
+	requires_fp16_packing = false;
+	requires_uint2_packing = false;
+	requires_explicit_fp16_packing = false;
+	requires_unorm8_packing = false;
+	requires_snorm8_packing = false;
+	requires_unorm16_packing = false;
+	requires_snorm16_packing = false;
+	requires_bitfield_insert = false;
+	requires_bitfield_extract = false;
+	requires_inverse_2x2 = false;
+	requires_inverse_3x3 = false;
+	requires_inverse_4x4 = false;
+	requires_scalar_reflect = false;
+	requires_scalar_refract = false;
+	requires_scalar_faceforward = false;
+	required_texture_size_variants = TextureSizeVariants();
+
+	require_output = false;
+	require_input = false;
+	remap_vertex_attributes.clear();
+	num_workgroups_builtin = 0;
+	root_constants_layout.clear();
+	unique_identifier_count = 0;
+	resource_bindings.clear();
+	force_uav_buffer_bindings.clear();
+
+	// Binding flags are a backend preference, like the options, so they are kept.
+	CompilerGLSL::reset_module_state();
+}
+
+void CompilerHLSL::hash_compile_state(Hasher &hasher) const
+{
+	CompilerGLSL::hash_compile_state(hasher);
+	hasher.string("hlsl");
+
+	hasher.u32(hlsl_options.shader_model);
+	hasher.u32(hlsl_options.point_size_compat);
+	hasher.u32(hlsl_options.point_coord_compat);
+	hasher.u32(hlsl_options.support_nonzero_base_vertex_base_instance);
+	hasher.u32(hlsl_options.force_storage_buffer_as_uav);
+	hasher.u32(hlsl_options.nonwritable_uav_texture_as_srv);
+	hasher.u32(hlsl_options.enable_16bit_types);
+	hasher.u32(hlsl_options.flatten_matrix_vertex_input_semantics);
+
+	hasher.u32(uint32_t(remap_vertex_attributes.size()));
+	for (auto &remap : remap_vertex_attributes)
+	{
+		hasher.u32(remap.location);
+		hasher.string(remap.semantic);
+	}
+
+	hasher.u32(num_workgroups_builtin);
+	hasher.u32(resource_binding_flags);
+
+	hasher.u32(uint32_t(root_constants_layout.size()));
+	for (auto &root : root_constants_layout)
+	{
+		hasher.u32(root.start);
+		hasher.u32(root.end);
+		hasher.u32(root.binding);
+		hasher.u32(root.space);
+	}
+
+	// Unordered containers are hashed by summing up per-entry hashes so iteration order does not matter.
+	// The second member of the pair is only written during compilation, so it is ignored.
+	uint64_t sum = 0;
+	for (auto &binding : resource_bindings)
+	{
+		auto &res = binding.second.first;
+		Hasher h;
+		h.u32(res.stage);
+		h.u32(res.desc_set);
+		h.u32(res.binding);
+		for (auto *b : { &res.cbv, &res.uav, &res.srv, &res.sampler })
+		{
+			h.u32(b->register_space);
+			h.u32(b->register_binding);
+		}
+		sum += h.get();
+	}
+	hasher.u32(uint32_t(resource_bindings.size()));
+	hasher.u64(sum);
+
+	sum = 0;
+	for (auto &pair : force_uav_buffer_bindings)
+	{
+		Hasher h;
+		h.u32(pair.desc_set);
+		h.u32(pair.binding);
+		sum += h.get();
+	}
+	hasher.u32(uint32_t(force_uav_buffer_bindings.size()));
+	hasher.u64(sum);
+}
@@ -98,6 +98,75 @@ struct HLSLResourceBinding
 	} cbv, uav, srv, sampler;
 };
 
+// A D3D12 root signature covering the registers declared by one or more compiled shaders.
+// Enum values match their D3D12 counterparts, so they can be cast directly.
+enum HLSLDescriptorRangeType
+{
+	HLSL_DESCRIPTOR_RANGE_SRV = 0,
+	HLSL_DESCRIPTOR_RANGE_UAV = 1,
+	HLSL_DESCRIPTOR_RANGE_CBV = 2,
+	HLSL_DESCRIPTOR_RANGE_SAMPLER = 3
+};
+
+enum HLSLRootParameterType
+{
+	HLSL_ROOT_PARAMETER_DESCRIPTOR_TABLE = 0,
+	HLSL_ROOT_PARAMETER_32BIT_CONSTANTS = 1
+};
+
+enum HLSLShaderVisibility
+{
+	HLSL_SHADER_VISIBILITY_ALL = 0,
+	HLSL_SHADER_VISIBILITY_VERTEX = 1,
+	HLSL_SHADER_VISIBILITY_HULL = 2,
+	HLSL_SHADER_VISIBILITY_DOMAIN = 3,
+	HLSL_SHADER_VISIBILITY_GEOMETRY = 4,
+	HLSL_SHADER_VISIBILITY_PIXEL = 5
+};
+
+enum HLSLRootSignatureFlagBits
+{
+	HLSL_ROOT_SIGNATURE_FLAG_NONE = 0,
+	HLSL_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT = 1 << 0,
+	HLSL_ROOT_SIGNATURE_FLAG_DENY_VERTEX_SHADER_ROOT_ACCESS = 1 << 1,
+	HLSL_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS = 1 << 2,
+	HLSL_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS = 1 << 3,
+	HLSL_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS = 1 << 4,
+	HLSL_ROOT_SIGNATURE_FLAG_DENY_PIXEL_SHADER_ROOT_ACCESS = 1 << 5
+};
+using HLSLRootSignatureFlags = uint32_t;
+
+// Used as descriptor count for runtime sized arrays.
+static const uint32_t HLSLDescriptorRangeUnbounded = ~0u;
+
+struct HLSLDescriptorRange
+{
+	HLSLDescriptorRangeType type = HLSL_DESCRIPTOR_RANGE_SRV;
+	uint32_t base_register = 0;
+	uint32_t register_space = 0;
+	uint32_t count = 1;
+};
+
+struct HLSLRootParameter
+{
+	HLSLRootParameterType type = HLSL_ROOT_PARAMETER_DESCRIPTOR_TABLE;
+	HLSLShaderVisibility visibility = HLSL_SHADER_VISIBILITY_ALL;
+
+	// For HLSL_ROOT_PARAMETER_DESCRIPTOR_TABLE.
+	SmallVector<HLSLDescriptorRange> ranges;
+
+	// For HLSL_ROOT_PARAMETER_32BIT_CONSTANTS.
+	uint32_t shader_register = 0;
+	uint32_t register_space = 0;
+	uint32_t num_32bit_values = 0;
+};
+
+struct HLSLRootSignature
+{
+	HLSLRootSignatureFlags flags = HLSL_ROOT_SIGNATURE_FLAG_NONE;
+	SmallVector<HLSLRootParameter> parameters;
+};
+
 class CompilerHLSL : public CompilerGLSL
 {
 public:
@@ -203,11 +272,28 @@ public:
 	// is_hlsl_resource_binding_used() will return true after calling ::compile() if
 	// the set/binding combination was used by the HLSL code.
 	void add_hlsl_resource_binding(const HLSLResourceBinding &resource);
+	// Adds a whole table of resource bindings at once, as if add_hlsl_resource_binding() was called for each of them.
+	void add_hlsl_resource_bindings(const HLSLResourceBinding *resources, size_t count);
 	bool is_hlsl_resource_binding_used(spv::ExecutionModel model, uint32_t set, uint32_t binding) const;
 
 	// Controls which storage buffer bindings will be forced to be declared as UAVs.
 	void set_hlsl_force_storage_buffer_as_uav(uint32_t desc_set, uint32_t binding);
 
+	// Builds a root signature for the registers declared by the last call to compile().
+	// Push constants are placed in root constants as long as they fit within the D3D12 root signature size limit,
+	// and are placed first, since they are the most frequently changed. All other CBVs, SRVs and UAVs share
+	// a single descriptor table, and samplers share another, with contiguous registers merged into one range.
+	// Every resource must be declared with an explicit register, or an exception is thrown.
+	HLSLRootSignature get_root_signature() const;
+
+	// Builds a single root signature which can be shared by all shaders in a pipeline.
+	// Registers used by several stages are only declared once. Root constants only used by one stage
+	// are restricted to that stage, and root access is denied to graphics stages which are not part of the set.
+	static HLSLRootSignature build_root_signature(const CompilerHLSL *const *compilers, size_t count);
+
+	// Serializes a root signature to the HLSL string form, e.g. for [RootSignature()] or the rootsig_1_1 target.
+	static std::string root_signature_to_string(const HLSLRootSignature &root_signature);
+
 private:
 	std::string type_to_glsl(const SPIRType &type, uint32_t id = 0) override;
 	std::string image_type_hlsl(const SPIRType &type, uint32_t id);
@@ -243,7 +329,9 @@ private:
 	std::string to_sampler_expression(uint32_t id);
 	std::string to_resource_binding(const SPIRVariable &var);
 	std::string to_resource_binding_sampler(const SPIRVariable &var);
-	std::string to_resource_register(HLSLBindingFlagBits flag, char space, uint32_t binding, uint32_t set);
+	std::string to_resource_register(HLSLBindingFlagBits flag, char space, uint32_t binding, uint32_t set,
+	                                 uint32_t count = 1, uint32_t root_constant_size = 0);
+	uint32_t to_resource_register_count(const SPIRType &type) const;
 	std::string to_initializer_expression(const SPIRVariable &var) override;
 	void emit_sampled_image_op(uint32_t result_type, uint32_t result_id, uint32_t image_id, uint32_t samp_id) override;
 	void emit_access_chain(const Instruction &instruction);
@@ -367,8 +455,24 @@ private:
 
 	std::unordered_set<SetBindingPair, InternalHasher> force_uav_buffer_bindings;
 
+	// Every register declared in the last compilation, used to build root signatures.
+	struct DeclaredRegister
+	{
+		char space;
+		uint32_t binding;
+		uint32_t register_space;
+		uint32_t count;
+		// In bytes, only for push constants.
+		uint32_t root_constant_size;
+	};
+	SmallVector<DeclaredRegister> declared_registers;
+	bool declared_unbound_registers = false;
+
 	// Returns true for BuiltInSampleMask because gl_SampleMask[] is an array in SPIR-V, but SV_Coverage is a scalar in HLSL.
 	bool builtin_translates_to_nonarray(spv::BuiltIn builtin) const override;
+
+	void hash_compile_state(Hasher &hasher) const override;
+	void reset_module_state() override;
 };
 } // namespace SPIRV_CROSS_NAMESPACE
 
@@ -69,6 +69,49 @@ void CompilerMSL::add_msl_resource_binding(const MSLResourceBinding &binding)
 	resource_bindings[tuple] = { binding, false };
 }
 
+void CompilerMSL::add_msl_resource_bindings(const MSLResourceBinding *bindings, size_t count)
+{
+	resource_bindings.reserve(resource_bindings.size() + count);
+	for (size_t i = 0; i < count; i++)
+		add_msl_resource_binding(bindings[i]);
+}
+
+void CompilerMSL::build_resource_binding_index()
+{
+	resource_binding_index.clear();
+	if (resource_bindings.empty())
+		return;
+
+	resource_binding_index.resize(ir.ids.size());
+	auto model = get_entry_point().model;
+	ir.for_each_typed_id<SPIRVariable>([&](uint32_t id, SPIRVariable &var) {
+		auto &dec = ir.meta[id].decoration;
+		auto &entry = resource_binding_index[id];
+		entry.desc_set = var.storage == StorageClassPushConstant ? kPushConstDescSet : dec.set;
+		entry.binding = var.storage == StorageClassPushConstant ? kPushConstBinding : dec.binding;
+		auto itr = resource_bindings.find({ model, entry.desc_set, entry.binding });
+		entry.remap = itr != end(resource_bindings) ? &itr->second : nullptr;
+		entry.valid = true;
+	});
+}
+
+pair<MSLResourceBinding, bool> *CompilerMSL::find_resource_binding(uint32_t id, uint32_t desc_set, uint32_t binding)
+{
+	if (resource_bindings.empty())
+		return nullptr;
+
+	// Variables which were added or redecorated after the index was built fall back to the table.
+	if (id < resource_binding_index.size())
+	{
+		auto &entry = resource_binding_index[id];
+		if (entry.valid && entry.desc_set == desc_set && entry.binding == binding)
+			return entry.remap;
+	}
+
+	auto itr = resource_bindings.find({ get_entry_point().model, desc_set, binding });
+	return itr != end(resource_bindings) ? &itr->second : nullptr;
+}
+
 void CompilerMSL::add_dynamic_buffer(uint32_t desc_set, uint32_t binding, uint32_t index)
 {
 	SetBindingPair pair = { desc_set, binding };
@@ -140,6 +183,26 @@ uint32_t CompilerMSL::get_automatic_msl_resource_binding_quaternary(uint32_t id)
 	return get_extended_decoration(id, SPIRVCrossDecorationResourceIndexQuaternary);
 }
 
+uint32_t CompilerMSL::get_tess_control_output_staging_size() const
+{
+	if (!msl_options.stage_tess_control_outputs_in_threadgroup ||
+	    get_execution_model() != ExecutionModelTessellationControl || !stage_out_var_id)
+		return 0;
+
+	// The output struct has no Offset decorations, lay it out the way Metal does.
+	auto &type = get_variable_data_type(get<SPIRVariable>(stage_out_var_id));
+	uint32_t size = 0;
+	uint32_t alignment = 1;
+	for (uint32_t i = 0; i < uint32_t(type.member_types.size()); i++)
+	{
+		uint32_t member_alignment = get_declared_struct_member_alignment_msl(type, i);
+		size = ((size + member_alignment - 1) & ~(member_alignment - 1)) + get_declared_struct_member_size_msl(type, i);
+		alignment = max(alignment, member_alignment);
+	}
+	size = (size + alignment - 1) & ~(alignment - 1);
+	return get_entry_point().output_vertices * size;
+}
+
 void CompilerMSL::set_fragment_output_components(uint32_t location, uint32_t components)
 {
 	fragment_output_components[location] = components;
@@ -177,10 +240,20 @@ void CompilerMSL::build_implicit_builtins()
 	bool need_sample_mask = msl_options.additional_fixed_sample_mask != 0xffffffff;
 	bool need_local_invocation_index = msl_options.emulate_subgroups && active_input_builtins.get(BuiltInSubgroupId);
 	bool need_workgroup_size = msl_options.emulate_subgroups && active_input_builtins.get(BuiltInNumSubgroups);
+	bool need_vertex_pulling = false;
+	if (get_execution_model() == ExecutionModelVertex && msl_options.vertex_pulling)
+	{
+		// Vertex pulling needs the vertex and instance indices to compute the addresses of the inputs.
+		ir.for_each_typed_id<SPIRVariable>([&](uint32_t, SPIRVariable &var) {
+			if (var.storage == StorageClassInput && interface_variable_exists_in_entry_point(var.self) &&
+			    !is_builtin_variable(var))
+				need_vertex_pulling = true;
+		});
+	}
 	if (need_subpass_input || need_sample_pos || need_subgroup_mask || need_vertex_params || need_tesc_params ||
 	    need_multiview || need_dispatch_base || need_vertex_base_params || need_grid_params || needs_sample_id ||
 	    needs_subgroup_invocation_id || needs_subgroup_size || need_sample_mask || need_local_invocation_index ||
-	    need_workgroup_size)
+	    need_workgroup_size || need_vertex_pulling)
 	{
 		bool has_frag_coord = false;
 		bool has_sample_id = false;
@@ -257,7 +330,7 @@ void CompilerMSL::build_implicit_builtins()
 				has_sample_id = true;
 			}
 
-			if (need_vertex_params)
+			if (need_vertex_params || need_vertex_pulling)
 			{
 				switch (builtin)
 				{
@@ -465,7 +538,8 @@ void CompilerMSL::build_implicit_builtins()
 		}
 
 		if ((need_vertex_params && (!has_vertex_idx || !has_base_vertex || !has_instance_idx || !has_base_instance)) ||
-		    (need_multiview && (!has_instance_idx || !has_base_instance || !has_view_idx)))
+		    (need_multiview && (!has_instance_idx || !has_base_instance || !has_view_idx)) ||
+		    (need_vertex_pulling && (!has_vertex_idx || !has_instance_idx || !has_base_instance)))
 		{
 			uint32_t type_ptr_id = ir.increase_bound_by(1);
 
@@ -477,7 +551,7 @@ void CompilerMSL::build_implicit_builtins()
 			auto &ptr_type = set<SPIRType>(type_ptr_id, uint_type_ptr);
 			ptr_type.self = get_uint_type_id();
 
-			if (need_vertex_params && !has_vertex_idx)
+			if ((need_vertex_params || need_vertex_pulling) && !has_vertex_idx)
 			{
 				uint32_t var_id = ir.increase_bound_by(1);
 
@@ -825,7 +899,7 @@ void CompilerMSL::ensure_builtin(spv::StorageClass storage, spv::BuiltIn builtin
 	if (active_builtins != nullptr && !active_builtins->get(builtin))
 	{
 		active_builtins->set(builtin);
-		force_recompile();
+		force_recompile(RecompileReasonBuiltin);
 	}
 }
 
@@ -1183,6 +1257,8 @@ void CompilerMSL::emit_entry_point_declarations()
 
 string CompilerMSL::compile()
 {
+	CompileBudgetScope budget_scope(*this);
+	begin_phase_timings();
 	replace_illegal_entry_point_names();
 	ir.fixup_reserved_names();
 
@@ -1236,10 +1312,8 @@ string CompilerMSL::compile()
 	sync_entry_point_aliases_and_names();
 
 	build_function_control_flow_graphs_and_analyze();
-	update_active_builtins();
-	analyze_image_and_sampler_usage();
-	analyze_sampled_image_usage();
-	analyze_interlocked_resource_usage();
+	SampledImageScanner sampled_image_scanner(*this);
+	analyze_active_usage(msl_options.swizzle_texture_samples ? &sampled_image_scanner : nullptr);
 	preprocess_op_codes();
 	build_implicit_builtins();
 
@@ -1264,12 +1338,15 @@ string CompilerMSL::compile()
 	if (builtin_sample_mask_id)
 		active_interface_variables.insert(builtin_sample_mask_id);
 
+	build_resource_binding_index();
+
 	// Create structs to hold input, output and uniform variables.
 	// Do output first to ensure out. is declared at top of entry function.
 	qual_pos_var_name = "";
 	stage_out_var_id = add_interface_block(StorageClassOutput);
 	patch_stage_out_var_id = add_interface_block(StorageClassOutput, true);
 	stage_in_var_id = add_interface_block(StorageClassInput);
+	reserve_vertex_pulling_buffer_indices();
 	if (get_execution_model() == ExecutionModelTessellationEvaluation)
 		patch_stage_in_var_id = add_interface_block(StorageClassInput, true);
 
@@ -1303,12 +1380,19 @@ string CompilerMSL::compile()
 		analyze_argument_buffers();
 	}
 
-	uint32_t pass_count = 0;
+	if (options.predict_temporaries)
+		analyze_multiply_read_expressions();
+	analyze_common_subexpressions();
+
+	begin_emission_timings();
+	compile_pass_count = 0;
 	do
 	{
-		if (pass_count >= 3)
+		if (compile_pass_count >= 3)
 			SPIRV_CROSS_THROW("Over 3 compilation loops detected. Must be a bug!");
 
+		SPIRV_CROSS_TRACE_SCOPE(trace_callback, TraceEventCompilePass, compile_pass_count);
+
 		reset();
 
 		// Start bindings at zero.
@@ -1319,19 +1403,24 @@ string CompilerMSL::compile()
 			id = 0;
 
 		// Move constructor for this type is broken on GCC 4.9 ...
-		buffer.reset();
+		buffer.clear();
 
 		emit_header();
-		emit_custom_templates();
+		if (msl_options.use_helper_library)
+			add_dependent_spv_functions();
+		else
+			emit_custom_templates();
 		emit_specialization_constants_and_structs();
 		emit_resources();
-		emit_custom_functions();
+		if (!msl_options.use_helper_library)
+			emit_custom_functions();
 		emit_function(get<SPIRFunction>(ir.default_entry_point), Bitset());
 
-		pass_count++;
+		compile_pass_count++;
+		end_pass_timing();
 	} while (is_forcing_recompilation());
 
-	return buffer.str();
+	return finish_output();
 }
 
 // Register the need to output any custom functions.
@@ -1796,37 +1885,38 @@ uint32_t CompilerMSL::get_target_components_for_fragment_location(uint32_t locat
 
 uint32_t CompilerMSL::build_extended_vector_type(uint32_t type_id, uint32_t components, SPIRType::BaseType basetype)
 {
+	// The same extended types tend to be requested for many interface variables, so they are interned.
 	uint32_t new_type_id = ir.increase_bound_by(1);
 	auto &old_type = get<SPIRType>(type_id);
-	auto *type = &set<SPIRType>(new_type_id, old_type);
-	type->vecsize = components;
+	SPIRType type = old_type;
+	type.vecsize = components;
 	if (basetype != SPIRType::Unknown)
-		type->basetype = basetype;
-	type->self = new_type_id;
-	type->parent_type = type_id;
-	type->array.clear();
-	type->array_size_literal.clear();
-	type->pointer = false;
+		type.basetype = basetype;
+	type.self = new_type_id;
+	type.parent_type = type_id;
+	type.array.clear();
+	type.array_size_literal.clear();
+	type.pointer = false;
+	new_type_id = set_interned_type(new_type_id, type);
 
 	if (is_array(old_type))
 	{
 		uint32_t array_type_id = ir.increase_bound_by(1);
-		type = &set<SPIRType>(array_type_id, *type);
-		type->parent_type = new_type_id;
-		type->array = old_type.array;
-		type->array_size_literal = old_type.array_size_literal;
-		new_type_id = array_type_id;
+		type.self = array_type_id;
+		type.parent_type = new_type_id;
+		type.array = old_type.array;
+		type.array_size_literal = old_type.array_size_literal;
+		new_type_id = set_interned_type(array_type_id, type);
 	}
 
 	if (old_type.pointer)
 	{
 		uint32_t ptr_type_id = ir.increase_bound_by(1);
-		type = &set<SPIRType>(ptr_type_id, *type);
-		type->self = new_type_id;
-		type->parent_type = new_type_id;
-		type->storage = old_type.storage;
-		type->pointer = true;
-		new_type_id = ptr_type_id;
+		type.self = new_type_id;
+		type.parent_type = new_type_id;
+		type.storage = old_type.storage;
+		type.pointer = true;
+		new_type_id = set_interned_type(ptr_type_id, type);
 	}
 
 	return new_type_id;
@@ -1835,14 +1925,17 @@ uint32_t CompilerMSL::build_extended_vector_type(uint32_t type_id, uint32_t comp
 uint32_t CompilerMSL::build_msl_interpolant_type(uint32_t type_id, bool is_noperspective)
 {
 	uint32_t new_type_id = ir.increase_bound_by(1);
-	SPIRType &type = set<SPIRType>(new_type_id, get<SPIRType>(type_id));
+	SPIRType type = get<SPIRType>(type_id);
+	type.self = new_type_id;
 	type.basetype = SPIRType::Interpolant;
 	type.parent_type = type_id;
 	// In Metal, the pull-model interpolant type encodes perspective-vs-no-perspective in the type itself.
 	// Add this decoration so we know which argument to pass to the template.
-	if (is_noperspective)
+	// The decoration is part of the interning tag, so an existing type already has it.
+	uint32_t interned_type_id = set_interned_type(new_type_id, type, is_noperspective);
+	if (interned_type_id == new_type_id && is_noperspective)
 		set_decoration(new_type_id, DecorationNoPerspective);
-	return new_type_id;
+	return interned_type_id;
 }
 
 void CompilerMSL::add_plain_variable_to_interface_block(StorageClass storage, const string &ib_var_ref,
@@ -3085,6 +3178,14 @@ uint32_t CompilerMSL::add_interface_block(StorageClass storage, bool patch)
 				}
 			});
 		}
+		else if (get_execution_model() == ExecutionModelVertex && msl_options.vertex_pulling)
+		{
+			if (msl_options.vertex_for_tessellation)
+				SPIRV_CROSS_THROW("Vertex pulling is not supported when compiling vertex shaders for tessellation.");
+
+			// The input struct is a local variable, which is filled in from the vertex buffers.
+			entry_func.fixup_hooks_in.push_back([=]() { emit_vertex_input_loads(ib_var_id); });
+		}
 		break;
 
 	case StorageClassOutput:
@@ -3151,6 +3252,10 @@ uint32_t CompilerMSL::add_interface_block(StorageClass storage, bool patch)
 			case ExecutionModelTessellationControl:
 				if (msl_options.multi_patch_workgroup)
 				{
+					if (msl_options.stage_tess_control_outputs_in_threadgroup)
+						SPIRV_CROSS_THROW("Staging tessellation control outputs in threadgroup memory is not supported "
+						                  "with multi-patch workgroups.");
+
 					// We cannot use PrimitiveId here, because the hook may not have run yet.
 					if (patch)
 					{
@@ -3180,6 +3285,22 @@ uint32_t CompilerMSL::add_interface_block(StorageClass storage, bool patch)
 							          "];");
 						});
 					}
+					else if (msl_options.stage_tess_control_outputs_in_threadgroup)
+					{
+						// Every invocation can only write its own control point, so it can copy it out by itself,
+						// without waiting for the other invocations.
+						entry_func.fixup_hooks_in.push_back([=]() {
+							auto type_name = join(to_name(ir.default_entry_point), "_", ib_var_ref);
+							statement("threadgroup ", type_name, " spvStagedOut[", get_entry_point().output_vertices,
+							          "];");
+							statement("threadgroup ", type_name, "* gl_out = spvStagedOut;");
+						});
+						entry_func.fixup_hooks_out.push_back([=]() {
+							statement(output_buffer_var_name, "[", to_expression(builtin_primitive_id_id), " * ",
+							          get_entry_point().output_vertices, " + ", to_expression(builtin_invocation_id_id),
+							          "] = gl_out[", to_expression(builtin_invocation_id_id), "];");
+						});
+					}
 					else
 					{
 						entry_func.fixup_hooks_in.push_back([=]() {
@@ -3247,18 +3368,20 @@ uint32_t CompilerMSL::add_interface_block(StorageClass storage, bool patch)
 				break;
 			}
 			type.vecsize = input.second.vecsize;
-			set<SPIRType>(type_id, type);
+			type.self = type_id;
+			type_id = set_interned_type(type_id, type);
 
 			type.array.push_back(0);
 			type.array_size_literal.push_back(true);
+			type.self = array_type_id;
 			type.parent_type = type_id;
-			set<SPIRType>(array_type_id, type);
+			array_type_id = set_interned_type(array_type_id, type);
 
 			type.pointer = true;
+			type.self = array_type_id;
 			type.parent_type = array_type_id;
 			type.storage = storage;
-			auto &ptr_type = set<SPIRType>(ptr_type_id, type);
-			ptr_type.self = array_type_id;
+			ptr_type_id = set_interned_type(ptr_type_id, type);
 
 			auto &fake_var = set<SPIRVariable>(var_id, ptr_type_id, storage);
 			set_decoration(var_id, DecorationLocation, input.first);
@@ -3313,7 +3436,8 @@ uint32_t CompilerMSL::add_interface_block_pointer(uint32_t ib_var_id, StorageCla
 		ib_ptr_type.storage =
 		    storage == StorageClassInput ?
 		        (msl_options.multi_patch_workgroup ? StorageClassStorageBuffer : StorageClassWorkgroup) :
-		        StorageClassStorageBuffer;
+		        (msl_options.stage_tess_control_outputs_in_threadgroup ? StorageClassWorkgroup :
+		                                                                 StorageClassStorageBuffer);
 		ir.meta[ib_ptr_type_id] = ir.meta[ib_type.self];
 		// To ensure that get_variable_data_type() doesn't strip off the pointer,
 		// which we need, use another pointer.
@@ -3499,8 +3623,9 @@ void CompilerMSL::mark_scalar_layout_structs(const SPIRType &type)
 			uint32_t msl_size = get_declared_struct_member_size_msl(type, i);
 			uint32_t spirv_offset = type_struct_member_offset(type, i);
 			uint32_t spirv_offset_next;
-			if (i + 1 < mbr_cnt)
-				spirv_offset_next = type_struct_member_offset(type, i + 1);
+			uint32_t next = get_next_declared_struct_member(type, i);
+			if (next < mbr_cnt)
+				spirv_offset_next = type_struct_member_offset(type, next);
 			else
 				spirv_offset_next = spirv_offset + msl_size;
 
@@ -3572,10 +3697,15 @@ void CompilerMSL::align_struct(SPIRType &ib_type, unordered_set<uint32_t> &align
 
 	// Sort the members of the interface structure by their offset.
 	// They should already be sorted per SPIR-V spec anyway.
-	MemberSorter member_sorter(ib_type, ir.meta[ib_type_id], MemberSorter::Offset);
-	member_sorter.sort();
+	// Repacked blocks are accessed through their original member indices, so they are only declared in offset order.
+	if (!has_extended_decoration(ib_type_id, SPIRVCrossDecorationMemberDeclarationOrderByOffset))
+	{
+		MemberSorter member_sorter(ib_type, ir.meta[ib_type_id], MemberSorter::Offset);
+		member_sorter.sort();
+	}
 
 	auto mbr_cnt = uint32_t(ib_type.member_types.size());
+	auto mbr_order = get_struct_member_declaration_order(ib_type);
 
 	for (uint32_t mbr_idx = 0; mbr_idx < mbr_cnt; mbr_idx++)
 	{
@@ -3590,8 +3720,10 @@ void CompilerMSL::align_struct(SPIRType &ib_type, unordered_set<uint32_t> &align
 	// a packed format. If so, and the previous member is packable, pack it.
 	// For example ... this applies to any 3-element vector that is followed by a scalar.
 	uint32_t msl_offset = 0;
-	for (uint32_t mbr_idx = 0; mbr_idx < mbr_cnt; mbr_idx++)
+	for (uint32_t mbr_pos = 0; mbr_pos < mbr_cnt; mbr_pos++)
 	{
+		uint32_t mbr_idx = mbr_order[mbr_pos];
+
 		// This checks the member in isolation, if the member needs some kind of type remapping to conform to SPIR-V
 		// offsets, array strides and matrix strides.
 		ensure_member_packing_rules_msl(ib_type, mbr_idx);
@@ -3626,7 +3758,7 @@ void CompilerMSL::align_struct(SPIRType &ib_type, unordered_set<uint32_t> &align
 
 		// Increment the current offset to be positioned immediately after the current member.
 		// Don't do this for the last member since it can be unsized, and it is not relevant for padding purposes here.
-		if (mbr_idx + 1 < mbr_cnt)
+		if (mbr_pos + 1 < mbr_cnt)
 			msl_offset = aligned_msl_offset + get_declared_struct_member_size_msl(ib_type, mbr_idx);
 	}
 }
@@ -3636,12 +3768,13 @@ bool CompilerMSL::validate_member_packing_rules_msl(const SPIRType &type, uint32
 	auto &mbr_type = get<SPIRType>(type.member_types[index]);
 	uint32_t spirv_offset = get_member_decoration(type.self, index, DecorationOffset);
 
-	if (index + 1 < type.member_types.size())
+	uint32_t next = get_next_declared_struct_member(type, index);
+	if (next < type.member_types.size())
 	{
 		// First, we will check offsets. If SPIR-V offset + MSL size > SPIR-V offset of next member,
 		// we *must* perform some kind of remapping, no way getting around it.
 		// We can always pad after this member if necessary, so that case is fine.
-		uint32_t spirv_offset_next = get_member_decoration(type.self, index + 1, DecorationOffset);
+		uint32_t spirv_offset_next = get_member_decoration(type.self, next, DecorationOffset);
 		assert(spirv_offset_next >= spirv_offset);
 		uint32_t maximum_size = spirv_offset_next - spirv_offset;
 		uint32_t msl_mbr_size = get_declared_struct_member_size_msl(type, index);
@@ -3903,7 +4036,7 @@ void CompilerMSL::emit_store_statement(uint32_t lhs_expression, uint32_t rhs_exp
 			for (uint32_t c = 0; c < type.vecsize; c++)
 			{
 				auto lhs_expr = to_dereferenced_expression(lhs_expression);
-				auto column_index = lhs_expr.find_last_of('[');
+				auto column_index = get_column_subscript_offset(lhs_expression, lhs_expr);
 				if (column_index != string::npos)
 				{
 					statement(lhs_expr.insert(column_index, join('[', c, ']')), " = ",
@@ -4054,7 +4187,7 @@ void CompilerMSL::emit_store_statement(uint32_t lhs_expression, uint32_t rhs_exp
 			for (uint32_t c = 0; c < type.vecsize; c++)
 			{
 				auto lhs_expr = to_enclosed_expression(lhs_expression);
-				auto column_index = lhs_expr.find_last_of('[');
+				auto column_index = get_column_subscript_offset(lhs_expression, lhs_expr);
 				if (column_index != string::npos)
 				{
 					statement("((device ", type_to_glsl(write_type), "*)&",
@@ -4207,6 +4340,12 @@ void CompilerMSL::emit_header()
 	statement("using namespace metal;");
 	statement("");
 
+	if (msl_options.use_helper_library)
+	{
+		statement("#include \"", helper_library_include, "\"");
+		statement("");
+	}
+
 	for (auto &td : typedef_lines)
 		statement(td);
 
@@ -4218,14 +4357,14 @@ void CompilerMSL::add_pragma_line(const string &line)
 {
 	auto rslt = pragma_lines.insert(line);
 	if (rslt.second)
-		force_recompile();
+		force_recompile(RecompileReasonExtension);
 }
 
 void CompilerMSL::add_typedef_line(const string &line)
 {
 	auto rslt = typedef_lines.insert(line);
 	if (rslt.second)
-		force_recompile();
+		force_recompile(RecompileReasonHelperFunction);
 }
 
 // Template struct like spvUnsafeArray<> need to be declared *before* any resources are declared
@@ -4282,10 +4421,8 @@ void CompilerMSL::emit_custom_templates()
 	}
 }
 
-// Emits any needed custom function bodies.
-// Metal helper functions must be static force-inline, i.e. static inline __attribute__((always_inline))
-// otherwise they will cause problems when linked together in a single Metallib.
-void CompilerMSL::emit_custom_functions()
+// Some helpers are implemented in terms of others, make sure those are pulled in too.
+void CompilerMSL::add_dependent_spv_functions()
 {
 	for (uint32_t i = kArrayCopyMultidimMax; i >= 2; i--)
 		if (spv_function_implementations.count(static_cast<SPVFuncImpl>(SPVFuncImplArrayCopyMultidimBase + i)))
@@ -4323,6 +4460,14 @@ void CompilerMSL::emit_custom_functions()
 		spv_function_implementations.insert(SPVFuncImplForwardArgs);
 		spv_function_implementations.insert(SPVFuncImplGetSwizzle);
 	}
+}
+
+// Emits any needed custom function bodies.
+// Metal helper functions must be static force-inline, i.e. static inline __attribute__((always_inline))
+// otherwise they will cause problems when linked together in a single Metallib.
+void CompilerMSL::emit_custom_functions()
+{
+	add_dependent_spv_functions();
 
 	for (const auto &spv_func : spv_function_implementations)
 	{
@@ -6122,16 +6267,63 @@ void CompilerMSL::declare_complex_constant_arrays()
 
 void CompilerMSL::emit_resources()
 {
+	SPIRV_CROSS_TRACE_SCOPE(trace_callback, TraceEventEmitResources, 0);
+
 	declare_constant_arrays();
 	declare_undefined_values();
 
 	// Emit the special [[stage_in]] and [[stage_out]] interface blocks which we created.
 	emit_interface_block(stage_out_var_id);
 	emit_interface_block(patch_stage_out_var_id);
+	if (stage_in_var_id && get_execution_model() == ExecutionModelVertex && msl_options.vertex_pulling)
+	{
+		statement("struct spvVertexAttribute");
+		begin_scope();
+		statement("uint offset;");
+		statement("uint stride;");
+		statement("uint instance_divisor;");
+		end_scope_decl();
+		statement("");
+	}
+
 	emit_interface_block(stage_in_var_id);
 	emit_interface_block(patch_stage_in_var_id);
 }
 
+// Declares the stage-in struct as a local variable, and loads every member from its vertex buffer.
+void CompilerMSL::emit_vertex_input_loads(uint32_t ib_var_id)
+{
+	auto &ib_type = get_variable_data_type(get<SPIRVariable>(ib_var_id));
+	auto ib_var_ref = to_name(ib_var_id);
+	statement(type_to_glsl(ib_type), " ", ib_var_ref, " = {};");
+
+	for (uint32_t i = 0; i < uint32_t(ib_type.member_types.size()); i++)
+	{
+		auto &mbr_type = get<SPIRType>(ib_type.member_types[i]);
+		if (!mbr_type.array.empty() || mbr_type.columns > 1)
+			SPIRV_CROSS_THROW("Vertex pulling does not support arrays or matrices in the stage-in struct.");
+
+		uint32_t locn = get_ordered_member_location(ib_type.self, i);
+		auto attr = join(vertex_attributes_var_name, "[", locn, "]");
+		auto index = join("(", attr, ".instance_divisor != 0 ? (", to_expression(builtin_instance_idx_id), " - ",
+		                  to_expression(builtin_base_instance_id), ") / ", attr, ".instance_divisor + ",
+		                  to_expression(builtin_base_instance_id), " : ", to_expression(builtin_vertex_idx_id), ")");
+		auto addr = join(vertex_buffer_var_name, locn, " + ", attr, ".offset + ", index, " * ", attr, ".stride");
+
+		auto mbr_type_name = type_to_glsl(mbr_type);
+		if (mbr_type.vecsize > 1)
+		{
+			statement(ib_var_ref, ".", to_member_name(ib_type, i), " = ", mbr_type_name,
+			          "(*reinterpret_cast<const device packed_", mbr_type_name, "*>(", addr, "));");
+		}
+		else
+		{
+			statement(ib_var_ref, ".", to_member_name(ib_type, i), " = *reinterpret_cast<const device ",
+			          mbr_type_name, "*>(", addr, ");");
+		}
+	}
+}
+
 // Emit declarations for the specialization Metal function constants
 void CompilerMSL::emit_specialization_constants_and_structs()
 {
@@ -7288,7 +7480,7 @@ void CompilerMSL::emit_instruction(const Instruction &instruction)
 			if (p_var && has_decoration(p_var->self, DecorationNonReadable))
 			{
 				unset_decoration(p_var->self, DecorationNonReadable);
-				force_recompile();
+				force_recompile(RecompileReasonDecoration);
 			}
 		}
 
@@ -7349,7 +7541,7 @@ void CompilerMSL::emit_instruction(const Instruction &instruction)
 		if (p_var && has_decoration(p_var->self, DecorationNonWritable))
 		{
 			unset_decoration(p_var->self, DecorationNonWritable);
-			force_recompile();
+			force_recompile(RecompileReasonDecoration);
 		}
 
 		bool forward = false;
@@ -10002,7 +10194,7 @@ string CompilerMSL::member_attribute_qualifier(const SPIRType &type, uint32_t in
 			}
 		}
 		uint32_t locn = get_ordered_member_location(type.self, index);
-		if (locn != k_unknown_location)
+		if (locn != k_unknown_location && !msl_options.vertex_pulling)
 			return string(" [[attribute(") + convert_to_string(locn) + ")]]";
 	}
 
@@ -10495,6 +10687,9 @@ string CompilerMSL::entry_point_arg_stage_in()
 	if (get_execution_model() == ExecutionModelTessellationControl && msl_options.multi_patch_workgroup)
 		return decl;
 
+	if (get_execution_model() == ExecutionModelVertex && msl_options.vertex_pulling)
+		return decl;
+
 	// Stage-in structure
 	uint32_t stage_in_id;
 	if (get_execution_model() == ExecutionModelTessellationEvaluation)
@@ -10805,6 +11000,28 @@ void CompilerMSL::entry_point_args_builtin(string &ep_args)
 			}
 		}
 	}
+
+	if (stage_in_var_id && get_execution_model() == ExecutionModelVertex && msl_options.vertex_pulling)
+	{
+		// Add the vertex buffers and the attribute descriptions to load the inputs from.
+		auto &ib_type = get_stage_in_struct_type();
+		std::set<uint32_t> locations;
+		for (uint32_t i = 0; i < uint32_t(ib_type.member_types.size()); i++)
+			locations.insert(get_ordered_member_location(ib_type.self, i));
+
+		for (uint32_t locn : locations)
+		{
+			if (!ep_args.empty())
+				ep_args += ", ";
+			ep_args += join("const device uchar* ", vertex_buffer_var_name, locn, " [[buffer(",
+			                msl_options.vertex_buffer_index_base + locn, ")]]");
+		}
+
+		if (!ep_args.empty())
+			ep_args += ", ";
+		ep_args += join("constant spvVertexAttribute* ", vertex_attributes_var_name, " [[buffer(",
+		                msl_options.vertex_attribute_buffer_index, ")]]");
+	}
 }
 
 string CompilerMSL::entry_point_args_argument_buffer(bool append_comma)
@@ -10837,8 +11054,8 @@ string CompilerMSL::entry_point_args_argument_buffer(bool append_comma)
 		{
 			// As a fallback, directly map desc set <-> binding.
 			// If that was taken, take the next buffer binding.
-			if (claimed_bindings.get(i))
-				buffer_binding = next_metal_resource_index_buffer;
+			if (claimed_bindings.get(i) || reserved_buffer_indices.get(i))
+				buffer_binding = get_next_unreserved_buffer_index(next_metal_resource_index_buffer, 1);
 			else
 				buffer_binding = i;
 		}
@@ -11675,14 +11892,13 @@ void CompilerMSL::fix_up_shader_inputs_outputs()
 // Returns the Metal index of the resource of the specified type as used by the specified variable.
 uint32_t CompilerMSL::get_metal_resource_index(SPIRVariable &var, SPIRType::BaseType basetype, uint32_t plane)
 {
-	auto &execution = get_entry_point();
 	auto &var_dec = ir.meta[var.self].decoration;
 	auto &var_type = get<SPIRType>(var.basetype);
 	uint32_t var_desc_set = (var.storage == StorageClassPushConstant) ? kPushConstDescSet : var_dec.set;
 	uint32_t var_binding = (var.storage == StorageClassPushConstant) ? kPushConstBinding : var_dec.binding;
 
 	// If a matching binding has been specified, find and use it.
-	auto itr = resource_bindings.find({ execution.model, var_desc_set, var_binding });
+	auto *remap = find_resource_binding(var.self, var_desc_set, var_binding);
 
 	// Atomic helper buffers for image atomics need to use secondary bindings as well.
 	bool use_secondary_binding = (var_type.basetype == SPIRType::SampledImage && basetype == SPIRType::Sampler) ||
@@ -11696,21 +11912,20 @@ uint32_t CompilerMSL::get_metal_resource_index(SPIRVariable &var, SPIRType::Base
 	if (plane == 2)
 		resource_decoration = SPIRVCrossDecorationResourceIndexQuaternary;
 
-	if (itr != end(resource_bindings))
+	if (remap)
 	{
-		auto &remap = itr->second;
-		remap.second = true;
+		remap->second = true;
 		switch (basetype)
 		{
 		case SPIRType::Image:
-			set_extended_decoration(var.self, resource_decoration, remap.first.msl_texture + plane);
-			return remap.first.msl_texture + plane;
+			set_extended_decoration(var.self, resource_decoration, remap->first.msl_texture + plane);
+			return remap->first.msl_texture + plane;
 		case SPIRType::Sampler:
-			set_extended_decoration(var.self, resource_decoration, remap.first.msl_sampler);
-			return remap.first.msl_sampler;
+			set_extended_decoration(var.self, resource_decoration, remap->first.msl_sampler);
+			return remap->first.msl_sampler;
 		default:
-			set_extended_decoration(var.self, resource_decoration, remap.first.msl_buffer);
-			return remap.first.msl_buffer;
+			set_extended_decoration(var.self, resource_decoration, remap->first.msl_buffer);
+			return remap->first.msl_buffer;
 		}
 	}
 
@@ -11776,8 +11991,8 @@ uint32_t CompilerMSL::get_metal_resource_index(SPIRVariable &var, SPIRType::Base
 			next_metal_resource_index_sampler += binding_stride;
 			break;
 		default:
-			resource_index = next_metal_resource_index_buffer;
-			next_metal_resource_index_buffer += binding_stride;
+			resource_index = get_next_unreserved_buffer_index(next_metal_resource_index_buffer, binding_stride);
+			next_metal_resource_index_buffer = resource_index + binding_stride;
 			break;
 		}
 	}
@@ -11786,6 +12001,45 @@ uint32_t CompilerMSL::get_metal_resource_index(SPIRVariable &var, SPIRType::Base
 	return resource_index;
 }
 
+void CompilerMSL::reserve_vertex_pulling_buffer_indices()
+{
+	reserved_buffer_indices.reset();
+	if (!stage_in_var_id || get_execution_model() != ExecutionModelVertex || !msl_options.vertex_pulling)
+		return;
+
+	auto &ib_type = get_stage_in_struct_type();
+	for (uint32_t i = 0; i < uint32_t(ib_type.member_types.size()); i++)
+	{
+		uint32_t locn = get_ordered_member_location(ib_type.self, i);
+		uint32_t index = msl_options.vertex_buffer_index_base + locn;
+		if (locn > 30 || index > 30)
+			SPIRV_CROSS_THROW("Vertex buffer index for location " + convert_to_string(locn) +
+			                  " is out of range, vertex_buffer_index_base + location must not exceed 30.");
+		if (index == msl_options.vertex_attribute_buffer_index)
+			SPIRV_CROSS_THROW("Vertex buffer index for location " + convert_to_string(locn) +
+			                  " overlaps vertex_attribute_buffer_index.");
+		reserved_buffer_indices.set(index);
+	}
+	reserved_buffer_indices.set(msl_options.vertex_attribute_buffer_index);
+}
+
+// Returns the first index at or after index where count consecutive buffer indices are not reserved.
+uint32_t CompilerMSL::get_next_unreserved_buffer_index(uint32_t index, uint32_t count) const
+{
+	uint32_t i = 0;
+	while (i < count)
+	{
+		if (reserved_buffer_indices.get(index + i))
+		{
+			index += i + 1;
+			i = 0;
+		}
+		else
+			i++;
+	}
+	return index;
+}
+
 bool CompilerMSL::type_is_msl_framebuffer_fetch(const SPIRType &type) const
 {
 	return type.basetype == SPIRType::Image && type.image.dim == DimSubpassData &&
@@ -13743,6 +13997,11 @@ uint32_t CompilerMSL::get_declared_struct_size_msl(const SPIRType &struct_type,
 	if (struct_type.member_types.empty())
 		return 0;
 
+	auto query = LayoutQuery(LayoutQueryMSLSize + (ignore_alignment ? 1 : 0) + (ignore_padding ? 2 : 0));
+	size_t cached_size;
+	if (find_cached_layout(struct_type, query, cached_size))
+		return uint32_t(cached_size);
+
 	uint32_t mbr_cnt = uint32_t(struct_type.member_types.size());
 
 	// In MSL, a struct's alignment is equal to the maximum alignment of any of its members.
@@ -13759,9 +14018,11 @@ uint32_t CompilerMSL::get_declared_struct_size_msl(const SPIRType &struct_type,
 
 	// Last member will always be matched to the final Offset decoration, but size of struct in MSL now depends
 	// on physical size in MSL, and the size of the struct itself is then aligned to struct alignment.
-	uint32_t spirv_offset = type_struct_member_offset(struct_type, mbr_cnt - 1);
-	uint32_t msl_size = spirv_offset + get_declared_struct_member_size_msl(struct_type, mbr_cnt - 1);
+	uint32_t last = get_last_declared_struct_member(struct_type);
+	uint32_t spirv_offset = type_struct_member_offset(struct_type, last);
+	uint32_t msl_size = spirv_offset + get_declared_struct_member_size_msl(struct_type, last);
 	msl_size = (msl_size + alignment - 1) & ~(alignment - 1);
+	cache_layout(struct_type, query, msl_size);
 	return msl_size;
 }
 
@@ -13846,10 +14107,15 @@ uint32_t CompilerMSL::get_declared_type_alignment_msl(const SPIRType &type, bool
 
 	case SPIRType::Struct:
 	{
+		size_t cached_alignment;
+		if (find_cached_layout(type, LayoutQueryMSLAlignment, cached_alignment))
+			return uint32_t(cached_alignment);
+
 		// In MSL, a struct's alignment is equal to the maximum alignment of any of its members.
 		uint32_t alignment = 1;
 		for (uint32_t i = 0; i < type.member_types.size(); i++)
 			alignment = max(alignment, uint32_t(get_declared_struct_member_alignment_msl(type, i)));
+		cache_layout(type, LayoutQueryMSLAlignment, alignment);
 		return alignment;
 	}
 
@@ -13891,15 +14157,6 @@ bool CompilerMSL::skip_argument(uint32_t) const
 	return false;
 }
 
-void CompilerMSL::analyze_sampled_image_usage()
-{
-	if (msl_options.swizzle_texture_samples)
-	{
-		SampledImageScanner scanner(*this);
-		traverse_all_reachable_opcodes(get<SPIRFunction>(ir.default_entry_point), scanner);
-	}
-}
-
 bool CompilerMSL::SampledImageScanner::handle(spv::Op opcode, const uint32_t *args, uint32_t length)
 {
 	switch (opcode)
@@ -13948,7 +14205,7 @@ void CompilerMSL::add_spv_func_and_recompile(SPVFuncImpl spv_func)
 	{
 		spv_function_implementations.insert(spv_func);
 		suppress_missing_prototypes = true;
-		force_recompile();
+		force_recompile(RecompileReasonHelperFunction);
 	}
 }
 
@@ -14945,3 +15202,453 @@ const char *CompilerMSL::get_combined_sampler_suffix() const
 {
 	return sampler_name_suffix.c_str();
 }
+
+void CompilerMSL::set_helper_library_include(const char *name)
+{
+	helper_library_include = name;
+}
+
+const char *CompilerMSL::get_helper_library_include() const
+{
+	return helper_library_include.c_str();
+}
+
+void CompilerMSL::add_helper_library_requirements(const CompilerMSL &other)
+{
+	spv_function_implementations.insert(begin(other.spv_function_implementations),
+	                                    end(other.spv_function_implementations));
+}
+
+string CompilerMSL::compile_helper_library()
+{
+	buffer.clear();
+	indent = 0;
+
+	statement("#ifndef SPIRV_CROSS_MSL_HELPERS_H");
+	statement("#define SPIRV_CROSS_MSL_HELPERS_H");
+	statement("");
+
+	statement("#pragma clang diagnostic ignored \"-Wmissing-prototypes\"");
+	if (spv_function_implementations.count(SPVFuncImplUnsafeArray) != 0)
+		statement("#pragma clang diagnostic ignored \"-Wmissing-braces\"");
+	statement("");
+
+	statement("#include <metal_stdlib>");
+	statement("#include <simd/simd.h>");
+	statement("");
+	statement("using namespace metal;");
+	statement("");
+
+	add_dependent_spv_functions();
+	emit_custom_templates();
+	emit_custom_functions();
+
+	statement("#endif");
+
+	auto source = buffer.str();
+	buffer.clear();
+	return source;
+}
+
+// Assigns offsets to members sorted by [[id(N)]], following the MSL alignment rules for structs.
+static void layout_argument_buffer_members(SmallVector<MSLArgumentBufferMember> &members)
+{
+	sort(begin(members), end(members), [](const MSLArgumentBufferMember &lhs, const MSLArgumentBufferMember &rhs) {
+		return lhs.msl_id < rhs.msl_id;
+	});
+
+	uint32_t offset = 0;
+	for (auto &member : members)
+	{
+		offset = (offset + member.alignment - 1) & ~(member.alignment - 1);
+		member.offset = offset;
+		offset += member.size;
+	}
+}
+
+SmallVector<MSLArgumentBufferMember> CompilerMSL::get_argument_buffer_layout(uint32_t desc_set) const
+{
+	SmallVector<MSLArgumentBufferMember> members;
+	if (desc_set >= kMaxArgumentBuffers || argument_buffer_ids[desc_set] == 0)
+		return members;
+
+	auto &buffer_type = get_variable_data_type(get<SPIRVariable>(argument_buffer_ids[desc_set]));
+	uint32_t stage_mask = 1u << get_execution_model();
+	SmallVector<uint32_t> member_vars;
+
+	for (uint32_t i = 0; i < uint32_t(buffer_type.member_types.size()); i++)
+	{
+		auto &mbr_type = get<SPIRType>(buffer_type.member_types[i]);
+		uint32_t var_id = get_extended_member_decoration(buffer_type.self, i, SPIRVCrossDecorationInterfaceOrigID);
+
+		MSLArgumentBufferMember member;
+		member.desc_set = desc_set;
+		member.binding = get_decoration(var_id, DecorationBinding);
+		member.msl_id = get_extended_member_decoration(buffer_type.self, i, SPIRVCrossDecorationResourceIndexPrimary);
+		member.stage_mask = stage_mask;
+
+		if (mbr_type.basetype == SPIRType::Image || mbr_type.basetype == SPIRType::SampledImage)
+			member.type = MSL_ARGUMENT_BUFFER_MEMBER_TEXTURE;
+		else if (mbr_type.basetype == SPIRType::Sampler)
+			member.type = MSL_ARGUMENT_BUFFER_MEMBER_SAMPLER;
+		else if (mbr_type.basetype == SPIRType::Struct && !mbr_type.pointer)
+			member.type = MSL_ARGUMENT_BUFFER_MEMBER_INLINE_UNIFORM_BLOCK;
+		else
+			member.type = MSL_ARGUMENT_BUFFER_MEMBER_BUFFER;
+
+		// Planes of a multiplanar image are emitted in order.
+		for (size_t j = 0; j < members.size(); j++)
+			if (member_vars[j] == var_id && members[j].type == member.type)
+				member.plane++;
+
+		for (auto &dim : mbr_type.array)
+			member.count *= dim;
+		if (!mbr_type.array.empty() && member.count == 0)
+			member.count = get_resource_array_size(var_id);
+
+		if (member.type == MSL_ARGUMENT_BUFFER_MEMBER_INLINE_UNIFORM_BLOCK)
+		{
+			member.size = get_declared_struct_size_msl(mbr_type);
+			member.alignment = get_declared_type_alignment_msl(mbr_type, false, false);
+		}
+		else
+		{
+			member.size = 8 * member.count;
+			member.alignment = 8;
+		}
+
+		members.push_back(member);
+		member_vars.push_back(var_id);
+	}
+
+	layout_argument_buffer_members(members);
+	return members;
+}
+
+SmallVector<MSLArgumentBufferMember> CompilerMSL::merge_argument_buffer_layouts(const CompilerMSL *const *compilers,
+                                                                              size_t num_compilers, uint32_t desc_set)
+{
+	SmallVector<MSLArgumentBufferMember> merged;
+
+	for (size_t i = 0; i < num_compilers; i++)
+	{
+		for (auto &member : compilers[i]->get_argument_buffer_layout(desc_set))
+		{
+			auto itr = find_if(begin(merged), end(merged), [&](const MSLArgumentBufferMember &m) {
+				return m.binding == member.binding && m.type == member.type && m.plane == member.plane;
+			});
+
+			if (itr == end(merged))
+			{
+				for (auto &m : merged)
+					if (m.msl_id == member.msl_id)
+						SPIRV_CROSS_THROW(join("Argument buffer ", desc_set, " uses [[id(", member.msl_id,
+						                       ")]] for different resources across stages."));
+				merged.push_back(member);
+			}
+			else if (itr->msl_id != member.msl_id || itr->count != member.count || itr->size != member.size)
+			{
+				SPIRV_CROSS_THROW(join("Binding ", member.binding, " of argument buffer ", desc_set,
+				                       " has a different layout across stages."));
+			}
+			else
+				itr->stage_mask |= member.stage_mask;
+		}
+	}
+
+	layout_argument_buffer_members(merged);
+	return merged;
+}
+
+static void hash_msl_shader_input(Hasher &hasher, const MSLShaderInput &input)
+{
+	hasher.u32(input.location);
+	hasher.u32(input.format);
+	hasher.u32(input.builtin);
+	hasher.u32(input.vecsize);
+}
+
+static void hash_msl_constexpr_sampler(Hasher &hasher, const MSLConstexprSampler &sampler)
+{
+	hasher.u32(sampler.coord);
+	hasher.u32(sampler.min_filter);
+	hasher.u32(sampler.mag_filter);
+	hasher.u32(sampler.mip_filter);
+	hasher.u32(sampler.s_address);
+	hasher.u32(sampler.t_address);
+	hasher.u32(sampler.r_address);
+	hasher.u32(sampler.compare_func);
+	hasher.u32(sampler.border_color);
+	uint32_t lod_bits[2];
+	memcpy(lod_bits, &sampler.lod_clamp_min, sizeof(float));
+	memcpy(lod_bits + 1, &sampler.lod_clamp_max, sizeof(float));
+	hasher.u32(lod_bits[0]);
+	hasher.u32(lod_bits[1]);
+	hasher.u32(uint32_t(sampler.max_anisotropy));
+	hasher.u32(sampler.planes);
+	hasher.u32(sampler.resolution);
+	hasher.u32(sampler.chroma_filter);
+	hasher.u32(sampler.x_chroma_offset);
+	hasher.u32(sampler.y_chroma_offset);
+	for (auto &swiz : sampler.swizzle)
+		hasher.u32(swiz);
+	hasher.u32(sampler.ycbcr_model);
+	hasher.u32(sampler.ycbcr_range);
+	hasher.u32(sampler.bpc);
+	hasher.u32(sampler.compare_enable);
+	hasher.u32(sampler.lod_clamp_enable);
+	hasher.u32(sampler.anisotropy_enable);
+	hasher.u32(sampler.ycbcr_conversion_enable);
+}
+
+void CompilerMSL::reset_module_state()
+{
+	function_global_vars.clear();
+
+	builtin_frag_coord_id = 0;
+	builtin_sample_id_id = 0;
+	builtin_sample_mask_id = 0;
+	builtin_vertex_idx_id = 0;
+	builtin_base_vertex_id = 0;
+	builtin_instance_idx_id = 0;
+	builtin_base_instance_id = 0;
+	builtin_view_idx_id = 0;
+	builtin_layer_id = 0;
+	builtin_invocation_id_id = 0;
+	builtin_primitive_id_id = 0;
+	builtin_subgroup_invocation_id_id = 0;
+	builtin_subgroup_size_id = 0;
+	builtin_dispatch_base_id = 0;
+	builtin_stage_input_size_id = 0;
+	builtin_local_invocation_index_id = 0;
+	builtin_workgroup_size_id = 0;
+	swizzle_buffer_id = 0;
+	buffer_size_buffer_id = 0;
+	view_mask_buffer_id = 0;
+	dynamic_offsets_buffer_id = 0;
+	uint_type_id = 0;
+	does_shader_write_sample_mask = false;
+
+	spv_function_implementations.clear();
+	inputs_by_location.clear();
+	inputs_by_builtin.clear();
+	inputs_in_use.clear();
+	fragment_output_components.clear();
+	pragma_lines.clear();
+	typedef_lines.clear();
+	vars_needing_early_declaration.clear();
+	resource_bindings.clear();
+	resource_binding_index.clear();
+
+	next_metal_resource_index_buffer = 0;
+	next_metal_resource_index_texture = 0;
+	next_metal_resource_index_sampler = 0;
+	for (auto &id : next_metal_resource_ids)
+		id = 0;
+
+	stage_in_var_id = 0;
+	stage_out_var_id = 0;
+	patch_stage_in_var_id = 0;
+	patch_stage_out_var_id = 0;
+	stage_in_ptr_var_id = 0;
+	stage_out_ptr_var_id = 0;
+	needs_base_vertex_arg = TriState::Neutral;
+	needs_base_instance_arg = TriState::Neutral;
+
+	has_sampled_images = false;
+	builtin_declaration = false;
+	is_using_builtin_array = false;
+	is_rasterization_disabled = false;
+	capture_output_to_buffer = false;
+	needs_swizzle_buffer_def = false;
+	used_swizzle_buffer = false;
+	added_builtin_tess_level = false;
+	needs_subgroup_invocation_id = false;
+	needs_subgroup_size = false;
+	needs_sample_id = false;
+
+	// The combined sampler suffix is a naming preference and is kept.
+	qual_pos_var_name.clear();
+	stage_in_var_name = "in";
+	stage_out_var_name = "out";
+	patch_stage_in_var_name = "patchIn";
+	patch_stage_out_var_name = "patchOut";
+	swizzle_name_suffix = "Swzl";
+	buffer_size_name_suffix = "BufferSize";
+	plane_name_suffix = "Plane";
+	input_wg_var_name = "gl_in";
+	input_buffer_var_name = "spvIn";
+	output_buffer_var_name = "spvOut";
+	patch_output_buffer_var_name = "spvPatchOut";
+	tess_factor_buffer_var_name = "spvTessLevel";
+	index_buffer_var_name = "spvIndices";
+	previous_instruction_opcode = OpNop;
+
+	constexpr_samplers_by_id.clear();
+	constexpr_samplers_by_binding.clear();
+	buffers_requiring_array_length.clear();
+	buffer_arrays.clear();
+	atomic_image_vars.clear();
+	pull_model_inputs.clear();
+	buffers_requiring_dynamic_offset.clear();
+	disabled_frag_outputs.clear();
+	inline_uniform_blocks.clear();
+
+	for (auto &id : argument_buffer_ids)
+		id = 0;
+	argument_buffer_discrete_mask = 0;
+	argument_buffer_device_storage_mask = 0;
+	suppress_missing_prototypes = false;
+
+	CompilerGLSL::reset_module_state();
+}
+
+void CompilerMSL::hash_compile_state(Hasher &hasher) const
+{
+	CompilerGLSL::hash_compile_state(hasher);
+	hasher.string("msl");
+
+	hasher.u32(msl_options.platform);
+	hasher.u32(msl_options.msl_version);
+	hasher.u32(msl_options.texel_buffer_texture_width);
+	hasher.u32(msl_options.r32ui_linear_texture_alignment);
+	hasher.u32(msl_options.r32ui_alignment_constant_id);
+	hasher.u32(msl_options.swizzle_buffer_index);
+	hasher.u32(msl_options.indirect_params_buffer_index);
+	hasher.u32(msl_options.shader_output_buffer_index);
+	hasher.u32(msl_options.shader_patch_output_buffer_index);
+	hasher.u32(msl_options.shader_tess_factor_buffer_index);
+	hasher.u32(msl_options.buffer_size_buffer_index);
+	hasher.u32(msl_options.view_mask_buffer_index);
+	hasher.u32(msl_options.dynamic_offsets_buffer_index);
+	hasher.u32(msl_options.shader_input_buffer_index);
+	hasher.u32(msl_options.vertex_buffer_index_base);
+	hasher.u32(msl_options.vertex_attribute_buffer_index);
+	hasher.u32(msl_options.shader_index_buffer_index);
+	hasher.u32(msl_options.shader_input_wg_index);
+	hasher.u32(msl_options.device_index);
+	hasher.u32(msl_options.enable_frag_output_mask);
+	hasher.u32(msl_options.additional_fixed_sample_mask);
+	hasher.u32(msl_options.enable_point_size_builtin);
+	hasher.u32(msl_options.enable_frag_depth_builtin);
+	hasher.u32(msl_options.enable_frag_stencil_ref_builtin);
+	hasher.u32(msl_options.disable_rasterization);
+	hasher.u32(msl_options.capture_output_to_buffer);
+	hasher.u32(msl_options.swizzle_texture_samples);
+	hasher.u32(msl_options.tess_domain_origin_lower_left);
+	hasher.u32(msl_options.multiview);
+	hasher.u32(msl_options.multiview_layered_rendering);
+	hasher.u32(msl_options.view_index_from_device_index);
+	hasher.u32(msl_options.dispatch_base);
+	hasher.u32(msl_options.texture_1D_as_2D);
+	hasher.u32(msl_options.argument_buffers);
+	hasher.u32(msl_options.enable_base_index_zero);
+	hasher.u32(msl_options.pad_fragment_output_components);
+	hasher.u32(msl_options.ios_support_base_vertex_instance);
+	hasher.u32(msl_options.use_framebuffer_fetch_subpasses);
+	hasher.u32(msl_options.invariant_float_math);
+	hasher.u32(msl_options.emulate_cube_array);
+	hasher.u32(msl_options.enable_decoration_binding);
+	hasher.u32(msl_options.texture_buffer_native);
+	hasher.u32(msl_options.force_active_argument_buffer_resources);
+	hasher.u32(msl_options.force_native_arrays);
+	hasher.u32(msl_options.enable_clip_distance_user_varying);
+	hasher.u32(msl_options.multi_patch_workgroup);
+	hasher.u32(msl_options.vertex_for_tessellation);
+	hasher.u32(msl_options.arrayed_subpass_input);
+	hasher.u32(msl_options.ios_use_simdgroup_functions);
+	hasher.u32(msl_options.emulate_subgroups);
+	hasher.u32(msl_options.fixed_subgroup_size);
+	hasher.u32(uint32_t(msl_options.vertex_index_type));
+	hasher.u32(msl_options.force_sample_rate_shading);
+	hasher.u32(msl_options.use_helper_library);
+	hasher.u32(msl_options.vertex_pulling);
+	hasher.u32(msl_options.stage_tess_control_outputs_in_threadgroup);
+
+	// Unordered containers are hashed by summing up per-entry hashes so iteration order does not matter.
+	hasher.u32(uint32_t(inputs_by_location.size()));
+	for (auto &input : inputs_by_location)
+		hash_msl_shader_input(hasher, input.second);
+
+	uint64_t sum = 0;
+	for (auto &input : inputs_by_builtin)
+	{
+		Hasher h;
+		hash_msl_shader_input(h, input.second);
+		sum += h.get();
+	}
+	hasher.u32(uint32_t(inputs_by_builtin.size()));
+	hasher.u64(sum);
+
+	sum = 0;
+	for (auto &components : fragment_output_components)
+	{
+		Hasher h;
+		h.u32(components.first);
+		h.u32(components.second);
+		sum += h.get();
+	}
+	hasher.u32(uint32_t(fragment_output_components.size()));
+	hasher.u64(sum);
+
+	// The second member of the pair is only written during compilation, so it is ignored.
+	sum = 0;
+	for (auto &binding : resource_bindings)
+	{
+		auto &res = binding.second.first;
+		Hasher h;
+		h.u32(res.stage);
+		h.u32(res.desc_set);
+		h.u32(res.binding);
+		h.u32(res.count);
+		h.u32(res.msl_buffer);
+		h.u32(res.msl_texture);
+		h.u32(res.msl_sampler);
+		sum += h.get();
+	}
+	hasher.u32(uint32_t(resource_bindings.size()));
+	hasher.u64(sum);
+
+	hasher.u32(uint32_t(constexpr_samplers_by_id.size()));
+	for (auto &sampler : constexpr_samplers_by_id)
+	{
+		hasher.u32(sampler.first);
+		hash_msl_constexpr_sampler(hasher, sampler.second);
+	}
+
+	sum = 0;
+	for (auto &sampler : constexpr_samplers_by_binding)
+	{
+		Hasher h;
+		h.u32(sampler.first.desc_set);
+		h.u32(sampler.first.binding);
+		hash_msl_constexpr_sampler(h, sampler.second);
+		sum += h.get();
+	}
+	hasher.u32(uint32_t(constexpr_samplers_by_binding.size()));
+	hasher.u64(sum);
+
+	hasher.u32(uint32_t(buffers_requiring_dynamic_offset.size()));
+	for (auto &dynamic : buffers_requiring_dynamic_offset)
+	{
+		hasher.u32(dynamic.first.desc_set);
+		hasher.u32(dynamic.first.binding);
+		hasher.u32(dynamic.second.first);
+	}
+
+	sum = 0;
+	for (auto &block : inline_uniform_blocks)
+	{
+		Hasher h;
+		h.u32(block.desc_set);
+		h.u32(block.binding);
+		sum += h.get();
+	}
+	hasher.u32(uint32_t(inline_uniform_blocks.size()));
+	hasher.u64(sum);
+
+	hasher.u32(argument_buffer_discrete_mask);
+	hasher.u32(argument_buffer_device_storage_mask);
+	hasher.string(sampler_name_suffix);
+	hasher.string(helper_library_include);
+}
@@ -88,6 +88,41 @@ struct MSLResourceBinding
 	uint32_t msl_sampler = 0;
 };
 
+// The kind of resource held by a member of an MSL argument buffer.
+enum MSLArgumentBufferMemberType
+{
+	MSL_ARGUMENT_BUFFER_MEMBER_BUFFER = 0,
+	MSL_ARGUMENT_BUFFER_MEMBER_TEXTURE = 1,
+	MSL_ARGUMENT_BUFFER_MEMBER_SAMPLER = 2,
+	MSL_ARGUMENT_BUFFER_MEMBER_INLINE_UNIFORM_BLOCK = 3,
+	MSL_ARGUMENT_BUFFER_MEMBER_INT_MAX = 0x7fffffff
+};
+
+// Describes one [[id(N)]] member of the argument buffer generated for a descriptor set.
+// desc_set and binding are the SPIR-V descriptor set and binding of the resource. The implicit buffers holding
+// swizzle constants and buffer sizes use kSwizzleBufferBinding and kBufferSizeBufferBinding as binding.
+// plane is the plane index of multiplanar Y'CbCr textures, and 0 otherwise.
+// A binding can produce several members, e.g. a combined image sampler has a texture and a sampler member,
+// and an image using emulated atomics also has a buffer member.
+// count is the array size of the member, and is 1 for non-arrays.
+// offset, size and alignment are in bytes, and describe the structure as declared in MSL, where every buffer,
+// texture and sampler is a 64-bit handle, and inline uniform blocks are embedded directly.
+// This matches the layout of argument buffers written directly by the CPU, e.g. with Metal 3.
+// stage_mask has bit (1 << ExecutionModel) set for every stage which declares the member.
+struct MSLArgumentBufferMember
+{
+	uint32_t desc_set = 0;
+	uint32_t binding = 0;
+	uint32_t plane = 0;
+	MSLArgumentBufferMemberType type = MSL_ARGUMENT_BUFFER_MEMBER_BUFFER;
+	uint32_t msl_id = 0;
+	uint32_t count = 1;
+	uint32_t offset = 0;
+	uint32_t size = 0;
+	uint32_t alignment = 0;
+	uint32_t stage_mask = 0;
+};
+
 enum MSLSamplerCoord
 {
 	MSL_SAMPLER_COORD_NORMALIZED = 0,
@@ -413,6 +448,33 @@ public:
 		// the extra threads away.
 		bool force_sample_rate_shading = false;
 
+		// If set, helper functions and templates such as spvTextureSwizzle or spvUnsafeArray are not emitted
+		// into the shader. Instead, the shader includes a shared helper library, see set_helper_library_include()
+		// and compile_helper_library().
+		bool use_helper_library = false;
+
+		// If set, vertex shader inputs are not declared as a [[stage_in]] struct, so no MTLVertexDescriptor is needed.
+		// Instead, the shader loads each input with location L from the buffer
+		// [[buffer(vertex_buffer_index_base + L)]] itself. The data is read in the type declared for the input,
+		// which can be adjusted with add_msl_shader_input(), with the components packed tightly.
+		// The offset, stride and step rate of every input are read at runtime from an array of spvVertexAttribute,
+		// indexed by location, in [[buffer(vertex_attribute_buffer_index)]], so one pipeline works with any
+		// vertex buffer layout. If instance_divisor is 0, the input is indexed per vertex, otherwise per instance.
+		// Interleaved attributes can be supported by binding the same buffer at several indices.
+		// These indices are skipped when buffer indices are assigned automatically to other resources,
+		// and vertex_buffer_index_base + L must not exceed 30.
+		// Not supported together with vertex_for_tessellation.
+		bool vertex_pulling = false;
+		uint32_t vertex_buffer_index_base = 0;
+		uint32_t vertex_attribute_buffer_index = 20;
+
+		// If set, a tessellation control shader keeps the per-vertex outputs of its patch in threadgroup memory,
+		// and each invocation writes its control point to the output buffer once, when it returns.
+		// Patch outputs and tessellation levels are still written to device memory directly.
+		// The amount of threadgroup memory used is reported by get_tess_control_output_staging_size().
+		// Not supported together with multi_patch_workgroup.
+		bool stage_tess_control_outputs_in_threadgroup = false;
+
 		bool is_ios() const
 		{
 			return platform == iOS;
@@ -524,6 +586,9 @@ public:
 	// the set/binding combination was used by the MSL code.
 	void add_msl_resource_binding(const MSLResourceBinding &resource);
 
+	// Adds a whole table of resource bindings at once, as if add_msl_resource_binding() was called for each of them.
+	void add_msl_resource_bindings(const MSLResourceBinding *resources, size_t count);
+
 	// desc_set and binding are the SPIR-V descriptor set and binding of a buffer resource
 	// in this shader. index is the index within the dynamic offset buffer to use. This
 	// function marks that resource as using a dynamic offset (VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC
@@ -565,6 +630,12 @@ public:
 	// If no binding exists, uint32_t(-1) is returned.
 	uint32_t get_automatic_msl_resource_binding(uint32_t id) const;
 
+	// This must only be called after a successful call to CompilerMSL::compile().
+	// If Options::stage_tess_control_outputs_in_threadgroup is set, returns the number of bytes of threadgroup memory
+	// the kernel declares to hold the control points of a patch, in addition to the threadgroup memory of gl_in.
+	// Otherwise, returns 0.
+	uint32_t get_tess_control_output_staging_size() const;
+
 	// Same as get_automatic_msl_resource_binding, but should only be used for combined image samplers, in which case the
 	// sampler's binding is returned instead. For any other resource type, -1 is returned.
 	uint32_t get_automatic_msl_resource_binding_secondary(uint32_t id) const;
@@ -600,6 +671,33 @@ public:
 	void set_combined_sampler_suffix(const char *suffix);
 	const char *get_combined_sampler_suffix() const;
 
+	// With Options::use_helper_library, the name of the header shaders include to obtain the helpers.
+	// The default is "spirv_cross_msl_helpers.h".
+	void set_helper_library_include(const char *name);
+	const char *get_helper_library_include() const;
+
+	// Adds the helpers required by another compiler, typically one which has compiled a shader with
+	// Options::use_helper_library, to the helpers this compiler emits with compile_helper_library().
+	void add_helper_library_requirements(const CompilerMSL &other);
+
+	// Emits the helper library header, containing every helper required by the last compile() of this compiler
+	// and all compilers added with add_helper_library_requirements().
+	// The helpers are tailored to the MSL options of this compiler, which should match those of the shaders.
+	std::string compile_helper_library();
+
+	// Query after compilation. Returns the members of the argument buffer generated for desc_set,
+	// sorted by [[id(N)]]. The list is empty if desc_set is not used as an argument buffer by this shader.
+	SmallVector<MSLArgumentBufferMember> get_argument_buffer_layout(uint32_t desc_set) const;
+
+	// Merges the argument buffer layouts for desc_set of several compiled shaders, typically every stage of a pipeline,
+	// into one layout which can be encoded once and shared by all of them.
+	// A member declared by several stages must have the same [[id(N)]], count and size in each of them,
+	// and different members must not share an [[id(N)]]. Otherwise, an exception is thrown.
+	// To keep the layout stable, supply explicit [[id(N)]] values with add_msl_resource_binding() for every stage.
+	// Shaders only declare the resources they use, unless Options::force_active_argument_buffer_resources is set.
+	static SmallVector<MSLArgumentBufferMember> merge_argument_buffer_layouts(const CompilerMSL *const *compilers,
+	                                                                          size_t num_compilers, uint32_t desc_set);
+
 protected:
 	// An enum of SPIR-V functions that are implemented in additional
 	// source code that is added to the shader if necessary.
@@ -797,9 +895,11 @@ protected:
 
 	void emit_custom_templates();
 	void emit_custom_functions();
+	void add_dependent_spv_functions();
 	void emit_resources();
 	void emit_specialization_constants_and_structs();
 	void emit_interface_block(uint32_t ib_var_id);
+	void emit_vertex_input_loads(uint32_t ib_var_id);
 	bool maybe_emit_array_assignment(uint32_t id_lhs, uint32_t id_rhs);
 	uint32_t get_resource_array_size(uint32_t id) const;
 
@@ -908,8 +1008,6 @@ protected:
 	void cast_from_builtin_load(uint32_t source_id, std::string &expr, const SPIRType &expr_type) override;
 	void emit_store_statement(uint32_t lhs_expression, uint32_t rhs_expression) override;
 
-	void analyze_sampled_image_usage();
-
 	void prepare_access_chain_for_scalar_access(std::string &expr, const SPIRType &type, spv::StorageClass storage,
 	                                            bool &is_packed) override;
 	void fix_up_interpolant_access_chain(const uint32_t *ops, uint32_t length);
@@ -936,9 +1034,26 @@ protected:
 
 	std::unordered_map<StageSetBinding, std::pair<MSLResourceBinding, bool>, InternalHasher> resource_bindings;
 
+	// Resolves resource_bindings once per variable at the start of compile(),
+	// since every resource is looked up several times while emitting the entry point.
+	struct ResourceBindingIndexEntry
+	{
+		uint32_t desc_set = 0;
+		uint32_t binding = 0;
+		std::pair<MSLResourceBinding, bool> *remap = nullptr;
+		bool valid = false;
+	};
+	SmallVector<ResourceBindingIndexEntry> resource_binding_index;
+	void build_resource_binding_index();
+	std::pair<MSLResourceBinding, bool> *find_resource_binding(uint32_t id, uint32_t desc_set, uint32_t binding);
+
 	uint32_t next_metal_resource_index_buffer = 0;
 	uint32_t next_metal_resource_index_texture = 0;
 	uint32_t next_metal_resource_index_sampler = 0;
+	// Buffer indices taken by the vertex buffers and the attribute buffer when pulling vertices.
+	Bitset reserved_buffer_indices;
+	void reserve_vertex_pulling_buffer_indices();
+	uint32_t get_next_unreserved_buffer_index(uint32_t index, uint32_t count) const;
 	// Intentionally uninitialized, works around MSVC 2013 bug.
 	uint32_t next_metal_resource_ids[kMaxArgumentBuffers];
 
@@ -979,10 +1094,13 @@ protected:
 	std::string patch_stage_in_var_name = "patchIn";
 	std::string patch_stage_out_var_name = "patchOut";
 	std::string sampler_name_suffix = "Smplr";
+	std::string helper_library_include = "spirv_cross_msl_helpers.h";
 	std::string swizzle_name_suffix = "Swzl";
 	std::string buffer_size_name_suffix = "BufferSize";
 	std::string plane_name_suffix = "Plane";
 	std::string input_wg_var_name = "gl_in";
+	std::string vertex_buffer_var_name = "spvVertexBuffer";
+	std::string vertex_attributes_var_name = "spvVertexAttributes";
 	std::string input_buffer_var_name = "spvIn";
 	std::string output_buffer_var_name = "spvOut";
 	std::string patch_output_buffer_var_name = "spvPatchOut";
@@ -1026,6 +1144,9 @@ protected:
 	void activate_argument_buffer_resources();
 
 	bool type_is_msl_framebuffer_fetch(const SPIRType &type) const;
+
+	void hash_compile_state(Hasher &hasher) const override;
+	void reset_module_state() override;
 	bool is_supported_argument_buffer_type(const SPIRType &type) const;
 
 	// OpcodeHandler that handles several MSL preprocessing operations.
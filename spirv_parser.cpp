@@ -23,6 +23,25 @@
 
 #include "spirv_parser.hpp"
 #include <assert.h>
+#include <stdio.h>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPIRV_CROSS_HAS_MMAP
+#else
+#include <stdlib.h>
+#endif
 
 using namespace std;
 using namespace spv;
@@ -39,6 +58,148 @@ Parser::Parser(const uint32_t *spirv_data, size_t word_count)
 	ir.spirv = vector<uint32_t>(spirv_data, spirv_data + word_count);
 }
 
+Parser::Parser(SPIRVWordBuffer spirv)
+{
+	ir.spirv = move(spirv);
+}
+
+namespace
+{
+// Keeps a mapped file region alive for as long as any SPIRVWordBuffer refers to it.
+struct MappedRegion
+{
+	void *base = nullptr;
+	size_t size = 0;
+#if defined(_WIN32)
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#endif
+
+	MappedRegion() = default;
+	MappedRegion(const MappedRegion &) = delete;
+	void operator=(const MappedRegion &) = delete;
+
+	~MappedRegion()
+	{
+#if defined(_WIN32)
+		if (base)
+			UnmapViewOfFile(base);
+		if (mapping)
+			CloseHandle(mapping);
+		if (file != INVALID_HANDLE_VALUE)
+			CloseHandle(file);
+#elif defined(SPIRV_CROSS_HAS_MMAP)
+		if (base)
+			munmap(base, size);
+#else
+		free(base);
+#endif
+	}
+};
+} // namespace
+
+SPIRVWordBuffer Parser::map_file(const string &path, size_t offset, size_t size)
+{
+	if (offset % sizeof(uint32_t))
+		SPIRV_CROSS_THROW("SPIR-V file region must be aligned to 4 bytes.");
+
+	auto region = make_shared<MappedRegion>();
+	size_t file_size = 0;
+	size_t page_offset = 0;
+
+#if defined(_WIN32)
+	region->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	                           FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (region->file == INVALID_HANDLE_VALUE)
+		SPIRV_CROSS_THROW("Failed to open SPIR-V file.");
+
+	LARGE_INTEGER large_size;
+	if (!GetFileSizeEx(region->file, &large_size))
+		SPIRV_CROSS_THROW("Failed to query size of SPIR-V file.");
+	file_size = size_t(large_size.QuadPart);
+#elif defined(SPIRV_CROSS_HAS_MMAP)
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		SPIRV_CROSS_THROW("Failed to open SPIR-V file.");
+
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+	{
+		close(fd);
+		SPIRV_CROSS_THROW("Failed to query size of SPIR-V file.");
+	}
+	file_size = size_t(st.st_size);
+#else
+	FILE *file = fopen(path.c_str(), "rb");
+	if (!file)
+		SPIRV_CROSS_THROW("Failed to open SPIR-V file.");
+
+	fseek(file, 0, SEEK_END);
+	long end_offset = ftell(file);
+	if (end_offset < 0)
+	{
+		fclose(file);
+		SPIRV_CROSS_THROW("Failed to query size of SPIR-V file.");
+	}
+	file_size = size_t(end_offset);
+#endif
+
+	bool valid_region = offset <= file_size;
+	if (valid_region)
+	{
+		if (size == 0)
+			size = file_size - offset;
+		valid_region = size <= file_size - offset && size % sizeof(uint32_t) == 0 && size != 0;
+	}
+
+	if (!valid_region)
+	{
+#if defined(SPIRV_CROSS_HAS_MMAP)
+		close(fd);
+#elif !defined(_WIN32)
+		fclose(file);
+#endif
+		SPIRV_CROSS_THROW("SPIR-V file region is out of range or not a multiple of 4 bytes.");
+	}
+
+#if defined(_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	page_offset = offset % info.dwAllocationGranularity;
+
+	region->mapping = CreateFileMappingA(region->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!region->mapping)
+		SPIRV_CROSS_THROW("Failed to map SPIR-V file.");
+
+	uint64_t map_offset = uint64_t(offset - page_offset);
+	region->size = size + page_offset;
+	region->base = MapViewOfFile(region->mapping, FILE_MAP_READ, DWORD(map_offset >> 32), DWORD(map_offset),
+	                             region->size);
+	if (!region->base)
+		SPIRV_CROSS_THROW("Failed to map SPIR-V file.");
+#elif defined(SPIRV_CROSS_HAS_MMAP)
+	page_offset = offset % size_t(sysconf(_SC_PAGESIZE));
+	region->size = size + page_offset;
+	void *base = mmap(nullptr, region->size, PROT_READ, MAP_PRIVATE, fd, off_t(offset - page_offset));
+	close(fd);
+	if (base == MAP_FAILED)
+		SPIRV_CROSS_THROW("Failed to map SPIR-V file.");
+	region->base = base;
+#else
+	// No memory mapping available, fall back to reading the region into memory.
+	region->size = size;
+	region->base = malloc(size);
+	bool read_ok = region->base && fseek(file, long(offset), SEEK_SET) == 0 &&
+	               fread(region->base, 1, size, file) == size;
+	fclose(file);
+	if (!read_ok)
+		SPIRV_CROSS_THROW("Failed to read SPIR-V file.");
+#endif
+
+	auto *words = reinterpret_cast<const uint32_t *>(static_cast<const uint8_t *>(region->base) + page_offset);
+	return SPIRVWordBuffer::borrow(words, size / sizeof(uint32_t), move(region));
+}
+
 static bool decoration_is_string(Decoration decoration)
 {
 	switch (decoration)
@@ -77,17 +238,22 @@ static bool is_valid_spirv_version(uint32_t version)
 
 void Parser::parse()
 {
-	auto &spirv = ir.spirv;
+	SPIRV_CROSS_TRACE_SCOPE(trace_callback, TraceEventParse, 0);
 
-	auto len = spirv.size();
+	auto len = ir.spirv.size();
 	if (len < 5)
 		SPIRV_CROSS_THROW("SPIRV file too small.");
 
-	auto s = spirv.data();
+	// Endian-swap if we need to. This is the only case where the words are modified,
+	// so borrowed words are only copied here.
+	if (ir.spirv[0] == swap_endian(MagicNumber))
+	{
+		auto &words = ir.spirv.get_mutable();
+		transform(begin(words), end(words), begin(words), [](uint32_t c) { return swap_endian(c); });
+	}
 
-	// Endian-swap if we need to.
-	if (s[0] == swap_endian(MagicNumber))
-		transform(begin(spirv), end(spirv), begin(spirv), [](uint32_t c) { return swap_endian(c); });
+	const auto &spirv = ir.spirv;
+	auto s = spirv.data();
 
 	if (s[0] != MagicNumber || !is_valid_spirv_version(s[1]))
 		SPIRV_CROSS_THROW("Invalid SPIRV format.");
@@ -100,9 +266,19 @@ void Parser::parse()
 
 	ir.set_id_bounds(bound);
 
+	// Count the instructions first, so the instruction list is allocated once.
+	size_t instruction_count = 0;
+	for (size_t offset = 5; offset < len; offset += (spirv[offset] >> 16) & 0xffff)
+	{
+		if (((spirv[offset] >> 16) & 0xffff) == 0)
+			SPIRV_CROSS_THROW("SPIR-V instructions cannot consume 0 words. Invalid SPIR-V file.");
+		instruction_count++;
+	}
+
 	uint32_t offset = 5;
 
 	SmallVector<Instruction> instructions;
+	instructions.reserve(instruction_count);
 	while (offset < len)
 	{
 		Instruction instr = {};
@@ -123,9 +299,18 @@ void Parser::parse()
 		instructions.push_back(instr);
 	}
 
+	if (!entry_point_filter.empty())
+		filter_instructions(instructions);
+
+	presize(instructions);
 	for (auto &i : instructions)
 		parse(i);
 
+	function_sizes.clear();
+	block_sizes.clear();
+	next_function_size = 0;
+	next_block_size = 0;
+
 	for (auto &fixup : forward_pointer_fixups)
 	{
 		auto &target = get<SPIRType>(fixup.first);
@@ -142,6 +327,127 @@ void Parser::parse()
 		SPIRV_CROSS_THROW("Block was not terminated.");
 }
 
+void Parser::presize(const SmallVector<Instruction> &instructions)
+{
+	size_t counts[TypeCount] = {};
+	bool in_function = false;
+	bool in_block = false;
+
+	function_sizes.clear();
+	block_sizes.clear();
+	next_function_size = 0;
+	next_block_size = 0;
+
+	for (auto &i : instructions)
+	{
+		auto op = static_cast<Op>(i.op);
+		switch (op)
+		{
+		case OpTypeVoid:
+		case OpTypeBool:
+		case OpTypeInt:
+		case OpTypeFloat:
+		case OpTypeVector:
+		case OpTypeMatrix:
+		case OpTypeImage:
+		case OpTypeSampler:
+		case OpTypeSampledImage:
+		case OpTypeArray:
+		case OpTypeRuntimeArray:
+		case OpTypeStruct:
+		case OpTypePointer:
+		case OpTypeForwardPointer:
+		case OpTypeAccelerationStructureKHR:
+		case OpTypeRayQueryKHR:
+			counts[TypeType]++;
+			break;
+
+		case OpTypeFunction:
+			counts[TypeFunctionPrototype]++;
+			break;
+
+		case OpConstant:
+		case OpConstantTrue:
+		case OpConstantFalse:
+		case OpConstantComposite:
+		case OpConstantNull:
+		case OpSpecConstant:
+		case OpSpecConstantTrue:
+		case OpSpecConstantFalse:
+		case OpSpecConstantComposite:
+			counts[TypeConstant]++;
+			break;
+
+		case OpSpecConstantOp:
+			counts[TypeConstantOp]++;
+			break;
+
+		case OpUndef:
+			counts[TypeUndef]++;
+			break;
+
+		case OpString:
+			counts[TypeString]++;
+			break;
+
+		case OpExtInstImport:
+			counts[TypeExtension]++;
+			break;
+
+		case OpFunction:
+			counts[TypeFunction]++;
+			function_sizes.emplace_back();
+			in_function = true;
+			break;
+
+		case OpFunctionEnd:
+			in_function = false;
+			in_block = false;
+			break;
+
+		case OpLabel:
+			counts[TypeBlock]++;
+			if (in_function)
+				function_sizes.back().blocks++;
+			block_sizes.push_back(0);
+			in_block = true;
+			break;
+
+		case OpFunctionParameter:
+			counts[TypeVariable]++;
+			break;
+
+		case OpVariable:
+		case OpPhi:
+			counts[TypeVariable]++;
+			if (in_function)
+				function_sizes.back().variables++;
+			if (in_block)
+				block_sizes.back()++;
+			break;
+
+		default:
+			// Counting every other instruction of a block, including the terminator,
+			// gives an upper bound for the block's ops.
+			if (in_block)
+				block_sizes.back()++;
+			break;
+		}
+	}
+
+	size_t constant_or_type = counts[TypeType] + counts[TypeConstant] + counts[TypeConstantOp];
+	size_t constant_or_variable = counts[TypeConstant] + counts[TypeVariable];
+	for (uint32_t type = 0; type < TypeCount; type++)
+	{
+		if (type == TypeNone || counts[type] == 0)
+			continue;
+		ir.reserve_objects(static_cast<Types>(type), counts[type]);
+		ir.ids_for_type[type].reserve(ir.ids_for_type[type].size() + counts[type]);
+	}
+	ir.ids_for_constant_or_type.reserve(ir.ids_for_constant_or_type.size() + constant_or_type);
+	ir.ids_for_constant_or_variable.reserve(ir.ids_for_constant_or_variable.size() + constant_or_variable);
+}
+
 const uint32_t *Parser::stream(const Instruction &instr) const
 {
 	// If we're not going to use any arguments, just return nullptr.
@@ -155,7 +461,7 @@ const uint32_t *Parser::stream(const Instruction &instr) const
 	return &ir.spirv[instr.offset];
 }
 
-static string extract_string(const vector<uint32_t> &spirv, uint32_t offset)
+static string extract_string(const SPIRVWordBuffer &spirv, uint32_t offset)
 {
 	string ret;
 	for (uint32_t i = offset; i < spirv.size(); i++)
@@ -174,6 +480,108 @@ static string extract_string(const vector<uint32_t> &spirv, uint32_t offset)
 	SPIRV_CROSS_THROW("String was not terminated before EOF");
 }
 
+void Parser::filter_instructions(SmallVector<Instruction> &instructions)
+{
+	struct FunctionRange
+	{
+		size_t begin = 0;
+		size_t end = 0;
+		SmallVector<uint32_t> callees;
+	};
+
+	// Record where each function body starts and ends, and which functions it calls.
+	unordered_map<uint32_t, FunctionRange> functions;
+	FunctionRange *current = nullptr;
+	uint32_t entry_function = 0;
+
+	for (size_t i = 0; i < instructions.size(); i++)
+	{
+		auto &instr = instructions[i];
+		auto *ops = stream(instr);
+
+		switch (static_cast<Op>(instr.op))
+		{
+		case OpEntryPoint:
+			if (instr.length >= 2 && static_cast<ExecutionModel>(ops[0]) == entry_point_filter_model &&
+			    extract_string(ir.spirv, instr.offset + 2) == entry_point_filter)
+				entry_function = ops[1];
+			break;
+
+		case OpFunction:
+			if (instr.length >= 2)
+			{
+				current = &functions[ops[1]];
+				current->begin = i;
+			}
+			break;
+
+		case OpFunctionCall:
+			if (current && instr.length >= 3)
+				current->callees.push_back(ops[2]);
+			break;
+
+		case OpFunctionEnd:
+			if (current)
+				current->end = i;
+			current = nullptr;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	if (!entry_function)
+		SPIRV_CROSS_THROW("Entry point filter does not match any entry point.");
+
+	unordered_set<uint32_t> reachable;
+	SmallVector<uint32_t> pending = { entry_function };
+	while (!pending.empty())
+	{
+		uint32_t func = pending.back();
+		pending.pop_back();
+		if (!reachable.insert(func).second)
+			continue;
+
+		auto itr = functions.find(func);
+		if (itr != end(functions))
+			for (auto callee : itr->second.callees)
+				pending.push_back(callee);
+	}
+
+	SmallVector<bool> skip;
+	skip.resize(instructions.size());
+	for (auto &func : functions)
+		if (!reachable.count(func.first))
+			for (size_t i = func.second.begin; i <= func.second.end; i++)
+				skip[i] = true;
+
+	// Drop the declarations of all other entry points as well, since their functions might not exist.
+	size_t count = 0;
+	for (size_t i = 0; i < instructions.size(); i++)
+	{
+		auto &instr = instructions[i];
+		if (skip[i])
+			continue;
+
+		auto op = static_cast<Op>(instr.op);
+		if (op == OpEntryPoint && instr.length >= 2)
+		{
+			auto *ops = stream(instr);
+			if (ops[1] != entry_function || static_cast<ExecutionModel>(ops[0]) != entry_point_filter_model)
+			{
+				ir.entry_points_filtered = true;
+				continue;
+			}
+		}
+		else if (op == OpExecutionMode && instr.length >= 1 && stream(instr)[0] != entry_function)
+			continue;
+
+		instructions[count++] = instr;
+	}
+	instructions.resize(count);
+}
+
 void Parser::parse(const Instruction &instruction)
 {
 	auto *ops = stream(instruction);
@@ -887,6 +1295,12 @@ void Parser::parse(const Instruction &instruction)
 			SPIRV_CROSS_THROW("Must end a function before starting a new one!");
 
 		current_function = &set<SPIRFunction>(id, res, type);
+		if (next_function_size < function_sizes.size())
+		{
+			auto &size = function_sizes[next_function_size++];
+			current_function->blocks.reserve(size.blocks);
+			current_function->local_variables.reserve(size.variables);
+		}
 		break;
 	}
 
@@ -933,6 +1347,8 @@ void Parser::parse(const Instruction &instruction)
 			SPIRV_CROSS_THROW("Cannot start a block before ending the current block.");
 
 		current_block = &set<SPIRBlock>(id);
+		if (next_block_size < block_sizes.size())
+			current_block->ops.reserve(block_sizes[next_block_size++]);
 		break;
 	}
 
@@ -35,8 +35,35 @@ public:
 	Parser(const uint32_t *spirv_data, size_t word_count);
 	Parser(std::vector<uint32_t> spirv);
 
+	// Parses words which are not owned by the parser without copying them, see SPIRVWordBuffer::borrow().
+	// The resulting ParsedIR refers to the words, so they must outlive it and every Compiler created from it,
+	// unless an owner is attached to the buffer.
+	// If the module has to be endian-swapped, a private copy is made instead.
+	explicit Parser(SPIRVWordBuffer spirv);
+
+	// Maps size bytes starting at byte offset in a file, e.g. one module in a shader archive.
+	// If size is 0, the rest of the file is mapped. The offset and size must be multiples of 4.
+	// The returned buffer keeps the mapping alive and unmaps the file once the last reference is released.
+	static SPIRVWordBuffer map_file(const std::string &path, size_t offset = 0, size_t size = 0);
+
 	void parse();
 
+	// Makes parse() only materialize functions which are reachable from the given entry point,
+	// e.g. for libraries with many entry points and helper functions sharing one module.
+	// Other entry points are left out of the ParsedIR, so set_entry_point() cannot select them later.
+	// parse() throws if the entry point does not exist.
+	void set_entry_point_filter(const std::string &name, spv::ExecutionModel model)
+	{
+		entry_point_filter = name;
+		entry_point_filter_model = model;
+	}
+
+	// Called around parse() if SPIRV-Cross is built with SPIRV_CROSS_ENABLE_TRACING.
+	void set_trace_callback(TraceCallback callback)
+	{
+		trace_callback = std::move(callback);
+	}
+
 	ParsedIR &get_parsed_ir()
 	{
 		return ir;
@@ -44,11 +71,28 @@ public:
 
 private:
 	ParsedIR ir;
+	TraceCallback trace_callback;
+	std::string entry_point_filter;
+	spv::ExecutionModel entry_point_filter_model = spv::ExecutionModelMax;
 	SPIRFunction *current_function = nullptr;
 	SPIRBlock *current_block = nullptr;
 
 	void parse(const Instruction &instr);
 	const uint32_t *stream(const Instruction &instr) const;
+	void filter_instructions(SmallVector<Instruction> &instructions);
+
+	// Counts what parsing the instructions will create, and reserves the object pools and ID lists up front.
+	// The sizes of functions and blocks are filled in in module order, and consumed in the same order by parse().
+	void presize(const SmallVector<Instruction> &instructions);
+	struct FunctionSize
+	{
+		uint32_t blocks = 0;
+		uint32_t variables = 0;
+	};
+	SmallVector<FunctionSize> function_sizes;
+	SmallVector<uint32_t> block_sizes;
+	size_t next_function_size = 0;
+	size_t next_block_size = 0;
 
 	template <typename T, typename... P>
 	T &set(uint32_t id, P &&... args)
@@ -38,232 +38,421 @@ enum class Type
 };
 
 using State = std::pair<Type, bool>;
-using Stack = std::stack<State>;
 
+// Common interface for the JSON and binary writers, so both share the same walk over the module.
+// Output is buffered locally and handed to the sink in large chunks.
 class Stream
 {
-	Stack stack;
-	StringStream<> buffer;
-	uint32_t indent{ 0 };
-	char current_locale_radix_character = '.';
-
 public:
+	explicit Stream(ReflectionSink &sink_)
+	    : sink(sink_)
+	{
+	}
+
+	virtual ~Stream() = default;
+
 	void set_current_locale_radix_character(char c)
 	{
 		current_locale_radix_character = c;
 	}
 
-	void begin_json_object();
-	void end_json_object();
-	void emit_json_key(const std::string &key);
-	void emit_json_key_value(const std::string &key, const std::string &value);
-	void emit_json_key_value(const std::string &key, bool value);
-	void emit_json_key_value(const std::string &key, uint32_t value);
-	void emit_json_key_value(const std::string &key, int32_t value);
-	void emit_json_key_value(const std::string &key, float value);
-	void emit_json_key_object(const std::string &key);
-	void emit_json_key_array(const std::string &key);
+	virtual void begin_json_object() = 0;
+	virtual void end_json_object() = 0;
+	virtual void begin_json_array() = 0;
+	virtual void end_json_array() = 0;
+	virtual void emit_json_key(const char *key, size_t length) = 0;
 
-	void begin_json_array();
-	void end_json_array();
-	void emit_json_array_value(const std::string &value);
-	void emit_json_array_value(uint32_t value);
-	void emit_json_array_value(bool value);
+	void emit_json_key(const char *key)
+	{
+		emit_json_key(key, strlen(key));
+	}
 
-	std::string str() const
+	template <typename T>
+	void emit_json_key_value(const char *key, const T &value)
 	{
-		return buffer.str();
+		emit_json_key(key);
+		emit_value(value);
 	}
 
-private:
-	inline void statement_indent()
+	// Emits a reference to a type, "_<id>".
+	void emit_json_key_type_id(const char *key, uint32_t id)
 	{
-		for (uint32_t i = 0; i < indent; i++)
-			buffer << "    ";
+		emit_json_key(key);
+		char buf[16];
+		emit_value_string(buf, type_id_to_string(buf, id));
+	}
+
+	void emit_json_key_object(const char *key)
+	{
+		emit_json_key(key);
+		begin_json_object();
+	}
+
+	void emit_json_key_type_id_object(uint32_t id)
+	{
+		char buf[16];
+		emit_json_key(buf, type_id_to_string(buf, id));
+		begin_json_object();
+	}
+
+	void emit_json_key_array(const char *key)
+	{
+		emit_json_key(key);
+		begin_json_array();
 	}
 
 	template <typename T>
-	inline void statement_inner(T &&t)
+	void emit_json_array_value(const T &value)
+	{
+		check_state(Type::Array);
+		emit_value(value);
+	}
+
+	void flush()
 	{
-		buffer << std::forward<T>(t);
+		sink.write(buffer, buffer_size);
+		buffer_size = 0;
 	}
 
-	template <typename T, typename... Ts>
-	inline void statement_inner(T &&t, Ts &&... ts)
+protected:
+	virtual void emit_value_string(const char *str, size_t length) = 0;
+	virtual void emit_value(uint32_t value) = 0;
+	virtual void emit_value(int32_t value) = 0;
+	virtual void emit_value(float value) = 0;
+	virtual void emit_value(bool value) = 0;
+
+	void emit_value(const std::string &value)
 	{
-		buffer << std::forward<T>(t);
-		statement_inner(std::forward<Ts>(ts)...);
+		emit_value_string(value.data(), value.size());
 	}
 
-	template <typename... Ts>
-	inline void statement(Ts &&... ts)
+	void emit_value(const char *value)
 	{
-		statement_indent();
-		statement_inner(std::forward<Ts>(ts)...);
-		buffer << '\n';
+		emit_value_string(value, strlen(value));
 	}
 
-	template <typename... Ts>
-	void statement_no_return(Ts &&... ts)
+	void put(const char *data, size_t size)
 	{
-		statement_indent();
-		statement_inner(std::forward<Ts>(ts)...);
+		if (buffer_size + size > sizeof(buffer))
+		{
+			flush();
+			if (size > sizeof(buffer))
+			{
+				sink.write(data, size);
+				return;
+			}
+		}
+		memcpy(buffer + buffer_size, data, size);
+		buffer_size += size;
 	}
-};
-} // namespace simple_json
 
-using namespace simple_json;
+	void put(char c)
+	{
+		if (buffer_size == sizeof(buffer))
+			flush();
+		buffer[buffer_size++] = c;
+	}
+
+	void check_state(Type type) const
+	{
+		if (stack.empty() || stack.back().first != type)
+			SPIRV_CROSS_THROW("Invalid JSON state");
+	}
+
+	static size_t type_id_to_string(char (&buf)[16], uint32_t id)
+	{
+		char digits[10];
+		size_t count = 0;
+		do
+		{
+			digits[count++] = char('0' + id % 10);
+			id /= 10;
+		} while (id);
+
+		buf[0] = '_';
+		for (size_t i = 0; i < count; i++)
+			buf[i + 1] = digits[count - i - 1];
+		return count + 1;
+	}
+
+	SmallVector<State, 8> stack;
+	char current_locale_radix_character = '.';
+
+private:
+	ReflectionSink &sink;
+	char buffer[16 * 1024];
+	size_t buffer_size = 0;
+};
 
 // Hackery to emit JSON without using nlohmann/json C++ library (which requires a
 // higher level of compiler compliance than is required by SPIRV-Cross
-void Stream::begin_json_array()
+class JSONStream : public Stream
 {
-	if (!stack.empty() && stack.top().second)
+public:
+	using Stream::Stream;
+
+	void begin_json_object() override
 	{
-		statement_inner(",\n");
+		begin_value();
+		put("{\n", 2);
+		++indent;
+		stack.push_back({ Type::Object, false });
 	}
-	statement("[");
-	++indent;
-	stack.emplace(Type::Array, false);
-}
 
-void Stream::end_json_array()
-{
-	if (stack.empty() || stack.top().first != Type::Array)
-		SPIRV_CROSS_THROW("Invalid JSON state");
-	if (stack.top().second)
+	void end_json_object() override
 	{
-		statement_inner("\n");
+		end_scope(Type::Object, '}');
 	}
-	--indent;
-	statement_no_return("]");
-	stack.pop();
-	if (!stack.empty())
+
+	void begin_json_array() override
 	{
-		stack.top().second = true;
+		begin_value();
+		put("[\n", 2);
+		++indent;
+		stack.push_back({ Type::Array, false });
 	}
-}
 
-void Stream::emit_json_array_value(const std::string &value)
-{
-	if (stack.empty() || stack.top().first != Type::Array)
-		SPIRV_CROSS_THROW("Invalid JSON state");
+	void end_json_array() override
+	{
+		end_scope(Type::Array, ']');
+	}
 
-	if (stack.top().second)
-		statement_inner(",\n");
+	void emit_json_key(const char *key, size_t length) override
+	{
+		check_state(Type::Object);
+		if (stack.back().second)
+			put(",\n", 2);
+		statement_indent();
+		put('"');
+		put(key, length);
+		put("\" : ", 4);
+		stack.back().second = true;
+		after_key = true;
+	}
 
-	statement_no_return("\"", value, "\"");
-	stack.top().second = true;
-}
+protected:
+	void emit_value_string(const char *str, size_t length) override
+	{
+		begin_value();
+		put('"');
+		put(str, length);
+		put('"');
+	}
 
-void Stream::emit_json_array_value(uint32_t value)
-{
-	if (stack.empty() || stack.top().first != Type::Array)
-		SPIRV_CROSS_THROW("Invalid JSON state");
-	if (stack.top().second)
-		statement_inner(",\n");
-	statement_no_return(std::to_string(value));
-	stack.top().second = true;
-}
+	void emit_value(uint32_t value) override
+	{
+		begin_value();
+		char buf[16];
+		put(buf, size_t(sprintf(buf, "%u", value)));
+	}
 
-void Stream::emit_json_array_value(bool value)
-{
-	if (stack.empty() || stack.top().first != Type::Array)
-		SPIRV_CROSS_THROW("Invalid JSON state");
-	if (stack.top().second)
-		statement_inner(",\n");
-	statement_no_return(value ? "true" : "false");
-	stack.top().second = true;
-}
+	void emit_value(int32_t value) override
+	{
+		begin_value();
+		char buf[16];
+		put(buf, size_t(sprintf(buf, "%d", value)));
+	}
 
-void Stream::begin_json_object()
-{
-	if (!stack.empty() && stack.top().second)
+	void emit_value(float value) override
 	{
-		statement_inner(",\n");
+		begin_value();
+		auto str = convert_to_string(value, current_locale_radix_character);
+		put(str.data(), str.size());
 	}
-	statement("{");
-	++indent;
-	stack.emplace(Type::Object, false);
-}
 
-void Stream::end_json_object()
-{
-	if (stack.empty() || stack.top().first != Type::Object)
-		SPIRV_CROSS_THROW("Invalid JSON state");
-	if (stack.top().second)
+	void emit_value(bool value) override
 	{
-		statement_inner("\n");
+		begin_value();
+		if (value)
+			put("true", 4);
+		else
+			put("false", 5);
 	}
-	--indent;
-	statement_no_return("}");
-	stack.pop();
-	if (!stack.empty())
+
+private:
+	// Values following a key go on the same line, array elements and the top level go on their own.
+	void begin_value()
 	{
-		stack.top().second = true;
+		if (after_key)
+		{
+			after_key = false;
+			return;
+		}
+
+		if (!stack.empty())
+		{
+			if (stack.back().second)
+				put(",\n", 2);
+			stack.back().second = true;
+		}
+		statement_indent();
 	}
-}
 
-void Stream::emit_json_key(const std::string &key)
-{
-	if (stack.empty() || stack.top().first != Type::Object)
-		SPIRV_CROSS_THROW("Invalid JSON state");
+	void end_scope(Type type, char terminator)
+	{
+		check_state(type);
+		if (stack.back().second)
+			put('\n');
+		--indent;
+		statement_indent();
+		put(terminator);
+		stack.pop_back();
+	}
 
-	if (stack.top().second)
-		statement_inner(",\n");
-	statement_no_return("\"", key, "\" : ");
-	stack.top().second = true;
-}
+	void statement_indent()
+	{
+		for (uint32_t i = 0; i < indent; i++)
+			put("    ", 4);
+	}
 
-void Stream::emit_json_key_value(const std::string &key, const std::string &value)
-{
-	emit_json_key(key);
-	statement_inner("\"", value, "\"");
-}
+	uint32_t indent = 0;
+	bool after_key = false;
+};
 
-void Stream::emit_json_key_value(const std::string &key, uint32_t value)
+class BinaryStream : public Stream
 {
-	emit_json_key(key);
-	statement_inner(value);
-}
+public:
+	explicit BinaryStream(ReflectionSink &sink_)
+	    : Stream(sink_)
+	{
+		put("SPVR", 4);
+		put_varint(ReflectionBinaryVersion);
+	}
 
-void Stream::emit_json_key_value(const std::string &key, int32_t value)
-{
-	emit_json_key(key);
-	statement_inner(value);
-}
+	void begin_json_object() override
+	{
+		put(char(TagBeginObject));
+		stack.push_back({ Type::Object, false });
+	}
 
-void Stream::emit_json_key_value(const std::string &key, float value)
-{
-	emit_json_key(key);
-	statement_inner(convert_to_string(value, current_locale_radix_character));
-}
+	void end_json_object() override
+	{
+		check_state(Type::Object);
+		put(char(TagEndObject));
+		stack.pop_back();
+	}
 
-void Stream::emit_json_key_value(const std::string &key, bool value)
-{
-	emit_json_key(key);
-	statement_inner(value ? "true" : "false");
-}
+	void begin_json_array() override
+	{
+		put(char(TagBeginArray));
+		stack.push_back({ Type::Array, false });
+	}
 
-void Stream::emit_json_key_object(const std::string &key)
-{
-	emit_json_key(key);
-	statement_inner("{\n");
-	++indent;
-	stack.emplace(Type::Object, false);
-}
+	void end_json_array() override
+	{
+		check_state(Type::Array);
+		put(char(TagEndArray));
+		stack.pop_back();
+	}
+
+	void emit_json_key(const char *key, size_t length) override
+	{
+		check_state(Type::Object);
+
+		// Reuse the lookup string to avoid allocating for every key.
+		lookup_key.assign(key, length);
+		auto itr = keys.find(lookup_key);
+		if (itr != end(keys))
+		{
+			put(char(TagKeyReference));
+			put_varint(itr->second);
+		}
+		else
+		{
+			uint32_t index = uint32_t(keys.size());
+			keys[lookup_key] = index;
+			put(char(TagKeyDefinition));
+			put_varint(uint32_t(length));
+			put(key, length);
+		}
+	}
+
+protected:
+	enum Tag
+	{
+		TagBeginObject = 0x01,
+		TagEndObject = 0x02,
+		TagBeginArray = 0x03,
+		TagEndArray = 0x04,
+		TagFalse = 0x05,
+		TagTrue = 0x06,
+		TagUInt = 0x07,
+		TagInt = 0x08,
+		TagFloat = 0x09,
+		TagString = 0x0a,
+		TagKeyDefinition = 0x0b,
+		TagKeyReference = 0x0c
+	};
+
+	void emit_value_string(const char *str, size_t length) override
+	{
+		put(char(TagString));
+		put_varint(uint32_t(length));
+		put(str, length);
+	}
+
+	void emit_value(uint32_t value) override
+	{
+		put(char(TagUInt));
+		put_varint(value);
+	}
+
+	void emit_value(int32_t value) override
+	{
+		put(char(TagInt));
+		put_varint((uint32_t(value) << 1) ^ uint32_t(value >> 31));
+	}
+
+	void emit_value(float value) override
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		put(char(TagFloat));
+		for (uint32_t i = 0; i < 4; i++)
+			put(char((bits >> (8 * i)) & 0xff));
+	}
+
+	void emit_value(bool value) override
+	{
+		put(char(value ? TagTrue : TagFalse));
+	}
+
+private:
+	void put_varint(uint32_t value)
+	{
+		while (value >= 0x80)
+		{
+			put(char((value & 0x7f) | 0x80));
+			value >>= 7;
+		}
+		put(char(value));
+	}
+
+	std::unordered_map<std::string, uint32_t> keys;
+	std::string lookup_key;
+};
 
-void Stream::emit_json_key_array(const std::string &key)
+class StringSink : public ReflectionSink
 {
-	emit_json_key(key);
-	statement_inner("[\n");
-	++indent;
-	stack.emplace(Type::Array, false);
-}
+public:
+	void write(const char *data, size_t size) override
+	{
+		str.append(data, size);
+	}
+
+	std::string str;
+};
+} // namespace simple_json
+
+using namespace simple_json;
 
 void CompilerReflection::set_format(const std::string &format)
 {
-	if (format != "json")
+	if (format == "json")
+		binary_format = false;
+	else if (format == "binary")
+		binary_format = true;
+	else
 	{
 		SPIRV_CROSS_THROW("Unsupported format");
 	}
@@ -271,16 +460,32 @@ void CompilerReflection::set_format(const std::string &format)
 
 string CompilerReflection::compile()
 {
-	json_stream = std::make_shared<simple_json::Stream>();
+	StringSink sink;
+	compile(sink);
+	return move(sink.str);
+}
+
+void CompilerReflection::compile(ReflectionSink &sink)
+{
+	CompileBudgetScope budget_scope(*this);
+	begin_phase_timings();
+	if (binary_format)
+		json_stream = std::make_shared<BinaryStream>(sink);
+	else
+		json_stream = std::make_shared<JSONStream>(sink);
 	json_stream->set_current_locale_radix_character(current_locale_radix_character);
 	json_stream->begin_json_object();
 	reorder_type_alias();
+	begin_emission_timings();
 	emit_entry_points();
 	emit_types();
 	emit_resources();
 	emit_specialization_constants();
 	json_stream->end_json_object();
-	return json_stream->str();
+	json_stream->flush();
+	json_stream.reset();
+	compile_pass_count = 1;
+	end_pass_timing();
 }
 
 static bool naturally_emit_type(const SPIRType &type)
@@ -338,18 +543,18 @@ void CompilerReflection::emit_type(uint32_t type_id, bool &emitted_open_tag)
 		json_stream->emit_json_key_object("types");
 		emitted_open_tag = true;
 	}
-	json_stream->emit_json_key_object("_" + std::to_string(type_id));
+	json_stream->emit_json_key_type_id_object(type_id);
 	json_stream->emit_json_key_value("name", name);
 
 	if (type_is_top_level_physical_pointer(type))
 	{
-		json_stream->emit_json_key_value("type", "_" + std::to_string(type.parent_type));
+		json_stream->emit_json_key_type_id("type", type.parent_type);
 		json_stream->emit_json_key_value("physical_pointer", true);
 	}
 	else if (!type.array.empty())
 	{
 		emit_type_array(type);
-		json_stream->emit_json_key_value("type", "_" + std::to_string(type.parent_type));
+		json_stream->emit_json_key_type_id("type", type.parent_type);
 		json_stream->emit_json_key_value("array_stride", get_decoration(type_id, DecorationArrayStride));
 	}
 	else
@@ -388,11 +593,11 @@ void CompilerReflection::emit_type_member(const SPIRType &type, uint32_t index)
 
 	if (type_is_reference(membertype))
 	{
-		json_stream->emit_json_key_value("type", "_" + std::to_string(membertype.parent_type));
+		json_stream->emit_json_key_type_id("type", membertype.parent_type);
 	}
 	else if (membertype.basetype == SPIRType::Struct)
 	{
-		json_stream->emit_json_key_value("type", "_" + std::to_string(membertype.self));
+		json_stream->emit_json_key_type_id("type", membertype.self);
 	}
 	else
 	{
@@ -525,6 +730,13 @@ void CompilerReflection::emit_entry_points()
 				json_stream->emit_json_array_value(spec_y.id != ID(0));
 				json_stream->emit_json_array_value(spec_z.id != ID(0));
 				json_stream->end_json_array();
+
+				// Workgroup variables are only known for the entry point being compiled.
+				uint32_t workgroup_memory_size = 0;
+				if (&spv_entry == &get_entry_point())
+					workgroup_memory_size = get_workgroup_memory_size();
+				if (workgroup_memory_size != 0)
+					json_stream->emit_json_key_value("workgroup_memory_size", workgroup_memory_size);
 			}
 			json_stream->end_json_object();
 		}
@@ -576,7 +788,7 @@ void CompilerReflection::emit_resources(const char *tag, const SmallVector<Resou
 
 		if (type.basetype == SPIRType::Struct)
 		{
-			json_stream->emit_json_key_value("type", "_" + std::to_string(res.base_type_id));
+			json_stream->emit_json_key_type_id("type", res.base_type_id);
 		}
 		else
 		{
@@ -704,3 +916,15 @@ string CompilerReflection::to_member_name(const SPIRType &type, uint32_t index)
 	else
 		return join("_m", index);
 }
+
+void CompilerReflection::reset_module_state()
+{
+	json_stream.reset();
+	CompilerGLSL::reset_module_state();
+}
+
+void CompilerReflection::hash_compile_state(Hasher &hasher) const
+{
+	CompilerGLSL::hash_compile_state(hasher);
+	hasher.string("reflect");
+}
@@ -34,6 +34,25 @@ class Stream;
 
 namespace SPIRV_CROSS_NAMESPACE
 {
+// Receives reflection output as it is generated, e.g. to write it straight to a file.
+class ReflectionSink
+{
+public:
+	virtual ~ReflectionSink() = default;
+	virtual void write(const char *data, size_t size) = 0;
+};
+
+// The "binary" format encodes the same tree as the JSON output, but needs no text parsing to load.
+// It starts with the magic "SPVR" followed by the format version as a varint, then a single value.
+// Each value starts with a tag byte:
+// 0x01/0x02: begin/end object, 0x03/0x04: begin/end array, 0x05/0x06: false/true,
+// 0x07: unsigned varint, 0x08: signed zigzag varint, 0x09: 32-bit little-endian float,
+// 0x0a: string, as varint length followed by the UTF-8 bytes.
+// Inside objects, each value is preceded by its key. 0x0b defines a new key, as a varint length followed
+// by its bytes, and assigns it the next key index, starting from 0. 0x0c refers to a defined key by varint index.
+// Varints are unsigned LEB128.
+static const uint32_t ReflectionBinaryVersion = 1;
+
 class CompilerReflection : public CompilerGLSL
 {
 	using Parent = CompilerGLSL;
@@ -63,9 +82,13 @@ public:
 		options.vulkan_semantics = true;
 	}
 
+	// Either "json" (default) or "binary".
 	void set_format(const std::string &format);
 	std::string compile() override;
 
+	// Writes the output to sink as it is generated instead of returning it as a string.
+	void compile(ReflectionSink &sink);
+
 private:
 	static std::string execution_model_to_str(spv::ExecutionModel model);
 
@@ -83,7 +106,11 @@ private:
 
 	std::string to_member_name(const SPIRType &type, uint32_t index) const;
 
+	void hash_compile_state(Hasher &hasher) const override;
+	void reset_module_state() override;
+
 	std::shared_ptr<simple_json::Stream> json_stream;
+	bool binary_format = false;
 };
 
 } // namespace SPIRV_CROSS_NAMESPACE
@@ -237,6 +237,12 @@ def cross_compile_msl(shader, spirv, opt, iterations, paths):
         msl_args.append('3')
     if '.force-active.' in shader:
         msl_args.append('--msl-force-active-argument-buffer-resources')
+    if '.repack-ubo.' in shader:
+        msl_args.append('--repack-ubo')
+    if '.pad-shared.' in shader:
+        msl_args.append('--pad-workgroup-arrays')
+    if '.alias-shared.' in shader:
+        msl_args.append('--alias-workgroup-variables')
     if '.line.' in shader:
         msl_args.append('--emit-line-directives')
     if '.multiview.' in shader:
@@ -302,6 +308,8 @@ def cross_compile_msl(shader, spirv, opt, iterations, paths):
         msl_args.append('1')
         msl_args.append('any16')
         msl_args.append('2')
+    if '.stage-tesc-out.' in shader:
+        msl_args.append('--msl-stage-tess-control-outputs')
     if '.for-tess.' in shader:
         msl_args.append('--msl-vertex-for-tessellation')
     if '.fixed-sample-mask.' in shader:
@@ -321,6 +329,12 @@ def cross_compile_msl(shader, spirv, opt, iterations, paths):
         msl_args.append('32')
     if '.force-sample.' in shader:
         msl_args.append('--msl-force-sample-rate-shading')
+    if '.vertex-pulling.' in shader:
+        msl_args.append('--msl-vertex-pulling')
+        msl_args.append('--msl-vertex-buffer-index-base')
+        msl_args.append('8')
+    if '.vertex-pulling-default-base.' in shader:
+        msl_args.append('--msl-vertex-pulling')
     if '.decoration-binding.' in shader:
         msl_args.append('--msl-decoration-binding')
 
@@ -443,6 +457,12 @@ def cross_compile_hlsl(shader, spirv, opt, force_no_external_validation, iterati
         hlsl_args.append('--hlsl-enable-16bit-types')
     if '.flatten-matrix-vertex-input.' in shader:
         hlsl_args.append('--hlsl-flatten-matrix-vertex-input-semantics')
+    if '.repack-ubo.' in shader:
+        hlsl_args.append('--repack-ubo')
+    if '.pad-shared.' in shader:
+        hlsl_args.append('--pad-workgroup-arrays')
+    if '.alias-shared.' in shader:
+        hlsl_args.append('--alias-workgroup-variables')
 
     subprocess.check_call(hlsl_args)
 
@@ -472,9 +492,38 @@ def cross_compile_reflect(shader, spirv, opt, iterations, paths):
     spirv_cross_path = paths.spirv_cross
 
     sm = shader_to_sm(shader)
-    subprocess.check_call([spirv_cross_path, '--entry', 'main', '--output', reflect_path, spirv_path, '--reflect', '--iterations', str(iterations)])
+    reflect_args = [spirv_cross_path, '--entry', 'main', '--output', reflect_path, spirv_path, '--reflect', '--iterations', str(iterations)]
+    if '.repack-ubo.' in shader:
+        reflect_args.append('--repack-ubo')
+    if '.pad-shared.' in shader:
+        reflect_args.append('--pad-workgroup-arrays')
+    if '.alias-shared.' in shader:
+        reflect_args.append('--alias-workgroup-variables')
+
+    subprocess.check_call(reflect_args)
     return (spirv_path, reflect_path)
 
+def cross_compile_cpp(shader, spirv, opt, iterations, paths):
+    spirv_path = create_temporary()
+    cpp_path = create_temporary(os.path.basename(shader))
+
+    if spirv:
+        subprocess.check_call([paths.spirv_as, '--target-env', 'vulkan1.1', '-o', spirv_path, shader])
+    else:
+        subprocess.check_call([paths.glslang, '--amb', '--target-env', 'vulkan1.1', '-V', '-o', spirv_path, shader])
+
+    if opt:
+        subprocess.check_call([paths.spirv_opt, '--skip-validation', '-O', '-o', spirv_path, spirv_path])
+
+    spirv_cross_path = paths.spirv_cross
+
+    cpp_args = [spirv_cross_path, '--entry', 'main', '--output', cpp_path, spirv_path, '--cpp', '--iterations', str(iterations)]
+    if '.batched.' in shader:
+        cpp_args.append('--cpp-batched-invocations')
+
+    subprocess.check_call(cpp_args)
+    return (spirv_path, cpp_path)
+
 def validate_shader(shader, vulkan, paths):
     if vulkan:
         spirv_14 = '.spv14.' in shader
@@ -535,6 +584,23 @@ def cross_compile(shader, vulkan, spirv, invalid_spirv, eliminate, is_legacy, fl
         extra_args += ['--glsl-remap-ext-framebuffer-fetch', '3', '3']
     if '.zero-initialize.' in shader:
         extra_args += ['--force-zero-initialized-variables']
+    if '.predict-temporaries.' in shader:
+        extra_args += ['--predict-temporaries']
+    if '.compact.' in shader:
+        extra_args += ['--compact-output']
+    if '.fold-spec-constants.' in shader:
+        # Bakes constant_id 0 = 1 and constant_id 1 = 2, any other specialization constants are kept.
+        extra_args += ['--fold-spec-constant', '0', '1', '--fold-spec-constant', '1', '2']
+    if '.cse.' in shader:
+        extra_args += ['--eliminate-common-subexpressions']
+    if '.infer-precision.' in shader:
+        extra_args += ['--glsl-infer-relaxed-precision']
+    if '.repack-ubo.' in shader:
+        extra_args += ['--repack-ubo']
+    if '.pad-shared.' in shader:
+        extra_args += ['--pad-workgroup-arrays']
+    if '.alias-shared.' in shader:
+        extra_args += ['--alias-workgroup-variables']
     if '.force-flattened-io.' in shader:
         extra_args += ['--glsl-force-flattened-io-blocks']
 
@@ -770,6 +836,15 @@ def test_shader_reflect(stats, shader, args, paths):
     regression_check_reflect(shader, reflect, args)
     remove_file(spirv)
 
+def test_shader_cpp(stats, shader, args, paths):
+    joined_path = os.path.join(shader[0], shader[1])
+    print('Testing C++ shader:', joined_path)
+    is_spirv = shader_is_spirv(shader[1])
+    noopt = shader_is_noopt(shader[1])
+    spirv, cpp = cross_compile_cpp(joined_path, is_spirv, args.opt and (not noopt), args.iterations, paths)
+    regression_check(shader, cpp, args)
+    remove_file(spirv)
+
 def test_shader_file(relpath, stats, args, backend):
     paths = Paths(args.spirv_cross, args.glslang, args.spirv_as, args.spirv_val, args.spirv_opt)
     try:
@@ -779,6 +854,8 @@ def test_shader_file(relpath, stats, args, backend):
             test_shader_hlsl(stats, (args.folder, relpath), args, paths)
         elif backend == 'reflect':
             test_shader_reflect(stats, (args.folder, relpath), args, paths)
+        elif backend == 'cpp':
+            test_shader_cpp(stats, (args.folder, relpath), args, paths)
         else:
             test_shader(stats, (args.folder, relpath), args, paths)
         return None
@@ -858,6 +935,9 @@ def main():
     parser.add_argument('--reflect',
             action = 'store_true',
             help = 'Test reflection backend.')
+    parser.add_argument('--cpp',
+            action = 'store_true',
+            help = 'Test C++ backend.')
     parser.add_argument('--parallel',
             action = 'store_true',
             help = 'Execute tests in parallel.  Useful for doing regression quickly, but bad for debugging and stat output.')
@@ -904,6 +984,8 @@ def main():
         backend = 'hlsl'
     elif args.reflect:
         backend = 'reflect'
+    elif args.cpp:
+        backend = 'cpp'
 
     test_shaders(backend, args)
     if args.malisc:
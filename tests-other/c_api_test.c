@@ -7,6 +7,7 @@
 #include <spirv_cross_c.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #define SPVC_CHECKED_CALL(x) do { \
 	if ((x) != SPVC_SUCCESS) { \
@@ -93,6 +94,179 @@ static void dump_resources(spvc_compiler compiler, spvc_resources resources)
 	dump_resource_list(compiler, resources, SPVC_RESOURCE_TYPE_SUBPASS_INPUT, "Subpass input");
 }
 
+static unsigned g_cache_stores = 0;
+
+static const char *cache_load(void *userdata, const char *key)
+{
+	(void)userdata;
+	(void)key;
+	return NULL;
+}
+
+static void cache_store(void *userdata, const char *key, const char *source)
+{
+	(void)userdata;
+	(void)source;
+	if (!key || key[16] != '\0')
+	{
+		fprintf(stderr, "Invalid cache key.\n");
+		exit(1);
+	}
+	g_cache_stores++;
+}
+
+static int g_trace_depth = 0;
+static unsigned g_trace_passes = 0;
+
+static void trace_callback(void *userdata, spvc_trace_event event, spvc_bool begin, unsigned id)
+{
+	(void)userdata;
+	(void)id;
+	if (event == SPVC_TRACE_EVENT_FORCE_RECOMPILE)
+		return;
+
+	g_trace_depth += begin ? 1 : -1;
+	if (g_trace_depth < 0)
+	{
+		fprintf(stderr, "Unbalanced trace events!\n");
+		exit(1);
+	}
+
+	if (event == SPVC_TRACE_EVENT_COMPILE_PASS && begin)
+		g_trace_passes++;
+}
+
+struct output_buffer
+{
+	char *data;
+	size_t size;
+};
+
+static void output_callback(void *userdata, const char *data, size_t size)
+{
+	struct output_buffer *output = userdata;
+	output->data = realloc(output->data, output->size + size + 1);
+	memcpy(output->data + output->size, data, size);
+	output->size += size;
+	output->data[output->size] = '\0';
+}
+
+static void compile_streamed(spvc_compiler compiler, const char *tag)
+{
+	const char *result = NULL;
+	struct output_buffer output = { NULL, 0 };
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler, &result));
+	SPVC_CHECKED_CALL(spvc_compiler_compile_to_callback(compiler, output_callback, &output));
+	if (!output.data || strcmp(output.data, result) != 0)
+	{
+		fprintf(stderr, "Streamed %s output mismatch!\n", tag);
+		exit(1);
+	}
+	free(output.data);
+}
+
+static void compile_with_budget(spvc_compiler compiler, const char *expected)
+{
+	const char *result = NULL;
+	spvc_compile_budget budget;
+
+	spvc_compile_budget_init(&budget);
+	budget.max_output_size = strlen(expected) - 1;
+	SPVC_CHECKED_CALL(spvc_compiler_set_compile_budget(compiler, &budget));
+	g_fail_on_error = SPVC_FALSE;
+	if (spvc_compiler_compile(compiler, &result) != SPVC_ERROR_BUDGET_EXCEEDED)
+	{
+		fprintf(stderr, "Output budget not enforced!\n");
+		exit(1);
+	}
+
+	spvc_compile_budget_init(&budget);
+	SPVC_CHECKED_CALL(spvc_compiler_set_compile_budget(compiler, &budget));
+	spvc_compiler_cancel_compile(compiler);
+	if (spvc_compiler_compile(compiler, &result) != SPVC_ERROR_BUDGET_EXCEEDED)
+	{
+		fprintf(stderr, "Cancellation not enforced!\n");
+		exit(1);
+	}
+	g_fail_on_error = SPVC_TRUE;
+
+	budget.max_output_size = strlen(expected);
+	SPVC_CHECKED_CALL(spvc_compiler_set_compile_budget(compiler, &budget));
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler, &result));
+	if (strcmp(result, expected) != 0)
+	{
+		fprintf(stderr, "Budgeted compile mismatch!\n");
+		exit(1);
+	}
+}
+
+static void compile_after_shrink(spvc_compiler compiler, const char *expected)
+{
+	const char *result = NULL;
+	size_t total = spvc_compiler_get_memory_usage(compiler, SPVC_MEMORY_CATEGORY_TOTAL);
+
+	if (total == 0 || spvc_compiler_get_memory_usage(compiler, SPVC_MEMORY_CATEGORY_SPIRV) == 0 ||
+	    spvc_compiler_get_memory_usage(compiler, SPVC_MEMORY_CATEGORY_OBJECT_POOLS_LIVE) >
+	        spvc_compiler_get_memory_usage(compiler, SPVC_MEMORY_CATEGORY_OBJECT_POOLS))
+	{
+		fprintf(stderr, "Memory usage mismatch!\n");
+		exit(1);
+	}
+
+	spvc_compiler_shrink_to_fit(compiler);
+	if (spvc_compiler_get_memory_usage(compiler, SPVC_MEMORY_CATEGORY_TOTAL) > total)
+	{
+		fprintf(stderr, "Shrinking grew memory usage!\n");
+		exit(1);
+	}
+
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler, &result));
+	if (strcmp(result, expected) != 0)
+	{
+		fprintf(stderr, "Compile after shrink mismatch!\n");
+		exit(1);
+	}
+}
+
+static void remap_bindings_in_bulk(spvc_context context, const SpvId *buffer, size_t word_count)
+{
+	spvc_parsed_ir ir = NULL;
+	spvc_compiler compiler = NULL;
+	const char *result = NULL;
+	unsigned num_remapped = 0;
+	spvc_resource_binding_remap remaps[3] = {
+		{ 0, 0, 1, 1 },
+		{ 0, 1, 0, 0 },
+		{ 7, 7, 0, 1 },
+	};
+	spvc_msl_resource_binding bindings[2];
+
+	spvc_msl_resource_binding_init(&bindings[0]);
+	bindings[0].stage = SpvExecutionModelGLCompute;
+	bindings[0].desc_set = 1;
+	bindings[0].binding = 1;
+	bindings[0].msl_buffer = 5;
+	bindings[1] = bindings[0];
+	bindings[1].desc_set = 0;
+	bindings[1].binding = 0;
+	bindings[1].msl_buffer = 6;
+
+	SPVC_CHECKED_CALL(spvc_context_parse_spirv(context, buffer, word_count, &ir));
+	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_MSL, ir, SPVC_CAPTURE_MODE_TAKE_OWNERSHIP,
+	                                               &compiler));
+	SPVC_CHECKED_CALL(spvc_compiler_remap_resource_bindings(compiler, remaps, 3, &num_remapped));
+	SPVC_CHECKED_CALL(spvc_compiler_msl_add_resource_bindings(compiler, bindings, 2));
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler, &result));
+
+	if (num_remapped != 2 || !spvc_compiler_msl_is_resource_used(compiler, SpvExecutionModelGLCompute, 1, 1) ||
+	    !spvc_compiler_msl_is_resource_used(compiler, SpvExecutionModelGLCompute, 0, 0) ||
+	    !strstr(result, "[[buffer(5)]]") || !strstr(result, "[[buffer(6)]]"))
+	{
+		fprintf(stderr, "Bulk binding remap mismatch!\n");
+		exit(1);
+	}
+}
+
 static void compile(spvc_compiler compiler, const char *tag)
 {
 	const char *result = NULL;
@@ -113,10 +287,42 @@ int main(int argc, char **argv)
 	spvc_compiler compiler_cpp = NULL;
 	spvc_compiler compiler_json = NULL;
 	spvc_compiler compiler_none = NULL;
+	spvc_compiler compiler_cached[2] = { NULL, NULL };
+	const char *cached_result[2] = { NULL, NULL };
+	spvc_parsed_ir ir_borrowed = NULL;
+	spvc_parsed_ir ir_mapped = NULL;
+	spvc_compiler compiler_borrowed = NULL;
+	spvc_compiler compiler_mapped = NULL;
+	spvc_parsed_ir ir_serialized = NULL;
+	spvc_parsed_ir ir_filtered = NULL;
+	spvc_compiler compiler_filtered = NULL;
+	const char *filtered_result = NULL;
+	spvc_compiler compiler_serialized = NULL;
+	const SpvId *serialized = NULL;
+	size_t serialized_word_count = 0;
+	const char *serialized_result = NULL;
+	const char *borrowed_result = NULL;
+	const char *mapped_result = NULL;
+	spvc_parsed_ir ir_rebind = NULL;
+	const char *rebind_result = NULL;
+	const char *helper_library = NULL;
+	spvc_parsed_ir ir_scoped = NULL;
+	spvc_compiler compiler_scoped = NULL;
+	spvc_resources resources_scoped = NULL;
+	const char *scoped_result = NULL;
+	int scoped_iteration;
+	size_t cache_hits = 0, cache_misses = 0;
+	spvc_batch_option batch_hlsl_option = { SPVC_COMPILER_OPTION_HLSL_SHADER_MODEL, 50 };
+	spvc_specialization_constant_value spec_value = { 0, 1 };
+	spvc_batch_job batch_jobs[3];
+	spvc_batch_result batch_results[3];
 	spvc_compiler_options options = NULL;
 	spvc_resources resources = NULL;
 	SpvId *buffer = NULL;
 	size_t word_count = 0;
+	spvc_bool tracing;
+	int recompile_reason;
+	unsigned recompile_count = 0;
 
 	rev = spvc_get_commit_revision_and_timestamp();
 	if (!rev || *rev == '\0')
@@ -152,12 +358,17 @@ int main(int argc, char **argv)
 
 	SPVC_CHECKED_CALL(spvc_context_create(&context));
 	spvc_context_set_error_callback(context, error_callback, NULL);
+	g_fail_on_error = SPVC_FALSE;
+	tracing = spvc_context_set_trace_callback(context, trace_callback, NULL) == SPVC_SUCCESS;
+	g_fail_on_error = SPVC_TRUE;
 	SPVC_CHECKED_CALL(spvc_context_parse_spirv(context, buffer, word_count, &ir));
 	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_GLSL, ir, SPVC_CAPTURE_MODE_COPY, &compiler_glsl));
 	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_HLSL, ir, SPVC_CAPTURE_MODE_COPY, &compiler_hlsl));
 	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_MSL, ir, SPVC_CAPTURE_MODE_COPY, &compiler_msl));
 	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_CPP, ir, SPVC_CAPTURE_MODE_COPY, &compiler_cpp));
 	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_JSON, ir, SPVC_CAPTURE_MODE_COPY, &compiler_json));
+	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_GLSL, ir, SPVC_CAPTURE_MODE_COPY, &compiler_cached[0]));
+	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_GLSL, ir, SPVC_CAPTURE_MODE_COPY, &compiler_cached[1]));
 	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_NONE, ir, SPVC_CAPTURE_MODE_TAKE_OWNERSHIP, &compiler_none));
 
 	SPVC_CHECKED_CALL(spvc_compiler_create_compiler_options(compiler_none, &options));
@@ -178,10 +389,146 @@ int main(int argc, char **argv)
 	SPVC_CHECKED_CALL(spvc_compiler_create_shader_resources(compiler_none, &resources));
 	dump_resources(compiler_none, resources);
 	compile(compiler_glsl, "GLSL");
+	SPVC_CHECKED_CALL(spvc_compiler_fold_specialization_constants(compiler_hlsl, &spec_value, 1));
 	compile(compiler_hlsl, "HLSL");
 	compile(compiler_msl, "MSL");
 	compile(compiler_json, "JSON");
 	compile(compiler_cpp, "CPP");
+	if (spvc_compiler_get_compile_pass_count(compiler_glsl) == 0)
+	{
+		fprintf(stderr, "Compile pass count not reported!\n");
+		return 1;
+	}
+
+	for (recompile_reason = SPVC_RECOMPILE_REASON_GENERIC; recompile_reason <= SPVC_RECOMPILE_REASON_BUILTIN;
+	     recompile_reason++)
+		recompile_count += spvc_compiler_get_recompile_reason_count(compiler_glsl, (spvc_recompile_reason)recompile_reason);
+	if (spvc_compiler_get_compile_pass_count(compiler_glsl) > 1 && recompile_count == 0)
+	{
+		fprintf(stderr, "Recompile reasons not reported!\n");
+		return 1;
+	}
+
+	if (tracing && (g_trace_passes == 0 || g_trace_depth != 0))
+	{
+		fprintf(stderr, "Trace events not reported!\n");
+		return 1;
+	}
+
+	compile_streamed(compiler_glsl, "GLSL");
+	compile_streamed(compiler_cpp, "CPP");
+	compile_streamed(compiler_json, "JSON");
+
+	SPVC_CHECKED_CALL_NEGATIVE(spvc_context_set_compilation_cache_callbacks(context, cache_load, cache_store, NULL));
+	SPVC_CHECKED_CALL(spvc_context_enable_compilation_cache(context, 1024 * 1024));
+	SPVC_CHECKED_CALL(spvc_context_set_compilation_cache_callbacks(context, cache_load, cache_store, NULL));
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler_cached[0], &cached_result[0]));
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler_cached[1], &cached_result[1]));
+	spvc_context_get_compilation_cache_statistics(context, &cache_hits, &cache_misses);
+	if (cache_hits != 1 || cache_misses != 1 || g_cache_stores != 1 || strcmp(cached_result[0], cached_result[1]) != 0)
+	{
+		fprintf(stderr, "Compilation cache mismatch!\n");
+		return 1;
+	}
+	spvc_context_disable_compilation_cache(context);
+	compile_with_budget(compiler_glsl, cached_result[0]);
+	compile_after_shrink(compiler_glsl, cached_result[0]);
+	remap_bindings_in_bulk(context, buffer, word_count);
+
+	SPVC_CHECKED_CALL(spvc_context_parse_spirv_borrowed(context, buffer, word_count, &ir_borrowed));
+	SPVC_CHECKED_CALL(spvc_context_parse_spirv_file_region(context, argv[1], 0, 0, &ir_mapped));
+	SPVC_CHECKED_CALL_NEGATIVE(spvc_context_parse_spirv_file_region(context, argv[1], 2, 0, &ir_mapped));
+	SPVC_CHECKED_CALL(spvc_context_serialize_parsed_ir(context, ir_borrowed, &serialized, &serialized_word_count));
+	SPVC_CHECKED_CALL(spvc_context_deserialize_parsed_ir(context, serialized, serialized_word_count, &ir_serialized));
+	SPVC_CHECKED_CALL_NEGATIVE(spvc_context_deserialize_parsed_ir(context, serialized, serialized_word_count - 1, &ir_serialized));
+	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_GLSL, ir_serialized,
+	                                               SPVC_CAPTURE_MODE_TAKE_OWNERSHIP, &compiler_serialized));
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler_serialized, &serialized_result));
+	SPVC_CHECKED_CALL(spvc_context_parse_spirv_entry_point(context, buffer, word_count, "main", SpvExecutionModelGLCompute,
+	                                                       &ir_filtered));
+	SPVC_CHECKED_CALL_NEGATIVE(spvc_context_parse_spirv_entry_point(context, buffer, word_count, "main",
+	                                                                SpvExecutionModelFragment, &ir_filtered));
+	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_GLSL, ir_filtered,
+	                                               SPVC_CAPTURE_MODE_TAKE_OWNERSHIP, &compiler_filtered));
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler_filtered, &filtered_result));
+	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_GLSL, ir_borrowed,
+	                                               SPVC_CAPTURE_MODE_TAKE_OWNERSHIP, &compiler_borrowed));
+	SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_GLSL, ir_mapped,
+	                                               SPVC_CAPTURE_MODE_TAKE_OWNERSHIP, &compiler_mapped));
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler_borrowed, &borrowed_result));
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler_mapped, &mapped_result));
+	if (strcmp(borrowed_result, cached_result[0]) != 0 || strcmp(mapped_result, cached_result[0]) != 0 ||
+	    strcmp(serialized_result, cached_result[0]) != 0 || strcmp(filtered_result, cached_result[0]) != 0)
+	{
+		fprintf(stderr, "Borrowed SPIR-V mismatch!\n");
+		return 1;
+	}
+
+	SPVC_CHECKED_CALL(spvc_context_parse_spirv(context, buffer, word_count, &ir_rebind));
+	SPVC_CHECKED_CALL_NEGATIVE(spvc_compiler_rebind_parsed_ir(compiler_mapped, ir_rebind, (spvc_capture_mode)2));
+	SPVC_CHECKED_CALL(spvc_compiler_rebind_parsed_ir(compiler_mapped, ir_rebind, SPVC_CAPTURE_MODE_COPY));
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler_mapped, &rebind_result));
+	if (strcmp(rebind_result, cached_result[0]) != 0)
+	{
+		fprintf(stderr, "Rebound compiler mismatch!\n");
+		return 1;
+	}
+	SPVC_CHECKED_CALL(spvc_compiler_rebind_parsed_ir(compiler_msl, ir_rebind, SPVC_CAPTURE_MODE_TAKE_OWNERSHIP));
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler_msl, &rebind_result));
+
+	SPVC_CHECKED_CALL(spvc_compiler_create_compiler_options(compiler_msl, &options));
+	SPVC_CHECKED_CALL(spvc_compiler_options_set_bool(options, SPVC_COMPILER_OPTION_MSL_USE_HELPER_LIBRARY, SPVC_TRUE));
+	SPVC_CHECKED_CALL(spvc_compiler_install_compiler_options(compiler_msl, options));
+	SPVC_CHECKED_CALL(spvc_compiler_msl_set_helper_library_include(compiler_msl, "c_api_helpers.h"));
+	SPVC_CHECKED_CALL_NEGATIVE(spvc_compiler_msl_add_helper_library_requirements(compiler_msl, compiler_glsl));
+	SPVC_CHECKED_CALL(spvc_compiler_compile(compiler_msl, &rebind_result));
+	SPVC_CHECKED_CALL(spvc_compiler_msl_compile_helper_library(compiler_msl, &helper_library));
+	if (!strstr(rebind_result, "#include \"c_api_helpers.h\"") || !strstr(helper_library, "SPIRV_CROSS_MSL_HELPERS_H"))
+	{
+		fprintf(stderr, "MSL helper library mismatch!\n");
+		return 1;
+	}
+
+	spvc_compiler_destroy(compiler_mapped);
+	spvc_compiler_destroy(NULL);
+	spvc_parsed_ir_destroy(ir_rebind);
+	spvc_parsed_ir_destroy(NULL);
+	SPVC_CHECKED_CALL(spvc_context_parse_spirv(context, buffer, word_count, &ir_scoped));
+	for (scoped_iteration = 0; scoped_iteration < 4; scoped_iteration++)
+	{
+		SPVC_CHECKED_CALL(spvc_context_create_compiler(context, SPVC_BACKEND_GLSL, ir_scoped, SPVC_CAPTURE_MODE_COPY,
+		                                               &compiler_scoped));
+		SPVC_CHECKED_CALL(spvc_compiler_create_shader_resources(compiler_scoped, &resources_scoped));
+		SPVC_CHECKED_CALL(spvc_compiler_compile(compiler_scoped, &scoped_result));
+		if (strcmp(scoped_result, cached_result[0]) != 0)
+		{
+			fprintf(stderr, "Scoped compiler mismatch!\n");
+			return 1;
+		}
+		spvc_compiler_destroy(compiler_scoped);
+	}
+	spvc_parsed_ir_destroy(ir_scoped);
+
+	memset(batch_jobs, 0, sizeof(batch_jobs));
+	batch_jobs[0].spirv = buffer;
+	batch_jobs[0].word_count = word_count;
+	batch_jobs[0].backend = SPVC_BACKEND_GLSL;
+	batch_jobs[1].spirv = buffer;
+	batch_jobs[1].word_count = word_count;
+	batch_jobs[1].backend = SPVC_BACKEND_HLSL;
+	batch_jobs[1].options = &batch_hlsl_option;
+	batch_jobs[1].num_options = 1;
+	batch_jobs[2].spirv = buffer;
+	batch_jobs[2].word_count = 3;
+	batch_jobs[2].backend = SPVC_BACKEND_GLSL;
+	SPVC_CHECKED_CALL(spvc_context_compile_batch(context, batch_jobs, 3, 2, batch_results));
+	if (batch_results[0].result != SPVC_SUCCESS || strcmp(batch_results[0].source, cached_result[0]) != 0 ||
+	    batch_results[1].result != SPVC_SUCCESS || !batch_results[1].source ||
+	    batch_results[2].result != SPVC_ERROR_INVALID_SPIRV || !batch_results[2].error)
+	{
+		fprintf(stderr, "Batch compilation mismatch!\n");
+		return 1;
+	}
 
 	spvc_context_destroy(context);
 	free(buffer);
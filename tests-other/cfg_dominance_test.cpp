@@ -0,0 +1,132 @@
+// Checks CFG::dominates() and CFG::get_dominance_frontier() against their definitions,
+// for every pair of reachable blocks in every function.
+
+#include "spirv_cfg.hpp"
+#include "spirv_cross.hpp"
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace SPIRV_CROSS_NAMESPACE;
+
+static void check(bool cond, const char *what, uint32_t a, uint32_t b)
+{
+	if (!cond)
+	{
+		fprintf(stderr, "CFG mismatch: %s (%u, %u)\n", what, a, b);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static std::vector<uint32_t> read_file(const char *path)
+{
+	FILE *file = fopen(path, "rb");
+	if (!file)
+		exit(EXIT_FAILURE);
+
+	fseek(file, 0, SEEK_END);
+	long len = ftell(file) / sizeof(uint32_t);
+	rewind(file);
+
+	std::vector<uint32_t> spirv(len);
+	if (fread(spirv.data(), sizeof(uint32_t), len, file) != size_t(len))
+		exit(EXIT_FAILURE);
+	fclose(file);
+	return spirv;
+}
+
+// Functions and blocks are not part of the public interface.
+class DominanceTestCompiler : public Compiler
+{
+public:
+	explicit DominanceTestCompiler(std::vector<uint32_t> spirv)
+	    : Compiler(std::move(spirv))
+	{
+	}
+
+	void check_functions()
+	{
+		for (uint32_t id = 1; id < get_current_id_bound(); id++)
+		{
+			auto *func = maybe_get<SPIRFunction>(id);
+			if (func && func->entry_block)
+				check_function(*func);
+		}
+	}
+
+private:
+	// The blocks reachable from the entry block, without passing through excluded.
+	static SmallVector<uint8_t> reachable(const CFG &cfg, const SPIRFunction &func, uint32_t bound, uint32_t excluded)
+	{
+		SmallVector<uint8_t> seen(bound);
+		SmallVector<uint32_t> stack;
+		if (func.entry_block != excluded)
+			stack.push_back(func.entry_block);
+
+		while (!stack.empty())
+		{
+			uint32_t block = stack.back();
+			stack.pop_back();
+			if (seen[block])
+				continue;
+			seen[block] = 1;
+
+			for (auto succ : cfg.get_succeeding_edges(block))
+				if (succ != excluded)
+					stack.push_back(succ);
+		}
+		return seen;
+	}
+
+	void check_function(const SPIRFunction &func)
+	{
+		CFG cfg(*this, func);
+		uint32_t bound = get_current_id_bound();
+		auto reached = reachable(cfg, func, bound, 0);
+
+		SmallVector<uint32_t> blocks;
+		for (auto block : func.blocks)
+			if (reached[block])
+				blocks.push_back(block);
+
+		for (auto a : blocks)
+		{
+			// a dominates b if b cannot be reached without going through a.
+			auto without_a = reachable(cfg, func, bound, a);
+			const auto dominates = [&](uint32_t b) { return a == b || !without_a[b]; };
+
+			for (auto b : blocks)
+				check(cfg.dominates(a, b) == dominates(b), "dominates", a, b);
+
+			SmallVector<uint32_t> expected_frontier;
+			for (auto b : blocks)
+			{
+				if (a != b && dominates(b))
+					continue;
+
+				auto &preds = cfg.get_preceding_edges(b);
+				if (std::any_of(preds.begin(), preds.end(), dominates))
+					expected_frontier.push_back(b);
+			}
+
+			auto frontier = cfg.get_dominance_frontier(a);
+			std::sort(frontier.begin(), frontier.end());
+			std::sort(expected_frontier.begin(), expected_frontier.end());
+			check(frontier.size() == expected_frontier.size() &&
+			          std::equal(frontier.begin(), frontier.end(), expected_frontier.begin()),
+			      "dominance frontier", a, 0);
+		}
+	}
+};
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+		return EXIT_FAILURE;
+
+	for (int i = 1; i < argc; i++)
+	{
+		DominanceTestCompiler compiler(read_file(argv[i]));
+		compiler.check_functions();
+	}
+}
@@ -0,0 +1,101 @@
+// Runs a C++ compute shader generated by spirv-cross and checks the results of invoke() and dispatch().
+// The shader is a workgroup reduction with a barrier inside a loop, see shaders-cpp/asm/comp/barrier-in-loop.*.
+
+#ifndef SPIRV_CROSS_CPP_SHADER
+#error "SPIRV_CROSS_CPP_SHADER must name the generated C++ shader."
+#endif
+
+#include SPIRV_CROSS_CPP_SHADER
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+// The generated shader has 64 invocations per workgroup, each invocation reads two inputs.
+static const unsigned group_inputs = 128;
+
+static void check(bool cond, const char *what)
+{
+	if (!cond)
+	{
+		fprintf(stderr, "Check failed: %s\n", what);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static void check_sums(const std::vector<float> &inputs, const std::vector<float> &sums, const char *what)
+{
+	for (size_t group = 0; group < sums.size(); group++)
+	{
+		float expected = 0.0f;
+		for (size_t i = group * group_inputs; i < (group + 1) * group_inputs; i++)
+			expected += inputs[i];
+
+		// All inputs are small integers, so the sum is exact in any order.
+		if (sums[group] != expected)
+		{
+			fprintf(stderr, "%s: workgroup %u computed %f, expected %f.\n", what, unsigned(group), sums[group],
+			        expected);
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+int main()
+{
+	const struct spirv_cross_interface *iface = spirv_cross_get_interface();
+	check(iface->dispatch != nullptr, "compute shaders provide dispatch()");
+
+	const unsigned num_groups = 37;
+	std::vector<float> inputs(group_inputs * num_groups);
+	for (size_t i = 0; i < inputs.size(); i++)
+		inputs[i] = float(i & 0xff);
+
+	{
+		std::vector<float> sums(num_groups);
+		void *inputs_ptr = inputs.data();
+		void *sums_ptr = sums.data();
+
+		spirv_cross_shader_t *shader = iface->construct();
+		spirv_cross_set_resource(shader, 0, 0, &inputs_ptr, sizeof(inputs_ptr));
+		spirv_cross_set_resource(shader, 0, 1, &sums_ptr, sizeof(sums_ptr));
+
+		uvec3 num_work_groups(num_groups, 1, 1);
+		uvec3 work_group_id(0, 0, 0);
+		spirv_cross_set_builtin(shader, SPIRV_CROSS_BUILTIN_NUM_WORK_GROUPS, &num_work_groups,
+		                        sizeof(num_work_groups));
+		spirv_cross_set_builtin(shader, SPIRV_CROSS_BUILTIN_WORK_GROUP_ID, &work_group_id, sizeof(work_group_id));
+
+		for (unsigned group = 0; group < num_groups; group++)
+		{
+			work_group_id.x = group;
+			iface->invoke(shader);
+		}
+
+		iface->destruct(shader);
+		check_sums(inputs, sums, "invoke()");
+	}
+
+	{
+		std::vector<float> sums(num_groups);
+		void *inputs_ptr = inputs.data();
+		void *sums_ptr = sums.data();
+
+		spirv_cross_shader_t *shader = iface->construct();
+		spirv_cross_set_resource(shader, 0, 0, &inputs_ptr, sizeof(inputs_ptr));
+		spirv_cross_set_resource(shader, 0, 1, &sums_ptr, sizeof(sums_ptr));
+
+		// Dispatch twice, the second grid must not see state left behind by the first.
+		iface->dispatch(shader, num_groups, 1, 1);
+		check_sums(inputs, sums, "dispatch()");
+
+		for (auto &sum : sums)
+			sum = 0.0f;
+		iface->dispatch(shader, num_groups, 1, 1);
+		check_sums(inputs, sums, "second dispatch()");
+
+		iface->destruct(shader);
+	}
+
+	return EXIT_SUCCESS;
+}
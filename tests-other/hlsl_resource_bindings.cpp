@@ -5,6 +5,7 @@
 #include <vector>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define SPVC_CHECKED_CALL(x) do { \
 	if ((x) != SPVC_SUCCESS) { \
@@ -85,5 +86,16 @@ int main(int argc, char **argv)
 
 	if (!spvc_compiler_hlsl_is_resource_used(compiler, SpvExecutionModelFragment, SPVC_HLSL_PUSH_CONSTANT_DESC_SET, SPVC_HLSL_PUSH_CONSTANT_BINDING))
 		return EXIT_FAILURE;
+
+	const char *root_signature;
+	SPVC_CHECKED_CALL(spvc_compiler_hlsl_build_root_signature(&compiler, 1, &root_signature));
+	fprintf(stderr, "Root signature:\n%s\n", root_signature);
+
+	// The push constant block is small enough to become root constants.
+	if (strcmp(root_signature, "RootFlags(0), "
+	                           "RootConstants(num32BitConstants=4, b4, visibility=SHADER_VISIBILITY_PIXEL), "
+	                           "DescriptorTable(SRV(t3, space=2), visibility=SHADER_VISIBILITY_PIXEL), "
+	                           "DescriptorTable(Sampler(s5, space=4), visibility=SHADER_VISIBILITY_PIXEL)") != 0)
+		return EXIT_FAILURE;
 }
 
@@ -82,5 +82,32 @@ int main(int argc, char **argv)
 
 	if (!spvc_compiler_msl_is_resource_used(compiler, SpvExecutionModelFragment, 1, SPVC_MSL_ARGUMENT_BUFFER_BINDING))
 		return EXIT_FAILURE;
+
+	const spvc_msl_argument_buffer_member *members;
+	size_t num_members;
+	SPVC_CHECKED_CALL(spvc_compiler_msl_get_argument_buffer_layout(compiler, 2, &members, &num_members));
+	if (num_members != 3)
+		return EXIT_FAILURE;
+	for (size_t i = 0; i < num_members; i++)
+	{
+		fprintf(stderr, "Set 2, binding %u, type %d, id %u, offset %u, size %u\n", members[i].binding, members[i].type,
+		        members[i].msl_id, members[i].offset, members[i].size);
+		if (members[i].msl_id != i || members[i].offset != 8 * i || members[i].size != 8 ||
+		    members[i].stage_mask != (1u << SpvExecutionModelFragment))
+			return EXIT_FAILURE;
+	}
+	if (members[0].type != SPVC_MSL_ARGUMENT_BUFFER_MEMBER_BUFFER ||
+	    members[1].type != SPVC_MSL_ARGUMENT_BUFFER_MEMBER_TEXTURE ||
+	    members[2].type != SPVC_MSL_ARGUMENT_BUFFER_MEMBER_SAMPLER || members[1].binding != members[2].binding)
+		return EXIT_FAILURE;
+
+	spvc_compiler stages[2] = { compiler, compiler };
+	SPVC_CHECKED_CALL(spvc_compiler_msl_merge_argument_buffer_layouts(stages, 2, 2, &members, &num_members));
+	if (num_members != 3)
+		return EXIT_FAILURE;
+
+	SPVC_CHECKED_CALL(spvc_compiler_msl_get_argument_buffer_layout(compiler, 3, &members, &num_members));
+	if (num_members != 0)
+		return EXIT_FAILURE;
 }
 
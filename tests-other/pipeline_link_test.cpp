@@ -0,0 +1,84 @@
+// Checks that linking a vertex and fragment shader prunes and compacts the varyings between them.
+
+#include "spirv_cross_util.hpp"
+#include "spirv_glsl.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace SPIRV_CROSS_NAMESPACE;
+
+static void check(bool cond, const char *what)
+{
+	if (!cond)
+	{
+		fprintf(stderr, "Pipeline link mismatch: %s\n", what);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static std::vector<uint32_t> read_file(const char *path)
+{
+	FILE *file = fopen(path, "rb");
+	if (!file)
+		exit(EXIT_FAILURE);
+
+	fseek(file, 0, SEEK_END);
+	long len = ftell(file) / sizeof(uint32_t);
+	rewind(file);
+
+	std::vector<uint32_t> spirv(len);
+	if (fread(spirv.data(), sizeof(uint32_t), len, file) != size_t(len))
+		exit(EXIT_FAILURE);
+	fclose(file);
+	return spirv;
+}
+
+static const Resource *find_resource(const SmallVector<Resource> &resources, const char *name)
+{
+	for (auto &res : resources)
+		if (res.name == name)
+			return &res;
+	return nullptr;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 3)
+		return EXIT_FAILURE;
+
+	CompilerGLSL vert(read_file(argv[1]));
+	CompilerGLSL frag(read_file(argv[2]));
+
+	SmallVector<Compiler *> stages = { &vert, &frag };
+	spirv_cross_util::link_pipeline_stages(stages);
+
+	auto vert_outputs = vert.get_shader_resources().stage_outputs;
+	auto frag_inputs = frag.get_shader_resources().stage_inputs;
+	check(vert_outputs.size() == 2, "vertex outputs");
+	check(frag_inputs.size() == 2, "fragment inputs");
+	check(!find_resource(vert_outputs, "vFog"), "unread output is removed");
+	check(!find_resource(frag_inputs, "vUnused"), "unused input is removed");
+
+	for (auto *name : { "vColor", "vUV" })
+	{
+		auto *output = find_resource(vert_outputs, name);
+		auto *input = find_resource(frag_inputs, name);
+		check(output && input, "linked varyings are kept");
+		check(vert.get_decoration(output->id, spv::DecorationLocation) ==
+		          frag.get_decoration(input->id, spv::DecorationLocation),
+		      "linked locations match");
+	}
+
+	check(vert.get_decoration(find_resource(vert_outputs, "vColor")->id, spv::DecorationLocation) == 0,
+	      "locations are compacted");
+	check(vert.get_decoration(find_resource(vert_outputs, "vUV")->id, spv::DecorationLocation) == 1,
+	      "locations are compacted");
+
+	auto vert_source = vert.compile();
+	auto frag_source = frag.compile();
+	check(vert_source.find("vFog") == std::string::npos, "removed output is not declared");
+	check(vert_source.find("0.5") == std::string::npos, "dead code is removed");
+	check(vert_source.find("gl_Position") != std::string::npos, "built-ins are kept");
+	check(frag_source.find("vUnused") == std::string::npos, "removed input is not declared");
+	check(frag_source.find("layout(location = 1) in vec2 vUV;") != std::string::npos, "compacted location is emitted");
+}
@@ -0,0 +1,56 @@
+// Checks that predicting temporaries avoids the extra compilation pass for loads which are invalidated by stores,
+// without changing the output.
+
+#include "spirv_glsl.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace SPIRV_CROSS_NAMESPACE;
+
+static void check(bool cond, const char *what)
+{
+	if (!cond)
+	{
+		fprintf(stderr, "Temporary prediction mismatch: %s\n", what);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static std::vector<uint32_t> read_file(const char *path)
+{
+	FILE *file = fopen(path, "rb");
+	if (!file)
+		exit(EXIT_FAILURE);
+
+	fseek(file, 0, SEEK_END);
+	long len = ftell(file) / sizeof(uint32_t);
+	rewind(file);
+
+	std::vector<uint32_t> spirv(len);
+	if (fread(spirv.data(), sizeof(uint32_t), len, file) != size_t(len))
+		exit(EXIT_FAILURE);
+	fclose(file);
+	return spirv;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 2)
+		return EXIT_FAILURE;
+
+	auto spirv = read_file(argv[1]);
+
+	CompilerGLSL reference(spirv);
+	auto expected = reference.compile();
+	check(reference.get_compile_pass_count() == 2, "loads are invalidated without prediction");
+	check(reference.get_recompile_reason_count(RecompileReasonInvalidatedExpression) != 0,
+	      "recompile is caused by invalidated loads");
+
+	CompilerGLSL predicted(spirv);
+	auto options = predicted.get_common_options();
+	options.predict_temporaries = true;
+	predicted.set_common_options(options);
+	auto source = predicted.compile();
+	check(predicted.get_compile_pass_count() == 1, "prediction avoids the extra pass");
+	check(source == expected, "output is unchanged");
+}
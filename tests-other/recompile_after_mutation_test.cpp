@@ -0,0 +1,140 @@
+// Checks that modifying the module or the options after compile() gives the same output as doing so before the first
+// compile().
+
+#include "spirv_glsl.hpp"
+#include <functional>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace SPIRV_CROSS_NAMESPACE;
+
+static std::vector<uint32_t> read_file(const char *path)
+{
+	FILE *file = fopen(path, "rb");
+	if (!file)
+		exit(EXIT_FAILURE);
+
+	fseek(file, 0, SEEK_END);
+	long len = ftell(file) / sizeof(uint32_t);
+	rewind(file);
+
+	std::vector<uint32_t> spirv(len);
+	if (fread(spirv.data(), sizeof(uint32_t), len, file) != size_t(len))
+		exit(EXIT_FAILURE);
+	fclose(file);
+	return spirv;
+}
+
+// prepare is only applied to the compiler which is compiled twice, before its first compile().
+static void check(const std::vector<uint32_t> &spirv, const char *what,
+                  const std::function<void(CompilerGLSL &)> &mutate,
+                  const std::function<void(CompilerGLSL &)> &prepare = {})
+{
+	CompilerGLSL fresh(spirv);
+	mutate(fresh);
+	auto expected = fresh.compile();
+
+	CompilerGLSL recompiled(spirv);
+	if (prepare)
+		prepare(recompiled);
+	auto before = recompiled.compile();
+	mutate(recompiled);
+	auto source = recompiled.compile();
+
+	if (source != expected)
+	{
+		fprintf(stderr, "%s after compile() does not match:\n%s\nExpected:\n%s\n", what, source.c_str(),
+		        expected.c_str());
+		exit(EXIT_FAILURE);
+	}
+
+	if (source == before)
+	{
+		fprintf(stderr, "%s did not change the output.\n", what);
+		exit(EXIT_FAILURE);
+	}
+}
+
+// For calls which do not change the output, e.g. folding without any constants to fold, or shrink_to_fit().
+// Whatever is kept or redone must not add to the results of the first compile().
+static void check_unchanged(const std::vector<uint32_t> &spirv, const char *what,
+                            const std::function<void(CompilerGLSL &)> &mutate)
+{
+	CompilerGLSL fresh(spirv);
+	auto expected = fresh.compile();
+
+	CompilerGLSL recompiled(spirv);
+	recompiled.compile();
+	mutate(recompiled);
+	auto source = recompiled.compile();
+
+	if (source != expected)
+	{
+		fprintf(stderr, "%s after compile() does not match:\n%s\nExpected:\n%s\n", what, source.c_str(),
+		        expected.c_str());
+		exit(EXIT_FAILURE);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 7)
+		return EXIT_FAILURE;
+
+	auto spec_constants = read_file(argv[1]);
+	auto workgroup_memory = read_file(argv[2]);
+	auto interface = read_file(argv[3]);
+	auto common_subexpressions = read_file(argv[4]);
+	auto loop_variables = read_file(argv[5]);
+	auto relaxed_precision = read_file(argv[6]);
+
+	check(spec_constants, "fold_specialization_constants()", [](CompilerGLSL &compiler) {
+		compiler.fold_specialization_constants({ { 0, 1 }, { 1, 2 } });
+	});
+
+	check(interface, "remove_interface_variables()", [](CompilerGLSL &compiler) {
+		for (auto &output : compiler.get_shader_resources().stage_outputs)
+			if (output.name == "vFog")
+				compiler.remove_interface_variables({ output.id });
+	});
+
+	check(workgroup_memory, "pad_workgroup_arrays()", [](CompilerGLSL &compiler) { compiler.pad_workgroup_arrays(); });
+
+	check(workgroup_memory, "alias_workgroup_variables()",
+	      [](CompilerGLSL &compiler) { compiler.alias_workgroup_variables(); });
+
+	check(
+	    common_subexpressions, "Disabling eliminate_common_subexpressions",
+	    [](CompilerGLSL &compiler) {
+		    auto options = compiler.get_common_options();
+		    options.eliminate_common_subexpressions = false;
+		    compiler.set_common_options(options);
+	    },
+	    [](CompilerGLSL &compiler) {
+		    auto options = compiler.get_common_options();
+		    options.eliminate_common_subexpressions = true;
+		    compiler.set_common_options(options);
+	    });
+
+	check(
+	    relaxed_precision, "Disabling infer_relaxed_precision",
+	    [](CompilerGLSL &compiler) {
+		    auto options = compiler.get_common_options();
+		    options.es = true;
+		    options.version = 310;
+		    options.infer_relaxed_precision = false;
+		    compiler.set_common_options(options);
+	    },
+	    [](CompilerGLSL &compiler) {
+		    auto options = compiler.get_common_options();
+		    options.es = true;
+		    options.version = 310;
+		    options.infer_relaxed_precision = true;
+		    compiler.set_common_options(options);
+	    });
+
+	check_unchanged(loop_variables, "fold_specialization_constants() without constants",
+	                [](CompilerGLSL &compiler) { compiler.fold_specialization_constants({}); });
+
+	check_unchanged(loop_variables, "shrink_to_fit()", [](CompilerGLSL &compiler) { compiler.shrink_to_fit(); });
+}
@@ -0,0 +1,229 @@
+// Checks that streamed reflection output matches compile(),
+// and that decoding the binary reflection format gives back the JSON output.
+
+#include "spirv_reflect.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace SPIRV_CROSS_NAMESPACE;
+
+static void check(bool cond, const char *what)
+{
+	if (!cond)
+	{
+		fprintf(stderr, "Reflection stream mismatch: %s\n", what);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static std::vector<uint32_t> read_file(const char *path)
+{
+	FILE *file = fopen(path, "rb");
+	if (!file)
+		exit(EXIT_FAILURE);
+
+	fseek(file, 0, SEEK_END);
+	long len = ftell(file) / sizeof(uint32_t);
+	rewind(file);
+
+	std::vector<uint32_t> spirv(len);
+	if (fread(spirv.data(), sizeof(uint32_t), len, file) != size_t(len))
+		exit(EXIT_FAILURE);
+	fclose(file);
+	return spirv;
+}
+
+struct RecordingSink : ReflectionSink
+{
+	void write(const char *data, size_t size) override
+	{
+		str.append(data, size);
+		writes++;
+	}
+
+	std::string str;
+	uint32_t writes = 0;
+};
+
+// Re-emits the binary format as JSON without any whitespace.
+class BinaryDecoder
+{
+public:
+	explicit BinaryDecoder(const std::string &data_)
+	    : data(data_)
+	{
+	}
+
+	std::string decode()
+	{
+		check(data.compare(0, 4, "SPVR") == 0, "magic");
+		offset = 4;
+		check(varint() == ReflectionBinaryVersion, "version");
+		value(byte());
+		check(offset == data.size(), "trailing data");
+		return out;
+	}
+
+private:
+	uint8_t byte()
+	{
+		check(offset < data.size(), "truncated");
+		return uint8_t(data[offset++]);
+	}
+
+	uint32_t varint()
+	{
+		uint32_t value = 0;
+		for (uint32_t shift = 0;; shift += 7)
+		{
+			uint8_t b = byte();
+			value |= uint32_t(b & 0x7f) << shift;
+			if (!(b & 0x80))
+				return value;
+		}
+	}
+
+	std::string bytes()
+	{
+		uint32_t length = varint();
+		check(offset + length <= data.size(), "truncated string");
+		std::string str = data.substr(offset, length);
+		offset += length;
+		return str;
+	}
+
+	void value(uint8_t tag)
+	{
+		switch (tag)
+		{
+		case 0x01:
+		{
+			out += '{';
+			bool first = true;
+			for (uint8_t next = byte(); next != 0x02; next = byte())
+			{
+				if (!first)
+					out += ',';
+				first = false;
+
+				if (next == 0x0b)
+				{
+					keys.push_back(bytes());
+					out += '"' + keys.back() + "\":";
+				}
+				else
+				{
+					check(next == 0x0c, "object key");
+					uint32_t index = varint();
+					check(index < keys.size(), "key index");
+					out += '"' + keys[index] + "\":";
+				}
+				value(byte());
+			}
+			out += '}';
+			break;
+		}
+
+		case 0x03:
+		{
+			out += '[';
+			bool first = true;
+			for (uint8_t next = byte(); next != 0x04; next = byte())
+			{
+				if (!first)
+					out += ',';
+				first = false;
+				value(next);
+			}
+			out += ']';
+			break;
+		}
+
+		case 0x05:
+			out += "false";
+			break;
+
+		case 0x06:
+			out += "true";
+			break;
+
+		case 0x07:
+			out += convert_to_string(varint());
+			break;
+
+		case 0x08:
+		{
+			uint32_t zigzag = varint();
+			out += convert_to_string(int32_t((zigzag >> 1) ^ (0u - (zigzag & 1))));
+			break;
+		}
+
+		case 0x09:
+		{
+			uint32_t bits = 0;
+			for (uint32_t i = 0; i < 4; i++)
+				bits |= uint32_t(byte()) << (8 * i);
+			float f;
+			memcpy(&f, &bits, sizeof(f));
+			out += convert_to_string(f, '.');
+			break;
+		}
+
+		case 0x0a:
+			out += '"' + bytes() + '"';
+			break;
+
+		default:
+			check(false, "value tag");
+		}
+	}
+
+	const std::string &data;
+	size_t offset = 0;
+	SmallVector<std::string> keys;
+	std::string out;
+};
+
+// Reflection strings never contain quotes or whitespace which would need escaping.
+static std::string strip_whitespace(const std::string &json)
+{
+	std::string stripped;
+	bool in_string = false;
+	for (char c : json)
+	{
+		if (c == '"')
+			in_string = !in_string;
+		if (in_string || (c != ' ' && c != '\n' && c != '\t'))
+			stripped += c;
+	}
+	return stripped;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+		return EXIT_FAILURE;
+
+	for (int i = 1; i < argc; i++)
+	{
+		auto spirv = read_file(argv[i]);
+
+		CompilerReflection json(spirv);
+		auto expected = json.compile();
+
+		CompilerReflection streamed(spirv);
+		RecordingSink json_sink;
+		streamed.compile(json_sink);
+		check(json_sink.writes != 0, "JSON is written to the sink");
+		check(json_sink.str == expected, "streamed JSON matches compile()");
+
+		CompilerReflection binary(spirv);
+		binary.set_format("binary");
+		RecordingSink binary_sink;
+		binary.compile(binary_sink);
+		check(binary_sink.str == binary.compile(), "streamed binary matches compile()");
+		check(binary_sink.str.size() < expected.size(), "binary is smaller than JSON");
+		check(BinaryDecoder(binary_sink.str).decode() == strip_whitespace(expected), "binary decodes to the JSON");
+	}
+}
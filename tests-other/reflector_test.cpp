@@ -0,0 +1,64 @@
+// Checks that Reflector agrees with the regular Compiler reflection interface.
+
+#include "spirv_cross_reflector.hpp"
+#include "spirv_parser.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace SPIRV_CROSS_NAMESPACE;
+
+static void check(bool cond, const char *what)
+{
+	if (!cond)
+	{
+		fprintf(stderr, "Reflector mismatch: %s\n", what);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static bool same_resources(const SmallVector<Resource> &a, const SmallVector<Resource> &b)
+{
+	if (a.size() != b.size())
+		return false;
+	for (size_t i = 0; i < a.size(); i++)
+		if (a[i].id != b[i].id || a[i].type_id != b[i].type_id || a[i].name != b[i].name)
+			return false;
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 2)
+		return EXIT_FAILURE;
+
+	Parser parser(Parser::map_file(argv[1]));
+	parser.parse();
+
+	Compiler compiler(parser.get_parsed_ir());
+	Reflector reflector(std::move(parser.get_parsed_ir()));
+
+	auto expected_active = compiler.get_active_interface_variables();
+	auto expected = compiler.get_shader_resources(expected_active);
+
+	auto &active = reflector.get_active_variables();
+	check(active == expected_active, "active variables");
+	check(&active == &reflector.get_active_variables(), "active variables are not cached");
+
+	auto &resources = reflector.get_active_shader_resources();
+	check(same_resources(resources.uniform_buffers, expected.uniform_buffers), "uniform buffers");
+	check(same_resources(resources.storage_buffers, expected.storage_buffers), "storage buffers");
+	check(same_resources(resources.stage_inputs, expected.stage_inputs), "stage inputs");
+	check(same_resources(resources.stage_outputs, expected.stage_outputs), "stage outputs");
+	check(same_resources(resources.storage_images, expected.storage_images), "storage images");
+	check(same_resources(resources.sampled_images, expected.sampled_images), "sampled images");
+	check(same_resources(resources.separate_images, expected.separate_images), "separate images");
+	check(same_resources(resources.separate_samplers, expected.separate_samplers), "separate samplers");
+	check(same_resources(resources.push_constant_buffers, expected.push_constant_buffers), "push constants");
+
+	size_t expected_ranges = 0;
+	for (auto &block : expected.push_constant_buffers)
+		expected_ranges += compiler.get_active_buffer_ranges(block.id).size();
+	check(reflector.get_active_push_constant_ranges().size() == expected_ranges, "push constant ranges");
+
+	return EXIT_SUCCESS;
+}
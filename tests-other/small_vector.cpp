@@ -207,6 +207,65 @@ static void convert_to_std_vector()
 #endif
 }
 
+static void memory_arena()
+{
+	MemoryArena arena(256);
+	auto *a = arena.allocate_array<uint32_t>(4);
+	auto *b = arena.allocate_array<uint64_t>(4);
+	SPVC_ASSERT((reinterpret_cast<uintptr_t>(b) & (alignof(uint64_t) - 1)) == 0);
+	SPVC_ASSERT(static_cast<void *>(a) != static_cast<void *>(b));
+
+	// Large allocations go to a separate block and are released on reset.
+	size_t reserved = arena.get_reserved_size();
+	arena.allocate(1000);
+	SPVC_ASSERT(arena.get_reserved_size() == reserved + 1000);
+
+	auto *str = arena.allocate_string("foo", 3);
+	SPVC_ASSERT(strcmp(str, "foo") == 0);
+
+	// Blocks are recycled after a reset.
+	arena.reset();
+	SPVC_ASSERT(arena.get_allocated_size() == 0);
+	SPVC_ASSERT(arena.get_reserved_size() == reserved);
+	SPVC_ASSERT(arena.allocate_array<uint32_t>(4) == a);
+
+	std::unordered_map<uint32_t, uint32_t, std::hash<uint32_t>, std::equal_to<uint32_t>,
+	                   ArenaAllocator<std::pair<const uint32_t, uint32_t>>>
+	    map{ ArenaAllocator<std::pair<const uint32_t, uint32_t>>(&arena) };
+	for (uint32_t i = 0; i < 100; i++)
+		map[i] = i * 2;
+	SPVC_ASSERT(map.size() == 100 && map[50] == 100);
+	SPVC_ASSERT(arena.get_allocated_size() > 100 * sizeof(uint32_t));
+}
+
+static void shared_vector_copy_on_write()
+{
+	SharedVector<RAIIInt> a;
+	a.push_back(1);
+	a.push_back(2);
+	SPVC_ASSERT(!a.is_shared());
+
+	// Copies share the elements until one of them is written to.
+	SharedVector<RAIIInt> b = a;
+	SPVC_ASSERT(a.is_shared() && b.is_shared());
+	SPVC_ASSERT(a.data() == b.data());
+
+	b.push_back(3);
+	SPVC_ASSERT(!a.is_shared() && !b.is_shared());
+	SPVC_ASSERT(a.data() != b.data());
+	SPVC_ASSERT(a.size() == 2 && b.size() == 3);
+	SPVC_ASSERT(a[1].v == 2 && b[2].v == 3);
+
+	// Writing to an unshared vector does not copy.
+	const RAIIInt *data = b.data();
+	b.get_mutable()[0].v = 10;
+	SPVC_ASSERT(b.data() == data && b[0].v == 10 && a[0].v == 1);
+
+	SharedVector<RAIIInt> c = a;
+	a.clear();
+	SPVC_ASSERT(a.empty() && !c.is_shared() && c.size() == 2);
+}
+
 int main()
 {
 	propagate_stack_to_heap();
@@ -220,6 +279,8 @@ int main()
 	erase_start();
 
 	convert_to_std_vector();
+	memory_arena();
+	shared_vector_copy_on_write();
 
 	SPVC_ASSERT(allocations > 0 && deallocations > 0 && deallocations == allocations);
 }